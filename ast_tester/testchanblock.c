@@ -0,0 +1,241 @@
+#include "ast.h"
+#include <stdio.h>
+#include <string.h>
+
+/* A memory buffer used to hold the data exchanged with a Channel. */
+typedef struct Buffer {
+   char *text;
+   size_t len;
+   size_t pos;
+   size_t chunk;
+   int ncall;
+} Buffer;
+
+static void Reset( Buffer *buf, size_t chunk ){
+   buf->pos = 0;
+   buf->chunk = chunk;
+   buf->ncall = 0;
+}
+
+static void Empty( Buffer *buf ){
+   buf->text = astFree( buf->text );
+   buf->len = 0;
+   Reset( buf, 0 );
+}
+
+static void Append( Buffer *buf, const char *data, size_t nbyte ){
+   buf->text = astGrow( buf->text, buf->len + nbyte + 1, 1 );
+   if( astOK ) {
+      memcpy( buf->text + buf->len, data, nbyte );
+      buf->len += nbyte;
+      buf->text[ buf->len ] = 0;
+   }
+}
+
+/* Block source and sink functions. The source function returns at most
+   "chunk" bytes on each call so that lines are split between blocks. */
+static size_t BlockSource( char *data, size_t size ){
+   Buffer *buf = astChannelData;
+   size_t n = buf->len - buf->pos;
+   if( n > size ) n = size;
+   if( n > buf->chunk ) n = buf->chunk;
+   memcpy( data, buf->text + buf->pos, n );
+   buf->pos += n;
+   buf->ncall++;
+   return n;
+}
+
+static void BlockSink( const char *data, size_t nbyte ){
+   Buffer *buf = astChannelData;
+   Append( buf, data, nbyte );
+   buf->ncall++;
+}
+
+/* Error handler used to suppress expected error messages. */
+static int nerr = 0;
+static void QuietPutErr( int status_value, const char *message ){
+   nerr++;
+}
+
+/* Line-oriented sink function, used to check the block output. */
+static void LineSink( const char *line ){
+   Buffer *buf = astChannelData;
+   Append( buf, line, strlen( line ) );
+   Append( buf, "\n", 1 );
+}
+
+/* Write an Object through both a line sink and a block sink, check the
+   two outputs are the same, then read the Object back through a block
+   source that delivers "chunk" bytes at a time. */
+static AstObject *RoundTrip( AstChannel *line_chan, AstChannel *block_chan,
+                             AstObject *obj, size_t chunk, int ierr ){
+   Buffer line_buf = { NULL, 0, 0, 0, 0 };
+   Buffer block_buf = { NULL, 0, 0, 0, 0 };
+   AstObject *result = NULL;
+
+   astPutChannelData( line_chan, &line_buf );
+   astPutChannelData( block_chan, &block_buf );
+   astChannelBlock( block_chan, BlockSource, BlockSink );
+
+   if( astWrite( line_chan, obj ) != 1 && astOK ) {
+      astError( AST__INTER, "Error %d (line write)\n", ierr );
+   }
+   if( astWrite( block_chan, obj ) != 1 && astOK ) {
+      astError( AST__INTER, "Error %d (block write)\n", ierr + 1 );
+   }
+
+   if( astOK ) {
+      if( block_buf.len == 0 || block_buf.ncall == 0 ) {
+         astError( AST__INTER, "Error %d (nothing written)\n", ierr + 2 );
+      } else if( line_buf.len != block_buf.len ||
+                 strcmp( line_buf.text, block_buf.text ) ) {
+         astError( AST__INTER, "Error %d (outputs differ)\n", ierr + 3 );
+      }
+   }
+
+   if( astOK ) {
+      Reset( &block_buf, chunk );
+      result = astRead( block_chan );
+      if( !result && astOK ) {
+         astError( AST__INTER, "Error %d (nothing read)\n", ierr + 4 );
+      } else if( block_buf.ncall < 2 && astOK ) {
+         astError( AST__INTER, "Error %d (%d source calls)\n", ierr + 5,
+                   block_buf.ncall );
+      }
+   }
+
+   Empty( &line_buf );
+   Empty( &block_buf );
+   return result;
+}
+
+int main(){
+   AstChannel *chan1;
+   AstChannel *chan2;
+   AstFrame *frm;
+   AstFrameSet *fs;
+   AstMapping *map;
+   AstMoc *moc;
+   AstObject *obj;
+   AstRegion *reg;
+   AstSkyFrame *sf;
+   Buffer buf = { NULL, 0, 0, 0, 0 };
+   double centre[ 2 ] = { 0.1, 0.2 };
+   double radius = 0.01;
+   double coeff[ 8 ] = { 1.0, 1, 1, 0, 2.0, 1, 0, 1 };
+
+/* A FrameSet through a basic Channel. */
+   sf = astSkyFrame( "System=FK5" );
+   map = (AstMapping *) astPolyMap( 2, 1, 2, coeff, 0, NULL, " " );
+   fs = astFrameSet( sf, " " );
+   frm = astFrame( 1, "Domain=X" );
+   astAddFrame( fs, AST__BASE, map, frm );
+
+   chan1 = astChannel( NULL, LineSink, " " );
+   chan2 = astChannel( NULL, NULL, " " );
+   obj = RoundTrip( chan1, chan2, (AstObject *) fs, 7, 100 );
+   if( obj && !astEqual( obj, fs ) && astOK ) {
+      astError( AST__INTER, "Error 1\n" );
+   }
+   if( obj ) obj = astAnnul( obj );
+
+/* The same through a binary Channel. */
+   astSet( chan2, "Binary=1" );
+   astPutChannelData( chan2, &buf );
+   if( astWrite( chan2, fs ) != 1 && astOK ) {
+      astError( AST__INTER, "Error 2\n" );
+   }
+   Reset( &buf, 3 );
+   obj = astRead( chan2 );
+   if( ( !obj || !astEqual( obj, fs ) ) && astOK ) {
+      astError( AST__INTER, "Error 3\n" );
+   }
+   if( obj ) obj = astAnnul( obj );
+   if( astRead( chan2 ) && astOK ) {
+      astError( AST__INTER, "Error 4\n" );
+   }
+
+/* A corrupt string length (here, of the class name following the
+   signature and "begin" tag) is reported as an error rather than causing
+   a huge amount of memory to be allocated. */
+   if( buf.len > 9 && astOK ) {
+      buf.text[ 5 ] = (char) 0xf0;
+      buf.text[ 6 ] = buf.text[ 7 ] = buf.text[ 8 ] = (char) 0xff;
+      Reset( &buf, 1000 );
+      nerr = 0;
+      astSetPutErr( QuietPutErr );
+      obj = astRead( chan2 );
+      astSetPutErr( NULL );
+      if( obj || astStatus != AST__BADIN || nerr == 0 ) {
+         if( astOK ) astError( AST__INTER, "Error 12\n" );
+      } else {
+         astClearStatus;
+      }
+      if( obj ) obj = astAnnul( obj );
+   }
+   Empty( &buf );
+   chan1 = astAnnul( chan1 );
+   chan2 = astAnnul( chan2 );
+
+/* A FrameSet through an XmlChan. */
+   chan1 = (AstChannel *) astXmlChan( NULL, LineSink, " " );
+   chan2 = (AstChannel *) astXmlChan( NULL, NULL, " " );
+   obj = RoundTrip( chan1, chan2, (AstObject *) fs, 13, 200 );
+   if( obj && !astEqual( obj, fs ) && astOK ) {
+      astError( AST__INTER, "Error 5\n" );
+   }
+   if( obj ) obj = astAnnul( obj );
+   chan1 = astAnnul( chan1 );
+
+   chan2 = astAnnul( chan2 );
+
+/* A Region through an StcsChan. */
+   reg = (AstRegion *) astCircle( sf, 1, centre, &radius, NULL, " " );
+   chan1 = (AstChannel *) astStcsChan( NULL, LineSink, " " );
+   chan2 = (AstChannel *) astStcsChan( NULL, NULL, " " );
+   obj = RoundTrip( chan1, chan2, (AstObject *) reg, 5, 300 );
+   if( obj && !astIsACircle( obj ) && astOK ) {
+      astError( AST__INTER, "Error 6\n" );
+   }
+   if( obj ) obj = astAnnul( obj );
+   chan1 = astAnnul( chan1 );
+   chan2 = astAnnul( chan2 );
+
+/* A Moc through a MocChan. */
+   moc = astMoc( "MaxOrder=12" );
+   astAddRegion( moc, AST__OR, reg );
+   chan1 = (AstChannel *) astMocChan( NULL, LineSink, " " );
+   chan2 = (AstChannel *) astMocChan( NULL, NULL, " " );
+   obj = RoundTrip( chan1, chan2, (AstObject *) moc, 11, 400 );
+   if( obj && !astEqual( obj, moc ) && astOK ) {
+      astError( AST__INTER, "Error 7\n" );
+   }
+   if( obj ) obj = astAnnul( obj );
+   chan1 = astAnnul( chan1 );
+   chan2 = astAnnul( chan2 );
+
+/* Removing the block functions reverts to the line functions. */
+   chan1 = astChannel( NULL, LineSink, " " );
+   astPutChannelData( chan1, &buf );
+   astChannelBlock( chan1, BlockSource, BlockSink );
+   astChannelBlock( chan1, NULL, NULL );
+   astWrite( chan1, fs );
+   if( ( buf.len == 0 || buf.ncall != 0 ) && astOK ) {
+      astError( AST__INTER, "Error 8\n" );
+   }
+   Empty( &buf );
+   chan1 = astAnnul( chan1 );
+
+   moc = astAnnul( moc );
+   reg = astAnnul( reg );
+   fs = astAnnul( fs );
+   map = astAnnul( map );
+   frm = astAnnul( frm );
+   sf = astAnnul( sf );
+
+   if( astOK ) {
+      printf(" All Channel block I/O tests passed\n");
+   } else {
+      printf("Channel block I/O tests failed\n");
+   }
+}
@@ -4,7 +4,7 @@
       include 'AST_PAR'
       include 'AST_ERR'
 
-      integer status, ch, sf, sf2
+      integer status, ch, sf, sf2, fs, fs2, fs3
       character buff*50
       status = sai__ok
 
@@ -63,6 +63,112 @@
       end if
 
 
+      fs = ast_frameset( ast_frame( 2, ' ', status ), ' ', status )
+      call ast_addframe( fs, AST__BASE, ast_zoommap( 2, 0.1D0, ' ',
+     :                                               status ),
+     :                   sf, status )
+      call ast_clear( ch, 'SourceFile', status )
+      call ast_set( ch, 'Binary=1,SinkFile=./fred3.bin', status )
+      if( ast_write( ch, fs, status ) .ne. 1 ) then
+         call stopit( 8, status )
+      end if
+      call ast_clear( ch, 'SinkFile', status )
+
+      call ast_set( ch, 'SourceFile=./fred3.bin', status )
+      fs2 = ast_read( ch, status )
+      if( fs2 .eq. AST__NULL ) call stopit( 9, status )
+      if( .not. ast_equal( fs, fs2, status ) ) then
+         call stopit( 10, status )
+      end if
+      if( ast_read( ch, status ) .ne. AST__NULL ) then
+         call stopit( 11, status )
+      end if
+
+      call ast_set( ch, 'SourceFile=./fred2.txt', status )
+      if( status .eq. SAI__OK ) then
+         fs2 = ast_read( ch, status )
+         if( status .eq. AST__BADIN ) then
+            call err_annul( status )
+         else
+            call stopit( 12, status )
+         end if
+      end if
+
+      call ast_set( ch, 'Lazy=1,SourceFile=./fred3.bin', status )
+      fs2 = ast_read( ch, status )
+      if( fs2 .eq. AST__NULL ) call stopit( 13, status )
+      if( .not. ast_equal( ast_getframe( fs2, AST__CURRENT, status ),
+     :                     sf, status ) ) then
+         call stopit( 14, status )
+      end if
+      if( .not. ast_equal( fs, fs2, status ) ) then
+         call stopit( 15, status )
+      end if
+
+*  Read the FrameSet lazily again, and modify it before any of its
+*  Frames or Mappings have been used. Do the same to a copy of the
+*  original FrameSet and check the results are the same.
+      call ast_set( ch, 'SourceFile=./fred3.bin', status )
+      fs2 = ast_read( ch, status )
+      if( fs2 .eq. AST__NULL ) call stopit( 20, status )
+      fs3 = ast_copy( fs, status )
+
+      call ast_addframe( fs2, AST__BASE, ast_zoommap( 2, 4.0D0, ' ',
+     :                                                status ),
+     :                   ast_frame( 2, 'Domain=NEW', status ), status )
+      call ast_addframe( fs3, AST__BASE, ast_zoommap( 2, 4.0D0, ' ',
+     :                                                status ),
+     :                   ast_frame( 2, 'Domain=NEW', status ), status )
+      if( ast_geti( fs2, 'Nframe', status ) .ne. 3 ) then
+         call stopit( 21, status )
+      else if( .not. ast_equal( fs2, fs3, status ) ) then
+         call stopit( 22, status )
+      end if
+
+      call ast_removeframe( fs2, 2, status )
+      call ast_removeframe( fs3, 2, status )
+      if( ast_geti( fs2, 'Nframe', status ) .ne. 2 ) then
+         call stopit( 23, status )
+      else if( ast_getc( fs2, 'Domain', status ) .ne. 'NEW' ) then
+         call stopit( 24, status )
+      else if( .not. ast_equal( fs2, fs3, status ) ) then
+         call stopit( 25, status )
+      end if
+
+*  Removing the base Frame of a lazily read FrameSet should leave the
+*  original current Frame.
+      call ast_set( ch, 'SourceFile=./fred3.bin', status )
+      fs2 = ast_read( ch, status )
+      call ast_removeframe( fs2, AST__BASE, status )
+      if( ast_geti( fs2, 'Nframe', status ) .ne. 1 ) then
+         call stopit( 26, status )
+      else if( .not. ast_equal( ast_getframe( fs2, AST__BASE, status ),
+     :                          sf, status ) ) then
+         call stopit( 27, status )
+      end if
+
+      call ast_clear( ch, 'SourceFile', status )
+      call ast_set( ch, 'Binary=0,SinkFile=./fred4.txt', status )
+      if( ast_write( ch, fs, status ) .ne. 1 ) then
+         call stopit( 16, status )
+      end if
+      call ast_clear( ch, 'SinkFile', status )
+
+      call ast_set( ch, 'SourceFile=./fred4.txt', status )
+      fs2 = ast_read( ch, status )
+      if( fs2 .eq. AST__NULL ) call stopit( 17, status )
+      if( .not. ast_equal( ast_getmapping( fs2, AST__BASE,
+     :                                     AST__CURRENT, status ),
+     :                     ast_getmapping( fs, AST__BASE,
+     :                                     AST__CURRENT, status ),
+     :                     status ) ) then
+         call stopit( 18, status )
+      end if
+      if( .not. ast_equal( fs, ast_copy( fs2, status ), status ) ) then
+         call stopit( 19, status )
+      end if
+
+
       call ast_end( status )
       call err_end( status )
 
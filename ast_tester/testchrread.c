@@ -0,0 +1,109 @@
+#define astCLASS testchrread
+
+#include "ast_err.h"
+#include "error.h"
+#include "memory.h"
+#include <float.h>
+#include <math.h>
+#include <stdint.h>
+#include <stdio.h>
+
+/* Strings read by astChrReadDouble, the number of characters that
+   should be used, and the value that should be returned. */
+static const char *dstr[] = { "1.5", "  -2.5E+03  ", "6.02e23", "1.0D0",
+                              "1.5E", "1.5e+", "1.25abc", "3.5 x", ".5",
+                              "-.5E-2", "12E2E3", "1e400", "-1e400",
+                              "1e-400", "E5", "", "   ", "+", "-.e1" };
+static const int dnc[] = { 3, 12, 7, 3, 3, 3, 4, 4, 2, 6, 4, 5, 6, 6, 0, 0,
+                           0, 0, 0 };
+static const double dval[] = { 1.5, -2500.0, 6.02E23, 1.0, 1.5, 1.5, 1.25,
+                               3.5, 0.5, -0.005, 1200.0, HUGE_VAL,
+                               -HUGE_VAL, 0.0, -1.0, -1.0, -1.0, -1.0,
+                               -1.0 };
+
+int main(){
+   int status_value = 0;
+   int *status = &status_value;
+
+   double value;
+   double svalue;
+   int i;
+   int ival;
+   int n;
+   int nc;
+   int64_t kval;
+
+/* Check each string is read correctly. The value should be left
+   unchanged if nothing can be read. */
+   for( i = 0; i < (int)( sizeof( dstr )/sizeof( dstr[ 0 ] ) ); i++ ) {
+      value = -1.0;
+      nc = astChrReadDouble( dstr[ i ], &value );
+      if( nc != dnc[ i ] || value != dval[ i ] ) {
+         astError( AST__INTER, "Error 1 (%s)\n", status, dstr[ i ] );
+         break;
+      }
+
+/* Also check the same result is produced by astSscanf for strings that
+   do not have an incomplete exponent (whether sscanf consumes these is
+   system-dependent). */
+      if( i == 4 || i == 5 || i == 18 ) continue;
+      svalue = -1.0;
+      nc = 0;
+      n = astSscanf( dstr[ i ], " %lf %n", &svalue, &nc );
+      if( ( n == 1 && ( nc != dnc[ i ] || svalue != dval[ i ] ) ) ||
+          ( n != 1 && dnc[ i ] != 0 ) ) {
+         astError( AST__INTER, "Error 2 (%s)\n", status, dstr[ i ] );
+         break;
+      }
+   }
+
+/* A NULL string should give zero. */
+   if( astChrReadDouble( NULL, &value ) != 0 && astOK ) {
+      astError( AST__INTER, "Error 3\n", status );
+   }
+
+/* Integer values, including values with trailing characters, and a
+   floating point value (only the integer part should be read). */
+   ival = -1;
+   if( ( astChrReadInt( " -42 ", &ival ) != 5 || ival != -42 ) && astOK ) {
+      astError( AST__INTER, "Error 4\n", status );
+   }
+   if( ( astChrReadInt( "17abc", &ival ) != 2 || ival != 17 ) && astOK ) {
+      astError( AST__INTER, "Error 5\n", status );
+   }
+   if( ( astChrReadInt( "3.5", &ival ) != 1 || ival != 3 ) && astOK ) {
+      astError( AST__INTER, "Error 6\n", status );
+   }
+   ival = -1;
+   if( ( astChrReadInt( "x12", &ival ) != 0 || ival != -1 ) && astOK ) {
+      astError( AST__INTER, "Error 7\n", status );
+   }
+
+/* 64 bit integers, including values too large for an int, and a value
+   that overflows a 64 bit integer (the largest value is returned, as
+   for strtoll). */
+   kval = 0;
+   if( ( astChrReadInt64( "  9007199254740993", &kval ) != 18 ||
+         kval != INT64_C( 9007199254740993 ) ) && astOK ) {
+      astError( AST__INTER, "Error 8\n", status );
+   }
+   if( ( astChrReadInt64( "-9223372036854775808 ", &kval ) != 21 ||
+         kval != INT64_MIN ) && astOK ) {
+      astError( AST__INTER, "Error 9\n", status );
+   }
+   if( ( astChrReadInt64( "99999999999999999999", &kval ) != 20 ||
+         kval != INT64_MAX ) && astOK ) {
+      astError( AST__INTER, "Error 10\n", status );
+   }
+   kval = 5;
+   if( ( astChrReadInt64( "-", &kval ) != 0 || kval != 5 ) && astOK ) {
+      astError( AST__INTER, "Error 11\n", status );
+   }
+
+   if( astOK ) {
+      printf(" All string reading tests passed\n");
+   } else {
+      printf("String reading tests failed\n");
+   }
+   return *status;
+}
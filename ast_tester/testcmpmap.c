@@ -0,0 +1,87 @@
+#include "ast.h"
+#include <stdio.h>
+#include <string.h>
+
+#define NDEEP 200
+#define NPOINT 100000
+
+int main(){
+   AstCmpMap *cm;
+   AstMapping *map;
+   AstShiftMap *sm;
+   double shift[ 2 ];
+   double *xin, *yin, *xout, *yout;
+   int i, ipass;
+
+   astBegin;
+
+/* Create a series CmpMap nested NDEEP levels deep. Each level adds a
+   ShiftMap to the end of the CmpMap created by the previous level. */
+   shift[ 0 ] = 1.0;
+   shift[ 1 ] = -0.5;
+   map = (AstMapping *) astUnitMap( 2, " " );
+   for( i = 0; i < NDEEP; i++ ) {
+      sm = astShiftMap( 2, shift, " " );
+      cm = astCmpMap( map, sm, 1, " " );
+      map = astAnnul( map );
+      sm = astAnnul( sm );
+      map = (AstMapping *) cm;
+   }
+
+   xin = astMalloc( NPOINT*sizeof( *xin ) );
+   yin = astMalloc( NPOINT*sizeof( *yin ) );
+   xout = astMalloc( NPOINT*sizeof( *xout ) );
+   yout = astMalloc( NPOINT*sizeof( *yout ) );
+
+   if( astOK ) {
+      for( i = 0; i < NPOINT; i++ ) {
+         xin[ i ] = i;
+         yin[ i ] = -i;
+      }
+
+/* Transform a small and then a large number of points through the
+   nested CmpMap, in both directions. The large number of points needs
+   several megabytes of intermediate storage at every level. Repeat this
+   to check that the re-used memory gives the same results. */
+      for( ipass = 0; ipass < 2 && astOK; ipass++ ) {
+         astTran2( map, 3, xin, yin, 1, xout, yout );
+         for( i = 0; i < 3 && astOK; i++ ) {
+            if( xout[ i ] != xin[ i ] + NDEEP ||
+                yout[ i ] != yin[ i ] - 0.5*NDEEP ) {
+               astError( AST__INTER, "Error 1 (pass %d point %d: %g %g)\n",
+                         ipass, i, xout[ i ], yout[ i ] );
+            }
+         }
+
+         astTran2( map, NPOINT, xin, yin, 1, xout, yout );
+         for( i = 0; i < NPOINT && astOK; i++ ) {
+            if( xout[ i ] != xin[ i ] + NDEEP ||
+                yout[ i ] != yin[ i ] - 0.5*NDEEP ) {
+               astError( AST__INTER, "Error 2 (pass %d point %d: %g %g)\n",
+                         ipass, i, xout[ i ], yout[ i ] );
+            }
+         }
+
+         astTran2( map, NPOINT, xout, yout, 0, xout, yout );
+         for( i = 0; i < NPOINT && astOK; i++ ) {
+            if( xout[ i ] != xin[ i ] || yout[ i ] != yin[ i ] ) {
+               astError( AST__INTER, "Error 3 (pass %d point %d: %g %g)\n",
+                         ipass, i, xout[ i ], yout[ i ] );
+            }
+         }
+      }
+   }
+
+   xin = astFree( xin );
+   yin = astFree( yin );
+   xout = astFree( xout );
+   yout = astFree( yout );
+
+   astEnd;
+
+   if( astOK ) {
+      printf(" All CmpMap tests passed\n");
+   } else {
+      printf("CmpMap tests failed\n");
+   }
+}
@@ -29,6 +29,14 @@ c      call ast_watchmemory( 225192 )
       call test_fitsrounding( fc, status )
       call ast_emptyfits( fc, status )
 
+      call test_putblock( fc, status )
+      call ast_emptyfits( fc, status )
+
+      call test_fitscache( fc, status )
+      call ast_emptyfits( fc, status )
+
+      call test_sinkwindow( status )
+
 
 *  Put a FITS-WCS header into it.
       cards(1) = 'CRPIX1  =                   45'
@@ -1065,6 +1073,390 @@ c --------------------------------------------------------------------
       end
 
 
+      subroutine test_putblock( fc, status )
+      implicit none
+
+      include 'SAE_PAR'
+      include 'AST_PAR'
+
+      integer fc
+      integer status
+      integer ival
+      character block*480
+      character card*80
+
+      if( status .ne. SAI__OK ) return
+
+*  Two cards, an END card and some blank padding cards.
+      block = ' '
+      block( 1 : 80 ) = 'NAXIS   =                    2 / '//
+     :                  'Number of axes'
+      block( 81 : 160 ) = 'OBJECT  = ''M31     '''
+      block( 161 : 240 ) = 'END'
+
+*  The first card alone does not contain an END card.
+      if( ast_putblock( fc, block( 1 : 80 ), status ) ) then
+         call stopit( 12320, ' ', status )
+      end if
+
+*  The rest of the block is appended, and the END card is found.
+      if( .not. ast_putblock( fc, block( 81 : ), status ) ) then
+         call stopit( 12321, ' ', status )
+      end if
+
+      if( ast_geti( fc, 'Ncard', status ) .ne. 2 ) then
+         call stopit( 12322, ' ', status )
+      end if
+
+      if( ast_geti( fc, 'Card', status ) .ne. 1 ) then
+         call stopit( 12323, ' ', status )
+      end if
+
+      if( .not. ast_getfitsi( fc, 'NAXIS', ival, status ) ) then
+         call stopit( 12324, ' ', status )
+      else if( ival .ne. 2 ) then
+         call stopit( 12325, ' ', status )
+      end if
+
+      call ast_clear( fc, 'Card', status )
+      if( ast_findfits( fc, 'OBJECT', card, .false., status ) ) then
+         if( card .ne. 'OBJECT  = ''M31     ''' ) then
+            call stopit( 12326, card, status )
+         end if
+      else
+         call stopit( 12327, ' ', status )
+      end if
+
+      end
+
+
+      subroutine test_sinkwindow( status )
+      implicit none
+
+      include 'SAE_PAR'
+      include 'AST_PAR'
+
+      integer status
+      integer fc, fs, fs2, i, j
+      double precision shift( 2 )
+      character wcscards(9)*80
+
+      integer ncard( 2 ), iwhich
+      character cards( 500, 2 )*80
+      common /swsink_com/ ncard, iwhich, cards
+
+      external swsink
+
+      if( status .ne. SAI__OK ) return
+
+      call ast_begin( status )
+
+      fs = ast_frameset( ast_frame( 2, 'Domain=PIXEL', status ),
+     :                   ' ', status )
+      call ast_addframe( fs, AST__BASE, ast_zoommap( 2, 2.5D0, ' ',
+     :                                                 status ),
+     :                   ast_skyframe( ' ', status ), status )
+
+*  Write the FrameSet to a FitsChan that retains all cards until it is
+*  deleted.
+      ncard( 1 ) = 0
+      ncard( 2 ) = 0
+      iwhich = 1
+      fc = ast_fitschan( AST_NULL, swsink, ' ', status )
+      if( ast_write( fc, fs, status ) .ne. 1 ) then
+         call stopit( 12360, ' ', status )
+      end if
+      call ast_annul( fc, status )
+
+*  Now write it to a FitsChan that streams cards to the sink. All cards
+*  should have been written out by the time astWrite returns.
+      iwhich = 2
+      fc = ast_fitschan( AST_NULL, swsink, 'SinkWindow=5', status )
+      if( ast_write( fc, fs, status ) .ne. 1 ) then
+         call stopit( 12361, ' ', status )
+      end if
+
+      if( ast_geti( fc, 'Ncard', status ) .ne. 0 ) then
+         call stopit( 12362, ' ', status )
+      end if
+
+      if( ncard( 2 ) .ne. ncard( 1 ) ) then
+         call stopit( 12363, ' ', status )
+      end if
+
+      call ast_annul( fc, status )
+
+*  The same cards should have been written out in both cases.
+      if( ncard( 1 ) .eq. 0 .or. ncard( 2 ) .ne. ncard( 1 ) ) then
+         call stopit( 12364, ' ', status )
+      else
+         do i = 1, ncard( 1 )
+            if( cards( i, 1 ) .ne. cards( i, 2 ) ) then
+               call stopit( 12365, cards( i, 2 ), status )
+            end if
+         end do
+      end if
+
+*  Now write two FrameSets to a FitsChan using the FITS-WCS encoding.
+*  The second write modifies the CRPIXi and CRVALi cards created by the
+*  first write, so no cards should be written out until the FitsChan is
+*  deleted, and the cards written out should be the same whatever the
+*  value of SinkWindow.
+      wcscards(1) = 'NAXIS   =                    2'
+      wcscards(2) = 'CRPIX1  =                   45'
+      wcscards(3) = 'CRPIX2  =                   45'
+      wcscards(4) = 'CRVAL1  =                   45'
+      wcscards(5) = 'CRVAL2  =                   30'
+      wcscards(6) = 'CDELT1  =                -0.01'
+      wcscards(7) = 'CDELT2  =                 0.01'
+      wcscards(8) = 'CTYPE1  = ''RA---TAN'''
+      wcscards(9) = 'CTYPE2  = ''DEC--TAN'''
+
+      fc = ast_fitschan( AST_NULL, AST_NULL, ' ', status )
+      do i = 1, 9
+         call ast_putfits( fc, wcscards(i), .false., status )
+      end do
+      call ast_clear( fc, 'Card', status )
+      fs = ast_read( fc, status )
+      call ast_annul( fc, status )
+
+      fs2 = ast_copy( fs, status )
+      shift( 1 ) = 10.0D0
+      shift( 2 ) = -20.0D0
+      call ast_remapframe( fs2, AST__BASE, ast_shiftmap( 2, shift, ' ',
+     :                                                     status ),
+     :                     status )
+
+      do j = 1, 2
+         ncard( j ) = 0
+         iwhich = j
+         fc = ast_fitschan( AST_NULL, swsink, 'Encoding=FITS-WCS',
+     :                      status )
+         if( j .eq. 2 ) call ast_seti( fc, 'SinkWindow', 1, status )
+         if( ast_write( fc, fs, status ) .ne. 1 .or.
+     :       ast_write( fc, fs2, status ) .ne. 1 ) then
+            call stopit( 12366, ' ', status )
+         end if
+         if( ncard( j ) .ne. 0 ) then
+            call stopit( 12367, ' ', status )
+         end if
+         call ast_annul( fc, status )
+      end do
+
+      if( ncard( 1 ) .eq. 0 .or. ncard( 2 ) .ne. ncard( 1 ) ) then
+         call stopit( 12368, ' ', status )
+      else
+         do i = 1, ncard( 1 )
+            if( cards( i, 1 ) .ne. cards( i, 2 ) ) then
+               call stopit( 12369, cards( i, 2 ), status )
+            end if
+         end do
+      end if
+
+      call ast_end( status )
+
+      end
+
+
+      subroutine swsink( card, status )
+      implicit none
+
+      include 'SAE_PAR'
+
+      character card*80
+      integer status
+
+      integer ncard( 2 ), iwhich
+      character cards( 500, 2 )*80
+      common /swsink_com/ ncard, iwhich, cards
+
+      if( status .ne. SAI__OK ) return
+
+      if( ncard( iwhich ) .lt. 500 ) then
+         ncard( iwhich ) = ncard( iwhich ) + 1
+         cards( ncard( iwhich ), iwhich ) = card
+      end if
+
+      end
+
+
+      subroutine test_fitscache( fc, status )
+      implicit none
+
+      include 'SAE_PAR'
+      include 'AST_PAR'
+
+      integer fc
+      integer status
+      integer fs1, fs2, fs3, fs4, fs5, fs6, hits, i, km, misses, size
+      character cards(8)*80, sipcards(6)*80
+      double precision xin, yin, x1, y1, x2, y2
+
+      if( status .ne. SAI__OK ) return
+
+      cards(1) = 'NAXIS   =                    2'
+      cards(2) = 'CRPIX1  =                   45'
+      cards(3) = 'CRPIX2  =                   45'
+      cards(4) = 'CRVAL1  =                   45'
+      cards(5) = 'CRVAL2  =                   30'
+      cards(6) = 'CDELT1  =                -0.01'
+      cards(7) = 'CDELT2  =                 0.01'
+      cards(8) = 'CTYPE1  = ''RA---TAN'''
+
+*  Enable the cache of FrameSets read from FITS headers.
+      size = ast_tune( 'FitsCache', 5, status )
+      if( size .ne. 0 ) call stopit( 12350, ' ', status )
+
+*  Reset the cache statistics.
+      km = ast_fitscachestats( .true., status )
+      call ast_annul( km, status )
+
+*  Read the same header twice. The second read should return a copy of
+*  the cached FrameSet.
+      do i = 1, 8
+         call ast_putfits( fc, cards(i), .false., status )
+      end do
+      call ast_putfits( fc, 'CTYPE2  = ''DEC--TAN''', .false., status )
+      call ast_clear( fc, 'Card', status )
+      fs1 = ast_read( fc, status )
+
+      do i = 1, 8
+         call ast_putfits( fc, cards(i), .false., status )
+      end do
+      call ast_putfits( fc, 'CTYPE2  = ''DEC--TAN''', .false., status )
+      call ast_clear( fc, 'Card', status )
+      fs2 = ast_read( fc, status )
+
+      if( fs1 .eq. AST__NULL .or. fs2 .eq. AST__NULL ) then
+         call stopit( 12351, ' ', status )
+      else if( fs1 .eq. fs2 ) then
+         call stopit( 12352, ' ', status )
+      else if( .not. ast_equal( fs1, fs2, status ) ) then
+         call stopit( 12353, ' ', status )
+      end if
+
+*  The WCS cards should have been removed from the FitsChan in the same
+*  way by both reads, leaving just the two NAXIS cards.
+      if( ast_geti( fc, 'Ncard', status ) .ne. 2 ) then
+         call stopit( 12354, ' ', status )
+      end if
+      call ast_emptyfits( fc, status )
+
+*  The first read should have been a cache miss and the second a hit.
+      km = ast_fitscachestats( .true., status )
+      if( .not. ast_mapget0i( km, 'Hits', hits, status ) .or.
+     :    .not. ast_mapget0i( km, 'Misses', misses, status ) ) then
+         call stopit( 12357, ' ', status )
+      else if( hits .ne. 1 .or. misses .ne. 1 ) then
+         call stopit( 12357, ' ', status )
+      end if
+      call ast_annul( km, status )
+
+*  A header with a different reference point should produce a different
+*  FrameSet.
+      cards(4) = 'CRVAL1  =                   46'
+      do i = 1, 8
+         call ast_putfits( fc, cards(i), .false., status )
+      end do
+      call ast_putfits( fc, 'CTYPE2  = ''DEC--TAN''', .false., status )
+      call ast_clear( fc, 'Card', status )
+      fs3 = ast_read( fc, status )
+
+      xin = 10.0
+      yin = 20.0
+      call ast_tran2( fs1, 1, xin, yin, .true., x1, y1, status )
+      call ast_tran2( fs3, 1, xin, yin, .true., x2, y2, status )
+      if( abs( x1 - x2 ) .lt. 1.0D-3 ) then
+         call stopit( 12355, ' ', status )
+      end if
+
+*  SIP headers. The inverse SIP transformation is fitted over the image
+*  area given by the NAXISi keywords, so a header with the same WCS
+*  keywords but different NAXISi values should not use the cached
+*  FrameSet. Read the same header twice with NAXISi = 100, and then
+*  once with NAXISi = 4000.
+      sipcards(1) = 'CTYPE1  = ''RA---TAN-SIP'''
+      sipcards(2) = 'CTYPE2  = ''DEC--TAN-SIP'''
+      sipcards(3) = 'A_ORDER =                    2'
+      sipcards(4) = 'A_0_2   =               2.0E-4'
+      sipcards(5) = 'B_ORDER =                    2'
+      sipcards(6) = 'B_2_0   =               2.0E-4'
+
+      cards(4) = 'CRVAL1  =                   45'
+      call ast_emptyfits( fc, status )
+      call ast_putfits( fc, 'NAXIS1  =                  100', .false.,
+     :                  status )
+      call ast_putfits( fc, 'NAXIS2  =                  100', .false.,
+     :                  status )
+      do i = 1, 7
+         call ast_putfits( fc, cards(i), .false., status )
+      end do
+      do i = 1, 6
+         call ast_putfits( fc, sipcards(i), .false., status )
+      end do
+      call ast_clear( fc, 'Card', status )
+      fs4 = ast_read( fc, status )
+
+      call ast_emptyfits( fc, status )
+      call ast_putfits( fc, 'NAXIS1  =                  100', .false.,
+     :                  status )
+      call ast_putfits( fc, 'NAXIS2  =                  100', .false.,
+     :                  status )
+      do i = 1, 7
+         call ast_putfits( fc, cards(i), .false., status )
+      end do
+      do i = 1, 6
+         call ast_putfits( fc, sipcards(i), .false., status )
+      end do
+      call ast_clear( fc, 'Card', status )
+      fs5 = ast_read( fc, status )
+
+      call ast_emptyfits( fc, status )
+      call ast_putfits( fc, 'NAXIS1  =                 4000', .false.,
+     :                  status )
+      call ast_putfits( fc, 'NAXIS2  =                 4000', .false.,
+     :                  status )
+      do i = 1, 7
+         call ast_putfits( fc, cards(i), .false., status )
+      end do
+      do i = 1, 6
+         call ast_putfits( fc, sipcards(i), .false., status )
+      end do
+      call ast_clear( fc, 'Card', status )
+      fs6 = ast_read( fc, status )
+      call ast_emptyfits( fc, status )
+
+      if( fs4 .eq. AST__NULL .or. fs5 .eq. AST__NULL .or.
+     :    fs6 .eq. AST__NULL ) then
+         call stopit( 12358, ' ', status )
+      end if
+
+*  Since the statistics were last reset there should have been misses
+*  for the header with a different CRVAL1, and for the first and third
+*  SIP headers, and a hit for the second SIP header.
+      km = ast_fitscachestats( .false., status )
+      if( .not. ast_mapget0i( km, 'Hits', hits, status ) .or.
+     :    .not. ast_mapget0i( km, 'Misses', misses, status ) ) then
+         call stopit( 12359, ' ', status )
+      else if( hits .ne. 1 .or. misses .ne. 3 ) then
+         call stopit( 12359, ' ', status )
+      end if
+      call ast_annul( km, status )
+
+*  Disable the cache again.
+      size = ast_tune( 'FitsCache', 0, status )
+      if( size .ne. 5 ) call stopit( 12356, ' ', status )
+
+      call ast_annul( fs1, status )
+      call ast_annul( fs2, status )
+      call ast_annul( fs3, status )
+      call ast_annul( fs4, status )
+      call ast_annul( fs5, status )
+      call ast_annul( fs6, status )
+
+      end
+
+
       subroutine test_fitsrounding( fc, status )
       implicit none
 
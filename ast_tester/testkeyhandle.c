@@ -0,0 +1,158 @@
+#define astCLASS testkeyhandle
+
+#include "ast_err.h"
+#include "error.h"
+#include "object.h"
+#include "keymap.h"
+#include "unitmap.h"
+#include "fitschan.h"
+#include <stdio.h>
+#include <string.h>
+
+int main(){
+   int status_value = 0;
+   int *status = &status_value;
+
+   AstFitsChan *fc;
+   AstKeyMap *km, *km2;
+   AstMapKeyHandle handle, handle2;
+   AstObject *obj;
+   AstUnitMap *um;
+   char key[ 20 ];
+   const char *cval;
+   double dval;
+   int i, ival;
+
+/* Store and retrieve a scalar value using a handle in a case-insensitive
+   KeyMap. */
+   km = astKeyMap( "KeyCase=0", status );
+   astMapKeyHandle( km, "Alpha ", &handle );
+   ival = 3;
+   astMapPut0H( km, &handle, AST__INTTYPE, &ival, "A comment" );
+   if( !astMapHasKeyH( km, &handle ) && astOK ) {
+      astError( AST__INTER, "Error 1\n", status );
+   }
+   if( ( !astMapGet0I( km, "ALPHA", &ival ) || ival != 3 ) && astOK ) {
+      astError( AST__INTER, "Error 2\n", status );
+   }
+   if( ( !astMapGet0H( km, &handle, AST__DOUBLETYPE, &dval ) ||
+         dval != 3.0 ) && astOK ) {
+      astError( AST__INTER, "Error 3\n", status );
+   }
+   if( strcmp( astMapKey( km, 0 ), "ALPHA" ) && astOK ) {
+      astError( AST__INTER, "Error 4 (%s)\n", status, astMapKey( km, 0 ) );
+   }
+
+/* Replace the value with a string, and check there is still one entry. */
+   cval = "text";
+   astMapPut0H( km, &handle, AST__STRINGTYPE, &cval, NULL );
+   if( astMapSize( km ) != 1 && astOK ) {
+      astError( AST__INTER, "Error 5\n", status );
+   }
+   if( ( !astMapGet0C( km, "alpha", &cval ) || strcmp( cval, "text" ) ) &&
+       astOK ) {
+      astError( AST__INTER, "Error 6\n", status );
+   }
+
+/* The handle remains usable after the hash table has grown. */
+   for( i = 0; i < 1000; i++ ) {
+      sprintf( key, "K%d", i );
+      astMapPut0I( km, key, i, NULL );
+   }
+   if( !astMapHasKeyH( km, &handle ) && astOK ) {
+      astError( AST__INTER, "Error 7\n", status );
+   }
+   astMapKeyHandle( km, "k500", &handle2 );
+   if( ( !astMapGet0H( km, &handle2, AST__INTTYPE, &ival ) || ival != 500 ) &&
+       astOK ) {
+      astError( AST__INTER, "Error 8\n", status );
+   }
+
+/* A handle created for a case-sensitive KeyMap can be used with a
+   case-insensitive KeyMap. */
+   km2 = astKeyMap( "KeyCase=1", status );
+   astMapKeyHandle( km2, "Alpha", &handle2 );
+   if( !astMapHasKeyH( km, &handle2 ) && astOK ) {
+      astError( AST__INTER, "Error 9\n", status );
+   }
+   if( astMapHasKeyH( km2, &handle2 ) && astOK ) {
+      astError( AST__INTER, "Error 10\n", status );
+   }
+
+/* Object values are cloned when stored and when retrieved. */
+   um = astUnitMap( 2, " ", status );
+   astMapPut0H( km2, &handle2, AST__OBJECTTYPE, &um, NULL );
+   if( astGetRefCount( um ) != 2 && astOK ) {
+      astError( AST__INTER, "Error 11 (%d)\n", status, astGetRefCount( um ) );
+   }
+   obj = NULL;
+   if( ( !astMapGet0H( km2, &handle2, AST__OBJECTTYPE, &obj ) ||
+         obj != (AstObject *) um ) && astOK ) {
+      astError( AST__INTER, "Error 12\n", status );
+   }
+   if( astGetRefCount( um ) != 3 && astOK ) {
+      astError( AST__INTER, "Error 13 (%d)\n", status, astGetRefCount( um ) );
+   }
+   obj = astAnnul( obj );
+   km2 = astAnnul( km2 );
+   if( astGetRefCount( um ) != 1 && astOK ) {
+      astError( AST__INTER, "Error 14 (%d)\n", status, astGetRefCount( um ) );
+   }
+
+/* FitsChan uses key handles to count the cards with each keyword name.
+   Check the counts are maintained as cards are added and deleted. */
+   fc = astFitsChan( NULL, NULL, " ", status );
+   astPutFits( fc, "A       =                    1", 0 );
+   astPutFits( fc, "B       =                    2", 0 );
+   astPutFits( fc, "A       =                    3", 0 );
+   astClearCard( fc );
+   if( !astFindFits( fc, "A", NULL, 0 ) && astOK ) {
+      astError( AST__INTER, "Error 15\n", status );
+   }
+   astDelFits( fc );
+   if( !astTestFits( fc, "A", NULL ) && astOK ) {
+      astError( AST__INTER, "Error 16\n", status );
+   }
+   astClearCard( fc );
+   if( !astFindFits( fc, "A", NULL, 0 ) && astOK ) {
+      astError( AST__INTER, "Error 17\n", status );
+   }
+   astDelFits( fc );
+   astClearCard( fc );
+   if( astTestFits( fc, "A", NULL ) && astOK ) {
+      astError( AST__INTER, "Error 18\n", status );
+   }
+   if( !astTestFits( fc, "B", NULL ) && astOK ) {
+      astError( AST__INTER, "Error 19\n", status );
+   }
+
+/* A handle created for a case-insensitive KeyMap uses the key as
+   originally supplied (not the upper case version) when used with a
+   case-sensitive KeyMap. */
+   km2 = astKeyMap( "KeyCase=1", status );
+   ival = 4;
+   astMapPut0H( km2, &handle, AST__INTTYPE, &ival, NULL );
+   if( !astMapHasKey( km2, "Alpha" ) && astOK ) {
+      astError( AST__INTER, "Error 20\n", status );
+   }
+   if( astMapHasKey( km2, "ALPHA" ) && astOK ) {
+      astError( AST__INTER, "Error 21\n", status );
+   }
+   if( ( !astMapGet0H( km2, &handle, AST__INTTYPE, &ival ) || ival != 4 ) &&
+       astOK ) {
+      astError( AST__INTER, "Error 22\n", status );
+   }
+   km2 = astAnnul( km2 );
+
+   fc = astAnnul( fc );
+   km = astAnnul( km );
+   um = astAnnul( um );
+
+
+   if( astOK ) {
+      printf(" All KeyMap key handle tests passed\n");
+   } else {
+      printf("KeyMap key handle tests failed\n");
+   }
+   return 0;
+}
@@ -0,0 +1,130 @@
+#include "ast.h"
+#include <stdio.h>
+#include <string.h>
+
+/* The number of pairs of characters in each colliding key, and the
+   resulting number of keys. */
+#define NPAIR 6
+#define NKEY 64
+
+/* Form the key with index "ikey". Each pair of characters is "@Q" or
+   "A0", depending on the corresponding bit of "ikey". These two pairs
+   have equal djb2 hash values (33*'@'+'Q' == 33*'A'+'0'), so all the
+   keys have the same hash value, and so are stored in the same element
+   of the KeyMap hash table however large the table is. */
+static void MakeKey( int ikey, char *key ){
+   int ipair;
+   for( ipair = 0; ipair < NPAIR; ipair++ ) {
+      strcpy( key + 2*ipair, ( ikey & ( 1 << ipair ) ) ? "A0" : "@Q" );
+   }
+}
+
+int main(){
+   AstKeyMap *km, *km2;
+   char key[ 2*NPAIR + 1 ];
+   char key2[ 2*NPAIR + 1 ];
+   int i, ival;
+
+   astBegin;
+
+/* Store entries for all the colliding keys in a case-insensitive KeyMap. */
+   km = astKeyMap( "KeyCase=0" );
+   for( i = 0; i < NKEY; i++ ) {
+      MakeKey( i, key );
+      astMapPut0I( km, key, i, NULL );
+   }
+   if( astMapSize( km ) != NKEY && astOK ) {
+      astError( AST__INTER, "Error 1 (%d)\n", astMapSize( km ) );
+   }
+
+/* Check each entry can be retrieved, in upper and lower case. */
+   for( i = 0; i < NKEY && astOK; i++ ) {
+      MakeKey( i, key );
+      if( !astMapGet0I( km, key, &ival ) || ival != i ) {
+         astError( AST__INTER, "Error 2 (key %s)\n", key );
+      }
+      key[ 1 ] = ( key[ 1 ] == 'Q' ) ? 'q' : key[ 1 ];
+      if( !astMapHasKey( km, key ) ) {
+         astError( AST__INTER, "Error 3 (key %s)\n", key );
+      }
+   }
+
+/* Check that keys which are not in the KeyMap are not found, including
+   a key that has the same hash value. */
+   if( astMapHasKey( km, "@QA0" ) && astOK ) {
+      astError( AST__INTER, "Error 4\n" );
+   }
+   if( astMapHasKey( km, "@Q@Q@Q@Q@Q@R" ) && astOK ) {
+      astError( AST__INTER, "Error 5\n" );
+   }
+
+/* Replace the value of one entry and remove every other entry. */
+   MakeKey( 1, key );
+   astMapPut0I( km, key, -1, NULL );
+   for( i = 0; i < NKEY; i += 2 ) {
+      MakeKey( i, key );
+      astMapRemove( km, key );
+   }
+   if( astMapSize( km ) != NKEY/2 && astOK ) {
+      astError( AST__INTER, "Error 6 (%d)\n", astMapSize( km ) );
+   }
+   for( i = 0; i < NKEY && astOK; i++ ) {
+      MakeKey( i, key );
+      if( i % 2 ) {
+         if( !astMapGet0I( km, key, &ival ) || ival != ( ( i == 1 ) ? -1 : i ) ) {
+            astError( AST__INTER, "Error 7 (key %s)\n", key );
+         }
+      } else if( astMapHasKey( km, key ) ) {
+         astError( AST__INTER, "Error 8 (key %s)\n", key );
+      }
+   }
+
+/* Rename an entry using one of the removed keys, and check a copy of
+   the KeyMap. */
+   MakeKey( 3, key );
+   MakeKey( 2, key2 );
+   astMapRename( km, key, key2 );
+   if( ( astMapHasKey( km, key ) || !astMapGet0I( km, key2, &ival ) ||
+         ival != 3 ) && astOK ) {
+      astError( AST__INTER, "Error 9\n" );
+   }
+
+   km2 = astCopy( km );
+   if( !astEqual( km, km2 ) && astOK ) {
+      astError( AST__INTER, "Error 10\n" );
+   }
+
+/* The keys are sorted correctly. The renamed key is the only remaining
+   key that starts with "@", so it should be first. */
+   astSet( km, "SortBy=KeyUp" );
+   if( strcmp( astMapKey( km, 0 ), key2 ) && astOK ) {
+      astError( AST__INTER, "Error 11 (%s)\n", astMapKey( km, 0 ) );
+   }
+
+/* Keys with equal hash values in a case-sensitive KeyMap. */
+   km2 = astAnnul( km2 );
+   km2 = astKeyMap( "KeyCase=1" );
+   astMapPut0I( km2, "Ab", 1, NULL );
+   astMapPut0I( km2, "BA", 2, NULL );
+   if( ( !astMapGet0I( km2, "Ab", &ival ) || ival != 1 ) && astOK ) {
+      astError( AST__INTER, "Error 12\n" );
+   }
+   if( ( !astMapGet0I( km2, "BA", &ival ) || ival != 2 ) && astOK ) {
+      astError( AST__INTER, "Error 13\n" );
+   }
+   if( astMapHasKey( km2, "AB" ) && astOK ) {
+      astError( AST__INTER, "Error 14\n" );
+   }
+   astMapRemove( km2, "BA" );
+   if( ( !astMapHasKey( km2, "Ab" ) || astMapHasKey( km2, "BA" ) ) && astOK ) {
+      astError( AST__INTER, "Error 15\n" );
+   }
+
+   astEnd;
+
+   if( astOK ) {
+      printf(" All KeyMap hashing tests passed\n");
+   } else {
+      printf("KeyMap hashing tests failed\n");
+   }
+}
@@ -0,0 +1,221 @@
+#define astCLASS testlazy
+
+#include "ast_err.h"
+#include "error.h"
+#include "object.h"
+#include "channel.h"
+#include "frame.h"
+#include "skyframe.h"
+#include "frameset.h"
+#include "unitmap.h"
+#include "zoommap.h"
+#include "shiftmap.h"
+#include "circle.h"
+#include <stdio.h>
+#include <string.h>
+
+int main(){
+   int status_value = 0;
+   int *status = &status_value;
+
+   AstChannel *ch;
+   AstCircle *circle;
+   AstFrame *frm, *frm2;
+   AstFrameSet *fs, *fse, *fsl, *fs2;
+   AstMapping *map;
+   AstObject *obj;
+   double centre[ 2 ] = { 0.1, 0.2 };
+   double radius = 0.01;
+   double shift[ 2 ] = { 1.0, 2.0 };
+   double xin, yin, xout, yout, xout2, yout2;
+   int binary, iframe;
+   size_t size0, size1;
+
+/* Create a FrameSet with three Frames and two Mappings. */
+   fs = astFrameSet( astFrame( 2, "Domain=PIXEL", status ), " ", status );
+   astAddFrame( fs, AST__BASE, astZoomMap( 2, 0.1, " ", status ),
+                astSkyFrame( " ", status ) );
+   astAddFrame( fs, AST__CURRENT, astShiftMap( 2, shift, " ", status ),
+                astFrame( 2, "Domain=A", status ) );
+
+/* Create a Circle. Only the contents of FrameSets are deferred, so the
+   Frame and PointSet within the Circle should be created when it is
+   read, even if the Channel is in lazy mode. */
+   circle = astCircle( astSkyFrame( " ", status ), 1, centre, &radius,
+                       NULL, " ", status );
+
+/* Do the tests using both text and binary files. */
+   for( binary = 0; binary < 2 && astOK; binary++ ) {
+      ch = astChannel( NULL, NULL, "SinkFile=./testlazy.dat", status );
+      astSetI( ch, "Binary", binary );
+      if( astWrite( ch, fs ) != 1 && astOK ) {
+         astError( AST__INTER, "Error 1\n", status );
+      }
+      astClear( ch, "SinkFile" );
+
+/* Read the FrameSet normally and lazily. Initially, none of the Frames
+   or Mappings in the lazily read FrameSet should have been created, so
+   its size (which includes the serialised forms) should differ from the
+   normal FrameSet. */
+      astSetC( ch, "SourceFile", "./testlazy.dat" );
+      fse = astRead( ch );
+      astSetI( ch, "Lazy", 1 );
+      astSetC( ch, "SourceFile", "./testlazy.dat" );
+      fsl = astRead( ch );
+      if( astOK && ( !fse || !fsl ) ) {
+         astError( AST__INTER, "Error 2\n", status );
+         break;
+      }
+      size0 = astGetObjSize( fsl );
+      if( size0 == astGetObjSize( fse ) && astOK ) {
+         astError( AST__INTER, "Error 3\n", status );
+      }
+      if( astGetNframe( fsl ) != 3 && astOK ) {
+         astError( AST__INTER, "Error 4\n", status );
+      }
+      if( astGetObjSize( fsl ) != size0 && astOK ) {
+         astError( AST__INTER, "Error 5\n", status );
+      }
+
+/* Getting the current Frame should create it, changing the size of the
+   FrameSet. Getting it again should not change the size. */
+      frm = astGetFrame( fsl, AST__CURRENT );
+      frm2 = astGetFrame( fse, AST__CURRENT );
+      if( !astEqual( frm, frm2 ) && astOK ) {
+         astError( AST__INTER, "Error 6\n", status );
+      }
+      frm = astAnnul( frm );
+      frm2 = astAnnul( frm2 );
+      size1 = astGetObjSize( fsl );
+      if( size1 == size0 && astOK ) {
+         astError( AST__INTER, "Error 7\n", status );
+      }
+      frm = astGetFrame( fsl, AST__CURRENT );
+      frm = astAnnul( frm );
+      if( astGetObjSize( fsl ) != size1 && astOK ) {
+         astError( AST__INTER, "Error 8\n", status );
+      }
+
+/* Getting the Mapping from the base to the current Frame should create
+   both Mappings. */
+      map = astGetMapping( fsl, AST__BASE, AST__CURRENT );
+      xin = 10.0;
+      yin = 20.0;
+      astTran2( map, 1, &xin, &yin, 1, &xout, &yout );
+      if( ( xout != 2.0 || yout != 4.0 ) && astOK ) {
+         astError( AST__INTER, "Error 9\n", status );
+      }
+      map = astAnnul( map );
+      if( astGetObjSize( fsl ) == size1 && astOK ) {
+         astError( AST__INTER, "Error 10\n", status );
+      }
+
+/* Comparing the whole FrameSet should create everything else, as
+   should adding a Frame. Getting each Frame should then leave the size
+   of the FrameSet unchanged. */
+      if( !astEqual( fse, fsl ) && astOK ) {
+         astError( AST__INTER, "Error 11\n", status );
+      }
+      fs2 = astCopy( fse );
+      astAddFrame( fs2, AST__BASE, astUnitMap( 2, " ", status ),
+                   astFrame( 2, "Domain=C", status ) );
+      astAddFrame( fsl, AST__BASE, astUnitMap( 2, " ", status ),
+                   astFrame( 2, "Domain=C", status ) );
+      size0 = astGetObjSize( fsl );
+      for( iframe = 1; iframe <= 4; iframe++ ) {
+         frm = astGetFrame( fsl, iframe );
+         frm = astAnnul( frm );
+      }
+      if( astGetObjSize( fsl ) != size0 && astOK ) {
+         astError( AST__INTER, "Error 12\n", status );
+      }
+      if( !astEqual( fs2, fsl ) && astOK ) {
+         astError( AST__INTER, "Error 13\n", status );
+      }
+      fs2 = astAnnul( fs2 );
+      fsl = astAnnul( fsl );
+
+/* Read the FrameSet lazily again, and add a new Frame to it without
+   accessing anything first. The result should be the same as adding
+   the Frame to the normal FrameSet. */
+      astSetC( ch, "SourceFile", "./testlazy.dat" );
+      fsl = astRead( ch );
+      fs2 = astCopy( fse );
+      astAddFrame( fs2, 2, astZoomMap( 2, 3.0, " ", status ),
+                   astFrame( 2, "Domain=B", status ) );
+      astAddFrame( fsl, 2, astZoomMap( 2, 3.0, " ", status ),
+                   astFrame( 2, "Domain=B", status ) );
+      if( astOK && ( astGetNframe( fsl ) != 4 || !astEqual( fs2, fsl ) ) ) {
+         astError( AST__INTER, "Error 14\n", status );
+      }
+
+/* Remove the original current Frame from both, and check the new
+   current Frame and the total Mapping. */
+      astRemoveFrame( fs2, 3 );
+      astRemoveFrame( fsl, 3 );
+      if( astOK && ( astGetNframe( fsl ) != 3 || !astEqual( fs2, fsl ) ||
+                     strcmp( astGetDomain( fsl ), "B" ) ) ) {
+         astError( AST__INTER, "Error 15\n", status );
+      }
+      astTran2( fsl, 1, &xin, &yin, 1, &xout, &yout );
+      astTran2( fs2, 1, &xin, &yin, 1, &xout2, &yout2 );
+      if( astOK && ( xout != 3.0 || yout != 6.0 || xout != xout2 ||
+                     yout != yout2 ) ) {
+         astError( AST__INTER, "Error 16\n", status );
+      }
+      fs2 = astAnnul( fs2 );
+      fsl = astAnnul( fsl );
+
+/* Read it lazily once more and remove the base Frame before accessing
+   anything. The remaining Mapping should be the ShiftMap. */
+      astSetC( ch, "SourceFile", "./testlazy.dat" );
+      fsl = astRead( ch );
+      astRemoveFrame( fsl, AST__BASE );
+      if( astOK && astGetNframe( fsl ) != 2 ) {
+         astError( AST__INTER, "Error 17\n", status );
+      }
+      xin = 1.0;
+      yin = 2.0;
+      astTran2( fsl, 1, &xin, &yin, 1, &xout, &yout );
+      if( astOK && ( xout != 2.0 || yout != 4.0 ) ) {
+         astError( AST__INTER, "Error 18\n", status );
+      }
+      fsl = astAnnul( fsl );
+      fse = astAnnul( fse );
+
+/* Check a lazily read Circle is the same as a normally read Circle. */
+      astClear( ch, "SourceFile" );
+      astSetC( ch, "SinkFile", "./testlazy.dat" );
+      astWrite( ch, circle );
+      astClear( ch, "SinkFile" );
+      astSetC( ch, "SourceFile", "./testlazy.dat" );
+      obj = astRead( ch );
+      if( astOK && !obj ) {
+         astError( AST__INTER, "Error 19\n", status );
+      } else if( astOK && !astEqual( obj, circle ) ) {
+         astError( AST__INTER, "Error 20\n", status );
+      }
+      size0 = obj ? astGetObjSize( obj ) : 0;
+      if( obj ) obj = astAnnul( obj );
+
+      astSetI( ch, "Lazy", 0 );
+      astSetC( ch, "SourceFile", "./testlazy.dat" );
+      obj = astRead( ch );
+      if( obj && astGetObjSize( obj ) != size0 && astOK ) {
+         astError( AST__INTER, "Error 21\n", status );
+      }
+      if( obj ) obj = astAnnul( obj );
+      ch = astAnnul( ch );
+   }
+
+   fs = astAnnul( fs );
+   circle = astAnnul( circle );
+   remove( "./testlazy.dat" );
+
+   if( astOK ) {
+      printf(" All lazy FrameSet reading tests passed\n");
+   } else {
+      printf("Lazy FrameSet reading tests failed\n");
+   }
+   return *status;
+}
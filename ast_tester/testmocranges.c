@@ -0,0 +1,329 @@
+#include "ast.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <inttypes.h>
+
+#define NCELL 20000
+
+/* A memory buffer holding the text exchanged with a MocChan. */
+static char *text = NULL;
+static size_t tlen = 0;
+static size_t tpos = 0;
+static char *line = NULL;
+
+static const char *Source( void ){
+   size_t nc;
+   if( tpos >= tlen ) return NULL;
+   nc = strcspn( text + tpos, "\n" );
+   line = astStore( line, text + tpos, nc + 1 );
+   if( astOK ) line[ nc ] = 0;
+   tpos += nc + 1;
+   return line;
+}
+
+static void Sink( const char *l ){
+   size_t nc = strlen( l );
+   text = astGrow( text, tlen + nc + 2, 1 );
+   if( astOK ) {
+      memcpy( text + tlen, l, nc );
+      tlen += nc;
+      text[ tlen++ ] = '\n';
+      text[ tlen ] = 0;
+   }
+}
+
+/* Combine two lists of ranges at order 20 and check the result. */
+static void Combine( int na, const int64_t *ra, int nb, const int64_t *rb,
+                     int cmode, int negate, int nexp, const int64_t *rexp,
+                     int ierr ){
+   AstMoc *moc;
+   int64_t r[ 20 ];
+   int i;
+   int nrange;
+
+   moc = astMoc( "MaxOrder=20" );
+   astAddMocRanges( moc, AST__OR, 0, 20, na, ra );
+   astAddMocRanges( moc, cmode, negate, 20, nb, rb );
+   astGetMocRanges( moc, 10, &nrange, r );
+   if( astOK ) {
+      if( nrange != nexp ) {
+         astError( AST__INTER, "Error %d: %d ranges\n", ierr, nrange );
+      } else {
+         for( i = 0; i < 2*nrange; i++ ) {
+            if( r[ i ] != rexp[ i ] ) {
+               astError( AST__INTER, "Error %d: element %d is %" PRId64
+                         "\n", ierr, i, r[ i ] );
+               break;
+            }
+         }
+      }
+   }
+   moc = astAnnul( moc );
+}
+
+/* Error handler used to suppress expected error messages. */
+static int nerr = 0;
+static void QuietPutErr( int status_value, const char *message ){
+   nerr++;
+}
+
+int main(){
+   AstMoc *moc1;
+   AstMoc *moc2;
+   AstMoc *moc3;
+   AstMocChan *chan;
+   int64_t *data;
+   int64_t *ranges;
+   int64_t npix;
+   int64_t r[ 4 ];
+   int i;
+   int nrange;
+   int ok;
+
+   astBegin;
+
+/* Read a string-encoded MOC containing two very large ranges of cells. */
+   chan = astMocChan( Source, Sink, "MocFormat=string" );
+   Sink( "20/0-100000000 20/200000000-300000000" );
+   moc1 = astRead( chan );
+   if( astOK ) {
+      if( !moc1 || !astIsAMoc( moc1 ) ) {
+         astError( AST__INTER, "Error 1\n" );
+      } else {
+         astGetMocRanges( moc1, 0, &nrange, NULL );
+         if( nrange != 2 && astOK ) {
+            astError( AST__INTER, "Error 2: %d\n", nrange );
+         }
+         astGetMocRanges( moc1, 2, &nrange, r );
+         if( astOK && ( r[ 0 ] != 0 || r[ 1 ] != 100000000 ||
+                        r[ 2 ] != 200000000 || r[ 3 ] != 300000000 ) ) {
+            astError( AST__INTER, "Error 3\n" );
+         }
+         if( astGetI( moc1, "MaxOrder" ) != 20 && astOK ) {
+            astError( AST__INTER, "Error 4\n" );
+         }
+      }
+   }
+
+/* Create the same Moc from the ranges, and check they are equal. */
+   moc2 = astMoc( " " );
+   astAddMocRanges( moc2, AST__OR, 0, 20, 2, r );
+   if( !astEqual( moc1, moc2 ) && astOK ) {
+      astError( AST__INTER, "Error 5\n" );
+   }
+
+/* Check an error is reported if the supplied array is too small. */
+   if( astOK ) {
+      nerr = 0;
+      astSetPutErr( QuietPutErr );
+      astGetMocRanges( moc1, 1, &nrange, r );
+      ok = astOK;
+      astClearStatus;
+      astSetPutErr( NULL );
+      if( ok || nerr == 0 ) astError( AST__INTER, "Error 6\n" );
+   }
+
+/* Check an error is reported for an invalid range, and that the Moc is
+   left unchanged. */
+   if( astOK ) {
+      r[ 0 ] = 10;
+      r[ 1 ] = 5;
+      nerr = 0;
+      astSetPutErr( QuietPutErr );
+      astAddMocRanges( moc2, AST__OR, 0, 20, 1, r );
+      ok = astOK;
+      astClearStatus;
+      astSetPutErr( NULL );
+      if( ok || nerr == 0 ) {
+         astError( AST__INTER, "Error 7\n" );
+      } else if( !astEqual( moc1, moc2 ) && astOK ) {
+         astError( AST__INTER, "Error 8\n" );
+      }
+   }
+   moc1 = astAnnul( moc1 );
+   moc2 = astAnnul( moc2 );
+
+/* Ranges at a lower order than MaxOrder are expanded, and ranges at a
+   higher order are degraded. */
+   moc1 = astMoc( "MaxOrder=10" );
+   r[ 0 ] = 3;
+   r[ 1 ] = 4;
+   astAddMocRanges( moc1, AST__OR, 0, 9, 1, r );
+   r[ 0 ] = 16*( 12 + 4*1000 ) + 1;
+   r[ 1 ] = 16*( 12 + 4*1000 ) + 2;
+   astAddMocRanges( moc1, AST__OR, 0, 12, 1, r );
+   moc2 = astMoc( " " );
+   astAddCell( moc2, AST__OR, 10, 12 + 4*1000 );
+   astAddCell( moc2, AST__OR, 9, 3 );
+   astAddCell( moc2, AST__OR, 9, 4 );
+   if( !astEqual( moc1, moc2 ) && astOK ) {
+      astError( AST__INTER, "Error 9\n" );
+   }
+
+/* Negating the ranges and combining with AST__AND removes the cells. */
+   r[ 0 ] = 3;
+   r[ 1 ] = 3;
+   astAddMocRanges( moc1, AST__AND, 1, 9, 1, r );
+   moc3 = astMoc( " " );
+   astAddCell( moc3, AST__OR, 10, 12 + 4*1000 );
+   astAddCell( moc3, AST__OR, 9, 4 );
+   if( !astEqual( moc1, moc3 ) && astOK ) {
+      astError( AST__INTER, "Error 10\n" );
+   }
+   moc1 = astAnnul( moc1 );
+   moc2 = astAnnul( moc2 );
+   moc3 = astAnnul( moc3 );
+
+/* Create a Moc from a long list of unsorted and overlapping cells, and
+   check it matches the Moc created by adding the cells one at a time. */
+   data = astMalloc( NCELL*sizeof( *data ) );
+   if( astOK ) {
+      srand( 3 );
+      npix = 0;
+      for( i = 0; i < NCELL; i++ ) {
+         npix += 1 + ( rand() % 3 == 0 ? rand() % 5 : 0 );
+         data[ i ] = 4*( (int64_t) 1 << 26 ) + npix;
+      }
+      for( i = 0; i < NCELL; i += 50 ) {
+         npix = data[ i ];
+         data[ i ] = data[ NCELL - 1 - i ];
+         data[ NCELL - 1 - i ] = npix;
+      }
+      data[ 10 ] = data[ 20 ];
+      data[ 30 ] = 4*( (int64_t) 1 << 22 ) +
+                   ( ( data[ 40 ] - 4*( (int64_t) 1 << 26 ) ) >> 4 );
+   }
+
+   moc1 = astMoc( " " );
+   astAddMocData( moc1, AST__OR, 0, -1, NCELL, 8, data );
+   moc2 = astMoc( "MaxOrder=13" );
+   for( i = 0; i < NCELL && astOK; i++ ) {
+      if( data[ i ] >= 4*( (int64_t) 1 << 26 ) ) {
+         astAddCell( moc2, AST__OR, 13, data[ i ] - 4*( (int64_t) 1 << 26 ) );
+      } else {
+         astAddCell( moc2, AST__OR, 11, data[ i ] - 4*( (int64_t) 1 << 22 ) );
+      }
+   }
+   if( !astEqual( moc1, moc2 ) && astOK ) {
+      astError( AST__INTER, "Error 11\n" );
+   }
+
+/* Copy the ranges into a new Moc and check it is equal. */
+   astGetMocRanges( moc1, 0, &nrange, NULL );
+   ranges = astMalloc( 2*nrange*sizeof( *ranges ) );
+   astGetMocRanges( moc1, nrange, &nrange, ranges );
+   moc3 = astMoc( " " );
+   astAddMocRanges( moc3, AST__OR, 0, astGetI( moc1, "MaxOrder" ), nrange,
+                    ranges );
+   if( !astEqual( moc1, moc3 ) && astOK ) {
+      astError( AST__INTER, "Error 12\n" );
+   }
+   ranges = astFree( ranges );
+   moc3 = astAnnul( moc3 );
+
+/* Write the Moc out as a string and as JSON, and read each back. */
+   tlen = tpos = 0;
+   astWrite( chan, moc1 );
+   moc3 = astRead( chan );
+   if( astOK && ( !moc3 || !astEqual( moc1, moc3 ) ) ) {
+      astError( AST__INTER, "Error 13\n" );
+   }
+   if( moc3 ) moc3 = astAnnul( moc3 );
+
+   tlen = tpos = 0;
+   astSet( chan, "MocFormat=json" );
+   astWrite( chan, moc1 );
+   moc3 = astRead( chan );
+   if( astOK && ( !moc3 || !astEqual( moc1, moc3 ) ) ) {
+      astError( AST__INTER, "Error 14\n" );
+   }
+   if( moc3 ) moc3 = astAnnul( moc3 );
+
+/* Check the combination of two lists of ranges. */
+   {
+      int64_t ra[ 6 ] = { 0, 99, 200, 299, 400, 499 };
+      int64_t rb[ 6 ] = { 50, 249, 450, 450, 1000, 1000 };
+      int64_t ror[ 6 ] = { 0, 299, 400, 499, 1000, 1000 };
+      int64_t rboth[ 6 ] = { 50, 99, 200, 249, 450, 450 };
+      int64_t rxor[ 12 ] = { 0, 49, 100, 199, 250, 299, 400, 449, 451, 499,
+                             1000, 1000 };
+      int64_t rdiff[ 8 ] = { 0, 49, 250, 299, 400, 449, 451, 499 };
+      int64_t rone[ 2 ] = { 10, 20 };
+      int64_t rall[ 2 ] = { 0, 12*( (int64_t) 1 << 40 ) - 1 };
+      int64_t rnot[ 6 ] = { 100, 199, 300, 399, 500,
+                            12*( (int64_t) 1 << 40 ) - 1 };
+
+      Combine( 3, ra, 3, rb, AST__OR, 0, 3, ror, 15 );
+      Combine( 3, ra, 3, rb, AST__AND, 0, 3, rboth, 16 );
+      Combine( 3, ra, 3, rb, AST__XOR, 0, 6, rxor, 17 );
+      Combine( 3, ra, 3, rb, AST__AND, 1, 4, rdiff, 18 );
+      Combine( 3, rb, 3, ra, AST__OR, 0, 3, ror, 19 );
+      Combine( 3, rb, 3, ra, AST__AND, 0, 3, rboth, 20 );
+      Combine( 3, rb, 3, ra, AST__XOR, 0, 6, rxor, 21 );
+
+/* The intersection of an empty Moc and a single range is empty. */
+      Combine( 0, NULL, 1, rone, AST__AND, 0, 0, NULL, 22 );
+
+/* A negated empty list of ranges covers the whole sky. */
+      Combine( 3, ra, 0, NULL, AST__OR, 1, 1, rall, 26 );
+      Combine( 3, ra, 0, NULL, AST__AND, 1, 3, ra, 27 );
+      Combine( 3, ra, 0, NULL, AST__XOR, 1, 3, rnot, 28 );
+   }
+
+/* Adding a negated empty list of ranges to a Moc with no MaxOrder sets
+   MaxOrder and fills the whole sky. */
+   moc2 = astMoc( " " );
+   astAddMocRanges( moc2, AST__OR, 1, 3, 0, NULL );
+   astGetMocRanges( moc2, 1, &nrange, r );
+   if( astOK ) {
+      if( astGetI( moc2, "MaxOrder" ) != 3 ) {
+         astError( AST__INTER, "Error 29\n" );
+      } else if( nrange != 1 || r[ 0 ] != 0 || r[ 1 ] != 12*64 - 1 ) {
+         astError( AST__INTER, "Error 30\n" );
+      }
+   }
+   moc2 = astAnnul( moc2 );
+
+/* Intersect the large Moc with a single range covering part of it, and
+   remove a single range from it. */
+   moc2 = astCopy( moc1 );
+   astGetMocRanges( moc1, 0, &nrange, NULL );
+   ranges = astMalloc( 2*nrange*sizeof( *ranges ) );
+   astGetMocRanges( moc1, nrange, &nrange, ranges );
+   if( astOK ) {
+      r[ 0 ] = ranges[ 2*100 ];
+      r[ 1 ] = ranges[ 2*200 + 1 ];
+      astAddMocRanges( moc1, AST__AND, 0, 13, 1, r );
+      astGetMocRanges( moc1, 0, &i, NULL );
+      if( i != 101 && astOK ) {
+         astError( AST__INTER, "Error 23: %d\n", i );
+      }
+
+      astAddMocRanges( moc2, AST__AND, 1, 13, 1, r );
+      astGetMocRanges( moc2, 0, &i, NULL );
+      if( i != nrange - 101 && astOK ) {
+         astError( AST__INTER, "Error 24: %d\n", i );
+      }
+
+      astAddMocRanges( moc2, AST__OR, 0, 13, 1, r );
+      astGetMocRanges( moc2, nrange, &i, ranges );
+      if( i != nrange - 100 && astOK ) {
+         astError( AST__INTER, "Error 25: %d\n", i );
+      }
+   }
+   ranges = astFree( ranges );
+   moc2 = astAnnul( moc2 );
+
+   data = astFree( data );
+   text = astFree( text );
+   line = astFree( line );
+   astEnd;
+
+   if( astOK ) {
+      printf(" All Moc range tests passed\n");
+   } else {
+      printf("Moc range tests failed\n");
+   }
+}
@@ -108,10 +108,91 @@ int main(){
       }
       km = astAnnul( km );
 
+      km = astMemoryUsage( 0 );
+      if( !km && astOK ) {
+         astError( AST__INTER, "Error 39\n" );
+      } else {
+         AstKeyMap *km2;
+         AstKeyMap *km3;
+         int nobj;
+         int64_t nbyte;
+
+         if( !astMapGet0A( km, "Classes", &km2 ) && astOK ) {
+            astError( AST__INTER, "Error 391\n" );
+         } else {
+            if( !astMapGet0A( km2, "FrameSet", &km3 ) && astOK ) {
+               astError( AST__INTER, "Error 392\n" );
+            } else {
+               if( ( !astMapGet0I( km3, "Nobject", &nobj ) || nobj < 2 ) && astOK ) {
+                  astError( AST__INTER, "Error 393 (%d)\n", nobj );
+               }
+               if( ( !astMapGet0K( km3, "Bytes", &nbyte ) || nbyte <= 0 ) && astOK ) {
+                  astError( AST__INTER, "Error 394\n" );
+               }
+               km3 = astAnnul( km3 );
+            }
+            km2 = astAnnul( km2 );
+         }
+
+         if( !astMapGet0A( km, "Routines", &km2 ) && astOK ) {
+            astError( AST__INTER, "Error 395\n" );
+         } else {
+            if( !astMapGet0A( km2, "main", &km3 ) && astOK ) {
+               astError( AST__INTER, "Error 396\n" );
+            } else {
+               if( ( !astMapGet0I( km3, "Nobject", &nobj ) || nobj != 4 ) && astOK ) {
+                  astError( AST__INTER, "Error 397 (%d)\n", nobj );
+               }
+               km3 = astAnnul( km3 );
+            }
+            km2 = astAnnul( km2 );
+         }
+      }
+      km = astAnnul( km );
+
    } else if( astOK ){
       astError( AST__INTER, "Error 4\n"  );
    }
 
+/* Test re-use of large memory blocks retained in the pool controlled by
+   the MemoryPool tuning parameter. Two blocks of 40000 bytes fit into a
+   100 KB pool, but only one fits into a 50 KB pool. */
+   if( astOK ) {
+      void *p1, *p2, *p3;
+
+      if( astTune( "MemoryPool", 100 ) != 0 && astOK ) {
+         astError( AST__INTER, "Error 40\n" );
+      }
+
+      p1 = astMalloc( 40000 );
+      (void) astFree( p1 );
+      p = astMalloc( 40000 );
+      if( p != p1 && astOK ) {
+         astError( AST__INTER, "Error 41\n" );
+      }
+
+      p2 = astMalloc( 40000 );
+      p3 = astMalloc( 40000 );
+      (void) astFree( p2 );
+      (void) astFree( p3 );
+      if( astTune( "MemoryPool", 50 ) != 100 && astOK ) {
+         astError( AST__INTER, "Error 42\n" );
+      }
+
+/* The most recently freed block (p3) should have been released by the
+   trim, leaving p2 in the pool. */
+      p1 = astMalloc( 40000 );
+      if( p1 != p2 && astOK ) {
+         astError( AST__INTER, "Error 43\n" );
+      }
+
+      p = astFree( p );
+      p1 = astFree( p1 );
+      if( astTune( "MemoryPool", 0 ) != 50 && astOK ) {
+         astError( AST__INTER, "Error 44\n" );
+      }
+   }
+
    if( astOK ) {
       printf(" All Object tests passed\n");
    } else {
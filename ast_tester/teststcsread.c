@@ -0,0 +1,179 @@
+#include "ast.h"
+#include <stdio.h>
+#include <string.h>
+#include <math.h>
+
+#define NVERT 2000
+
+/* The lines of the STC-S document to be read. */
+static char lines[ NVERT + 2 ][ 80 ];
+static int nline = 0;
+static int iline = 0;
+
+static const char *Source( void ){
+   return ( iline < nline ) ? lines[ iline++ ] : NULL;
+}
+
+/* Error handler used to suppress expected error messages. */
+static int nerr = 0;
+static char lastmsg[ 300 ];
+static void QuietPutErr( int status_value, const char *message ){
+   nerr++;
+   strncpy( lastmsg, message, sizeof( lastmsg ) - 1 );
+}
+
+/* Return the vertex positions (in degrees) used for the test polygon. */
+static void Vertex( int i, double *ra, double *dec ){
+   double a = 2*AST__DPI*( NVERT - i )/NVERT;
+   *ra = 150.0 + 0.5*cos( a );
+   *dec = 2.0 + 0.5*sin( a );
+}
+
+int main(){
+   AstKeyMap *km;
+   AstKeyMap *props;
+   AstObject *obj;
+   AstObject *area;
+   AstStcsChan *chan;
+   const char *text;
+   double in[ 2 ][ 2 ] = { { 150.0*AST__DD2R, 150.0*AST__DD2R },
+                           { 2.0*AST__DD2R, 3.0*AST__DD2R } };
+   double out[ 2 ][ 2 ];
+   double *pts;
+   double dec;
+   double ra;
+   int i;
+   int npoint;
+   int ncoord;
+
+   astBegin;
+
+/* Create a document holding a Polygon with many vertices, spread over
+   many lines. Include values with exponents, leading signs and missing
+   leading or trailing digits. */
+   strcpy( lines[ nline++ ], "Polygon ICRS" );
+   for( i = 0; i < NVERT; i++ ) {
+      Vertex( i, &ra, &dec );
+      if( i == 1 ) {
+         sprintf( lines[ nline++ ], "   %.15e +%.15E", ra, dec );
+      } else {
+         sprintf( lines[ nline++ ], "   %.15g %.15g", ra, dec );
+      }
+   }
+   strcpy( lines[ 3 ], "   150.5 2." );
+   strcpy( lines[ 4 ], "   1.505e+2 .2E1" );
+
+/* Read it and check the vertices are correct. */
+   chan = astStcsChan( Source, NULL, " " );
+   obj = astRead( chan );
+   if( astOK ) {
+      if( !obj || !astIsAPolygon( obj ) ) {
+         astError( AST__INTER, "Error 1\n" );
+      } else {
+         ncoord = 2;
+         pts = astMalloc( sizeof( double )*NVERT*ncoord );
+         astGetRegionPoints( obj, NVERT, ncoord, &npoint, pts );
+         if( npoint != NVERT && astOK ) {
+            astError( AST__INTER, "Error 2: %d\n", npoint );
+         } else {
+            for( i = 0; i < npoint && astOK; i++ ) {
+               Vertex( i, &ra, &dec );
+               if( i == 2 || i == 3 ) {
+                  ra = 150.5;
+                  dec = 2.0;
+               }
+               if( fabs( pts[ i ]*AST__DR2D - ra ) > 1.0E-12 ||
+                   fabs( pts[ i + npoint ]*AST__DR2D - dec ) > 1.0E-12 ) {
+                  astError( AST__INTER, "Error 3: vertex %d (%.15g,%.15g) "
+                            "!= (%.15g,%.15g)\n", i, pts[ i ]*AST__DR2D,
+                            pts[ i + npoint ]*AST__DR2D, ra, dec );
+               }
+            }
+         }
+         pts = astFree( pts );
+
+         astTran2( obj, 2, in[ 0 ], in[ 1 ], 1, out[ 0 ], out[ 1 ] );
+         if( astOK && ( out[ 0 ][ 0 ] == AST__BAD ||
+                        out[ 0 ][ 1 ] != AST__BAD ) ) {
+            astError( AST__INTER, "Error 4\n" );
+         }
+      }
+   }
+   if( obj ) obj = astAnnul( obj );
+
+/* Read it again, this time returning the properties. The textual form
+   of the vertex list should be included in the spatial properties. */
+   iline = 0;
+   astSetL( chan, "StcsProps", 1 );
+   km = (AstKeyMap *) astRead( chan );
+   if( astOK ) {
+      if( !km || !astIsAKeyMap( km ) ) {
+         astError( AST__INTER, "Error 5\n" );
+      } else if( !astMapGet0A( km, "AREA", &area ) ||
+                 !astMapGet0A( km, "PROPS", &obj ) ) {
+         astError( AST__INTER, "Error 6\n" );
+      } else {
+         props = (AstKeyMap *) obj;
+         if( astMapGet0A( props, "SPACE_PROPS", &obj ) ) {
+            props = astAnnul( props );
+            props = (AstKeyMap *) obj;
+         }
+         if( !astMapGet0C( props, "VERTICES", &text ) ||
+             strncmp( text, "150.5 2 ", 8 ) ||
+             !strstr( text, " 150.5 2. 1.505e+2 .2E1 " ) ) {
+            astError( AST__INTER, "Error 7\n" );
+         }
+         if( astOK && astMapLength( props, "DVERTICES" ) != 2*NVERT ) {
+            astError( AST__INTER, "Error 8\n" );
+         }
+         area = astAnnul( area );
+         props = astAnnul( props );
+      }
+   }
+   if( km ) km = astAnnul( km );
+
+/* Check that a PositionInterval gets the correct upper limits. */
+   strcpy( lines[ 0 ], "PositionInterval ICRS 10 20 11.5 2.25e1" );
+   nline = 1;
+   iline = 0;
+   astSetL( chan, "StcsProps", 0 );
+   obj = astRead( chan );
+   if( astOK ) {
+      double lbnd[ 2 ], ubnd[ 2 ];
+      if( !obj || !astIsABox( obj ) ) {
+         astError( AST__INTER, "Error 9\n" );
+      } else {
+         astGetRegionBounds( obj, lbnd, ubnd );
+         if( fabs( ubnd[ 0 ]*AST__DR2D - 11.5 ) > 1.0E-10 ||
+             fabs( ubnd[ 1 ]*AST__DR2D - 22.5 ) > 1.0E-10 ) {
+            astError( AST__INTER, "Error 10: %g %g\n", ubnd[ 0 ]*AST__DR2D,
+                      ubnd[ 1 ]*AST__DR2D );
+         }
+      }
+   }
+   if( obj ) obj = astAnnul( obj );
+
+/* Check an error is reported for an invalid vertex value, and that the
+   message includes the preceding words. */
+   strcpy( lines[ 0 ], "Polygon ICRS 10 20 11 20 11 1.2.3 10 21" );
+   iline = 0;
+   if( astOK ) {
+      astSetPutErr( QuietPutErr );
+      obj = astRead( chan );
+      astSetPutErr( NULL );
+      if( obj || astOK || nerr == 0 || !strstr( lastmsg, "'1.2.3'" ) ||
+          !strstr( lastmsg, "Polygon ICRS 10 20 11 20 11 1.2.3" ) ) {
+         if( astOK ) astError( AST__INTER, "Error 11: %s\n", lastmsg );
+      } else {
+         astClearStatus;
+      }
+   }
+
+   astEnd;
+
+   if( astOK ) {
+      printf(" All StcsChan reading tests passed\n");
+   } else {
+      printf("StcsChan reading tests failed\n");
+   }
+}
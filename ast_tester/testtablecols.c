@@ -0,0 +1,167 @@
+#define astCLASS testtablecols
+
+#include "ast_err.h"
+#include "error.h"
+#include "object.h"
+#include "keymap.h"
+#include "table.h"
+#include <stdio.h>
+#include <string.h>
+
+/* Error handler used to suppress expected error messages. */
+static int nerr = 0;
+static void QuietPutErr( int status_value, const char *message ){
+   nerr++;
+}
+
+int main(){
+   int status_value = 0;
+   int *status = &status_value;
+
+   AstTable *table;
+   char valid[ 10 ];
+   char valid_in[ 10 ];
+   double dval;
+   double dvals[ 10 ];
+   double dvals_in[ 10 ];
+   int dims[ 2 ];
+   int i, ival, nrow, ok;
+   int ivals[ 30 ];
+   int ivals_in[ 30 ];
+
+/* Create a Table with a scalar double column and an integer column
+   holding 3x2 arrays. */
+   table = astTable( " ", status );
+   astAddColumn( table, "dcol", AST__DOUBLETYPE, 0, NULL, "m" );
+   dims[ 0 ] = 3;
+   dims[ 1 ] = 2;
+   astAddColumn( table, "ICOL", AST__INTTYPE, 2, dims, "" );
+
+/* Store 5 rows in each column, and check they are read back unchanged.
+   Also check the Nrow attribute has been updated. */
+   for( i = 0; i < 5; i++ ) dvals_in[ i ] = 1.5*i - 2.0;
+   for( i = 0; i < 30; i++ ) ivals_in[ i ] = 7*i - 20;
+   astPutColumn( table, "DCOL", 5, dvals_in, NULL );
+   astPutColumn( table, "ICOL", 5, ivals_in, NULL );
+   if( astGetNrow( table ) != 5 && astOK ) {
+      astError( AST__INTER, "Error 1\n", status );
+   }
+
+   memset( valid, 2, sizeof( valid ) );
+   nrow = astGetColumn( table, "DCOL ", sizeof( dvals ), dvals, valid );
+   if( nrow != 5 && astOK ) {
+      astError( AST__INTER, "Error 2\n", status );
+   }
+   for( i = 0; i < 5 && astOK; i++ ) {
+      if( dvals[ i ] != dvals_in[ i ] || valid[ i ] != 1 ) {
+         astError( AST__INTER, "Error 3\n", status );
+      }
+   }
+
+/* Each row of the array column holds 6 integers, stored and returned
+   contiguously. Also check the cell is seen by the KeyMap methods as a
+   vector of the correct length. */
+   nrow = astGetColumn( table, "ICOL", sizeof( ivals ), ivals, valid );
+   if( nrow != 5 && astOK ) {
+      astError( AST__INTER, "Error 4\n", status );
+   }
+   for( i = 0; i < 30 && astOK; i++ ) {
+      if( ivals[ i ] != ivals_in[ i ] ) {
+         astError( AST__INTER, "Error 5\n", status );
+      }
+   }
+   if( astMapLength( table, "ICOL(2)" ) != 6 && astOK ) {
+      astError( AST__INTER, "Error 6\n", status );
+   }
+   if( ( !astMapGetElemI( table, "ICOL(2)", 4, &ival ) ||
+         ival != ivals_in[ 10 ] ) && astOK ) {
+      astError( AST__INTER, "Error 7\n", status );
+   }
+
+/* Check the number of rows returned is limited by the size of the
+   supplied array, and that a whole number of rows is returned. */
+   nrow = astGetColumn( table, "ICOL", 17*sizeof( int ), ivals, NULL );
+   if( nrow != 2 && astOK ) {
+      astError( AST__INTER, "Error 8\n", status );
+   }
+
+/* Store new values for the first 3 rows, flagging row 2 as invalid. This
+   should remove the value in row 2, leave rows 4 and 5 unchanged, and
+   leave Nrow unchanged. */
+   valid_in[ 0 ] = 1;
+   valid_in[ 1 ] = 0;
+   valid_in[ 2 ] = 1;
+   dvals_in[ 0 ] = 100.0;
+   dvals_in[ 1 ] = 200.0;
+   dvals_in[ 2 ] = 300.0;
+   astPutColumn( table, "DCOL", 3, dvals_in, valid_in );
+   if( astMapHasKey( table, "DCOL(2)" ) && astOK ) {
+      astError( AST__INTER, "Error 9\n", status );
+   }
+   if( astGetNrow( table ) != 5 && astOK ) {
+      astError( AST__INTER, "Error 10\n", status );
+   }
+
+/* Also remove row 4 using the KeyMap interface, and check that the
+   missing cells are flagged as invalid and their elements left
+   unchanged. */
+   astMapRemove( table, "DCOL(4)" );
+   for( i = 0; i < 10; i++ ) dvals[ i ] = -1.0;
+   nrow = astGetColumn( table, "DCOL", sizeof( dvals ), dvals, valid );
+   if( nrow != 5 && astOK ) {
+      astError( AST__INTER, "Error 11\n", status );
+   }
+   if( astOK && ( valid[ 0 ] != 1 || valid[ 1 ] != 0 || valid[ 2 ] != 1 ||
+                  valid[ 3 ] != 0 || valid[ 4 ] != 1 ) ) {
+      astError( AST__INTER, "Error 12\n", status );
+   }
+   if( astOK && ( dvals[ 0 ] != 100.0 || dvals[ 1 ] != -1.0 ||
+                  dvals[ 2 ] != 300.0 || dvals[ 3 ] != -1.0 ||
+                  dvals[ 4 ] != 4.0 ) ) {
+      astError( AST__INTER, "Error 13\n", status );
+   }
+
+/* Check individual cells can still be read using the KeyMap interface. */
+   if( ( !astMapGet0D( table, "DCOL(3)", &dval ) || dval != 300.0 ) &&
+       astOK ) {
+      astError( AST__INTER, "Error 14\n", status );
+   }
+
+/* Storing rows beyond the current end of the table should increase
+   Nrow, and rows with more than one digit should be handled correctly. */
+   for( i = 0; i < 10; i++ ) dvals_in[ i ] = 0.25*i;
+   valid_in[ 9 ] = 1;
+   for( i = 0; i < 9; i++ ) valid_in[ i ] = 0;
+   astPutColumn( table, "DCOL", 10, dvals_in, valid_in );
+   if( astGetNrow( table ) != 10 && astOK ) {
+      astError( AST__INTER, "Error 15\n", status );
+   }
+   if( ( !astMapGet0D( table, "DCOL(10)", &dval ) || dval != 2.25 ) &&
+       astOK ) {
+      astError( AST__INTER, "Error 16\n", status );
+   }
+   nrow = astGetColumn( table, "DCOL", sizeof( dvals ), dvals, valid );
+   if( astOK && ( nrow != 10 || valid[ 0 ] || !valid[ 9 ] ||
+                  dvals[ 9 ] != 2.25 ) ) {
+      astError( AST__INTER, "Error 17\n", status );
+   }
+
+/* Using a column that does not exist should report an error. */
+   if( astOK ) {
+      astSetPutErr( QuietPutErr );
+      astPutColumn( table, "NOCOL", 1, dvals_in, NULL );
+      ok = astOK;
+      astClearStatus;
+      astSetPutErr( NULL );
+      if( ok || nerr == 0 ) astError( AST__INTER, "Error 18\n", status );
+   }
+
+   table = astAnnul( table );
+
+   if( astOK ) {
+      printf(" All Table tests passed\n");
+   } else {
+      printf("Table tests failed\n");
+   }
+   return *status;
+}
@@ -0,0 +1,127 @@
+#include "ast.h"
+#include <stdio.h>
+#include <string.h>
+
+/* A memory buffer used to hold the data exchanged with an XmlChan. */
+typedef struct Buffer {
+   char *text;
+   size_t len;
+   size_t pos;
+} Buffer;
+
+static void Append( Buffer *buf, const char *data, size_t nbyte ){
+   buf->text = astGrow( buf->text, buf->len + nbyte + 1, 1 );
+   if( astOK ) {
+      memcpy( buf->text + buf->len, data, nbyte );
+      buf->len += nbyte;
+      buf->text[ buf->len ] = 0;
+   }
+}
+
+/* Block source and sink functions. The source function returns at most
+   100 bytes on each call so that elements are split between blocks. */
+static size_t BlockSource( char *data, size_t size ){
+   Buffer *buf = astChannelData;
+   size_t n = buf->len - buf->pos;
+   if( n > size ) n = size;
+   if( n > 100 ) n = 100;
+   memcpy( data, buf->text + buf->pos, n );
+   buf->pos += n;
+   return n;
+}
+
+static void BlockSink( const char *data, size_t nbyte ){
+   Append( astChannelData, data, nbyte );
+}
+
+/* Error handler used to suppress expected error messages. */
+static int nerr = 0;
+static void QuietPutErr( int status_value, const char *message ){
+   nerr++;
+}
+
+int main(){
+   AstFrame *frm;
+   AstFrameSet *fs;
+   AstMapping *map;
+   AstObject *obj;
+   AstSkyFrame *sf;
+   AstXmlChan *chan;
+   Buffer buf = { NULL, 0, 0 };
+   double coeff[ 8 ] = { 1.0, 1, 1, 0, 2.0, 1, 0, 1 };
+   char *text;
+   size_t nc;
+
+   sf = astSkyFrame( "System=FK5" );
+   map = (AstMapping *) astPolyMap( 2, 1, 2, coeff, 0, NULL, " " );
+   fs = astFrameSet( sf, " " );
+   frm = astFrame( 1, "Domain=X" );
+   astAddFrame( fs, AST__BASE, map, frm );
+
+/* Write two FrameSets, then read them back. Nested XmlChan elements are
+   converted as soon as they are complete, so check that each FrameSet
+   is read correctly, and that the end of the input is then detected. */
+   chan = astXmlChan( NULL, NULL, " " );
+   astPutChannelData( chan, &buf );
+   astChannelBlock( chan, BlockSource, BlockSink );
+   astWrite( chan, fs );
+   astWrite( chan, fs );
+
+   obj = astRead( chan );
+   if( ( !obj || !astEqual( obj, fs ) ) && astOK ) {
+      astError( AST__INTER, "Error 1\n" );
+   }
+   if( obj ) obj = astAnnul( obj );
+   obj = astRead( chan );
+   if( ( !obj || !astEqual( obj, fs ) ) && astOK ) {
+      astError( AST__INTER, "Error 2\n" );
+   }
+   if( obj ) obj = astAnnul( obj );
+   if( astRead( chan ) && astOK ) {
+      astError( AST__INTER, "Error 3\n" );
+   }
+
+/* Check that unused content within a nested element is still reported,
+   and that the following Object can then be read. */
+   text = buf.text ? strstr( buf.text, "<Frame " ) : NULL;
+   if( text ) text = strchr( text, '>' );
+   if( text ) {
+      nc = text + 1 - buf.text;
+      text = astStore( NULL, buf.text, buf.len + 1 );
+      buf.len = nc;
+      Append( &buf, "<_attribute name=\"Bogus\" value=\"1\"/>", 36 );
+      Append( &buf, text + nc, strlen( text + nc ) );
+      text = astFree( text );
+
+      buf.pos = 0;
+      astSetPutErr( QuietPutErr );
+      obj = astRead( chan );
+      astSetPutErr( NULL );
+      if( obj || astStatus != AST__BADIN || nerr == 0 ) {
+         if( astOK ) astError( AST__INTER, "Error 4\n" );
+      } else {
+         astClearStatus;
+         obj = astRead( chan );
+         if( ( !obj || !astEqual( obj, fs ) ) && astOK ) {
+            astError( AST__INTER, "Error 5\n" );
+         }
+      }
+      if( obj ) obj = astAnnul( obj );
+
+   } else if( astOK ) {
+      astError( AST__INTER, "Error 6\n" );
+   }
+
+   buf.text = astFree( buf.text );
+   chan = astAnnul( chan );
+   fs = astAnnul( fs );
+   map = astAnnul( map );
+   frm = astAnnul( frm );
+   sf = astAnnul( sf );
+
+   if( astOK ) {
+      printf(" All XmlChan streaming tests passed\n");
+   } else {
+      printf("XmlChan streaming tests failed\n");
+   }
+}
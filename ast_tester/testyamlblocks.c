@@ -0,0 +1,347 @@
+#include "ast.h"
+#include <stdio.h>
+#include <string.h>
+#include <math.h>
+
+/* A memory buffer holding the YAML text exchanged with a YamlChan. */
+typedef struct Buffer {
+   char *text;
+   size_t len;
+   size_t pos;
+   char *line;
+} Buffer;
+
+/* Line-oriented source and sink functions. */
+static const char *Source( void ){
+   Buffer *buf = astChannelData;
+   size_t nc;
+   if( buf->pos >= buf->len ) return NULL;
+   nc = strcspn( buf->text + buf->pos, "\n" );
+   buf->line = astStore( buf->line, buf->text + buf->pos, nc + 1 );
+   if( astOK ) buf->line[ nc ] = 0;
+   buf->pos += nc + 1;
+   return buf->line;
+}
+
+static void Sink( const char *line ){
+   Buffer *buf = astChannelData;
+   size_t nc = strlen( line );
+   buf->text = astGrow( buf->text, buf->len + nc + 2, 1 );
+   if( astOK ) {
+      memcpy( buf->text + buf->len, line, nc );
+      buf->len += nc;
+      buf->text[ buf->len++ ] = '\n';
+      buf->text[ buf->len ] = 0;
+   }
+}
+
+/* Error handler used to suppress expected error messages. The start of
+   the text of the messages is kept so that it can be checked. */
+static int nerr = 0;
+static char errtext[ 1000 ];
+static void QuietPutErr( int status_value, const char *message ){
+   nerr++;
+   strncat( errtext, message, sizeof( errtext ) - strlen( errtext ) - 1 );
+}
+
+/* Check two Mappings transform a set of test points in the same way. */
+static void Compare( AstMapping *map1, AstMapping *map2, int ierr ){
+   double in[ 2 ][ 4 ] = { { 0.0, 1.0, -2.0, 10.0 },
+                           { 0.5, 3.0, 7.0, -1.0 } };
+   double out1[ 2 ][ 4 ];
+   double out2[ 2 ][ 4 ];
+   int i, j;
+
+   astTranN( map1, 4, 2, 4, (const double *) in, 1, 2, 4, (double *) out1 );
+   astTranN( map2, 4, 2, 4, (const double *) in, 1, 2, 4, (double *) out2 );
+   for( i = 0; i < 2 && astOK; i++ ) {
+      for( j = 0; j < 4; j++ ) {
+         if( fabs( out1[ i ][ j ] - out2[ i ][ j ] ) > 1.0E-10 ) {
+            astError( AST__INTER, "Error %d: %g != %g\n", ierr,
+                      out1[ i ][ j ], out2[ i ][ j ] );
+            break;
+         }
+      }
+   }
+}
+
+int main(){
+   AstKeyMap *blocks;
+   AstKeyMap *blocks2;
+   AstFrameSet *fs;
+   AstMapping *map;
+   AstObject *obj;
+   AstYamlChan *chan;
+   Buffer buf = { NULL, 0, 0, NULL };
+   double matrix[ 4 ] = { 1.0, 0.5, -0.25, 2.0 };
+   double shift[ 2 ] = { 10.0, -20.0 };
+
+   astBegin;
+
+   map = (AstMapping *) astCmpMap( astMatrixMap( 2, 2, 0, matrix, " " ),
+                                   astShiftMap( 2, shift, " " ), 1, " " );
+   fs = astFrameSet( astFrame( 2, "Domain=PIXEL" ), " " );
+   astAddFrame( fs, AST__BASE, map, astSkyFrame( "System=ICRS" ) );
+
+/* Write the FrameSet with all arrays inline. */
+   chan = astYamlChan( Source, Sink, "YamlEncoding=ASDF" );
+   astPutChannelData( chan, &buf );
+   if( astWrite( chan, fs ) != 1 && astOK ) {
+      astError( AST__INTER, "Error 1\n" );
+   }
+   if( buf.text && strstr( buf.text, "source:" ) && astOK ) {
+      astError( AST__INTER, "Error 2\n" );
+   }
+   if( astGetAsdfBlocks( chan ) && astOK ) {
+      astError( AST__INTER, "Error 3\n" );
+   }
+   buf.text = astFree( buf.text );
+   buf.len = 0;
+
+/* Write it again, storing the 4 element matrix in a binary block. The 2
+   element translation is still written inline. */
+   astSetI( chan, "BlockOK", 3 );
+   if( astWrite( chan, fs ) != 1 && astOK ) {
+      astError( AST__INTER, "Error 4\n" );
+   }
+   if( astOK ) {
+      if( !buf.text || !strstr( buf.text, "source: 0" ) ||
+          strstr( buf.text, "source: 1" ) ) {
+         astError( AST__INTER, "Error 5\n" );
+      }
+   }
+
+   blocks = astGetAsdfBlocks( chan );
+   if( astOK ) {
+      if( !blocks || astMapSize( blocks ) != 1 ||
+          astMapLength( blocks, "0" ) != 4*sizeof( double ) ) {
+         astError( AST__INTER, "Error 6\n" );
+      }
+   }
+
+/* Writing again replaces the previous blocks. */
+   buf.text = astFree( buf.text );
+   buf.len = 0;
+   astWrite( chan, fs );
+   blocks2 = astGetAsdfBlocks( chan );
+   if( astOK && ( !blocks2 || astMapSize( blocks2 ) != 1 ) ) {
+      astError( AST__INTER, "Error 7\n" );
+   }
+   if( blocks2 ) blocks2 = astAnnul( blocks2 );
+
+/* Reading the YAML without the blocks should fail. */
+   chan = astAnnul( chan );
+   chan = astYamlChan( Source, Sink, " " );
+   astPutChannelData( chan, &buf );
+   if( astOK ) {
+      astSetPutErr( QuietPutErr );
+      obj = astRead( chan );
+      astSetPutErr( NULL );
+      if( obj || astOK || nerr == 0 ) {
+         if( astOK ) astError( AST__INTER, "Error 8\n" );
+      } else {
+         astClearStatus;
+      }
+   }
+
+/* Read it back using the blocks, and check the FrameSet is unchanged. */
+   buf.pos = 0;
+   astPutAsdfBlocks( chan, blocks );
+   obj = astRead( chan );
+   if( astOK ) {
+      if( !obj || !astIsAFrameSet( obj ) ) {
+         astError( AST__INTER, "Error 9\n" );
+      } else {
+         Compare( (AstMapping *) fs, (AstMapping *) obj, 10 );
+      }
+   }
+   if( obj ) obj = astAnnul( obj );
+
+/* Check big-endian float32 blocks with an offset can also be read. */
+   if( astOK ) {
+      const char *yaml =
+        "#ASDF 1.0.0\n"
+        "%YAML 1.1\n"
+        "%TAG ! tag:stsci.edu:asdf/\n"
+        "--- !core/asdf-1.1.0\n"
+        "wcs: !<tag:stsci.edu:gwcs/wcs-1.0.0>\n"
+        "  name: ''\n"
+        "  steps:\n"
+        "  - !<tag:stsci.edu:gwcs/step-1.0.0>\n"
+        "    frame: !<tag:stsci.edu:gwcs/frame2d-1.0.0>\n"
+        "      name: pixel\n"
+        "    transform: !transform/affine-1.3.0\n"
+        "      matrix: !core/ndarray-1.0.0\n"
+        "        source: 0\n"
+        "        datatype: float32\n"
+        "        byteorder: big\n"
+        "        offset: 4\n"
+        "        shape: [2, 2]\n"
+        "      translation: [1.0, 2.0]\n"
+        "  - !<tag:stsci.edu:gwcs/step-1.0.0>\n"
+        "    frame: !<tag:stsci.edu:gwcs/celestial_frame-1.0.0>\n"
+        "      name: icrs\n"
+        "      axes_names: [lon, lat]\n"
+        "      reference_frame: !<tag:astropy.org:astropy/coordinates/frames/icrs-1.1.0>\n"
+        "        frame_attributes: {}\n"
+        "      unit: [!unit/unit-1.0.0 deg, !unit/unit-1.0.0 deg]\n"
+        "      axis_physical_types: ['pos.eq.ra', 'pos.eq.dec']\n"
+        "...\n";
+      unsigned char data[ 20 ] = { 0xff, 0xff, 0xff, 0xff,
+                                   0x3f, 0x80, 0x00, 0x00,    /*  1.0 */
+                                   0x40, 0x00, 0x00, 0x00,    /*  2.0 */
+                                   0xc0, 0x40, 0x00, 0x00,    /* -3.0 */
+                                   0x3e, 0x80, 0x00, 0x00 };  /*  0.25 */
+      double pin[ 2 ] = { 1.0, 1.0 };
+      double pout[ 2 ];
+
+      astMapPut1B( blocks, "0", 20, data, NULL );
+      astPutAsdfBlocks( chan, blocks );
+
+      buf.text = astFree( buf.text );
+      buf.len = 0;
+      buf.pos = 0;
+      buf.text = astStore( NULL, yaml, strlen( yaml ) + 1 );
+      buf.len = strlen( yaml );
+
+      obj = astRead( chan );
+      if( astOK ) {
+         if( !obj || !astIsAFrameSet( obj ) ) {
+            astError( AST__INTER, "Error 11\n" );
+         } else {
+            astTran2( obj, 1, pin, pin + 1, 1, pout, pout + 1 );
+            if( fabs( pout[ 0 ]*AST__DR2D - 4.0 ) > 1.0E-10 ||
+                fabs( pout[ 1 ]*AST__DR2D + 0.75 ) > 1.0E-10 ) {
+               astError( AST__INTER, "Error 12: %g %g\n",
+                         pout[ 0 ]*AST__DR2D, pout[ 1 ]*AST__DR2D );
+            }
+         }
+      }
+      if( obj ) obj = astAnnul( obj );
+   }
+
+/* Check an ndarray with a shape that implies more bytes than can be
+   counted is rejected. The number of bytes in this 1263665316 x
+   1824726041 array of doubles is 2^64 + 32, and so the array would
+   appear to fit in a 32 byte block if this overflowed. */
+   if( astOK ) {
+      const char *yaml =
+        "#ASDF 1.0.0\n"
+        "%YAML 1.1\n"
+        "%TAG ! tag:stsci.edu:asdf/\n"
+        "--- !core/asdf-1.1.0\n"
+        "wcs: !<tag:stsci.edu:gwcs/wcs-1.0.0>\n"
+        "  name: ''\n"
+        "  steps:\n"
+        "  - !<tag:stsci.edu:gwcs/step-1.0.0>\n"
+        "    frame: !<tag:stsci.edu:gwcs/frame2d-1.0.0>\n"
+        "      name: pixel\n"
+        "    transform: !transform/affine-1.3.0\n"
+        "      matrix: !core/ndarray-1.0.0\n"
+        "        source: 0\n"
+        "        datatype: float64\n"
+        "        byteorder: little\n"
+        "        shape: [1263665316, 1824726041]\n"
+        "      translation: [1.0, 2.0]\n"
+        "  - !<tag:stsci.edu:gwcs/step-1.0.0>\n"
+        "    frame: !<tag:stsci.edu:gwcs/celestial_frame-1.0.0>\n"
+        "      name: icrs\n"
+        "      axes_names: [lon, lat]\n"
+        "      reference_frame: !<tag:astropy.org:astropy/coordinates/frames/icrs-1.1.0>\n"
+        "        frame_attributes: {}\n"
+        "      unit: [!unit/unit-1.0.0 deg, !unit/unit-1.0.0 deg]\n"
+        "      axis_physical_types: ['pos.eq.ra', 'pos.eq.dec']\n"
+        "...\n";
+      unsigned char data[ 32 ] = { 0 };
+
+      astMapPut1B( blocks, "0", 32, data, NULL );
+      astPutAsdfBlocks( chan, blocks );
+
+      buf.text = astFree( buf.text );
+      buf.pos = 0;
+      buf.text = astStore( NULL, yaml, strlen( yaml ) + 1 );
+      buf.len = strlen( yaml );
+
+      errtext[ 0 ] = 0;
+      astSetPutErr( QuietPutErr );
+      obj = astRead( chan );
+      astSetPutErr( NULL );
+      if( obj || astOK ) {
+         if( astOK ) astError( AST__INTER, "Error 16\n" );
+      } else {
+         astClearStatus;
+         if( !strstr( errtext, "illegal shape" ) ) {
+            astError( AST__INTER, "Error 17\n" );
+         }
+      }
+      if( obj ) obj = astAnnul( obj );
+   }
+
+/* Check a large polynomial written inline is read back correctly. The
+   coefficients array has more than 10 rows, and the YAML text is larger
+   than the buffer used by the libyaml emitter. */
+   if( astOK ) {
+      double cofs[ 4*2*31*31 ];
+      double xin[ 3 ] = { 0.0, 0.5, -0.9 };
+      double yin[ 3 ] = { 0.3, -0.7, 0.8 };
+      double xout1[ 3 ], yout1[ 3 ], xout2[ 3 ], yout2[ 3 ];
+      int deg = 30;
+      int i, j, k, ncof;
+
+      ncof = 0;
+      for( k = 1; k <= 2; k++ ) {
+         for( i = 0; i <= deg; i++ ) {
+            for( j = 0; i + j <= deg; j++ ) {
+               cofs[ 4*ncof ] = ( k == 1 ? 1.0 : -1.0 )/( 1 + i + 2*j );
+               cofs[ 4*ncof + 1 ] = k;
+               cofs[ 4*ncof + 2 ] = i;
+               cofs[ 4*ncof + 3 ] = j;
+               ncof++;
+            }
+         }
+      }
+
+      map = (AstMapping *) astPolyMap( 2, 2, ncof, cofs, 0, NULL, " " );
+      fs = astFrameSet( astFrame( 2, "Domain=PIXEL" ), " " );
+      astAddFrame( fs, AST__BASE, map, astSkyFrame( "System=ICRS" ) );
+
+      buf.text = astFree( buf.text );
+      buf.len = 0;
+      buf.pos = 0;
+      chan = astAnnul( chan );
+      chan = astYamlChan( Source, Sink, "YamlEncoding=ASDF" );
+      astPutChannelData( chan, &buf );
+      astWrite( chan, fs );
+      if( astOK && buf.len < 20000 ) {
+         astError( AST__INTER, "Error 13: %zu\n", buf.len );
+      }
+
+      obj = astRead( chan );
+      if( astOK ) {
+         if( !obj || !astIsAFrameSet( obj ) ) {
+            astError( AST__INTER, "Error 14\n" );
+         } else {
+            astTran2( fs, 3, xin, yin, 1, xout1, yout1 );
+            astTran2( obj, 3, xin, yin, 1, xout2, yout2 );
+            for( i = 0; i < 3 && astOK; i++ ) {
+               if( fabs( xout1[ i ] - xout2[ i ] ) > 1.0E-10 ||
+                   fabs( yout1[ i ] - yout2[ i ] ) > 1.0E-10 ) {
+                  astError( AST__INTER, "Error 15: (%g,%g) != (%g,%g)\n",
+                            xout1[ i ], yout1[ i ], xout2[ i ], yout2[ i ] );
+               }
+            }
+         }
+      }
+      if( obj ) obj = astAnnul( obj );
+   }
+
+   buf.text = astFree( buf.text );
+   buf.line = astFree( buf.line );
+   astEnd;
+
+   if( astOK ) {
+      printf(" All YamlChan binary block tests passed\n");
+   } else {
+      printf("YamlChan binary block tests failed\n");
+   }
+}
@@ -32,9 +32,11 @@ f     and "sink" routines which connect it to an external data store
 *     In addition to those attributes common to all Objects, every
 *     Channel also has the following attributes:
 *
+*     - Binary: Use a compact binary encoding?
 *     - Comment: Include textual comments in output?
 *     - Full: Set level of output detail
 *     - Indent: Indentation increment between objects
+*     - Lazy: Defer creation of Objects nested within FrameSets?
 *     - ReportLevel: Selects the level of error reporting
 *     - SinkFile: The path to a file to which the Channel should write
 *     - Skip: Skip irrelevant data?
@@ -48,6 +50,7 @@ f     In addition to those routines applicable to all Objects, the
 f     following routines may also be applied to all Channels:
 *
 c     - astWarnings: Return warnings from the previous read or write
+c     - astChannelBlock: Register block-oriented source and sink functions
 c     - astPutChannelData: Store data to pass to source or sink functions
 c     - astRead: Read an Object from a Channel
 c     - astWrite: Write an Object to a Channel
@@ -149,6 +152,27 @@ f     - AST_WRITE: Write an Object to a Channel
    for a specified value name. */
 #define HASHMAP_SIZE 128
 
+/* Tags used to identify each type of data item in the binary encoding
+   (see attribute Binary). */
+#define BIN_BEGIN 'B'
+#define BIN_ISA 'A'
+#define BIN_END 'E'
+#define BIN_DOUBLE 'D'
+#define BIN_INT 'I'
+#define BIN_INT64 'K'
+#define BIN_STRING 'S'
+#define BIN_OBJECT 'O'
+
+/* The signature that precedes each top-level Object in the binary
+   encoding. The last byte is the version number of the encoding. */
+#define BIN_SIGNATURE "AST\001"
+#define BIN_SIGLEN 4
+
+/* The number of bytes accumulated in the output buffer before it is
+   passed to a block sink function, and the minimum number of bytes
+   requested from a block source function (see astChannelBlock). */
+#define BLOCK_SIZE 65536
+
 /* Include files. */
 /* ============== */
 /* Interface definitions. */
@@ -329,12 +353,18 @@ static AstObject *Read( AstChannel *, int * );
 static AstObject *ReadObject( AstChannel *, const char *, AstObject *, int * );
 static AstChannelValue *FreeValue( AstChannelValue *, int * );
 static AstChannelValue *LookupValue( const char *, int * );
+static AstChannelSpan *ReadSpan( AstChannel *, const char *, int * );
+static AstChannelSpan *ReadSpanData( AstChannel *, int, int * );
 static AstKeyMap *Warnings( AstChannel *, int * );
+static char *FormatValue( AstChannelValue *, int * );
+static char *GetBinaryString( AstChannel *, const unsigned char *, int * );
+static char *GetBlockText( AstChannel *, int * );
 static char *GetNextText( AstChannel *, int * );
 static char *InputTextItem( AstChannel *, int * );
 static char *ReadString( AstChannel *, const char *, const char *, int * );
 static char *SourceWrap( const char *(*)( void ), int * );
 static const char *GetAttrib( AstObject *, const char *, int * );
+static const char *ValueClass( AstChannelValue *, int * );
 static double ReadDouble( AstChannel *, const char *, double, int * );
 static int GetComment( AstChannel *, int * );
 static int GetFull( AstChannel *, int * );
@@ -349,9 +379,15 @@ static int TestFull( AstChannel *, int * );
 static int TestSkip( AstChannel *, int * );
 static int TestStrict( AstChannel *, int * );
 static int Use( AstChannel *, int, int, int * );
+static int UseBinary( AstChannel *, int * );
+static int UseLazy( AstChannel *, int * );
+static size_t FillBlock( AstChannel *, int * );
+static size_t GetNextBinary( AstChannel *, unsigned char *, size_t, int * );
+static size_t SpanSource( char *, size_t );
 static int Write( AstChannel *, AstObject *, int * );
 static void AddWarning( AstChannel *, int, const char *, const char *, int * );
 static void AppendValue( AstChannelValue *, AstChannelValue **, int * );
+static void ChannelBlock( AstChannel *, size_t (*)( char *, size_t ), void (*)( const char *, size_t ), int * );
 static void ClearAttrib( AstObject *, const char *, int * );
 static void ClearComment( AstChannel *, int * );
 static void ClearFull( AstChannel *, int * );
@@ -359,12 +395,21 @@ static void ClearSkip( AstChannel *, int * );
 static void ClearStrict( AstChannel *, int * );
 static void ClearValues( AstChannel *, int * );
 static void Copy( const AstObject *, AstObject *, int * );
+static void DeferObjects( AstChannel *, int * );
 static void Delete( AstObject *, int * );
 static void Dump( AstObject *, AstChannel *, int * );
+static void FlushBlock( AstChannel *, int * );
 static void GetNextData( AstChannel *, int, char **, char **, int * );
 static void OutputTextItem( AstChannel *, const char *, int * );
 static void PutChannelData( AstChannel *, void *, int * );
+static void OpenSinkFile( AstChannel *, const char *, int * );
+static void OpenSourceFile( AstChannel *, const char *, int * );
+static void PutBinaryItem( AstChannel *, int, const char *, const char *, uint64_t, int * );
+static void PutBlock( AstChannel *, const char *, size_t, int * );
+static void PutNextBinary( AstChannel *, const unsigned char *, size_t, int * );
 static void PutNextText( AstChannel *, const char *, int * );
+static void ReadBinaryItem( AstChannel *, int, char **, char **, AstChannelValue **, int * );
+static void SkipBinary( AstChannel *, size_t, int * );
 static void ReadClassData( AstChannel *, const char *, int * );
 static void RemoveValue( AstChannelValue *, AstChannelValue **, int * );
 static void SetAttrib( AstObject *, const char *, int * );
@@ -404,6 +449,16 @@ static int TestSinkFile( AstChannel *, int * );
 static void ClearSinkFile( AstChannel *, int * );
 static void SetSinkFile( AstChannel *, const char *, int * );
 
+static int GetBinary( AstChannel *, int * );
+static int TestBinary( AstChannel *, int * );
+static void ClearBinary( AstChannel *, int * );
+static void SetBinary( AstChannel *, int, int * );
+
+static int GetLazy( AstChannel *, int * );
+static int TestLazy( AstChannel *, int * );
+static void ClearLazy( AstChannel *, int * );
+static void SetLazy( AstChannel *, int, int * );
+
 /* Member functions. */
 /* ================= */
 static void AddWarning( AstChannel *this, int level, const char *msg,
@@ -571,6 +626,114 @@ static void AppendValue( AstChannelValue *value, AstChannelValue **head, int *st
    }
 }
 
+static void ChannelBlock( AstChannel *this,
+                          size_t (* source)( char *, size_t ),
+                          void (* sink)( const char *, size_t ),
+                          int *status ) {
+/*
+c++
+*  Name:
+*     astChannelBlock
+
+*  Purpose:
+*     Register block-oriented source and sink functions with a Channel.
+
+*  Type:
+*     Public function.
+
+*  Synopsis:
+*     #include "channel.h"
+*     void astChannelBlock( AstChannel *this,
+*                           size_t (* source)( char *buf, size_t size ),
+*                           void (* sink)( const char *buf, size_t nbyte ) )
+
+*  Class Membership:
+*     Channel method.
+
+*  Description:
+*     This function registers a pair of block-oriented source and sink
+*     functions with a Channel. Whereas the source and sink functions
+*     supplied when the Channel is created are invoked once for each
+*     line of text, block-oriented functions exchange large buffers of
+*     data with the Channel, which splits the input data into lines (and
+*     assembles output lines into buffers) internally. This avoids the
+*     overhead of invoking a function for every line read or written,
+*     which can be significant when large Objects are transferred. Note,
+*     each line of input is still passed on to the Channel in a newly
+*     allocated string, so the cost of allocating memory for each line
+*     is not removed.
+*
+*     Once registered, a block source function is used in preference to
+*     any line-oriented source function, and a block sink function is
+*     used in preference to any line-oriented sink function. However, a
+*     file specified by the SourceFile or SinkFile attribute is used in
+*     preference to either. Block functions may also be used to read
+*     and write data using the binary encoding (see attribute Binary).
+
+*  Parameters:
+*     this
+*        Pointer to the Channel.
+*     source
+*        Pointer to a block source function, or NULL if the Channel
+*        should revert to its original means of obtaining input data.
+*        The function is invoked with a pointer to a buffer ("buf") in
+*        which it should store the next block of input data, and the
+*        size of the buffer in bytes ("size"). It should store up to
+*        "size" bytes of data in the buffer and return the number of
+*        bytes stored. It need not fill the buffer. Successive lines of
+*        text should be separated by newline characters (no null
+*        characters should be included), but a block need not begin or
+*        end on a line boundary. A value of zero should be returned when
+*        there is no more input data.
+*     sink
+*        Pointer to a block sink function, or NULL if the Channel
+*        should revert to its original means of writing output data.
+*        The function is invoked with a pointer to a buffer ("buf")
+*        holding the next block of output data, and the number of bytes
+*        in the buffer ("nbyte"). The buffer is not null-terminated and
+*        each line of text within it is terminated by a newline
+*        character. The function should make a copy of any data it
+*        requires since the buffer is re-used once the function
+*        returns.
+
+*  Applicability:
+*     Channel
+*        All Channels have this function, and the block functions are
+*        used by the Channel, MocChan, StcsChan, XmlChan and YamlChan
+*        classes. They are not used by a FitsChan.
+
+*  Notes:
+*     - Output data is accumulated in an internal buffer and is passed
+*     to the sink function when the buffer becomes full, at the end of
+*     each invocation of astWrite, and when the Channel is deleted.
+*     - Any input data that has been obtained from a previously
+*     registered block source function, but not yet used, is discarded
+*     when a new source function is registered. Any output data that has
+*     not yet been passed to a previously registered block sink function
+*     is passed to it before the new sink function is registered.
+*     - The astChannelData macro may be used within block source and
+*     sink functions to access any pointer stored in the Channel using
+*     astPutChannelData.
+*     - This routine is not available in the Fortran 77 interface to
+*     the AST library.
+c--
+*/
+
+/* Check the global error status. */
+   if ( !astOK ) return;
+
+/* Discard any unused input data obtained from the previous source
+   function, and store the new source function. */
+   this->nblockin = 0;
+   this->iblockin = 0;
+   this->blocksource = source;
+
+/* Pass any pending output data to the previous sink function, and store
+   the new sink function. */
+   FlushBlock( this, status );
+   this->blocksink = sink;
+}
+
 void *astChannelData_( void ) {
 /*
 c++
@@ -664,9 +827,19 @@ static void ClearAttrib( AstObject *this_object, const char *attrib, int *status
 
 /* Check the attribute name and clear the appropriate attribute. */
 
+/* Binary. */
+/* ------- */
+   if ( !strcmp( attrib, "binary" ) ) {
+      astClearBinary( this );
+
+/* Lazy. */
+/* ----- */
+   } else if ( !strcmp( attrib, "lazy" ) ) {
+      astClearLazy( this );
+
 /* Comment. */
 /* -------- */
-   if ( !strcmp( attrib, "comment" ) ) {
+   } else if ( !strcmp( attrib, "comment" ) ) {
       astClearComment( this );
 
 /* Full. */
@@ -760,6 +933,7 @@ static void ClearValues( AstChannel *this, int *status ) {
    astDECLARE_GLOBALS            /* Declare the thread specific global data */
    AstChannelValue **head;       /* Address of pointer to values list */
    AstChannelValue *value;       /* Pointer to value list element */
+   char *text;                   /* Formatted binary value */
    int indx;                     /* Index into hash map */
 
 /* Get a pointer to the structure holding thread-specific global data. */
@@ -805,7 +979,13 @@ static void ClearValues( AstChannel *this, int *status ) {
          if ( value->is_object ) {
             astAddWarning( this, 1, "The Object \"%s = <%s>\" was "
                            "not recognised as valid input.", "astRead", status,
-                           value->name, astGetClass( value->ptr.object ) );
+                           value->name, ValueClass( value, status ) );
+         } else if ( value->binary ) {
+            text = FormatValue( value, status );
+            astAddWarning( this, 1, "The value \"%s = %s\" was not "
+                           "recognised as valid input.", "astRead", status,
+                           value->name, text );
+            text = astFree( text );
          } else {
             astAddWarning( this, 1, "The value \"%s = %s\" was not "
                            "recognised as valid input.", "astRead", status,
@@ -820,6 +1000,131 @@ static void ClearValues( AstChannel *this, int *status ) {
    }
 }
 
+AstChannelSpan *astCopySpan_( AstChannelSpan *span, int *status ) {
+/*
+*+
+*  Name:
+*     astCopySpan
+
+*  Purpose:
+*     Copy an unconverted Object read from a Channel.
+
+*  Type:
+*     Protected function.
+
+*  Synopsis:
+*     #include "channel.h"
+*     AstChannelSpan *astCopySpan( AstChannelSpan *span )
+
+*  Description:
+*     This function returns a deep copy of a structure holding the
+*     serialised form of an Object, as returned by astReadSpan.
+
+*  Parameters:
+*     span
+*        Pointer to the structure to be copied. May be NULL.
+
+*  Returned Value:
+*     Pointer to the copy, which should be freed using astFreeSpan when
+*     no longer required. NULL is returned if "span" is NULL.
+
+*  Notes:
+*     - A NULL pointer will be returned if this function is invoked
+*     with the global error status set, or if it should fail for any
+*     reason.
+*-
+*/
+
+/* Local Variables: */
+   AstChannelSpan *result;       /* Pointer to the copy */
+
+/* Initialise. */
+   result = NULL;
+
+/* Check the global error status and the supplied pointer. */
+   if ( !astOK || !span ) return result;
+
+/* Allocate the new structure and copy the serialised data and the
+   class name into it. */
+   result = astMalloc( sizeof( AstChannelSpan ) );
+   if ( astOK ) {
+      result->data = astStore( NULL, span->data, span->size );
+      result->size = span->size;
+      result->class = astStore( NULL, span->class,
+                                strlen( span->class ) + 1 );
+      result->binary = span->binary;
+      if ( !astOK ) result = astFreeSpan( result );
+   }
+
+/* Return the result. */
+   return result;
+}
+
+static void DeferObjects( AstChannel *this, int *status ) {
+/*
+*+
+*  Name:
+*     astDeferObjects
+
+*  Purpose:
+*     Defer the creation of Objects nested in the Object being read.
+
+*  Type:
+*     Protected virtual function.
+
+*  Synopsis:
+*     #include "channel.h"
+*     void astDeferObjects( AstChannel *this )
+
+*  Class Membership:
+*     Channel method.
+
+*  Description:
+*     This function may be invoked by class loaders that are able to
+*     hold the Objects they contain in serialised form until they are
+*     first needed (e.g. the Frames and Mappings in a FrameSet). If the
+*     Lazy attribute of the Channel is non-zero, any Objects found
+*     within the data subsequently read for the Object being loaded (by
+*     astReadClassData, for this class and for any ancestor class) are
+*     not created. Instead, their serialised form is retained, and may
+*     be obtained by the loader using astReadSpan. Such Objects may
+*     still be obtained using astReadObject, in which case they are
+*     created when astReadObject is invoked.
+*
+*     If the Lazy attribute is zero, or the Channel is not a basic
+*     Channel (e.g. an XmlChan), this function has no effect and
+*     astReadSpan will always return NULL.
+
+*  Parameters:
+*     this
+*        Pointer to the Channel.
+
+*  Notes:
+*     - This function must be invoked before the loader invokes the
+*     loader of its parent class. This is because an ancestor class
+*     that has no data of its own may read the data for this class (the
+*     "IsA" item that would separate them is not written for a class
+*     with no data items, which is always the case for the Frame data of
+*     a FrameSet written using the binary encoding).
+*     - The request applies only to the Object currently being read,
+*     and not to any other Objects.
+*-
+*/
+
+/* Local Variables: */
+   astDECLARE_GLOBALS            /* Declare the thread specific global data */
+
+/* Check the global error status. */
+   if ( !astOK ) return;
+
+/* Get a pointer to the structure holding thread-specific global data. */
+   astGET_GLOBALS(this);
+
+/* Record the nesting level of the Object being read. ReadClassData only
+   retains Objects in serialised form when reading data at this level. */
+   if ( UseLazy( this, status ) ) this->spans = nest;
+}
+
 static AstChannelValue *FreeValue( AstChannelValue *value, int *status ) {
 /*
 *  Name:
@@ -870,6 +1175,7 @@ static AstChannelValue *FreeValue( AstChannelValue *value, int *status ) {
          if ( value->ptr.object ) {
             value->ptr.object = astAnnul( value->ptr.object );
          }
+         if ( value->span ) value->span = astFreeSpan( value->span );
 
 /* Otherwise, if it identifies a string, then free the string. */
       } else {
@@ -886,127 +1192,399 @@ static AstChannelValue *FreeValue( AstChannelValue *value, int *status ) {
    return NULL;
 }
 
-static const char *GetAttrib( AstObject *this_object, const char *attrib, int *status ) {
+AstChannelSpan *astFreeSpan_( AstChannelSpan *span, int *status ) {
 /*
+*+
 *  Name:
-*     GetAttrib
+*     astFreeSpan
 
 *  Purpose:
-*     Get the value of a specified attribute for a Channel.
+*     Free an unconverted Object read from a Channel.
+
+*  Type:
+*     Protected function.
+
+*  Synopsis:
+*     #include "channel.h"
+*     AstChannelSpan *astFreeSpan( AstChannelSpan *span )
+
+*  Description:
+*     This function frees a structure holding the serialised form of an
+*     Object, as returned by astReadSpan, together with the data it
+*     refers to.
+
+*  Parameters:
+*     span
+*        Pointer to the structure to be freed. May be NULL.
+
+*  Returned Value:
+*     A NULL pointer.
+
+*  Notes:
+*     - This function attempts to execute even if the global error
+*     status is set.
+*-
+*/
+
+/* Check a structure was supplied. */
+   if ( span ) {
+
+/* Free the serialised data, the class name and the structure itself. */
+      span->data = astFree( span->data );
+      span->class = astFree( span->class );
+      span = astFree( span );
+   }
+
+/* Return a NULL pointer. */
+   return NULL;
+}
+
+static char *FormatValue( AstChannelValue *value, int *status ) {
+/*
+*  Name:
+*     FormatValue
+
+*  Purpose:
+*     Format a binary numerical Value as a string.
 
 *  Type:
 *     Private function.
 
 *  Synopsis:
 *     #include "channel.h"
-*     const char *GetAttrib( AstObject *this, const char *attrib, int *status )
+*     char *FormatValue( AstChannelValue *value, int *status )
 
 *  Class Membership:
-*     Channel member function (over-rides the protected astGetAttrib
-*     method inherited from the Object class).
+*     Channel member function.
 
 *  Description:
-*     This function returns a pointer to the value of a specified
-*     attribute for a Channel, formatted as a character string.
+*     This function returns a string holding the numerical value stored
+*     in a Value structure read from a binary data source (see attribute
+*     Binary). The string is formatted in the same way as for the textual
+*     encoding.
 
 *  Parameters:
-*     this
-*        Pointer to the Channel.
-*     attrib
-*        Pointer to a null terminated string containing the name of
-*        the attribute whose value is required. This name should be in
-*        lower case, with all white space removed.
+*     value
+*        Pointer to the Value structure. The "binary" component should
+*        be non-zero.
 *     status
 *        Pointer to the inherited status variable.
 
 *  Returned Value:
-*     - Pointer to a null terminated string containing the attribute
-*     value.
+*     Pointer to a null-terminated string held in dynamically allocated
+*     memory, which must be freed by the caller (using astFree) when no
+*     longer required.
 
 *  Notes:
-*     - The returned string pointer may point at memory allocated
-*     within the Channel, or at static memory. The contents of the
-*     string may be over-written or the pointer may become invalid
-*     following a further invocation of the same function or any
-*     modification of the Channel. A copy of the string should
-*     therefore be made if necessary.
 *     - A NULL pointer will be returned if this function is invoked
 *     with the global error status set, or if it should fail for any
 *     reason.
 */
 
-/* Local Variables: */
-   astDECLARE_GLOBALS            /* Declare the thread specific global data */
-   AstChannel *this;             /* Pointer to the Channel structure */
-   const char *result;           /* Pointer value to return */
-   int comment;                  /* Comment attribute value */
-   int full;                     /* Full attribute value */
-   int indent;                   /* Indent attribute value */
-   int report_level;             /* ReportLevel attribute value */
-   int skip;                     /* Skip attribute value */
-   int strict;                   /* Report errors insead of warnings? */
+/* Local Constants: */
+#define BUFF_LEN 100             /* Size of local formatting buffer */
 
-/* Initialise. */
-   result = NULL;
+/* Local Variables: */
+   char buff[ BUFF_LEN + 1 ];    /* Local formatting buffer */
 
 /* Check the global error status. */
-   if ( !astOK ) return result;
+   if ( !astOK ) return NULL;
 
-/* Get a pointer to the structure holding thread-specific global data. */
-   astGET_GLOBALS(this_object);
+/* Format the value. */
+   if( value->binary != BIN_DOUBLE ) {
+      (void) sprintf( buff, "%" PRId64, value->ival );
+   } else if( value->dval != AST__BAD ) {
+      (void) sprintf( buff, "%.*g", AST__DBL_DIG, value->dval );
+   } else {
+      strcpy( buff, BAD_STRING );
+   }
 
-/* Obtain a pointer to the Channel structure. */
-   this = (AstChannel *) this_object;
+/* Return a dynamic copy of the string. */
+   return astStore( NULL, buff, strlen( buff ) + 1 );
 
-/* Compare "attrib" with each recognised attribute name in turn,
-   obtaining the value of the required attribute. If necessary, write
-   the value into "getattrib_buff" as a null terminated string in an appropriate
-   format.  Set "result" to point at the result string. */
+/* Undefine macros local to this function. */
+#undef BUFF_LEN
+}
 
-/* Comment. */
-/* -------- */
-   if ( !strcmp( attrib, "comment" ) ) {
-      comment = astGetComment( this );
-      if ( astOK ) {
-         (void) sprintf( getattrib_buff, "%d", comment );
-         result = getattrib_buff;
-      }
+static size_t FillBlock( AstChannel *this, int *status ) {
+/*
+*  Name:
+*     FillBlock
 
-/* Full. */
-/* ----- */
-   } else if ( !strcmp( attrib, "full" ) ) {
-      full = astGetFull( this );
-      if ( astOK ) {
-         (void) sprintf( getattrib_buff, "%d", full );
-         result = getattrib_buff;
-      }
+*  Purpose:
+*     Obtain more input data from a block source function.
 
-/* Indent. */
-/* ------- */
-   } else if ( !strcmp( attrib, "indent" ) ) {
-      indent = astGetIndent( this );
-      if ( astOK ) {
-         (void) sprintf( getattrib_buff, "%d", indent );
-         result = getattrib_buff;
-      }
+*  Type:
+*     Private function.
 
-/* ReportLevel. */
-/* ------------ */
-   } else if ( !strcmp( attrib, "reportlevel" ) ) {
-      report_level = astGetReportLevel( this );
-      if ( astOK ) {
-         (void) sprintf( getattrib_buff, "%d", report_level );
-         result = getattrib_buff;
-      }
+*  Synopsis:
+*     #include "channel.h"
+*     size_t FillBlock( AstChannel *this, int *status )
 
-/* Skip. */
-/* ----- */
-   } else if ( !strcmp( attrib, "skip" ) ) {
-      skip = astGetSkip( this );
-      if ( astOK ) {
-         (void) sprintf( getattrib_buff, "%d", skip );
-         result = getattrib_buff;
-      }
+*  Class Membership:
+*     Channel member function.
+
+*  Description:
+*     This function invokes the block source function registered with
+*     a Channel (see astChannelBlock) to obtain the next block of input
+*     data. Any input data that has not yet been used is first moved to
+*     the start of the Channel's input buffer, and the new data is
+*     appended to it. The buffer is extended if necessary so that at
+*     least BLOCK_SIZE bytes are always available for new data.
+
+*  Parameters:
+*     this
+*        Pointer to the Channel.
+*     status
+*        Pointer to the inherited status variable.
+
+*  Returned Value:
+*     The number of new bytes appended to the input buffer. Zero is
+*     returned when the source function indicates that there is no more
+*     input data.
+
+*  Notes:
+*     - A value of zero will be returned if this function is invoked
+*     with the global error status set, or if it should fail for any
+*     reason.
+*/
+
+/* Local Variables: */
+   size_t nleft;                 /* Number of unused bytes in buffer */
+   size_t result;                /* Number of new bytes obtained */
+   size_t space;                 /* Space available for new bytes */
+
+/* Initialise. */
+   result = 0;
+
+/* Check the global error status. */
+   if ( !astOK ) return result;
+
+/* Move any unused bytes to the start of the buffer. */
+   nleft = this->nblockin - this->iblockin;
+   if( nleft > 0 && this->iblockin > 0 ) {
+      memmove( this->blockin, this->blockin + this->iblockin, nleft );
+   }
+   this->nblockin = nleft;
+   this->iblockin = 0;
+
+/* Ensure there is room for at least BLOCK_SIZE new bytes. */
+   if( !this->blockin || astSizeOf( this->blockin ) < nleft + BLOCK_SIZE ) {
+      this->blockin = astGrow( this->blockin, nleft + BLOCK_SIZE,
+                               sizeof( char ) );
+   }
+
+/* Invoke the source function to fill the free space at the end of the
+   buffer. We are about to call an externally supplied function which
+   may not be thread-safe, so lock a mutex first. Also store the channel
+   data pointer in a global variable so that it can be accessed in the
+   source function using macro astChannelData. */
+   if( astOK ) {
+      space = astSizeOf( this->blockin ) - nleft;
+      astStoreChannelData( this );
+      LOCK_MUTEX3;
+      result = ( *this->blocksource )( this->blockin + nleft, space );
+      UNLOCK_MUTEX3;
+
+/* Guard against the source function claiming to have stored more bytes
+   than requested. */
+      if( result > space ) result = space;
+      this->nblockin += result;
+   }
+
+/* Return the result. */
+   return result;
+}
+
+static void FlushBlock( AstChannel *this, int *status ) {
+/*
+*  Name:
+*     FlushBlock
+
+*  Purpose:
+*     Pass buffered output data to a block sink function.
+
+*  Type:
+*     Private function.
+
+*  Synopsis:
+*     #include "channel.h"
+*     void FlushBlock( AstChannel *this, int *status )
+
+*  Class Membership:
+*     Channel member function.
+
+*  Description:
+*     This function passes any output data accumulated in the output
+*     buffer of a Channel to the block sink function registered with the
+*     Channel (see astChannelBlock), and then empties the buffer. It
+*     returns without action if no block sink function has been
+*     registered or if the buffer is empty.
+
+*  Parameters:
+*     this
+*        Pointer to the Channel.
+*     status
+*        Pointer to the inherited status variable.
+*/
+
+/* Check the global error status, and that there is something to do. */
+   if ( !astOK || !this->blocksink || this->nblockout == 0 ) return;
+
+/* Invoke the sink function. Since we are about to call an externally
+   supplied function which may not be thread-safe, lock a mutex first.
+   Also store the channel data pointer in a global variable so that it
+   can be accessed in the sink function using macro astChannelData. */
+   astStoreChannelData( this );
+   LOCK_MUTEX2;
+   ( *this->blocksink )( this->blockout, this->nblockout );
+   UNLOCK_MUTEX2;
+
+/* The buffer is now empty. */
+   this->nblockout = 0;
+}
+
+static const char *GetAttrib( AstObject *this_object, const char *attrib, int *status ) {
+/*
+*  Name:
+*     GetAttrib
+
+*  Purpose:
+*     Get the value of a specified attribute for a Channel.
+
+*  Type:
+*     Private function.
+
+*  Synopsis:
+*     #include "channel.h"
+*     const char *GetAttrib( AstObject *this, const char *attrib, int *status )
+
+*  Class Membership:
+*     Channel member function (over-rides the protected astGetAttrib
+*     method inherited from the Object class).
+
+*  Description:
+*     This function returns a pointer to the value of a specified
+*     attribute for a Channel, formatted as a character string.
+
+*  Parameters:
+*     this
+*        Pointer to the Channel.
+*     attrib
+*        Pointer to a null terminated string containing the name of
+*        the attribute whose value is required. This name should be in
+*        lower case, with all white space removed.
+*     status
+*        Pointer to the inherited status variable.
+
+*  Returned Value:
+*     - Pointer to a null terminated string containing the attribute
+*     value.
+
+*  Notes:
+*     - The returned string pointer may point at memory allocated
+*     within the Channel, or at static memory. The contents of the
+*     string may be over-written or the pointer may become invalid
+*     following a further invocation of the same function or any
+*     modification of the Channel. A copy of the string should
+*     therefore be made if necessary.
+*     - A NULL pointer will be returned if this function is invoked
+*     with the global error status set, or if it should fail for any
+*     reason.
+*/
+
+/* Local Variables: */
+   astDECLARE_GLOBALS            /* Declare the thread specific global data */
+   AstChannel *this;             /* Pointer to the Channel structure */
+   const char *result;           /* Pointer value to return */
+   int binary;                   /* Binary attribute value */
+   int comment;                  /* Comment attribute value */
+   int full;                     /* Full attribute value */
+   int indent;                   /* Indent attribute value */
+   int lazy;                     /* Lazy attribute value */
+   int report_level;             /* ReportLevel attribute value */
+   int skip;                     /* Skip attribute value */
+   int strict;                   /* Report errors insead of warnings? */
+
+/* Initialise. */
+   result = NULL;
+
+/* Check the global error status. */
+   if ( !astOK ) return result;
+
+/* Get a pointer to the structure holding thread-specific global data. */
+   astGET_GLOBALS(this_object);
+
+/* Obtain a pointer to the Channel structure. */
+   this = (AstChannel *) this_object;
+
+/* Compare "attrib" with each recognised attribute name in turn,
+   obtaining the value of the required attribute. If necessary, write
+   the value into "getattrib_buff" as a null terminated string in an appropriate
+   format.  Set "result" to point at the result string. */
+
+/* Binary. */
+/* ------- */
+   if ( !strcmp( attrib, "binary" ) ) {
+      binary = astGetBinary( this );
+      if ( astOK ) {
+         (void) sprintf( getattrib_buff, "%d", binary );
+         result = getattrib_buff;
+      }
+
+/* Lazy. */
+/* ----- */
+   } else if ( !strcmp( attrib, "lazy" ) ) {
+      lazy = astGetLazy( this );
+      if ( astOK ) {
+         (void) sprintf( getattrib_buff, "%d", lazy );
+         result = getattrib_buff;
+      }
+
+/* Comment. */
+/* -------- */
+   } else if ( !strcmp( attrib, "comment" ) ) {
+      comment = astGetComment( this );
+      if ( astOK ) {
+         (void) sprintf( getattrib_buff, "%d", comment );
+         result = getattrib_buff;
+      }
+
+/* Full. */
+/* ----- */
+   } else if ( !strcmp( attrib, "full" ) ) {
+      full = astGetFull( this );
+      if ( astOK ) {
+         (void) sprintf( getattrib_buff, "%d", full );
+         result = getattrib_buff;
+      }
+
+/* Indent. */
+/* ------- */
+   } else if ( !strcmp( attrib, "indent" ) ) {
+      indent = astGetIndent( this );
+      if ( astOK ) {
+         (void) sprintf( getattrib_buff, "%d", indent );
+         result = getattrib_buff;
+      }
+
+/* ReportLevel. */
+/* ------------ */
+   } else if ( !strcmp( attrib, "reportlevel" ) ) {
+      report_level = astGetReportLevel( this );
+      if ( astOK ) {
+         (void) sprintf( getattrib_buff, "%d", report_level );
+         result = getattrib_buff;
+      }
+
+/* Skip. */
+/* ----- */
+   } else if ( !strcmp( attrib, "skip" ) ) {
+      skip = astGetSkip( this );
+      if ( astOK ) {
+         (void) sprintf( getattrib_buff, "%d", skip );
+         result = getattrib_buff;
+      }
 
 /* SourceFile. */
 /* ----------- */
@@ -1038,79 +1616,409 @@ static const char *GetAttrib( AstObject *this_object, const char *attrib, int *s
 
 }
 
-static void GetNextData( AstChannel *this, int skip, char **name,
-                         char **val, int *status ) {
+static char *GetBinaryString( AstChannel *this, const unsigned char *len4,
+                              int *status ) {
 /*
-*+
 *  Name:
-*     astGetNextData
+*     GetBinaryString
 
 *  Purpose:
-*     Read the next item of data from a data source.
+*     Read a length-prefixed string from a binary data source.
 
 *  Type:
-*     Protected virtual function.
+*     Private function.
 
 *  Synopsis:
 *     #include "channel.h"
-*     void astGetNextData( AstChannel *this, int skip, char **name,
-*                          char **val )
+*     char *GetBinaryString( AstChannel *this, const unsigned char *len4,
+*                            int *status )
 
 *  Class Membership:
-*     Channel method.
+*     Channel member function.
 
 *  Description:
-*     This function reads the next item of input data from a data
-*     source associated with a Channel and returns the result.
-*
-*     It is layered conceptually on the astGetNextText method, but
-*     instead of returning the raw input text, it decodes it and
-*     returns name/value pairs ready for use. Note that in some
-*     derived classes, where the data are not stored as text, this
-*     function may not actually use astGetNextText, but will access
-*     the data directly.
+*     This function reads a string stored in the binary encoding used
+*     when the Binary attribute is set (a 4 byte little-endian length
+*     followed by the characters in the string, with no terminating
+*     null) and returns it as a null-terminated string.
 
 *  Parameters:
 *     this
 *        Pointer to the Channel.
-*     skip
-*        A non-zero value indicates that a new Object is to be read,
-*        and that all input data up to the next "Begin" item are to be
-*        skipped in order to locate it. This is useful if the data
-*        source contains AST objects interspersed with other data (but
-*        note that these other data cannot appear inside AST Objects,
-*        only between them).
-*
-*        A zero value indicates that all input data are significant
-*        and the next item will therefore be read and an attempt made
-*        to interpret it whatever it contains. Any other data
-*        inter-mixed with AST Objects will then result in an error.
-*     name
-*        An address at which to store a pointer to a null-terminated
-*        dynamically allocated string containing the name of the next
-*        item in the input data stream. This name will be in lower
-*        case with no surrounding white space.  It is the callers
-*        responsibilty to free the memory holding this string (using
-*        astFree) when it is no longer required.
-*
-*        A NULL pointer value will be returned (without error) to
-*        indicate when there are no further input data items to be
-*        read.
-*     val
-*        An address at which to store a pointer to a null-terminated
-*        dynamically allocated string containing the value associated
-*        with the next item in the input data stream. No case
-*        conversion is performed on this string and all white space is
-*        potentially significant.  It is the callers responsibilty to
-*        free the memory holding this string (using astFree) when it
-*        is no longer required.
-*
-*        The returned pointer will be NULL if an Object data item is
-*        read (see the "Data Representation" section).
+*     len4
+*        Pointer to the 4 bytes holding the encoded length of the string,
+*        if these have already been read by the caller. If NULL, the
+*        length is read from the data source.
+*     status
+*        Pointer to the inherited status variable.
 
-*  Data Representation:
-*     The returned data items fall into the following categories:
-*
+*  Returned Value:
+*     Pointer to a null-terminated string held in dynamically allocated
+*     memory, which must be freed by the caller (using astFree) when no
+*     longer required.
+
+*  Notes:
+*     - The string is read in pieces of no more than BLOCK_SIZE bytes,
+*     and the memory holding it is extended as each piece is read. So a
+*     corrupt length (which may be up to 4 GB) cannot cause more memory
+*     to be allocated than is justified by the data actually available.
+*     - An error is reported if the end of the input data is reached
+*     before the whole string has been read.
+*     - A NULL pointer will be returned if this function is invoked
+*     with the global error status set, or if it should fail for any
+*     reason.
+*/
+
+/* Local Variables: */
+   char *result;                 /* Pointer to returned string */
+   size_t len;                   /* Length of string */
+   size_t ngot;                  /* No. of bytes read in current piece */
+   size_t nget;                  /* No. of bytes to read in next piece */
+   size_t nread;                 /* No. of bytes read so far */
+   unsigned char buf[ 4 ];       /* Buffer for encoded length */
+
+/* Initialise. */
+   result = NULL;
+
+/* Check the global error status. */
+   if ( !astOK ) return result;
+
+/* Read (if necessary) and decode the length of the string. */
+   if( !len4 && GetNextBinary( this, buf, 4, status ) == 4 ) len4 = buf;
+   if( len4 ) {
+      len = (size_t) len4[ 0 ] | ( (size_t) len4[ 1 ] << 8 ) |
+            ( (size_t) len4[ 2 ] << 16 ) | ( (size_t) len4[ 3 ] << 24 );
+
+/* Read the string in pieces, extending the memory holding it before
+   reading each piece. Leave the loop early if the end of the input is
+   reached. */
+      nread = 0;
+      while( astOK ) {
+         nget = len - nread;
+         if( nget > BLOCK_SIZE ) nget = BLOCK_SIZE;
+         result = astGrow( result, nread + nget + 1, 1 );
+         if( astOK ) {
+            ngot = GetNextBinary( this, (unsigned char *) result + nread,
+                                  nget, status );
+            nread += ngot;
+            if( ngot < nget || nread == len ) break;
+         }
+      }
+
+/* Terminate the string if it was read completely. Otherwise, report an
+   error. The data are likely to be corrupt if a long string was
+   expected. */
+      if( astOK && nread == len ) {
+         result[ len ] = '\0';
+
+      } else {
+         result = astFree( result );
+         if( astOK ) {
+            astError( AST__BADIN, "astRead(%s): The binary input data are "
+                      "corrupt or incomplete - a string of %lu bytes was "
+                      "expected, but the input ended after %lu bytes.",
+                      status, astGetClass( this ), (unsigned long) len,
+                      (unsigned long) nread );
+         }
+      }
+   }
+
+/* Report an error if the length of the string could not be read. */
+   if( !result && astOK ) {
+      astError( AST__EOCHN, "astRead(%s): Unexpected end of input in "
+                "the middle of a binary data item.", status,
+                astGetClass( this ) );
+   }
+
+/* Return the result. */
+   return result;
+}
+
+static char *GetBlockText( AstChannel *this, int *status ) {
+/*
+*  Name:
+*     GetBlockText
+
+*  Purpose:
+*     Read the next line of input text from a block source function.
+
+*  Type:
+*     Private function.
+
+*  Synopsis:
+*     #include "channel.h"
+*     char *GetBlockText( AstChannel *this, int *status )
+
+*  Class Membership:
+*     Channel member function.
+
+*  Description:
+*     This function extracts the next newline-terminated line of text
+*     from the input buffer of a Channel, invoking the block source
+*     function registered with the Channel (see astChannelBlock) to
+*     obtain more input data whenever the buffer does not contain a
+*     complete line. Any final line that is not terminated by a newline
+*     is returned when the source function indicates that there is no
+*     more input data.
+
+*  Parameters:
+*     this
+*        Pointer to the Channel.
+*     status
+*        Pointer to the inherited status variable.
+
+*  Returned Value:
+*     Pointer to a null-terminated string containing the input line,
+*     excluding the terminating newline (held in dynamically allocated
+*     memory, which must be freed by the caller when no longer
+*     required). A NULL pointer is returned if there are no more input
+*     lines to be read.
+
+*  Notes:
+*     - A NULL pointer will be returned if this function is invoked
+*     with the global error status set, or if it should fail for any
+*     reason.
+*/
+
+/* Local Variables: */
+   char *eol;                    /* Pointer to terminating newline */
+   char *line;                   /* Pointer to line data to be returned */
+   size_t len;                   /* Length of line */
+   size_t nscan;                 /* Number of bytes already searched */
+
+/* Initialise. */
+   line = NULL;
+   len = 0;
+
+/* Check the global error status. */
+   if ( !astOK ) return line;
+
+/* Loop until a complete line has been found in the buffer. Bytes that
+   have already been searched for a newline are not searched again after
+   more data has been appended to the buffer. */
+   eol = NULL;
+   nscan = 0;
+   while( astOK ) {
+      len = this->nblockin - this->iblockin;
+      if( len > nscan ) {
+         eol = memchr( this->blockin + this->iblockin + nscan, '\n',
+                       len - nscan );
+         if( eol ) {
+            len = eol - ( this->blockin + this->iblockin );
+            break;
+         }
+      }
+      nscan = len;
+
+/* If no newline was found, obtain more data. If there is no more data,
+   use any remaining unterminated text as the final line. */
+      if( !FillBlock( this, status ) ) break;
+   }
+
+/* Copy the line to dynamic memory, terminating it with a null. Advance
+   past the line (and its newline) in the input buffer. */
+   if( astOK && ( eol || len > 0 ) ) {
+      line = astMalloc( len + 1 );
+      if( astOK ) {
+         memcpy( line, this->blockin + this->iblockin, len );
+         line[ len ] = '\0';
+         this->iblockin += eol ? len + 1 : len;
+      }
+   }
+
+/* Return the result. */
+   return line;
+}
+
+static size_t GetNextBinary( AstChannel *this, unsigned char *data,
+                             size_t nbyte, int *status ) {
+/*
+*  Name:
+*     GetNextBinary
+
+*  Purpose:
+*     Read bytes from a binary data source.
+
+*  Type:
+*     Private function.
+
+*  Synopsis:
+*     #include "channel.h"
+*     size_t GetNextBinary( AstChannel *this, unsigned char *data,
+*                           size_t nbyte, int *status )
+
+*  Class Membership:
+*     Channel member function.
+
+*  Description:
+*     This function reads the requested number of bytes from the data
+*     source associated with a Channel that uses the binary encoding
+*     (see attribute Binary). The bytes are read from the file specified
+*     by the SourceFile attribute, from a block source function registered
+*     using astChannelBlock, or from standard input. Binary data cannot be
+*     read using a line-oriented source function.
+
+*  Parameters:
+*     this
+*        Pointer to the Channel.
+*     data
+*        Pointer to an array in which to return the bytes read.
+*     nbyte
+*        The number of bytes to read.
+*     status
+*        Pointer to the inherited status variable.
+
+*  Returned Value:
+*     The number of bytes actually read. This will be less than "nbyte"
+*     only if the end of the input data is reached.
+
+*  Notes:
+*     - A value of zero will be returned if this function is invoked
+*     with the global error status set, or if it should fail for any
+*     reason.
+*/
+
+/* Local Variables: */
+   size_t nleft;                 /* Number of unused bytes in block buffer */
+   size_t result;                /* Number of bytes read */
+   FILE *fd;                     /* Input file descriptor */
+
+/* Initialise. */
+   result = 0;
+
+/* Check the global error status. */
+   if ( !astOK || nbyte == 0 ) return result;
+
+/* If the SourceFile attribute of the Channel specifies an input file,
+   but no input file has yet been opened, open it now. */
+   OpenSourceFile( this, "rb", status );
+
+/* If a block source function has been registered, copy bytes from the
+   block buffer, obtaining more data from the source function as
+   required. */
+   if( astOK && !this->fd_in && this->blocksource ) {
+      while( astOK && result < nbyte ) {
+         nleft = this->nblockin - this->iblockin;
+         if( nleft == 0 ) {
+            if( !FillBlock( this, status ) ) break;
+            nleft = this->nblockin - this->iblockin;
+         }
+         if( nleft > nbyte - result ) nleft = nbyte - result;
+         memcpy( data + result, this->blockin + this->iblockin, nleft );
+         this->iblockin += nleft;
+         result += nleft;
+      }
+      if( !astOK ) result = 0;
+
+/* Line-oriented source functions deliver null-terminated lines of text
+   and so cannot be used to read binary data. */
+   } else if( astOK && !this->fd_in && this->source && this->source_wrap ) {
+      astError( AST__RDERR, "astRead(%s): Binary data cannot be read "
+                "using a line-oriented source function - use the "
+                "SourceFile attribute or astChannelBlock instead (see "
+                "attribute Binary).", status, astGetClass( this ) );
+
+/* Otherwise, read the bytes from the input file or from standard input,
+   and check for read errors. */
+   } else if( astOK ) {
+      fd = this->fd_in ? this->fd_in : stdin;
+      result = fread( data, 1, nbyte, fd );
+      if( result < nbyte && ferror( fd ) ) {
+         astError( AST__RDERR, "astRead(%s): Read error on binary input.",
+                   status, astGetClass( this ) );
+         result = 0;
+      }
+   }
+
+/* If the bytes form part of an Object whose conversion is being
+   deferred (see astDeferObjects), append them to the recorded
+   serialised form of the Object. */
+   if( this->recording && result > 0 ) {
+      this->span = astGrow( this->span, this->nspan + result,
+                            sizeof( char ) );
+      if( astOK ) {
+         memcpy( this->span + this->nspan, data, result );
+         this->nspan += result;
+      }
+   }
+
+/* Return the result. */
+   return result;
+}
+
+static void GetNextData( AstChannel *this, int skip, char **name,
+                         char **val, int *status ) {
+/*
+*+
+*  Name:
+*     astGetNextData
+
+*  Purpose:
+*     Read the next item of data from a data source.
+
+*  Type:
+*     Protected virtual function.
+
+*  Synopsis:
+*     #include "channel.h"
+*     void astGetNextData( AstChannel *this, int skip, char **name,
+*                          char **val )
+
+*  Class Membership:
+*     Channel method.
+
+*  Description:
+*     This function reads the next item of input data from a data
+*     source associated with a Channel and returns the result.
+*
+*     It is layered conceptually on the astGetNextText method, but
+*     instead of returning the raw input text, it decodes it and
+*     returns name/value pairs ready for use. Note that in some
+*     derived classes, where the data are not stored as text, this
+*     function may not actually use astGetNextText, but will access
+*     the data directly.
+
+*  Parameters:
+*     this
+*        Pointer to the Channel.
+*     skip
+*        A non-zero value indicates that a new Object is to be read,
+*        and that all input data up to the next "Begin" item are to be
+*        skipped in order to locate it. This is useful if the data
+*        source contains AST objects interspersed with other data (but
+*        note that these other data cannot appear inside AST Objects,
+*        only between them).
+*
+*        A zero value indicates that all input data are significant
+*        and the next item will therefore be read and an attempt made
+*        to interpret it whatever it contains. Any other data
+*        inter-mixed with AST Objects will then result in an error.
+*     name
+*        An address at which to store a pointer to a null-terminated
+*        dynamically allocated string containing the name of the next
+*        item in the input data stream. This name will be in lower
+*        case with no surrounding white space.  It is the callers
+*        responsibilty to free the memory holding this string (using
+*        astFree) when it is no longer required.
+*
+*        A NULL pointer value will be returned (without error) to
+*        indicate when there are no further input data items to be
+*        read.
+*     val
+*        An address at which to store a pointer to a null-terminated
+*        dynamically allocated string containing the value associated
+*        with the next item in the input data stream. No case
+*        conversion is performed on this string and all white space is
+*        potentially significant.  It is the callers responsibilty to
+*        free the memory holding this string (using astFree) when it
+*        is no longer required.
+*
+*        The returned pointer will be NULL if an Object data item is
+*        read (see the "Data Representation" section).
+
+*  Data Representation:
+*     The returned data items fall into the following categories:
+*
 *     - Begin: Identified by the name string "begin", this indicates
 *     the start of an Object definition. The associated value string
 *     gives the class name of the Object being defined.
@@ -1423,8 +2331,6 @@ static char *GetNextText( AstChannel *this, int *status ) {
    char *errstat;                /* Pointer for system error message */
    char *line;                   /* Pointer to line data to be returned */
    char errbuf[ ERRBUF_LEN ];    /* Buffer for system error message */
-   const char *sink_file;        /* Path to output sink file */
-   const char *source_file;      /* Path to source file */
    int c;                        /* Input character */
    int len;                      /* Length of input line */
    int readstat;                 /* "errno" value set by "getchar" */
@@ -1437,43 +2343,16 @@ static char *GetNextText( AstChannel *this, int *status ) {
    if ( !astOK ) return line;
 
 /* If the SourceFile attribute of the Channel specifies an input file,
-   but no input file has yet been opened, open it now. Report an error if
-   it is the same as the sink file. */
-   if( astTestSourceFile( this ) && !this->fd_in ) {
-      source_file = astGetSourceFile( this );
-
-      if( this->fd_out ) {
-         sink_file = astGetSinkFile( this );
-         if( astOK && !strcmp( sink_file, source_file ) ) {
-            astError( AST__RDERR, "astRead(%s): Failed to open input "
-                      "SourceFile '%s' - the file is currently being used "
-                      "as the output SinkFile.", status, astGetClass( this ),
-                      source_file );
-         }
-      }
-
-      if( astOK ) {
-         this->fd_in = fopen( source_file, "r" );
-         if( !this->fd_in ) {
-            if ( errno ) {
-#if HAVE_STRERROR_R
-               strerror_r( errno, errbuf, ERRBUF_LEN );
-               errstat = errbuf;
-#else
-               errstat = strerror( errno );
-#endif
-               astError( AST__RDERR, "astRead(%s): Failed to open input "
-                         "SourceFile '%s' - %s.", status, astGetClass( this ),
-                         source_file, errstat );
-            } else {
-               astError( AST__RDERR, "astRead(%s): Failed to open input "
-                         "SourceFile '%s'.", status, astGetClass( this ),
-                         source_file );
-            }
-         }
+   but no input file has yet been opened, open it now. */
+   OpenSourceFile( this, "r", status );
 
-      }
-   }
+/* Block source function defined, but no input file. */
+/* ------------------------------------------------- */
+/* If no active input file descriptor is stored in the Channel, but a
+   block source function has been registered using astChannelBlock,
+   extract the next line from the data it supplies. */
+   if ( !this->fd_in && this->blocksource ) {
+      line = GetBlockText( this, status );
 
 /* Source function defined, but no input file. */
 /* ------------------------------------------- */
@@ -1482,7 +2361,7 @@ static char *GetNextText( AstChannel *this, int *status ) {
    Channel, use the wrapper function to invoke the source function to
    read a line of input text. This is returned in a dynamically
    allocated string. */
-   if ( !this->fd_in && this->source && this->source_wrap ) {
+   } else if ( !this->fd_in && this->source && this->source_wrap ) {
 
 /* About to call an externally supplied function which may not be
    thread-safe, so lock a mutex first. Also store the channel data
@@ -1877,6 +2756,16 @@ AstChannel *astInitChannel_( void *mem, size_t size, int init,
       new->fd_out = NULL;
       new->fn_out = NULL;
 
+/* Indicate no block source or sink functions have been registered
+   (see astChannelBlock). */
+      new->blocksource = NULL;
+      new->blocksink = NULL;
+      new->blockin = NULL;
+      new->nblockin = 0;
+      new->iblockin = 0;
+      new->blockout = NULL;
+      new->nblockout = 0;
+
 /* Set all attributes to their undefined values. */
       new->comment = -INT_MAX;
       new->full = -INT_MAX;
@@ -1884,6 +2773,12 @@ AstChannel *astInitChannel_( void *mem, size_t size, int init,
       new->report_level = -INT_MAX;
       new->skip = -INT_MAX;
       new->strict = -INT_MAX;
+      new->binary = -INT_MAX;
+      new->lazy = -INT_MAX;
+      new->spans = -1;
+      new->span = NULL;
+      new->nspan = 0;
+      new->recording = 0;
       new->data = NULL;
       new->warnings = NULL;
       new->nwarn = 0;
@@ -1972,6 +2867,8 @@ void astInitChannelVtab_(  AstChannelVtab *vtab, const char *name, int *status )
    vtab->PutNextText = PutNextText;
    vtab->Read = Read;
    vtab->ReadClassData = ReadClassData;
+   vtab->DeferObjects = DeferObjects;
+   vtab->ReadSpan = ReadSpan;
    vtab->ReadDouble = ReadDouble;
    vtab->ReadInt = ReadInt;
    vtab->ReadInt64 = ReadInt64;
@@ -1996,6 +2893,7 @@ void astInitChannelVtab_(  AstChannelVtab *vtab, const char *name, int *status )
    vtab->WriteString = WriteString;
    vtab->WriteFlush = WriteFlush;
    vtab->PutChannelData = PutChannelData;
+   vtab->ChannelBlock = ChannelBlock;
 
    vtab->ClearReportLevel = ClearReportLevel;
    vtab->GetReportLevel = GetReportLevel;
@@ -2017,300 +2915,657 @@ void astInitChannelVtab_(  AstChannelVtab *vtab, const char *name, int *status )
    vtab->SetSinkFile = SetSinkFile;
    vtab->TestSinkFile = TestSinkFile;
 
-/* Save the inherited pointers to methods that will be extended, and
-   replace them with pointers to the new member functions. */
-   object = (AstObjectVtab *) vtab;
+   vtab->ClearBinary = ClearBinary;
+   vtab->GetBinary = GetBinary;
+   vtab->SetBinary = SetBinary;
+   vtab->TestBinary = TestBinary;
+
+   vtab->ClearLazy = ClearLazy;
+   vtab->GetLazy = GetLazy;
+   vtab->SetLazy = SetLazy;
+   vtab->TestLazy = TestLazy;
+
+/* Save the inherited pointers to methods that will be extended, and
+   replace them with pointers to the new member functions. */
+   object = (AstObjectVtab *) vtab;
+
+   parent_clearattrib = object->ClearAttrib;
+   object->ClearAttrib = ClearAttrib;
+   parent_getattrib = object->GetAttrib;
+   object->GetAttrib = GetAttrib;
+   parent_setattrib = object->SetAttrib;
+   object->SetAttrib = SetAttrib;
+   parent_testattrib = object->TestAttrib;
+   object->TestAttrib = TestAttrib;
+
+/* Declare the destructor and copy constructor. */
+   astSetDelete( (AstObjectVtab *) vtab, Delete );
+   astSetCopy( (AstObjectVtab *) vtab, Copy );
+
+/* Declare the Dump function for this class. There is no destructor or
+   copy constructor. */
+   astSetDump( vtab, Dump, "Channel", "Basic I/O Channel" );
+
+/* If we have just initialised the vtab for the current class, indicate
+   that the vtab is now initialised, and store a pointer to the class
+   identifier in the base "object" level of the vtab. */
+   if( vtab == &class_vtab ) {
+      class_init = 1;
+      astSetVtabClassIdentifier( vtab, &(vtab->id) );
+   }
+}
+
+static char *InputTextItem( AstChannel *this, int *status ) {
+/*
+*  Name:
+*     InputTextItem
+
+*  Purpose:
+*     Read the next item from a data source as text.
+
+*  Type:
+*     Private function.
+
+*  Synopsis:
+*     #include "channel.h"
+*     char *InputTextItem( AstChannel *this )
+
+*  Class Membership:
+*     Channel member function.
+
+*  Description:
+*     This function reads the next input data item as text from the
+*     data source associated with a Channel. It is similar to the
+*     astGetNextText method (which it invokes), except that it strips
+*     off any comments along with leading and trailing white
+*     space. Input lines which are empty or do not contain significant
+*     characters (e.g. all comment) are skipped, so that only
+*     significant lines are returned.
+*
+*     Each line is returned as a pointer to a null-terminated string
+*     held in dynamic memory, and it is the caller's responsibility to
+*     free this memory (using astFree) when it is no longer
+*     required. A NULL pointer is returned if there are no more input
+*     lines to be read.
+
+*  Parameters:
+*     this
+*        Pointer to the Channel.
+
+*  Returned Value:
+*     Pointer to a null-terminated string containing the input line
+*     (held in dynamically allocated memory, which must be freed by
+*     the caller when no longer required). A NULL pointer is returned
+*     if there are no more input lines to be read.
+
+*  Notes:
+*     - A NULL pointer will be returned if this function is invoked
+*     with the global error status set, or if it should fail for any
+*     reason.
+*/
+
+/* Local Variables: */
+   char *line;                   /* Pointer to line data to be returned */
+   int i;                        /* Loop counter for line characters */
+   int j;                        /* Counter for characters */
+   int len;                      /* Length of result line */
+   int nonspace;                 /* Non-space character encountered? */
+   int quoted;                   /* Character is inside quotes? */
+
+/* Initialise. */
+   line = NULL;
+
+/* Check the global error status. */
+   if ( !astOK ) return line;
+
+/* Loop to read input lines until one is found which contains useful
+   characters or end of file is reached (or a read error occurs). */
+   while ( !line && ( line = astGetNextText( this ) ) && astOK ) {
+
+/* Loop to remove comments and leading and trailing white space. */
+      len = 0;
+      nonspace = 0;
+      quoted = 0;
+      for ( i = j = 0; line[ i ]; i++ ) {
+
+/* Note quote characters and ignore all text after the first unquoted
+   comment character. */
+         if ( line[ i ] == '"' ) quoted = !quoted;
+         if ( ( line[ i ] == '#' ) && !quoted ) break;
+
+/* Note the first non-space character and ignore everything before
+   it. */
+         if ( ( nonspace = nonspace || !isspace( line[ i ] ) ) ) {
+
+/* Move each character to its new position in the string. */
+            line[ j++ ] = line[ i ];
+
+/* Note the final length of the string (ignoring trailing spaces). */
+            if ( !isspace( line[ i ] ) ) len = j;
+         }
+      }
+
+/* If the string is not empty, terminate it. */
+     if ( len ) {
+        line[ len ] = '\0';
+
+/* Otherwise, free the memory used for the string so that another
+   input line will be read. */
+      } else {
+         line = astFree( line );
+      }
+   }
+
+/* Return the result pointer. */
+   return line;
+
+/* Undefine macros local to this function. */
+#undef MIN_CHARS
+}
+
+static AstChannelValue *LookupValue( const char *name, int *status ) {
+/*
+*  Name:
+*     LookupValue
+
+*  Purpose:
+*     Look up a Value structure by name.
+
+*  Type:
+*     Private function.
+
+*  Synopsis:
+*     #include "channel.h"
+*     AstChannelValue *LookupValue( const char *name )
+
+*  Class Membership:
+*     Channel member function.
+
+*  Description:
+*     This function searches the current values list (i.e. at the
+*     current nesting level) to identify a Value structure with a
+*     specified name. If one is found, it is removed from the list and
+*     a pointer to it is returned. If no suitable Value can be found,
+*     a NULL pointer is returned instead.
+
+*  Parameters:
+*     name
+*        Pointer to a constant null-terminated character string
+*        containing the name of the required Value. This must be in
+*        lower case with no surrounding white space. Note that names
+*        longer than NAME_MAX characters will not match any Value.
+
+*  Returned value:
+*     Pointer to the required Value structure, or NULL if no suitable
+*     Value exists.
+
+*  Notes:
+*     - The returned pointer refers to a dynamically allocated
+*     structure and it is the callers responsibility to free this when
+*     no longer required. The FreeValue function must be used for this
+*     purpose.
+*     - A NULL pointer will be returned if this function is invoked
+*     with the global error status set, or if it should fail for any
+*     reason.
+*/
+
+/* Local Variables: */
+   astDECLARE_GLOBALS            /* Declare the thread specific global data */
+   AstChannelValue **head;       /* Address of head of list pointer */
+   AstChannelValue *result;      /* Pointer value to return */
+   AstChannelValue *value;       /* Pointer to list element */
+   int indx;                     /* Index into the hash table */
+   unsigned long hash;           /* Hash value for current name */
+
+/* Initialise. */
+   result = NULL;
+
+/* Check the global error status. */
+   if ( !astOK ) return result;
+
+/* Get a pointer to the structure holding thread-specific global data. */
+   astGET_GLOBALS(NULL);
+
+/* Check that the "values_ok" flag is set. If not, the Values in the
+   values list belong to a different class to that of the current
+   class loader, so we cannot return any Value. */
+   if ( values_ok[ nest ] ) {
+
+/* The value in the values list (at the current nesting level) is a
+   pointer to an array containing HASHMAP_SIZE elements, each of which
+   holds a pointer to the first element in a linked list of values.
+   Values are appended to the appropriate linked list, depending on the
+   hash of the associated name. Use the hash function to get the index
+   of the element holding the appropriate linked list for the name of the
+   required value. */
+      indx = HashFun( name, HASHMAP_SIZE - 1, &hash );
+
+/* Obtain the address of the current "head of list" pointer for the
+   values list (at the current nesting level). */
+      head = values_list[ nest ] + indx;
+
+/* Obtain the head of list pointer itself and check the list is not
+   empty. */
+      if ( ( value = *head ) ) {
+
+/* Loop to inspect each list element. */
+         while ( 1 ) {
+
+/* If a name match is found, remove the element from the list, return
+   a pointer to it and quit searching. */
+            if ( !strcmp( name, value->name ) ) {
+               RemoveValue( value, head, status );
+               result = value;
+               break;
+            }
+
+/* Follow the list until we return to the head. */
+            value = value->flink;
+            if ( value == *head ) break;
+         }
+      }
+   }
+
+/* Return the result. */
+   return result;
+}
+
+static void OpenSinkFile( AstChannel *this, const char *mode, int *status ) {
+/*
+*  Name:
+*     OpenSinkFile
+
+*  Purpose:
+*     Open the output file specified by the SinkFile attribute.
+
+*  Type:
+*     Private function.
+
+*  Synopsis:
+*     #include "channel.h"
+*     void OpenSinkFile( AstChannel *this, const char *mode, int *status )
+
+*  Class Membership:
+*     Channel member function.
+
+*  Description:
+*     This function opens the file specified by the SinkFile attribute
+*     of a Channel, storing the resulting file descriptor in the
+*     Channel. It returns without action if the SinkFile attribute has
+*     not been set, or if the file has already been opened.
+
+*  Parameters:
+*     this
+*        Pointer to the Channel.
+*     mode
+*        The mode string to pass to "fopen" ("w" for text or "wb" for
+*        binary output).
+*     status
+*        Pointer to the inherited status variable.
+*/
+
+/* Local Constants: */
+#define ERRBUF_LEN 80
+
+/* Local Variables: */
+   char *errstat;                /* Pointer for system error message */
+   char errbuf[ ERRBUF_LEN ];    /* Buffer for system error message */
+   const char *sink_file;        /* Path to output sink file */
+   const char *source_file;      /* Path to output source file */
 
-   parent_clearattrib = object->ClearAttrib;
-   object->ClearAttrib = ClearAttrib;
-   parent_getattrib = object->GetAttrib;
-   object->GetAttrib = GetAttrib;
-   parent_setattrib = object->SetAttrib;
-   object->SetAttrib = SetAttrib;
-   parent_testattrib = object->TestAttrib;
-   object->TestAttrib = TestAttrib;
+/* Check the global error status. */
+   if ( !astOK ) return;
 
-/* Declare the destructor and copy constructor. */
-   astSetDelete( (AstObjectVtab *) vtab, Delete );
-   astSetCopy( (AstObjectVtab *) vtab, Copy );
+/* If the SinkFile attribute of the Channel specifies an output file,
+   but no output file has yet been opened, open it now. Report an error
+   if it is the same as the source file. */
+   if( !this->fd_out && astTestSinkFile( this ) ) {
+      sink_file = astGetSinkFile( this );
 
-/* Declare the Dump function for this class. There is no destructor or
-   copy constructor. */
-   astSetDump( vtab, Dump, "Channel", "Basic I/O Channel" );
+      if( this->fd_out ) {
+         source_file = astGetSourceFile( this );
+         if( astOK && !strcmp( sink_file, source_file ) ) {
+            astError( AST__WRERR, "astWrite(%s): Failed to open output "
+                      "SinkFile '%s' - the file is currently being used "
+                      "as the input SourceFile.", status, astGetClass( this ),
+                      sink_file );
+         }
+      }
 
-/* If we have just initialised the vtab for the current class, indicate
-   that the vtab is now initialised, and store a pointer to the class
-   identifier in the base "object" level of the vtab. */
-   if( vtab == &class_vtab ) {
-      class_init = 1;
-      astSetVtabClassIdentifier( vtab, &(vtab->id) );
+      if( astOK ) {
+         this->fd_out = fopen( sink_file, mode );
+         if( !this->fd_out ) {
+            if ( errno ) {
+#if HAVE_STRERROR_R
+               strerror_r( errno, errbuf, ERRBUF_LEN );
+               errstat = errbuf;
+#else
+               errstat = strerror( errno );
+#endif
+               astError( AST__WRERR, "astWrite(%s): Failed to open output "
+                         "SinkFile '%s' - %s.", status, astGetClass( this ),
+                         sink_file, errstat );
+            } else {
+               astError( AST__WRERR, "astWrite(%s): Failed to open output "
+                         "SinkFile '%s'.", status, astGetClass( this ),
+                         sink_file );
+            }
+         }
+      }
    }
+
+/* Undefine macros local to this function. */
+#undef ERRBUF_LEN
 }
 
-static char *InputTextItem( AstChannel *this, int *status ) {
+static void OpenSourceFile( AstChannel *this, const char *mode, int *status ) {
 /*
 *  Name:
-*     InputTextItem
+*     OpenSourceFile
 
 *  Purpose:
-*     Read the next item from a data source as text.
+*     Open the input file specified by the SourceFile attribute.
 
 *  Type:
 *     Private function.
 
 *  Synopsis:
 *     #include "channel.h"
-*     char *InputTextItem( AstChannel *this )
+*     void OpenSourceFile( AstChannel *this, const char *mode, int *status )
 
 *  Class Membership:
 *     Channel member function.
 
 *  Description:
-*     This function reads the next input data item as text from the
-*     data source associated with a Channel. It is similar to the
-*     astGetNextText method (which it invokes), except that it strips
-*     off any comments along with leading and trailing white
-*     space. Input lines which are empty or do not contain significant
-*     characters (e.g. all comment) are skipped, so that only
-*     significant lines are returned.
-*
-*     Each line is returned as a pointer to a null-terminated string
-*     held in dynamic memory, and it is the caller's responsibility to
-*     free this memory (using astFree) when it is no longer
-*     required. A NULL pointer is returned if there are no more input
-*     lines to be read.
+*     This function opens the file specified by the SourceFile attribute
+*     of a Channel, storing the resulting file descriptor in the
+*     Channel. It returns without action if the SourceFile attribute has
+*     not been set, or if the file has already been opened.
 
 *  Parameters:
 *     this
 *        Pointer to the Channel.
-
-*  Returned Value:
-*     Pointer to a null-terminated string containing the input line
-*     (held in dynamically allocated memory, which must be freed by
-*     the caller when no longer required). A NULL pointer is returned
-*     if there are no more input lines to be read.
-
-*  Notes:
-*     - A NULL pointer will be returned if this function is invoked
-*     with the global error status set, or if it should fail for any
-*     reason.
+*     mode
+*        The mode string to pass to "fopen" ("r" for text or "rb" for
+*        binary input).
+*     status
+*        Pointer to the inherited status variable.
 */
 
-/* Local Variables: */
-   char *line;                   /* Pointer to line data to be returned */
-   int i;                        /* Loop counter for line characters */
-   int j;                        /* Counter for characters */
-   int len;                      /* Length of result line */
-   int nonspace;                 /* Non-space character encountered? */
-   int quoted;                   /* Character is inside quotes? */
+/* Local Constants: */
+#define ERRBUF_LEN 80
 
-/* Initialise. */
-   line = NULL;
+/* Local Variables: */
+   char *errstat;                /* Pointer for system error message */
+   char errbuf[ ERRBUF_LEN ];    /* Buffer for system error message */
+   const char *sink_file;        /* Path to output sink file */
+   const char *source_file;      /* Path to source file */
 
 /* Check the global error status. */
-   if ( !astOK ) return line;
-
-/* Loop to read input lines until one is found which contains useful
-   characters or end of file is reached (or a read error occurs). */
-   while ( !line && ( line = astGetNextText( this ) ) && astOK ) {
-
-/* Loop to remove comments and leading and trailing white space. */
-      len = 0;
-      nonspace = 0;
-      quoted = 0;
-      for ( i = j = 0; line[ i ]; i++ ) {
-
-/* Note quote characters and ignore all text after the first unquoted
-   comment character. */
-         if ( line[ i ] == '"' ) quoted = !quoted;
-         if ( ( line[ i ] == '#' ) && !quoted ) break;
-
-/* Note the first non-space character and ignore everything before
-   it. */
-         if ( ( nonspace = nonspace || !isspace( line[ i ] ) ) ) {
+   if ( !astOK ) return;
 
-/* Move each character to its new position in the string. */
-            line[ j++ ] = line[ i ];
+/* If the SourceFile attribute of the Channel specifies an input file,
+   but no input file has yet been opened, open it now. Report an error if
+   it is the same as the sink file. */
+   if( !this->fd_in && astTestSourceFile( this ) ) {
+      source_file = astGetSourceFile( this );
 
-/* Note the final length of the string (ignoring trailing spaces). */
-            if ( !isspace( line[ i ] ) ) len = j;
+      if( this->fd_out ) {
+         sink_file = astGetSinkFile( this );
+         if( astOK && !strcmp( sink_file, source_file ) ) {
+            astError( AST__RDERR, "astRead(%s): Failed to open input "
+                      "SourceFile '%s' - the file is currently being used "
+                      "as the output SinkFile.", status, astGetClass( this ),
+                      source_file );
          }
       }
 
-/* If the string is not empty, terminate it. */
-     if ( len ) {
-        line[ len ] = '\0';
+      if( astOK ) {
+         this->fd_in = fopen( source_file, mode );
+         if( !this->fd_in ) {
+            if ( errno ) {
+#if HAVE_STRERROR_R
+               strerror_r( errno, errbuf, ERRBUF_LEN );
+               errstat = errbuf;
+#else
+               errstat = strerror( errno );
+#endif
+               astError( AST__RDERR, "astRead(%s): Failed to open input "
+                         "SourceFile '%s' - %s.", status, astGetClass( this ),
+                         source_file, errstat );
+            } else {
+               astError( AST__RDERR, "astRead(%s): Failed to open input "
+                         "SourceFile '%s'.", status, astGetClass( this ),
+                         source_file );
+            }
+         }
 
-/* Otherwise, free the memory used for the string so that another
-   input line will be read. */
-      } else {
-         line = astFree( line );
       }
    }
 
-/* Return the result pointer. */
-   return line;
-
 /* Undefine macros local to this function. */
-#undef MIN_CHARS
+#undef ERRBUF_LEN
 }
 
-static AstChannelValue *LookupValue( const char *name, int *status ) {
+static void OutputTextItem( AstChannel *this, const char *line, int *status ) {
 /*
 *  Name:
-*     LookupValue
+*     OutputTextItem
 
 *  Purpose:
-*     Look up a Value structure by name.
+*     Output a data item formatted as text.
 
 *  Type:
 *     Private function.
 
 *  Synopsis:
 *     #include "channel.h"
-*     AstChannelValue *LookupValue( const char *name )
+*     void OutputTextItem( AstChannel *this, const char *line, int *status )
 
 *  Class Membership:
 *     Channel member function.
 
 *  Description:
-*     This function searches the current values list (i.e. at the
-*     current nesting level) to identify a Value structure with a
-*     specified name. If one is found, it is removed from the list and
-*     a pointer to it is returned. If no suitable Value can be found,
-*     a NULL pointer is returned instead.
+*     This function outputs a data item formatted as a text string to
+*     a data sink associated with a Channel. It keeps track of the
+*     number of items written.
 
 *  Parameters:
-*     name
-*        Pointer to a constant null-terminated character string
-*        containing the name of the required Value. This must be in
-*        lower case with no surrounding white space. Note that names
-*        longer than NAME_MAX characters will not match any Value.
-
-*  Returned value:
-*     Pointer to the required Value structure, or NULL if no suitable
-*     Value exists.
-
-*  Notes:
-*     - The returned pointer refers to a dynamically allocated
-*     structure and it is the callers responsibility to free this when
-*     no longer required. The FreeValue function must be used for this
-*     purpose.
-*     - A NULL pointer will be returned if this function is invoked
-*     with the global error status set, or if it should fail for any
-*     reason.
+*     this
+*        Pointer to the Channel.
+*     line
+*        Pointer to a constant null-terminated string containing the
+*        data item to be output (no newline character should be
+*        appended).
+*     status
+*        Pointer to the inherited status variable.
 */
 
 /* Local Variables: */
    astDECLARE_GLOBALS            /* Declare the thread specific global data */
-   AstChannelValue **head;       /* Address of head of list pointer */
-   AstChannelValue *result;      /* Pointer value to return */
-   AstChannelValue *value;       /* Pointer to list element */
-   int indx;                     /* Index into the hash table */
-   unsigned long hash;           /* Hash value for current name */
-
-/* Initialise. */
-   result = NULL;
 
 /* Check the global error status. */
-   if ( !astOK ) return result;
+   if ( !astOK ) return;
 
 /* Get a pointer to the structure holding thread-specific global data. */
-   astGET_GLOBALS(NULL);
+   astGET_GLOBALS(this);
+
+/* Write out the line of text using the astPutNextText method (which
+   may be over-ridden). */
+   astPutNextText( this, line );
+
+/* If successful, increment the count of items written. */
+   if ( astOK ) items_written++;
+}
+
+static void PutBinaryItem( AstChannel *this, int tag, const char *name,
+                           const char *string, uint64_t num, int *status ) {
+/*
+*  Name:
+*     PutBinaryItem
+
+*  Purpose:
+*     Output a data item using the binary encoding.
+
+*  Type:
+*     Private function.
+
+*  Synopsis:
+*     #include "channel.h"
+*     void PutBinaryItem( AstChannel *this, int tag, const char *name,
+*                         const char *string, uint64_t num, int *status )
+
+*  Class Membership:
+*     Channel member function.
+
+*  Description:
+*     This function encodes a single data item using the binary
+*     encoding (see attribute Binary) and writes it to the data sink
+*     associated with a Channel. It keeps track of the number of items
+*     written.
+*
+*     Each item consists of a single tag byte, followed by the item
+*     name, followed by an optional string value, followed by an
+*     optional numerical value. Strings are stored as a 4 byte
+*     little-endian length followed by the characters in the string
+*     (with no terminating null). Numerical values are stored as 8
+*     little-endian bytes (4 bytes for "int" values).
 
-/* Check that the "values_ok" flag is set. If not, the Values in the
-   values list belong to a different class to that of the current
-   class loader, so we cannot return any Value. */
-   if ( values_ok[ nest ] ) {
+*  Parameters:
+*     this
+*        Pointer to the Channel.
+*     tag
+*        The tag identifying the type of item (one of the BIN_...
+*        constants).
+*     name
+*        The item name. For "Begin", "IsA" and "End" items, this should
+*        be the class name.
+*     string
+*        The string value, or NULL if the item has no string value.
+*     num
+*        The bits of the numerical value, for BIN_DOUBLE, BIN_INT and
+*        BIN_INT64 items. Ignored for other items.
+*     status
+*        Pointer to the inherited status variable.
+*/
 
-/* The value in the values list (at the current nesting level) is a
-   pointer to an array containing HASHMAP_SIZE elements, each of which
-   holds a pointer to the first element in a linked list of values.
-   Values are appended to the appropriate linked list, depending on the
-   hash of the associated name. Use the hash function to get the index
-   of the element holding the appropriate linked list for the name of the
-   required value. */
-      indx = HashFun( name, HASHMAP_SIZE - 1, &hash );
+/* Local Constants: */
+#define BUFF_LEN 256             /* Size of local encoding buffer */
 
-/* Obtain the address of the current "head of list" pointer for the
-   values list (at the current nesting level). */
-      head = values_list[ nest ] + indx;
+/* Local Variables: */
+   astDECLARE_GLOBALS            /* Declare the thread specific global data */
+   const char *text;             /* Pointer to next string to encode */
+   size_t len;                   /* Length of current string */
+   size_t nbyte;                 /* Total number of bytes in item */
+   unsigned char *item;          /* Pointer to encoded item */
+   unsigned char *p;             /* Pointer to next byte to store */
+   unsigned char buff[ BUFF_LEN ];/* Local encoding buffer */
+   int i;                        /* Loop counter for strings and bytes */
+   int nnum;                     /* Number of bytes in numerical value */
 
-/* Obtain the head of list pointer itself and check the list is not
-   empty. */
-      if ( ( value = *head ) ) {
+/* Check the global error status. */
+   if ( !astOK ) return;
 
-/* Loop to inspect each list element. */
-         while ( 1 ) {
+/* Get a pointer to the structure holding thread-specific global data. */
+   astGET_GLOBALS(this);
 
-/* If a name match is found, remove the element from the list, return
-   a pointer to it and quit searching. */
-            if ( !strcmp( name, value->name ) ) {
-               RemoveValue( value, head, status );
-               result = value;
-               break;
-            }
+/* Find the total number of bytes needed to encode the item. Use the
+   local buffer if it is big enough, and allocate memory otherwise. */
+   nnum = ( tag == BIN_DOUBLE || tag == BIN_INT64 ) ? 8 :
+          ( ( tag == BIN_INT ) ? 4 : 0 );
+   nbyte = 5 + strlen( name ) + nnum;
+   if( string ) nbyte += 4 + strlen( string );
+   item = ( nbyte > BUFF_LEN ) ? astMalloc( nbyte ) : buff;
+   if( astOK ) {
 
-/* Follow the list until we return to the head. */
-            value = value->flink;
-            if ( value == *head ) break;
+/* Store the tag, then the name and (if supplied) the string value. */
+      p = item;
+      *(p++) = (unsigned char) tag;
+      for( i = 0; i < 2; i++ ) {
+         text = i ? string : name;
+         if( text ) {
+            len = strlen( text );
+            *(p++) = (unsigned char) ( len & 0xff );
+            *(p++) = (unsigned char) ( ( len >> 8 ) & 0xff );
+            *(p++) = (unsigned char) ( ( len >> 16 ) & 0xff );
+            *(p++) = (unsigned char) ( ( len >> 24 ) & 0xff );
+            memcpy( p, text, len );
+            p += len;
          }
       }
+
+/* Store any numerical value, least significant byte first, and write
+   out the item. */
+      for( i = 0; i < nnum; i++ ) {
+         *(p++) = (unsigned char) ( num & 0xff );
+         num >>= 8;
+      }
+      PutNextBinary( this, item, nbyte, status );
    }
 
-/* Return the result. */
-   return result;
+/* Free any allocated memory. */
+   if( item != buff ) item = astFree( item );
+
+/* If successful, increment the count of items written. */
+   if ( astOK ) items_written++;
+
+/* Undefine macros local to this function. */
+#undef BUFF_LEN
 }
 
-static void OutputTextItem( AstChannel *this, const char *line, int *status ) {
+static void PutBlock( AstChannel *this, const char *data, size_t nbyte,
+                      int *status ) {
 /*
 *  Name:
-*     OutputTextItem
+*     PutBlock
 
 *  Purpose:
-*     Output a data item formatted as text.
+*     Append data to the buffer used by a block sink function.
 
 *  Type:
 *     Private function.
 
 *  Synopsis:
 *     #include "channel.h"
-*     void OutputTextItem( AstChannel *this, const char *line, int *status )
+*     void PutBlock( AstChannel *this, const char *data, size_t nbyte,
+*                    int *status )
 
 *  Class Membership:
 *     Channel member function.
 
 *  Description:
-*     This function outputs a data item formatted as a text string to
-*     a data sink associated with a Channel. It keeps track of the
-*     number of items written.
+*     This function appends the supplied bytes to the output buffer of a
+*     Channel that has a block sink function (see astChannelBlock). The
+*     buffer is passed to the sink function once it holds at least
+*     BLOCK_SIZE bytes.
 
 *  Parameters:
 *     this
 *        Pointer to the Channel.
-*     line
-*        Pointer to a constant null-terminated string containing the
-*        data item to be output (no newline character should be
-*        appended).
+*     data
+*        Pointer to the bytes to be written.
+*     nbyte
+*        The number of bytes to write.
 *     status
 *        Pointer to the inherited status variable.
 */
 
-/* Local Variables: */
-   astDECLARE_GLOBALS            /* Declare the thread specific global data */
-
 /* Check the global error status. */
    if ( !astOK ) return;
 
-/* Get a pointer to the structure holding thread-specific global data. */
-   astGET_GLOBALS(this);
-
-/* Write out the line of text using the astPutNextText method (which
-   may be over-ridden). */
-   astPutNextText( this, line );
+/* Extend the buffer if necessary, and append the new bytes. */
+   if( !this->blockout ||
+       astSizeOf( this->blockout ) < this->nblockout + nbyte ) {
+      this->blockout = astGrow( this->blockout, this->nblockout + nbyte +
+                                BLOCK_SIZE, sizeof( char ) );
+   }
+   if( astOK ) {
+      memcpy( this->blockout + this->nblockout, data, nbyte );
+      this->nblockout += nbyte;
 
-/* If successful, increment the count of items written. */
-   if ( astOK ) items_written++;
+/* Pass the buffer to the sink function if it is full. */
+      if( this->nblockout >= BLOCK_SIZE ) FlushBlock( this, status );
+   }
 }
 
 static void PutChannelData( AstChannel *this, void *data, int *status ) {
@@ -2363,6 +3618,79 @@ c--
    this->data = data;
 }
 
+static void PutNextBinary( AstChannel *this, const unsigned char *data,
+                           size_t nbyte, int *status ) {
+/*
+*  Name:
+*     PutNextBinary
+
+*  Purpose:
+*     Write bytes to a binary data sink.
+
+*  Type:
+*     Private function.
+
+*  Synopsis:
+*     #include "channel.h"
+*     void PutNextBinary( AstChannel *this, const unsigned char *data,
+*                         size_t nbyte, int *status )
+
+*  Class Membership:
+*     Channel member function.
+
+*  Description:
+*     This function writes the supplied bytes to the data sink
+*     associated with a Channel that uses the binary encoding (see
+*     attribute Binary). The bytes are written to the file specified by
+*     the SinkFile attribute, to a block sink function registered using
+*     astChannelBlock, or to standard output. Binary data cannot be
+*     written using a line-oriented sink function.
+
+*  Parameters:
+*     this
+*        Pointer to the Channel.
+*     data
+*        Pointer to the bytes to be written.
+*     nbyte
+*        The number of bytes to write.
+*     status
+*        Pointer to the inherited status variable.
+*/
+
+/* Local Variables: */
+   FILE *fd;                     /* Output file descriptor */
+
+/* Check the global error status. */
+   if ( !astOK ) return;
+
+/* If the SinkFile attribute of the Channel specifies an output file,
+   but no output file has yet been opened, open it now. */
+   OpenSinkFile( this, "wb", status );
+
+/* If a block sink function has been registered, append the bytes to the
+   block buffer. */
+   if( astOK && !this->fd_out && this->blocksink ) {
+      PutBlock( this, (const char *) data, nbyte, status );
+
+/* Line-oriented sink functions accept null-terminated lines of text and
+   so cannot be used to write binary data. */
+   } else if( astOK && !this->fd_out && this->sink && this->sink_wrap ) {
+      astError( AST__WRERR, "astWrite(%s): Binary data cannot be written "
+                "using a line-oriented sink function - use the SinkFile "
+                "attribute or astChannelBlock instead (see attribute "
+                "Binary).", status, astGetClass( this ) );
+
+/* Otherwise, write the bytes to the output file or to standard output,
+   and check for write errors. */
+   } else if( astOK ) {
+      fd = this->fd_out ? this->fd_out : stdout;
+      if( fwrite( data, 1, nbyte, fd ) < nbyte ) {
+         astError( AST__WRERR, "astWrite(%s): Write error on binary "
+                   "output.", status, astGetClass( this ) );
+      }
+   }
+}
+
 static void PutNextText( AstChannel *this, const char *line, int *status ) {
 /*
 *+
@@ -2401,55 +3729,12 @@ static void PutNextText( AstChannel *this, const char *line, int *status ) {
 *-
 */
 
-/* Local Constants: */
-#define ERRBUF_LEN 80
-
-/* Local Variables: */
-   char *errstat;                /* Pointer for system error message */
-   char errbuf[ ERRBUF_LEN ];    /* Buffer for system error message */
-   const char *sink_file;        /* Path to output sink file */
-   const char *source_file;      /* Path to output source file */
-
 /* Check the global error status. */
    if ( !astOK ) return;
 
 /* If the SinkFile attribute of the Channel specifies an output file,
-   but no output file has yet been opened, open it now. Report an error
-   if it is the same as the source file. */
-   if( astTestSinkFile( this ) && !this->fd_out ) {
-      sink_file = astGetSinkFile( this );
-
-      if( this->fd_out ) {
-         source_file = astGetSourceFile( this );
-         if( astOK && !strcmp( sink_file, source_file ) ) {
-            astError( AST__WRERR, "astWrite(%s): Failed to open output "
-                      "SinkFile '%s' - the file is currently being used "
-                      "as the input SourceFile.", status, astGetClass( this ),
-                      sink_file );
-         }
-      }
-
-      if( astOK ) {
-         this->fd_out = fopen( sink_file, "w" );
-         if( !this->fd_out ) {
-            if ( errno ) {
-#if HAVE_STRERROR_R
-               strerror_r( errno, errbuf, ERRBUF_LEN );
-               errstat = errbuf;
-#else
-               errstat = strerror( errno );
-#endif
-               astError( AST__WRERR, "astWrite(%s): Failed to open output "
-                         "SinkFile '%s' - %s.", status, astGetClass( this ),
-                         sink_file, errstat );
-            } else {
-               astError( AST__WRERR, "astWrite(%s): Failed to open output "
-                         "SinkFile '%s'.", status, astGetClass( this ),
-                         sink_file );
-            }
-         }
-      }
-   }
+   but no output file has yet been opened, open it now. */
+   OpenSinkFile( this, "w", status );
 
 /* Check no error occurred above. */
    if( astOK ) {
@@ -2459,6 +3744,12 @@ static void PutNextText( AstChannel *this, const char *line, int *status ) {
       if( this->fd_out ) {
          (void) fprintf( this->fd_out, "%s\n", line );
 
+/* Otherwise, if a block sink function has been registered using
+   astChannelBlock, append the text and a newline to the output buffer. */
+      } else if ( this->blocksink ) {
+         PutBlock( this, line, strlen( line ), status );
+         PutBlock( this, "\n", 1, status );
+
 /* Otherwise, if a sink function (and its wrapper function) is defined for
    the Channel, use the wrapper function to invoke the sink function to
    output the text line. Since we are about to call an externally supplied
@@ -2554,6 +3845,7 @@ f     is invoked with STATUS set to an error value, or if it should fail
 
 /* Local Variables: */
    astDECLARE_GLOBALS            /* Declare the thread specific global data */
+   AstChannelValue *value;       /* Pointer to unexpected binary Value */
    AstLoaderType *loader;        /* Pointer to loader for Object */
    AstObject *new;               /* Pointer to new Object */
    char *class;                  /* Pointer to Object class name string */
@@ -2583,8 +3875,16 @@ f     is invoked with STATUS set to an error value, or if it should fail
 /* Read the next input data item. If we are reading a top-level Object
    definition, skip any unrelated data beforehand. Otherwise read the
    data strictly as it comes (there should be no unrelated data
-   embedded within Object definitions themselves). */
-   astGetNextData( this, skip, &name, &class );
+   embedded within Object definitions themselves). If the binary
+   encoding is being used, there can be no unrelated data. Any
+   numerical item read in place of the "Begin" item is simply discarded
+   (an error is reported below). */
+   if ( UseBinary( this, status ) ) {
+      ReadBinaryItem( this, top, &name, &class, &value, status );
+      value = FreeValue( value, status );
+   } else {
+      astGetNextData( this, skip, &name, &class );
+   }
 
 /* If no suitable data item was found (and no error occurred), we have
    reached the end of data. For a top-level Object a NULL Object
@@ -2651,6 +3951,10 @@ f     is invoked with STATUS set to an error value, or if it should fail
    class. */
             new = (*loader)( NULL, (size_t) 0, NULL, NULL, this, status );
 
+/* Any request made by the loader to defer the creation of nested
+   Objects (see astDeferObjects) applies only to this Object. */
+            if ( this->spans == nest ) this->spans = -1;
+
 /* Clear the values list for the current nesting level. If the list
    has not been read or any Values remain in it, an error will
    result. */
@@ -2705,6 +4009,183 @@ f     is invoked with STATUS set to an error value, or if it should fail
    return new;
 }
 
+static void ReadBinaryItem( AstChannel *this, int top, char **name,
+                            char **val, AstChannelValue **value,
+                            int *status ) {
+/*
+*  Name:
+*     ReadBinaryItem
+
+*  Purpose:
+*     Read the next item of data from a binary data source.
+
+*  Type:
+*     Private function.
+
+*  Synopsis:
+*     #include "channel.h"
+*     void ReadBinaryItem( AstChannel *this, int top, char **name,
+*                          char **val, AstChannelValue **value,
+*                          int *status )
+
+*  Class Membership:
+*     Channel member function.
+
+*  Description:
+*     This function reads the next item of data from a data source that
+*     uses the binary encoding (see attribute Binary). It is used in
+*     place of astGetNextData, and returns "Begin", "IsA", "End",
+*     string and Object items in the same way as astGetNextData.
+*     Numerical items are returned instead in a new Value structure,
+*     so that they need not be converted to and from text.
+
+*  Parameters:
+*     this
+*        Pointer to the Channel.
+*     top
+*        Should be non-zero if a top-level Object is about to be read.
+*        The signature that precedes each top-level Object in the binary
+*        encoding is then read and checked before the first item.
+*     name
+*        An address at which to store a pointer to a null-terminated
+*        dynamically allocated string containing the name of the next
+*        item, in lower case. A NULL pointer value is returned (without
+*        error) if there are no further input data items to be read.
+*     val
+*        An address at which to store a pointer to a null-terminated
+*        dynamically allocated string containing the string value
+*        associated with the next item. A NULL pointer is returned for
+*        Object and numerical items.
+*     value
+*        An address at which to store a pointer to a new Value structure
+*        describing a numerical item. The "name" component of the
+*        structure is NULL (the name is returned via "name"). A NULL
+*        pointer is returned for all other types of item.
+*     status
+*        Pointer to the inherited status variable.
+*/
+
+/* Local Variables: */
+   char *class;                  /* Pointer to class name string */
+   char *p;                      /* Pointer to next name character */
+   int i;                        /* Loop counter for bytes */
+   size_t nnum;                  /* Number of bytes read */
+   uint64_t bits;                /* Bits of numerical value */
+   unsigned char buf[ 8 ];       /* Buffer for encoded values */
+   unsigned char tag;            /* Tag identifying the item type */
+
+/* Initialise. */
+   *name = NULL;
+   *val = NULL;
+   *value = NULL;
+
+/* Check the global error status. */
+   if ( !astOK ) return;
+
+/* If a top-level Object is being read, check that it is preceded by the
+   expected signature. Reaching the end of input here indicates that
+   there are no more Objects to read. */
+   if( top ) {
+      nnum = GetNextBinary( this, buf, BIN_SIGLEN, status );
+      if( nnum == 0 || !astOK ) return;
+      if( nnum < BIN_SIGLEN || memcmp( buf, BIN_SIGNATURE, BIN_SIGLEN ) ) {
+         astError( AST__BADIN, "astRead(%s): The input data are not in the "
+                   "AST binary format (see attribute Binary).", status,
+                   astGetClass( this ) );
+         return;
+      }
+   }
+
+/* Every item starts with a tag byte followed by a string (the class
+   name or item name). Read the tag and the length of the string
+   together, returning without error if the end of input has been
+   reached. */
+   nnum = GetNextBinary( this, buf, 5, status );
+   if( nnum == 0 || !astOK ) return;
+   if( nnum < 5 ) {
+      astError( AST__EOCHN, "astRead(%s): Unexpected end of input in "
+                "the middle of a binary data item.", status,
+                astGetClass( this ) );
+      return;
+   }
+   tag = buf[ 0 ];
+
+/* "Begin", "IsA" and "End" items hold a class name. Return this as the
+   value, associated with the appropriate fixed name. */
+   if( tag == BIN_BEGIN || tag == BIN_ISA || tag == BIN_END ) {
+      class = GetBinaryString( this, buf + 1, status );
+      if( astOK ) {
+         *name = astStore( NULL, ( tag == BIN_BEGIN ) ? "begin" :
+                                 ( ( tag == BIN_ISA ) ? "isa" : "end" ),
+                           6 );
+         *val = class;
+      }
+
+/* Other items start with a name, which is converted to lower case to
+   match the names used by the class loaders. */
+   } else if( tag == BIN_STRING || tag == BIN_OBJECT ||
+              tag == BIN_DOUBLE || tag == BIN_INT || tag == BIN_INT64 ) {
+      *name = GetBinaryString( this, buf + 1, status );
+      if( astOK ) {
+         for( p = *name; *p; p++ ) *p = tolower( *p );
+
+/* String items are followed by the string value. Object items have no
+   value (the Object definition follows). */
+         if( tag == BIN_STRING ) {
+            *val = GetBinaryString( this, NULL, status );
+
+/* Numerical items are followed by the little-endian bytes of the value.
+   Decode them and store the value in a new Value structure. */
+         } else if( tag != BIN_OBJECT ) {
+            *value = astMalloc( sizeof( AstChannelValue ) );
+            if( astOK ) {
+               (*value)->name = NULL;
+               (*value)->ptr.string = NULL;
+               (*value)->is_object = 0;
+               (*value)->span = NULL;
+               (*value)->binary = tag;
+               (*value)->dval = 0.0;
+               (*value)->ival = 0;
+
+               nnum = ( tag == BIN_INT ) ? 4 : 8;
+               if( GetNextBinary( this, buf, nnum, status ) == nnum ) {
+                  bits = 0;
+                  for( i = (int) nnum - 1; i >= 0; i-- ) {
+                     bits = ( bits << 8 ) | buf[ i ];
+                  }
+
+                  if( (*value)->binary == BIN_DOUBLE ) {
+                     memcpy( &( (*value)->dval ), &bits, sizeof( double ) );
+                  } else if( (*value)->binary == BIN_INT ) {
+                     (*value)->ival = (int32_t) (uint32_t) bits;
+                  } else {
+                     (*value)->ival = (int64_t) bits;
+                  }
+
+               } else if( astOK ) {
+                  astError( AST__EOCHN, "astRead(%s): Unexpected end of "
+                            "input in the middle of a binary data item.",
+                            status, astGetClass( this ) );
+               }
+            }
+         }
+      }
+
+/* Report an error for any other tag. */
+   } else {
+      astError( AST__BADIN, "astRead(%s): Unrecognised data item (tag "
+                "%d) found in binary input.", status, astGetClass( this ),
+                (int) tag );
+   }
+
+/* If an error occurred, free any returned memory. */
+   if( !astOK ) {
+      *name = astFree( *name );
+      *val = astFree( *val );
+      *value = FreeValue( *value, status );
+   }
+}
+
 static void ReadClassData( AstChannel *this, const char *class, int *status ) {
 /*
 *+
@@ -2754,12 +4235,15 @@ static void ReadClassData( AstChannel *this, const char *class, int *status ) {
 
 /* Local Variables: */
    astDECLARE_GLOBALS            /* Declare the thread specific global data */
+   AstChannelSpan *span;         /* Pointer to unconverted Object */
    AstObject *object;            /* Pointer to new Object */
    AstChannelValue *value;       /* Pointer to Value structure */
    char *name;                   /* Pointer to data item name string */
    char *val;                    /* Pointer to data item value string */
+   int binary;                   /* Use the binary encoding? */
    int done;                     /* All class data read? */
    int indx;                     /* Index into hash table */
+   int spans;                    /* Defer conversion of Object values? */
    unsigned long hash;           /* Hash value for current name */
 
 /* Check the global error status. */
@@ -2808,11 +4292,23 @@ static void ReadClassData( AstChannel *this, const char *class, int *status ) {
 /* If we need new values, loop to read input data items until the end
    of the data for a class is reached. */
    } else {
+      binary = UseBinary( this, status );
+
+/* Keep any Objects in serialised form if the loader for the Object
+   being read has requested it (see astDeferObjects). */
+      spans = ( this->spans == nest );
       done = 0;
       while ( astOK && !done ) {
 
-/* Read the next input data item. */
-         astGetNextData( this, 0, &name, &val );
+/* Read the next input data item. If the binary encoding is being used,
+   numerical values are returned in a new Value structure instead of as
+   a string. */
+         if ( binary ) {
+            ReadBinaryItem( this, 0, &name, &val, &value, status );
+         } else {
+            astGetNextData( this, 0, &name, &val );
+            value = NULL;
+         }
          if ( astOK ) {
 
 /* Unexpected end of input. */
@@ -2886,6 +4382,15 @@ static void ReadClassData( AstChannel *this, const char *class, int *status ) {
 /* Note we have finished reading class data. */
                done = 1;
 
+/* Binary numerical value. */
+/* ------------------------ */
+/* If a Value structure was returned, store the pointer to the name in
+   it and append it to the values list for the current nesting level. */
+            } else if ( value ) {
+               value->name = name;
+               indx = HashFun( name, HASHMAP_SIZE - 1, &hash );
+               AppendValue( value, values_list[ nest ] + indx, status );
+
 /* String value. */
 /* ------------- */
 /* If any other name is obtained and "val" is not NULL, we have read a
@@ -2900,6 +4405,8 @@ static void ReadClassData( AstChannel *this, const char *class, int *status ) {
                   value->name = name;
                   value->ptr.string = val;
                   value->is_object = 0;
+                  value->span = NULL;
+                  value->binary = 0;
 
 /* Append the Value structure to the values list for the current
    nesting level. */
@@ -2925,9 +4432,17 @@ static void ReadClassData( AstChannel *this, const char *class, int *status ) {
    items and to build the Object, returning a pointer to it. This will
    result in recursive calls to the current function, but as these
    will use higher nesting levels they will not interfere with the
-   current invocation. */
+   current invocation. If the Channel is in lazy mode, instead just
+   store the serialised Object definition so that the Object can be
+   built later if required. */
                astreadclassdata_msg = 0;
-               object = astRead( this );
+               if ( spans ) {
+                  object = NULL;
+                  span = ReadSpanData( this, binary, status );
+               } else {
+                  object = astRead( this );
+                  span = NULL;
+               }
                if ( astOK ) {
 
 /* Store pointers to the name and Object in the Value structure and
@@ -2935,6 +4450,8 @@ static void ReadClassData( AstChannel *this, const char *class, int *status ) {
                   value->name = name;
                   value->ptr.object = object;
                   value->is_object = 1;
+                  value->span = span;
+                  value->binary = 0;
 
 /* Append the Value structure to the values list for the current
    nesting level. */
@@ -3021,7 +4538,8 @@ static double ReadDouble( AstChannel *this, const char *name, double def, int *s
 /* Local Variables: */
    AstChannelValue *value;       /* Pointer to required Value structure */
    double result;                /* Value to be returned */
-   int nc;                       /* Number of characters read by astSscanf */
+   int len;                      /* Length of the value string */
+   int nc;                       /* Number of characters read */
 
 /* Initialise. */
    result = 0.0;
@@ -3037,21 +4555,29 @@ static double ReadDouble( AstChannel *this, const char *name, double def, int *s
 /* If a Value was found, check that it describes a string (as opposed
    to an Object). */
       if ( value ) {
-         if ( !value->is_object ) {
+         if ( value->binary ) {
+
+/* If the Value holds a binary numerical value, use it directly. */
+            if ( value->binary == BIN_DOUBLE ) {
+               result = value->dval;
+            } else {
+               result = (double) value->ival;
+            }
+
+         } else if ( !value->is_object ) {
 
 /* If so, then attempt to decode the string to give a double value,
    checking that the entire string is read (and checking for the magic string
    used to represent bad values). If this fails, then the wrong name has
    probably been given, or the input data are corrupt, so report an error. */
-            nc = 0;
-            if ( ( 0 == astSscanf( value->ptr.string, " " BAD_STRING " %n",
-                                                      &nc ) )
-                    && ( nc >= (int) strlen( value->ptr.string ) ) ) {
+            len = (int) strlen( value->ptr.string );
+            nc = astChrReadDouble( value->ptr.string, &result );
+            if ( nc == 0 && ( 0 == astSscanf( value->ptr.string,
+                                              " " BAD_STRING " %n", &nc ) )
+                    && ( nc >= len ) ) {
                result = AST__BAD;
 
-            } else if ( !( ( 1 == astSscanf( value->ptr.string, " %lf %n",
-                                                      &result, &nc ) )
-                    && ( nc >= (int) strlen( value->ptr.string ) ) ) ) {
+            } else if ( !( nc && ( nc >= len ) ) ) {
                astError( AST__BADIN,
                          "astRead(%s): The value \"%s = %s\" cannot "
                          "be read as a double precision floating point "
@@ -3072,7 +4598,7 @@ static double ReadDouble( AstChannel *this, const char *name, double def, int *s
                       "astRead(%s): The Object \"%s = <%s>\" cannot "
                       "be read as a double precision floating point number.", status,
                       astGetClass( this ),
-                      value->name, astGetClass( value->ptr.object ) );
+                      value->name, ValueClass( value, status ) );
          }
 
 /* Free the Value structure and the resources it points at. */
@@ -3146,7 +4672,8 @@ static int ReadInt( AstChannel *this, const char *name, int def, int *status ) {
 
 /* Local Variables: */
    AstChannelValue *value;       /* Pointer to required Value structure */
-   int nc;                       /* Number of characters read by astSscanf */
+   char *text;                   /* Formatted binary value */
+   int nc;                       /* Number of characters read */
    int result;                   /* Value to be returned */
 
 /* Initialise. */
@@ -3163,16 +4690,37 @@ static int ReadInt( AstChannel *this, const char *name, int def, int *status ) {
 /* If a Value was found, check that it describes a string (as opposed
    to an Object). */
       if ( value ) {
-         if ( !value->is_object ) {
+         if ( value->binary ) {
+
+/* If the Value holds a binary numerical value, use it directly. A
+   floating point value must be integral and within range (as it would
+   need to be if it were read from a string). */
+            if ( value->binary != BIN_DOUBLE &&
+                 value->ival >= INT_MIN && value->ival <= INT_MAX ) {
+               result = (int) value->ival;
+
+            } else if ( value->binary == BIN_DOUBLE &&
+                        value->dval >= INT_MIN && value->dval <= INT_MAX &&
+                        value->dval == (double)(int) value->dval ) {
+               result = (int) value->dval;
+
+            } else {
+               text = FormatValue( value, status );
+               astError( AST__BADIN,
+                         "astRead(%s): The value \"%s = %s\" cannot "
+                         "be read as an integer.", status, astGetClass( this ),
+                         value->name, text );
+               text = astFree( text );
+            }
+
+         } else if ( !value->is_object ) {
 
 /* If so, then attempt to decode the string to give an int value,
    checking that the entire string is read. If this fails, then the
    wrong name has probably been given, or the input data are corrupt,
    so report an error. */
-            nc = 0;
-            if ( !( ( 1 == astSscanf( value->ptr.string, " %d %n",
-                                                      &result, &nc ) )
-                    && ( nc >= (int) strlen( value->ptr.string ) ) ) ) {
+            nc = astChrReadInt( value->ptr.string, &result );
+            if ( !( nc && ( nc >= (int) strlen( value->ptr.string ) ) ) ) {
                astError( AST__BADIN,
                          "astRead(%s): The value \"%s = %s\" cannot "
                          "be read as an integer.", status, astGetClass( this ),
@@ -3184,7 +4732,7 @@ static int ReadInt( AstChannel *this, const char *name, int def, int *status ) {
             astError( AST__BADIN,
                       "astRead(%s): The Object \"%s = <%s>\" cannot "
                       "be read as an integer.", status, astGetClass( this ),
-                      value->name, astGetClass( value->ptr.object ) );
+                      value->name, ValueClass( value, status ) );
          }
 
 /* Free the Value structure and the resources it points at. */
@@ -3258,7 +4806,8 @@ static int64_t ReadInt64( AstChannel *this, const char *name, int64_t def, int *
 
 /* Local Variables: */
    AstChannelValue *value;       /* Pointer to required Value structure */
-   int nc;                       /* Number of characters read by astSscanf */
+   char *text;                   /* Formatted binary value */
+   int nc;                       /* Number of characters read */
    int64_t result;               /* Value to be returned */
 
 /* Initialise. */
@@ -3275,16 +4824,35 @@ static int64_t ReadInt64( AstChannel *this, const char *name, int64_t def, int *
 /* If a Value was found, check that it describes a string (as opposed
    to an Object). */
       if ( value ) {
-         if ( !value->is_object ) {
+         if ( value->binary ) {
+
+/* If the Value holds a binary numerical value, use it directly. A
+   floating point value must be integral (as it would need to be if it
+   were read from a string). */
+            if ( value->binary != BIN_DOUBLE ) {
+               result = value->ival;
+
+            } else if ( value->dval > -9.2E18 && value->dval < 9.2E18 &&
+                        value->dval == (double)(int64_t) value->dval ) {
+               result = (int64_t) value->dval;
+
+            } else {
+               text = FormatValue( value, status );
+               astError( AST__BADIN,
+                         "astRead(%s): The value \"%s = %s\" cannot "
+                         "be read as a 64 bit integer.", status,
+                         astGetClass( this ), value->name, text );
+               text = astFree( text );
+            }
+
+         } else if ( !value->is_object ) {
 
 /* If so, then attempt to decode the string to give an int value,
    checking that the entire string is read. If this fails, then the
    wrong name has probably been given, or the input data are corrupt,
    so report an error. */
-            nc = 0;
-            if ( !( ( 1 == astSscanf( value->ptr.string, " %" SCNd64 " %n",
-                                                      &result, &nc ) )
-                    && ( nc >= (int) strlen( value->ptr.string ) ) ) ) {
+            nc = astChrReadInt64( value->ptr.string, &result );
+            if ( !( nc && ( nc >= (int) strlen( value->ptr.string ) ) ) ) {
                astError( AST__BADIN,
                          "astRead(%s): The value \"%s = %s\" cannot "
                          "be read as a 64 bit integer.", status,
@@ -3296,7 +4864,7 @@ static int64_t ReadInt64( AstChannel *this, const char *name, int64_t def, int *
             astError( AST__BADIN,
                       "astRead(%s): The Object \"%s = <%s>\" cannot be read "
                       "as a 64 bit integer.", status, astGetClass( this ),
-                      value->name, astGetClass( value->ptr.object ) );
+                      value->name, ValueClass( value, status ) );
          }
 
 /* Free the Value structure and the resources it points at. */
@@ -3392,9 +4960,15 @@ static AstObject *ReadObject( AstChannel *this, const char *name,
       if ( value ) {
          if ( value->is_object ) {
 
-/* If so, then extract the Object pointer, replacing it with NULL. */
-            result = value->ptr.object;
-            value->ptr.object = NULL;
+/* If so, then extract the Object pointer, replacing it with NULL. If
+   the Object has not yet been built (see astDeferObjects), build it
+   now from its serialised form. */
+            if ( value->span ) {
+               result = astSpanObject( value->span );
+            } else {
+               result = value->ptr.object;
+               value->ptr.object = NULL;
+            }
 
 /* If the Value does not describe an Object, then the wrong name has
    probably been given, or the input data are corrupt, so report an
@@ -3420,6 +4994,297 @@ static AstObject *ReadObject( AstChannel *this, const char *name,
    return result;
 }
 
+static AstChannelSpan *ReadSpan( AstChannel *this, const char *name,
+                                 int *status ) {
+/*
+*+
+*  Name:
+*     astReadSpan
+
+*  Purpose:
+*     Read an unconverted (sub)Object as part of loading a class.
+
+*  Type:
+*     Protected virtual function.
+
+*  Synopsis:
+*     #include "channel.h"
+*     AstChannelSpan *astReadSpan( AstChannel *this, const char *name )
+
+*  Class Membership:
+*     Channel method.
+
+*  Description:
+*     This function searches the current values list of a Channel to
+*     identify an Object with a specified name that has not yet been
+*     created (see astDeferObjects). If such an Object is found, the
+*     structure holding its serialised form is returned. The Object can
+*     be created later using astSpanObject.
+*
+*     This function should only be invoked from within the loader
+*     function associated with a class. It must be preceded by a call
+*     to the astDeferObjects function.
+
+*  Parameters:
+*     this
+*        Pointer to the Channel.
+*     name
+*        Pointer to a constant null-terminated character string
+*        containing the name of the required Object. This must be in
+*        lower case with no surrounding white space.
+
+*  Returned Value:
+*     A pointer to the structure holding the serialised Object, which
+*     should be freed using astFreeSpan when no longer required. NULL
+*     is returned if no such Object is found, in which case
+*     astReadObject should be used to obtain the Object (if any) in the
+*     usual way.
+
+*  Notes:
+*     - A NULL pointer will be returned if this function is invoked
+*     with the global error status set, or if it should fail for any
+*     reason.
+*-
+*/
+
+/* Local Variables: */
+   astDECLARE_GLOBALS            /* Declare the thread specific global data */
+   AstChannelSpan *result;       /* Pointer value to return */
+   AstChannelValue *value;       /* Pointer to required Value structure */
+   int indx;                     /* Index into hash table */
+   unsigned long hash;           /* Hash value for name */
+
+/* Initialise. */
+   result = NULL;
+
+/* Check the global error status. Spans are only created by basic
+   Channels that are in lazy mode. */
+   if ( !astOK || !UseLazy( this, status ) ) return result;
+
+/* Get a pointer to the structure holding thread-specific global data. */
+   astGET_GLOBALS(this);
+
+/* Search for a Value structure with the required name in the current
+   values list.*/
+   value = LookupValue( name, status );
+   if ( value ) {
+
+/* If it holds an unconverted Object, extract the span, and free the
+   Value structure. */
+      if ( value->span ) {
+         result = value->span;
+         value->span = NULL;
+         value = FreeValue( value, status );
+
+/* Otherwise, return the Value structure to the values list so that it
+   can be read using another function. */
+      } else {
+         indx = HashFun( name, HASHMAP_SIZE - 1, &hash );
+         AppendValue( value, values_list[ nest ] + indx, status );
+      }
+   }
+
+/* Return the result. */
+   return result;
+}
+
+static AstChannelSpan *ReadSpanData( AstChannel *this, int binary,
+                                     int *status ) {
+/*
+*  Name:
+*     ReadSpanData
+
+*  Purpose:
+*     Read the serialised form of an Object without creating it.
+
+*  Type:
+*     Private function.
+
+*  Synopsis:
+*     #include "channel.h"
+*     AstChannelSpan *ReadSpanData( AstChannel *this, int binary,
+*                                   int *status )
+
+*  Class Membership:
+*     Channel member function.
+
+*  Description:
+*     This function reads the input data items that describe an Object,
+*     from the "Begin" item to the matching "End" item, and returns them
+*     in a new AstChannelSpan structure, without creating the Object.
+*     Textual data items are stored with comments and leading and
+*     trailing spaces removed. Binary data items are stored preceded by
+*     the signature required at the start of a top-level binary Object.
+
+*  Parameters:
+*     this
+*        Pointer to the Channel.
+*     binary
+*        Non-zero if the Channel is using the binary encoding.
+*     status
+*        Pointer to the inherited status variable.
+
+*  Returned Value:
+*     Pointer to the new structure, which should be freed using
+*     astFreeSpan when no longer required.
+
+*  Notes:
+*     - A NULL pointer will be returned if this function is invoked
+*     with the global error status set, or if it should fail for any
+*     reason.
+*/
+
+/* Local Variables: */
+   AstChannelSpan *result;       /* Pointer value to return */
+   char *class;                  /* Class of Object */
+   char *line;                   /* Input line of text */
+   char *val;                    /* Pointer to class name in input line */
+   int depth;                    /* Nesting depth of Object definitions */
+   int first;                    /* Is this the first data item? */
+   size_t len;                   /* Length of input line */
+   size_t nbyte;                 /* Length of binary string */
+   unsigned char buf[ 5 ];       /* Buffer for binary tag and length */
+   unsigned char tag;            /* Tag identifying a binary item type */
+
+/* Initialise. */
+   result = NULL;
+
+/* Check the global error status. */
+   if ( !astOK ) return result;
+
+/* Allocate the returned structure. */
+   result = astMalloc( sizeof( AstChannelSpan ) );
+   if ( !astOK ) return result;
+   result->data = NULL;
+   result->size = 0;
+   result->class = NULL;
+   result->binary = binary;
+
+/* Loop to read data items until the "End" item matching the first
+   "Begin" item has been read. */
+   class = NULL;
+   depth = 0;
+   first = 1;
+
+/* In the binary encoding, skip over each data item without decoding its
+   value, and get GetNextBinary to record the bytes it reads. The
+   recorded data start with the signature of a top-level Object. Every
+   item starts with a tag byte and the length of a string (the class
+   name or item name). */
+   if ( binary ) {
+      this->span = astStore( NULL, BIN_SIGNATURE, BIN_SIGLEN );
+      this->nspan = BIN_SIGLEN;
+      this->recording = 1;
+      while ( astOK && ( first || depth > 0 ) ) {
+         if ( GetNextBinary( this, buf, 5, status ) != 5 ) {
+            if ( astOK ) {
+               astError( AST__EOCHN, "astRead(%s): Unexpected end of input "
+                         "(missing end of %s).", status, astGetClass( this ),
+                         class ? class : "Object" );
+            }
+            break;
+         }
+         tag = buf[ 0 ];
+         nbyte = (size_t) buf[ 1 ] | ( (size_t) buf[ 2 ] << 8 ) |
+                 ( (size_t) buf[ 3 ] << 16 ) | ( (size_t) buf[ 4 ] << 24 );
+
+/* Keep the class name from the first "Begin" item. Skip all other
+   strings. */
+         if ( first && tag == BIN_BEGIN ) {
+            class = GetBinaryString( this, buf + 1, status );
+         } else {
+            SkipBinary( this, nbyte, status );
+         }
+
+/* Track the nesting depth, and skip any value following the name. */
+         if ( tag == BIN_BEGIN ) {
+            depth++;
+         } else if ( tag == BIN_END ) {
+            depth--;
+         } else if ( tag == BIN_STRING ) {
+            if ( GetNextBinary( this, buf, 4, status ) == 4 ) {
+               nbyte = (size_t) buf[ 0 ] | ( (size_t) buf[ 1 ] << 8 ) |
+                       ( (size_t) buf[ 2 ] << 16 ) |
+                       ( (size_t) buf[ 3 ] << 24 );
+               SkipBinary( this, nbyte, status );
+            } else {
+               SkipBinary( this, 4, status );
+            }
+         } else if ( tag == BIN_DOUBLE || tag == BIN_INT64 ) {
+            SkipBinary( this, 8, status );
+         } else if ( tag == BIN_INT ) {
+            SkipBinary( this, 4, status );
+         } else if ( tag != BIN_ISA && tag != BIN_OBJECT && astOK ) {
+            astError( AST__BADIN, "astRead(%s): Unrecognised data item (tag "
+                      "%d) found in binary input.", status,
+                      astGetClass( this ), (int) tag );
+         }
+         if ( first && !depth && astOK ) {
+            astError( AST__BADIN, "astRead(%s): Bad class structure in "
+                      "input data - missing Begin item.", status,
+                      astGetClass( this ) );
+         }
+         first = 0;
+      }
+      this->recording = 0;
+      result->data = this->span;
+      result->size = this->nspan;
+      this->span = NULL;
+      this->nspan = 0;
+
+/* In the textual encoding, read each line using InputTextItem, which
+   removes comments and surrounding spaces, and append it to the
+   returned data. Only lines containing no "=" can be "Begin" or "End"
+   items. */
+   } else {
+      while ( astOK && ( first || depth > 0 ) ) {
+         line = InputTextItem( this, status );
+         if ( line ) {
+            len = strlen( line );
+            result->data = astGrow( result->data, result->size + len + 1,
+                                    sizeof( char ) );
+            if ( astOK ) {
+               memcpy( result->data + result->size, line, len );
+               result->size += len;
+               result->data[ result->size++ ] = '\n';
+            }
+            if ( !strchr( line, '=' ) ) {
+               if ( astChrMatchN( line, "begin", 5 ) ) {
+                  if ( first ) {
+                     val = line + 5;
+                     while ( isspace( *val ) ) val++;
+                     class = astStore( NULL, val, strlen( val ) + 1 );
+                  }
+                  depth++;
+               } else if ( astChrMatchN( line, "end", 3 ) ) {
+                  depth--;
+               }
+            }
+            line = astFree( line );
+         } else if ( astOK ) {
+            astError( AST__EOCHN, "astRead(%s): Unexpected end of input "
+                      "(missing end of %s).", status, astGetClass( this ),
+                      class ? class : "Object" );
+         }
+         if ( first && !depth && astOK ) {
+            astError( AST__BADIN, "astRead(%s): Bad class structure in "
+                      "input data - missing Begin item.", status,
+                      astGetClass( this ) );
+         }
+         first = 0;
+      }
+   }
+
+/* Store the class name. */
+   result->class = class;
+
+/* Free the returned structure if an error occurred. */
+   if ( !astOK ) result = astFreeSpan( result );
+
+/* Return the result. */
+   return result;
+}
+
 static char *ReadString( AstChannel *this, const char *name,
                          const char *def, int *status ) {
 /*
@@ -3503,7 +5368,13 @@ static char *ReadString( AstChannel *this, const char *name,
 /* If a Value was found, check that it describes a string (as opposed
    to an Object). */
       if ( value ) {
-         if ( !value->is_object ) {
+         if ( value->binary ) {
+
+/* If the Value holds a binary numerical value, format it in the same
+   way as the textual encoding. */
+            result = FormatValue( value, status );
+
+         } else if ( !value->is_object ) {
 
 /* If so, then extract the string pointer, replacing it with NULL. */
             result = value->ptr.string;
@@ -3516,7 +5387,7 @@ static char *ReadString( AstChannel *this, const char *name,
             astError( AST__BADIN,
                       "astRead(%s): The Object \"%s = <%s>\" cannot "
                       "be read as a string.", status, astGetClass( this ),
-                      value->name, astGetClass( value->ptr.object ) );
+                      value->name, ValueClass( value, status ) );
          }
 
 /* Free the Value structure and the resources it points at. */
@@ -3635,9 +5506,11 @@ static void SetAttrib( AstObject *this_object, const char *setting, int *status
 
 /* Local Variables: */
    AstChannel *this;             /* Pointer to the Channel structure */
+   int binary;                   /* Binary attribute value */
    int comment;                  /* Comment attribute value */
    int full;                     /* Full attribute value */
    int indent;                   /* Indent attribute value */
+   int lazy;                     /* Lazy attribute value */
    int len;                      /* Length of setting string */
    int nc;                       /* Number of characters read by "astSscanf" */
    int report_level;             /* Skip attribute value */
@@ -3661,11 +5534,25 @@ static void SetAttrib( AstObject *this_object, const char *setting, int *status
    in "nc" to check that the entire string was matched. Once a value
    has been obtained, use the appropriate method to set it. */
 
-/* Comment. */
-/* ---------*/
+/* Binary. */
+/* ------- */
    if ( nc = 0,
-        ( 1 == astSscanf( setting, "comment= %d %n", &comment, &nc ) )
+        ( 1 == astSscanf( setting, "binary= %d %n", &binary, &nc ) )
         && ( nc >= len ) ) {
+      astSetBinary( this, binary );
+
+/* Lazy. */
+/* ----- */
+   } else if ( nc = 0,
+               ( 1 == astSscanf( setting, "lazy= %d %n", &lazy, &nc ) )
+               && ( nc >= len ) ) {
+      astSetLazy( this, lazy );
+
+/* Comment. */
+/* ---------*/
+   } else if ( nc = 0,
+               ( 1 == astSscanf( setting, "comment= %d %n", &comment, &nc ) )
+               && ( nc >= len ) ) {
       astSetComment( this, comment );
 
 /* Full. */
@@ -3724,6 +5611,60 @@ static void SetAttrib( AstObject *this_object, const char *setting, int *status
    }
 }
 
+static void SkipBinary( AstChannel *this, size_t nbyte, int *status ) {
+/*
+*  Name:
+*     SkipBinary
+
+*  Purpose:
+*     Skip over bytes in a binary data source.
+
+*  Type:
+*     Private function.
+
+*  Synopsis:
+*     #include "channel.h"
+*     void SkipBinary( AstChannel *this, size_t nbyte, int *status )
+
+*  Class Membership:
+*     Channel member function.
+
+*  Description:
+*     This function reads and discards a specified number of bytes from
+*     a data source that uses the binary encoding (see attribute
+*     Binary). It is used when recording the serialised form of an
+*     Object (see astDeferObjects), in which case the bytes are still
+*     recorded by GetNextBinary. An error is reported if the end of
+*     input is reached first.
+
+*  Parameters:
+*     this
+*        Pointer to the Channel.
+*     nbyte
+*        The number of bytes to skip.
+*     status
+*        Pointer to the inherited status variable.
+*/
+
+/* Local Variables: */
+   size_t nread;                 /* Number of bytes to read */
+   unsigned char buf[ 256 ];     /* Buffer for discarded bytes */
+
+/* Read the bytes in chunks until all have been read, or the end of
+   input is reached. */
+   while( nbyte > 0 && astOK ) {
+      nread = ( nbyte < sizeof( buf ) ) ? nbyte : sizeof( buf );
+      if( GetNextBinary( this, buf, nread, status ) != nread ) {
+         if( astOK ) {
+            astError( AST__EOCHN, "astRead(%s): Unexpected end of input "
+                      "in the middle of a binary data item.", status,
+                      astGetClass( this ) );
+         }
+      }
+      nbyte -= nread;
+   }
+}
+
 static void SinkWrap( void (* sink)( const char * ), const char *line, int *status ) {
 /*
 *  Name:
@@ -3813,26 +5754,142 @@ static char *SourceWrap( const char *(* source)( void ), int *status ) {
 *     for any reason.
 */
 
-/* Local Variables: */
-   char *result;                 /* Pointer value to return */
-   const char *line;             /* Pointer to input line */
+/* Local Variables: */
+   char *result;                 /* Pointer value to return */
+   const char *line;             /* Pointer to input line */
+
+/* Initialise. */
+   result = NULL;
+
+/* Check the global error status. */
+   if ( !astOK ) return result;
+
+/* Invoke the source function to read the next input line and return a
+   pointer to the resulting string. */
+   line = ( *source )();
+
+/* If a string was obtained, make a dynamic copy of it and save the
+   resulting pointer. */
+   if ( line ) result = astString( line, (int) strlen( line ) );
+
+/* Return the result. */
+   return result;
+}
+
+AstObject *astSpanObject_( AstChannelSpan *span, int *status ) {
+/*
+*+
+*  Name:
+*     astSpanObject
+
+*  Purpose:
+*     Create an Object from its serialised form.
+
+*  Type:
+*     Protected function.
+
+*  Synopsis:
+*     #include "channel.h"
+*     AstObject *astSpanObject( AstChannelSpan *span )
+
+*  Description:
+*     This function creates an Object from the serialised form returned
+*     by astReadSpan. The supplied structure is left unchanged.
+
+*  Parameters:
+*     span
+*        Pointer to the structure holding the serialised Object.
+
+*  Returned Value:
+*     Pointer to the new Object.
+
+*  Notes:
+*     - A NULL pointer will be returned if this function is invoked
+*     with the global error status set, or if it should fail for any
+*     reason.
+*-
+*/
+
+/* Local Variables: */
+   astDECLARE_GLOBALS            /* Declare the thread specific global data */
+   AstChannel *channel;          /* Channel used to read the Object */
+   AstObject *result;            /* Pointer value to return */
+
+/* Initialise. */
+   result = NULL;
+
+/* Check the global error status and the supplied pointer. */
+   if ( !astOK || !span ) return result;
+
+/* Get a pointer to the structure holding thread-specific global data. */
+   astGET_GLOBALS(NULL);
+
+/* Create a basic Channel and store a copy of the serialised data in its
+   block input buffer. Register a block source function that indicates
+   that no further data are available. */
+   channel = astChannel( NULL, NULL, "", status );
+   if ( astOK ) {
+      channel->blockin = astStore( NULL, span->data, span->size );
+      channel->nblockin = span->size;
+      channel->iblockin = 0;
+      channel->blocksource = SpanSource;
+      channel->binary = span->binary;
+
+/* If another Object is currently being read (for instance, if a class
+   loader is asking for a deferred Object), astRead will treat this
+   Object as a nested Object and so will not expect the signature that
+   precedes a top-level Object in the binary encoding. Skip over it. */
+      if ( span->binary && nest != -1 ) channel->iblockin = BIN_SIGLEN;
+
+/* Read the Object. Report an error if it was not found. */
+      result = astRead( channel );
+      if ( !result && astOK ) {
+         astError( AST__EOCHN, "Failed to read a deferred %s Object.",
+                   status, span->class ? span->class : "" );
+      }
+   }
+
+/* Annul the Channel. */
+   channel = astAnnul( channel );
+
+/* Return the result. */
+   return result;
+}
+
+static size_t SpanSource( char *buf, size_t size ) {
+/*
+*  Name:
+*     SpanSource
+
+*  Purpose:
+*     A block source function that supplies no data.
+
+*  Type:
+*     Private function.
 
-/* Initialise. */
-   result = NULL;
+*  Synopsis:
+*     #include "channel.h"
+*     size_t SpanSource( char *buf, size_t size )
 
-/* Check the global error status. */
-   if ( !astOK ) return result;
+*  Class Membership:
+*     Channel member function.
 
-/* Invoke the source function to read the next input line and return a
-   pointer to the resulting string. */
-   line = ( *source )();
+*  Description:
+*     This function is used as the block source function for the Channels
+*     created by astSpanObject, all of whose input data is stored in the
+*     Channel's input buffer before it is read. It always indicates that
+*     no further input data is available.
 
-/* If a string was obtained, make a dynamic copy of it and save the
-   resulting pointer. */
-   if ( line ) result = astString( line, (int) strlen( line ) );
+*  Parameters:
+*     buf
+*        Buffer for input data (not used).
+*     size
+*        Size of buffer (not used).
 
-/* Return the result. */
-   return result;
+*  Returned Value:
+*     Zero.
+*/
+   return 0;
 }
 
 void astStoreChannelData_( AstChannel *this, int *status ) {
@@ -3936,9 +5993,19 @@ static int TestAttrib( AstObject *this_object, const char *attrib, int *status )
 
 /* Check the attribute name and test the appropriate attribute. */
 
+/* Binary. */
+/* ------- */
+   if ( !strcmp( attrib, "binary" ) ) {
+      result = astTestBinary( this );
+
+/* Lazy. */
+/* ----- */
+   } else if ( !strcmp( attrib, "lazy" ) ) {
+      result = astTestLazy( this );
+
 /* Comment. */
 /* -------- */
-   if ( !strcmp( attrib, "comment" ) ) {
+   } else if ( !strcmp( attrib, "comment" ) ) {
       result = astTestComment( this );
 
 /* Full. */
@@ -4150,6 +6217,143 @@ static int Use( AstChannel *this, int set, int helpful, int *status ) {
    return result;
 }
 
+static int UseBinary( AstChannel *this, int *status ) {
+/*
+*  Name:
+*     UseBinary
+
+*  Purpose:
+*     Decide whether to use the binary encoding.
+
+*  Type:
+*     Private function.
+
+*  Synopsis:
+*     #include "channel.h"
+*     int UseBinary( AstChannel *this, int *status )
+
+*  Class Membership:
+*     Channel member function.
+
+*  Description:
+*     This function returns a flag indicating if the binary encoding
+*     should be used to read or write Objects through a Channel. This
+*     is the case if the Binary attribute is set and the Channel is a
+*     basic Channel. Derived classes, which use their own encodings,
+*     ignore the Binary attribute.
+
+*  Parameters:
+*     this
+*        A pointer to the Channel.
+*     status
+*        Pointer to the inherited status variable.
+
+*  Returned Value:
+*     One if the binary encoding should be used, otherwise zero.
+
+*  Notes:
+*     - A value of zero will be returned if this function is invoked
+*     with the global error status set or if it should fail for any
+*     reason.
+*/
+
+/* Check the global error status. */
+   if ( !astOK ) return 0;
+
+/* Return the result. */
+   return astGetBinary( this ) && !strcmp( astGetClass( this ), "Channel" );
+}
+
+static int UseLazy( AstChannel *this, int *status ) {
+/*
+*  Name:
+*     UseLazy
+
+*  Purpose:
+*     Should the creation of nested Objects be deferred?
+
+*  Type:
+*     Private function.
+
+*  Synopsis:
+*     #include "channel.h"
+*     int UseLazy( AstChannel *this, int *status )
+
+*  Class Membership:
+*     Channel member function.
+
+*  Description:
+*     This function returns a flag indicating if astDeferObjects should
+*     cause nested Objects to be retained in serialised form rather than
+*     being created.
+*     This is only done if the Lazy attribute is non-zero and the
+*     supplied Channel is a basic Channel (derived classes such as the
+*     XmlChan class read their data in other ways).
+
+*  Parameters:
+*     this
+*        Pointer to the Channel.
+*     status
+*        Pointer to the inherited status variable.
+
+*  Returned Value:
+*     Non-zero if nested Objects should be retained in serialised form.
+
+*  Notes:
+*     - A value of zero will be returned if this function is invoked
+*     with the global error status set, or if it should fail for any
+*     reason.
+*/
+
+/* Check the global error status. */
+   if ( !astOK ) return 0;
+
+/* Return the result. */
+   return astGetLazy( this ) && !strcmp( astGetClass( this ), "Channel" );
+}
+
+static const char *ValueClass( AstChannelValue *value, int *status ) {
+/*
+*  Name:
+*     ValueClass
+
+*  Purpose:
+*     Return the class of an Object value.
+
+*  Type:
+*     Private function.
+
+*  Synopsis:
+*     #include "channel.h"
+*     const char *ValueClass( AstChannelValue *value, int *status )
+
+*  Class Membership:
+*     Channel member function.
+
+*  Description:
+*     This function returns the class name of the Object described by a
+*     Value structure, including Objects that have not yet been created
+*     (see astDeferObjects).
+
+*  Parameters:
+*     value
+*        Pointer to a Value structure describing an Object.
+*     status
+*        Pointer to the inherited status variable.
+
+*  Returned Value:
+*     Pointer to a constant null-terminated string holding the class
+*     name.
+*/
+
+/* If the Object has not yet been created, return the class name stored
+   with its serialised form. */
+   if ( value->span ) return value->span->class;
+
+/* Otherwise, get the class from the Object. */
+   return astGetClass( value->ptr.object );
+}
+
 static int Write( AstChannel *this, AstObject *object, int *status ) {
 /*
 *++
@@ -4291,32 +6495,46 @@ static void WriteBegin( AstChannel *this, const char *class,
 /* Get a pointer to the structure holding thread-specific global data. */
    astGET_GLOBALS(this);
 
-/* Start building a dynamic string with an initial space. Then add
-   further spaces to suit the current indentation level. */
-   line = astAppendString( NULL, &nc, " " );
-   for ( i = 0; i < current_indent; i++ ) {
-      line = astAppendString( line, &nc, " " );
-   }
+/* If the binary encoding is being used, write a "Begin" item, preceded
+   by the signature if this is a top-level Object. The indentation level
+   is used simply to record the nesting level. */
+   if ( UseBinary( this, status ) ) {
+      if ( !current_indent ) {
+         PutNextBinary( this, (const unsigned char *) BIN_SIGNATURE,
+                        BIN_SIGLEN, status );
+      }
+      PutBinaryItem( this, BIN_BEGIN, class, NULL, 0, status );
+      current_indent++;
+
+/* Otherwise, start building a dynamic string with an initial space.
+   Then add further spaces to suit the current indentation level. */
+   } else {
+      line = astAppendString( NULL, &nc, " " );
+      for ( i = 0; i < current_indent; i++ ) {
+         line = astAppendString( line, &nc, " " );
+      }
 
 /* Append the "Begin" keyword followed by the class name. */
-   line = astAppendString( line, &nc, "Begin " );
-   line = astAppendString( line, &nc, class );
+      line = astAppendString( line, &nc, "Begin " );
+      line = astAppendString( line, &nc, class );
 
 /* If required, also append the comment. */
-   if ( astGetComment( this ) && *comment ) {
-      line = astAppendString( line, &nc, " \t# " );
-      line = astAppendString( line, &nc, comment );
-   }
+      if ( astGetComment( this ) && *comment ) {
+         line = astAppendString( line, &nc, " \t# " );
+         line = astAppendString( line, &nc, comment );
+      }
 
 /* Write out the resulting line of text. */
-   OutputTextItem( this, line, status );
+      OutputTextItem( this, line, status );
 
 /* Free the dynamic string. */
-   line = astFree( line );
+      line = astFree( line );
+
+/* Increment the indentation level. */
+      current_indent += astGetIndent( this );
+   }
 
-/* Increment the indentation level and clear the count of items written
-   for this Object. */
-   current_indent += astGetIndent( this );
+/* Clear the count of items written for this Object. */
    items_written = 0;
 }
 
@@ -4417,6 +6635,7 @@ static void WriteDouble( AstChannel *this, const char *name,
    char buff[ BUFF_LEN + 1 ];    /* Local formatting buffer */
    int i;                        /* Loop counter for indentation characters */
    int nc;                       /* Number of output characters */
+   uint64_t bits;                /* Bits of binary value */
 
 /* Check the global error status. */
    if ( !astOK ) return;
@@ -4424,10 +6643,18 @@ static void WriteDouble( AstChannel *this, const char *name,
 /* Get a pointer to the structure holding thread-specific global data. */
    astGET_GLOBALS(this);
 
-/* Use the "set" and "helpful" flags, along with the Channel's
-   attributes to decide whether this value should actually be
+/* If the binary encoding is being used, only values that are needed to
+   re-create the Object are written. Write the bits of the value. */
+   if ( UseBinary( this, status ) ) {
+      if ( set ) {
+         memcpy( &bits, &value, sizeof( double ) );
+         PutBinaryItem( this, BIN_DOUBLE, name, NULL, bits, status );
+      }
+
+/* Otherwise, use the "set" and "helpful" flags, along with the
+   Channel's attributes to decide whether this value should actually be
    written. */
-   if ( Use( this, set, helpful, status ) ) {
+   } else if ( Use( this, set, helpful, status ) ) {
 
 /* Start building a dynamic string with an initial space, or a comment
    character if "set" is zero. Then add further spaces to suit the
@@ -4517,26 +6744,34 @@ static void WriteEnd( AstChannel *this, const char *class, int *status ) {
 /* Get a pointer to the structure holding thread-specific global data. */
    astGET_GLOBALS(this);
 
-/* Decrement the indentation level so that the "End" item matches the
-   corresponding "Begin" item. */
-   current_indent -= astGetIndent( this );
+/* If the binary encoding is being used, decrement the nesting level
+   and write an "End" item. */
+   if ( UseBinary( this, status ) ) {
+      current_indent--;
+      PutBinaryItem( this, BIN_END, class, NULL, 0, status );
+
+/* Otherwise, decrement the indentation level so that the "End" item
+   matches the corresponding "Begin" item. */
+   } else {
+      current_indent -= astGetIndent( this );
 
 /* Start building a dynamic string with an initial space. Then add
    further spaces to suit the current indentation level. */
-   line = astAppendString( NULL, &nc, " " );
-   for ( i = 0; i < current_indent; i++ ) {
-      line = astAppendString( line, &nc, " " );
-   }
+      line = astAppendString( NULL, &nc, " " );
+      for ( i = 0; i < current_indent; i++ ) {
+         line = astAppendString( line, &nc, " " );
+      }
 
 /* Append the "End" keyword followed by the class name. */
-   line = astAppendString( line, &nc, "End " );
-   line = astAppendString( line, &nc, class );
+      line = astAppendString( line, &nc, "End " );
+      line = astAppendString( line, &nc, class );
 
 /* Write out the resulting line of text. */
-   OutputTextItem( this, line, status );
+      OutputTextItem( this, line, status );
 
 /* Free the dynamic string. */
-   line = astFree( line );
+      line = astFree( line );
+   }
 }
 
 static void WriteFlush( AstChannel *this, int *status ) {
@@ -4560,7 +6795,8 @@ static void WriteFlush( AstChannel *this, int *status ) {
 
 *  Description:
 *     This function flushes any buffered output to any ouput file
-*     associated with the supplied CHannel.
+*     associated with the supplied CHannel, and passes any buffered
+*     output to any block sink function registered using astChannelBlock.
 
 *  Parameters:
 *     this
@@ -4571,8 +6807,10 @@ static void WriteFlush( AstChannel *this, int *status ) {
 /* Check the global error status. */
    if ( !astOK ) return;
 
-/* If the Channel has an associated output file, flush it. */
+/* If the Channel has an associated output file, flush it. Also pass
+   any buffered output to a block sink function. */
    if( this->fd_out ) fflush( this->fd_out );
+   FlushBlock( this, status );
 }
 
 static void WriteInt( AstChannel *this, const char *name, int set, int helpful,
@@ -4678,10 +6916,18 @@ static void WriteInt( AstChannel *this, const char *name, int set, int helpful,
 /* Get a pointer to the structure holding thread-specific global data. */
    astGET_GLOBALS(this);
 
-/* Use the "set" and "helpful" flags, along with the Channel's
-   attributes to decide whether this value should actually be
+/* If the binary encoding is being used, only values that are needed to
+   re-create the Object are written. */
+   if ( UseBinary( this, status ) ) {
+      if ( set ) {
+         PutBinaryItem( this, BIN_INT, name, NULL,
+                        (uint64_t) (uint32_t) value, status );
+      }
+
+/* Otherwise, use the "set" and "helpful" flags, along with the
+   Channel's attributes to decide whether this value should actually be
    written. */
-   if ( Use( this, set, helpful, status ) ) {
+   } else if ( Use( this, set, helpful, status ) ) {
 
 /* Start building a dynamic string with an initial space, or a comment
    character if "set" is zero. Then add further spaces to suit the
@@ -4819,10 +7065,18 @@ static void WriteInt64( AstChannel *this, const char *name, int set, int helpful
 /* Get a pointer to the structure holding thread-specific global data. */
    astGET_GLOBALS(this);
 
-/* Use the "set" and "helpful" flags, along with the Channel's
-   attributes to decide whether this value should actually be
+/* If the binary encoding is being used, only values that are needed to
+   re-create the Object are written. */
+   if ( UseBinary( this, status ) ) {
+      if ( set ) {
+         PutBinaryItem( this, BIN_INT64, name, NULL, (uint64_t) value,
+                        status );
+      }
+
+/* Otherwise, use the "set" and "helpful" flags, along with the
+   Channel's attributes to decide whether this value should actually be
    written. */
-   if ( Use( this, set, helpful, status ) ) {
+   } else if ( Use( this, set, helpful, status ) ) {
 
 /* Start building a dynamic string with an initial space, or a comment
    character if "set" is zero. Then add further spaces to suit the
@@ -4949,11 +7203,20 @@ static void WriteIsA( AstChannel *this, const char *class,
 /* Get a pointer to the structure holding thread-specific global data. */
    astGET_GLOBALS(this);
 
-/* Output an "IsA" item only if there has been at least one item
-   written since the last "Begin" or "IsA" item, or if the Full
+/* If the binary encoding is being used, output an "IsA" item only if
+   there has been at least one item written since the last "Begin" or
+   "IsA" item. */
+   if ( UseBinary( this, status ) ) {
+      if ( items_written ) {
+         PutBinaryItem( this, BIN_ISA, class, NULL, 0, status );
+         items_written = 0;
+      }
+
+/* Otherwise, output an "IsA" item only if there has been at least one
+   item written since the last "Begin" or "IsA" item, or if the Full
    attribute for the Channel is greater than zero (requesting maximum
    information). */
-   if ( items_written || astGetFull( this ) > 0 ) {
+   } else if ( items_written || astGetFull( this ) > 0 ) {
 
 /* Start building a dynamic string with an initial space. Then add
    further spaces to suit the current indentation level, but reduced
@@ -5087,10 +7350,19 @@ static void WriteObject( AstChannel *this, const char *name,
 /* Get a pointer to the structure holding thread-specific global data. */
    astGET_GLOBALS(this);
 
-/* Use the "set" and "helpful" flags, along with the Channel's
-   attributes to decide whether this value should actually be
+/* If the binary encoding is being used, only values that are needed to
+   re-create the Object are written. Write an Object item followed by
+   the Object itself. */
+   if ( UseBinary( this, status ) ) {
+      if ( set ) {
+         PutBinaryItem( this, BIN_OBJECT, name, NULL, 0, status );
+         (void) astWrite( this, value );
+      }
+
+/* Otherwise, use the "set" and "helpful" flags, along with the
+   Channel's attributes to decide whether this value should actually be
    written. */
-   if ( Use( this, set, helpful, status ) ) {
+   } else if ( Use( this, set, helpful, status ) ) {
 
 /* Start building a dynamic string with an initial space, or a comment
    character if "set" is zero. Then add further spaces to suit the
@@ -5233,10 +7505,17 @@ static void WriteString( AstChannel *this, const char *name,
 /* Get a pointer to the structure holding thread-specific global data. */
    astGET_GLOBALS(this);
 
-/* Use the "set" and "helpful" flags, along with the Channel's
-   attributes to decide whether this value should actually be
+/* If the binary encoding is being used, only values that are needed to
+   re-create the Object are written. The string needs no quoting. */
+   if ( UseBinary( this, status ) ) {
+      if ( set ) {
+         PutBinaryItem( this, BIN_STRING, name, value, 0, status );
+      }
+
+/* Otherwise, use the "set" and "helpful" flags, along with the
+   Channel's attributes to decide whether this value should actually be
    written. */
-   if ( Use( this, set, helpful, status ) ) {
+   } else if ( Use( this, set, helpful, status ) ) {
 
 /* Start building a dynamic string with an initial space, or a comment
    character if "set" is zero. Then add further spaces to suit the
@@ -5793,6 +8072,133 @@ astMAKE_GET(Channel,Strict,int,0,( this->strict != -INT_MAX ? this->strict : 0 )
 astMAKE_SET(Channel,Strict,int,strict,( value != 0 ))
 astMAKE_TEST(Channel,Strict,( this->strict != -INT_MAX ))
 
+/*
+*att++
+*  Name:
+*     Binary
+
+*  Purpose:
+*     Use a compact binary encoding?
+
+*  Type:
+*     Public attribute.
+
+*  Synopsis:
+*     Integer (boolean).
+
+*  Description:
+*     This is a boolean attribute which selects the encoding used by a
+*     basic Channel to describe AST Objects. If it is zero (the
+*     default), Objects are written and read as formatted text, as
+*     described in the documentation for the Channel class. If it is
+*     non-zero, a compact binary encoding is used instead.
+*
+*     The binary encoding stores each item of data as a single byte tag
+*     followed by length-prefixed strings and, for numerical values,
+*     the bytes of the value itself in little-endian order. Floating
+*     point values are therefore stored exactly, and reading them back
+*     involves no conversion to or from text. This makes the binary
+*     encoding considerably smaller and several times faster to read
+*     than the textual form, particularly for Objects that contain
+*     large numbers of numerical values (e.g. PolyMaps, LutMaps or
+*     Mocs). The Comment, Full and Indent attributes are ignored, and
+*     only those values that are needed to re-create an Object are
+*     written.
+*
+*     Binary data cannot be passed through the source and sink
+c     functions supplied when the Channel was created. So a binary
+f     routines supplied when the Channel was created. So a binary
+*     Channel must be associated with files using the SourceFile and
+c     SinkFile attributes, must use block source and sink functions
+c     registered using astChannelBlock, or must read from standard
+c     input and write to standard output. Objects read from a binary
+c     Channel must have
+f     SinkFile attributes, or must read from standard input and write
+f     to standard output. Objects read from a binary Channel must have
+*     been written by a binary Channel, and the Skip attribute is
+*     ignored.
+
+*  Applicability:
+*     Channel
+*        All Channels have this attribute.
+*     FitsChan
+*        The FitsChan class ignores this attribute.
+*     MocChan
+*        The MocChan class ignores this attribute.
+*     StcsChan
+*        The StcsChan class ignores this attribute.
+*     XmlChan
+*        The XmlChan class ignores this attribute.
+*     YamlChan
+*        The YamlChan class ignores this attribute.
+*att--
+*/
+
+/* This ia a boolean value (0 or 1) with a value of -INT_MAX when
+   undefined but yielding a default of zero. */
+astMAKE_CLEAR(Channel,Binary,binary,-INT_MAX)
+astMAKE_GET(Channel,Binary,int,0,( this->binary != -INT_MAX ? this->binary : 0 ))
+astMAKE_SET(Channel,Binary,int,binary,( value != 0 ))
+astMAKE_TEST(Channel,Binary,( this->binary != -INT_MAX ))
+
+/*
+*att++
+*  Name:
+*     Lazy
+
+*  Purpose:
+*     Defer creation of Objects nested within FrameSets?
+
+*  Type:
+*     Public attribute.
+
+*  Synopsis:
+*     Integer (boolean).
+
+*  Description:
+*     This is a boolean attribute which controls when a basic Channel
+*     creates the Frames and Mappings contained within a FrameSet that
+*     is being read. If it is zero (the default), they are all created
+*     when the FrameSet is read. If it is non-zero, each Frame and
+*     Mapping is instead retained in its serialised form, and is only
+*     created when it is first used (for instance, when the Mapping
+*     between the base and current Frames is obtained, only the
+*     Mappings on the path between those two Frames are created).
+*
+*     This can significantly reduce the time taken to read FrameSets
+*     that contain many Frames (for instance, many alternate
+*     coordinate systems), if only a few of them are subsequently
+*     used. The Objects within a FrameSet are all created if the
+*     FrameSet is modified (e.g. by adding or removing a Frame), or
+*     if it is written out or compared with another FrameSet.
+*
+*     Note, errors in the description of a Frame or Mapping are not
+*     detected until the Frame or Mapping is created, which may be
+*     some time after the FrameSet itself was read.
+
+*  Applicability:
+*     Channel
+*        All Channels have this attribute.
+*     FitsChan
+*        The FitsChan class ignores this attribute.
+*     MocChan
+*        The MocChan class ignores this attribute.
+*     StcsChan
+*        The StcsChan class ignores this attribute.
+*     XmlChan
+*        The XmlChan class ignores this attribute.
+*     YamlChan
+*        The YamlChan class ignores this attribute.
+*att--
+*/
+
+/* This ia a boolean value (0 or 1) with a value of -INT_MAX when
+   undefined but yielding a default of zero. */
+astMAKE_CLEAR(Channel,Lazy,lazy,-INT_MAX)
+astMAKE_GET(Channel,Lazy,int,0,( this->lazy != -INT_MAX ? this->lazy : 0 ))
+astMAKE_SET(Channel,Lazy,int,lazy,( value != 0 ))
+astMAKE_TEST(Channel,Lazy,( this->lazy != -INT_MAX ))
+
 /* Destructor. */
 /* ----------- */
 static void Delete( AstObject *obj, int *status ) {
@@ -5832,6 +8238,15 @@ static void Delete( AstObject *obj, int *status ) {
 /* Free memory used to store warnings. */
    astAddWarning( this, 0, NULL, NULL, status );
 
+/* Pass any remaining buffered output to the block sink function, and
+   free the block buffers. */
+   if( astOK ) FlushBlock( this, status );
+   this->blockin = astFree( this->blockin );
+   this->blockout = astFree( this->blockout );
+
+/* Free any partially recorded serialised Object. */
+   this->span = astFree( this->span );
+
 /* Close any open input or output files. */
    if( this->fd_in ) fclose( this->fd_in );
    if( this->fd_out ) fclose( this->fd_out );
@@ -5888,6 +8303,15 @@ static void Copy( const AstObject *objin, AstObject *objout, int *status ) {
    out->fn_in = NULL;
    out->fd_out = NULL;
    out->fn_out = NULL;
+   out->blockin = NULL;
+   out->nblockin = 0;
+   out->iblockin = 0;
+   out->blockout = NULL;
+   out->nblockout = 0;
+   out->spans = -1;
+   out->span = NULL;
+   out->nspan = 0;
+   out->recording = 0;
 }
 
 /* Dump function. */
@@ -5975,6 +8399,22 @@ static void Dump( AstObject *this_object, AstChannel *channel, int *status ) {
                 ival ? "Report errors insead of warnings" :
                        "Report warnings instead of errors" );
 
+/* Binary. */
+/* ------- */
+   set = TestBinary( this, status );
+   ival = set ? GetBinary( this, status ) : astGetBinary( this );
+   astWriteInt( channel, "Binary", set, 0, ival,
+                ival ? "Use binary encoding" :
+                       "Use textual encoding" );
+
+/* Lazy. */
+/* ----- */
+   set = TestLazy( this, status );
+   ival = set ? GetLazy( this, status ) : astGetLazy( this );
+   astWriteInt( channel, "Lazy", set, 0, ival,
+                ival ? "Defer creation of nested Objects" :
+                       "Create nested Objects immediately" );
+
 /* Full. */
 /* ----- */
    set = TestFull( this, status );
@@ -6640,6 +9080,13 @@ AstChannel *astLoadChannel_( void *mem, size_t size,
       new->source_wrap = NULL;
       new->sink = NULL;
       new->sink_wrap = NULL;
+      new->blocksource = NULL;
+      new->blocksink = NULL;
+      new->blockin = NULL;
+      new->nblockin = 0;
+      new->iblockin = 0;
+      new->blockout = NULL;
+      new->nblockout = 0;
 
 /* We do not have any data to pass to the source and sink functions. */
       new->data = NULL;
@@ -6685,6 +9132,20 @@ AstChannel *astLoadChannel_( void *mem, size_t size,
       new->strict = astReadInt( channel, "strict", -INT_MAX );
       if ( TestStrict( new, status ) ) SetStrict( new, new->strict, status );
 
+/* Binary. */
+/* ------- */
+      new->binary = astReadInt( channel, "binary", -INT_MAX );
+      if ( TestBinary( new, status ) ) SetBinary( new, new->binary, status );
+
+/* Lazy. */
+/* ----- */
+      new->lazy = astReadInt( channel, "lazy", -INT_MAX );
+      if ( TestLazy( new, status ) ) SetLazy( new, new->lazy, status );
+      new->spans = -1;
+      new->span = NULL;
+      new->nspan = 0;
+      new->recording = 0;
+
 /* Full. */
 /* ----- */
       new->full = astReadInt( channel, "full", -INT_MAX );
@@ -6725,6 +9186,10 @@ char *astGetNextText_( AstChannel *this, int *status ) {
    if ( !astOK ) return NULL;
    return (**astMEMBER(this,Channel,GetNextText))( this, status );
 }
+void astDeferObjects_( AstChannel *this, int *status ) {
+   if ( !astOK ) return;
+   (**astMEMBER(this,Channel,DeferObjects))( this, status );
+}
 void astPutNextText_( AstChannel *this, const char *line, int *status ) {
    if ( !astOK ) return;
    (**astMEMBER(this,Channel,PutNextText))( this, line, status );
@@ -6755,6 +9220,10 @@ AstObject *astReadObject_( AstChannel *this, const char *name,
    if ( !astOK ) return NULL;
    return (**astMEMBER(this,Channel,ReadObject))( this, name, def, status );
 }
+AstChannelSpan *astReadSpan_( AstChannel *this, const char *name, int *status ) {
+   if ( !astOK ) return NULL;
+   return (**astMEMBER(this,Channel,ReadSpan))( this, name, status );
+}
 char *astReadString_( AstChannel *this, const char *name, const char *def, int *status ) {
    if ( !astOK ) return NULL;
    return (**astMEMBER(this,Channel,ReadString))( this, name, def, status );
@@ -6800,6 +9269,11 @@ void astPutChannelData_( AstChannel *this, void *data, int *status ) {
    if ( !astOK ) return;
    (**astMEMBER(this,Channel,PutChannelData))( this, data, status );
 }
+void astChannelBlock_( AstChannel *this, size_t (* source)( char *, size_t ),
+                       void (* sink)( const char *, size_t ), int *status ) {
+   if ( !astOK ) return;
+   (**astMEMBER(this,Channel,ChannelBlock))( this, source, sink, status );
+}
 AstKeyMap *astWarnings_( AstChannel *this, int *status ){
    if( !astOK ) return NULL;
    return (**astMEMBER(this,Channel,Warnings))( this, status );
@@ -38,6 +38,10 @@
 *     None.
 
 *  New Attributes Defined:
+*     Binary (integer)
+*        A boolean value which controls whether a basic Channel uses
+*        a compact binary encoding instead of the usual textual one.
+*        The default is zero (text).
 *     Comment (integer)
 *        A boolean value (0 or 1) which controls whether comments are
 *        to be included in textual output generated by a Channel. If
@@ -52,6 +56,10 @@
 *        all non-essential information will be suppressed, while if it
 *        is positive, the output will include the maximum amount of
 *        information about the Object being written.
+*     Lazy (integer)
+*        A boolean value which controls whether a basic Channel defers
+*        the creation of Objects nested within a FrameSet until they
+*        are first used. The default is zero (create immediately).
 *     Skip (integer)
 *        A boolean value which indicates whether the Objects being
 *        read through a Channel are inter-mixed with other external
@@ -78,6 +86,8 @@
 
 *  New Methods Defined:
 *     Public:
+*        astChannelBlock
+*           Register block-oriented source and sink functions.
 *        astRead
 *           Read an Object from a Channel.
 *        astWrite
@@ -90,6 +100,8 @@
 *           Clear the Full attribute for a Channel.
 *        astClearSkip
 *           Clear the Skip attribute for a Channel.
+*        astDeferObjects
+*           Defer the creation of Objects nested in the Object being read.
 *        astGetComment
 *           Get the value of the Comment attribute for a Channel.
 *        astGetFull
@@ -110,6 +122,8 @@
 *           Read an int value as part of loading a class.
 *        astReadObject
 *           Read a (sub)Object as part of loading a class.
+*        astReadSpan
+*           Read an unconverted (sub)Object as part of loading a class.
 *        astReadString
 *           Read a string value as part of loading a class.
 *        astSetComment
@@ -281,6 +295,19 @@ typedef struct AstChannel {
    char *fn_in;                  /* Full path for source text file */
    FILE *fd_out;                 /* Descriptor for sink text file */
    char *fn_out;                 /* Full path for sink text file */
+   int binary;                   /* Use binary encoding? */
+   int lazy;                     /* Defer reading of nested Objects? */
+   int spans;                    /* Nesting level for deferred Objects */
+   char *span;                   /* Binary data recorded for a span */
+   size_t nspan;                 /* Number of bytes in "span" */
+   int recording;                /* Record binary data in "span"? */
+   size_t (* blocksource)( char *, size_t ); /* Block source function */
+   void (* blocksink)( const char *, size_t ); /* Block sink function */
+   char *blockin;                /* Buffer of data from block source */
+   size_t nblockin;              /* Number of bytes in "blockin" */
+   size_t iblockin;              /* Index of next unused byte in "blockin" */
+   char *blockout;               /* Buffer of data for block sink */
+   size_t nblockout;             /* Number of bytes in "blockout" */
 } AstChannel;
 
 /* Virtual function table. */
@@ -318,8 +345,11 @@ typedef struct AstChannelVtab {
    void (* ClearStrict)( AstChannel *, int * );
    void (* GetNextData)( AstChannel *, int, char **, char **, int * );
    void (* PutChannelData)( AstChannel *, void *, int * );
+   void (* ChannelBlock)( AstChannel *, size_t (*)( char *, size_t ), void (*)( const char *, size_t ), int * );
    void (* PutNextText)( AstChannel *, const char *, int * );
    void (* ReadClassData)( AstChannel *, const char *, int * );
+   void (* DeferObjects)( AstChannel *, int * );
+   struct AstChannelSpan *(* ReadSpan)( AstChannel *, const char *, int * );
    void (* SetComment)( AstChannel *, int, int * );
    void (* SetFull)( AstChannel *, int, int * );
    void (* SetStrict)( AstChannel *, int, int * );
@@ -357,8 +387,28 @@ typedef struct AstChannelVtab {
    int (* TestSinkFile)( AstChannel *, int * );
    void (* ClearSinkFile)( AstChannel *, int * );
    void (* SetSinkFile)( AstChannel *, const char *, int * );
+
+   int (* GetBinary)( AstChannel *, int * );
+   int (* TestBinary)( AstChannel *, int * );
+   void (* ClearBinary)( AstChannel *, int * );
+   void (* SetBinary)( AstChannel *, int, int * );
+
+   int (* GetLazy)( AstChannel *, int * );
+   int (* TestLazy)( AstChannel *, int * );
+   void (* ClearLazy)( AstChannel *, int * );
+   void (* SetLazy)( AstChannel *, int, int * );
 } AstChannelVtab;
 
+/* Define a structure type used to hold the serialised form of an Object
+   that has been read from a Channel but not yet converted into an
+   Object (see attribute Lazy). */
+typedef struct AstChannelSpan {
+   char *data;                    /* Serialised Object */
+   size_t size;                   /* Number of bytes in "data" */
+   char *class;                   /* Class of the serialised Object */
+   int binary;                    /* Does "data" use the binary encoding? */
+} AstChannelSpan;
+
 /* Define a private structure type used to store linked lists of
    name-value associations. */
 typedef struct AstChannelValue {
@@ -370,6 +420,10 @@ typedef struct AstChannelValue {
       AstObject *object;          /* Pointer to Object value */
    } ptr;
    int is_object;                 /* Whether value is an Object (else string) */
+   AstChannelSpan *span;          /* Unconverted Object value, if any */
+   int binary;                    /* Type code of binary numerical value */
+   double dval;                   /* Binary floating point value */
+   int64_t ival;                  /* Binary integer value */
 } AstChannelValue;
 
 #if defined(THREAD_SAFE)
@@ -451,6 +505,7 @@ void astInitChannelGlobals_( AstChannelGlobals * );
 AstObject *astRead_( AstChannel *, int * );
 int astWrite_( AstChannel *, AstObject *, int * );
 void astPutChannelData_( AstChannel *, void *, int * );
+void astChannelBlock_( AstChannel *, size_t (*)( char *, size_t ), void (*)( const char *, size_t ), int * );
 void *astChannelData_( void );
 struct AstKeyMap *astWarnings_( AstChannel *, int * );
 
@@ -460,6 +515,10 @@ void astSinkWrap_( void (*)( const char * ), const char *, int * );
 # if defined(astCLASS)           /* Protected */
 void astStoreChannelData_( AstChannel *, int * );
 AstObject *astReadObject_( AstChannel *, const char *, AstObject *, int * );
+AstChannelSpan *astReadSpan_( AstChannel *, const char *, int * );
+AstChannelSpan *astCopySpan_( AstChannelSpan *, int * );
+AstChannelSpan *astFreeSpan_( AstChannelSpan *, int * );
+AstObject *astSpanObject_( AstChannelSpan *, int * );
 char *astGetNextText_( AstChannel *, int * );
 char *astReadString_( AstChannel *, const char *, const char *, int * );
 double astReadDouble_( AstChannel *, const char *, double, int * );
@@ -475,6 +534,7 @@ void astAddWarning_( void *, int, const char *, const char *, int *, ... )__attr
 void astClearComment_( AstChannel *, int * );
 void astClearFull_( AstChannel *, int * );
 void astClearStrict_( AstChannel *, int * );
+void astDeferObjects_( AstChannel *, int * );
 void astGetNextData_( AstChannel *, int, char **, char **, int * );
 void astPutNextText_( AstChannel *, const char *, int * );
 void astReadClassData_( AstChannel *, const char *, int * );
@@ -517,6 +577,16 @@ int astTestSinkFile_( AstChannel *, int * );
 void astClearSinkFile_( AstChannel *, int * );
 void astSetSinkFile_( AstChannel *, const char *, int * );
 
+int astGetBinary_( AstChannel *, int * );
+int astTestBinary_( AstChannel *, int * );
+void astClearBinary_( AstChannel *, int * );
+void astSetBinary_( AstChannel *, int, int * );
+
+int astGetLazy_( AstChannel *, int * );
+int astTestLazy_( AstChannel *, int * );
+void astClearLazy_( AstChannel *, int * );
+void astSetLazy_( AstChannel *, int, int * );
+
 #endif
 
 /* Function interfaces. */
@@ -571,6 +641,8 @@ astINVOKE(O,astRead_(astCheckChannel(this),STATUS_PTR))
 astINVOKE(V,astWrite_(astCheckChannel(this),astCheckObject(object),STATUS_PTR))
 #define astPutChannelData(this,data) \
 astINVOKE(V,astPutChannelData_(astCheckChannel(this),data,STATUS_PTR))
+#define astChannelBlock(this,source,sink) \
+astINVOKE(V,astChannelBlock_(astCheckChannel(this),source,sink,STATUS_PTR))
 #define astWarnings(this) \
 astINVOKE(O,astWarnings_(astCheckChannel(this),STATUS_PTR))
 
@@ -589,6 +661,8 @@ astINVOKE(V,astClearComment_(astCheckChannel(this),STATUS_PTR))
 astINVOKE(V,astClearFull_(astCheckChannel(this),STATUS_PTR))
 #define astClearStrict(this) \
 astINVOKE(V,astClearStrict_(astCheckChannel(this),STATUS_PTR))
+#define astDeferObjects(this) \
+astINVOKE(V,astDeferObjects_(astCheckChannel(this),STATUS_PTR))
 #define astGetComment(this) \
 astINVOKE(V,astGetComment_(astCheckChannel(this),STATUS_PTR))
 #define astGetFull(this) \
@@ -611,8 +685,13 @@ astINVOKE(V,astReadInt_(astCheckChannel(this),name,def,STATUS_PTR))
 astINVOKE(V,astReadInt64_(astCheckChannel(this),name,def,STATUS_PTR))
 #define astReadObject(this,name,def) \
 astINVOKE(O,astReadObject_(astCheckChannel(this),name,(def)?astCheckObject(def):NULL,STATUS_PTR))
+#define astReadSpan(this,name) \
+astINVOKE(V,astReadSpan_(astCheckChannel(this),name,STATUS_PTR))
 #define astReadString(this,name,def) \
 astINVOKE(V,astReadString_(astCheckChannel(this),name,def,STATUS_PTR))
+#define astCopySpan(span) astCopySpan_(span,STATUS_PTR)
+#define astFreeSpan(span) astFreeSpan_(span,STATUS_PTR)
+#define astSpanObject(span) astINVOKE(O,astSpanObject_(span,STATUS_PTR))
 #define astSetComment(this,value) \
 astINVOKE(V,astSetComment_(astCheckChannel(this),value,STATUS_PTR))
 #define astSetFull(this,value) \
@@ -691,6 +770,24 @@ astINVOKE(V,astSetSinkFile_(astCheckChannel(this),value,STATUS_PTR))
 #define astTestSinkFile(this) \
 astINVOKE(V,astTestSinkFile_(astCheckChannel(this),STATUS_PTR))
 
+#define astClearBinary(this) \
+astINVOKE(V,astClearBinary_(astCheckChannel(this),STATUS_PTR))
+#define astGetBinary(this) \
+astINVOKE(V,astGetBinary_(astCheckChannel(this),STATUS_PTR))
+#define astSetBinary(this,value) \
+astINVOKE(V,astSetBinary_(astCheckChannel(this),value,STATUS_PTR))
+#define astTestBinary(this) \
+astINVOKE(V,astTestBinary_(astCheckChannel(this),STATUS_PTR))
+
+#define astClearLazy(this) \
+astINVOKE(V,astClearLazy_(astCheckChannel(this),STATUS_PTR))
+#define astGetLazy(this) \
+astINVOKE(V,astGetLazy_(astCheckChannel(this),STATUS_PTR))
+#define astSetLazy(this,value) \
+astINVOKE(V,astSetLazy_(astCheckChannel(this),value,STATUS_PTR))
+#define astTestLazy(this) \
+astINVOKE(V,astTestLazy_(astCheckChannel(this),STATUS_PTR))
+
 #endif
 #endif
 
@@ -184,6 +184,7 @@ f     The CmpMap class does not define any new routines beyond those
 #include "channel.h"             /* I/O channels */
 #include "permmap.h"             /* Coordinate permutation Mappings */
 #include "unitmap.h"             /* Unit transformations */
+#include "matrixmap.h"           /* Matrix multiplication */
 #include "cmpmap.h"              /* Interface definition for this class */
 #include "frameset.h"            /* Interface definition for FrameSets */
 #include "globals.h"             /* Thread-safe global data access */
@@ -899,10 +900,14 @@ void astInitCmpMapVtab_(  AstCmpMapVtab *vtab, const char *name, int *status ) {
 
 /* If we have just initialised the vtab for the current class, indicate
    that the vtab is now initialised, and store a pointer to the class
-   identifier in the base "object" level of the vtab. */
+   identifier in the base "object" level of the vtab. Also indicate that
+   the memory used by deleted CmpMaps should be re-used (see the
+   ObjectPool tuning parameter), since large numbers of short-lived
+   CmpMaps are often created. This is not done for sub-classes. */
    if( vtab == &class_vtab ) {
       class_init = 1;
       astSetVtabClassIdentifier( vtab, &(vtab->id) );
+      astSetVtabPooled( vtab );
    }
 }
 
@@ -3428,6 +3433,7 @@ static AstMapping *Simplify( AstMapping *this_mapping, int *status ) {
    int *invert_list;             /* Invert array pointer */
    int *mlist;                   /* Point to list of modified Mapping indices */
    int *nlist;                   /* Point to list of Mapping counts */
+   int affine;                   /* Affine runs have been merged? */
    int i;                        /* Loop counter for Mappings */
    int improved;                 /* Simplification achieved? */
    int invert;                   /* Invert attribute value */
@@ -3538,6 +3544,7 @@ static AstMapping *Simplify( AstMapping *this_mapping, int *status ) {
 
 /* Loop to simplify the sequence until a complete pass through it has
    been made without producing any improvement. */
+   affine = 0;
    improved = 1;
    while ( astOK && improved ) {
       improved = 0;
@@ -3612,6 +3619,22 @@ static AstMapping *Simplify( AstMapping *this_mapping, int *status ) {
             }
          }
       }
+
+/* When no further pair-wise merging is possible, attempt (once only) to
+   collapse any remaining runs of affine Mappings (e.g. interleaved
+   MatrixMaps, WinMaps, ShiftMaps, ZoomMaps and PermMaps) into a single
+   affine stage. If this changes anything, go round again to see if the
+   new Mappings can be merged with their neighbours. This is not done
+   for restricted simplification since it would modify Mappings that
+   have not been flagged as available for simplification. */
+      if( !improved && !affine && !restricted && astOK ) {
+         affine = 1;
+         if( astMergeAffine( this->series, &nmap, &map_list,
+                             &invert_list ) >= 0 ) {
+            improved = 1;
+            simpler = 1;
+         }
+      }
    }
 
 /* Free resources */
@@ -3809,13 +3832,17 @@ static AstPointSet *Transform( AstMapping *this, AstPointSet *in,
    AstPointSet *temp1;           /* Pointer to temporary PointSet */
    AstPointSet *temp2;           /* Pointer to temporary PointSet */
    AstPointSet *temp;            /* Pointer to temporary PointSet */
+   double **ptr;                 /* Pointers to intermediate coordinates */
+   double *values;               /* Intermediate coordinate values */
    int forward1;                 /* Use forward direction for Mapping 1? */
    int forward2;                 /* Use forward direction for Mapping 2? */
+   int icoord;                   /* Intermediate coordinate index */
    int ipoint1;                  /* Index of first point in batch */
    int ipoint2;                  /* Index of last point in batch */
    int nin1;                     /* No. input coordinates for Mapping 1 */
    int nin2;                     /* No. input coordinates for Mapping 2 */
    int nin;                      /* No. input coordinates supplied */
+   int nmid;                     /* No. intermediate coordinates */
    int nout1;                    /* No. output coordinates for Mapping 1 */
    int nout2;                    /* No. output coordinates for Mapping 2 */
    int nout;                     /* No. output coordinates supplied */
@@ -3872,8 +3899,25 @@ static AstPointSet *Transform( AstMapping *this, AstPointSet *in,
          nin = astGetNcoord( in );
          nout = astGetNcoord( result );
 
+/* Obtain the number of intermediate coordinates produced by the first
+   Mapping to be applied. */
+         if ( forward ) {
+            nmid = forward1 ? astGetNout( map->map1 ) : astGetNin( map->map1 );
+         } else {
+            nmid = forward2 ? astGetNout( map->map2 ) : astGetNin( map->map2 );
+         }
+
+/* Obtain memory from the arena to hold the intermediate coordinate values
+   for one batch of points. Using the arena means that repeated calls to
+   this function (which are common when a CmpMap is used within another
+   Mapping) do not need to call malloc and free to obtain this memory. */
+         astBeginArena;
+         np = ( npoint < nbatch ) ? npoint : nbatch;
+         ptr = astArenaMalloc( sizeof( double * )*(size_t) nmid );
+         values = astArenaMalloc( sizeof( double )*(size_t) ( nmid*np ) );
+
 /* Loop to process all the points in batches, of maximum size nbatch points. */
-         for ( ipoint1 = 0; ipoint1 < npoint; ipoint1 += nbatch ) {
+         for ( ipoint1 = 0; astOK && ipoint1 < npoint; ipoint1 += nbatch ) {
 
 /* Calculate the index of the final point in the batch and deduce the number of
    points (np) to be processed in this batch. */
@@ -3891,14 +3935,23 @@ static AstPointSet *Transform( AstMapping *this, AstPointSet *in,
             astSetSubPoints( in, ipoint1, 0, temp1 );
             astSetSubPoints( result, ipoint1, 0, temp2 );
 
-/* Apply the two Mappings in sequence and in the required order and direction.
-   Store the intermediate result in a temporary PointSet (temp) which is
-   created by the first Mapping applied. */
+/* Create a temporary PointSet (temp) to hold the intermediate result,
+   storing the coordinate values in the memory obtained from the arena. */
+            temp = astPointSet( np, nmid, "", status );
+            if ( astOK ) {
+               for ( icoord = 0; icoord < nmid; icoord++ ) {
+                  ptr[ icoord ] = values + icoord*np;
+               }
+               astSetPoints( temp, ptr );
+            }
+
+/* Apply the two Mappings in sequence and in the required order and
+   direction. */
             if ( forward ) {
-               temp = astTransform( map->map1, temp1, forward1, NULL );
+               (void) astTransform( map->map1, temp1, forward1, temp );
                (void) astTransform( map->map2, temp, forward2, temp2 );
             } else {
-               temp = astTransform( map->map2, temp1, forward2, NULL );
+               (void) astTransform( map->map2, temp1, forward2, temp );
                (void) astTransform( map->map1, temp, forward1, temp2 );
             }
 
@@ -3906,11 +3959,11 @@ static AstPointSet *Transform( AstMapping *this, AstPointSet *in,
             temp = astDelete( temp );
             temp1 = astDelete( temp1 );
             temp2 = astDelete( temp2 );
-
-/* Quit processing batches if an error occurs. */
-            if ( !astOK ) break;
          }
 
+/* Release the arena memory. */
+         astEndArena;
+
 /* Mappings in parallel. */
 /* --------------------- */
 /* If required, use the two component Mappings in parallel. Since we do not
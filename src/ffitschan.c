@@ -17,8 +17,10 @@
 *     AST_DELFITS
 *     AST_PURGEWCS
 *     AST_FINDFITS
+*     AST_FITSCACHESTATS
 *     AST_FITSCHAN
 *     AST_ISAFITSCHAN
+*     AST_PUTBLOCK
 *     AST_PUTCARDS
 *     AST_PUTFITS
 *     AST_RETAINFITS
@@ -422,6 +424,22 @@ F77_LOGICAL_FUNCTION(ast_isafitschan)( INTEGER(THIS),
    return RESULT;
 }
 
+F77_LOGICAL_FUNCTION(ast_putblock)( INTEGER(THIS),
+                                    CHARACTER(BLOCK),
+                                    INTEGER(STATUS)
+                                    TRAIL(BLOCK) ) {
+   GENPTR_INTEGER(THIS)
+   GENPTR_CHARACTER(BLOCK)
+   F77_LOGICAL_TYPE(RESULT);
+
+   astAt( "AST_PUTBLOCK", NULL, 0 );
+   astWatchSTATUS(
+      RESULT = astPutBlock( astI2P( *THIS ), BLOCK, BLOCK_length ) ?
+               F77_TRUE : F77_FALSE;
+   )
+   return RESULT;
+}
+
 F77_SUBROUTINE(ast_putcards)( INTEGER(THIS),
                               CHARACTER(CARDS),
                               INTEGER(STATUS)
@@ -1048,4 +1066,14 @@ F77_SUBROUTINE(ast_tablesource)( INTEGER(THIS),
    )
 }
 
+F77_INTEGER_FUNCTION(ast_fitscachestats)( LOGICAL(RESET),
+                                          INTEGER(STATUS) ) {
+   GENPTR_LOGICAL(RESET)
+   F77_INTEGER_TYPE(RESULT);
 
+   astAt( "AST_FITSCACHESTATS", NULL, 0 );
+   astWatchSTATUS(
+      RESULT = astP2I( astFitsCacheStats( F77_ISTRUE( *RESET ) ) );
+   )
+   return RESULT;
+}
@@ -136,6 +136,7 @@ f     encodings), then write operations using AST_WRITE will
 *     - SipReplace: Replace SIP inverse transformation?
 *     - SipOK: Use Spitzer Space Telescope keywords to define distortion?
 *     - SipReplace: Replace SIP inverse transformation?
+*     - SinkWindow: Number of new cards held before writing to the sink
 *     - TabOK: Should the FITS "-TAB" algorithm be recognised?
 *     - Warnings: Produces warnings about selected conditions
 
@@ -151,6 +152,7 @@ c     - astFindFits: Find a FITS card in a FitsChan by keyword
 c     - astGetFits<X>: Get a keyword value from a FitsChan
 c     - astGetTables: Retrieve any FitsTables from a FitsChan
 c     - astPurgeWCS: Delete all WCS-related cards in a FitsChan
+c     - astPutBlock: Store a block of raw FITS header cards in a FitsChan
 c     - astPutCards: Stores a set of FITS header card in a FitsChan
 c     - astPutFits: Store a FITS header card in a FitsChan
 c     - astPutTable: Store a single FitsTable in a FitsChan
@@ -169,6 +171,7 @@ f     - AST_FINDFITS: Find a FITS card in a FitsChan by keyword
 f     - AST_GETFITS<X>: Get a keyword value from a FitsChan
 f     - AST_GETTABLES: Retrieve any FitsTables from a FitsChan
 f     - AST_PURGEWCS: Delete all WCS-related cards in a FitsChan
+f     - AST_PUTBLOCK: Store a block of raw FITS header cards in a FitsChan
 f     - AST_PUTCARDS: Stores a set of FITS header card in a FitsChan
 f     - AST_PUTFITS: Store a FITS header card in a FitsChan
 f     - AST_PUTTABLE: Store a single FitsTables in a FitsChan
@@ -1558,6 +1561,16 @@ typedef struct FitsStore {
    char ****skyrefis;
 } FitsStore;
 
+/* Structure used to hold a single entry in the cache of FrameSets read
+   from FITS headers. The key is a byte string describing the FitsStore
+   and FitsChan attributes from which the FrameSet was created. */
+typedef struct FitsCacheEntry {
+   unsigned long hash;        /* Hash of the key bytes */
+   size_t keylen;             /* Number of bytes in the key */
+   char *key;                 /* The key bytes */
+   AstObject *fset;           /* Unlocked copy of the FrameSet */
+} FitsCacheEntry;
+
 /* Module Variables. */
 /* ================= */
 
@@ -1606,6 +1619,17 @@ static AstTimeFrame *timeframe = NULL;
 /* Max number of characters in a formatted int */
 static int int_dig;
 
+/* The process-wide cache of FrameSets read from FITS headers using foreign
+   encodings (see the FitsCache tuning parameter). The entries are held in
+   order of most recent use. Access is serialised using mutex5. */
+static FitsCacheEntry *fitscache = NULL;
+static int fitscache_size = 0;
+static int fitscache_n = 0;
+static int64_t fitscache_hits = 0;
+static int64_t fitscache_misses = 0;
+static int64_t fitscache_bypass = 0;
+static int64_t fitscache_evict = 0;
+
 /* Define macros for accessing each item of thread specific global data. */
 #ifdef THREAD_SAFE
 
@@ -1633,6 +1657,7 @@ static int int_dig;
    globals->Match_NB = 0; \
    globals->Match_Nentry = 0; \
    globals->WcsCelestial_Type[ 0 ] = 0; \
+   globals->Warn_Count = 0; \
    globals->Ignore_Used = 1; \
    globals->Mark_New = 0;
 
@@ -1663,6 +1688,7 @@ astMAKE_INITGLOBALS(FitsChan)
 #define match_nb astGLOBAL(FitsChan,Match_NB)
 #define match_nentry  astGLOBAL(FitsChan,Match_Nentry)
 #define wcscelestial_type astGLOBAL(FitsChan,WcsCelestial_Type)
+#define warn_count astGLOBAL(FitsChan,Warn_Count)
 static pthread_mutex_t mutex2 = PTHREAD_MUTEX_INITIALIZER;
 #define LOCK_MUTEX2 pthread_mutex_lock( &mutex2 );
 #define UNLOCK_MUTEX2 pthread_mutex_unlock( &mutex2 );
@@ -1672,6 +1698,9 @@ static pthread_mutex_t mutex3 = PTHREAD_MUTEX_INITIALIZER;
 static pthread_mutex_t mutex4 = PTHREAD_MUTEX_INITIALIZER;
 #define LOCK_MUTEX4 pthread_mutex_lock( &mutex4 );
 #define UNLOCK_MUTEX4 pthread_mutex_unlock( &mutex4 );
+static pthread_mutex_t mutex5 = PTHREAD_MUTEX_INITIALIZER;
+#define LOCK_MUTEX5 pthread_mutex_lock( &mutex5 );
+#define UNLOCK_MUTEX5 pthread_mutex_unlock( &mutex5 );
 
 /* If thread safety is not needed, declare and initialise globals at static
    variables. */
@@ -1748,6 +1777,9 @@ static int match_nentry = 0;
 /* Buffer for celestial system in WcsCelestial */
 static char wcscelestial_type[ 4 ];
 
+/* Number of warnings issued by Warn */
+static int warn_count = 0;
+
 /* Define the class virtual function table and its initialisation flag
    as static variables. */
 static AstFitsChanVtab class_vtab;   /* Virtual function table */
@@ -1758,6 +1790,8 @@ static int class_init = 0;       /* Virtual function table initialised? */
 #define UNLOCK_MUTEX3
 #define LOCK_MUTEX4
 #define UNLOCK_MUTEX4
+#define LOCK_MUTEX5
+#define UNLOCK_MUTEX5
 #endif
 
 /* External Interface Function Prototypes. */
@@ -1798,6 +1832,11 @@ static void ClearFitsRounding( AstFitsChan *, int * );
 static int GetFitsRounding( AstFitsChan *, int * );
 static int TestFitsRounding( AstFitsChan *, int * );
 static void SetFitsRounding( AstFitsChan *, int, int * );
+
+static void ClearSinkWindow( AstFitsChan *, int * );
+static int GetSinkWindow( AstFitsChan *, int * );
+static int TestSinkWindow( AstFitsChan *, int * );
+static void SetSinkWindow( AstFitsChan *, int, int * );
 static void ClearAltAxes( AstFitsChan *, int * );
 static int GetAltAxes( AstFitsChan *, int * );
 static int TestAltAxes( AstFitsChan *, int * );
@@ -1860,9 +1899,11 @@ static AstFitsChan *SpecTrans( AstFitsChan *, int, const char *, const char *, i
 static AstFitsTable *GetNamedTable( AstFitsChan *, const char *, int, int, int, const char *, int * );
 static AstFrameSet *MakeFitsFrameSet( AstFitsChan *, AstFrameSet *, int, int, int, const char *, const char *, int * );
 static AstGrismMap *ExtractGrismMap( AstMapping *, int, AstMapping **, int * );
+static const double *GetTableLut( AstFitsTable *, const char *, double **, int *, int * );
 static AstKeyMap *GetTables( AstFitsChan *, int * );
 static AstMapping *AddUnitMaps( AstMapping *, int, int, int * );
 static AstMapping *CelestialAxes( AstFitsChan *this, AstFrameSet *, double *, int *, char, FitsStore *, int *, int, const char *, const char *, int * );
+static AstObject *FsetFromCache( AstFitsChan *, FitsStore *, int, const char *, const char *, int * );
 static AstMapping *GrismSpecWcs( char *, FitsStore *, int, char, AstSpecFrame *, const char *, const char *, int * );
 static AstMapping *IsMapTab1D( AstMapping *, double, const char *, AstFrame *, double *, int, int, AstFitsTable **, int *, int *, int *, int * );
 static AstMapping *IsMapTab2D( AstMapping *, double, const char *, AstFrame *, double *, int, int, int, int, AstFitsTable **, int *, int *, int *, int *, int *, int *, int *, int *, int * );
@@ -1894,6 +1935,10 @@ static FitsCard *GetLink( FitsCard *, int, const char *, const char *, int * );
 static FitsStore *FitsToStore( AstFitsChan *, int, const char *, const char *, int * );
 static FitsStore *FreeStore( FitsStore *, int * );
 static FitsStore *FsetToStore( AstFitsChan *, AstFrameSet *, int, double *, int, const char *, const char *, int * );
+static char *CacheKey( AstFitsChan *, FitsStore *, int, size_t *, const char *, const char *, int * );
+static char *CacheKeyBytes( char *, size_t *, const void *, size_t, int * );
+static char *CacheKeyItem( char *, size_t *, double ***, int * );
+static char *CacheKeyItemC( char *, size_t *, char ****, int * );
 static char *CardComm( AstFitsChan *, int * );
 static char *CardName( AstFitsChan *, int * );
 static char *ConcatWAT( AstFitsChan *, int, const char *, const char *, int * );
@@ -1982,6 +2027,7 @@ static int MatchChar( char, char, const char *, const char *, const char *, int
 static int MatchFront( const char *, const char *, char *, int *, int *, int *, const char *, const char *, const char *, int * );
 static int MoveCard( AstFitsChan *, int, const char *, const char *, int * );
 static int PCFromStore( AstFitsChan *, FitsStore *, const char *, const char *, int * );
+static int PutBlock( AstFitsChan *, const char *, int, int * );
 static int SAOTrans( AstFitsChan *, AstFitsChan *, const char *, const char *, int * );
 static int SearchCard( AstFitsChan *, const char *, const char *, const char *, int * );
 static int SetFits( AstFitsChan *, const char *, void *, int, const char *, int, int * );
@@ -2019,6 +2065,7 @@ static void DeleteCard( AstFitsChan *, const char *, const char *, int * );
 static void DistortMaps( AstFitsChan *, FitsStore *, char, int , AstMapping **, AstMapping **, AstMapping **, AstMapping **, const char *, const char *, int * );
 static void Dump( AstObject *, AstChannel *, int * );
 static void EmptyFits( AstFitsChan *, int * );
+static void EmptyFitsCache( int, int * );
 static void FindWcs( AstFitsChan *, int, int, int, const char *, const char *, int * );
 static void FixNew( AstFitsChan *, int, int, const char *, const char *, int * );
 static void FixUsed( AstFitsChan *, int, int, int, const char *, const char *, int * );
@@ -2043,11 +2090,13 @@ static void PutTable( AstFitsChan *, AstFitsTable *, const char *, int * );
 static void PutTables( AstFitsChan *, AstKeyMap *, int * );
 static void ReadFits( AstFitsChan *, int * );
 static void ReadFromSource( AstFitsChan *, int * );
+static void ReleaseCachedFset( AstObject *, int * );
 static void RemoveTables( AstFitsChan *, const char *, int * );
 static void RetainFits( AstFitsChan *, int * );
 static void RoundFString( char *, int, int, int * );
 static void SetAlgCode( char *, const char *, int * );
 static void SetAttrib( AstObject *, const char *, int * );
+static void SetFitsCacheSize( int, int * );
 static void SetFitsCF( AstFitsChan *, const char *, double *, const char *, int, int * );
 static void SetFitsCI( AstFitsChan *, const char *, int *, const char *, int, int * );
 static void SetFitsCM( AstFitsChan *, const char *, int, int * );
@@ -2067,6 +2116,8 @@ static void ShowFits( AstFitsChan *, int * );
 static void Shpc1( double, double, int, double *, double *, int * );
 static void SinkWrap( void (*)( const char * ), const char *, int * );
 static void SkyPole( AstWcsMap *, AstMapping *, int, int, int *, char, FitsStore *, const char *, const char *, int * );
+static void StoreCard( AstFitsChan *, const char *, int, const char *, const char *, int * );
+static void StreamCards( AstFitsChan *, int, int * );
 static void TableSource( AstFitsChan *, void (*)( AstFitsChan *, const char *, int, int, int * ), int * );
 static void TidyOffsets( AstFrameSet *, int * );
 static void Warn( AstFitsChan *, const char *, const char *, const char *, const char *, int * );
@@ -4095,6 +4146,417 @@ static int AIPSPPFromStore( AstFitsChan *this, FitsStore *store,
    return astOK ? ok : 0;
 }
 
+static char *CacheKey( AstFitsChan *this, FitsStore *store, int encoding,
+                       size_t *keylen, const char *method,
+                       const char *class, int *status ){
+/*
+*  Name:
+*     CacheKey
+
+*  Purpose:
+*     Create a key describing the FrameSet that would be read from a
+*     FitsStore.
+
+*  Type:
+*     Private function.
+
+*  Synopsis:
+*     #include "fitschan.h"
+*     char *CacheKey( AstFitsChan *this, FitsStore *store, int encoding,
+*                     size_t *keylen, const char *method,
+*                     const char *class, int *status )
+
+*  Class Membership:
+*     FitsChan member function.
+
+*  Description:
+*     This function returns a dynamically allocated string of bytes that
+*     describes everything on which the FrameSet created by FsetFromStore
+*     depends - i.e. the contents of the supplied FitsStore, and the
+*     FitsChan attributes that control the way in which the FrameSet is
+*     created. Two FitsStores that produce identical keys will produce
+*     identical FrameSets. It is used to identify FrameSets in the cache
+*     of previously read FrameSets (see the FitsCache tuning parameter).
+*
+*     A NULL pointer is returned if the FrameSet also depends on other
+*     things, and so should not be cached. This is the case if any axis
+*     uses the -TAB algorithm (the FrameSet depends on the contents of
+*     the table), or if the FitsChan contains any AXREF or RFVAL
+*     keywords for an axis (these are read directly from the FitsChan
+*     by WcsCelestial).
+*
+*     If any axis uses the -SIP distortion code, the values of the NAXISi
+*     keywords in the FitsChan are also included in the key, since they
+*     determine the region over which the inverse SIP transformation is
+*     fitted (see DistortMaps).
+
+*  Parameters:
+*     this
+*        Pointer to the FitsChan.
+*     store
+*        Pointer to the FitsStore.
+*     encoding
+*        The encoding being used.
+*     keylen
+*        Address of a location at which to return the number of bytes
+*        in the key.
+*     method
+*        Pointer to a string holding the name of the calling method.
+*        This is only for use in constructing error messages.
+*     class
+*        Pointer to a string holding the name of the supplied object class.
+*        This is only for use in constructing error messages.
+*     status
+*        Pointer to the inherited status variable.
+
+*  Returned Value:
+*     A pointer to the key. It should be freed using astFree when no
+*     longer needed. The key is not null-terminated.
+
+*  Notes:
+*     -  A NULL pointer is returned if an error has already occurred, or
+*     if this function should fail for any reason.
+*/
+
+/* Local Variables: */
+   char *ctype;             /* CTYPE value */
+   char *key;               /* Returned key */
+   char s;                  /* Co-ordinate version character */
+   const char *warnings;    /* Warnings attribute value */
+   double dval;             /* Floating point attribute value */
+   int i;                   /* Intermediate axis index */
+   int icard;               /* Index of original current card */
+   int ival[ 11 ];          /* Integer attribute values */
+   int nax;                 /* Max. number of intermediate axes */
+   int ni;                  /* Number of intermediate axes */
+   int nsi;                 /* Number of co-ordinate versions */
+   int si;                  /* Co-ordinate version index */
+   int sip;                 /* Does any axis use the -SIP distortion? */
+
+/* Initialise */
+   key = NULL;
+   *keylen = 0;
+
+/* Check the inherited status. */
+   if( !astOK ) return key;
+
+/* Check each CTYPE value in the FitsStore. Return without action if
+   any axis uses the -TAB algorithm, or if the FitsChan contains an
+   AXREF or RFVAL keyword for the axis. Also note if any axis uses the
+   -SIP distortion code, and the largest number of axes. */
+   sip = 0;
+   nax = 0;
+   nsi = store->ctype ? astSizeOf( store->ctype )/sizeof( char *** ) : 0;
+   for( si = 0; si < nsi; si++ ) {
+      if( !store->ctype[ si ] ) continue;
+      s = si ? (char) ( 'A' + si - 1 ) : ' ';
+      ni = astSizeOf( store->ctype[ si ] )/sizeof( char ** );
+      if( ni > nax ) nax = ni;
+      for( i = 0; i < ni; i++ ) {
+         ctype = store->ctype[ si ][ i ] ? store->ctype[ si ][ i ][ 0 ] : NULL;
+         if( !ctype ) continue;
+         if( strstr( ctype, "-SIP" ) ) sip = 1;
+         if( strstr( ctype, "-TAB" ) ||
+             HasCard( this, FormatKey( "AXREF", i + 1, -1, s, status ),
+                      method, class, status ) ||
+             HasCard( this, FormatKey( "RFVAL", i + 1, -1, s, status ),
+                      method, class, status ) ) return key;
+      }
+   }
+
+/* Store the values of the attributes that affect the creation of the
+   FrameSet. The Clean attribute is included since it determines whether
+   any warnings are issued. */
+   ival[ 0 ] = encoding;
+   ival[ 1 ] = store->naxis;
+   ival[ 2 ] = astGetDefB1950( this );
+   ival[ 3 ] = astGetTabOK( this );
+   ival[ 4 ] = astGetIgnoreBadAlt( this );
+   ival[ 5 ] = astGetPolyTan( this );
+   ival[ 6 ] = astGetSipOK( this );
+   ival[ 7 ] = astGetCarLin( this );
+   ival[ 8 ] = astGetSipReplace( this );
+   ival[ 9 ] = astGetIwc( this );
+   ival[ 10 ] = astGetClean( this );
+   key = CacheKeyBytes( key, keylen, ival, sizeof( ival ), status );
+
+   dval = astGetFitsTol( this );
+   key = CacheKeyBytes( key, keylen, &dval, sizeof( dval ), status );
+
+   warnings = astGetWarnings( this );
+   if( !warnings ) warnings = "";
+   key = CacheKeyBytes( key, keylen, warnings, strlen( warnings ) + 1,
+                        status );
+
+/* If any axis uses the -SIP distortion code, append the image dimensions
+   used by DistortMaps (AST__BAD if not known). The current card is
+   re-instated afterwards, since astGetFits changes it. */
+   if( sip ) {
+      if( store->naxis > nax ) nax = store->naxis;
+      icard = astGetCard( this );
+      for( i = 0; i < nax; i++ ) {
+         if( !astGetFitsF( this, FormatKey( "NAXIS", i + 1, -1, ' ', status ),
+                           &dval ) ) dval = AST__BAD;
+         key = CacheKeyBytes( key, keylen, &dval, sizeof( dval ), status );
+      }
+      astSetCard( this, icard );
+   }
+
+/* Append the contents of each item in the FitsStore. */
+   key = CacheKeyItemC( key, keylen, store->cname, status );
+   key = CacheKeyItemC( key, keylen, store->ctype, status );
+   key = CacheKeyItemC( key, keylen, store->ctype_com, status );
+   key = CacheKeyItemC( key, keylen, store->cunit, status );
+   key = CacheKeyItemC( key, keylen, store->radesys, status );
+   key = CacheKeyItemC( key, keylen, store->wcsname, status );
+   key = CacheKeyItemC( key, keylen, store->specsys, status );
+   key = CacheKeyItemC( key, keylen, store->ssyssrc, status );
+   key = CacheKeyItemC( key, keylen, store->ps, status );
+   key = CacheKeyItemC( key, keylen, store->timesys, status );
+   key = CacheKeyItem( key, keylen, store->pc, status );
+   key = CacheKeyItem( key, keylen, store->cdelt, status );
+   key = CacheKeyItem( key, keylen, store->crpix, status );
+   key = CacheKeyItem( key, keylen, store->crval, status );
+   key = CacheKeyItem( key, keylen, store->equinox, status );
+   key = CacheKeyItem( key, keylen, store->latpole, status );
+   key = CacheKeyItem( key, keylen, store->lonpole, status );
+   key = CacheKeyItem( key, keylen, store->mjdobs, status );
+   key = CacheKeyItem( key, keylen, store->dtai, status );
+   key = CacheKeyItem( key, keylen, store->dut1, status );
+   key = CacheKeyItem( key, keylen, store->mjdavg, status );
+   key = CacheKeyItem( key, keylen, store->pv, status );
+   key = CacheKeyItem( key, keylen, store->wcsaxes, status );
+   key = CacheKeyItem( key, keylen, store->obsgeox, status );
+   key = CacheKeyItem( key, keylen, store->obsgeoy, status );
+   key = CacheKeyItem( key, keylen, store->obsgeoz, status );
+   key = CacheKeyItem( key, keylen, store->restfrq, status );
+   key = CacheKeyItem( key, keylen, store->restwav, status );
+   key = CacheKeyItem( key, keylen, store->zsource, status );
+   key = CacheKeyItem( key, keylen, store->velosys, status );
+   key = CacheKeyItem( key, keylen, store->asip, status );
+   key = CacheKeyItem( key, keylen, store->bsip, status );
+   key = CacheKeyItem( key, keylen, store->apsip, status );
+   key = CacheKeyItem( key, keylen, store->bpsip, status );
+   key = CacheKeyItem( key, keylen, store->imagfreq, status );
+   key = CacheKeyItem( key, keylen, store->axref, status );
+   key = CacheKeyItem( key, keylen, store->skyref, status );
+   key = CacheKeyItem( key, keylen, store->skyrefp, status );
+   key = CacheKeyItemC( key, keylen, store->skyrefis, status );
+
+/* Free the key if an error occurred. */
+   if( !astOK ) {
+      key = astFree( key );
+      *keylen = 0;
+   }
+
+/* Return the key. */
+   return key;
+}
+
+static char *CacheKeyBytes( char *key, size_t *keylen, const void *data,
+                            size_t nbyte, int *status ){
+/*
+*  Name:
+*     CacheKeyBytes
+
+*  Purpose:
+*     Append a block of bytes to a cache key.
+
+*  Type:
+*     Private function.
+
+*  Synopsis:
+*     #include "fitschan.h"
+*     char *CacheKeyBytes( char *key, size_t *keylen, const void *data,
+*                          size_t nbyte, int *status )
+
+*  Class Membership:
+*     FitsChan member function.
+
+*  Description:
+*     This function appends a copy of the supplied bytes to the end of
+*     a key created by CacheKey, extending the key as necessary.
+
+*  Parameters:
+*     key
+*        Pointer to the key, or NULL.
+*     keylen
+*        Address of the number of bytes in the key. Updated on exit.
+*     data
+*        Pointer to the bytes to append.
+*     nbyte
+*        The number of bytes to append.
+*     status
+*        Pointer to the inherited status variable.
+
+*  Returned Value:
+*     A pointer to the extended key.
+*/
+
+/* Check the inherited status. */
+   if( !astOK ) return key;
+
+/* Extend the key and append the new bytes. */
+   key = astGrow( key, *keylen + nbyte, 1 );
+   if( astOK ) {
+      memcpy( key + *keylen, data, nbyte );
+      *keylen += nbyte;
+   }
+
+/* Return the key. */
+   return key;
+}
+
+static char *CacheKeyItem( char *key, size_t *keylen, double ***item,
+                           int *status ){
+/*
+*  Name:
+*     CacheKeyItem
+
+*  Purpose:
+*     Append the contents of a floating point FitsStore item to a
+*     cache key.
+
+*  Type:
+*     Private function.
+
+*  Synopsis:
+*     #include "fitschan.h"
+*     char *CacheKeyItem( char *key, size_t *keylen, double ***item,
+*                         int *status )
+
+*  Class Membership:
+*     FitsChan member function.
+
+*  Description:
+*     This function appends a description of the shape and values of
+*     the supplied FitsStore item to the end of a key created by
+*     CacheKey.
+
+*  Parameters:
+*     key
+*        Pointer to the key, or NULL.
+*     keylen
+*        Address of the number of bytes in the key. Updated on exit.
+*     item
+*        The FitsStore item (e.g. "store->crval").
+*     status
+*        Pointer to the inherited status variable.
+
+*  Returned Value:
+*     A pointer to the extended key.
+*/
+
+/* Local Variables: */
+   int j;                /* Intermediate co-ordinate axis index */
+   int n;                /* Number of elements in an array */
+   int nj;               /* Number of intermediate axes */
+   int nsi;              /* Number of co-ordinate versions */
+   int si;               /* Co-ordinate version index */
+
+/* Store the number of co-ordinate versions (zero if the item is null). */
+   nsi = item ? astSizeOf( (void *) item )/sizeof( double ** ) : 0;
+   key = CacheKeyBytes( key, keylen, &nsi, sizeof( nsi ), status );
+
+/* Loop round each coordinate version, storing the number of
+   intermediate axes. */
+   for( si = 0; si < nsi && astOK; si++ ){
+      nj = item[ si ] ? astSizeOf( (void *) item[ si ] )/sizeof( double * ) : 0;
+      key = CacheKeyBytes( key, keylen, &nj, sizeof( nj ), status );
+
+/* Store the number of values for each intermediate axis, followed by the
+   values themselves. */
+      for( j = 0; j < nj && astOK; j++ ){
+         n = item[ si ][ j ] ? astSizeOf( (void *) item[ si ][ j ] )/sizeof( double ) : 0;
+         key = CacheKeyBytes( key, keylen, &n, sizeof( n ), status );
+         if( n ) key = CacheKeyBytes( key, keylen, item[ si ][ j ],
+                                      n*sizeof( double ), status );
+      }
+   }
+
+/* Return the key. */
+   return key;
+}
+
+static char *CacheKeyItemC( char *key, size_t *keylen, char ****item,
+                            int *status ){
+/*
+*  Name:
+*     CacheKeyItemC
+
+*  Purpose:
+*     Append the contents of a string FitsStore item to a cache key.
+
+*  Type:
+*     Private function.
+
+*  Synopsis:
+*     #include "fitschan.h"
+*     char *CacheKeyItemC( char *key, size_t *keylen, char ****item,
+*                          int *status )
+
+*  Class Membership:
+*     FitsChan member function.
+
+*  Description:
+*     This function appends a description of the shape and values of
+*     the supplied FitsStore item to the end of a key created by
+*     CacheKey.
+
+*  Parameters:
+*     key
+*        Pointer to the key, or NULL.
+*     keylen
+*        Address of the number of bytes in the key. Updated on exit.
+*     item
+*        The FitsStore item (e.g. "store->ctype").
+*     status
+*        Pointer to the inherited status variable.
+
+*  Returned Value:
+*     A pointer to the extended key.
+*/
+
+/* Local Variables: */
+   char *text;           /* String value */
+   int i;                /* Intermediate co-ordinate axis index */
+   int jm;               /* Pixel axis or parameter index */
+   int n;                /* Number of characters in string */
+   int ni;               /* Number of intermediate axes */
+   int njm;              /* Number of pixel axes or parameters */
+   int nsi;              /* Number of co-ordinate versions */
+   int si;               /* Co-ordinate version index */
+
+/* Store the number of co-ordinate versions (zero if the item is null). */
+   nsi = item ? astSizeOf( (void *) item )/sizeof( char *** ) : 0;
+   key = CacheKeyBytes( key, keylen, &nsi, sizeof( nsi ), status );
+
+/* Loop round each coordinate version, storing the number of
+   intermediate axes. */
+   for( si = 0; si < nsi && astOK; si++ ){
+      ni = item[ si ] ? astSizeOf( (void *) item[ si ] )/sizeof( char ** ) : 0;
+      key = CacheKeyBytes( key, keylen, &ni, sizeof( ni ), status );
+
+/* Store the number of strings for each intermediate axis. */
+      for( i = 0; i < ni && astOK; i++ ){
+         njm = item[ si ][ i ] ? astSizeOf( (void *) item[ si ][ i ] )/sizeof( char * ) : 0;
+         key = CacheKeyBytes( key, keylen, &njm, sizeof( njm ), status );
+
+/* Store the length of each string (-1 for a null pointer), followed by
+   the string itself. */
+         for( jm = 0; jm < njm && astOK; jm++ ){
+            text = item[ si ][ i ][ jm ];
+            n = text ? (int) strlen( text ) : -1;
+            key = CacheKeyBytes( key, keylen, &n, sizeof( n ), status );
+            if( n > 0 ) key = CacheKeyBytes( key, keylen, text, n, status );
+         }
+      }
+   }
+
+/* Return the key. */
+   return key;
+}
+
 static char *CardComm( AstFitsChan *this, int *status ){
 
 /*
@@ -6695,6 +7157,11 @@ static void ClearAttrib( AstObject *this_object, const char *attrib, int *status
    } else if ( !strcmp( attrib, "fitsrounding" ) ) {
       astClearFitsRounding( this );
 
+/* SinkWindow. */
+/* ----------- */
+   } else if ( !strcmp( attrib, "sinkwindow" ) ) {
+      astClearSinkWindow( this );
+
 /* DefB1950 */
 /* -------- */
    } else if ( !strcmp( attrib, "defb1950" ) ) {
@@ -7030,6 +7497,7 @@ static int CnvType( int otype, void *odata, size_t osize, int type, int undef,
    int ival;                /* Integer value read from string */
    int len;                 /* Length of character string */
    int nc;                  /* No. of characetsr used */
+   int nc2;                 /* No. of characters used by second value */
    int ret;                 /* Returned success flag */
 
 /* Check the global error status, and the supplied buffer. */
@@ -7107,12 +7575,11 @@ static int CnvType( int otype, void *odata, size_t osize, int type, int undef,
          ostring = (char *) odata;
          len = (int) strlen( ostring );
          if( type == AST__FLOAT ){
-            if( nc = 0,
+            if( nc = 0, ( *ostring == BAD_STRING[ 0 ] ) &&
                     ( 0 == astSscanf( ostring, BAD_STRING " %n", &nc ) )
                   && (nc >= len ) ){
                *( (double *) buff ) = AST__BAD;
-            } else if( nc = 0,
-                     ( 1 != astSscanf( ostring, "%lf %n", (double *) buff, &nc ) )
+            } else if( ( nc = astChrReadDouble( ostring, (double *) buff ) ) == 0
                   || (nc < len ) ){
                ret = 0;
             }
@@ -7120,20 +7587,17 @@ static int CnvType( int otype, void *odata, size_t osize, int type, int undef,
             strncpy( cnvtype_text, (char *) odata, AST__FITSCHAN_FITSCARDLEN );
             *( (char **) buff ) = cnvtype_text;
          } else if( type == AST__INT      ){
-            if( nc = 0,
-                     ( 1 != astSscanf( ostring, "%d %n", (int *) buff, &nc ) )
+            if( ( nc = astChrReadInt( ostring, (int *) buff ) ) == 0
                   || (nc < len ) ){
                ret = 0;
             }
          } else if( type == AST__KINT     ){
-            if( nc = 0,
-                     ( 1 != astSscanf( ostring, "%" PRId64 " %n", (int64_t *) buff, &nc ) )
+            if( ( nc = astChrReadInt64( ostring, (int64_t *) buff ) ) == 0
                   || (nc < len ) ){
                ret = 0;
             }
          } else if( type == AST__LOGICAL  ){
-            if( nc = 0,
-                     ( 1 == astSscanf( ostring, "%d %n", &ival, &nc ) )
+            if( ( nc = astChrReadInt( ostring, &ival ) )
                   && (nc >= len ) ){
                *( (int *) buff ) = ival ? 1 : 0;
             } else {
@@ -7149,32 +7613,28 @@ static int CnvType( int otype, void *odata, size_t osize, int type, int undef,
                   ret = 0;
                }
             }
+
+/* Complex values may be given as a pair of values or as a single real
+   value. */
          } else if( type == AST__COMPLEXF ){
-            if( nc = 0,
-                     ( 1 != astSscanf( ostring, "%lf %lf %n", (double *) buff,
-                                    (double *) buff + 1, &nc ) )
-                  || (nc < len ) ){
-               if( nc = 0,
-                        ( 1 != astSscanf( ostring, "%lf %n", (double *) buff,
-                                       &nc ) )
-                     || (nc < len ) ){
-                  ret = 0;
-               } else {
-                  ( (double *) buff )[ 1 ] = 0.0;
-               }
+            nc = astChrReadDouble( ostring, (double *) buff );
+            if( nc == 0 ) {
+               ret = 0;
+            } else if( nc < len ) {
+               nc2 = astChrReadDouble( ostring + nc, (double *) buff + 1 );
+               if( nc2 == 0 || nc + nc2 < len ) ret = 0;
+            } else {
+               ( (double *) buff )[ 1 ] = 0.0;
             }
          } else if( type == AST__COMPLEXI ){
-            if( nc = 0,
-                    ( 1 != astSscanf( ostring, "%d %d %n", (int *) buff,
-                                   (int *) buff + 1, &nc ) )
-                   || (nc < len ) ){
-               if( nc = 0,
-                        ( 1 != astSscanf( ostring, "%d %n", (int *) buff, &nc ) )
-                     || (nc < len ) ){
-                  ret = 0;
-               } else {
-                  ( (int *) buff )[ 1 ] = 0;
-               }
+            nc = astChrReadInt( ostring, (int *) buff );
+            if( nc == 0 ) {
+               ret = 0;
+            } else if( nc < len ) {
+               nc2 = astChrReadInt( ostring + nc, (int *) buff + 1 );
+               if( nc2 == 0 || nc + nc2 < len ) ret = 0;
+            } else {
+               ( (int *) buff )[ 1 ] = 0;
             }
          } else if( astOK ){
             ret = 0;
@@ -8040,9 +8500,11 @@ static void DeleteCard( AstFitsChan *this, const char *method,
 */
 
 /* Local Variables: */
+   AstMapKeyHandle handle;    /* Prepared keyword name */
    FitsCard *card;            /* Pointer to the current card */
    FitsCard *next;            /* Pointer to next card in list */
    FitsCard *prev;            /* Pointer to previous card in list */
+   int ncard;                 /* No. of cards with the same keyword name */
 
 /* Return if the supplied object or current card is NULL. */
    if( !this || !this->card ) return;
@@ -8050,8 +8512,18 @@ static void DeleteCard( AstFitsChan *this, const char *method,
 /* Get a pointer to the card to be deleted (the current card). */
    card = (FitsCard *) this->card;
 
-/* Remove it from the KeyMap holding all keywords. */
-   astMapRemove( this->keywords, card->name );
+/* Decrement the number of cards using the same keyword name in the
+   KeyMap holding all keywords, removing the entry if this was the last
+   such card. A key handle is used so that the keyword name is only
+   hashed once. */
+   astMapKeyHandle( this->keywords, card->name, &handle );
+   if( astMapGet0H( this->keywords, &handle, AST__INTTYPE, &ncard ) &&
+       ncard > 1 ) {
+      ncard--;
+      astMapPut0H( this->keywords, &handle, AST__INTTYPE, &ncard, NULL );
+   } else {
+      astMapRemove( this->keywords, card->name );
+   }
 
 /* Move the current card on to the next card. */
    MoveCard( this, 1, method, class, status );
@@ -9199,6 +9671,57 @@ f     Unlike AST_WRITEFITS,
    if( this->tables ) this->tables = astAnnul( this->tables );
 }
 
+static void EmptyFitsCache( int size, int *status ){
+/*
+*  Name:
+*     EmptyFitsCache
+
+*  Purpose:
+*     Remove entries from the cache of FrameSets read from FITS headers.
+
+*  Type:
+*     Private function.
+
+*  Synopsis:
+*     #include "fitschan.h"
+*     void EmptyFitsCache( int size, int *status )
+
+*  Class Membership:
+*     FitsChan member function.
+
+*  Description:
+*     This function deletes the least recently used entries in the cache
+*     of FrameSets read from FITS headers (see the FitsCache tuning
+*     parameter), until no more than "size" entries remain.
+
+*  Parameters:
+*     size
+*        The maximum number of entries to retain.
+*     status
+*        Pointer to the inherited status variable.
+
+*  Notes:
+*     -  This function should only be called while mutex5 is locked.
+*     -  This function attempts to execute even if an error has occurred.
+*/
+
+/* Local Variables: */
+   FitsCacheEntry *entry;       /* Pointer to entry being deleted */
+
+/* Delete entries from the end of the list (i.e. the least recently used
+   entries). */
+   while( fitscache_n > 0 && fitscache_n > size ) {
+      entry = fitscache + --fitscache_n;
+      ReleaseCachedFset( entry->fset, status );
+      entry->fset = NULL;
+      entry->key = astFree( entry->key );
+      fitscache_evict++;
+   }
+
+/* Free the array of entries if it is now empty. */
+   if( fitscache_n == 0 ) fitscache = astFree( fitscache );
+}
+
 static int EncodeFloat( char *buf, int digits, int width, int maxwidth,
                         int fitsrnd, double value, int *status ){
 /*
@@ -11327,6 +11850,206 @@ static char *FormatKey( const char *key, int c1, int c2, char s, int *status ){
    return formatkey_buff;
 }
 
+static AstObject *FsetFromCache( AstFitsChan *this, FitsStore *store,
+                                 int encoding, const char *method,
+                                 const char *class, int *status ){
+/*
+*  Name:
+*     FsetFromCache
+
+*  Purpose:
+*     Create a FrameSet from a FitsStore, using the cache of previously
+*     read FrameSets if possible.
+
+*  Type:
+*     Private function.
+
+*  Synopsis:
+*     AstObject *FsetFromCache( AstFitsChan *this, FitsStore *store,
+*                               int encoding, const char *method,
+*                               const char *class, int *status )
+
+*  Class Membership:
+*     FitsChan
+
+*  Description:
+*     This function returns the same FrameSet as FsetFromStore. If the
+*     FitsCache tuning parameter is non-zero, a process-wide cache of
+*     previously read FrameSets is first searched for a FrameSet that was
+*     created from an identical FitsStore, using identical FitsChan
+*     attribute values. If one is found, a deep copy of it is returned.
+*     Otherwise, a new FrameSet is created using FsetFromStore, and a copy
+*     of it is added to the cache, replacing the least recently used entry
+*     if the cache is full.
+*
+*     FrameSets that depend on anything other than the FitsStore and the
+*     FitsChan attributes (see CacheKey), or that caused warnings to be
+*     issued, are never cached. This ensures that the contents of the
+*     FitsChan and the returned FrameSet are the same whether or not the
+*     cache is used.
+
+*  Parameters:
+*     this
+*        The FitsChan from which the keywords were read.
+*     store
+*        Pointer to the FitsStore.
+*     encoding
+*        The encoding being used.
+*     method
+*        Pointer to a string holding the name of the calling method.
+*        This is only for use in constructing error messages.
+*     class
+*        Pointer to a string holding the name of the supplied object class.
+*        This is only for use in constructing error messages.
+*     status
+*        Pointer to the inherited status variable.
+
+*  Returned Value:
+*     A pointer to the new FrameSet, or a null pointer if no FrameSet
+*     could be constructed.
+*/
+
+/* Local Variables: */
+   astDECLARE_GLOBALS      /* Declare the thread specific global data */
+   AstObject *cached;      /* Copy of new FrameSet to store in the cache */
+   AstObject *fset;        /* Clone of cached FrameSet */
+   AstObject *ret;         /* Pointer to returned FrameSet */
+   FitsCacheEntry entry;   /* Cache entry */
+   char *key;              /* Key describing the FitsStore */
+   int found;              /* Was a matching cache entry found? */
+   int i;                  /* Cache entry index */
+   int nwarn;              /* Number of warnings issued before reading */
+   int size;               /* Max. number of entries in the cache */
+   size_t j;               /* Key byte index */
+   size_t keylen;          /* Number of bytes in the key */
+   unsigned long hash;     /* Hash of the key */
+
+/* Initialise */
+   ret = NULL;
+
+/* Check the inherited status. */
+   if( !astOK ) return ret;
+
+/* Get a pointer to the structure holding thread-specific global data. */
+   astGET_GLOBALS(this);
+
+/* If the cache is not in use, just create a new FrameSet. */
+   LOCK_MUTEX5
+   size = fitscache_size;
+   UNLOCK_MUTEX5
+   if( size <= 0 ) return FsetFromStore( this, store, method, class, status );
+
+/* Get the key describing the FitsStore. The key is stored in the cache,
+   so mark it as permanent memory. If the FrameSet cannot be cached, just
+   create a new FrameSet. */
+   astBeginPM;
+   key = CacheKey( this, store, encoding, &keylen, method, class, status );
+   astEndPM;
+   if( !key ) {
+      LOCK_MUTEX5
+      fitscache_bypass++;
+      UNLOCK_MUTEX5
+      return FsetFromStore( this, store, method, class, status );
+   }
+
+/* Form a hash of the key (FNV-1a) so that most non-matching cache
+   entries can be rejected without comparing the keys. */
+   hash = 2166136261UL;
+   for( j = 0; j < keylen; j++ ) {
+      hash = ( hash ^ (unsigned char) key[ j ] )*16777619UL;
+   }
+
+/* Search the cache for a matching entry. If found, take a clone of the
+   cached FrameSet (so that it is not deleted if the entry is removed from
+   the cache by another thread), and move the entry to the front of the
+   list. */
+   found = 0;
+   LOCK_MUTEX5
+   for( i = 0; i < fitscache_n; i++ ) {
+      if( fitscache[ i ].hash == hash && fitscache[ i ].keylen == keylen &&
+          !memcmp( fitscache[ i ].key, key, keylen ) ) {
+         entry = fitscache[ i ];
+         fset = astClone( entry.fset );
+         memmove( fitscache + 1, fitscache, i*sizeof( *fitscache ) );
+         fitscache[ 0 ] = entry;
+         fitscache_hits++;
+         found = 1;
+         break;
+      }
+   }
+   if( !found ) fitscache_misses++;
+   UNLOCK_MUTEX5
+
+/* If found, return a copy of the cached FrameSet. This is done after
+   unlocking the mutex so that other threads can search the cache while
+   the copy is being made. The cached FrameSet is unlocked, so lock it
+   for use by the current thread while it is copied. Then release the
+   clone. */
+   if( found ) {
+      astManageLock( fset, AST__LOCK, 1, NULL );
+      ret = astCopy( fset );
+      astManageLock( fset, AST__UNLOCK, 1, NULL );
+      LOCK_MUTEX5
+      ReleaseCachedFset( fset, status );
+      UNLOCK_MUTEX5
+   }
+
+/* If no matching entry was found, create a new FrameSet, noting the number
+   of warnings issued beforehand. */
+   if( !found ) {
+      nwarn = warn_count;
+      ret = FsetFromStore( this, store, method, class, status );
+
+/* If no warnings were issued, store an unlocked copy of the new FrameSet
+   in the cache (unless the cache has been disabled, or another thread has
+   stored the same FrameSet, in the meantime). The least recently used
+   entry is removed first if the cache is full. */
+      if( ret && astOK && warn_count == nwarn ) {
+         astBeginPM;
+         cached = astCopy( ret );
+         astEndPM;
+         astManageLock( cached, AST__UNLOCK, 1, NULL );
+
+         LOCK_MUTEX5
+         for( i = 0; i < fitscache_n; i++ ) {
+            if( fitscache[ i ].hash == hash && fitscache[ i ].keylen == keylen &&
+                !memcmp( fitscache[ i ].key, key, keylen ) ) break;
+         }
+         if( i == fitscache_n && fitscache_size > 0 && astOK ) {
+            EmptyFitsCache( fitscache_size - 1, status );
+            astBeginPM;
+            fitscache = astGrow( fitscache, fitscache_n + 1,
+                                 sizeof( *fitscache ) );
+            astEndPM;
+            if( astOK ) {
+               memmove( fitscache + 1, fitscache,
+                        fitscache_n*sizeof( *fitscache ) );
+               fitscache[ 0 ].hash = hash;
+               fitscache[ 0 ].keylen = keylen;
+               fitscache[ 0 ].key = key;
+               fitscache[ 0 ].fset = cached;
+               fitscache_n++;
+               key = NULL;
+               cached = NULL;
+            }
+         }
+         UNLOCK_MUTEX5
+
+/* Annul the copy if it was not stored in the cache. */
+         if( cached ) {
+            astManageLock( cached, AST__LOCK, 1, NULL );
+            cached = astAnnul( cached );
+         }
+      }
+   }
+
+/* Free the key if it was not stored in the cache. */
+   key = astFree( key );
+
+/* Return the FrameSet. */
+   return ret;
+}
+
 static AstObject *FsetFromStore( AstFitsChan *this, FitsStore *store,
                                  const char *method, const char *class, int *status ){
 /*
@@ -13246,6 +13969,90 @@ static AstFitsTable *GetNamedTable( AstFitsChan *this, const char *extname,
    return ret;
 }
 
+static const double *GetTableLut( AstFitsTable *table, const char *key,
+                                  double **lut, int *nel, int *status ) {
+/*
+*  Name:
+*     GetTableLut
+
+*  Purpose:
+*     Get the values stored in a cell of a -TAB look-up table.
+
+*  Type:
+*     Private function.
+
+*  Synopsis:
+*     #include "fitschan.h"
+*     const double *GetTableLut( AstFitsTable *table, const char *key,
+*                                double **lut, int *nel, int *status )
+
+*  Class Membership:
+*     FitsChan member function.
+
+*  Description:
+*     This function returns a pointer to the double precision values
+*     stored in a cell of a FitsTable. If the cell holds double precision
+*     values, a pointer to the values stored within the FitsTable is
+*     returned and no copy is made, since the arrays used for -TAB look-up
+*     tables can be very large. Otherwise, the values are converted to
+*     double precision and copied into newly allocated memory.
+
+*  Parameters:
+*     table
+*        Pointer to the FitsTable.
+*     key
+*        The key for the table cell.
+*     lut
+*        Pointer to a location at which to return a pointer to memory
+*        allocated to hold the converted values, if the cell does not hold
+*        double precision values. NULL is returned otherwise. Any returned
+*        memory should be freed using astFree when no longer needed.
+*     nel
+*        On entry, the maximum number of values to return. On exit, the
+*        number of values returned.
+*     status
+*        Pointer to the inherited status variable.
+
+*  Returned Value:
+*     Pointer to the values (either within the FitsTable or "*lut"), or
+*     NULL if the cell is empty. The returned pointer should not be used
+*     after the FitsTable has been modified or deleted.
+
+*/
+
+/* Local Variables: */
+   const double *result;
+   const void *pval;
+   int nval;
+   int type;
+
+/* Initialise */
+   result = NULL;
+   *lut = NULL;
+
+/* Check the inherited status */
+   if( !astOK ) return result;
+
+/* Get a pointer to the stored value. If it is double precision, use it
+   in place. */
+   pval = astMapValuePtr( table, key, &type, &nval );
+   if( pval && type == AST__DOUBLETYPE ) {
+      if( nval < *nel ) *nel = nval;
+      result = pval;
+
+/* Otherwise, copy the values into the supplied array, converting them to
+   double precision. */
+   } else if( pval ) {
+      *lut = astMalloc( *nel*sizeof( double ) );
+      if( astOK && astMapGet1D( table, key, *nel, nel, *lut ) ) {
+         result = *lut;
+      }
+   }
+
+/* Return the result. */
+   return result;
+}
+
 static AstKeyMap *GetTables( AstFitsChan *this, int *status ) {
 
 /*
@@ -13916,11 +14723,12 @@ static int KeyFields( AstFitsChan *this, const char *filter, int maxfld,
 */
 
 /* Local Variables: */
+   astDECLARE_GLOBALS     /* Declare the thread specific global data */
+   FitsCard *card;        /* Pointer to current card in the list */
    const char *class;     /* Object class */
    const char *method;    /* Method name */
    int *fields;           /* Pointer to array of field values */
    int i;                 /* Field index */
-   int icard;             /* Index of current card on entry */
    int nmatch;            /* No. of matching cards */
    int nf;                /* No. of integer fields in the filter */
    int nfld;              /* No. of integer fields in current keyword name */
@@ -13954,12 +14762,12 @@ static int KeyFields( AstFitsChan *this, const char *filter, int maxfld,
    each matching keyword. */
    fields = (int *) astMalloc( sizeof( int )*(size_t) nf );
 
-/* Save the current card index, and rewind the FitsChan. */
-   icard = astGetCard( this );
-   astClearCard( this );
+/* Get a pointer to the structure holding thread-specific global data. */
+   astGET_GLOBALS(this);
 
-/* Check that the FitsChan is not empty and the pointer can be used. */
-   if( !astFitsEof( this ) && astOK ){
+/* Get a pointer to the first card, and check the FitsChan is not empty. */
+   card = (FitsCard *) this->head;
+   if( card && astOK ){
 
 /* Initialise the returned bounds. Any excess elements in the array are left
    at the previously initialised values. */
@@ -13971,13 +14779,18 @@ static int KeyFields( AstFitsChan *this, const char *filter, int maxfld,
 /* Initialise the number of matching keywords. */
       nmatch = 0;
 
-/* Loop round all the cards in the FitsChan. */
-      while( !astFitsEof( this ) && astOK ){
+/* Loop round all the cards in the FitsChan, ignoring any that are being
+   skipped because they have been used. The list of cards is followed
+   directly, rather than by moving the current card, since this is called
+   many times when reading a header and the current card would otherwise
+   need to be saved and restored on each call. */
+      do {
 
 /* If the current keyword name matches the filter, update the returned
    bounds and increment the number of matches. */
-         if( Match( CardName( this, status ), filter, nf, fields, &nfld,
-                    method, class, status ) ){
+         if( !CARDUSED( card ) &&
+             Match( card->name, filter, nf, fields, &nfld, method, class,
+                    status ) ){
             for( i = 0; i < nf; i++ ){
                if( fields[ i ] > ubnd[ i ] ) ubnd[ i ] = fields[ i ];
                if( fields[ i ] < lbnd[ i ] ) lbnd[ i ] = fields[ i ];
@@ -13986,8 +14799,8 @@ static int KeyFields( AstFitsChan *this, const char *filter, int maxfld,
          }
 
 /* Move on to the next card. */
-         MoveCard( this, 1, method, class, status );
-      }
+         card = GetLink( card, NEXT, method, class, status );
+      } while( card && (void *) card != this->head && astOK );
 
 /* If bounds were not found, returned 0 and -1. */
       for( i = 0; i < nf; i++ ){
@@ -13998,8 +14811,10 @@ static int KeyFields( AstFitsChan *this, const char *filter, int maxfld,
       }
    }
 
-/* Reinstate the original current card index. */
-   astSetCard( this, icard );
+/* If the current card is one that is being skipped, leave the FitsChan
+   at end-of-file. This is what happens to such cards if the Card
+   attribute is saved and restored. */
+   if( this->card && CARDUSED( this->card ) ) this->card = NULL;
 
 /* Free the memory used to hold the integer field values extracted from
    each matching keyword. */
@@ -14291,6 +15106,8 @@ static int FindKeyCard( AstFitsChan *this, const char *name,
 */
 
 /* Local Variables: */
+   char key[ FITSNAMLEN + 1 ]; /* Upper case keyword name */
+   int i;                /* Character index */
    int nfld;             /* Number of fields in keyword template */
    int ret;              /* Was a card found? */
 
@@ -14300,6 +15117,24 @@ static int FindKeyCard( AstFitsChan *this, const char *name,
 /* Indicate that no card has been found yet. */
    ret = 0;
 
+/* A template that contains no field specifiers can only match a keyword
+   with the same name (ignoring case). In this case, use the KeyMap holding
+   the keywords in the FitsChan to see if any such card exists. If not,
+   leave the FitsChan at end-of-file (as if the search had failed) without
+   checking each card in turn. */
+   for( i = 0; name[ i ] && i < FITSNAMLEN; i++ ) {
+      if( name[ i ] == '%' || isspace( (int) name[ i ] ) ) break;
+      key[ i ] = (char) toupper( (int) name[ i ] );
+   }
+   if( i > 0 && !name[ i ] ) {
+      key[ i ] = 0;
+      ReadFromSource( this, status );
+      if( this->keywords && !HasCard( this, key, method, class, status ) ) {
+         this->card = NULL;
+         return 0;
+      }
+   }
+
 /* Search forward through the list until all cards have been checked. */
    while( !astFitsEof( this ) && astOK ){
 
@@ -16569,6 +17404,15 @@ const char *GetAttrib( AstObject *this_object, const char *attrib, int *status )
          result = getattrib_buff;
       }
 
+/* SinkWindow. */
+/* ----------- */
+   } else if ( !strcmp( attrib, "sinkwindow" ) ) {
+      ival = astGetSinkWindow( this );
+      if ( astOK ) {
+         (void) sprintf( getattrib_buff, "%d", ival );
+         result = getattrib_buff;
+      }
+
 /* AltAxes. */
 /* -------- */
    } else if ( !strcmp( attrib, "altaxes" ) ) {
@@ -18030,6 +18874,7 @@ void astInitFitsChanVtab_(  AstFitsChanVtab *vtab, const char *name, int *status
 
 /* Store pointers to the member functions (implemented here) that provide
    virtual methods for this class. */
+   vtab->PutBlock = PutBlock;
    vtab->PutCards = PutCards;
    vtab->PutFits = PutFits;
    vtab->DelFits = DelFits;
@@ -18085,6 +18930,10 @@ void astInitFitsChanVtab_(  AstFitsChanVtab *vtab, const char *name, int *status
    vtab->TestFitsRounding = TestFitsRounding;
    vtab->SetFitsRounding = SetFitsRounding;
    vtab->GetFitsRounding = GetFitsRounding;
+   vtab->ClearSinkWindow = ClearSinkWindow;
+   vtab->TestSinkWindow = TestSinkWindow;
+   vtab->SetSinkWindow = SetSinkWindow;
+   vtab->GetSinkWindow = GetSinkWindow;
    vtab->ClearFitsAxisOrder = ClearFitsAxisOrder;
    vtab->TestFitsAxisOrder = TestFitsAxisOrder;
    vtab->SetFitsAxisOrder = SetFitsAxisOrder;
@@ -18207,6 +19056,11 @@ void astInitFitsChanVtab_(  AstFitsChanVtab *vtab, const char *name, int *status
    astEndPM;
    UNLOCK_MUTEX4
 
+/* Ensure the cache of FrameSets read from FITS headers is resized
+   whenever a new value is assigned to the FitsCache tuning parameter.
+   This also stores the current value of the parameter. */
+   astTuneHook( "FitsCache", SetFitsCacheSize );
+
 /* If we have just initialised the vtab for the current class, indicate
    that the vtab is now initialised, and store a pointer to the class
    identifier in the base "object" level of the vtab. */
@@ -20431,6 +21285,7 @@ static AstMapping *MakeColumnMap( AstFitsTable *table, const char *col,
 /* Local Variables: */
    AstMapping *result;
    char *key;
+   const double *plut;
    double *lut;
    int *dims;
    int ndim;
@@ -20438,6 +21293,7 @@ static AstMapping *MakeColumnMap( AstFitsTable *table, const char *col,
 
 /* Initialise */
    result = NULL;
+   lut = NULL;
 
 /* Check the inherited status */
    if( !astOK ) return result;
@@ -20458,8 +21314,7 @@ static AstMapping *MakeColumnMap( AstFitsTable *table, const char *col,
 /* Get the length of the index vector. */
       nel = astGetColumnLength( table, col );
 
-/* Allocate memory to hold the array values, and to hold the cell key. */
-      lut = astMalloc( nel*sizeof( double ) );
+/* Allocate memory to hold the cell key. */
       key = astMalloc( strlen( col ) + 5 );
       if( astOK ) {
 
@@ -20469,13 +21324,14 @@ static AstMapping *MakeColumnMap( AstFitsTable *table, const char *col,
    the column name. */
          sprintf( key, "%.*s(1)", (int) astChrLen( col ), col );
 
-/* Copy the array values into the above memory. */
-         if( astMapGet1D( table, key, nel, &nel, lut ) ) {
+/* Get the array values, either in place or copied into the above memory. */
+         plut = GetTableLut( table, key, &lut, &nel, status );
+         if( plut ) {
 
 /* Create a 1D LutMap. FITS-WCS paper III (sec 6.1.2) mandates that the input
    corresponds to FITS grid coord (i.e. 1.0 at the centre of the first entry).
    Ensure the LutMap uses linear interpolation. */
-            result = (AstMapping *) astLutMap( nel, lut, 1.0, 1.0,
+            result = (AstMapping *) astLutMap( nel, plut, 1.0, 1.0,
                                                "LutInterp=%d", status, interp );
 
 /* Report an error if the table cell was empty. */
@@ -20518,8 +21374,7 @@ static AstMapping *MakeColumnMap( AstFitsTable *table, const char *col,
 /* Handle 1-dimensional  look-up tables. */
       } else if( astOK ){
 
-/* Allocate memory to hold the array values, and to hold the cell key. */
-         lut = astMalloc( dims[ 1 ]*sizeof( double ) );
+/* Allocate memory to hold the cell key. */
          key = astMalloc( strlen( col ) + 5 );
          if( astOK ) {
 
@@ -20529,13 +21384,14 @@ static AstMapping *MakeColumnMap( AstFitsTable *table, const char *col,
    the column name. */
             sprintf( key, "%.*s(1)", (int) astChrLen( col ), col );
 
-/* Copy the array values into the above memory. */
-            if( astMapGet1D( table, key, dims[ 1 ], dims, lut ) ) {
+/* Get the array values, either in place or copied into the above memory. */
+            plut = GetTableLut( table, key, &lut, dims + 1, status );
+            if( plut ) {
 
 /* Create a 1D LutMap. FITS-WCS paper III (sec 6.1.2) mandates that the input
    corresponds to FITS grid coord (i.e. 1.0 at the centre of the first entry).
    Ensure the LutMap uses linear interpolation. */
-               result = (AstMapping *) astLutMap( dims[ 1 ], lut, 1.0, 1.0,
+               result = (AstMapping *) astLutMap( dims[ 1 ], plut, 1.0, 1.0,
                                                   "LutInterp=%d", status,
                                                   interp );
 
@@ -22064,6 +22920,21 @@ static int Match( const char *test, const char *temp, int maxfld, int *fields,
       match_template = temp;
    }
 
+/* Any characters at the start of the template that precede the first
+   field specifier must be matched (ignoring case) by the characters at
+   the start of the test string. Check these first since most calls to
+   this function involve keywords that do not match the template, and
+   can be rejected without any further work. If the template contains no
+   field specifiers at all, this is a complete test. */
+   a = test;
+   b = temp;
+   while( *b && *b != '%' ) {
+      if( toupper( (int) *b ) != toupper( (int) *a ) ) return 0;
+      a++;
+      b++;
+   }
+   if( !*b ) return !*a;
+
 /* Increment the number of entries into this function. */
    match_nentry++;
 
@@ -22820,12 +23691,14 @@ static void NewCard( AstFitsChan *this, const char *name, int type,
 */
 
 /* Local Variables: */
+   AstMapKeyHandle handle;    /* Prepared keyword name */
    FitsCard *new;             /* Pointer to the new card */
    FitsCard *prev;            /* Pointer to the previous card in the list */
    char *b;                   /* Pointer to next stored character */
    const char *a;             /* Pointer to next supplied character */
    int lval;                  /* Logical data value restricted to 0 or 1 */
    int nc;                    /* No. of characters to store */
+   int ncard;                 /* No. of cards with the same keyword name */
 
 /* Check the global status. */
    if( !astOK ) return;
@@ -22847,8 +23720,17 @@ static void NewCard( AstFitsChan *this, const char *name, int type,
       if( !this->keywords ) this->keywords = astKeyMap( " ", status );
 
 /* Add the keyword name to the KeyMap. The value associated with the
-   KeyMap entry is not used and is set arbitrarily to zero. */
-      astMapPut0I( this->keywords, new->name, 0, NULL );
+   KeyMap entry is the number of cards in the FitsChan that have this
+   keyword name. A key handle is used so that the keyword name is only
+   hashed once. */
+      astMapKeyHandle( this->keywords, new->name, &handle );
+      if( !astMapGet0H( this->keywords, &handle, AST__INTTYPE, &ncard ) ) ncard = 0;
+      ncard++;
+      astMapPut0H( this->keywords, &handle, AST__INTTYPE, &ncard, NULL );
+
+/* Count the cards added since cards were last written out to the sink
+   (see attribute SinkWindow). */
+      this->nsinkcard++;
 
 /* Copy the data type. */
       new->type = type;
@@ -24629,6 +25511,155 @@ f        The global status.
 
 }
 
+static int PutBlock( AstFitsChan *this, const char *block, int nc,
+                     int *status ) {
+
+/*
+*++
+*  Name:
+c     astPutBlock
+f     AST_PUTBLOCK
+
+*  Purpose:
+*     Store a block of raw FITS header cards in a FitsChan.
+
+*  Type:
+*     Public virtual function.
+
+*  Synopsis:
+c     #include "fitschan.h"
+
+c     int astPutBlock( AstFitsChan *this, const char *block, int nc )
+f     RESULT = AST_PUTBLOCK( THIS, BLOCK, STATUS )
+
+*  Class Membership:
+*     FitsChan method.
+
+*  Description:
+c     This function
+f     This routine
+*     appends a set of FITS header cards to the end of a FitsChan. The
+*     cards are supplied in the form in which they are stored in a FITS
+*     file - i.e. as a contiguous buffer of 80 character cards, usually
+*     holding one or more complete 2880 byte FITS header blocks. The buffer
+*     need not be null-terminated. Cards are read from the buffer until a
+*     FITS "END" card is found, or the end of the buffer is reached. The
+*     END card itself, and any cards following it, are not stored.
+*
+*     Unlike
+c     astPutCards,
+f     AST_PUTCARDS,
+*     this function does not empty the FitsChan first. A FITS header
+*     that spans several blocks can therefore be stored by calling this
+c     function
+f     routine
+*     once for each block, in order, until it indicates that the END card
+*     has been found.
+*
+*     The FitsChan is "re-wound" on exit by clearing its Card attribute.
+*     This means that a subsequent invocation of
+c     astRead
+f     AST_READ
+*     can be made immediately without the need to re-wind the FitsChan
+*     first.
+
+*  Parameters:
+c     this
+f     THIS = INTEGER (Given)
+*        Pointer to the FitsChan.
+c     block
+f     BLOCK = CHARACTER * ( * ) (Given)
+c        Pointer to a character buffer
+f        A character string
+*        containing the FITS cards to be stored. Each individual card
+*        should occupy 80 characters in this buffer, and there should be
+*        no delimiters, new lines, etc, between adjacent cards. The final
+*        card may be less than 80 characters long.
+c     nc
+c        The number of characters in the buffer. Usually this will be
+c        a multiple of 2880.
+f     STATUS = INTEGER (Given and Returned)
+f        The global status.
+
+*  Returned Value:
+c     astPutBlock()
+f     AST_PUTBLOCK = LOGICAL
+c        A non-zero value is returned if an END card was found in the
+c        supplied buffer, and zero is returned otherwise.
+f        .TRUE. is returned if an END card was found in the supplied
+f        buffer, and .FALSE. is returned otherwise.
+
+*  Notes:
+*     - An error will result if the supplied buffer contains any cards
+*     which cannot be interpreted.
+c     - A value of zero will be returned if this function is invoked
+c     with the AST error status set, or if it should fail for any
+f     - A value of .FALSE. will be returned if this function is invoked
+f     with STATUS set to an error value, or if it should fail for any
+*     reason.
+*--
+*/
+
+/* Local Variables: */
+   char last[ AST__FITSCHAN_FITSCARDLEN + 1 ]; /* Copy of a short final card */
+   const char *a;         /* Pointer to start of next card */
+   const char *class;     /* Object class */
+   const char *method;    /* Current method */
+   int end;               /* Has the END card been found? */
+   int i;                 /* Character index */
+   int ncard;             /* No. of characters in current card */
+
+/* Initialise. */
+   end = 0;
+
+/* Check the global error status. */
+   if ( !astOK ) return end;
+
+/* Ensure the source function has been called */
+   ReadFromSource( this, status );
+
+/* Store the current method, and the class of the supplied object for use
+   in error messages.*/
+   method = "astPutBlock";
+   class = astGetClass( this );
+
+/* Ensure the FitsChan is at end-of-file. This will result in the new
+   cards being appended to the end of the FitsChan. */
+   astSetCard( this, INT_MAX );
+
+/* Loop round the supplied buffer in 80 character segments. */
+   for( a = block; a < block + nc && astOK; a += AST__FITSCHAN_FITSCARDLEN ){
+      ncard = block + nc - a;
+      if( ncard > AST__FITSCHAN_FITSCARDLEN ) ncard = AST__FITSCHAN_FITSCARDLEN;
+
+/* Check for an END card (the keyword "END" followed by blanks in the
+   rest of the keyword field). */
+      if( ncard >= 3 && !strncmp( a, "END", 3 ) ){
+         for( i = 3; i < ncard && i < FITSNAMLEN && a[ i ] == ' '; i++ );
+         if( i == ncard || i == FITSNAMLEN ) {
+            end = 1;
+            break;
+         }
+      }
+
+/* Store the card. A full length card need not be null terminated, but a
+   short final card must be copied so that it can be terminated. */
+      if( ncard == AST__FITSCHAN_FITSCARDLEN ) {
+         StoreCard( this, a, 0, method, class, status );
+      } else {
+         memcpy( last, a, ncard );
+         last[ ncard ] = 0;
+         StoreCard( this, last, 0, method, class, status );
+      }
+   }
+
+/* Rewind the FitsChan. */
+   astClearCard( this );
+
+/* Return the result. */
+   return astOK ? end : 0;
+}
+
 static void PutCards( AstFitsChan *this, const char *cards, int *status ) {
 
 /*
@@ -24690,6 +25721,7 @@ f        The global status.
 
 /* Local Variables: */
    const char *a;         /* Pointer to start of next card */
+   const char *class;     /* Object class */
    int clen;              /* Length of supplied string */
    int i;                 /* Card index */
    int ncard;             /* No. of cards supplied */
@@ -24700,6 +25732,9 @@ f        The global status.
 /* Ensure the source function has been called */
    ReadFromSource( this, status );
 
+/* Store the class of the supplied object for use in error messages.*/
+   class = astGetClass( this );
+
 /* Empty the FitsChan. */
    astEmptyFits( this );
 
@@ -24710,7 +25745,9 @@ f        The global status.
    ncard = clen/80;
    if( ncard*80 < clen ) ncard++;
    a = cards;
-   for( i = 0; i < ncard; i++, a += 80 ) astPutFits( this, a, 1 );
+   for( i = 0; i < ncard && astOK; i++, a += 80 ) {
+      StoreCard( this, a, 1, "astPutCards", class, status );
+   }
 
 /* Rewind the FitsChan. */
    astClearCard( this );
@@ -24782,134 +25819,15 @@ f        The global status.
 *--
 */
 
-/* Local Variables: */
-   char *comment;         /* The keyword comment */
-   char *name;            /* The keyword name */
-   char *value;           /* The keyword value */
-   const char *class;     /* Object class */
-   const char *method;    /* Current method */
-   double cfval[2];       /* Complex floating point keyword value */
-   double fval;           /* floating point keyword value */
-   int cival[2];          /* Complex integer keyword value */
-   int ival;              /* Integer keyword value */
-   int64_t kval;          /* 64 bit integer keyword value */
-   int len;               /* No. of characters to read from the value string */
-   int nc;                /* No. of characters read from value string */
-   int type;              /* Keyword data type */
-
 /* Check the global error status. */
    if ( !astOK ) return;
 
 /* Ensure the source function has been called */
    ReadFromSource( this, status );
 
-/* Store the current method, and the class of the supplied object for use
-   in error messages.*/
-   method = "astPutFits";
-   class = astGetClass( this );
-
-/* Split the supplied card up into name, value and commment strings, and
-   get pointers to local copies of them. The data type associated with the
-   keyword is returned. */
-   type = Split( this, card, &name, &value, &comment, method, class, status );
-
-/* Check that the pointers can be used. */
-   if( astOK ){
-
-/* Initialise the number of characters read from the value string. */
-      nc = 0;
-
-/* Store the number of characters in the value string. */
-      len = strlen( value );
-
-/* Read and store floating point values from the value string. NB, this
-   list is roughly in the order of descreasing frequency of use (i.e.
-   most FITS keywords are simple floating point values, the next most
-   common are strings, etc). */
-      if( type == AST__FLOAT ){
-         if( 1 == astSscanf( value, " %lf %n", &fval, &nc ) && nc >= len ){
-            astSetFitsF( this, name, fval, comment, overwrite );
-         } else {
-            astError( AST__BDFTS, "%s(%s): Unable to read a floating point "
-                      "FITS keyword value.", status, method, class );
-         }
-
-/* Read and store string values from the value string. */
-      } else if( type == AST__STRING ){
-         astSetFitsS( this, name, value, comment, overwrite );
-
-/* Read and store string values from the value string. */
-      } else if( type == AST__CONTINUE ){
-         astSetFitsCN( this, name, value, comment, overwrite );
-
-/* Store comment card. */
-      } else if( type == AST__COMMENT ){
-         astSetFitsCom( this, name, comment, overwrite );
-
-/* Read and store integer values from the value string. */
-      } else if( type == AST__INT ){
-         if( 1 == astSscanf( value, " %d %n", &ival, &nc ) && nc >= len ){
-            astSetFitsI( this, name, ival, comment, overwrite );
-         } else {
-            astError( AST__BDFTS, "%s(%s): Unable to read an integer FITS "
-                      "keyword value.", status, method, class );
-         }
-
-/* Read and store 64 bit integer values from the value string. */
-      } else if( type == AST__KINT ){
-         if( 1 == astSscanf( value, " %" PRId64 " %n", &kval, &nc ) && nc >= len ){
-            astSetFitsK( this, name, kval, comment, overwrite );
-         } else {
-            astError( AST__BDFTS, "%s(%s): Unable to read a 64 bit integer FITS "
-                      "keyword value.", status, method, class );
-         }
-
-/* Read and store logical values from the value string. */
-      } else if( type == AST__LOGICAL ){
-         astSetFitsL( this, name, (*value == 'T'), comment, overwrite );
-
-/* Read and store undefined values from the value string. */
-      } else if( type == AST__UNDEF ){
-         astSetFitsU( this, name, comment, overwrite );
-
-/* Read and store complex floating point values from the value string. */
-      } else if( type == AST__COMPLEXF ){
-         if( 2 == astSscanf( value, " %lf %lf %n", cfval, cfval + 1, &nc ) &&
-             nc >= len ){
-            astSetFitsCF( this, name, cfval, comment, overwrite );
-         } else {
-            astError( AST__BDFTS, "%s(%s): Unable to read a complex pair "
-                      "of floating point FITS keyword values.", status, method, class );
-         }
-
-/* Read and store complex integer values from the value string. */
-      } else if( type == AST__COMPLEXI ){
-         if( 2 == astSscanf( value, " %d %d %n", cival, cival + 1, &nc ) &&
-             nc >= len ){
-            astSetFitsCI( this, name, cival, comment, overwrite );
-         } else {
-            astError( AST__BDFTS, "%s(%s): Unable to read a complex pair "
-                      "of integer FITS keyword values.", status, method, class );
-         }
-
-/* Report an error for any other type. */
-      } else {
-         astError( AST__INTER, "%s: AST internal programming error - "
-                   "FITS data-type '%d' not yet supported.", status, method, type );
-      }
-
-/* Give a context message if an error occurred. */
-      if( !astOK ){
-         astError( astStatus, "%s(%s): Unable to store the following FITS "
-                   "header card:\n%s\n", status, method, class, card );
-      }
-   }
-
-/* Free the memory used to hold the keyword name, comment and value
-   strings. */
-   (void) astFree( (void *) name );
-   (void) astFree( (void *) comment );
-   (void) astFree( (void *) value );
+/* Decode the card and store it in the FitsChan. */
+   StoreCard( this, card, overwrite, "astPutFits", astGetClass( this ),
+              status );
 }
 
 static void PutTable( AstFitsChan *this, AstFitsTable *table,
@@ -25196,8 +26114,9 @@ static AstObject *Read( AstChannel *this_channel, int *status ) {
    intermediary structure called a FitsStore. */
          store = FitsToStore( this, encoding, method, class, status );
 
-/* Now create a FrameSet from this FitsStore. */
-         new = FsetFromStore( this, store, method, class, status );
+/* Now create a FrameSet from this FitsStore, re-using a previously
+   read FrameSet if possible. */
+         new = FsetFromCache( this, store, encoding, method, class, status );
 
 /* Release the resources used by the FitsStore. */
          store = FreeStore( store, status );
@@ -25600,6 +26519,65 @@ static void ReadFromSource( AstFitsChan *this, int *status ){
    }
 }
 
+static void ReleaseCachedFset( AstObject *fset, int *status ){
+/*
+*  Name:
+*     ReleaseCachedFset
+
+*  Purpose:
+*     Annul a pointer to a FrameSet held in the FrameSet cache.
+
+*  Type:
+*     Private function.
+
+*  Synopsis:
+*     #include "fitschan.h"
+*     void ReleaseCachedFset( AstObject *fset, int *status )
+
+*  Class Membership:
+*     FitsChan member function.
+
+*  Description:
+*     This function annuls a pointer to a FrameSet that is, or was, held
+*     in the cache of FrameSets read from FITS headers. Such FrameSets
+*     are left unlocked, so that they can be used by any thread. If the
+*     supplied pointer is the last one, the FrameSet is locked for use by
+*     the current thread before it is deleted. Otherwise, the FrameSet is
+*     left unlocked.
+
+*  Parameters:
+*     fset
+*        The pointer to annul.
+*     status
+*        Pointer to the inherited status variable.
+
+*  Notes:
+*     -  This function should only be called while mutex5 is locked.
+*     Since all clones of a cached FrameSet are taken and annulled while
+*     mutex5 is locked, this ensures that no other thread can change the
+*     reference count between it being checked and the pointer being
+*     annulled.
+*     -  This function attempts to execute even if an error has occurred.
+*/
+
+/* Local Variables: */
+   int lstatus;                 /* Local status value */
+
+/* Lock the FrameSet for use by the current thread, waiting for any other
+   thread to finish copying it. */
+   astManageLock( fset, AST__LOCK, 1, NULL );
+
+/* If other pointers remain, unlock it again before annulling the pointer.
+   Otherwise, the FrameSet is deleted while locked. A separate status
+   variable is used when getting the reference count, so that the
+   FrameSet is not left locked if an error has already occurred. */
+   lstatus = 0;
+   if( astGetRefCount_( fset, &lstatus ) > 1 ) {
+      astManageLock( fset, AST__UNLOCK, 1, NULL );
+   }
+   (void) astAnnul( fset );
+}
+
 static void RemoveTables( AstFitsChan *this, const char *key, int *status ){
 
 /*
@@ -25796,6 +26774,7 @@ static void RoundFString( char *text, int width, int fitsrnd, int *status ){
    char *exp;
    char *ltext;
    char *prnd;
+   char lbuf[ 100 ];
    char *seq0;
    char *seq9;
    int bu;
@@ -25815,10 +26794,11 @@ static void RoundFString( char *text, int width, int fitsrnd, int *status ){
 /* Save the original length of the text. */
    len0 = strlen( text );
 
-/* Allocate a buffer and store a copy of the text with an extra leading
-   space. */
+/* Store a copy of the text with an extra leading space. Formatted
+   numerical values are short, so use a local buffer unless the text is
+   too long to fit in it. */
    len = len0 + 1;
-   ltext = astMalloc( len + 1 );
+   ltext = ( len < (int) sizeof( lbuf ) ) ? lbuf : astMalloc( len + 1 );
    if( ltext ) {
       *ltext = ' ';
       strcpy( ltext + 1, text );
@@ -26055,7 +27035,7 @@ static void RoundFString( char *text, int width, int fitsrnd, int *status ){
       if( astChrLen( ltext ) <= len0 ) strcpy( text, ltext );
 
 /* Free local resources. */
-      ltext = astFree( ltext );
+      if( ltext != lbuf ) ltext = astFree( ltext );
 
 /* If a minimum field width has been given, move the text to the right
    hand end of the supplied buffer. */
@@ -26640,6 +27620,13 @@ static void SetAttrib( AstObject *this_object, const char *setting, int *status
         && ( nc >= len ) ) {
       astSetFitsRounding( this, ival );
 
+/* SinkWindow. */
+/* ----------- */
+   } else if ( nc = 0,
+        ( 1 == astSscanf( setting, "sinkwindow= %d %n", &ival, &nc ) )
+        && ( nc >= len ) ) {
+      astSetSinkWindow( this, ival );
+
 /* FitsAxisOrder. */
 /* -------------- */
    } else if ( nc = 0,
@@ -26764,6 +27751,63 @@ static void SetAttrib( AstObject *this_object, const char *setting, int *status
    }
 }
 
+static void SetFitsCacheSize( int size, int *status ){
+/*
+*  Name:
+*     SetFitsCacheSize
+
+*  Purpose:
+*     Set the maximum number of FrameSets retained in the cache of
+*     FrameSets read from FITS headers.
+
+*  Type:
+*     Private function.
+
+*  Synopsis:
+*     #include "fitschan.h"
+*     void SetFitsCacheSize( int size, int *status )
+
+*  Class Membership:
+*     FitsChan member function.
+
+*  Description:
+*     This function is registered with the Object class (using
+*     astTuneHook) and is invoked whenever a new value is assigned to
+*     the FitsCache tuning parameter (see astTune). It stores the new
+*     maximum number of FrameSets that may be retained in the
+*     process-wide cache of FrameSets read from FITS headers.
+*
+*     When a FrameSet is read from a FitsChan using any encoding other
+*     than NATIVE, and the cache is in use, a copy of the FrameSet is
+*     stored in the cache together with a description of the WCS-related
+*     keyword values from which it was created. If a later read finds
+*     that the same WCS-related keyword values (and FitsChan attribute
+*     values) have been used to create a cached FrameSet, a copy of the
+*     cached FrameSet is returned instead of creating a new one. This
+*     saves time when many FITS headers with the same WCS are read, as
+*     is often the case when processing tiles or frames from a single
+*     instrument.
+
+*  Parameters:
+*     size
+*        The new maximum number of FrameSets to retain. The cache is not
+*        used if this is zero. Reducing the value causes the least
+*        recently used FrameSets to be deleted until the new limit is met.
+*     status
+*        Pointer to the inherited status variable.
+
+*  Notes:
+*     -  This function attempts to execute even if an error has occurred.
+*/
+
+/* Serialise access to the cache, since it is shared by all threads.
+   Store the new value, and delete any excess entries. */
+   LOCK_MUTEX5
+   fitscache_size = ( size > 0 ) ? size : 0;
+   EmptyFitsCache( fitscache_size, status );
+   UNLOCK_MUTEX5
+}
+
 static void SetCard( AstFitsChan *this, int icard, int *status ){
 
 /*
@@ -31424,6 +32468,7 @@ int Split( AstFitsChan *this, const char *card, char **name, char **value,
    int len;                   /* Used length of value string */
    int lq;                    /* Was previous character an escaping quote? */
    int nch;                   /* No. of characters used */
+   int nch2;                  /* No. of characters used by second value */
    int ndig;                  /* No. of digits in the formatted integer */
    int type;                  /* Keyword data type */
    size_t nc;                 /* Number of character in the supplied card */
@@ -31642,15 +32687,14 @@ int Split( AstFitsChan *this, const char *card, char **name, char **value,
 
 /* First attempt to read two integers from the string (separated by white
    space). */
-                     if( nch = 0,
-                         ( 2 == astSscanf( v, " %d %d%n", &ir, &ii, &nch ) ) &&
-                         ( nch >= len ) ) {
+                     if( ( nch = astChrReadInt( v, &ir ) ) &&
+                         ( nch2 = astChrReadInt( v + nch, &ii ) ) &&
+                         ( nch + nch2 >= len ) ) {
                         type = AST__COMPLEXI;
 
 /* If that failed, attempt to read a single 64 bit integer from the string. */
-                     } else if( nch = 0,
-                         ( 1 == astSscanf( v, " %" PRId64 "%n", &kr, &nch ) ) &&
-                         ( nch >= len ) ) {
+                     } else if( ( nch = astChrReadInt64( v, &kr ) ) &&
+                                ( nch >= len ) ) {
 
 /* See if the value is small enough to fit in a 32 bit integer. */
                         if( kr <= INT_MAX && kr >= INT_MIN ) {
@@ -31665,15 +32709,14 @@ int Split( AstFitsChan *this, const char *card, char **name, char **value,
 
 /* First attempt to read two doubles from the string (separated by white
    space). */
-                     if( nch = 0,
-                         ( 2 == astSscanf( v, " %lf %lf%n", &fr, &fi, &nch ) ) &&
-                         ( nch >= len ) ) {
+                     if( ( nch = astChrReadDouble( v, &fr ) ) &&
+                         ( nch2 = astChrReadDouble( v + nch, &fi ) ) &&
+                         ( nch + nch2 >= len ) ) {
                         type = AST__COMPLEXF;
 
-/* If that failed, attempt to read a single double from the string. */
-                     } else if( nch = 0,
-                         ( 1 == astSscanf( v, " %lf%n", &fr, &nch ) ) &&
-                         ( nch >= len ) ) {
+/* If that failed, see if the first double read above used the whole
+   string. */
+                     } else if( nch >= len ) {
                         type = AST__FLOAT;
                      }
 
@@ -31691,15 +32734,14 @@ int Split( AstFitsChan *this, const char *card, char **name, char **value,
 
 /* Attempt to read two doubles from the edited string (separated by white
    space). */
-                        if( nch = 0,
-                          ( 2 == astSscanf( v, " %lf %lf%n", &fr, &fi, &nch ) ) &&
-                          ( nch >= len ) ) {
+                        if( ( nch = astChrReadDouble( v, &fr ) ) &&
+                            ( nch2 = astChrReadDouble( v + nch, &fi ) ) &&
+                            ( nch + nch2 >= len ) ) {
                            type = AST__COMPLEXF;
 
-/* If that failed, attempt to read a single double from the edited string. */
-                        } else if( nch = 0,
-                            ( 1 == astSscanf( v, " %lf%n", &fr, &nch ) ) &&
-                            ( nch >= len ) ) {
+/* If that failed, see if the first double read above used the whole
+   edited string. */
+                        } else if( nch >= len ) {
                            type = AST__FLOAT;
                         }
                      }
@@ -32468,6 +33510,301 @@ static int SplitMat( int naxis, double *matrix, double *cdelt, int *status ){
    }
    return ok;
 }
+static void StoreCard( AstFitsChan *this, const char *card, int overwrite,
+                       const char *method, const char *class, int *status ){
+
+/*
+*  Name:
+*     StoreCard
+
+*  Purpose:
+*     Decode a FITS header card and store it in a FitsChan.
+
+*  Type:
+*     Private function.
+
+*  Synopsis:
+*     #include "fitschan.h"
+*     void StoreCard( AstFitsChan *this, const char *card, int overwrite,
+*                     const char *method, const char *class, int *status )
+
+*  Class Membership:
+*     FitsChan member function.
+
+*  Description:
+*     This function splits the supplied header card up into keyword name,
+*     value and comment, converts the value to the appropriate data type,
+*     and stores the resulting card in the FitsChan, either inserting it
+*     before the current card or over-writing the current card. It does the
+*     same job as the public astPutFits method, but the decoded value is
+*     stored directly rather than being passed on to the astSetFits<X>
+*     methods (which would split the keyword name up a second time). It is
+*     used wherever large numbers of cards are stored in one go.
+
+*  Parameters:
+*     this
+*        Pointer to the FitsChan.
+*     card
+*        Pointer to a possibly null-terminated character string
+*        containing the FITS card to be stored. No more than 80
+*        characters will be used from this string (or fewer if a null
+*        occurs earlier).
+*     overwrite
+*        If non-zero, the new card replaces the current card. Otherwise
+*        it is inserted in front of the current card. In either case,
+*        the card following the new card becomes the current card.
+*     method
+*        Pointer to string holding name of calling method.
+*     class
+*        Pointer to string holding object class.
+*     status
+*        Pointer to the inherited status variable.
+
+*  Notes:
+*     - If no comment is included in the card, and the current card is
+*     being over-written, the comment from the current card is retained
+*     (as for the astSetFits<X> methods).
+*     - It is assumed that the source function has already been called.
+*/
+
+/* Local Variables: */
+   char *comment;         /* The keyword comment */
+   char *name;            /* The keyword name */
+   char *value;           /* The keyword value */
+   const char *com;       /* Comment to store */
+   double cfval[2];       /* Complex floating point keyword value */
+   double fval;           /* floating point keyword value */
+   int cival[2];          /* Complex integer keyword value */
+   int free_com;          /* Should com be freed before returning? */
+   int ival;              /* Integer keyword value */
+   int64_t kval;          /* 64 bit integer keyword value */
+   int len;               /* No. of characters to read from the value string */
+   int nc;                /* No. of characters read from value string */
+   int type;              /* Keyword data type */
+   void *data;            /* Pointer to the decoded keyword value */
+
+/* Check the global error status. */
+   if ( !astOK ) return;
+
+/* Split the supplied card up into name, value and commment strings, and
+   get pointers to local copies of them. The data type associated with the
+   keyword is returned. */
+   type = Split( this, card, &name, &value, &comment, method, class, status );
+
+/* Check that the pointers can be used. */
+   if( astOK ){
+
+/* Initialise the number of characters read from the value string, and
+   the pointer to the decoded value. */
+      nc = 0;
+      data = NULL;
+
+/* Store the number of characters in the value string. */
+      len = strlen( value );
+
+/* Read floating point values from the value string. NB, this list is
+   roughly in the order of descreasing frequency of use (i.e. most FITS
+   keywords are simple floating point values, the next most common are
+   strings, etc). */
+      if( type == AST__FLOAT ){
+         if( ( nc = astChrReadDouble( value, &fval ) ) && nc >= len ){
+            data = &fval;
+         } else {
+            astError( AST__BDFTS, "%s(%s): Unable to read a floating point "
+                      "FITS keyword value.", status, method, class );
+         }
+
+/* String values (including CONTINUE cards) are stored as they are. */
+      } else if( type == AST__STRING || type == AST__CONTINUE ){
+         data = value;
+
+/* Comment cards over-writing a card with the same keyword retain the
+   value of the card being over-written, so store them using
+   astSetFitsCom. */
+      } else if( type == AST__COMMENT ){
+         astSetFitsCom( this, name, comment, overwrite );
+
+/* Read integer values from the value string. */
+      } else if( type == AST__INT ){
+         if( ( nc = astChrReadInt( value, &ival ) ) && nc >= len ){
+            data = &ival;
+         } else {
+            astError( AST__BDFTS, "%s(%s): Unable to read an integer FITS "
+                      "keyword value.", status, method, class );
+         }
+
+/* Read 64 bit integer values from the value string. */
+      } else if( type == AST__KINT ){
+         if( ( nc = astChrReadInt64( value, &kval ) ) && nc >= len ){
+            data = &kval;
+         } else {
+            astError( AST__BDFTS, "%s(%s): Unable to read a 64 bit integer FITS "
+                      "keyword value.", status, method, class );
+         }
+
+/* Read logical values from the value string. */
+      } else if( type == AST__LOGICAL ){
+         ival = ( *value == 'T' );
+         data = &ival;
+
+/* Undefined values have no data. */
+      } else if( type == AST__UNDEF ){
+         data = NULL;
+
+/* Read complex floating point values from the value string. */
+      } else if( type == AST__COMPLEXF ){
+         if( 2 == astSscanf( value, " %lf %lf %n", cfval, cfval + 1, &nc ) &&
+             nc >= len ){
+            data = cfval;
+         } else {
+            astError( AST__BDFTS, "%s(%s): Unable to read a complex pair "
+                      "of floating point FITS keyword values.", status, method, class );
+         }
+
+/* Read complex integer values from the value string. */
+      } else if( type == AST__COMPLEXI ){
+         if( 2 == astSscanf( value, " %d %d %n", cival, cival + 1, &nc ) &&
+             nc >= len ){
+            data = cival;
+         } else {
+            astError( AST__BDFTS, "%s(%s): Unable to read a complex pair "
+                      "of integer FITS keyword values.", status, method, class );
+         }
+
+/* Report an error for any other type. */
+      } else {
+         astError( AST__INTER, "%s: AST internal programming error - "
+                   "FITS data-type '%d' not yet supported.", status, method, type );
+      }
+
+/* Store any card other than a comment card. If the comment is blank, use
+   the existing comment if we are over-writing, or a NULL pointer
+   otherwise. */
+      if( astOK && type != AST__COMMENT ){
+         com = ChrLen( comment, status ) ? comment : NULL;
+         free_com = 0;
+         if( !com && overwrite && CardComm( this, status ) ) {
+            com = (const char *) astStore( NULL, (void *) CardComm( this, status ),
+                                           strlen( CardComm( this, status ) ) + 1 );
+            free_com = 1;
+         }
+         InsCard( this, overwrite, name, type, data, com, method, class, status );
+         if( free_com ) com = (const char *) astFree( (void *) com );
+      }
+
+/* Give a context message if an error occurred. */
+      if( !astOK ){
+         astError( astStatus, "%s(%s): Unable to store the following FITS "
+                   "header card:\n%.*s\n", status, method, class,
+                   AST__FITSCHAN_FITSCARDLEN, card );
+      }
+   }
+
+/* Free the memory used to hold the keyword name, comment and value
+   strings. */
+   (void) astFree( (void *) name );
+   (void) astFree( (void *) comment );
+   (void) astFree( (void *) value );
+}
+
+static void StreamCards( AstFitsChan *this, int force, int *status ){
+/*
+*  Name:
+*     StreamCards
+
+*  Purpose:
+*     Write completed cards out to the sink function.
+
+*  Type:
+*     Private function.
+
+*  Synopsis:
+*     #include "fitschan.h"
+*     void StreamCards( AstFitsChan *this, int force, int *status )
+
+*  Class Membership:
+*     FitsChan member function.
+
+*  Description:
+*     If the SinkWindow attribute is non-zero, all cards that precede the
+*     current card are passed in turn to the sink function specified when
+*     the FitsChan was created, and are then removed from the FitsChan.
+*     Cards marked as having been read into an AST object are removed
+*     without being written out, as in WriteToSink. Nothing is done if
+*     the SinkFile attribute is set or if no sink function was provided.
+*
+*     This function is called while an Object is being written to the
+*     FitsChan, at points where no cards preceding the current card will
+*     be modified, so the cards are written out in the same order as
+*     WriteToSink would use.
+
+*  Parameters:
+*     this
+*        Pointer to the FitsChan.
+*     force
+*        If zero, cards are only written out if more than SinkWindow
+*        cards have been added to the FitsChan since cards were last
+*        written out. If non-zero, cards are written out regardless of
+*        the number of cards added.
+*     status
+*        Pointer to the inherited status variable.
+
+*  Notes:
+*     -  The current card is left unchanged.
+*/
+
+/* Local Variables: */
+   FitsCard *card0;             /* Current card on entry */
+   astDECLARE_GLOBALS           /* Declare the thread specific global data */
+   char card[ AST__FITSCHAN_FITSCARDLEN + 1]; /* Buffer for header card */
+   const char *class;           /* Object class */
+   int old_ignore_used;         /* Original value of external variable ignore_used */
+   int window;                  /* Value of SinkWindow attribute */
+
+/* Check the global status. */
+   if( !astOK ) return;
+
+/* Return if cards cannot be streamed to a sink function. */
+   if( !this->sink || !this->sink_wrap || astTestSinkFile( this ) ) return;
+
+/* Return if streaming has not been requested, or if the window has not
+   yet been filled. */
+   window = astGetSinkWindow( this );
+   if( window <= 0 || ( !force && this->nsinkcard <= window ) ) return;
+
+/* Get a pointer to the structure holding thread-specific global data. */
+   astGET_GLOBALS(this);
+
+/* Save the current card and then rewind the FitsChan, including any
+   cards that have been read into an AST object. */
+   class = astGetClass( this );
+   card0 = (FitsCard *) this->card;
+   old_ignore_used = ignore_used;
+   ignore_used = 0;
+   this->card = this->head;
+
+/* Loop round all cards that precede the original current card. Write
+   out each one that has not been used, and then delete it (this makes
+   the next card current). The sink function is an externally supplied
+   function which may not be thread-safe, so lock a mutex first. */
+   while( this->card && this->card != (void *) card0 && astOK ){
+      if( !( ( (FitsCard *) this->card )->flags & USED ) ) {
+         FormatCard( this, card, "astWrite", status );
+         astStoreChannelData( this );
+         LOCK_MUTEX3;
+         ( *this->sink_wrap )( *this->sink, card, status );
+         UNLOCK_MUTEX3;
+      }
+      DeleteCard( this, "astWrite", class, status );
+   }
+
+/* Re-instate the original current card and ignore_used flag, and reset
+   the count of cards added since the last cards were written out. */
+   ignore_used = old_ignore_used;
+   this->card = (void *) card0;
+   this->nsinkcard = 0;
+}
+
 static void TableSource( AstFitsChan *this,
                          void (* tabsource)( AstFitsChan *, const char *,
                                              int, int, int * ),
@@ -33283,6 +34620,11 @@ static int TestAttrib( AstObject *this_object, const char *attrib, int *status )
    } else if ( !strcmp( attrib, "fitsrounding" ) ) {
       result = astTestFitsRounding( this );
 
+/* SinkWindow. */
+/* ----------- */
+   } else if ( !strcmp( attrib, "sinkwindow" ) ) {
+      result = astTestSinkWindow( this );
+
 /* DefB1950. */
 /* --------- */
    } else if ( !strcmp( attrib, "defb1950" ) ) {
@@ -34189,6 +35531,7 @@ static void Warn( AstFitsChan *this, const char *condition, const char *text,
 */
 
 /* Local Variables: */
+   astDECLARE_GLOBALS    /* Declare the thread specific global data */
    char buff[ AST__FITSCHAN_FITSCARDLEN + 1 ]; /* Buffer for new card text */
    const char *a;        /* Pointer to 1st character in next card */
    const char *b;        /* Pointer to terminating null character */
@@ -34200,6 +35543,9 @@ static void Warn( AstFitsChan *this, const char *condition, const char *text,
 /* Check the inherited status, warning text, FitsChan and Clean attribute. */
    if( !astOK || !text || !text[0] || !this || astGetClean( this ) ) return;
 
+/* Get a pointer to the structure holding thread-specific global data. */
+   astGET_GLOBALS(this);
+
 /* Ignore the warning if the supplied condition is not contained within
    the list of conditions to be reported in this way (given by the
    Warnings attribute). */
@@ -34208,6 +35554,10 @@ static void Warn( AstFitsChan *this, const char *condition, const char *text,
 /* If found, store the warning in the parent Channel structure. */
       astAddWarning( this, 1, "%s", method, status, text );
 
+/* Count the warnings issued, so that FrameSets read from headers that
+   generate warnings are not cached (see FsetFromCache). */
+      warn_count++;
+
 /* For historical reasons, warnings are also stored in the FitsChan as a
    set of FITS cards... First save the current card index, and rewind the
    FitsChan. */
@@ -39637,6 +40987,15 @@ static int Write( AstChannel *this_channel, AstObject *object, int *status ) {
 /* If no object was written, re-instate the original current card. */
    if( !ret ) astSetCard( this, card0 );
 
+/* If a top-level object was written using the NATIVE encoding, the cards
+   preceding the current card are complete, so write them out through the
+   sink function if required (see attribute SinkWindow). This is not done
+   for foreign encodings since subsequent writes may modify existing WCS
+   cards in place. */
+   if( ret && write_nest < 0 && encoding == NATIVE_ENCODING ) {
+      StreamCards( this, 1, status );
+   }
+
 /* Return the answer. */
    return ret;
 }
@@ -39725,6 +41084,9 @@ static void WriteBegin( AstChannel *this_channel, const char *class,
 
 /* Clear the count of items written. */
    items_written = 0;
+
+/* Write out completed cards if required (see attribute SinkWindow). */
+   StreamCards( this, 0, status );
 }
 
 static void WriteDouble( AstChannel *this_channel, const char *name,
@@ -39847,6 +41209,9 @@ static void WriteDouble( AstChannel *this_channel, const char *name,
 /* Increment the count of items written. */
       items_written++;
    }
+
+/* Write out completed cards if required (see attribute SinkWindow). */
+   StreamCards( this, 0, status );
 }
 
 static void WriteEnd( AstChannel *this_channel, const char *class, int *status ) {
@@ -39922,6 +41287,9 @@ static void WriteEnd( AstChannel *this_channel, const char *class, int *status )
 
 /* Decrement the indentation level for comments. */
    current_indent -= INDENT_INC;
+
+/* Write out completed cards if required (see attribute SinkWindow). */
+   StreamCards( this, 0, status );
 }
 
 static void WriteFits( AstFitsChan *this, int *status ){
@@ -40105,6 +41473,9 @@ static void WriteInt( AstChannel *this_channel, const char *name,
 /* Increment the count of items written. */
       items_written++;
    }
+
+/* Write out completed cards if required (see attribute SinkWindow). */
+   StreamCards( this, 0, status );
 }
 
 static void WriteIsA( AstChannel *this_channel, const char *class,
@@ -40198,6 +41569,9 @@ static void WriteIsA( AstChannel *this_channel, const char *class,
 
 /* Clear the count of items written. */
    items_written = 0;
+
+/* Write out completed cards if required (see attribute SinkWindow). */
+   StreamCards( this, 0, status );
 }
 
 static void WriteObject( AstChannel *this_channel, const char *name,
@@ -40329,6 +41703,9 @@ static void WriteObject( AstChannel *this_channel, const char *name,
 /* Increment the count of items written. */
       items_written++;
    }
+
+/* Write out completed cards if required (see attribute SinkWindow). */
+   StreamCards( this, 0, status );
 }
 
 static void WriteToSink( AstFitsChan *this, int *status ){
@@ -40668,6 +42045,9 @@ static void WriteString( AstChannel *this_channel, const char *name,
 /* Increment the count of items written. */
       items_written++;
    }
+
+/* Write out completed cards if required (see attribute SinkWindow). */
+   StreamCards( this, 0, status );
 }
 
 static AstMapping *ZPXMapping( AstFitsChan *this, FitsStore *store, char s,
@@ -42192,6 +43572,78 @@ astMAKE_GET(FitsChan,FitsRounding,int,10,((this->fitsrounding!=-1)?this->fitsrou
 astMAKE_SET(FitsChan,FitsRounding,int,fitsrounding,astMAX(0,value))
 astMAKE_TEST(FitsChan,FitsRounding,( this->fitsrounding != -1 ))
 
+/* SinkWindow. */
+/* =========== */
+
+/*
+*att++
+*  Name:
+*     SinkWindow
+
+*  Purpose:
+*     Number of new cards held before writing to the sink.
+
+*  Type:
+*     Public attribute.
+
+*  Synopsis:
+*     Integer.
+
+*  Description:
+*     This attribute allows the header cards created when an Object is
+*     written to a FitsChan
+c     (using astWrite)
+f     (using AST_WRITE)
+*     using the "NATIVE" encoding to be passed to the sink function as
+*     soon as they are complete,
+*     rather than being held in the FitsChan until the FitsChan is
+*     deleted or
+c     astWriteFits
+f     AST_WRITEFITS
+*     is called. This can reduce the memory needed when writing large
+*     Objects, or when a single FitsChan is used to generate headers for
+*     many separate images.
+*
+*     If SinkWindow is zero (the default), all cards are retained in the
+*     FitsChan until it is deleted or
+c     astWriteFits
+f     AST_WRITEFITS
+*     is called. If it is positive, then each time an Object is written
+*     successfully using the "NATIVE" encoding, all cards that precede
+*     the new current card are written out through the sink function and
+*     then removed from the FitsChan. The same thing also happens while
+*     the Object is being written, whenever more than SinkWindow cards
+*     have been added to the FitsChan since the last cards were written
+*     out. The sequence of cards sent to the sink function is the same
+*     as if SinkWindow were zero. When setting a new value, negative
+*     values are converted to zero.
+
+*  Applicability:
+*     FitsChan
+*        All FitsChans have this attribute.
+
+*  Notes:
+*     - This attribute is ignored if the FitsChan has no sink function,
+*     or if the SinkFile attribute is set.
+*     - Only the "NATIVE" encoding is supported. Cards are never
+*     written out early when using any other encoding (such as "FITS-WCS"),
+*     since a later write using such an encoding may modify or remove
+*     cards created by an earlier write (for instance, CRPIXi and CRVALi
+*     cards are over-written in place). Such cards are held in the
+*     FitsChan as if SinkWindow were zero.
+*     - Cards that have been written out to the sink function are no
+*     longer available within the FitsChan, and so cannot be read or
+*     modified using other FitsChan methods.
+*     - If an error occurs while writing an Object using the "NATIVE"
+*     encoding, any cards that have already been written out to the sink
+*     function cannot be withdrawn.
+*att--
+*/
+astMAKE_CLEAR(FitsChan,SinkWindow,sinkwindow,-1)
+astMAKE_GET(FitsChan,SinkWindow,int,0,((this->sinkwindow!=-1)?this->sinkwindow:0))
+astMAKE_SET(FitsChan,SinkWindow,int,sinkwindow,astMAX(0,value))
+astMAKE_TEST(FitsChan,SinkWindow,( this->sinkwindow != -1 ))
+
 /* AltAxes. */
 /* ======== */
 
@@ -42860,6 +44312,12 @@ static void Dump( AstObject *this_object, AstChannel *channel, int *status ) {
    ival = set ? GetFitsRounding( this, status ) : astGetFitsRounding( this );
    astWriteInt( channel, "FitsRn", set, 1, ival, "No. of digits guarded from rounding" );
 
+/* SinkWindow. */
+/* ----------- */
+   set = TestSinkWindow( this, status );
+   ival = set ? GetSinkWindow( this, status ) : astGetSinkWindow( this );
+   astWriteInt( channel, "SinkWn", set, 0, ival, "No. of new cards held before writing to sink" );
+
 /* AltAXes. */
 /* -------- */
    set = TestAltAxes( this, status );
@@ -43778,6 +45236,8 @@ AstFitsChan *astInitFitsChan_( void *mem, size_t size, int init,
       new->clean = -1;
       new->fitsdigits = AST__DBL_DIG;
       new->fitsrounding = -1;
+      new->sinkwindow = -1;
+      new->nsinkcard = 0;
       new->altaxes = INT_MAX;
       new->fitsaxisorder = NULL;
       new->encoding = UNKNOWN_ENCODING;
@@ -43996,6 +45456,12 @@ AstFitsChan *astLoadFitsChan_( void *mem, size_t size,
       new->fitsrounding = astReadInt( channel, "fitsrn", -1 );
       if ( TestFitsRounding( new, status ) ) SetFitsRounding( new, new->fitsrounding, status );
 
+/* SinkWindow. */
+/* ----------- */
+      new->sinkwindow = astReadInt( channel, "sinkwn", -1 );
+      if ( TestSinkWindow( new, status ) ) SetSinkWindow( new, new->sinkwindow, status );
+      new->nsinkcard = 0;
+
 /* DefB1950 */
 /* -------- */
       new->defb1950 = astReadInt( channel, "dfb1950", -1 );
@@ -44173,6 +45639,129 @@ AstFitsChan *astLoadFitsChan_( void *mem, size_t size,
    return new;
 }
 
+AstKeyMap *astFitsCacheStats_( int reset, int *status ){
+/*
+*++
+*  Name:
+c     astFitsCacheStats
+f     AST_FITSCACHESTATS
+
+*  Purpose:
+*     Return statistics describing the use of the FitsChan FrameSet cache.
+
+*  Type:
+*     Public function.
+
+*  Synopsis:
+c     #include "fitschan.h"
+c     AstKeyMap *astFitsCacheStats( int reset )
+f     RESULT = AST_FITSCACHESTATS( RESET, STATUS )
+
+*  Class Membership:
+*     FitsChan function.
+
+*  Description:
+*     This function returns a KeyMap describing the use of the
+*     process-wide cache of FrameSets read from FITS headers. The cache
+*     is controlled by the FitsCache tuning parameter (see
+c     astTune).
+f     AST_TUNE).
+*     If this is non-zero, FrameSets read from a FitsChan using any
+*     encoding other than NATIVE are retained in the cache, and a copy
+*     of a cached FrameSet is returned by any subsequent read
+*     that uses identical WCS-related keyword values and FitsChan
+*     attribute values. The returned KeyMap contains the following
+*     integer entries:
+*
+*     - "Size": The maximum number of FrameSets that may be retained
+*     (the value of the FitsCache tuning parameter).
+*     - "Nentry": The number of FrameSets currently retained.
+*     - "Hits": The number of reads that returned a copy of a cached
+*     FrameSet.
+*     - "Misses": The number of reads for which no cached FrameSet was
+*     found.
+*     - "Bypassed": The number of reads that could not use the cache
+*     because the FrameSet depends on more than just the WCS-related
+*     keyword values (for instance, because it uses the -TAB algorithm).
+*     - "Evictions": The number of FrameSets that have been removed from
+*     the cache to make room for others, or as a result of the cache
+*     size being reduced.
+*
+*     Reads that cause warnings to be issued (see the Warnings
+*     attribute) are included in the "Misses" value, but their FrameSets
+*     are not retained in the cache.
+
+*  Parameters:
+c     reset
+f     RESET = LOGICAL (Given)
+c        If non-zero,
+f        If .TRUE.,
+*        the "Hits", "Misses", "Bypassed" and "Evictions"
+*        counters are reset to zero after their values have been
+*        stored in the returned KeyMap.
+f     STATUS = INTEGER (Given and Returned)
+f        The global status.
+
+*  Returned Value:
+c     astFitsCacheStats()
+f     AST_FITSCACHESTATS = INTEGER
+*        A pointer to a new KeyMap holding the statistics. The KeyMap
+*        pointer should be annulled when it is no longer needed. The
+*        counters are stored as 64 bit integers, and so should be
+*        accessed using the KeyMap "K" data type (e.g. using
+c        function astMapGet0K).
+f        routine AST_MAPGET0K).
+
+*  Notes:
+*     - The statistics are shared by all threads.
+*     - A null Object pointer (AST__NULL) is returned if this function is invoked with the
+*     AST error status set, or if it should fail for any reason.
+*--
+*/
+
+/* Local Variables: */
+   AstKeyMap *result;
+   int64_t stats[ 6 ];
+
+/* Check the global error status. */
+   if( !astOK ) return NULL;
+
+/* Get the maximum cache size from the FitsCache tuning parameter, since
+   the FitsChan class may not yet have been told its value (see
+   SetFitsCacheSize). */
+   stats[ 0 ] = astTune( "FitsCache", AST__TUNULL );
+
+/* Take a copy of the statistics, resetting the counters if required. */
+   LOCK_MUTEX5
+   stats[ 1 ] = fitscache_n;
+   stats[ 2 ] = fitscache_hits;
+   stats[ 3 ] = fitscache_misses;
+   stats[ 4 ] = fitscache_bypass;
+   stats[ 5 ] = fitscache_evict;
+   if( reset ) {
+      fitscache_hits = 0;
+      fitscache_misses = 0;
+      fitscache_bypass = 0;
+      fitscache_evict = 0;
+   }
+   UNLOCK_MUTEX5
+
+/* Store them in a new KeyMap. */
+   result = astKeyMap( " ", status );
+   astMapPut0K( result, "Size", stats[ 0 ], NULL );
+   astMapPut0K( result, "Nentry", stats[ 1 ], NULL );
+   astMapPut0K( result, "Hits", stats[ 2 ], NULL );
+   astMapPut0K( result, "Misses", stats[ 3 ], NULL );
+   astMapPut0K( result, "Bypassed", stats[ 4 ], NULL );
+   astMapPut0K( result, "Evictions", stats[ 5 ], NULL );
+
+/* Annul the returned KeyMap if an error occurred. */
+   if( !astOK ) result = astAnnul( result );
+
+/* Return the KeyMap. */
+   return result;
+}
+
 /* Virtual function interfaces. */
 /* ============================ */
 
@@ -44205,6 +45794,11 @@ void astShowFits_( AstFitsChan *this, int *status ){
    (**astMEMBER(this,FitsChan,ShowFits))(this, status );
 }
 
+int astPutBlock_( AstFitsChan *this, const char *block, int nc, int *status ){
+   if( !astOK ) return 0;
+   return (**astMEMBER(this,FitsChan,PutBlock))(this,block,nc,status);
+}
+
 void astPutCards_( AstFitsChan *this, const char *cards, int *status ){
    if( !astOK ) return;
    (**astMEMBER(this,FitsChan,PutCards))(this,cards, status );
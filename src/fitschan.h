@@ -192,6 +192,8 @@ typedef struct AstFitsChan {
    int altaxes;     /* Controls creation of FITS-WCS alternate axes */
    int fitsdigits;  /* No. of decmial places in formatted floating point keyword values */
    int fitsrounding;  /* No. of decmial places guarded against rounding in formatted floating point keyword values */
+   int sinkwindow;  /* Max. no. of new cards held before writing to the sink */
+   int nsinkcard;   /* No. of cards added since last written to the sink */
    char *fitsaxisorder; /* Pointer to a string defining WCS axis order */
    char *warnings;  /* Pointer to a string containing warning conditions */
    void *card;      /* Pointer to next FitsCard to be read */
@@ -256,6 +258,7 @@ typedef struct AstFitsChanVtab {
    void (* EmptyFits)( AstFitsChan *, int * );
    void (* ShowFits)( AstFitsChan *, int * );
    void (* PurgeWCS)( AstFitsChan *, int * );
+   int (* PutBlock)( AstFitsChan *, const char *, int, int * );
    void (* PutCards)( AstFitsChan *, const char *, int * );
    void (* PutFits)( AstFitsChan *, const char [81], int, int * );
    void (* PutTable)( AstFitsChan *, struct AstFitsTable *, const char *, int * );
@@ -289,6 +292,11 @@ typedef struct AstFitsChanVtab {
    void (* SetFitsRounding)( AstFitsChan *, int, int * );
    void (* ClearFitsRounding)( AstFitsChan *, int * );
 
+   int (* GetSinkWindow)( AstFitsChan *, int * );
+   int (* TestSinkWindow)( AstFitsChan *, int * );
+   void (* SetSinkWindow)( AstFitsChan *, int, int * );
+   void (* ClearSinkWindow)( AstFitsChan *, int * );
+
    int (* GetAltAxes)( AstFitsChan *, int * );
    int (* TestAltAxes)( AstFitsChan *, int * );
    void (* SetAltAxes)( AstFitsChan *, int, int * );
@@ -421,6 +429,7 @@ typedef struct AstFitsChanGlobals {
    int Match_NB;
    int Match_Nentry;
    char WcsCelestial_Type[ 4 ];
+   int Warn_Count;
 } AstFitsChanGlobals;
 
 #endif
@@ -475,6 +484,8 @@ void astInitFitsChanGlobals_( AstFitsChanGlobals * );
 
 #endif
 
+AstKeyMap *astFitsCacheStats_( int, int * );
+
 /* Prototypes for member functions. */
 /* -------------------------------- */
    AstKeyMap *astGetTables_( AstFitsChan *, int * );
@@ -494,6 +505,7 @@ void astInitFitsChanGlobals_( AstFitsChanGlobals * );
    void astEmptyFits_( AstFitsChan *, int * );
    void astShowFits_( AstFitsChan *, int * );
    void astPurgeWCS_( AstFitsChan *, int * );
+   int astPutBlock_( AstFitsChan *, const char *, int, int * );
    void astPutCards_( AstFitsChan *, const char *, int * );
    void astPutFits_( AstFitsChan *, const char [81], int, int * );
    void astPutTable_( AstFitsChan *, struct AstFitsTable *, const char *, int * );
@@ -610,6 +622,11 @@ void astInitFitsChanGlobals_( AstFitsChanGlobals * );
    void astSetFitsRounding_( AstFitsChan *, int, int * );
    void astClearFitsRounding_( AstFitsChan *, int * );
 
+   int astGetSinkWindow_( AstFitsChan *, int * );
+   int astTestSinkWindow_( AstFitsChan *, int * );
+   void astSetSinkWindow_( AstFitsChan *, int, int * );
+   void astClearSinkWindow_( AstFitsChan *, int * );
+
    int astGetAltAxes_( AstFitsChan *, int * );
    int astTestAltAxes_( AstFitsChan *, int * );
    void astSetAltAxes_( AstFitsChan *, int, int * );
@@ -681,8 +698,11 @@ astINVOKE(O,astInitFitsChan_(mem,size,init,vtab,name,source,sourcewrap,sink,sink
 /* Loader. */
 #define astLoadFitsChan(mem,size,vtab,name,channel) \
 astINVOKE(O,astLoadFitsChan_(mem,size,vtab,name,astCheckChannel(channel),STATUS_PTR))
+
 #endif
 
+#define astFitsCacheStats(reset) astINVOKE(O,astFitsCacheStats_(reset,STATUS_PTR))
+
 
 /* More include files. */
 /* =================== */
@@ -708,6 +728,9 @@ astINVOKE(V,astPutFits_(astCheckFitsChan(this),card,overwrite,STATUS_PTR))
 #define astPutCards(this,cards) \
 astINVOKE(V,astPutCards_(astCheckFitsChan(this),cards,STATUS_PTR))
 
+#define astPutBlock(this,block,nc) \
+astINVOKE(V,astPutBlock_(astCheckFitsChan(this),block,nc,STATUS_PTR))
+
 #define astDelFits(this) \
 astINVOKE(V,astDelFits_(astCheckFitsChan(this),STATUS_PTR))
 
@@ -953,6 +976,15 @@ astINVOKE(V,astSetFitsRounding_(astCheckFitsChan(this),fitsrounding,STATUS_PTR))
 #define astTestFitsRounding(this) \
 astINVOKE(V,astTestFitsRounding_(astCheckFitsChan(this),STATUS_PTR))
 
+#define astClearSinkWindow(this) \
+astINVOKE(V,astClearSinkWindow_(astCheckFitsChan(this),STATUS_PTR))
+#define astGetSinkWindow(this) \
+astINVOKE(V,astGetSinkWindow_(astCheckFitsChan(this),STATUS_PTR))
+#define astSetSinkWindow(this,sinkwindow) \
+astINVOKE(V,astSetSinkWindow_(astCheckFitsChan(this),sinkwindow,STATUS_PTR))
+#define astTestSinkWindow(this) \
+astINVOKE(V,astTestSinkWindow_(astCheckFitsChan(this),STATUS_PTR))
+
 #define astClearAltAxes(this) \
 astINVOKE(V,astClearAltAxes_(astCheckFitsChan(this),STATUS_PTR))
 #define astGetAltAxes(this) \
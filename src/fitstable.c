@@ -1384,6 +1384,7 @@ f     AST_COLUMNNULLK functiom.
 
 /* Local Variables: */
    char *cbuf;       /* Array of strings returned by astMapGet1C */
+   char *valid;      /* Flags indicating which rows have values */
    char key[ AST__MXCOLKEYLEN + 1 ]; /* Current cell key string */
    int iel;          /* Index of current element */
    int irow;         /* Index of value being copied */
@@ -1470,37 +1471,33 @@ f     AST_COLUMNNULLK functiom.
    small to hold all rows. */
    if( mxsize < nbv*nrow ) nrow = mxsize/nbv;
 
-/* Loop round the returned rows rows. */
-   for( irow = 1; irow <= nrow; irow++ ) {
-
-/* Format the cell name. */
-      (void) MakeKey( column, irow, key, AST__MXCOLKEYLEN + 1,
-                      status );
-
-/* Get the values in the current cell of the column, using its native
-   data type. For floating point, convert any NaNs into the appropriate
-   null value (do not need to do this if the null value is itself NaN). */
-      if( type == AST__INTTYPE ) {
-         ok = astMapGet1I( this, key, nel, &nval, pout );
+/* Numerical columns can be copied into the returned array in a single
+   operation. This leaves rows with no value unchanged, and returns a
+   flag for each row indicating if it has a value. */
+   if( type != AST__STRINGTYPE ) {
+      valid = astMalloc( nrow*sizeof( char ) );
+      nrow = astGetColumn( this, column, mxsize, coldata, valid );
+   } else {
+      valid = NULL;
+   }
 
-      } else if( type == AST__KINTTYPE ) {
-         ok = astMapGet1K( this, key, nel, &nval, pout );
+/* Loop round the returned rows rows. */
+   for( irow = 1; irow <= nrow && astOK; irow++ ) {
 
-      } else if(  type == AST__DOUBLETYPE ){
-         ok = astMapGet1D( this, key, nel, &nval, pout );
+/* For numerical columns, the values have already been copied. For
+   floating point, convert any NaNs into the appropriate null value (do
+   not need to do this if the null value is itself NaN). */
+      if( valid ) {
+         ok = valid[ irow - 1 ];
 
-         if( ok && astISFINITE(dnull) ) {
+         if( ok && type == AST__DOUBLETYPE && astISFINITE(dnull) ) {
             for( iel = 0; iel < nel; iel++ ) {
                if( !astISFINITE( ((double *)pout)[ iel ] ) ) {
                   ((double *)pout)[ iel ] = dnull;
                }
             }
-         }
 
-      } else if(  type == AST__FLOATTYPE ){
-         ok = astMapGet1F( this, key, nel, &nval, pout );
-
-         if( ok && astISFINITE(fnull) ) {
+         } else if( ok && type == AST__FLOATTYPE && astISFINITE(fnull) ) {
             for( iel = 0; iel < nel; iel++ ) {
                if( !astISFINITE( ((float *)pout)[ iel ] ) ) {
                   ((float *)pout)[ iel ] = fnull;
@@ -1508,13 +1505,12 @@ f     AST_COLUMNNULLK functiom.
             }
          }
 
-      } else if(  type == AST__SINTTYPE ){
-         ok = astMapGet1S( this, key, nel, &nval, pout );
-
-      } else if(  type == AST__BYTETYPE ){
-         ok = astMapGet1B( this, key, nel, &nval, pout );
-
+/* For string columns, get the values in the current cell of the column. */
       } else if(  type == AST__STRINGTYPE ){
+
+/* Format the cell name. */
+         (void) MakeKey( column, irow, key, AST__MXCOLKEYLEN + 1,
+                         status );
          ok = astMapGet1C( this, key, nb + 1, nel, &nval, cbuf );
 
 /* Copy the strings returned by astMapGet1C into the returned array,
@@ -1578,6 +1574,7 @@ f     AST_COLUMNNULLK functiom.
 /* Free resources. */
    cbuf = astFree( cbuf );
    pnull = astFree( pnull );
+   valid = astFree( valid );
 
 /* Return the number of returned elements. */
    *nelem = nel*nrow;
@@ -2106,12 +2103,19 @@ f        An
 f     STATUS = INTEGER (Given and Returned)
 f        The global status.
 
+*  Notes:
+*     - If the column holds floating point values, any cell for which
+*     every element of the supplied value is NaN is left holding a null
+*     value (i.e. any existing value in the cell is removed). Prior to
+*     AST version 9.2.13, the existing value was left unchanged.
+
 *--
 */
 
 /* Local Variables: */
    char key[ AST__MXCOLKEYLEN + 1 ]; /* Current cell key string */
    char **carray;    /* Pointer to array of null terminated string pointers */
+   char *valid;      /* Flags indicating which rows have values */
    int irow;         /* Index of value being copied */
    int iel;          /* Index of current element */
    int nel;          /* No. of elements per value */
@@ -2180,57 +2184,50 @@ f        The global status.
                 (int) size, (int) nbv );
    }
 
-/* Loop round the rows to be copied. */
-   for( irow = 1; irow <= nrow; irow++ ) {
-
-/* Format the cell name. */
-      (void) MakeKey( column, irow, key, AST__MXCOLKEYLEN + 1,
-                      status );
-
-/* Put the next value into the current cell of the column, using its native
-   data type. Skip floating point values that are entirely NaN. */
-      if( type == AST__INTTYPE ) {
-         astMapPut1I( this, key, nel, pin, NULL );
-
-      } else if( type == AST__KINTTYPE ) {
-         astMapPut1K( this, key, nel, pin, NULL );
-
-      } else if(  type == AST__DOUBLETYPE ){
-         for( iel = 0; iel < nel; iel++ ) {
-            if( astISFINITE( ((double *)pin)[ iel ] ) ) {
-               astMapPut1D( this, key, nel, pin, NULL );
-               break;
-            }
-         }
-
-      } else if(  type == AST__FLOATTYPE ){
-         for( iel = 0; iel < nel; iel++ ) {
-            if( astISFINITE( ((double *)pin)[ iel ] ) ) {
-               astMapPut1F( this, key, nel, pin, NULL );
-               break;
+/* Numerical columns can be stored in a single operation. Floating point
+   values that are entirely NaN are null, so flag them as invalid. This
+   causes any existing value in the cell to be removed. */
+   if( type != AST__STRINGTYPE ) {
+      valid = NULL;
+      if( type == AST__DOUBLETYPE || type == AST__FLOATTYPE ) {
+         valid = astMalloc( nrow*sizeof( char ) );
+         if( astOK ) {
+            for( irow = 0; irow < nrow; irow++ ) {
+               valid[ irow ] = 0;
+               for( iel = 0; iel < nel; iel++ ) {
+                  if( type == AST__DOUBLETYPE ?
+                      astISFINITE( ((double *)pin)[ iel ] ) :
+                      astISFINITE( ((float *)pin)[ iel ] ) ) {
+                     valid[ irow ] = 1;
+                     break;
+                  }
+               }
+               pin = (char*)pin + nbv;
             }
          }
+      }
 
-      } else if(  type == AST__SINTTYPE ){
-         astMapPut1S( this, key, nel, pin, NULL );
-
-      } else if(  type == AST__BYTETYPE ){
-         astMapPut1B( this, key, nel, pin, NULL );
+      astPutColumn( this, column, nrow, coldata, valid );
+      valid = astFree( valid );
 
 /* If each cell in the column holds an array of strings, we need to
    convert the fixed length strings in the supplied array into an array
    of pointers to null terminated strings. */
-      } else if(  type == AST__STRINGTYPE ){
+   } else {
+      for( irow = 1; irow <= nrow; irow++ ) {
+         (void) MakeKey( column, irow, key, AST__MXCOLKEYLEN + 1,
+                         status );
          carray = astStringArray( pin, nel, clen );
          astMapPut1C( this, key, nel, (const char ** ) carray, NULL );
          carray = astFree( carray );
-      }
 
 /* Increment the pointer to the next input value. */
-      pin = (char*)pin + nbv;
+         pin = (char*)pin + nbv;
+      }
    }
 
 /* Remove any remaining cells already present in this column. */
+   irow = nrow + 1;
    nrow = astGetNrow( this );
    for( ; irow <= nrow; irow++ ) {
       (void) MakeKey( column, irow, key, AST__MXCOLKEYLEN + 1,
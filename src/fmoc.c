@@ -96,6 +96,27 @@ F77_SUBROUTINE(ast_addmocdata)( INTEGER(THIS),
    )
 }
 
+F77_SUBROUTINE(ast_addmocranges)( INTEGER(THIS),
+                                  INTEGER(CMODE),
+                                  LOGICAL(NEGATE),
+                                  INTEGER(ORDER),
+                                  INTEGER(NRANGE),
+                                  INTEGER8_ARRAY(RANGES),
+                                  INTEGER(STATUS) ) {
+   GENPTR_INTEGER(THIS)
+   GENPTR_INTEGER(CMODE)
+   GENPTR_LOGICAL(NEGATE)
+   GENPTR_INTEGER(ORDER)
+   GENPTR_INTEGER(NRANGE)
+   GENPTR_INTEGER8_ARRAY(RANGES)
+
+   astAt( "AST_ADDMOCRANGES", NULL, 0 );
+   astWatchSTATUS(
+      astAddMocRanges( astI2P( *THIS ), *CMODE, F77_ISTRUE( *NEGATE ),
+                       *ORDER, *NRANGE, (const int64_t *) RANGES );
+   )
+}
+
 F77_SUBROUTINE(ast_addmocstring)( INTEGER(THIS),
                                   INTEGER(CMODE),
                                   LOGICAL(NEGATE),
@@ -214,6 +235,23 @@ F77_SUBROUTINE(ast_getmocdata)( INTEGER(THIS),
    )
 }
 
+F77_SUBROUTINE(ast_getmocranges)( INTEGER(THIS),
+                                  INTEGER(MXRANGE),
+                                  INTEGER(NRANGE),
+                                  INTEGER8_ARRAY(RANGES),
+                                  INTEGER(STATUS) ) {
+   GENPTR_INTEGER(THIS)
+   GENPTR_INTEGER(MXRANGE)
+   GENPTR_INTEGER(NRANGE)
+   GENPTR_INTEGER8_ARRAY(RANGES)
+
+   astAt( "AST_GETMOCRANGES", NULL, 0 );
+   astWatchSTATUS(
+      astGetMocRanges( astI2P( *THIS ), *MXRANGE, NRANGE,
+                       (int64_t *) RANGES );
+   )
+}
+
 F77_INTEGER_FUNCTION(ast_getmocheader)( INTEGER(THIS),
                                         INTEGER(STATUS) ) {
    GENPTR_INTEGER(THIS)
@@ -865,6 +865,9 @@ static char getallvariants_buff[ AST__FRAMESET_GETALLVARIANTS_BUFF_LEN + 1 ];
 /* ======================================== */
 static AstAxis *GetAxis( AstFrame *, int, int * );
 static AstFrame *GetFrame( AstFrameSet *, int, int * );
+static AstFrame *NodeFrame( AstFrameSet *, AstFrame **, int, int * );
+static size_t SpanSize( AstChannelSpan *, int * );
+static void FreeSpans( AstFrameSet *, int * );
 static AstFrame *PickAxes( AstFrame *, int, const int[], AstMapping **, int * );
 static AstFrameSet *Convert( AstFrame *, AstFrame *, const char *, int * );
 static AstFrameSet *ConvertX( AstFrame *, AstFrame *, const char *, int * );
@@ -1015,6 +1018,9 @@ static void SetSymbol( AstFrame *, int, const char *, int * );
 static void SetTitle( AstFrame *, const char *, int * );
 static void SetUnit( AstFrame *, int, const char *, int * );
 static void TidyNodes( AstFrameSet *, int * );
+static void UnpackAll( AstFrameSet *, int * );
+static AstFrame *UnpackFrame( AstFrameSet *, int, int * );
+static AstMapping *UnpackMapping( AstFrameSet *, int, int * );
 static void VSet( AstObject *, const char *, char **, va_list, int * );
 static void ValidateAxisSelection( AstFrame *, int, const int *, const char *, int * );
 
@@ -1331,6 +1337,10 @@ f     AST_SIMPLIFY
 /* Check the global error status. */
    if ( !astOK ) return;
 
+/* Ensure all Frames and Mappings in the FrameSet have been created, since
+   the arrays holding them are about to be extended. */
+   UnpackAll( this, status );
+
 /* First handle cases where we are appending axes to the existing
    Frames in a FrameSet. */
    if( iframe == AST__ALLFRAMES ) {
@@ -1464,6 +1474,7 @@ f     AST_SIMPLIFY
    references and calculate how many Frames and nodes the combined
    FrameSet will contain. */
       frameset = (AstFrameSet *) frame;
+      UnpackAll( frameset, status );
       nframe = this->nframe + frameset->nframe;
       nnode = this->nnode + frameset->nnode;
 
@@ -3653,7 +3664,8 @@ static int Equal( AstObject *this_object, AstObject *that_object, int *status )
 /* Check the Frames and nodes are equal. */
           result = 1;
           for ( i = 0; i < this->nframe; i++ ) {
-             if( !astEqual( this->frame[ i ], that->frame[ i ] ) ||
+             if( !astEqual( UnpackFrame( this, i, status ),
+                            UnpackFrame( that, i, status ) ) ||
                  this->node[ i ] != that->node[ i ] ){
                 result = 0;
                 break;
@@ -3663,7 +3675,8 @@ static int Equal( AstObject *this_object, AstObject *that_object, int *status )
 /* Check the Mappings, links and invert flags are equal. */
          if( result ) {
             for ( i = 0; i < this->nnode - 1; i++ ) {
-               if( !astEqual( this->map[ i ], that->map[ i ] ) ||
+               if( !astEqual( UnpackMapping( this, i, status ),
+                              UnpackMapping( that, i, status ) ) ||
                    this->link[ i ] != that->link[ i ] ||
                    this->invert[ i ] != that->invert[ i ] ) {
                   result = 0;
@@ -4344,7 +4357,7 @@ static int ForceCopy( AstFrameSet *this, int iframe, int *status ) {
 
 /* If OK, obtain the corresponding Frame pointer (don't clone it). */
    if ( astOK ) {
-      frame = this->frame[ iframe - 1 ];
+      frame = UnpackFrame( this, iframe - 1, status );
 
 /* Loop to inspect each Frame in the FrameSet. */
       for ( ifr = 1; ifr <= this->nframe; ifr++ ) {
@@ -4454,6 +4467,61 @@ static const char *Format( AstFrame *this_frame, int axis, double value, int *st
    return result;
 }
 
+static void FreeSpans( AstFrameSet *this, int *status ) {
+/*
+*  Name:
+*     FreeSpans
+
+*  Purpose:
+*     Free the serialised forms of any Frames and Mappings in a FrameSet.
+
+*  Type:
+*     Private function.
+
+*  Synopsis:
+*     #include "frameset.h"
+*     void FreeSpans( AstFrameSet *this, int *status )
+
+*  Class Membership:
+*     FrameSet member function.
+
+*  Description:
+*     This function frees the serialised forms of any Frames and Mappings
+*     that have not yet been created (see UnpackAll), together with the
+*     arrays holding them.
+
+*  Parameters:
+*     this
+*        Pointer to the FrameSet.
+*     status
+*        Pointer to the inherited status variable.
+
+*  Notes:
+*     - This function attempts to execute even if the global error
+*     status is set.
+*/
+
+/* Local Variables: */
+   int iframe;                   /* Loop counter for Frames */
+   int inode;                    /* Loop counter for nodes */
+
+/* Free the Frames. */
+   if ( this->frmspan ) {
+      for ( iframe = 0; iframe < this->nframe; iframe++ ) {
+         this->frmspan[ iframe ] = astFreeSpan( this->frmspan[ iframe ] );
+      }
+      this->frmspan = astFree( this->frmspan );
+   }
+
+/* Free the Mappings. */
+   if ( this->mapspan ) {
+      for ( inode = 0; inode < this->nnode - 1; inode++ ) {
+         this->mapspan[ inode ] = astFreeSpan( this->mapspan[ inode ] );
+      }
+      this->mapspan = astFree( this->mapspan );
+   }
+}
+
 static double Gap( AstFrame *this_frame, int axis, double gap, int *ntick, int *status ) {
 /*
 *  Name:
@@ -4622,7 +4690,7 @@ static int GetNode( AstFrameSet *this, int inode, int *nnodes,
 /* Get the Mapping - if any - associated with the node. The root node -
    node zero - has no mapping or parent node. */
       if( inode > 0 ) {
-         *map = astCopy( this->map[ inode - 1 ] );
+         *map = astCopy( UnpackMapping( this, inode - 1, status ) );
          if( astGetInvert( *map ) !=  this->invert[ inode - 1 ] ) {
             astSetInvert( *map,  this->invert[ inode - 1 ] );
          }
@@ -4697,12 +4765,21 @@ static size_t GetObjSize( AstObject *this_object, int *status ) {
 
    for ( iframe = 0; iframe < this->nframe; iframe++ ) {
       result += astGetObjSize( this->frame[ iframe ] );
+      if ( this->frmspan && this->frmspan[ iframe ] ) {
+         result += SpanSize( this->frmspan[ iframe ], status );
+      }
    }
 
    for ( inode = 0; inode < this->nnode - 1; inode++ ) {
       result += astGetObjSize( this->map[ inode ] );
+      if ( this->mapspan && this->mapspan[ inode ] ) {
+         result += SpanSize( this->mapspan[ inode ], status );
+      }
    }
 
+   result += astTSizeOf( this->frmspan );
+   result += astTSizeOf( this->mapspan );
+
    result += astTSizeOf( this->frame );
    result += astTSizeOf( this->varfrm );
    result += astTSizeOf( this->node );
@@ -5226,7 +5303,7 @@ f     function is invoked with STATUS set to an error value, or if it
    iframe = astValidateFrameIndex( this, iframe, "astGetFrame" );
 
 /* If OK, clone a pointer to the requested Frame. */
-   if ( astOK ) result = astClone( this->frame[ iframe - 1 ] );
+   if ( astOK ) result = astClone( UnpackFrame( this, iframe - 1, status ) );
 
 /* Return the result. */
    return result;
@@ -7574,6 +7651,70 @@ f     AST_ADDVARIANT
    }
 }
 
+static AstFrame *NodeFrame( AstFrameSet *this, AstFrame **frames, int inode,
+                            int *status ) {
+/*
+*  Name:
+*     NodeFrame
+
+*  Purpose:
+*     Return the Frame associated with a FrameSet node.
+
+*  Type:
+*     Private function.
+
+*  Synopsis:
+*     #include "frameset.h"
+*     AstFrame *NodeFrame( AstFrameSet *this, AstFrame **frames, int inode,
+*                          int *status )
+
+*  Class Membership:
+*     FrameSet member function.
+
+*  Description:
+*     This function returns the element of a node-indexed array of Frame
+*     pointers (as used by Span) for a specified node. If the element is
+*     NULL but the FrameSet still holds the node's Frame in serialised
+*     form (see UnpackAll), the Frame is first created and stored in the
+*     array.
+
+*  Parameters:
+*     this
+*        Pointer to the FrameSet.
+*     frames
+*        Array of Frame pointers indexed by node index.
+*     inode
+*        The node index.
+*     status
+*        Pointer to the inherited status variable.
+
+*  Returned Value:
+*     A pointer to the Frame, or NULL if the node has no Frame. This is
+*     not cloned and so should not be annulled.
+*/
+
+/* Local Variables: */
+   int iframe;                   /* Loop counter for Frames */
+
+/* Check the global error status. */
+   if ( !astOK ) return NULL;
+
+/* If required, find the last Frame associated with the node (this is
+   the one that would have been stored in the "frames" array had it
+   been created) and create it. */
+   if ( !frames[ inode ] && this->frmspan ) {
+      for ( iframe = this->nframe - 1; iframe >= 0; iframe-- ) {
+         if ( this->node[ iframe ] == inode ) {
+            frames[ inode ] = UnpackFrame( this, iframe, status );
+            break;
+         }
+      }
+   }
+
+/* Return the Frame pointer. */
+   return frames[ inode ];
+}
+
 static void Norm( AstFrame *this_frame, double value[], int *status ) {
 /*
 *  Name:
@@ -8577,6 +8718,10 @@ f     (AST_REMOVEFRAME).
 /* Check the global error status. */
    if ( !astOK ) return;
 
+/* Ensure all Frames and Mappings have been created, since a new node is
+   to be added. */
+   UnpackAll( this, status );
+
 /* Validate and translate the Frame index supplied. */
    iframe = astValidateFrameIndex( this, iframe, "astRemapFrame" );
 
@@ -8740,6 +8885,10 @@ f     IFRAME argument to specify the base Frame or the current
 /* Check the global error status. */
    if ( !astOK ) return;
 
+/* Ensure all Frames and Mappings have been created, since the arrays
+   holding them are to be re-ordered. */
+   UnpackAll( this, status );
+
 /* Validate and translate the Frame index supplied. */
    iframe = astValidateFrameIndex( this, iframe, "astRemoveFrame" );
    if ( astOK ) {
@@ -8947,8 +9096,10 @@ static AstMapping *RemoveRegions( AstMapping *this_mapping, int *status ) {
 /* Check the global error status. */
    if ( !astOK ) return result;
 
-/* Get a pointer to the FrameSet. */
+/* Get a pointer to the FrameSet, and ensure all its Frames and Mappings
+   have been created. */
    this = (AstFrameSet *) this_mapping;
+   UnpackAll( this, status );
 
 /* Allocate arrays to hold the modified Mapping and Frame pointers. */
    newmaps = astMalloc( sizeof( AstMapping *)*( this->nnode - 1 ) );
@@ -10036,7 +10187,7 @@ static void SetVariant( AstFrameSet *this, const char *variant, int *status ) {
                   inode = this->node[ icur - 1 ];
 
 /* Get the Mapping that generates the node values, and its Invert flag. */
-                  map0 = this->map[ inode - 1 ];
+                  map0 = UnpackMapping( this, inode - 1, status );
                   inv0 = this->invert[ inode - 1 ];
 
 /* Temporarily reset the invert flag in the Mapping to account for any
@@ -10173,6 +10324,7 @@ static AstMapping *Simplify( AstMapping *this_mapping, int *status ) {
 /* Make a copy of the FrameSet, since we may alter it (this is a deep
    copy, which is a minor limitation of the current implementation). */
    new = astCopy( this );
+   UnpackAll( new, status );
 
 /* Loop to examine each of the Mappings between the Frames in the
    copy. */
@@ -10372,7 +10524,7 @@ static int Span( AstFrameSet *this, AstFrame **frames, int inode1, int inode2,
    UnitMap, add the Frame as the first Mapping into the returned list. The
    "forward" value is irrelevant since the forward and inverse transformations
    of Frames are the same. */
-      frame = frames[ inode1 ];
+      frame = NodeFrame( this, frames, inode1, status );
       if( frame ) {
          if( !astIsUnitFrame( frame ) ) {
             result++;
@@ -10412,7 +10564,7 @@ static int Span( AstFrameSet *this, AstFrame **frames, int inode1, int inode2,
    UnitMap. Note the number of slots to be reserved for node1 when we call
    Span recursively below. */
                nextra = 1;
-               frame = frames[ inode1 ];
+               frame = NodeFrame( this, frames, inode1, status );
                if( frame && !astIsUnitFrame( frame ) ) nextra = 2;
 
 /* Invoke this function recursively to try and find a path from inode
@@ -10430,9 +10582,10 @@ static int Span( AstFrameSet *this, AstFrame **frames, int inode1, int inode2,
                if ( result ) {
                   result++;
                   nextra--;
-                  map[ nextra ] = this->map[ ( fwd ? inode : inode1 ) - 1 ];
+                  map[ nextra ] = UnpackMapping( this, ( fwd ? inode : inode1 ) - 1,
+                                                 status );
                   forward[ nextra ] = fwd;
-                  if( frm ) frm[ nextra ] = frames[ inode ];
+                  if( frm ) frm[ nextra ] = NodeFrame( this, frames, inode, status );
 
 /* Obtain the original value of the Invert attribute for the Mapping
    between nodes inode1 and inode (recorded when the Mapping was first
@@ -10471,6 +10624,48 @@ static int Span( AstFrameSet *this, AstFrame **frames, int inode1, int inode2,
    return result;
 }
 
+static size_t SpanSize( AstChannelSpan *span, int *status ) {
+/*
+*  Name:
+*     SpanSize
+
+*  Purpose:
+*     Return the memory used by the serialised form of an Object.
+
+*  Type:
+*     Private function.
+
+*  Synopsis:
+*     #include "frameset.h"
+*     size_t SpanSize( AstChannelSpan *span, int *status )
+
+*  Class Membership:
+*     FrameSet member function.
+
+*  Description:
+*     This function returns the number of bytes of memory used to hold
+*     the serialised form of a Frame or Mapping that has not yet been
+*     created (see UnpackAll).
+
+*  Parameters:
+*     span
+*        Pointer to the structure holding the serialised form.
+*     status
+*        Pointer to the inherited status variable.
+
+*  Returned Value:
+*     The number of bytes used.
+*/
+
+/* Check the global error status. */
+   if ( !astOK ) return 0;
+
+/* Sum the sizes of the structure, the serialised data and the class
+   name. */
+   return astTSizeOf( span ) + astTSizeOf( span->data ) +
+          astTSizeOf( span->class );
+}
+
 static int SubFrame( AstFrame *this_frame, AstFrame *template,
                      int result_naxes,
                      const int *target_axes, const int *template_axes,
@@ -11453,6 +11648,175 @@ static int Unformat( AstFrame *this_frame, int axis, const char *string,
    return nc;
 }
 
+static void UnpackAll( AstFrameSet *this, int *status ) {
+/*
+*  Name:
+*     UnpackAll
+
+*  Purpose:
+*     Create all Frames and Mappings not yet read from a FrameSet's input.
+
+*  Type:
+*     Private function.
+
+*  Synopsis:
+*     #include "frameset.h"
+*     void UnpackAll( AstFrameSet *this, int *status )
+
+*  Class Membership:
+*     FrameSet member function.
+
+*  Description:
+*     If the FrameSet was read from a Channel with the Lazy attribute
+*     set, some of its Frames and Mappings may still be held in
+*     serialised form. This function creates all such Objects and then
+*     frees the arrays used to hold the serialised forms, so that the
+*     FrameSet can subsequently be modified or inspected in the usual
+*     way. It should be invoked by any function that accesses all the
+*     Frames or Mappings in a FrameSet, or that changes the number of
+*     Frames or nodes.
+
+*  Parameters:
+*     this
+*        Pointer to the FrameSet.
+*     status
+*        Pointer to the inherited status variable.
+*/
+
+/* Local Variables: */
+   int iframe;                   /* Loop counter for Frames */
+   int inode;                    /* Loop counter for nodes */
+
+/* Check the global error status. Also return if there is nothing
+   left to create. */
+   if ( !astOK || ( !this->frmspan && !this->mapspan ) ) return;
+
+/* Create each remaining Frame and Mapping. */
+   for ( iframe = 0; iframe < this->nframe && astOK; iframe++ ) {
+      (void) UnpackFrame( this, iframe, status );
+   }
+   for ( inode = 0; inode < this->nnode - 1 && astOK; inode++ ) {
+      (void) UnpackMapping( this, inode, status );
+   }
+
+/* If all were created successfully, free the arrays. */
+   if ( astOK ) {
+      this->frmspan = astFree( this->frmspan );
+      this->mapspan = astFree( this->mapspan );
+   }
+}
+
+static AstFrame *UnpackFrame( AstFrameSet *this, int iframe, int *status ) {
+/*
+*  Name:
+*     UnpackFrame
+
+*  Purpose:
+*     Ensure a Frame in a FrameSet has been created.
+
+*  Type:
+*     Private function.
+
+*  Synopsis:
+*     #include "frameset.h"
+*     AstFrame *UnpackFrame( AstFrameSet *this, int iframe, int *status )
+
+*  Class Membership:
+*     FrameSet member function.
+
+*  Description:
+*     This function returns a pointer to a specified Frame in a FrameSet,
+*     first creating the Frame from its serialised form if this has not
+*     already been done (see UnpackAll).
+
+*  Parameters:
+*     this
+*        Pointer to the FrameSet.
+*     iframe
+*        The zero-based index of the Frame within the FrameSet.
+*     status
+*        Pointer to the inherited status variable.
+
+*  Returned Value:
+*     A pointer to the Frame. This is not cloned and so should not be
+*     annulled.
+
+*  Notes:
+*     - A NULL pointer will be returned if this function is invoked
+*     with the global error status set, or if it should fail for any
+*     reason.
+*/
+
+/* Check the global error status. */
+   if ( !astOK ) return NULL;
+
+/* If the Frame is still held in serialised form, create it and free
+   the serialised form. */
+   if ( this->frmspan && this->frmspan[ iframe ] ) {
+      this->frame[ iframe ] = (AstFrame *) astSpanObject( this->frmspan[ iframe ] );
+      if ( astOK ) this->frmspan[ iframe ] = astFreeSpan( this->frmspan[ iframe ] );
+   }
+
+/* Return the Frame pointer. */
+   return astOK ? this->frame[ iframe ] : NULL;
+}
+
+static AstMapping *UnpackMapping( AstFrameSet *this, int inode, int *status ) {
+/*
+*  Name:
+*     UnpackMapping
+
+*  Purpose:
+*     Ensure a Mapping in a FrameSet has been created.
+
+*  Type:
+*     Private function.
+
+*  Synopsis:
+*     #include "frameset.h"
+*     AstMapping *UnpackMapping( AstFrameSet *this, int inode, int *status )
+
+*  Class Membership:
+*     FrameSet member function.
+
+*  Description:
+*     This function returns a pointer to the Mapping associated with a
+*     specified node in a FrameSet, first creating the Mapping from its
+*     serialised form if this has not already been done (see UnpackAll).
+
+*  Parameters:
+*     this
+*        Pointer to the FrameSet.
+*     inode
+*        The index of the Mapping within the FrameSet's array of
+*        Mappings (i.e. one less than the index of the associated node).
+*     status
+*        Pointer to the inherited status variable.
+
+*  Returned Value:
+*     A pointer to the Mapping. This is not cloned and so should not be
+*     annulled.
+
+*  Notes:
+*     - A NULL pointer will be returned if this function is invoked
+*     with the global error status set, or if it should fail for any
+*     reason.
+*/
+
+/* Check the global error status. */
+   if ( !astOK ) return NULL;
+
+/* If the Mapping is still held in serialised form, create it and free
+   the serialised form. */
+   if ( this->mapspan && this->mapspan[ inode ] ) {
+      this->map[ inode ] = (AstMapping *) astSpanObject( this->mapspan[ inode ] );
+      if ( astOK ) this->mapspan[ inode ] = astFreeSpan( this->mapspan[ inode ] );
+   }
+
+/* Return the Mapping pointer. */
+   return astOK ? this->map[ inode ] : NULL;
+}
+
 static int ValidateAxis( AstFrame *this_frame, int axis, int fwd,
                          const char *method, int *status ) {
 /*
@@ -12361,6 +12725,8 @@ static void Copy( const AstObject *objin, AstObject *objout, int *status ) {
    out->map = NULL;
    out->link = NULL;
    out->invert = NULL;
+   out->frmspan = NULL;
+   out->mapspan = NULL;
 
 /* Allocate memory in the output FrameSet to store the Frame and node
    information and copy scalar information across. */
@@ -12379,10 +12745,31 @@ static void Copy( const AstObject *objin, AstObject *objout, int *status ) {
    resulting pointers in the output FrameSet. */
    if ( astOK ) {
       for ( iframe = 0; iframe < in->nframe; iframe++ ) {
-         out->frame[ iframe ] = astCopy( in->frame[ iframe ] );
+         out->frame[ iframe ] = in->frame[ iframe ] ?
+                                astCopy( in->frame[ iframe ] ) : NULL;
       }
       for ( inode = 0; inode < in->nnode - 1; inode++ ) {
-         out->map[ inode ] = astCopy( in->map[ inode ] );
+         out->map[ inode ] = in->map[ inode ] ?
+                             astCopy( in->map[ inode ] ) : NULL;
+      }
+
+/* Copy any Frames and Mappings that have not yet been created from
+   their serialised forms. */
+      if ( in->frmspan ) {
+         out->frmspan = astCalloc( in->nframe, sizeof( AstChannelSpan * ) );
+         if ( astOK ) {
+            for ( iframe = 0; iframe < in->nframe; iframe++ ) {
+               out->frmspan[ iframe ] = astCopySpan( in->frmspan[ iframe ] );
+            }
+         }
+      }
+      if ( in->mapspan ) {
+         out->mapspan = astCalloc( in->nnode - 1, sizeof( AstChannelSpan * ) );
+         if ( astOK ) {
+            for ( inode = 0; inode < in->nnode - 1; inode++ ) {
+               out->mapspan[ inode ] = astCopySpan( in->mapspan[ inode ] );
+            }
+         }
       }
 
 /* If an error occurred while copying any of these objects, clean up
@@ -12390,11 +12777,16 @@ static void Copy( const AstObject *objin, AstObject *objout, int *status ) {
    all. */
       if ( !astOK ) {
          for ( iframe = 0; iframe < in->nframe; iframe++ ) {
-            out->frame[ iframe ] = astAnnul( out->frame[ iframe ] );
+            if ( out->frame[ iframe ] ) {
+               out->frame[ iframe ] = astAnnul( out->frame[ iframe ] );
+            }
          }
          for ( inode = 0; inode < in->nnode - 1; inode++ ) {
-            out->map[ inode ] = astAnnul( out->map[ inode ] );
+            if ( out->map[ inode ] ) {
+               out->map[ inode ] = astAnnul( out->map[ inode ] );
+            }
          }
+         FreeSpans( out, status );
       }
    }
 
@@ -12450,18 +12842,26 @@ static void Delete( AstObject *obj, int *status ) {
 /* Annul all Frame pointers and clear the node numbers associated with
    them. */
    for ( iframe = 0; iframe < this->nframe; iframe++ ) {
-      this->frame[ iframe ] = astAnnul( this->frame[ iframe ] );
+      if ( this->frame[ iframe ] ) {
+         this->frame[ iframe ] = astAnnul( this->frame[ iframe ] );
+      }
       this->node[ iframe ] = 0;
    }
 
 /* Annul all Mapping pointers and clear the links between pairs of
    nodes and the associated Mapping Invert information. */
    for ( inode = 0; inode < this->nnode - 1; inode++ ) {
-      this->map[ inode ] = astAnnul( this->map[ inode ] );
+      if ( this->map[ inode ] ) {
+         this->map[ inode ] = astAnnul( this->map[ inode ] );
+      }
       this->link[ inode ] = 0;
       this->invert[ inode ] = 0;
    }
 
+/* Free any Frames and Mappings that were never created from their
+   serialised forms. */
+   FreeSpans( this, status );
+
 /* Free all allocated memory. */
    this->frame = astFree( this->frame );
    this->varfrm = astFree( this->varfrm );
@@ -12517,8 +12917,10 @@ static void Dump( AstObject *this_object, AstChannel *channel, int *status ) {
 /* Check the global error status. */
    if ( !astOK ) return;
 
-/* Obtain a pointer to the FrameSet structure. */
+/* Obtain a pointer to the FrameSet structure, and ensure all its Frames
+   and Mappings have been created. */
    this = (AstFrameSet *) this_object;
+   UnpackAll( this, status );
 
 /* Determine if the FrameSet is inverted. This is required so that the
    effects of inversion can be un-done to obtain information about the
@@ -12880,6 +13282,9 @@ AstFrameSet *astInitFrameSet_( void *mem, size_t size, int init,
 
 /* Initialise the FrameSet data. */
 /* ----------------------------- */
+/* All Frames and Mappings are held as Objects. */
+      new->frmspan = NULL;
+      new->mapspan = NULL;
 
 /* Normal Frame supplied. */
 /* ---------------------- */
@@ -12923,6 +13328,7 @@ AstFrameSet *astInitFrameSet_( void *mem, size_t size, int init,
 
 /* Obtain a pointer to the original FrameSet structure. */
          old = (AstFrameSet *) frame;
+         UnpackAll( old, status );
 
 /* Allocate memory in the new FrameSet to store the Frame and node
    information and copy any scalar information across. */
@@ -13073,6 +13479,7 @@ AstFrameSet *astLoadFrameSet_( void *mem, size_t size,
 #define KEY_LEN 50               /* Maximum length of a keyword */
 
 /* Local Variables: */
+   AstChannelSpan *span;         /* Unconverted Frame or Mapping */
    AstFrameSet *new;             /* Pointer to the new FrameSet */
    char key[ KEY_LEN + 1 ];      /* Buffer for keyword string */
    int ifr;                      /* Get a pointer to the thread specific global data structure. */
@@ -13104,6 +13511,13 @@ AstFrameSet *astLoadFrameSet_( void *mem, size_t size,
       }
    }
 
+/* If the Channel's Lazy attribute is set, ask it to leave the Frames
+   and Mappings in serialised form, so that they are only created when
+   they are needed. This must be done before invoking the parent class
+   loader, since the Frame data may not be separated from the FrameSet
+   data in the input. */
+   astDeferObjects( channel );
+
 /* Invoke the parent class loader to load data for all the ancestral
    classes of the current one, returning a pointer to the resulting
    partly-built FrameSet. */
@@ -13117,6 +13531,8 @@ AstFrameSet *astLoadFrameSet_( void *mem, size_t size,
 /* Request the input Channel to read all the input data appropriate to
    this class into the internal "values list". */
       astReadClassData( channel, "FrameSet" );
+      new->frmspan = NULL;
+      new->mapspan = NULL;
 
 /* Now read each individual data item from this list and use it to
    initialise the appropriate instance variable(s) for this class. */
@@ -13170,7 +13586,20 @@ AstFrameSet *astLoadFrameSet_( void *mem, size_t size,
 /* -------------- */
 /* Create the required keyword and then read the Frame. */
             (void) sprintf( key, "frm%d", ifr );
-            new->frame[ ifr - 1 ] = astReadObject( channel, key, NULL );
+            span = astReadSpan( channel, key );
+            if ( span ) {
+               if ( !new->frmspan ) {
+                  new->frmspan = astCalloc( new->nframe,
+                                            sizeof( AstChannelSpan * ) );
+               }
+               if ( astOK ) {
+                  new->frmspan[ ifr - 1 ] = span;
+               } else {
+                  span = astFreeSpan( span );
+               }
+            } else {
+               new->frame[ ifr - 1 ] = astReadObject( channel, key, NULL );
+            }
 
 /* Node index for each Frame. */
 /* -------------------------- */
@@ -13199,7 +13628,20 @@ AstFrameSet *astLoadFrameSet_( void *mem, size_t size,
 /* Mapping objects. */
 /* ---------------- */
             (void) sprintf( key, "map%d", inode + 1 );
-            new->map[ inode - 1 ] = astReadObject( channel, key, NULL );
+            span = astReadSpan( channel, key );
+            if ( span ) {
+               if ( !new->mapspan ) {
+                  new->mapspan = astCalloc( new->nnode - 1,
+                                            sizeof( AstChannelSpan * ) );
+               }
+               if ( astOK ) {
+                  new->mapspan[ inode - 1 ] = span;
+               } else {
+                  span = astFreeSpan( span );
+               }
+            } else {
+               new->map[ inode - 1 ] = astReadObject( channel, key, NULL );
+            }
          }
 
 /* Read remaining data... */
@@ -480,6 +480,8 @@ typedef struct AstFrameSet {
 /* Attributes specific to objects in this class. */
    AstFrame **frame;             /* Array of Frame pointers */
    AstMapping **map;             /* Array of Mapping pointers */
+   struct AstChannelSpan **frmspan; /* Unconverted Frames (if any) */
+   struct AstChannelSpan **mapspan; /* Unconverted Mappings (if any) */
    int *varfrm;                  /* Array of variants Frames indices */
    int *invert;                  /* Array of Mapping Invert values */
    int *link;                    /* Parent node index for each node */
@@ -16,6 +16,8 @@
 *  Routines Defined:
 *     AST_YAMLCHAN
 *     AST_ISAYAMLCHAN
+*     AST_GETASDFBLOCKS
+*     AST_PUTASDFBLOCKS
 
 *  Copyright:
 *     Copyright (C) 2020 East Asian Observatory
@@ -125,7 +127,26 @@ F77_LOGICAL_FUNCTION(ast_isayamlchan)( INTEGER(THIS),
    return RESULT;
 }
 
+F77_INTEGER_FUNCTION(ast_getasdfblocks)( INTEGER(THIS),
+                                         INTEGER(STATUS) ) {
+   GENPTR_INTEGER(THIS)
+   F77_INTEGER_TYPE(RESULT);
 
+   astAt( "AST_GETASDFBLOCKS", NULL, 0 );
+   astWatchSTATUS(
+      RESULT = astP2I( astGetAsdfBlocks( astI2P( *THIS ) ) );
+   )
+   return RESULT;
+}
 
+F77_SUBROUTINE(ast_putasdfblocks)( INTEGER(THIS),
+                                   INTEGER(BLOCKS),
+                                   INTEGER(STATUS) ){
+   GENPTR_INTEGER(THIS)
+   GENPTR_INTEGER(BLOCKS)
 
-
+   astAt( "AST_PUTASDFBLOCKS", NULL, 0 );
+   astWatchSTATUS(
+      astPutAsdfBlocks( astI2P( *THIS ), astI2P( *BLOCKS ) );
+   )
+}
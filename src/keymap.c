@@ -485,8 +485,9 @@ AstKeyMap *astKeyMapId_( const char *, ... );
 static AstMapEntry *AddTableEntry( AstKeyMap *, int, AstMapEntry *, int, int * );
 static AstMapEntry *CopyMapEntry( AstMapEntry *, int * );
 static AstMapEntry *FreeMapEntry( AstMapEntry *, int * );
-static AstMapEntry *RemoveTableEntry( AstKeyMap *, int, const char *, int * );
-static AstMapEntry *SearchTableEntry( AstKeyMap *, int, const char *, int * );
+static void *EntryValue( AstMapEntry *, int * );
+static AstMapEntry *RemoveTableEntry( AstKeyMap *, int, const char *, unsigned long, int * );
+static AstMapEntry *SearchTableEntry( AstKeyMap *, int, const char *, unsigned long, int * );
 static const char *ConvertKey( AstKeyMap *, const char *, char *, int, const char *, int * );
 static const char *GetKey( AstKeyMap *, int index, int * );
 static const char *MapIterate( AstKeyMap *, int, int * );
@@ -527,6 +528,10 @@ static int MapGetElemI( AstKeyMap *, const char *, int, int *, int * );
 static int MapGetElemK( AstKeyMap *, const char *, int, int64_t *, int * );
 static int MapGetElemP( AstKeyMap *, const char *, int, void **, int * );
 static int MapHasKey( AstKeyMap *, const char *, int * );
+static int MapHasKeyH( AstKeyMap *, const AstMapKeyHandle *, int * );
+static const void *MapValuePtr( AstKeyMap *, const char *, int *, int *, int * );
+static int MapGet0H( AstKeyMap *, const AstMapKeyHandle *, int, void *, int * );
+static void MapPut0H( AstKeyMap *, const AstMapKeyHandle *, int, const void *, const char *, int * );
 static int MapLenC( AstKeyMap *, const char *, int * );
 static int MapLength( AstKeyMap *, const char *, int * );
 static int MapSize( AstKeyMap *, int * );
@@ -576,7 +581,9 @@ static void MapPutElemP( AstKeyMap *, const char *, int, void *, int * );
 static void MapPutU( AstKeyMap *, const char *, const char *, int * );
 static void MapRemove( AstKeyMap *, const char *, int * );
 static void MapRename( AstKeyMap *, const char *, const char *, int * );
+static void MapKeyHandle( AstKeyMap *, const char *, AstMapKeyHandle *, int * );
 static void NewTable( AstKeyMap *, int, int * );
+static void PutEntry0( AstKeyMap *, AstMapEntry *, const char *, const unsigned long *, const char *, const char *, int * );
 static void RemoveFromSortedList( AstKeyMap *, AstMapEntry *, int * );
 static void RemoveFromObjectList( AstKeyMap *, AstMapEntry *, int * );
 static void SortEntries( AstKeyMap *, int * );
@@ -665,6 +672,7 @@ static AstMapEntry *AddTableEntry( AstKeyMap *this, int itab,
 
 */
 
+/* Local Variables: */
 /* Check the global error status. */
    if ( !astOK ) return NULL;
 
@@ -676,8 +684,10 @@ static AstMapEntry *AddTableEntry( AstKeyMap *this, int itab,
    hash table. */
    this->table[ itab ] = entry;
 
-/* Increment the length of linked list. */
+/* Increment the length of linked list, and the total number of entries
+   in the KeyMap. */
    this->nentry[ itab ]++;
+   this->ntotal++;
 
 /* Each new entry added to the KeyMap has a unique member index that is
    never re-used. */
@@ -702,10 +712,12 @@ static AstMapEntry *AddTableEntry( AstKeyMap *this, int itab,
 
 /* If the population of this table entry is now too large, double the size
    of the table, moving the table entries to appropriate places in the
-   new larger table. */
-   if( this->nentry[ itab ] > MAX_ENTRIES_PER_TABLE_ENTRY ) {
-      DoubleTableSize( this, status );
-   }
+   new larger table. Do not do this if the table already has more elements
+   than the KeyMap has entries, since the long list must then be caused by
+   keys with equal hash values, which would stay together however large
+   the table became. */
+   if( this->nentry[ itab ] > MAX_ENTRIES_PER_TABLE_ENTRY &&
+       this->ntotal > this->mapsize ) DoubleTableSize( this, status );
 
 /* Return a NULL pointer. */
    return NULL;
@@ -2932,6 +2944,102 @@ static void DumpEntry( AstMapEntry *entry, AstChannel *channel, int nentry, int
    }
 }
 
+static void *EntryValue( AstMapEntry *entry, int *status ) {
+/*
+*  Name:
+*     EntryValue
+
+*  Purpose:
+*     Return a pointer to the value stored in a MapEntry.
+
+*  Type:
+*     Private function.
+
+*  Synopsis:
+*     #include "keymap.h"
+*     void *EntryValue( AstMapEntry *entry, int *status )
+
+*  Class Membership:
+*     KeyMap member function.
+
+*  Description:
+*     This function returns a pointer to the memory holding the value
+*     stored in the supplied MapEntry. For a scalar entry this is the
+*     address of the single value. For a vector entry it is the address
+*     of the first element of the array of values.
+
+*  Parameters:
+*     entry
+*        Pointer to the MapEntry.
+*     status
+*        Pointer to the inherited status variable.
+
+*  Returned Value:
+*     Pointer to the value, or NULL if the entry has an undefined value.
+
+*  Notes:
+*     - A NULL pointer is returned if an error has already occurred, or
+*     if this function should fail for any reason.
+*/
+
+/* Local Variables: */
+   int type;
+   void *result;
+
+/* Initialise */
+   result = NULL;
+
+/* Check the global error status. */
+   if ( !astOK ) return result;
+
+/* Do each data type in turn. */
+   type = entry->type;
+   if( type == AST__INTTYPE ){
+      result = entry->nel ? (void *) ((Entry1I *)entry)->value :
+                            (void *) &( ((Entry0I *)entry)->value );
+
+   } else if( type == AST__SINTTYPE ){
+      result = entry->nel ? (void *) ((Entry1S *)entry)->value :
+                            (void *) &( ((Entry0S *)entry)->value );
+
+   } else if( type == AST__KINTTYPE ){
+      result = entry->nel ? (void *) ((Entry1K *)entry)->value :
+                            (void *) &( ((Entry0K *)entry)->value );
+
+   } else if( type == AST__BYTETYPE ){
+      result = entry->nel ? (void *) ((Entry1B *)entry)->value :
+                            (void *) &( ((Entry0B *)entry)->value );
+
+   } else if( type == AST__DOUBLETYPE ){
+      result = entry->nel ? (void *) ((Entry1D *)entry)->value :
+                            (void *) &( ((Entry0D *)entry)->value );
+
+   } else if( type == AST__FLOATTYPE ){
+      result = entry->nel ? (void *) ((Entry1F *)entry)->value :
+                            (void *) &( ((Entry0F *)entry)->value );
+
+   } else if( type == AST__POINTERTYPE ){
+      result = entry->nel ? (void *) ((Entry1P *)entry)->value :
+                            (void *) &( ((Entry0P *)entry)->value );
+
+   } else if( type == AST__STRINGTYPE ){
+      result = entry->nel ? (void *) ((Entry1C *)entry)->value :
+                            (void *) &( ((Entry0C *)entry)->value );
+
+   } else if( type == AST__OBJECTTYPE ){
+      result = entry->nel ? (void *) ((Entry1A *)entry)->value :
+                            (void *) &( ((Entry0A *)entry)->value );
+
+   } else if( type != AST__UNDEFTYPE ){
+      astError( AST__INTER, "EntryValue(KeyMap): Illegal map entry data "
+                "type %d encountered (internal AST programming error).", status,
+                type );
+   }
+
+/* Return the result. */
+   return result;
+}
+
 static AstMapEntry *FreeMapEntry( AstMapEntry *in, int *status ){
 /*
 *  Name:
@@ -3153,7 +3261,9 @@ static void FreeTableEntry( AstKeyMap *this, int itab, int *status ){
 /* Store a NULL pointer in the table element. */
       this->table[ itab ] = NULL;
 
-/* Sets the number of entries in this hash table element to zero. */
+/* Sets the number of entries in this hash table element to zero,
+   and reduce the total number of entries in the KeyMap accordingly. */
+      this->ntotal -= this->nentry[ itab ];
       this->nentry[ itab ] = 0;
    }
 }
@@ -3612,7 +3722,8 @@ static int HashFun( const char *key, int bitmask, unsigned long *hash, int *stat
 
 *  Synopsis:
 *     #include "keymap.h"
-*     int HashFun( const char *key, int bitmask, int *hash, int *status )
+*     int HashFun( const char *key, int bitmask, unsigned long *hash,
+*                  int *status )
 
 *  Class Membership:
 *     KeyMap member function.
@@ -3638,13 +3749,17 @@ static int HashFun( const char *key, int bitmask, unsigned long *hash, int *stat
 *     An integer in the range zero to ( mapsize - 1 ).
 
 *  Notes:
-*     - A value of zero is returned if this function is invoked with the
-*     global error status set.
+*     - A value of zero is returned, and zero is stored in "*hash", if this
+*     function is invoked with the global error status set.
 */
 
 /* Local Variables: */
    int c;
 
+/* Initialise the returned hash value, so that callers never see an
+   uninitialised value. */
+   *hash = 0;
+
 /* Check the local error status. */
    if ( !astOK ) return 0;
 
@@ -3790,6 +3905,11 @@ void astInitKeyMapVtab_(  AstKeyMapVtab *vtab, const char *name, int *status ) {
    vtab->MapType = MapType;
    vtab->MapHasKey = MapHasKey;
    vtab->MapKey = MapKey;
+   vtab->MapKeyHandle = MapKeyHandle;
+   vtab->MapGet0H = MapGet0H;
+   vtab->MapPut0H = MapPut0H;
+   vtab->MapHasKeyH = MapHasKeyH;
+   vtab->MapValuePtr = MapValuePtr;
    vtab->MapIterate = MapIterate;
 
    vtab->ClearSizeGuess = ClearSizeGuess;
@@ -4188,7 +4308,7 @@ f        The global status.
 
 /* Search for a destination entry with the same key. */
          itab = HashFun( key, this->mapsize - 1, &hash, status );
-         out_entry = SearchTableEntry( this, itab, key, status );
+         out_entry = SearchTableEntry( this, itab, key, hash, status );
 
 /* If the destination KeyMap does not contain an entry with the current
    key, store a copy of the entry in the destination, or report an error
@@ -4245,7 +4365,7 @@ f        The global status.
    But retain the original keymember value since we are just changing the
    value of an existing key. */
             if( ! merged ) {
-               out_entry = RemoveTableEntry( this, itab, key, status );
+               out_entry = RemoveTableEntry( this, itab, key, hash, status );
                keymember = out_entry->keymember;
                (void) FreeMapEntry( out_entry, status );
                out_entry = CopyMapEntry( in_entry, status );
@@ -4353,12 +4473,12 @@ f        The global status.
    itab = HashFun( key, that->mapsize - 1, &hash, status );
 
 /* Search the relevent table entry for the required MapEntry. */
-   in_entry = SearchTableEntry( that, itab, key, status );
+   in_entry = SearchTableEntry( that, itab, key, hash, status );
 
 /* If found, search for a destination entry with the same key. */
    if( in_entry ) {
       itab = HashFun( key, this->mapsize - 1, &hash, status );
-      out_entry = SearchTableEntry( this, itab, key, status );
+      out_entry = SearchTableEntry( this, itab, key, hash, status );
 
 /* If the destination KeyMap does not contain an entry with the current
    key, store a copy of the entry in the destination, or report an error
@@ -4417,7 +4537,7 @@ f        The global status.
    But retain the original keymember value since we are just changing the
    value of an existing key. */
          if( ! merged ) {
-            out_entry = RemoveTableEntry( this, itab, key, status );
+            out_entry = RemoveTableEntry( this, itab, key, hash, status );
             keymember = out_entry->keymember;
             (void) FreeMapEntry( out_entry, status );
             out_entry = CopyMapEntry( in_entry, status );
@@ -4665,16 +4785,9 @@ static void MapPut0##X( AstKeyMap *this, const char *skey, Xtype value, \
                         const char *comment, int *status ) { \
 \
 /* Local Variables: */ \
-   AstMapEntry *mapentry;  /* Pointer to parent MapEntry structure */ \
-   AstMapEntry *oldent;    /* Pointer to existing MapEntry */ \
    Entry0##X *entry;       /* Structure holding the data for the new Entry */ \
    const char *key;        /* Pointer to key string to use */ \
-   char *p;                /* Pointer to next key character */ \
    char keybuf[ AST__MXKEYLEN + 1 ]; /* Buffer for upper cas key */ \
-   int itab;               /* Index of hash table element to use */ \
-   int keylen;             /* Length of supplied key string */ \
-   int keymember;          /* Identifier for existing key */ \
-   int there;              /* Did the entry already exist in the KeyMap? */ \
 \
 /* Check the global error status. */ \
    if ( !astOK ) return; \
@@ -4690,61 +4803,13 @@ static void MapPut0##X( AstKeyMap *this, const char *skey, Xtype value, \
    entry = astMalloc( sizeof( Entry0##X ) ); \
    if( astOK ) { \
 \
-/* Initialise the new structure.*/ \
-      mapentry = (AstMapEntry *) entry; \
-      InitMapEntry( mapentry, Itype, 0, status ); \
-\
-/* Now store the new values. */ \
-      keylen = strlen( key ); \
-      mapentry->key = astStore( NULL, key, keylen + 1 ); \
-      if( comment ) mapentry->comment = astStore( NULL, comment, strlen( comment ) + 1 ); \
-      mapentry->defined = 1; \
+/* Initialise the new structure and store the value.*/ \
+      InitMapEntry( (AstMapEntry *) entry, Itype, 0, status ); \
       entry->value = ValExp; \
 \
-/* Terminate the key string to exclude any trailing spaces. */ \
-      if( astOK ) { \
-         p = (char *) mapentry->key + keylen; \
-         while( --p >= mapentry->key ) { \
-            if( *p == ' ' ) { \
-               *p = 0; \
-            } else { \
-               break; \
-            } \
-         } \
-      } \
-\
-/* Use the hash function to determine the element of the hash table in \
-   which to store the new entry. */ \
-      itab = HashFun( mapentry->key, this->mapsize - 1, &(mapentry->hash), status ); \
-\
-/* Remove any existing entry with the given key from the table element. \
-   First save the key identifier. */ \
-      oldent = RemoveTableEntry( this, itab, mapentry->key, status ); \
-      if( oldent ) { \
-         keymember = oldent->keymember; \
-         oldent = FreeMapEntry( oldent, status ); \
-         there = 1; \
-      } else { \
-         keymember = -1; \
-         there = 0; \
-      } \
-\
-/* If the KeyMap is locked we report an error if an attempt is made to add a value for \
-   a new key. */ \
-      if( !there && astGetMapLocked( this ) ) { \
-         astError( AST__BADKEY, "astMapPut0" #X "(%s): Failed to add item \"%s\" to a KeyMap: " \
-                   "\"%s\" is not a known item.", status, astGetClass( this ), key, key ); \
-      } \
-\
-/* If all has gone OK, store the new entry at the head of the linked list \
-   associated with the selected table entry. */ \
-      if( astOK ) { \
-         mapentry = AddTableEntry( this, itab, mapentry, keymember, status ); \
-\
-/* If anything went wrong, try to delete the new entry. */ \
-      } else { \
-         mapentry = FreeMapEntry( mapentry, status ); \
-      } \
+/* Store the key and comment, and add the new entry to the KeyMap. */ \
+      PutEntry0( this, (AstMapEntry *) entry, key, NULL, comment, \
+                 "astMapPut0" #X, status ); \
    } \
 }
 
@@ -4786,6 +4851,143 @@ MAKE_MAPPUT0(B,unsigned char,AST__BYTETYPE,value)
 #undef CHECK_P
 #undef CHECK_B
 
+static void MapPut0H( AstKeyMap *this, const AstMapKeyHandle *handle, int type,
+                      const void *value, const char *comment, int *status ) {
+/*
+*+
+*  Name:
+*     astMapPut0H
+
+*  Purpose:
+*     Add a scalar value to a KeyMap using a key handle.
+
+*  Type:
+*     Protected virtual function.
+
+*  Synopsis:
+*     #include "keymap.h"
+*     void astMapPut0H( AstKeyMap *this, const AstMapKeyHandle *handle,
+*                       int type, const void *value, const char *comment )
+
+*  Class Membership:
+*     KeyMap method.
+
+*  Description:
+*     This function is equivalent to the astMapPut0<X> family of
+*     functions, except that the key is specified by a handle created
+*     previously by astMapKeyHandle, and the data type of the supplied
+*     value is specified by an integer type code rather than by the
+*     function name. The key is not case-folded or hashed again, so this
+*     function can be used with astMapGet0H to update an entry without
+*     processing the key more than once.
+
+*  Parameters:
+*     this
+*        Pointer to the KeyMap.
+*     handle
+*        Pointer to a key handle created by astMapKeyHandle.
+*     type
+*        The data type of the supplied value. This should be one of the
+*        scalar data type constants (AST__INTTYPE, AST__DOUBLETYPE, etc)
+*        defined in keymap.h.
+*     value
+*        Pointer to the value to be stored, which should be of the type
+*        indicated by "type". For AST__STRINGTYPE it should point to a
+*        "const char *" and for AST__OBJECTTYPE to an "AstObject *".
+*     comment
+*        A pointer to a null-terminated comment string to be stored with
+*        the value. May be NULL.
+
+*  Notes:
+*     - The KeyMap's own entries are modified directly, so any over-riding
+*     of the astMapPut0<X> methods by sub-classes is ignored.
+*     - As with astMapPut0A, a clone of any supplied AstObject pointer is
+*     stored in the KeyMap.
+*-
+*/
+
+/* Local Variables: */
+   AstMapEntry *mapentry;  /* Pointer to parent MapEntry structure */
+   AstMapKeyHandle lhandle;/* Local key handle */
+   AstObject *aval;        /* Supplied Object pointer */
+   const char *cval;       /* Supplied string pointer */
+   size_t size;            /* Size of new MapEntry structure */
+
+/* Check the global error status. */
+   if ( !astOK ) return;
+
+/* If the KeyCase attribute differs from the value used when the handle
+   was created, re-process the original key string stored in the handle. */
+   if( handle->keycase != astGetKeyCase( this ) ) {
+      astMapKeyHandle( this, handle->orig, &lhandle );
+      handle = &lhandle;
+   }
+
+/* Get the size of the structure needed to hold the new entry. Check that
+   any Object being stored does not contain "this". */
+   if( type == AST__INTTYPE ) {
+      size = sizeof( Entry0I );
+   } else if( type == AST__DOUBLETYPE ) {
+      size = sizeof( Entry0D );
+   } else if( type == AST__FLOATTYPE ) {
+      size = sizeof( Entry0F );
+   } else if( type == AST__SINTTYPE ) {
+      size = sizeof( Entry0S );
+   } else if( type == AST__KINTTYPE ) {
+      size = sizeof( Entry0K );
+   } else if( type == AST__BYTETYPE ) {
+      size = sizeof( Entry0B );
+   } else if( type == AST__STRINGTYPE ) {
+      size = sizeof( Entry0C );
+   } else if( type == AST__POINTERTYPE ) {
+      size = sizeof( Entry0P );
+   } else if( type == AST__OBJECTTYPE ) {
+      size = sizeof( Entry0A );
+      CheckCircle( this, *( (AstObject *const *) value ), "astMapPut0H",
+                   status );
+   } else {
+      size = 0;
+      astError( AST__INTER, "astMapPut0H(%s): Illegal data type %d "
+                "supplied (internal AST programming error).", status,
+                astGetClass( this ), type );
+   }
+
+/* Allocate memory for the new MapEntry. */
+   mapentry = astMalloc( size );
+   if( astOK ) {
+
+/* Initialise the new structure and store the value.*/
+      InitMapEntry( mapentry, type, 0, status );
+
+      if( type == AST__INTTYPE ) {
+         ((Entry0I *) mapentry)->value = *( (const int *) value );
+      } else if( type == AST__DOUBLETYPE ) {
+         ((Entry0D *) mapentry)->value = *( (const double *) value );
+      } else if( type == AST__FLOATTYPE ) {
+         ((Entry0F *) mapentry)->value = *( (const float *) value );
+      } else if( type == AST__SINTTYPE ) {
+         ((Entry0S *) mapentry)->value = *( (const short int *) value );
+      } else if( type == AST__KINTTYPE ) {
+         ((Entry0K *) mapentry)->value = *( (const int64_t *) value );
+      } else if( type == AST__BYTETYPE ) {
+         ((Entry0B *) mapentry)->value = *( (const unsigned char *) value );
+      } else if( type == AST__STRINGTYPE ) {
+         cval = *( (const char *const *) value );
+         ((Entry0C *) mapentry)->value = astStore( NULL, cval, strlen( cval ) + 1 );
+      } else if( type == AST__POINTERTYPE ) {
+         ((Entry0P *) mapentry)->value = *( (void *const *) value );
+      } else {
+         aval = *( (AstObject *const *) value );
+         ((Entry0A *) mapentry)->value = aval ? astClone( aval ) : NULL;
+      }
+
+/* Store the key and comment, and add the new entry to the KeyMap, using
+   the hash value stored in the handle. */
+      PutEntry0( this, mapentry, handle->key, &( handle->hash ), comment,
+                 "astMapPut0H", status );
+   }
+}
+
 /*
 *++
 *  Name:
@@ -4954,7 +5156,7 @@ static void MapPut1##X( AstKeyMap *this, const char *skey, int size, \
 \
 /* Remove any existing entry with the given key from the table element. \
    First save the key identifier. */ \
-      oldent = RemoveTableEntry( this, itab, mapentry->key, status ); \
+      oldent = RemoveTableEntry( this, itab, mapentry->key, mapentry->hash, status ); \
       if( oldent ) { \
          keymember = oldent->keymember; \
          oldent = FreeMapEntry( oldent, status ); \
@@ -5113,7 +5315,7 @@ void astMapPut1AId_( AstKeyMap *this, const char *skey, int size,
       itab = HashFun( mapentry->key, this->mapsize - 1, &(mapentry->hash), status );
 
 /* Remove any existing entry with the given key from the table element. */
-      oldent = RemoveTableEntry( this, itab, mapentry->key, status );
+      oldent = RemoveTableEntry( this, itab, mapentry->key, mapentry->hash, status );
       if( oldent ) {
          keymember = oldent->keymember;
          oldent = FreeMapEntry( oldent, status );
@@ -5250,7 +5452,7 @@ f        The global status.
       itab = HashFun( mapentry->key, this->mapsize - 1, &(mapentry->hash), status );
 
 /* Remove any existing entry with the given key from the table element. */
-      oldent = RemoveTableEntry( this, itab, mapentry->key, status );
+      oldent = RemoveTableEntry( this, itab, mapentry->key, mapentry->hash, status );
       if( oldent ) {
          keymember = oldent->keymember;
          oldent = FreeMapEntry( oldent, status );
@@ -5438,7 +5640,7 @@ static int MapGet0##X( AstKeyMap *this, const char *skey, Xtype *value, int *sta
    itab = HashFun( key, this->mapsize - 1, &hash, status ); \
 \
 /* Search the relevent table entry for the required MapEntry. */ \
-   mapentry = SearchTableEntry( this, itab, key, status ); \
+   mapentry = SearchTableEntry( this, itab, key, hash, status ); \
 \
 /* Skip rest if the key was not found. */ \
    if( mapentry ) { \
@@ -5562,6 +5764,126 @@ MAKE_MAPGET0(B,unsigned char,AST__BYTETYPE)
 /* Undefine the macro. */
 #undef MAKE_MAPGET0
 
+static int MapGet0H( AstKeyMap *this, const AstMapKeyHandle *handle, int type,
+                     void *value, int *status ) {
+/*
+*+
+*  Name:
+*     astMapGet0H
+
+*  Purpose:
+*     Get a scalar value from a KeyMap using a key handle.
+
+*  Type:
+*     Protected virtual function.
+
+*  Synopsis:
+*     #include "keymap.h"
+*     int astMapGet0H( AstKeyMap *this, const AstMapKeyHandle *handle,
+*                      int type, void *value )
+
+*  Class Membership:
+*     KeyMap method.
+
+*  Description:
+*     This function is equivalent to the astMapGet0<X> family of
+*     functions, except that the key is specified by a handle created
+*     previously by astMapKeyHandle, and the data type of the returned
+*     value is specified by an integer type code rather than by the
+*     function name. The supplied key is not case-folded or hashed, so
+*     this function can be used to avoid repeated processing of the same
+*     key in time-critical loops.
+
+*  Parameters:
+*     this
+*        Pointer to the KeyMap.
+*     handle
+*        Pointer to a key handle created by astMapKeyHandle.
+*     type
+*        The data type of the returned value. This should be one of the
+*        scalar data type constants (AST__INTTYPE, AST__DOUBLETYPE, etc)
+*        defined in keymap.h.
+*     value
+*        Pointer to a location at which to return the value, which should
+*        be of the type indicated by "type". Unchanged if the key is not
+*        found or has an undefined value.
+
+*  Returned Value:
+*     Non-zero if a defined value was found for the key, and zero
+*     otherwise.
+
+*  Notes:
+*     - The KeyMap's own entries are accessed directly, so any over-riding
+*     of the astMapGet0<X> methods by sub-classes is ignored.
+*     - As with astMapGet0A, any AstObject pointer returned is a clone of
+*     the pointer stored in the KeyMap, and should be annulled when it is
+*     no longer needed. It is a true C pointer, not an ID.
+*     - Zero is returned if an error has already occurred, or if this
+*     function should fail for any reason.
+*-
+*/
+
+/* Local Variables: */
+   AstMapEntry *mapentry;  /* Pointer to parent MapEntry structure */
+   AstMapKeyHandle lhandle;/* Local key handle */
+   int raw_type;           /* Data type of stored value */
+   int result;             /* Returned flag */
+   void *raw;              /* Pointer to stored value */
+
+/* Initialise */
+   result = 0;
+
+/* Check the global error status. */
+   if ( !astOK ) return result;
+
+/* If the KeyCase attribute differs from the value used when the handle
+   was created, re-process the original key string stored in the handle. */
+   if( handle->keycase != astGetKeyCase( this ) ) {
+      astMapKeyHandle( this, handle->orig, &lhandle );
+      handle = &lhandle;
+   }
+
+/* Search the relevent table entry for the required MapEntry. */
+   mapentry = SearchTableEntry( this, handle->hash & ( this->mapsize - 1 ),
+                                handle->key, handle->hash, status );
+
+/* Skip rest if the key was not found. */
+   if( mapentry ) {
+
+/* Get the address of the raw value, and its data type. For vector
+   entries, the first element is used. */
+      raw_type = mapentry->type;
+      raw = EntryValue( mapentry, status );
+
+/* Convert the value, storing the result the supplied buffer. Report an
+   error if conversion is not possible. */
+      if( !raw ) {
+         result = 0;
+
+      } else if( !ConvertValue( raw, raw_type, value, type, status ) && astOK ){
+         astError( AST__MPGER, "astMapGet0H(%s): The value of KeyMap key "
+                   "\"%s\" cannot be read using the requested data "
+                   "type.", status, astGetClass( this ), handle->key );
+
+      } else {
+         result = 1;
+      }
+
+/* If the KeyError attribute is non-zero, report an error if the key is not
+   found */
+   } else if( astGetKeyError( this ) && astOK ) {
+      astError( AST__MPKER, "astMapGet0H(%s): No value was found for "
+                "%s in the supplied KeyMap.", status, astGetClass( this ),
+                handle->key );
+   }
+
+/* If an error occurred, return zero. */
+   if( !astOK ) result = 0;
+
+/* Return the result.*/
+   return result;
+}
+
 int astMapGet0AId_( AstKeyMap *this, const char *skey, AstObject **value, int *status ) {
 /*
 *  Name:
@@ -5617,7 +5939,7 @@ int astMapGet0AId_( AstKeyMap *this, const char *skey, AstObject **value, int *s
    itab = HashFun( key, this->mapsize - 1, &hash, status );
 
 /* Search the relevent table entry for the required MapEntry. */
-   mapentry = SearchTableEntry( this, itab, key, status );
+   mapentry = SearchTableEntry( this, itab, key, hash, status );
 
 /* Skip rest if the key was not found. */
    if( mapentry ) {
@@ -5901,7 +6223,7 @@ static int MapGet1##X( AstKeyMap *this, const char *skey, int mxval, int *nval,
    itab = HashFun( key, this->mapsize - 1, &hash, status ); \
 \
 /* Search the relevent table entry for the required MapEntry. */ \
-   mapentry = SearchTableEntry( this, itab, key, status ); \
+   mapentry = SearchTableEntry( this, itab, key, hash, status ); \
 \
 /* Skip rest if the key was not found. */ \
    if( mapentry ) { \
@@ -6113,7 +6435,7 @@ static int MapGet1C( AstKeyMap *this, const char *skey, int l, int mxval,
    itab = HashFun( key, this->mapsize - 1, &hash, status );
 
 /* Search the relevent table entry for the required MapEntry. */
-   mapentry = SearchTableEntry( this, itab, key, status );
+   mapentry = SearchTableEntry( this, itab, key, hash, status );
 
 /* Skip rest if the key was not found. */
    if( mapentry ) {
@@ -6320,7 +6642,7 @@ int astMapGet1AId_( AstKeyMap *this, const char *skey, int mxval, int *nval,
    itab = HashFun( key, this->mapsize - 1, &hash, status );
 
 /* Search the relevent table entry for the required MapEntry. */
-   mapentry = SearchTableEntry( this, itab, key, status );
+   mapentry = SearchTableEntry( this, itab, key, hash, status );
 
 /* Skip rest if the key was not found. */
    if( mapentry ) {
@@ -6799,7 +7121,7 @@ static int MapGetElem##X( AstKeyMap *this, const char *skey, int elem, \
    itab = HashFun( key, this->mapsize - 1, &hash, status ); \
 \
 /* Search the relevent table entry for the required MapEntry. */ \
-   mapentry = SearchTableEntry( this, itab, key, status ); \
+   mapentry = SearchTableEntry( this, itab, key, hash, status ); \
 \
 /* Skip rest if the key was not found. */ \
    if( mapentry ) { \
@@ -7006,7 +7328,7 @@ static int MapGetElemC( AstKeyMap *this, const char *skey, int l, int elem,
    itab = HashFun( key, this->mapsize - 1, &hash, status );
 
 /* Search the relevent table entry for the required MapEntry. */
-   mapentry = SearchTableEntry( this, itab, key, status );
+   mapentry = SearchTableEntry( this, itab, key, hash, status );
 
 /* Skip rest if the key was not found. */
    if( mapentry ) {
@@ -7205,7 +7527,7 @@ int astMapGetElemAId_( AstKeyMap *this, const char *skey, int elem,
    itab = HashFun( key, this->mapsize - 1, &hash, status );
 
 /* Search the relevent table entry for the required MapEntry. */
-   mapentry = SearchTableEntry( this, itab, key, status );
+   mapentry = SearchTableEntry( this, itab, key, hash, status );
 
 /* Skip rest if the key was not found. */
    if( mapentry ) {
@@ -7416,7 +7738,7 @@ f        .TRUE.
    itab = HashFun( key, this->mapsize - 1, &hash, status );
 
 /* Search the relevent table entry for the required MapEntry. */
-   mapentry = SearchTableEntry( this, itab, key, status );
+   mapentry = SearchTableEntry( this, itab, key, hash, status );
 
 /* Skip rest if the key was not found. */
    if( mapentry ) {
@@ -7527,7 +7849,7 @@ f     .FALSE.
    itab = HashFun( key, this->mapsize - 1, &hash, status );
 
 /* Search the relevent table entry for the required MapEntry. */
-   mapentry = SearchTableEntry( this, itab, key, status );
+   mapentry = SearchTableEntry( this, itab, key, hash, status );
 
 /* Set a non-zero return value if the key was found. */
    if( mapentry ) result = 1;
@@ -7540,6 +7862,267 @@ f     .FALSE.
 
 }
 
+static int MapHasKeyH( AstKeyMap *this, const AstMapKeyHandle *handle,
+                       int *status ) {
+/*
+*+
+*  Name:
+*     astMapHasKeyH
+
+*  Purpose:
+*     Check if an entry with a given key handle exists in a KeyMap.
+
+*  Type:
+*     Protected virtual function.
+
+*  Synopsis:
+*     #include "keymap.h"
+*     int astMapHasKeyH( AstKeyMap *this, const AstMapKeyHandle *handle )
+
+*  Class Membership:
+*     KeyMap method.
+
+*  Description:
+*     This function is equivalent to astMapHasKey, except that the key
+*     is specified by a handle created previously by astMapKeyHandle.
+
+*  Parameters:
+*     this
+*        Pointer to the KeyMap.
+*     handle
+*        Pointer to a key handle created by astMapKeyHandle.
+
+*  Returned Value:
+*     Non-zero if the key was found, and zero otherwise.
+
+*  Notes:
+*     - Zero is returned if an error has already occurred, or if this
+*     function should fail for any reason.
+*-
+*/
+
+/* Local Variables: */
+   AstMapKeyHandle lhandle;/* Local key handle */
+   int result;             /* Returned value */
+
+/* Initialise */
+   result = 0;
+
+/* Check the global error status. */
+   if ( !astOK ) return result;
+
+/* If the KeyCase attribute differs from the value used when the handle
+   was created, re-process the original key string stored in the handle. */
+   if( handle->keycase != astGetKeyCase( this ) ) {
+      astMapKeyHandle( this, handle->orig, &lhandle );
+      handle = &lhandle;
+   }
+
+/* Search the relevent table entry for the required MapEntry. */
+   if( SearchTableEntry( this, handle->hash & ( this->mapsize - 1 ),
+                         handle->key, handle->hash, status ) ) result = 1;
+
+/* If an error has occurred, return zero. */
+   if( !astOK ) result = 0;
+
+/* Return the result. */
+   return result;
+}
+
+static void MapKeyHandle( AstKeyMap *this, const char *skey,
+                          AstMapKeyHandle *handle, int *status ) {
+/*
+*+
+*  Name:
+*     astMapKeyHandle
+
+*  Purpose:
+*     Prepare a key for repeated use.
+
+*  Type:
+*     Protected virtual function.
+
+*  Synopsis:
+*     #include "keymap.h"
+*     void astMapKeyHandle( AstKeyMap *this, const char *key,
+*                           AstMapKeyHandle *handle )
+
+*  Class Membership:
+*     KeyMap method.
+
+*  Description:
+*     This function converts the supplied key to upper case if the
+*     KeyCase attribute of the KeyMap is currently zero, and then stores
+*     the resulting key, together with its full width hash value, in the
+*     supplied handle. The handle can then be passed to astMapGet0H,
+*     astMapPut0H and astMapHasKeyH to access the corresponding entry in
+*     this or any other KeyMap, without needing to case-fold and hash the
+*     key again.
+
+*  Parameters:
+*     this
+*        Pointer to the KeyMap.
+*     key
+*        The character string identifying the KeyMap entry. Trailing
+*        spaces are ignored.
+*     handle
+*        Pointer to the structure in which to store the prepared key.
+
+*  Notes:
+*     - The handle records the KeyCase value in use when it was created,
+*     and the key as supplied. If it is later used with a KeyMap that has
+*     a different KeyCase value, the supplied key is processed again
+*     using the KeyCase value of that KeyMap before being used. This is
+*     slower, but gives the same result as using the key directly.
+*     - Keys longer than AST__MXKEYLEN characters cannot be stored in a
+*     handle, and an error is reported if such a key is supplied.
+*-
+*/
+
+/* Local Variables: */
+   const char *key;        /* Pointer to key string to use */
+   char keybuf[ AST__MXKEYLEN + 1 ]; /* Buffer for upper case key */
+   int len;                /* Used length of supplied key */
+
+/* Check the global error status. */
+   if ( !astOK ) return;
+
+/* Convert the supplied key to upper case if required, and store it in the
+   handle. Report an error if it is too long. */
+   handle->keycase = astGetKeyCase( this );
+   key = ConvertKey( this, skey, keybuf, AST__MXKEYLEN + 1, "astMapKeyHandle",
+                     status );
+   if( strlen( key ) > AST__MXKEYLEN && astOK ) {
+      astError( AST__BIGKEY, "astMapKeyHandle(%s): Supplied key '%s' is too "
+                "long (keys must be no more than %d characters long).",
+                status, astGetClass( this ), key, AST__MXKEYLEN );
+   }
+   if( astOK ) {
+      strcpy( handle->key, key );
+
+/* Also store the supplied key, excluding trailing spaces, so that it can
+   be re-processed if the handle is used with a KeyMap that has a
+   different KeyCase value. */
+      len = astChrLen( skey );
+      memcpy( handle->orig, skey, len );
+      handle->orig[ len ] = 0;
+
+/* Store the full width hash value. The hash table index is derived from
+   this when the handle is used, since the size of the hash table may
+   change. */
+      (void) HashFun( handle->key, 0, &(handle->hash), status );
+   }
+}
+
+static const void *MapValuePtr( AstKeyMap *this, const char *skey, int *type,
+                                int *nel, int *status ) {
+/*
+*+
+*  Name:
+*     astMapValuePtr
+
+*  Purpose:
+*     Get a pointer to the value stored for a key, without copying it.
+
+*  Type:
+*     Protected virtual function.
+
+*  Synopsis:
+*     #include "keymap.h"
+*     const void *astMapValuePtr( AstKeyMap *this, const char *key,
+*                                 int *type, int *nel )
+
+*  Class Membership:
+*     KeyMap method.
+
+*  Description:
+*     This function returns a pointer to the memory in which the KeyMap
+*     stores the value associated with a given key, together with the
+*     native data type and number of elements of the value. No copy of
+*     the value is made and no data type conversion is performed, so this
+*     can be used to avoid copying large vector values that are only to
+*     be read.
+
+*  Parameters:
+*     this
+*        Pointer to the KeyMap.
+*     key
+*        The character string identifying the KeyMap entry. Trailing
+*        spaces are ignored. The supplied string is converted to upper
+*        case before use if the KeyCase attribute is currently set to zero.
+*     type
+*        Pointer to a location at which to return the data type of the
+*        value (one of the data type constants such as AST__DOUBLETYPE
+*        defined in keymap.h).
+*     nel
+*        Pointer to a location at which to return the number of elements
+*        in the value (1 for a scalar value).
+
+*  Returned Value:
+*     A pointer to the first element of the stored value. For string
+*     values this is a pointer to an array of "const char *" pointers,
+*     and for Object values it is a pointer to an array of "AstObject *"
+*     pointers. NULL is returned if the key is not found or has an
+*     undefined value.
+
+*  Notes:
+*     - The returned pointer is owned by the KeyMap and must not be used
+*     to modify the value or be freed. It becomes invalid as soon as the
+*     entry is changed or removed, or the KeyMap is deleted.
+*     - The KeyMap's own entries are accessed directly, so any over-riding
+*     of the astMapGet1<X> methods by sub-classes is ignored.
+*     - NULL is returned if an error has already occurred, or if this
+*     function should fail for any reason.
+*-
+*/
+
+/* Local Variables: */
+   AstMapEntry *mapentry;  /* Pointer to entry in linked list */
+   const char *key;        /* Pointer to key string to use */
+   char keybuf[ AST__MXKEYLEN + 1 ]; /* Buffer for upper case key */
+   const void *result;     /* Returned pointer */
+   int itab;               /* Index of hash table element to use */
+   unsigned long hash;     /* Full width hash value */
+
+/* Initialise */
+   result = NULL;
+   *type = AST__BADTYPE;
+   *nel = 0;
+
+/* Check the global error status. */
+   if ( !astOK ) return result;
+
+/* Convert the supplied key to upper case if required. */
+   key = ConvertKey( this, skey, keybuf, AST__MXKEYLEN + 1, "astMapValuePtr",
+                     status );
+
+/* Use the hash function to determine the element of the hash table in
+   which the key will be stored. */
+   itab = HashFun( key, this->mapsize - 1, &hash, status );
+
+/* Search the relevent table entry for the required MapEntry. */
+   mapentry = SearchTableEntry( this, itab, key, hash, status );
+
+/* If found, return a pointer to the stored value, its type and length. */
+   if( mapentry ) {
+      result = EntryValue( mapentry, status );
+      if( result ) {
+         *type = mapentry->type;
+         *nel = mapentry->nel ? mapentry->nel : 1;
+      }
+   }
+
+/* If an error has occurred, return NULL. */
+   if( !astOK ) {
+      result = NULL;
+      *type = AST__BADTYPE;
+      *nel = 0;
+   }
+
+/* Return the result. */
+   return result;
+}
+
 static void MapRemove( AstKeyMap *this, const char *skey, int *status ) {
 /*
 *++
@@ -7600,7 +8183,7 @@ f        The global status.
    itab = HashFun( key, this->mapsize - 1, &hash, status );
 
 /* Search the relevent table entry for the required MapEntry and remove it. */
-   (void) FreeMapEntry( RemoveTableEntry( this, itab, key, status ), status );
+   (void) FreeMapEntry( RemoveTableEntry( this, itab, key, hash, status ), status );
 }
 
 static void MapRename( AstKeyMap *this, const char *soldkey, const char *snewkey,
@@ -7684,7 +8267,7 @@ f        The global status.
 
 /* Search the relevent table entry for the required MapEntry. Remove it
    from the list, but do not free it. */
-      entry = RemoveTableEntry( this, itab, oldkey, status );
+      entry = RemoveTableEntry( this, itab, oldkey, hash, status );
 
 /* Skip rest if the key was not found. */
       if( entry ) {
@@ -7710,7 +8293,7 @@ f        The global status.
 
 /* Remove and free any existing entry with the given key from the table
    element. */
-         oldent = RemoveTableEntry( this, itab, entry->key, status );
+         oldent = RemoveTableEntry( this, itab, entry->key, entry->hash, status );
          if( oldent ) {
             keymember = oldent->keymember;
             oldent = FreeMapEntry( oldent, status );
@@ -7786,7 +8369,6 @@ f     AST_MAPSIZE = INTEGER
 */
 
 /* Local Variables: */
-   int itab;               /* Index of hash table element to use */
    int result;             /* Returned value */
 
 /* Initialise */
@@ -7795,8 +8377,8 @@ f     AST_MAPSIZE = INTEGER
 /* Check the global error status. */
    if ( !astOK ) return result;
 
-/* Add up the number of entries in all elements of the hash table. */
-   for( itab = 0; itab < this->mapsize; itab++ ) result += this->nentry[ itab ];
+/* Return the total number of entries in the hash table. */
+   result = this->ntotal;
 
 /* Return the result. */
    return result;
@@ -7889,7 +8471,7 @@ c        This does not include the trailing null character.
    itab = HashFun( key, this->mapsize - 1, &hash, status );
 
 /* Search the relevent table entry for the required MapEntry. */
-   mapentry = SearchTableEntry( this, itab, key, status );
+   mapentry = SearchTableEntry( this, itab, key, hash, status );
 
 /* Skip rest if the key was not found. */
    if( mapentry ) {
@@ -8091,7 +8673,7 @@ f     AST_MAPLENGTH = INTEGER
    itab = HashFun( key, this->mapsize - 1, &hash, status );
 
 /* Search the relevent table entry for the required MapEntry. */
-   mapentry = SearchTableEntry( this, itab, key, status );
+   mapentry = SearchTableEntry( this, itab, key, hash, status );
 
 /* Skip rest if the key was not found. */
    if( mapentry ) {
@@ -8263,7 +8845,7 @@ static void MapPutElem##X( AstKeyMap *this, const char *skey, int elem, \
    itab = HashFun( key, this->mapsize - 1, &hash, status ); \
 \
 /* Search the relevent table entry for the required MapEntry. */ \
-   mapentry = SearchTableEntry( this, itab, key, status ); \
+   mapentry = SearchTableEntry( this, itab, key, hash, status ); \
 \
 /* If the key was not found, or was found but has an undefined value, create \
    a new one with a single element, \
@@ -8287,7 +8869,7 @@ static void MapPutElem##X( AstKeyMap *this, const char *skey, int elem, \
          if( nel == 0 ) { \
             astMapPut1I( this, key, 1, &( ((Entry0I *)mapentry)->value ), \
                          mapentry->comment ); \
-            mapentry = SearchTableEntry( this, itab, key, status ); \
+            mapentry = SearchTableEntry( this, itab, key, hash, status ); \
             nel = 1; \
          } \
 \
@@ -8301,7 +8883,7 @@ static void MapPutElem##X( AstKeyMap *this, const char *skey, int elem, \
          if( nel == 0 ) { \
             astMapPut1S( this, key, 1, &( ((Entry0S *)mapentry)->value ), \
                          mapentry->comment ); \
-            mapentry = SearchTableEntry( this, itab, key, status ); \
+            mapentry = SearchTableEntry( this, itab, key, hash, status ); \
             nel = 1; \
          } \
          raw = ((Entry1S *)mapentry)->value; \
@@ -8311,7 +8893,7 @@ static void MapPutElem##X( AstKeyMap *this, const char *skey, int elem, \
          if( nel == 0 ) { \
             astMapPut1K( this, key, 1, &( ((Entry0K *)mapentry)->value ), \
                          mapentry->comment ); \
-            mapentry = SearchTableEntry( this, itab, key, status ); \
+            mapentry = SearchTableEntry( this, itab, key, hash, status ); \
             nel = 1; \
          } \
          raw = ((Entry1K *)mapentry)->value; \
@@ -8321,7 +8903,7 @@ static void MapPutElem##X( AstKeyMap *this, const char *skey, int elem, \
          if( nel == 0 ) { \
             astMapPut1B( this, key, 1, &( ((Entry0B *)mapentry)->value ), \
                          mapentry->comment ); \
-            mapentry = SearchTableEntry( this, itab, key, status ); \
+            mapentry = SearchTableEntry( this, itab, key, hash, status ); \
             nel = 1; \
          } \
          raw = ((Entry1B *)mapentry)->value; \
@@ -8331,7 +8913,7 @@ static void MapPutElem##X( AstKeyMap *this, const char *skey, int elem, \
          if( nel == 0 ) { \
             astMapPut1D( this, key, 1, &( ((Entry0D *)mapentry)->value ), \
                          mapentry->comment ); \
-            mapentry = SearchTableEntry( this, itab, key, status ); \
+            mapentry = SearchTableEntry( this, itab, key, hash, status ); \
             nel = 1; \
          } \
          raw = ((Entry1D *)mapentry)->value; \
@@ -8341,7 +8923,7 @@ static void MapPutElem##X( AstKeyMap *this, const char *skey, int elem, \
          if( nel == 0 ) { \
             astMapPut1P( this, key, 1, &( ((Entry0P *)mapentry)->value ), \
                          mapentry->comment ); \
-            mapentry = SearchTableEntry( this, itab, key, status ); \
+            mapentry = SearchTableEntry( this, itab, key, hash, status ); \
             nel = 1; \
          } \
          raw = ((Entry1P *)mapentry)->value; \
@@ -8351,7 +8933,7 @@ static void MapPutElem##X( AstKeyMap *this, const char *skey, int elem, \
          if( nel == 0 ) { \
             astMapPut1F( this, key, 1, &( ((Entry0F *)mapentry)->value ), \
                          mapentry->comment ); \
-            mapentry = SearchTableEntry( this, itab, key, status ); \
+            mapentry = SearchTableEntry( this, itab, key, hash, status ); \
             nel = 1; \
          } \
          raw = ((Entry1F *)mapentry)->value; \
@@ -8361,7 +8943,7 @@ static void MapPutElem##X( AstKeyMap *this, const char *skey, int elem, \
          if( nel == 0 ) { \
             astMapPut1C( this, key, 1, &( ((Entry0C *)mapentry)->value ), \
                          mapentry->comment ); \
-            mapentry = SearchTableEntry( this, itab, key, status ); \
+            mapentry = SearchTableEntry( this, itab, key, hash, status ); \
             nel = 1; \
          } \
          raw = ((Entry1C *)mapentry)->value; \
@@ -8371,7 +8953,7 @@ static void MapPutElem##X( AstKeyMap *this, const char *skey, int elem, \
          if( nel == 0 ) { \
             astMapPut1A( this, key, 1, &( ((Entry0A *)mapentry)->value ), \
                          mapentry->comment ); \
-            mapentry = SearchTableEntry( this, itab, key, status ); \
+            mapentry = SearchTableEntry( this, itab, key, hash, status ); \
             nel = 1; \
          } \
          raw = ((Entry1A *)mapentry)->value; \
@@ -8581,7 +9163,7 @@ f        AST_MAPPUTU).
    itab = HashFun( key, this->mapsize - 1, &hash, status );
 
 /* Search the relevent table entry for the required MapEntry. */
-   mapentry = SearchTableEntry( this, itab, key, status );
+   mapentry = SearchTableEntry( this, itab, key, hash, status );
 
 /* Store the type if found. */
    if( mapentry ) result = mapentry->type;
@@ -8783,6 +9365,134 @@ static void NewTable( AstKeyMap *this, int size, int *status ){
    }
 }
 
+static void PutEntry0( AstKeyMap *this, AstMapEntry *mapentry,
+                       const char *key, const unsigned long *hash,
+                       const char *comment, const char *method,
+                       int *status ){
+/*
+*  Name:
+*     PutEntry0
+
+*  Purpose:
+*     Add a new scalar MapEntry to a KeyMap.
+
+*  Type:
+*     Private function.
+
+*  Synopsis:
+*     #include "keymap.h"
+*     void PutEntry0( AstKeyMap *this, AstMapEntry *mapentry,
+*                     const char *key, const unsigned long *hash,
+*                     const char *comment, const char *method,
+*                     int *status )
+
+*  Class Membership:
+*     KeyMap member function.
+
+*  Description:
+*     This function stores the key and comment in a new MapEntry that has
+*     been initialised and which already holds its value, and then adds
+*     the MapEntry to the KeyMap, replacing any existing entry with the
+*     same key. It implements the parts of astMapPut0<X> and astMapPut0H
+*     that do not depend on the data type.
+
+*  Parameters:
+*     this
+*        Pointer to the KeyMap.
+*     mapentry
+*        Pointer to the new MapEntry. It is freed if an error occurs.
+*     key
+*        The key for the new entry, already converted to upper case if
+*        required. Trailing spaces are ignored.
+*     hash
+*        Pointer to the full width hash value for the key, or NULL if the
+*        hash value should be calculated.
+*     comment
+*        A pointer to a null-terminated comment string to be stored with
+*        the value. May be NULL.
+*     method
+*        The name of the calling method - for use in error messages only.
+*     status
+*        Pointer to the inherited status variable.
+
+*  Notes:
+*     - This function attempts to execute even if an error has already
+*     occurred, in order to free the supplied MapEntry.
+*/
+
+/* Local Variables: */
+   AstMapEntry *oldent;    /* Pointer to existing MapEntry */
+   char *p;                /* Pointer to next key character */
+   int itab;               /* Index of hash table element to use */
+   int keylen;             /* Length of supplied key string */
+   int keymember;          /* Identifier for existing key */
+   int there;              /* Did the entry already exist in the KeyMap? */
+
+/* Free the MapEntry if an error has already occurred. */
+   if( !astOK ) {
+      mapentry = FreeMapEntry( mapentry, status );
+      return;
+   }
+
+/* Store the key and comment. */
+   keylen = strlen( key );
+   mapentry->key = astStore( NULL, key, keylen + 1 );
+   if( comment ) mapentry->comment = astStore( NULL, comment, strlen( comment ) + 1 );
+   mapentry->defined = 1;
+
+/* Terminate the key string to exclude any trailing spaces. */
+   if( astOK ) {
+      p = (char *) mapentry->key + keylen;
+      while( --p >= mapentry->key ) {
+         if( *p == ' ' ) {
+            *p = 0;
+         } else {
+            break;
+         }
+      }
+   }
+
+/* Use the supplied hash value, or the hash function, to determine the
+   element of the hash table in which to store the new entry. */
+   if( hash ) {
+      mapentry->hash = *hash;
+      itab = *hash & ( this->mapsize - 1 );
+   } else {
+      itab = HashFun( mapentry->key, this->mapsize - 1, &(mapentry->hash),
+                      status );
+   }
+
+/* Remove any existing entry with the given key from the table element.
+   First save the key identifier. */
+   oldent = RemoveTableEntry( this, itab, mapentry->key, mapentry->hash, status );
+   if( oldent ) {
+      keymember = oldent->keymember;
+      oldent = FreeMapEntry( oldent, status );
+      there = 1;
+   } else {
+      keymember = -1;
+      there = 0;
+   }
+
+/* If the KeyMap is locked we report an error if an attempt is made to add a value for
+   a new key. */
+   if( !there && astGetMapLocked( this ) ) {
+      astError( AST__BADKEY, "%s(%s): Failed to add item \"%s\" to a KeyMap: "
+                "\"%s\" is not a known item.", status, method,
+                astGetClass( this ), key, key );
+   }
+
+/* If all has gone OK, store the new entry at the head of the linked list
+   associated with the selected table entry. */
+   if( astOK ) {
+      mapentry = AddTableEntry( this, itab, mapentry, keymember, status );
+
+/* If anything went wrong, try to delete the new entry. */
+   } else {
+      mapentry = FreeMapEntry( mapentry, status );
+   }
+}
+
 static void RemoveFromObjectList( AstKeyMap *this, AstMapEntry *entry,
                                   int *status ){
 /*
@@ -8944,7 +9654,8 @@ static void RemoveFromSortedList( AstKeyMap *this, AstMapEntry *entry,
 }
 
 static AstMapEntry *RemoveTableEntry( AstKeyMap *this, int itab,
-                                      const char *key, int *status ){
+                                      const char *key, unsigned long hash,
+                                      int *status ){
 /*
 *  Name:
 *     RemoveTableEntry
@@ -8958,7 +9669,8 @@ static AstMapEntry *RemoveTableEntry( AstKeyMap *this, int itab,
 *  Synopsis:
 *     #include "keymap.h"
 *     AstMapEntry *RemoveTableEntry( AstKeyMap *this, int itab,
-*                                    const char *key, int *status )
+*                                    const char *key, unsigned long hash,
+*                                    int *status )
 
 *  Class Membership:
 *     KeyMap member function.
@@ -8976,6 +9688,8 @@ static AstMapEntry *RemoveTableEntry( AstKeyMap *this, int itab,
 *        Index of the hash table element to be searched.
 *     key
 *        The key string to be searched for. Trailing spaces are ignored.
+*     hash
+*        The full width hash value for "key", as returned by HashFun.
 *     status
 *        Pointer to the inherited status variable.
 
@@ -9008,8 +9722,10 @@ static AstMapEntry *RemoveTableEntry( AstKeyMap *this, int itab,
 /* Loop round until we have checked all entries. */
    while( next && astOK ) {
 
-/* If the key for the current entry macthes the supplied key... */
-      if( !KeyCmp( next->key, key ) ) {
+/* If the key for the current entry macthes the supplied key... Compare
+   the full width hash values first, since this is much cheaper than a
+   string comparison and rejects nearly all non-matching entries. */
+      if( next->hash == hash && !KeyCmp( next->key, key ) ) {
 
 /* Remove the MapEntry from the list sorted by key. */
          RemoveFromSortedList( this, next, status );
@@ -9030,8 +9746,10 @@ static AstMapEntry *RemoveTableEntry( AstKeyMap *this, int itab,
             result = next;
          }
 
-/* Decrement the number of entries in the linked list. */
+/* Decrement the number of entries in the linked list, and in the
+   KeyMap. */
          this->nentry[ itab ]--;
+         this->ntotal--;
 
 /* Set up the next MapEntry to be freed. */
          next = *link;
@@ -9052,7 +9770,8 @@ static AstMapEntry *RemoveTableEntry( AstKeyMap *this, int itab,
    return result;
 }
 
-static AstMapEntry *SearchTableEntry( AstKeyMap *this, int itab, const char *key, int *status ){
+static AstMapEntry *SearchTableEntry( AstKeyMap *this, int itab, const char *key,
+                                      unsigned long hash, int *status ){
 /*
 *  Name:
 *     SearchTableEntry
@@ -9065,7 +9784,8 @@ static AstMapEntry *SearchTableEntry( AstKeyMap *this, int itab, const char *key
 
 *  Synopsis:
 *     #include "keymap.h"
-*     AstMapEntry *SearchTableEntry( AstKeyMap *this, int itab, const char *key, int *status )
+*     AstMapEntry *SearchTableEntry( AstKeyMap *this, int itab, const char *key,
+*                                    unsigned long hash, int *status )
 
 *  Class Membership:
 *     KeyMap member function.
@@ -9075,6 +9795,10 @@ static AstMapEntry *SearchTableEntry( AstKeyMap *this, int itab, const char *key
 *     until an element is found which has a key matching the supplied key.
 *     The address of this entry is returned. If no suitable entry is found,
 *     then NULL is returned.
+*
+*     Each MapEntry records the full width hash value of its key, so the
+*     string comparison is only performed for entries that have the same
+*     full width hash value as the supplied key.
 
 *  Parameters:
 *     this
@@ -9083,6 +9807,8 @@ static AstMapEntry *SearchTableEntry( AstKeyMap *this, int itab, const char *key
 *        The index of the hash table to be searched.
 *     key
 *        The key string to be searched for. Trailing spaces are ignored.
+*     hash
+*        The full width hash value for "key", as returned by HashFun.
 *     status
 *        Pointer to the inherited status variable.
 
@@ -9111,7 +9837,7 @@ static AstMapEntry *SearchTableEntry( AstKeyMap *this, int itab, const char *key
 
 /* If the key for the current entry matches the supplied key, store the
    MapEntry pointer and break. */
-      if( !KeyCmp( next->key, key ) ) {
+      if( next->hash == hash && !KeyCmp( next->key, key ) ) {
          result = next;
          break;
       }
@@ -10818,6 +11544,7 @@ AstKeyMap *astInitKeyMap_( void *mem, size_t size, int init, AstKeyMapVtab *vtab
       new->mapsize = 0;
       new->table = NULL;
       new->nentry = NULL;
+      new->ntotal = 0;
       new->keycase = -1;
       new->keyerror = -INT_MAX;
       new->maplocked = -INT_MAX;
@@ -10976,6 +11703,7 @@ AstKeyMap *astLoadKeyMap_( void *mem, size_t size, AstKeyMapVtab *vtab,
       new->mapsize = 0;
       new->table = NULL;
       new->nentry = NULL;
+      new->ntotal = 0;
       new->firstA = NULL;
       new->iter_itab = 0;
       new->iter_entry = NULL;
@@ -11428,6 +12156,31 @@ const char *astMapIterate_( AstKeyMap *this, int reset, int *status ){
    if ( !astOK ) return NULL;
    return (**astMEMBER(this,KeyMap,MapIterate))(this,reset,status);
 }
+void astMapKeyHandle_( AstKeyMap *this, const char *key,
+                       AstMapKeyHandle *handle, int *status ){
+   if ( !astOK ) return;
+   (**astMEMBER(this,KeyMap,MapKeyHandle))(this,key,handle,status);
+}
+int astMapGet0H_( AstKeyMap *this, const AstMapKeyHandle *handle, int type,
+                  void *value, int *status ){
+   if ( !astOK ) return 0;
+   return (**astMEMBER(this,KeyMap,MapGet0H))(this,handle,type,value,status);
+}
+void astMapPut0H_( AstKeyMap *this, const AstMapKeyHandle *handle, int type,
+                   const void *value, const char *comment, int *status ){
+   if ( !astOK ) return;
+   (**astMEMBER(this,KeyMap,MapPut0H))(this,handle,type,value,comment,status);
+}
+int astMapHasKeyH_( AstKeyMap *this, const AstMapKeyHandle *handle,
+                    int *status ){
+   if ( !astOK ) return 0;
+   return (**astMEMBER(this,KeyMap,MapHasKeyH))(this,handle,status);
+}
+const void *astMapValuePtr_( AstKeyMap *this, const char *key, int *type,
+                             int *nel, int *status ){
+   if ( !astOK ) return NULL;
+   return (**astMEMBER(this,KeyMap,MapValuePtr))(this,key,type,nel,status);
+}
 int astGetSizeGuess_( AstKeyMap *this, int *status ){
    if( !astOK ) return 0;
    return (**astMEMBER(this,KeyMap,GetSizeGuess))(this,status);
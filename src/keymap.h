@@ -137,6 +137,7 @@ typedef struct AstKeyMap {
    AstMapEntry **table;            /* Hash table containing pointers to
                                       the KeyMap entries */
    int *nentry;                    /* No. of Entries in each table element */
+   int ntotal;                     /* Total no. of Entries in the KeyMap */
    int mapsize;                    /* Length of table */
    int keycase;                    /* Are keys case sensitive? */
    int keyerror;                   /* Report error if no key? */
@@ -155,6 +156,18 @@ typedef struct AstKeyMap {
 /* This table contains all information that is the same for all
    objects in the class (e.g. pointers to its virtual functions). */
 #if defined(astCLASS)            /* Protected */
+
+/* This structure holds a key that has been prepared by astMapKeyHandle
+   so that it can be used repeatedly to access KeyMap entries without
+   needing to be case-folded and hashed again each time. Its contents
+   should not be modified. */
+typedef struct AstMapKeyHandle {
+   char key[ AST__MXKEYLEN + 1 ]; /* Key string, upper case if required */
+   char orig[ AST__MXKEYLEN + 1 ];/* Key string as supplied */
+   unsigned long hash;            /* Full width hash value for "key" */
+   int keycase;                   /* KeyCase value used to form "key" */
+} AstMapKeyHandle;
+
 typedef struct AstKeyMapVtab {
 
 /* Properties (e.g. methods) inherited from the parent class. */
@@ -232,6 +245,11 @@ typedef struct AstKeyMapVtab {
    int (* MapDefined)( AstKeyMap *, const char *, int * );
    const char *(* MapIterate)( AstKeyMap *, int, int * );
    const char *(* MapKey)( AstKeyMap *, int, int * );
+   void (* MapKeyHandle)( AstKeyMap *, const char *, AstMapKeyHandle *, int * );
+   int (* MapGet0H)( AstKeyMap *, const AstMapKeyHandle *, int, void *, int * );
+   void (* MapPut0H)( AstKeyMap *, const AstMapKeyHandle *, int, const void *, const char *, int * );
+   int (* MapHasKeyH)( AstKeyMap *, const AstMapKeyHandle *, int * );
+   const void *(* MapValuePtr)( AstKeyMap *, const char *, int *, int *, int * );
 
    int (* GetSizeGuess)( AstKeyMap *, int * );
    int (* TestSizeGuess)( AstKeyMap *, int * );
@@ -396,6 +414,11 @@ void astMapRename_( AstKeyMap *, const char *, const char *, int * );
 
 #if defined(astCLASS)            /* Protected */
 const char *astMapIterate_( AstKeyMap *, int, int * );
+void astMapKeyHandle_( AstKeyMap *, const char *, AstMapKeyHandle *, int * );
+int astMapGet0H_( AstKeyMap *, const AstMapKeyHandle *, int, void *, int * );
+void astMapPut0H_( AstKeyMap *, const AstMapKeyHandle *, int, const void *, const char *, int * );
+int astMapHasKeyH_( AstKeyMap *, const AstMapKeyHandle *, int * );
+const void *astMapValuePtr_( AstKeyMap *, const char *, int *, int *, int * );
 
 int astGetSizeGuess_( AstKeyMap *, int * );
 int astTestSizeGuess_( AstKeyMap *, int * );
@@ -537,6 +560,11 @@ astINVOKE(O,astLoadKeyMap_(mem,size,vtab,name,astCheckChannel(channel),STATUS_PT
 #define astMapPut1A(this,key,size,value,comment) astINVOKE(V,astMapPut1A_(astCheckKeyMap(this),key,size,value,comment,STATUS_PTR))
 #define astMapGetElemA(this,key,elem,value) astINVOKE(V,astMapGetElemA_(astCheckKeyMap(this),key,elem,(AstObject **)(value),STATUS_PTR))
 #define astMapIterate(this,reset) astINVOKE(V,astMapIterate_(astCheckKeyMap(this),reset,STATUS_PTR))
+#define astMapKeyHandle(this,key,handle) astINVOKE(V,astMapKeyHandle_(astCheckKeyMap(this),key,handle,STATUS_PTR))
+#define astMapGet0H(this,handle,type,value) astINVOKE(V,astMapGet0H_(astCheckKeyMap(this),handle,type,value,STATUS_PTR))
+#define astMapPut0H(this,handle,type,value,comment) astINVOKE(V,astMapPut0H_(astCheckKeyMap(this),handle,type,value,comment,STATUS_PTR))
+#define astMapHasKeyH(this,handle) astINVOKE(V,astMapHasKeyH_(astCheckKeyMap(this),handle,STATUS_PTR))
+#define astMapValuePtr(this,key,type,nel) astINVOKE(V,astMapValuePtr_(astCheckKeyMap(this),key,type,nel,STATUS_PTR))
 
 #define astClearSizeGuess(this) \
 astINVOKE(V,astClearSizeGuess_(astCheckKeyMap(this),STATUS_PTR))
@@ -211,6 +211,10 @@ f     The MatrixMap class does not define any new routines beyond those
    cannot be used as it is used to indicate "determinant not yet found"). */
 #define NODET (AST__BAD/2)
 
+/* The number of points transformed together as a single block by a full
+   MatrixMap. */
+#define MTR_NBLOCK 256
+
 /* Include files. */
 /* ============== */
 /* Interface definitions. */
@@ -229,6 +233,8 @@ f     The MatrixMap class does not define any new routines beyond those
 #include "unitmap.h"
 #include "winmap.h"
 #include "wcsmap.h"
+#include "shiftmap.h"
+#include "cmpmap.h"
 
 /* Error code definitions. */
 /* ----------------------- */
@@ -302,6 +308,8 @@ static AstWinMap *MatWin2( AstMatrixMap *, AstWinMap *, int, int, int, int * );
 static double *InvertMatrix( int, int, int, double *, double *, int * );
 static double *MtrGet( AstMatrixMap *, int, int, int *, int * );
 static double GetDet( AstMatrixMap *, int * );
+static int AffineMap( int, int, double *, double *, double *, double *, AstMapping **, int * );
+static int AffineTerms( AstMapping *, int, int, int *, int *, double **, double **, int * );
 static double Rate( AstMapping *, double *, int, int, int * );
 static int *MapSplit( AstMapping *, int, const int *, AstMapping **, int * );
 static int CanSwap( AstMapping *, AstMapping *, int, int, int *, int * );
@@ -323,11 +331,598 @@ static void Dump( AstObject *, AstChannel *, int * );
 static void ExpandMatrix( AstMatrixMap *, int * );
 static void MatPermSwap( AstMapping **, int *, int, int * );
 static void MatWin( AstMapping **, int *, int, int * );
+static void AffineSeries( int, int, int, const double *, const double *, const double *, const double *, double **, double **, int * );
 static void PermGet( AstPermMap *, int **, int **, double **, int * );
 static void SMtrMult( int, int, int, const double *, double *, double*, int * );
 
 /* Member functions. */
 /* ================= */
+static int AffineMap( int nin, int nout, double *fmat, double *foff,
+                      double *imat, double *ioff, AstMapping **maps,
+                      int *status ){
+/*
+*  Name:
+*     AffineMap
+
+*  Purpose:
+*     Create the simplest Mappings that implement a given affine transform.
+
+*  Type:
+*     Private function.
+
+*  Synopsis:
+*     #include "matrixmap.h"
+*     int AffineMap( int nin, int nout, double *fmat, double *foff,
+*                    double *imat, double *ioff, AstMapping **maps,
+*                    int *status )
+
+*  Class Membership:
+*     MatrixMap member function
+
+*  Description:
+*     This function returns one or two Mappings which, when applied in
+*     series, implement a given affine transformation "out = M.in + C".
+*     The simplest available class is used: UnitMap, ZoomMap, ShiftMap,
+*     WinMap or diagonal MatrixMap if possible, and otherwise a full
+*     MatrixMap followed (if the offset is non-zero) by a ShiftMap.
+*
+*     The inverse transformation is not used to create the returned
+*     Mappings, but it is checked to ensure that it agrees with the
+*     inverse of the forward transformation. No Mappings are returned
+*     if it does not.
+
+*  Parameters:
+*     nin
+*        The number of inputs for the forward transformation.
+*     nout
+*        The number of outputs for the forward transformation.
+*     fmat
+*        The forward matrix M, stored by rows (nout rows of nin elements).
+*     foff
+*        The forward offset vector C (nout elements).
+*     imat
+*        The inverse matrix, stored by rows (nin rows of nout elements).
+*     ioff
+*        The inverse offset vector (nin elements).
+*     maps
+*        An array with room for two Mapping pointers, in which the
+*        returned Mappings are stored. Unused elements are set NULL.
+*     status
+*        Pointer to the inherited status variable.
+
+*  Returned Value:
+*     The number of Mappings returned in "maps" (zero, one or two).
+
+*  Notes:
+*     -  Zero is returned if the transformation is not square, or if the
+*     supplied inverse is not consistent with the supplied forward
+*     transformation.
+*     -  Zero is returned if an error has already occurred, or if this
+*     function should fail for any reason.
+*/
+
+/* Local Variables: */
+   AstWinMap *wm;            /* New WinMap */
+   double *diag;             /* Diagonal matrix elements */
+   double sum;               /* Sum of products */
+   double sumabs;            /* Sum of absolute products */
+   double term;              /* Product of two elements */
+   int i;                    /* Row index */
+   int isdiag;               /* Is the matrix diagonal? */
+   int isunit;               /* Are all diagonal elements unity? */
+   int iszoom;               /* Are all diagonal elements equal? */
+   int j;                    /* Column index */
+   int k;                    /* Summation index */
+   int n;                    /* Number of axes */
+   int noshift;              /* Are all offsets zero? */
+   int result;               /* Returned number of Mappings */
+
+/* Initialise. */
+   result = 0;
+   maps[ 0 ] = NULL;
+   maps[ 1 ] = NULL;
+
+/* Check the global error status. Only square transformations can be
+   represented by a single MatrixMap with both transformations
+   defined. */
+   if ( !astOK || nin != nout ) return result;
+   n = nin;
+
+/* Check that the product of the forward and inverse matrices is a unit
+   matrix, to within rounding error. */
+   for( i = 0; i < n; i++ ) {
+      for( j = 0; j < n; j++ ) {
+         sum = 0.0;
+         sumabs = 0.0;
+         for( k = 0; k < n; k++ ) {
+            term = fmat[ i*n + k ]*imat[ k*n + j ];
+            sum += term;
+            sumabs += fabs( term );
+         }
+         if( i == j ) sum -= 1.0;
+         if( fabs( sum ) > 1.0E-10*sumabs || ( i == j && sumabs == 0.0 ) ) {
+            return result;
+         }
+      }
+   }
+
+/* Check that the forward transformation maps the inverse offset onto
+   the origin, to within rounding error. */
+   for( i = 0; i < n; i++ ) {
+      sum = foff[ i ];
+      sumabs = fabs( foff[ i ] );
+      for( k = 0; k < n; k++ ) {
+         term = fmat[ i*n + k ]*ioff[ k ];
+         sum += term;
+         sumabs += fabs( term );
+      }
+      if( fabs( sum ) > 1.0E-10*sumabs ) return result;
+   }
+
+/* Classify the matrix and offset. */
+   isdiag = 1;
+   for( i = 0; i < n && isdiag; i++ ) {
+      for( j = 0; j < n; j++ ) {
+         if( i != j && fmat[ i*n + j ] != 0.0 ) {
+            isdiag = 0;
+            break;
+         }
+      }
+   }
+
+   noshift = 1;
+   for( i = 0; i < n; i++ ) {
+      if( foff[ i ] != 0.0 ) noshift = 0;
+   }
+
+/* First deal with diagonal matrices. Extract the diagonal elements and
+   see if they are all equal, and all unity. */
+   if( isdiag ) {
+      diag = astMalloc( sizeof( double )*(size_t) n );
+      if( astOK ) {
+         isunit = 1;
+         iszoom = 1;
+         for( i = 0; i < n; i++ ) {
+            diag[ i ] = fmat[ i*n + i ];
+            if( diag[ i ] != 1.0 ) isunit = 0;
+            if( diag[ i ] != diag[ 0 ] ) iszoom = 0;
+         }
+
+/* With no offset, use a UnitMap, ZoomMap or diagonal MatrixMap. */
+         if( noshift ) {
+            if( isunit ) {
+               maps[ 0 ] = (AstMapping *) astUnitMap( n, "", status );
+            } else if( iszoom ) {
+               maps[ 0 ] = (AstMapping *) astZoomMap( n, diag[ 0 ], "", status );
+            } else {
+               maps[ 0 ] = (AstMapping *) astMatrixMap( n, n, 1, diag, "", status );
+            }
+
+/* With a unit matrix, use a ShiftMap. */
+         } else if( isunit ) {
+            maps[ 0 ] = (AstMapping *) astShiftMap( n, foff, "", status );
+
+/* Otherwise, use a WinMap, storing the scale and shift terms directly
+   to avoid the rounding errors that would be introduced by going via
+   window corners. */
+         } else {
+            wm = astWinMap( n, NULL, NULL, NULL, NULL, "", status );
+            if( astOK ) {
+               for( i = 0; i < n; i++ ) {
+                  wm->a[ i ] = foff[ i ];
+                  wm->b[ i ] = diag[ i ];
+               }
+            }
+            maps[ 0 ] = (AstMapping *) wm;
+         }
+      }
+      diag = astFree( diag );
+
+/* Full matrices are represented by a MatrixMap followed if necessary by
+   a ShiftMap. */
+   } else {
+      maps[ 0 ] = (AstMapping *) astMatrixMap( n, n, 0, fmat, "", status );
+      if( !noshift ) {
+         maps[ 1 ] = (AstMapping *) astShiftMap( n, foff, "", status );
+      }
+   }
+
+/* Return the number of Mappings created. */
+   if( astOK ) {
+      result = maps[ 1 ] ? 2 : 1;
+   } else {
+      if( maps[ 0 ] ) maps[ 0 ] = astAnnul( maps[ 0 ] );
+      if( maps[ 1 ] ) maps[ 1 ] = astAnnul( maps[ 1 ] );
+   }
+   return result;
+}
+
+static void AffineSeries( int nin, int nmid, int nout, const double *mat1,
+                          const double *off1, const double *mat2,
+                          const double *off2, double **mat, double **off,
+                          int *status ){
+/*
+*  Name:
+*     AffineSeries
+
+*  Purpose:
+*     Combine two affine transformations in series.
+
+*  Type:
+*     Private function.
+
+*  Synopsis:
+*     #include "matrixmap.h"
+*     void AffineSeries( int nin, int nmid, int nout, const double *mat1,
+*                        const double *off1, const double *mat2,
+*                        const double *off2, double **mat, double **off,
+*                        int *status )
+
+*  Class Membership:
+*     MatrixMap member function
+
+*  Description:
+*     This function returns the matrix and offset of the affine
+*     transformation formed by applying "out = mat1.in + off1" followed by
+*     "out = mat2.in + off2". The returned matrix is "mat2.mat1" and the
+*     returned offset is "mat2.off1 + off2".
+
+*  Parameters:
+*     nin
+*        The number of inputs for the first transformation.
+*     nmid
+*        The number of outputs for the first transformation, which must
+*        equal the number of inputs for the second transformation.
+*     nout
+*        The number of outputs for the second transformation.
+*     mat1
+*        The first matrix, stored by rows (nmid rows of nin elements).
+*     off1
+*        The first offset vector (nmid elements).
+*     mat2
+*        The second matrix, stored by rows (nout rows of nmid elements).
+*     off2
+*        The second offset vector (nout elements).
+*     mat
+*        Address at which to return a pointer to a dynamically allocated
+*        array holding the combined matrix (nout rows of nin elements).
+*     off
+*        Address at which to return a pointer to a dynamically allocated
+*        array holding the combined offset vector (nout elements).
+*     status
+*        Pointer to the inherited status variable.
+
+*  Notes:
+*     -  The returned arrays should be freed using astFree when no longer
+*     needed.
+*     -  NULL pointers are returned if an error has already occurred, or
+*     if this function should fail for any reason.
+*/
+
+/* Local Variables: */
+   double sum;               /* Sum of products */
+   int i;                    /* Row index */
+   int j;                    /* Column index */
+   int k;                    /* Summation index */
+
+/* Initialise. */
+   *mat = NULL;
+   *off = NULL;
+
+/* Check the global error status. */
+   if ( !astOK ) return;
+
+/* Allocate the returned arrays. */
+   *mat = astMalloc( sizeof( double )*(size_t)( nout*nin ) );
+   *off = astMalloc( sizeof( double )*(size_t) nout );
+   if( astOK ) {
+
+/* Form each row of the combined matrix and offset. */
+      for( i = 0; i < nout; i++ ) {
+         for( j = 0; j < nin; j++ ) {
+            sum = 0.0;
+            for( k = 0; k < nmid; k++ ) {
+               sum += mat2[ i*nmid + k ]*mat1[ k*nin + j ];
+            }
+            (*mat)[ i*nin + j ] = sum;
+         }
+
+         sum = off2[ i ];
+         for( k = 0; k < nmid; k++ ) sum += mat2[ i*nmid + k ]*off1[ k ];
+         (*off)[ i ] = sum;
+      }
+   }
+}
+
+static int AffineTerms( AstMapping *map, int invert, int fwd, int *nin,
+                        int *nout, double **matrix, double **offset,
+                        int *status ){
+/*
+*  Name:
+*     AffineTerms
+
+*  Purpose:
+*     Get the matrix and offset describing an affine Mapping.
+
+*  Type:
+*     Private function.
+
+*  Synopsis:
+*     #include "matrixmap.h"
+*     int AffineTerms( AstMapping *map, int invert, int fwd, int *nin,
+*                      int *nout, double **matrix, double **offset,
+*                      int *status )
+
+*  Class Membership:
+*     MatrixMap member function
+
+*  Description:
+*     If the supplied Mapping is known to be an affine transformation
+*     "out = M.in + C", this function returns the matrix M and offset
+*     vector C for a requested direction of the Mapping. Mappings are
+*     recognised as affine if they are UnitMaps, ZoomMaps, ShiftMaps,
+*     WinMaps, MatrixMaps or PermMaps (with constants), or are CmpMaps
+*     (series or parallel) that contain only such Mappings. Other
+*     Mappings are not recognised, even if they are linear.
+
+*  Parameters:
+*     map
+*        Pointer to the Mapping.
+*     invert
+*        The value of the Invert attribute to use with the Mapping.
+*     fwd
+*        If non-zero, return terms describing the forward transformation.
+*        Otherwise, return terms describing the inverse transformation.
+*     nin
+*        Returned holding the number of inputs for the requested
+*        transformation.
+*     nout
+*        Returned holding the number of outputs for the requested
+*        transformation.
+*     matrix
+*        Address at which to return a pointer to a dynamically allocated
+*        array holding the matrix M, stored by rows (nout rows of nin
+*        elements).
+*     offset
+*        Address at which to return a pointer to a dynamically allocated
+*        array holding the offset vector C (nout elements).
+*     status
+*        Pointer to the inherited status variable.
+
+*  Returned Value:
+*     Non-zero if the Mapping is affine and has both forward and inverse
+*     transformations defined, and zero otherwise.
+
+*  Notes:
+*     -  The returned arrays should be freed using astFree when no longer
+*     needed. NULL pointers are returned if zero is returned.
+*     -  The Invert attribute of the supplied Mapping is temporarily
+*     modified but is returned to its original state on exit, as is
+*     its IsSimple flag.
+*     -  Zero is returned if an error has already occurred, or if this
+*     function should fail for any reason.
+*/
+
+/* Local Variables: */
+   AstMapping *map1;         /* First component Mapping */
+   AstMapping *map2;         /* Second component Mapping */
+   double *cnst;             /* PermMap constants */
+   double *mat;              /* Matrix from MatrixMap */
+   double *mat1;             /* Matrix for first component */
+   double *mat2;             /* Matrix for second component */
+   double *off1;             /* Offset for first component */
+   double *off2;             /* Offset for second component */
+   double *scale;            /* WinMap scale terms */
+   double *shift;            /* ShiftMap or WinMap shift terms */
+   double zoom;              /* ZoomMap factor */
+   int *inprm;               /* PermMap input axis permutation */
+   int *outprm;              /* PermMap output axis permutation */
+   int *perm;                /* Permutation for requested direction */
+   int form;                 /* MatrixMap storage form */
+   int i;                    /* Axis index */
+   int inv1;                 /* Invert flag for first component */
+   int inv2;                 /* Invert flag for second component */
+   int j;                    /* Axis index */
+   int nin1;                 /* Inputs for first component */
+   int nin2;                 /* Inputs for second component */
+   int nout1;                /* Outputs for first component */
+   int nout2;                /* Outputs for second component */
+   int old_inv;              /* Original Invert value */
+   int result;               /* Returned flag */
+   int series;               /* Is a CmpMap a series CmpMap? */
+   int set;                  /* Was the Invert attribute set? */
+   int simple;               /* Had the Mapping been simplified? */
+
+/* Initialise. */
+   result = 0;
+   *nin = 0;
+   *nout = 0;
+   *matrix = NULL;
+   *offset = NULL;
+
+/* Check the global error status. */
+   if ( !astOK ) return result;
+
+/* Temporarily set the Invert attribute to the required value. Setting
+   it clears the IsSimple flag, so note its original value. */
+   set = astTestInvert( map );
+   old_inv = astGetInvert( map );
+   simple = astGetIsSimple( map );
+   astSetInvert( map, invert );
+
+/* Both transformations must be available. */
+   if( astGetTranForward( map ) && astGetTranInverse( map ) ) {
+
+/* Get the dimensions of the requested transformation, and allocate a
+   unit matrix and zero offset, which are then modified as required. */
+      *nin = fwd ? astGetNin( map ) : astGetNout( map );
+      *nout = fwd ? astGetNout( map ) : astGetNin( map );
+      *matrix = astCalloc( (size_t)( (*nin)*(*nout) ), sizeof( double ) );
+      *offset = astCalloc( (size_t)( *nout ), sizeof( double ) );
+      if( astOK && *nin == *nout ) {
+         for( i = 0; i < *nin; i++ ) (*matrix)[ i*(*nin) + i ] = 1.0;
+      }
+
+      if( !astOK ) {
+
+/* UnitMaps need no further changes. */
+      } else if( astIsAUnitMap( map ) ) {
+         result = 1;
+
+/* ZoomMaps multiply the diagonal by the zoom factor or its reciprocal. */
+      } else if( astIsAZoomMap( map ) ) {
+         zoom = astGetZoom( map );
+         if( zoom != 0.0 && zoom != AST__BAD ) {
+            if( astGetInvert( map ) ) zoom = 1.0/zoom;
+            if( !fwd ) zoom = 1.0/zoom;
+            for( i = 0; i < *nin; i++ ) (*matrix)[ i*(*nin) + i ] = zoom;
+            result = 1;
+         }
+
+/* ShiftMaps add or subtract the shifts (astGetShifts takes account of
+   the Invert attribute). */
+      } else if( astIsAShiftMap( map ) ) {
+         shift = astGetShifts( map );
+         if( astOK ) {
+            result = 1;
+            for( i = 0; i < *nout; i++ ) {
+               if( shift[ i ] == AST__BAD ) result = 0;
+               (*offset)[ i ] = fwd ? shift[ i ] : -shift[ i ];
+            }
+         }
+         shift = astFree( shift );
+
+/* WinMaps have a scale and shift on each axis (astWinTerms takes account
+   of the Invert attribute). */
+      } else if( astIsAWinMap( map ) ) {
+         (void) astWinTerms( (AstWinMap *) map, 0, &shift, &scale );
+         if( astOK ) {
+            result = 1;
+            for( i = 0; i < *nout; i++ ) {
+               if( scale[ i ] == AST__BAD || shift[ i ] == AST__BAD ||
+                   scale[ i ] == 0.0 ) {
+                  result = 0;
+               } else if( fwd ) {
+                  (*matrix)[ i*(*nin) + i ] = scale[ i ];
+                  (*offset)[ i ] = shift[ i ];
+               } else {
+                  (*matrix)[ i*(*nin) + i ] = 1.0/scale[ i ];
+                  (*offset)[ i ] = -shift[ i ]/scale[ i ];
+               }
+            }
+         }
+         shift = astFree( shift );
+         scale = astFree( scale );
+
+/* MatrixMaps supply a matrix and no offset (MtrGet takes account of the
+   Invert attribute). */
+      } else if( astIsAMatrixMap( map ) ) {
+         mat = MtrGet( (AstMatrixMap *) map, fwd, 1, &form, status );
+         if( astOK ) {
+            result = 1;
+            for( i = 0; i < (*nin)*(*nout); i++ ) {
+               if( mat[ i ] == AST__BAD ) result = 0;
+               (*matrix)[ i ] = mat[ i ];
+            }
+         }
+         mat = astFree( mat );
+
+/* PermMaps copy each output either from an input or from a constant. */
+      } else if( astIsAPermMap( map ) ) {
+         PermGet( (AstPermMap *) map, &outprm, &inprm, &cnst, status );
+         if( astOK ) {
+            perm = fwd ? outprm : inprm;
+            result = 1;
+            for( i = 0; i < (*nout)*(*nin); i++ ) (*matrix)[ i ] = 0.0;
+            for( i = 0; i < *nout; i++ ) {
+               j = perm[ i ];
+               if( j >= 0 && j < *nin ) {
+                  (*matrix)[ i*(*nin) + j ] = 1.0;
+               } else if( j < 0 && cnst[ -j - 1 ] != AST__BAD ) {
+                  (*offset)[ i ] = cnst[ -j - 1 ];
+               } else {
+                  result = 0;
+               }
+            }
+         }
+         outprm = astFree( outprm );
+         inprm = astFree( inprm );
+         cnst = astFree( cnst );
+
+/* CmpMaps are affine if both components are affine. */
+      } else if( astIsACmpMap( map ) ) {
+         astDecompose( map, &map1, &map2, &series, &inv1, &inv2 );
+         if( AffineTerms( map1, inv1, fwd, &nin1, &nout1, &mat1, &off1,
+                          status ) ) {
+            if( AffineTerms( map2, inv2, fwd, &nin2, &nout2, &mat2, &off2,
+                             status ) ) {
+               *matrix = astFree( *matrix );
+               *offset = astFree( *offset );
+
+/* In series, the forward transformation applies map1 followed by map2,
+   and the inverse transformation applies map2 followed by map1. */
+               if( series ) {
+                  if( fwd ) {
+                     AffineSeries( nin1, nout1, nout2, mat1, off1, mat2,
+                                   off2, matrix, offset, status );
+                  } else {
+                     AffineSeries( nin2, nout2, nout1, mat2, off2, mat1,
+                                   off1, matrix, offset, status );
+                  }
+                  result = astOK;
+
+/* In parallel, form a block-diagonal matrix. */
+               } else {
+                  *matrix = astCalloc( (size_t)( (*nin)*(*nout) ),
+                                       sizeof( double ) );
+                  *offset = astMalloc( sizeof( double )*(size_t)( *nout ) );
+                  if( astOK ) {
+                     for( i = 0; i < nout1; i++ ) {
+                        for( j = 0; j < nin1; j++ ) {
+                           (*matrix)[ i*(*nin) + j ] = mat1[ i*nin1 + j ];
+                        }
+                        (*offset)[ i ] = off1[ i ];
+                     }
+                     for( i = 0; i < nout2; i++ ) {
+                        for( j = 0; j < nin2; j++ ) {
+                           (*matrix)[ ( i + nout1 )*(*nin) + j + nin1 ] =
+                                                         mat2[ i*nin2 + j ];
+                        }
+                        (*offset)[ i + nout1 ] = off2[ i ];
+                     }
+                     result = 1;
+                  }
+               }
+               mat2 = astFree( mat2 );
+               off2 = astFree( off2 );
+            }
+            mat1 = astFree( mat1 );
+            off1 = astFree( off1 );
+         }
+         map1 = astAnnul( map1 );
+         map2 = astAnnul( map2 );
+      }
+   }
+
+/* Re-instate the original Invert attribute and IsSimple flag. */
+   if( set ) {
+      astSetInvert( map, old_inv );
+   } else {
+      astClearInvert( map );
+   }
+   if( simple ) astSetIsSimple( map );
+
+/* Free the returned arrays if the Mapping is not affine. */
+   if( !result || !astOK ) {
+      result = 0;
+      *matrix = astFree( *matrix );
+      *offset = astFree( *offset );
+   }
+
+/* Return the result. */
+   return result;
+}
+
 static int CanSwap( AstMapping *map1, AstMapping *map2, int inv1, int inv2,
                     int *simpler, int *status ){
 /*
@@ -3523,6 +4118,275 @@ static AstMatrixMap *MatZoom( AstMatrixMap *mm, AstZoomMap *zm, int minv,
    return result;
 }
 
+int astMergeAffine_( int series, int *nmap, AstMapping ***map_list,
+                     int **invert_list, int *status ){
+/*
+*+
+*  Name:
+*     astMergeAffine
+
+*  Purpose:
+*     Collapse runs of affine Mappings into a single affine stage.
+
+*  Type:
+*     Protected function.
+
+*  Synopsis:
+*     #include "matrixmap.h"
+*     int astMergeAffine( int series, int *nmap, AstMapping ***map_list,
+*                         int **invert_list )
+
+*  Class Membership:
+*     MatrixMap member function
+
+*  Description:
+*     This function searches a list of Mappings that are to be combined
+*     in series or parallel for contiguous runs of Mappings that are all
+*     affine transformations (UnitMaps, ZoomMaps, ShiftMaps, WinMaps,
+*     MatrixMaps, PermMaps and any CmpMaps built from them). Each such
+*     run is replaced by the simplest equivalent Mappings - a single
+*     Mapping of the simplest available class or, for series runs that
+*     involve both a general matrix and an offset, a MatrixMap followed
+*     by a ShiftMap.
+*
+*     It is intended to be used by the astSimplify method of the CmpMap
+*     class once no further pair-wise merging of neighbouring Mappings
+*     is possible (e.g. when affine Mappings of different classes are
+*     interleaved in a way that the astMapMerge methods of the individual
+*     classes cannot handle). A run is replaced only if the replacement
+*     contains fewer Mappings than the run, and (for parallel lists) the
+*     replacement is a single Mapping.
+
+*  Parameters:
+*     series
+*        If non-zero, the Mappings in the list are applied in series.
+*        Otherwise, they are applied in parallel.
+*     nmap
+*        Pointer to an int holding the number of Mappings in the list.
+*        This is updated on exit to reflect any change in the list.
+*     map_list
+*        Address of a pointer to a dynamically allocated array of Mapping
+*        pointers, as used by the astMapMerge method. Mappings that are
+*        removed from the list are annulled, and new Mappings are stored
+*        in their place.
+*     invert_list
+*        Address of a pointer to a dynamically allocated array of Invert
+*        flags corresponding to the Mappings in "*map_list". The flags
+*        for any new Mappings are set to zero.
+
+*  Returned Value:
+*     The index of the first Mapping in the list that was modified, or
+*     -1 if no changes were made.
+
+*  Notes:
+*     -  Runs are only replaced if both the forward and inverse
+*     transformations of every Mapping in the run are defined, and the
+*     combined inverse agrees with the inverse of the combined forward
+*     transformation.
+*     -  A value of -1 is returned if an error has already occurred, or
+*     if this function should fail for any reason.
+*-
+*/
+
+/* Local Variables: */
+   AstMapping *new[ 2 ];     /* Replacement Mappings */
+   double *fmat1;            /* Forward matrix for current Mapping */
+   double *fmat;             /* Forward matrix for run */
+   double *foff1;            /* Forward offset for current Mapping */
+   double *foff;             /* Forward offset for run */
+   double *imat1;            /* Inverse matrix for current Mapping */
+   double *imat;             /* Inverse matrix for run */
+   double *ioff1;            /* Inverse offset for current Mapping */
+   double *ioff;             /* Inverse offset for run */
+   double *tmat;             /* Combined matrix */
+   double *toff;             /* Combined offset */
+   int i;                    /* Row index */
+   int imap;                 /* Index of first Mapping in run */
+   int j;                    /* Column index */
+   int jmap;                 /* Index of next Mapping after run */
+   int nin1;                 /* Inputs for current Mapping */
+   int nin2;                 /* Inverse inputs for current Mapping */
+   int nin;                  /* Inputs for run */
+   int nnew;                 /* Number of replacement Mappings */
+   int nout1;                /* Outputs for current Mapping */
+   int nout2;                /* Inverse outputs for current Mapping */
+   int nout;                 /* Outputs for run */
+   int nrun;                 /* Number of Mappings in run */
+   int result;               /* Returned index */
+
+/* Initialise. */
+   result = -1;
+
+/* Check the global error status. */
+   if ( !astOK ) return result;
+
+/* Loop round each run of affine Mappings in the list. */
+   imap = 0;
+   while( imap < *nmap && astOK ) {
+      fmat = foff = imat = ioff = NULL;
+      nin = nout = 0;
+      nrun = 0;
+
+/* Extend the run for as long as the following Mapping is affine,
+   accumulating the forward and inverse terms of the run so far. */
+      for( jmap = imap; jmap < *nmap && astOK; jmap++ ) {
+         if( !AffineTerms( (*map_list)[ jmap ], (*invert_list)[ jmap ], 1,
+                           &nin1, &nout1, &fmat1, &foff1, status ) ) break;
+         if( !AffineTerms( (*map_list)[ jmap ], (*invert_list)[ jmap ], 0,
+                           &nin2, &nout2, &imat1, &ioff1, status ) ) {
+            fmat1 = astFree( fmat1 );
+            foff1 = astFree( foff1 );
+            break;
+         }
+
+/* The first Mapping in the run just supplies its own terms. */
+         if( nrun == 0 ) {
+            fmat = fmat1;
+            foff = foff1;
+            imat = imat1;
+            ioff = ioff1;
+            nin = nin1;
+            nout = nout1;
+
+/* In series, the forward transformation of the run so far is followed
+   by the forward transformation of the current Mapping, and the
+   inverse transformation of the current Mapping is followed by the
+   inverse transformation of the run so far. */
+         } else if( series ) {
+            AffineSeries( nin, nout, nout1, fmat, foff, fmat1, foff1, &tmat,
+                          &toff, status );
+            fmat = astFree( fmat );
+            foff = astFree( foff );
+            fmat = tmat;
+            foff = toff;
+
+            AffineSeries( nout1, nout, nin, imat1, ioff1, imat, ioff, &tmat,
+                          &toff, status );
+            imat = astFree( imat );
+            ioff = astFree( ioff );
+            imat = tmat;
+            ioff = toff;
+
+            nout = nout1;
+            fmat1 = astFree( fmat1 );
+            foff1 = astFree( foff1 );
+            imat1 = astFree( imat1 );
+            ioff1 = astFree( ioff1 );
+
+/* In parallel, form block-diagonal matrices. */
+         } else {
+            tmat = astCalloc( (size_t)( ( nout + nout1 )*( nin + nin1 ) ),
+                              sizeof( double ) );
+            toff = astMalloc( sizeof( double )*(size_t)( nout + nout1 ) );
+            if( astOK ) {
+               for( i = 0; i < nout; i++ ) {
+                  for( j = 0; j < nin; j++ ) {
+                     tmat[ i*( nin + nin1 ) + j ] = fmat[ i*nin + j ];
+                  }
+                  toff[ i ] = foff[ i ];
+               }
+               for( i = 0; i < nout1; i++ ) {
+                  for( j = 0; j < nin1; j++ ) {
+                     tmat[ ( i + nout )*( nin + nin1 ) + j + nin ] =
+                                                        fmat1[ i*nin1 + j ];
+                  }
+                  toff[ i + nout ] = foff1[ i ];
+               }
+            }
+            fmat = astFree( fmat );
+            foff = astFree( foff );
+            fmat = tmat;
+            foff = toff;
+
+            tmat = astCalloc( (size_t)( ( nout + nout1 )*( nin + nin1 ) ),
+                              sizeof( double ) );
+            toff = astMalloc( sizeof( double )*(size_t)( nin + nin1 ) );
+            if( astOK ) {
+               for( i = 0; i < nin; i++ ) {
+                  for( j = 0; j < nout; j++ ) {
+                     tmat[ i*( nout + nout1 ) + j ] = imat[ i*nout + j ];
+                  }
+                  toff[ i ] = ioff[ i ];
+               }
+               for( i = 0; i < nin1; i++ ) {
+                  for( j = 0; j < nout1; j++ ) {
+                     tmat[ ( i + nin )*( nout + nout1 ) + j + nout ] =
+                                                        imat1[ i*nout1 + j ];
+                  }
+                  toff[ i + nin ] = ioff1[ i ];
+               }
+            }
+            imat = astFree( imat );
+            ioff = astFree( ioff );
+            imat = tmat;
+            ioff = toff;
+
+            nin += nin1;
+            nout += nout1;
+            fmat1 = astFree( fmat1 );
+            foff1 = astFree( foff1 );
+            imat1 = astFree( imat1 );
+            ioff1 = astFree( ioff1 );
+         }
+         nrun++;
+      }
+
+/* If the run contains more than one Mapping, create the simplest
+   equivalent Mappings. */
+      nnew = 0;
+      if( nrun > 1 ) {
+         nnew = AffineMap( nin, nout, fmat, foff, imat, ioff, new, status );
+
+/* Only use them if they are an improvement. Otherwise annul them. */
+         if( nnew >= nrun || ( !series && nnew > 1 ) ) {
+            for( i = 0; i < nnew; i++ ) new[ i ] = astAnnul( new[ i ] );
+            nnew = 0;
+         }
+      }
+
+/* If the run is to be replaced, annul the Mappings in the run and store
+   the new Mappings in their place, shuffling any later Mappings down to
+   fill the gap. */
+      if( nnew > 0 && astOK ) {
+         for( i = imap; i < jmap; i++ ) {
+            (*map_list)[ i ] = astAnnul( (*map_list)[ i ] );
+         }
+
+         for( i = 0; i < nnew; i++ ) {
+            (*map_list)[ imap + i ] = new[ i ];
+            (*invert_list)[ imap + i ] = 0;
+         }
+
+         for( i = jmap; i < *nmap; i++ ) {
+            (*map_list)[ i - nrun + nnew ] = (*map_list)[ i ];
+            (*invert_list)[ i - nrun + nnew ] = (*invert_list)[ i ];
+         }
+
+         for( i = *nmap - nrun + nnew; i < *nmap; i++ ) {
+            (*map_list)[ i ] = NULL;
+         }
+
+         *nmap -= nrun - nnew;
+         if( result < 0 ) result = imap;
+         imap += nnew;
+
+/* If the run is not to be replaced, move on to the next Mapping after the
+   run (or after the current Mapping if it is not affine). */
+      } else {
+         imap = ( nrun > 0 ) ? jmap : jmap + 1;
+      }
+
+/* Free the run terms. */
+      fmat = astFree( fmat );
+      foff = astFree( foff );
+      imat = astFree( imat );
+      ioff = astFree( ioff );
+   }
+
+/* Return the result. */
+   return astOK ? result : -1;
+}
+
 static AstMatrixMap *MtrMult( AstMatrixMap *this, AstMatrixMap *a, int *status ){
 /*
 *+
@@ -5097,21 +5961,26 @@ static AstPointSet *Transform( AstMapping *this, AstPointSet *in,
    AstPointSet *result;          /* Pointer to output PointSet */
    AstMatrixMap *map;            /* Pointer to MatrixMap to be applied */
    double diag_term;             /* Current diagonal element value */
+   double element;               /* Current matrix element value */
    double *indata;               /* Pointer to next input data value */
    double *matrix;               /* Pointer to start of matrix element array */
    double *matrix_element;       /* Pointer to current matrix element value */
    double *outdata;              /* Pointer to next output data value */
    double **ptr_in;              /* Pointer to input coordinate data */
    double **ptr_out;             /* Pointer to output coordinate data */
-   double sum;                   /* Partial output value */
+   double *work;                 /* Output values for current block */
    double val;                   /* Data value */
+   int *inbad;                   /* Input axes with bad values in block */
    int in_coord;                 /* Index of output coordinate */
+   int ip;                       /* Index of point within block */
    int nax;                      /* Output axes for which input axes exist */
+   int nb;                       /* Number of points in current block */
    int ncoord_in;                /* Number of coordinates per input point */
    int ncoord_out;               /* Number of coordinates per output point */
    int npoint;                   /* Number of points */
    int out_coord;                /* Index of output coordinate */
    int point;                    /* Loop counter for points */
+   char badout[ MTR_NBLOCK ];    /* Bad output flags for current block */
 
 /* Check the global error status. */
    if ( !astOK ) return NULL;
@@ -5153,61 +6022,96 @@ static AstPointSet *Transform( AstMapping *this, AstPointSet *in,
 /* ------------------------------ */
    if ( astOK ) {
 
-/* First deal with full MatrixMaps in which all matrix elements are stored. */
+/* First deal with full MatrixMaps in which all matrix elements are stored.
+   The points are processed in blocks of up to MTR_NBLOCK points. Within
+   each block, every output coordinate is formed by accumulating the
+   product of each matrix element with the corresponding block of input
+   coordinate values. The inner loop thus runs over contiguous values
+   and can be vectorised by the compiler, and the input values for the
+   block remain in cache while each output coordinate is formed. The
+   results for the block are accumulated in a work array and copied to
+   the output PointSet only when the whole block is complete, so the
+   input and output PointSets may be the same. */
       if( map->form == FULL ){
-
-/* Loop to apply the matrix to each point in turn, checking for
-   (and propagating) bad values in the process. The matrix elements are
-   accessed sequentially in row order. The next matrix element to be
-   used is identified by a pointer which is initialised to point to the
-   first element of the matrix prior to processing each point. */
-         for ( point = 0; point < npoint; point++ ) {
-            matrix_element = matrix;
+         work = astMalloc( sizeof( double )*(size_t)( ncoord_out*MTR_NBLOCK ) );
+         inbad = astMalloc( sizeof( int )*(size_t) ncoord_in );
+         if( astOK ) {
+            for( point = 0; point < npoint; point += MTR_NBLOCK ) {
+               nb = npoint - point;
+               if( nb > MTR_NBLOCK ) nb = MTR_NBLOCK;
+
+/* Note which input coordinates have any bad values within the block. */
+               for( in_coord = 0; in_coord < ncoord_in; in_coord++ ) {
+                  indata = ptr_in[ in_coord ] + point;
+                  inbad[ in_coord ] = 0;
+                  for( ip = 0; ip < nb; ip++ ) {
+                     if( indata[ ip ] == AST__BAD ) {
+                        inbad[ in_coord ] = 1;
+                        break;
+                     }
+                  }
+               }
 
 /* Each output co-ordinate value is created by summing the product of the
    corresponding input co-ordinates and the elements of one row of the
-   matrix. */
-            for ( out_coord = 0; out_coord < ncoord_out; out_coord++ ) {
-               sum = 0.0;
+   matrix. The sums are formed in the same order as for a point-by-point
+   evaluation, so the results are identical. */
+               for( out_coord = 0; out_coord < ncoord_out; out_coord++ ) {
+                  matrix_element = matrix + out_coord*ncoord_in;
+                  outdata = work + out_coord*MTR_NBLOCK;
+                  for( ip = 0; ip < nb; ip++ ) {
+                     outdata[ ip ] = 0.0;
+                     badout[ ip ] = 0;
+                  }
 
-               for ( in_coord = 0; in_coord < ncoord_in; in_coord++ ) {
-
-/*  Check the current input coordinate value and the current matrix element.
-    If the coordinate value is bad, then the output value will also be
-    bad unless the matrix element is zero. That is, a zero matrix element
-    results in the input coordinate value being ignored, even if it is bad.
-    This prevents bad input values being propagated to output axes which
-    are independant of the bad input axis. A bad matrix element always results
-    in the output value being bad. In either of these cases, break out of the
-    loop, remembering to advance the pointer to the next matrix element so
-    that it points to the start of the next row ready for doing the next
-    output coordinate. */
-                  if ( ( ptr_in[ in_coord ][ point ] == AST__BAD &&
-                                         (*matrix_element) != 0.0 ) ||
-                       (*matrix_element) == AST__BAD ) {
-                     sum = AST__BAD;
-                     matrix_element += ncoord_in - in_coord;
-                     break;
+                  for( in_coord = 0; in_coord < ncoord_in; in_coord++ ) {
+                     element = matrix_element[ in_coord ];
+                     indata = ptr_in[ in_coord ] + point;
 
-/*  If the input coordinate and the current matrix element are both
-    valid, increment the sum by their product, and step to the next matrix
-    element pointer If we arrive here with a bad input value, then the
-    matrix element must be zero, in which case the running sum is left
-    unchanged. */
-                  } else {
-                     if ( ptr_in[ in_coord ][ point ] != AST__BAD ) {
-                        sum += ptr_in[ in_coord ][ point ] * (*matrix_element);
+/* A bad matrix element always results in the output values being bad. */
+                     if( element == AST__BAD ) {
+                        for( ip = 0; ip < nb; ip++ ) badout[ ip ] = 1;
+                        break;
+
+/* If there are no bad input values, use a simple loop with no tests. */
+                     } else if( !inbad[ in_coord ] ) {
+                        for( ip = 0; ip < nb; ip++ ) {
+                           outdata[ ip ] += indata[ ip ]*element;
+                        }
+
+/* Otherwise, a bad coordinate value results in a bad output value unless
+   the matrix element is zero. That is, a zero matrix element results in
+   the input coordinate value being ignored, even if it is bad. This
+   prevents bad input values being propagated to output axes which are
+   independant of the bad input axis. */
+                     } else {
+                        for( ip = 0; ip < nb; ip++ ) {
+                           val = indata[ ip ];
+                           if( val != AST__BAD ) {
+                              outdata[ ip ] += val*element;
+                           } else if( element != 0.0 ) {
+                              badout[ ip ] = 1;
+                           }
+                        }
                      }
-                     matrix_element++;
                   }
-               }
 
-/*  Store the output coordinate value. */
-               ptr_out[ out_coord ][ point ] = sum;
+/* Flag the bad output values. */
+                  for( ip = 0; ip < nb; ip++ ) {
+                     if( badout[ ip ] ) outdata[ ip ] = AST__BAD;
+                  }
+               }
 
+/* Copy the block of output values to the output PointSet. */
+               for( out_coord = 0; out_coord < ncoord_out; out_coord++ ) {
+                  (void) memcpy( ptr_out[ out_coord ] + point,
+                                 (const void *)( work + out_coord*MTR_NBLOCK ),
+                                 sizeof( double )*(size_t) nb );
+               }
             }
-
          }
+         work = astFree( work );
+         inbad = astFree( inbad );
 
 /* Now deal with unit and diagonal MatrixMaps. */
       } else {
@@ -81,6 +81,8 @@
 *           Initialise the virtual function table for the MatrixMap class.
 *        astLoadMatrixMap
 *           Load a MatrixMap.
+*        astMergeAffine
+*           Collapse runs of affine Mappings into a single affine stage.
 
 *  Macros:
 *     None.
@@ -251,6 +253,9 @@ void astInitMatrixMapVtab_( AstMatrixMapVtab *, const char *, int * );
 /* Loader. */
 AstMatrixMap *astLoadMatrixMap_( void *, size_t, AstMatrixMapVtab *,
                                  const char *, AstChannel *, int * );
+
+/* Simplification of affine Mapping sequences. */
+int astMergeAffine_( int, int *, AstMapping ***, int **, int * );
 #endif
 
 /* Prototypes for member functions. */
@@ -302,6 +307,9 @@ astINVOKE(O,astInitMatrixMap_(mem,size,init,vtab,name,nin,nout,form,matrix,STATU
 /* Loader. */
 #define astLoadMatrixMap(mem,size,vtab,name,channel) \
 astINVOKE(O,astLoadMatrixMap_(mem,size,vtab,name,astCheckChannel(channel),STATUS_PTR))
+
+#define astMergeAffine(series,nmap,map_list,invert_list) \
+astMergeAffine_(series,nmap,map_list,invert_list,STATUS_PTR)
 #endif
 
 /* Interfaces to public member functions. */
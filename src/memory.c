@@ -388,6 +388,22 @@
 #define SIZEOF_MEMORY \
    ( ( sizeof_memory != 0 ) ? sizeof_memory : SizeOfMemory( status ) )
 
+/* The minimum size of each chunk of memory in the arena used by
+   astArenaMalloc. */
+#define ARENA_CHUNK 65536
+
+/* The maximum number of chunks retained in the arena for re-use when the
+   outermost astBeginArena/astEndArena block ends. Any further chunks are
+   freed. */
+#define ARENA_NKEEP 4
+
+/* The number of linked lists used to store the blocks in the pool of
+   large memory blocks, and a macro that returns the index of the list
+   used for a block of a given size. */
+#define POOL_NBIN 128
+#define POOL_BIN(size) \
+   ( (int) ( ( ( (size_t) size ) >> 3 ) % POOL_NBIN ) )
+
 
 /* Type Definitions. */
 /* ================= */
@@ -492,6 +508,51 @@ static pthread_mutex_t mutex3 = PTHREAD_MUTEX_INITIALIZER;
 
 #endif
 
+/* A pool of freed memory blocks that are too large to be stored in the
+   per-thread "cache" array (see below). The pool is shared by all
+   threads, so that a large block freed by one thread (e.g. a PointSet
+   freed by a worker thread) can be re-used by another. The blocks are
+   stored in a set of linked lists, each of which holds blocks with a
+   range of different sizes, selected by the POOL_BIN macro. A block is
+   only re-used for a request of exactly the same size. */
+static Memory *Pool[ POOL_NBIN ];
+
+/* The total number of bytes currently held in the pool. */
+static size_t Pool_Size = 0;
+
+/* The maximum number of bytes that may be held in the pool. Zero
+   means the pool is not used. Like the pool itself, this should only be
+   accessed while the pool mutex is locked. */
+static size_t Pool_Max = 0;
+
+/* A flag indicating if Pool_Max is non-zero. This is only changed while
+   the pool mutex is locked, but is read without locking the mutex so
+   that astMalloc and astFree can skip the pool (and the mutex) entirely
+   when the pool is not in use, which is the default. A stale value
+   merely causes a block to be freed or allocated normally, or the mutex
+   to be locked needlessly, since Pool_Max is always checked again once
+   the mutex is locked. */
+static int Pool_Used = 0;
+
+#ifdef THREAD_SAFE
+static pthread_mutex_t mutex4 = PTHREAD_MUTEX_INITIALIZER;
+#define LOCK_POOL_MUTEX pthread_mutex_lock( &mutex4 );
+#define UNLOCK_POOL_MUTEX pthread_mutex_unlock( &mutex4 );
+#else
+#define LOCK_POOL_MUTEX
+#define UNLOCK_POOL_MUTEX
+#endif
+
+/* A key used to free the chunks of memory in the arena used by
+   astArenaMalloc when a thread exits. The value associated with the key
+   in each thread is a pointer to the thread's global data, and is set
+   when the thread's arena first obtains a chunk of memory. */
+#ifdef THREAD_SAFE
+static pthread_key_t arena_key;
+static pthread_once_t arena_key_once = PTHREAD_ONCE_INIT;
+static int arena_key_ok = 0;
+#endif
+
 /* Define macros for accessing all items of thread-safe global data
    used by this module. */
 #ifdef THREAD_SAFE
@@ -501,6 +562,15 @@ static pthread_mutex_t mutex3 = PTHREAD_MUTEX_INITIALIZER;
 #define cache_init astGLOBAL(Memory,Cache_Init)
 #define use_cache astGLOBAL(Memory,Use_Cache)
 #define pm_depth astGLOBAL(Memory,PM_Depth)
+#define arena_chunk astGLOBAL(Memory,Arena_Chunk)
+#define arena_size astGLOBAL(Memory,Arena_Size)
+#define arena_nchunk astGLOBAL(Memory,Arena_NChunk)
+#define arena_ichunk astGLOBAL(Memory,Arena_IChunk)
+#define arena_used astGLOBAL(Memory,Arena_Used)
+#define arena_depth astGLOBAL(Memory,Arena_Depth)
+#define arena_maxdepth astGLOBAL(Memory,Arena_MaxDepth)
+#define arena_markchunk astGLOBAL(Memory,Arena_MarkChunk)
+#define arena_markused astGLOBAL(Memory,Arena_MarkUsed)
 
 /* Define the initial values for the global data for this module. */
 #define GLOBAL_inits \
@@ -508,6 +578,15 @@ static pthread_mutex_t mutex3 = PTHREAD_MUTEX_INITIALIZER;
    globals->Cache_Init = 0; \
    globals->Use_Cache = 0; \
    globals->PM_Depth = 0; \
+   globals->Arena_Chunk = NULL; \
+   globals->Arena_Size = NULL; \
+   globals->Arena_NChunk = 0; \
+   globals->Arena_IChunk = 0; \
+   globals->Arena_Used = 0; \
+   globals->Arena_Depth = 0; \
+   globals->Arena_MaxDepth = 0; \
+   globals->Arena_MarkChunk = NULL; \
+   globals->Arena_MarkUsed = NULL; \
 
 /* Create the global initialisation function. */
 astMAKE_INITGLOBALS(Memory)
@@ -542,6 +621,25 @@ static int use_cache = 0;
 /* Depth of nesting of astBeginPM/astEndPM blocks */
 static int pm_depth = 0;
 
+/* The memory arena used by astArenaMalloc. This is a list of "chunks" of
+   memory obtained using malloc. Memory is handed out by astArenaMalloc
+   from the start of the current chunk (arena_ichunk), moving on to the
+   next chunk when the current chunk is full. The first "arena_used" bytes
+   of the current chunk have already been handed out. */
+static char **arena_chunk = NULL;
+static size_t *arena_size = NULL;
+static int arena_nchunk = 0;
+static int arena_ichunk = 0;
+static size_t arena_used = 0;
+
+/* Depth of nesting of astBeginArena/astEndArena blocks, and the state of
+   the arena at the start of each block. The arrays holding the state are
+   extended as required, and "arena_maxdepth" holds their current length. */
+static int arena_depth = 0;
+static int arena_maxdepth = 0;
+static int *arena_markchunk = NULL;
+static size_t *arena_markused = NULL;
+
 #endif
 
 /* Prototypes for Private Functions. */
@@ -550,6 +648,14 @@ static size_t SizeOfMemory( int * );
 static char *CheckTempStart( const char *, const char *, const char *, char *, int *, int *, int *, int *, int *, int *, int *, int * );
 static char *ChrMatcher( const char *, const char *, const char *, const char *, const char *[], int, int, int, char ***, int *, const char **, int * );
 static char *ChrSuber( const char *, const char *, const char *[], int, int, char ***, int *, const char **, int * );
+static void ArenaFree( int, int * );
+#ifdef THREAD_SAFE
+static void ArenaCreateKey( void );
+static void ArenaDestroy( void * );
+#endif
+static Memory *PoolGet( size_t, int * );
+static int PoolPut( Memory *, int * );
+static void PoolTrim( size_t, int * );
 
 #ifdef MEM_DEBUG
 static void Issue( Memory *, int * );
@@ -802,6 +908,335 @@ char *astAppendStringf_( char *str1, int *nc, const char *str2, ... ) {
    return result;
 }
 
+void *astArenaMalloc_( size_t size, int *status ) {
+/*
+*+
+*  Name:
+*     astArenaMalloc
+
+*  Purpose:
+*     Allocate temporary memory from the current arena.
+
+*  Type:
+*     Protected function.
+
+*  Synopsis:
+*     #include "memory.h"
+*     void *astArenaMalloc( size_t size )
+
+*  Description:
+*     This function returns a pointer to a region of memory taken from a
+*     per-thread "arena". It is intended for work arrays that are needed
+*     only for the duration of a single function call (such as the
+*     intermediate coordinate values used when transforming points).
+*     Memory is handed out by simply advancing a pointer within large
+*     chunks of memory that are re-used by later calls, so after the first
+*     use there is usually no need to call the system malloc function.
+*
+*     The returned memory remains valid until the end of the current
+*     astBeginArena/astEndArena block, at which point all memory obtained
+*     from astArenaMalloc within the block is released in one go.
+
+*  Parameters:
+*     size
+*        The size of the memory region required (may be zero).
+
+*  Returned Value:
+*     astArenaMalloc()
+*        A pointer to the start of the memory region, aligned on an 8
+*        byte boundary. A NULL pointer is returned if the size is zero.
+
+*  Notes:
+*     - The returned pointer must not be passed to astFree, astRealloc,
+*     or any other function in this module that requires memory
+*     allocated by astMalloc.
+*     - An error is reported if this function is called outside an
+*     astBeginArena/astEndArena block.
+*     - A NULL pointer value is returned if this function is invoked
+*     with the global error status set or if it fails for any reason.
+*-
+*/
+
+/* Local Variables: */
+   astDECLARE_GLOBALS            /* Pointer to thread-specific global data */
+   char **new_chunk;             /* Extended array of chunk pointers */
+   size_t *new_size;             /* Extended array of chunk sizes */
+   size_t chunk_size;            /* Size of a new chunk */
+   void *result;                 /* Returned pointer */
+
+/* Initialise. */
+   result = NULL;
+
+/* Check the global error status. */
+   if ( !astOK || size == 0 ) return result;
+
+/* If needed, get a pointer to the thread specific global data structure. */
+   astGET_GLOBALS(NULL);
+
+/* Report an error if there is no current arena block. */
+   if( arena_depth == 0 ) {
+      astError( AST__INTER, "astArenaMalloc: astArenaMalloc called outside "
+                "an astBeginArena/astEndArena block (internal AST "
+                "programming error).", status );
+      return result;
+   }
+
+/* Round the size up to a multiple of 8 bytes so that the next region
+   handed out is correctly aligned. */
+   size += ( ( size & 0x7 ) ? ( ( size & 0x7 ) ^ 0x7 ) + 1 : 0 );
+
+/* If the current chunk is too full, move on to the next chunk, skipping
+   any that are too small. */
+   while( arena_ichunk < arena_nchunk &&
+          arena_used + size > arena_size[ arena_ichunk ] ) {
+      arena_ichunk++;
+      arena_used = 0;
+   }
+
+/* If no existing chunk is big enough, allocate a new chunk and append
+   it to the end of the list. */
+   if( arena_ichunk == arena_nchunk ) {
+      chunk_size = ( size > ARENA_CHUNK ) ? size : ARENA_CHUNK;
+      new_chunk = REALLOC( arena_chunk, sizeof( char * )*( arena_nchunk + 1 ) );
+      if( new_chunk ) arena_chunk = new_chunk;
+      new_size = REALLOC( arena_size, sizeof( size_t )*( arena_nchunk + 1 ) );
+      if( new_size ) arena_size = new_size;
+      if( new_chunk && new_size ) {
+         arena_chunk[ arena_nchunk ] = MALLOC( chunk_size );
+         if( arena_chunk[ arena_nchunk ] ) {
+            arena_size[ arena_nchunk++ ] = chunk_size;
+            arena_used = 0;
+
+/* If this is the first chunk in the arena, arrange for the arena to be
+   freed when the current thread exits. */
+#ifdef THREAD_SAFE
+            if( arena_nchunk == 1 ) {
+               pthread_once( &arena_key_once, ArenaCreateKey );
+               if( arena_key_ok ) pthread_setspecific( arena_key, AST__GLOBALS );
+            }
+#endif
+         }
+      }
+
+      if( arena_ichunk == arena_nchunk ) {
+         astError( AST__NOMEM, "astArenaMalloc: Failed to allocate %lu "
+                   "bytes of memory.", status, (unsigned long) chunk_size );
+         return result;
+      }
+   }
+
+/* Hand out the next "size" bytes of the current chunk. */
+   result = arena_chunk[ arena_ichunk ] + arena_used;
+   arena_used += size;
+
+/* Return the result. */
+   return result;
+}
+
+#ifdef THREAD_SAFE
+static void ArenaCreateKey( void ){
+/*
+*  Name:
+*     ArenaCreateKey
+
+*  Purpose:
+*     Create the key used to free the arena when a thread exits.
+
+*  Type:
+*     Private function.
+
+*  Synopsis:
+*     void ArenaCreateKey( void )
+
+*  Description:
+*     This function creates the thread-specific data key whose destructor
+*     (ArenaDestroy) frees the chunks of memory used by astArenaMalloc
+*     when a thread exits. It is called once only, by pthread_once.
+*/
+
+   arena_key_ok = !pthread_key_create( &arena_key, ArenaDestroy );
+}
+
+static void ArenaDestroy( void *data ){
+/*
+*  Name:
+*     ArenaDestroy
+
+*  Purpose:
+*     Free the arena used by a thread that is exiting.
+
+*  Type:
+*     Private function.
+
+*  Synopsis:
+*     void ArenaDestroy( void *data )
+
+*  Description:
+*     This function is the destructor for the thread-specific data key
+*     created by ArenaCreateKey. It is called by the pthreads library when
+*     a thread that has used astArenaMalloc exits, and frees the chunks of
+*     memory used by the thread's arena.
+
+*  Parameters:
+*     data
+*        Pointer to the global data structure for the exiting thread.
+*/
+
+/* Local Variables: */
+   int status_value = 0;         /* Local status value */
+
+/* Ensure the global data for the exiting thread is used by ArenaFree,
+   since the value associated with the global data key may already have
+   been cleared. Then free the arena. */
+   if( !pthread_setspecific( starlink_ast_globals_key, data ) ) {
+      ArenaFree( 0, &status_value );
+   }
+}
+#endif
+
+static void ArenaFree( int nkeep, int *status ){
+/*
+*  Name:
+*     ArenaFree
+
+*  Purpose:
+*     Free the chunks of memory used by astArenaMalloc.
+
+*  Type:
+*     Private function.
+
+*  Synopsis:
+*     void ArenaFree( int nkeep, int *status )
+
+*  Description:
+*     This function frees the chunks of memory used by astArenaMalloc
+*     in the current thread, other than the first "nkeep" chunks, which
+*     are retained for re-use. If "nkeep" is zero, the arrays used to
+*     record the state of the arena at the start of each
+*     astBeginArena/astEndArena block are also freed. It should only be
+*     called when there is no current astBeginArena/astEndArena block.
+
+*  Parameters:
+*     nkeep
+*        The number of chunks to retain.
+*     status
+*        Pointer to the inherited status variable.
+
+*  Notes:
+*     - This function attempts to execute even if an error has already
+*     occurred.
+*/
+
+/* Local Variables: */
+   astDECLARE_GLOBALS            /* Pointer to thread-specific global data */
+   int ichunk;                   /* Chunk index */
+
+/* If needed, get a pointer to the thread specific global data structure. */
+   astGET_GLOBALS(NULL);
+
+/* Free any chunks beyond the first "nkeep". The arrays holding the chunk
+   pointers and sizes are left at their current length unless all chunks
+   are freed. */
+   if( nkeep < 0 ) nkeep = 0;
+   for( ichunk = nkeep; ichunk < arena_nchunk; ichunk++ ) {
+      FREE( arena_chunk[ ichunk ] );
+   }
+   if( nkeep < arena_nchunk ) arena_nchunk = nkeep;
+
+   if( nkeep == 0 ) {
+      FREE( arena_chunk );
+      FREE( arena_size );
+      arena_chunk = NULL;
+      arena_size = NULL;
+
+/* Free the arrays holding the state of the arena at the start of each
+   block. */
+      FREE( arena_markchunk );
+      FREE( arena_markused );
+      arena_markchunk = NULL;
+      arena_markused = NULL;
+      arena_maxdepth = 0;
+   }
+
+/* Reset the arena so that the next allocation uses the first chunk. */
+   arena_ichunk = 0;
+   arena_used = 0;
+}
+
+void astBeginArena_( int *status ) {
+/*
+*+
+*  Name:
+*     astBeginArena
+
+*  Purpose:
+*     Start a block of temporary arena memory allocations.
+
+*  Type:
+*     Protected function.
+
+*  Synopsis:
+*     #include "memory.h"
+*     astBeginArena
+
+*  Description:
+*     This function starts a new block within which memory may be
+*     obtained using astArenaMalloc. All such memory is released when
+*     the matching astEndArena is called.
+*
+*     Matching pairs of astBeginArena/astEndArena calls may be nested
+*     to any depth (for instance, when a CmpMap contains other CmpMaps).
+*     Ending an inner block releases only the memory obtained within that
+*     block.
+
+*  Notes:
+*     - Each thread has a separate arena.
+*     - This function attempts to execute even if the global error status
+*     is set, so that it can be paired reliably with astEndArena.
+*-
+*/
+
+/* Local Variables: */
+   astDECLARE_GLOBALS            /* Pointer to thread-specific global data */
+   int *new_markchunk;           /* Extended array of chunk indices */
+   int new_maxdepth;             /* Extended length of state arrays */
+   size_t *new_markused;         /* Extended array of used byte counts */
+
+/* Get access to the thread-specific global variables: */
+   astGET_GLOBALS(NULL);
+
+/* If the arrays used to record the state of the arena at the start of
+   each block are full, attempt to extend them. */
+   if( arena_depth == arena_maxdepth ) {
+      new_maxdepth = ( arena_maxdepth > 0 ) ? 2*arena_maxdepth : 16;
+      new_markchunk = REALLOC( arena_markchunk,
+                               sizeof( int )*(size_t) new_maxdepth );
+      if( new_markchunk ) arena_markchunk = new_markchunk;
+      new_markused = REALLOC( arena_markused,
+                              sizeof( size_t )*(size_t) new_maxdepth );
+      if( new_markused ) arena_markused = new_markused;
+      if( new_markchunk && new_markused ) {
+         arena_maxdepth = new_maxdepth;
+      } else if( astOK ) {
+         astError( AST__NOMEM, "astBeginArena: Failed to allocate memory "
+                   "to record the state of the arena at nesting level %d.",
+                   status, arena_depth + 1 );
+      }
+   }
+
+/* Record the current state of the arena so that it can be re-instated
+   by the matching astEndArena. If the arrays could not be extended (in
+   which case an error has been reported above), the state is not
+   recorded, and the memory obtained within this block is instead
+   released when an enclosing block ends. Always increment the depth so
+   that the matching astEndArena call behaves correctly. */
+   if( arena_depth < arena_maxdepth ) {
+      arena_markchunk[ arena_depth ] = arena_ichunk;
+      arena_markused[ arena_depth ] = arena_used;
+   }
+   arena_depth++;
+}
+
 int astBrackets_( const char *text, size_t start, size_t end,
                   char opchar, char clchar, int strip,
                   size_t *openat, size_t *closeat, char **before,
@@ -1417,6 +1852,188 @@ double astChr2Double_( const char *str, int *status ) {
    return result;
 }
 
+int astChrReadDouble_( const char *str, double *value, int *status ) {
+/*
+*+
+*  Name:
+*     astChrReadDouble
+
+*  Purpose:
+*     Read a double value from the start of a string.
+
+*  Type:
+*     Protected function.
+
+*  Synopsis:
+*     #include "memory.h"
+*     int astChrReadDouble( const char *str, double *value )
+
+*  Description:
+*     This function reads a double from the start of the supplied
+*     null-terminated string, skipping any leading and trailing white
+*     space. For any valid numerical value it gives the same result as
+*     'astSscanf( str, " %lf %n", value, &nc )' but uses strtod directly
+*     and so avoids the cost of interpreting a format string. It is
+*     intended for use in code that reads large numbers of numerical
+*     values, such as FITS header cards.
+
+*  Parameters:
+*     str
+*        Pointer to the string.
+*     value
+*        Pointer to a double in which to return the value read from the
+*        string. It is left unchanged if no value can be read.
+
+*  Returned Value:
+*     astChrReadDouble()
+*       The number of characters read from the string, including
+*       leading and trailing white space. Zero is returned if the
+*       string does not start with a numerical value.
+
+*  Notes:
+*     -  An incomplete exponent (e.g. "1.5E") is not included in the
+*     returned number of characters. Some implementations of sscanf
+*     consume such exponents.
+*     -  Like astSscanf, this function does not check the inherited
+*     status and never reports an error.
+*-
+*/
+
+/* Local Variables: */
+   char *end;         /* Pointer to first character following the value */
+   const char *c;     /* Pointer to the first non-blank character */
+   double result;     /* The value read from the string */
+
+/* Check a string was supplied. */
+   if( !str ) return 0;
+
+/* Skip leading white space and then read the value. Return zero if no
+   characters were used. */
+   c = str;
+   while( isspace( (int) *c ) ) c++;
+   result = strtod( c, &end );
+   if( end == c ) return 0;
+
+/* Skip any trailing white space, store the value and return the number
+   of characters read. */
+   while( isspace( (int) *end ) ) end++;
+   *value = result;
+   return (int)( end - str );
+}
+
+int astChrReadInt_( const char *str, int *value, int *status ) {
+/*
+*+
+*  Name:
+*     astChrReadInt
+
+*  Purpose:
+*     Read an int value from the start of a string.
+
+*  Type:
+*     Protected function.
+
+*  Synopsis:
+*     #include "memory.h"
+*     int astChrReadInt( const char *str, int *value )
+
+*  Description:
+*     This function is like astChrReadDouble, except that it reads a
+*     decimal int value, giving the same result as
+*     'astSscanf( str, " %d %n", value, &nc )'.
+
+*  Parameters:
+*     str
+*        Pointer to the string.
+*     value
+*        Pointer to an int in which to return the value read from the
+*        string. It is left unchanged if no value can be read.
+
+*  Returned Value:
+*     astChrReadInt()
+*       The number of characters read from the string, including
+*       leading and trailing white space. Zero is returned if the
+*       string does not start with an integer value.
+*-
+*/
+
+/* Local Variables: */
+   char *end;
+   const char *c;
+   long int result;
+
+/* Check a string was supplied. */
+   if( !str ) return 0;
+
+/* Skip leading white space and read the value. */
+   c = str;
+   while( isspace( (int) *c ) ) c++;
+   result = strtol( c, &end, 10 );
+   if( end == c ) return 0;
+
+/* Skip trailing white space. The value is truncated to an int in the
+   same way as sscanf. */
+   while( isspace( (int) *end ) ) end++;
+   *value = (int) result;
+   return (int)( end - str );
+}
+
+int astChrReadInt64_( const char *str, int64_t *value, int *status ) {
+/*
+*+
+*  Name:
+*     astChrReadInt64
+
+*  Purpose:
+*     Read a 64 bit integer value from the start of a string.
+
+*  Type:
+*     Protected function.
+
+*  Synopsis:
+*     #include "memory.h"
+*     int astChrReadInt64( const char *str, int64_t *value )
+
+*  Description:
+*     This function is like astChrReadDouble, except that it reads a
+*     decimal 64 bit integer value, giving the same result as
+*     'astSscanf( str, " %" SCNd64 " %n", value, &nc )'.
+
+*  Parameters:
+*     str
+*        Pointer to the string.
+*     value
+*        Pointer to an int64_t in which to return the value read from the
+*        string. It is left unchanged if no value can be read.
+
+*  Returned Value:
+*     astChrReadInt64()
+*       The number of characters read from the string, including
+*       leading and trailing white space. Zero is returned if the
+*       string does not start with an integer value.
+*-
+*/
+
+/* Local Variables: */
+   char *end;
+   const char *c;
+   long long int result;
+
+/* Check a string was supplied. */
+   if( !str ) return 0;
+
+/* Skip leading white space and read the value. */
+   c = str;
+   while( isspace( (int) *c ) ) c++;
+   result = strtoll( c, &end, 10 );
+   if( end == c ) return 0;
+
+/* Skip trailing white space. */
+   while( isspace( (int) *end ) ) end++;
+   *value = (int64_t) result;
+   return (int)( end - str );
+}
+
 void astChrCase_( const char *in, char *out, int upper, int blen, int *status ) {
 /*
 *++
@@ -2416,6 +3033,67 @@ void astChrTrunc_( char *text, int *status ){
    text[ astChrLen( text ) ] = 0;
 }
 
+void astEndArena_( int *status ) {
+/*
+*+
+*  Name:
+*     astEndArena
+
+*  Purpose:
+*     End a block of temporary arena memory allocations.
+
+*  Type:
+*     Protected function.
+
+*  Synopsis:
+*     #include "memory.h"
+*     astEndArena
+
+*  Description:
+*     This function ends the block of arena memory allocations started
+*     by the matching call to astBeginArena. All memory obtained from
+*     astArenaMalloc since the matching astBeginArena call is released,
+*     and the pointers returned by those calls must no longer be used.
+*
+*     When the outermost block ends, the first few chunks of memory used
+*     by the arena are retained for use by later blocks, so that the same
+*     memory is re-used by each top-level call to a function such as
+*     astTransform. Any other chunks are freed. The retained chunks are
+*     freed when the thread exits (in thread-safe builds), or by
+*     astFlushMemory.
+
+*  Notes:
+*     - This function attempts to execute even if the global error status
+*     is set.
+*-
+*/
+
+/* Get access to the thread-specific global variables: */
+   astDECLARE_GLOBALS
+   astGET_GLOBALS(NULL);
+
+/* Report an error if there is no matching astBeginArena. */
+   if( arena_depth == 0 ){
+      if( astOK ) {
+         astError( AST__INTER, "astEndArena: astEndArena called without "
+                   "matching astBeginArena (internal AST programming "
+                   "error).", status );
+      }
+
+/* Otherwise, decrement the depth and re-instate the state of the arena
+   at the start of the block (if it was recorded). */
+   } else if( --arena_depth < arena_maxdepth ) {
+      arena_ichunk = arena_markchunk[ arena_depth ];
+      arena_used = arena_markused[ arena_depth ];
+   }
+
+/* If the outermost block has ended, free any chunks in excess of the
+   number retained for re-use. */
+   if( arena_depth == 0 && arena_nchunk > ARENA_NKEEP ) {
+      ArenaFree( ARENA_NKEEP, status );
+   }
+}
+
 void astFandl_( const char *text, size_t start, size_t end,
                 size_t *f, size_t *l, int *status ){
 /*
@@ -2593,9 +3271,11 @@ void *astFree_( void *ptr, int *status ) {
    The size of the block is implied by the Cache element it is stored in. */
          mem->size = (size_t) 0;
 
-/* Simply free other memory blocks, clearing the "magic number" and size
-   values it contains. This helps prevent accidental re-use of the memory. */
-      } else {
+/* Otherwise, if the memory block is too big for the cache, put it into
+   the pool of large memory blocks if there is room for it. If there is no
+   room, simply free it, clearing the "magic number" and size values it
+   contains. This helps prevent accidental re-use of the memory. */
+      } else if( size <= MXCSIZE || !PoolPut( mem, status ) ) {
          mem->magic = (unsigned long) 0;
          mem->size = (size_t) 0;
 
@@ -2937,6 +3617,11 @@ void *astMalloc_( size_t size, int init, int *status ) {
 /* Initialise the memory (but not the header) if required. */
          if( init ) (void) memset( (char *) mem + SIZEOF_MEMORY, 0, size );
 
+/* Otherwise, if the pool of large memory blocks is being used, and it
+   contains a block of the required size, use it. */
+      } else if( size > MXCSIZE && ( mem = PoolGet( size, status ) ) ) {
+         if( init ) (void) memset( (char *) mem + SIZEOF_MEMORY, 0, size );
+
 /* Otherwise, allocate a new memory block using "malloc" or "calloc". */
       } else {
          if( init ) {
@@ -3636,6 +4321,261 @@ int astMemCaching_( int newval, int *status ){
    return result;
 }
 
+int astMemPool_( int newval, int *status ){
+/*
+*++
+*  Name:
+*     astMemPool
+
+*  Purpose:
+*     Controls whether large freed memory blocks are retained for re-use.
+
+*  Type:
+*     Public function.
+
+*  Synopsis:
+*     #include "memory.h"
+*     int astMemPool( int newval )
+
+*  Description:
+*     This function sets the maximum total size of the memory blocks
+*     that may be retained in a pool of allocated but unused memory
+*     blocks, and returns the original value. Only blocks that are too
+*     large to be stored in the cache controlled by astMemCaching are
+*     stored in this pool. When such a block is freed using astFree, it
+*     is stored in the pool if there is room, and is then re-used by the
+*     next call to astMalloc that requests a block of exactly the same
+*     size. This avoids the overhead of calling the system malloc and
+*     free functions for the large work arrays that are allocated and
+*     freed repeatedly when (for instance) a Mapping is used to transform
+*     many sets of points of the same size.
+*
+*     Unlike the cache controlled by astMemCaching, the pool is shared
+*     by all threads, so a block freed by one thread can be re-used by
+*     another.
+
+*  Parameters:
+*     newval
+*        The new value for the MemoryPool tuning parameter (see astTune
+*        in object.c). This is the maximum total size of the blocks
+*        retained in the pool, in kilobytes. Zero (the default) means that
+*        no blocks are retained. If the new value is smaller than the total
+*        size of the blocks currently in the pool, blocks are freed until
+*        the pool is small enough. If AST__TUNULL is supplied, the current
+*        value is left unchanged.
+
+*  Returned Value:
+*     astMemPool()
+*        The original value of the MemoryPool tuning parameter.
+
+*--
+*/
+
+/* Local Variables: */
+   int result;
+   size_t maxsize;
+
+/* Check the global error status. */
+   if ( !astOK ) return 0;
+
+/* Store the original value of the tuning parameter, and store any new
+   value, within a single critical section. */
+   LOCK_POOL_MUTEX
+   result = (int) ( Pool_Max/1024 );
+   if( newval != AST__TUNULL ) {
+      Pool_Max = ( newval > 0 ) ? 1024*( (size_t) newval ) : 0;
+      Pool_Used = ( Pool_Max > 0 );
+   }
+   maxsize = Pool_Max;
+   UNLOCK_POOL_MUTEX
+
+/* If a new value was set, free any blocks that no longer fit in the
+   pool. */
+   if( newval != AST__TUNULL ) PoolTrim( maxsize, status );
+
+/* Return the original value. */
+   return result;
+}
+
+static Memory *PoolGet( size_t size, int *status ){
+/*
+*  Name:
+*     PoolGet
+
+*  Purpose:
+*     Remove a memory block of a given size from the pool of large blocks.
+
+*  Type:
+*     Private function.
+
+*  Synopsis:
+*     Memory *PoolGet( size_t size, int *status )
+
+*  Description:
+*     This function searches the pool of large memory blocks (see
+*     astMemPool) for a block of the given size. If one is found, it is
+*     removed from the pool and returned, with its "magic number" and
+*     size re-instated.
+
+*  Parameters:
+*     size
+*        The required size of the memory block, excluding the Memory
+*        header.
+*     status
+*        Pointer to the inherited status variable.
+
+*  Returned Value:
+*     A pointer to the Memory header of the block, or NULL if the pool
+*     contains no block of the required size.
+*/
+
+/* Local Variables: */
+   Memory **prev;
+   Memory *mem;
+
+/* Return without locking the mutex if the pool is not in use. */
+   if( !Pool_Used ) return NULL;
+
+/* Search the list of blocks that may have the required size. Remove the
+   first block that has exactly the required size. */
+   LOCK_POOL_MUTEX
+   prev = Pool + POOL_BIN( size );
+   mem = *prev;
+   while( mem && mem->size != size ) {
+      prev = &( mem->next );
+      mem = *prev;
+   }
+   if( mem ) {
+      *prev = mem->next;
+      Pool_Size -= size;
+   }
+   UNLOCK_POOL_MUTEX
+
+/* Re-instate the magic number, so that the block is again recognised as
+   dynamically allocated memory. */
+   if( mem ) {
+      mem->magic = MAGIC( mem, size );
+      mem->next = NULL;
+   }
+
+/* Return the block. */
+   return mem;
+}
+
+static int PoolPut( Memory *mem, int *status ){
+/*
+*  Name:
+*     PoolPut
+
+*  Purpose:
+*     Store a freed memory block in the pool of large blocks.
+
+*  Type:
+*     Private function.
+
+*  Synopsis:
+*     int PoolPut( Memory *mem, int *status )
+
+*  Description:
+*     This function stores a freed memory block in the pool of large
+*     memory blocks (see astMemPool), so long as this would not cause the
+*     total size of the blocks in the pool to exceed the limit set by
+*     astMemPool.
+
+*  Parameters:
+*     mem
+*        Pointer to the Memory header of the block.
+*     status
+*        Pointer to the inherited status variable.
+
+*  Returned Value:
+*     Non-zero if the block was stored in the pool, and zero otherwise
+*     (in which case the caller should free the block).
+
+*  Notes:
+*     - The "magic number" in the header is cleared when the block is
+*     stored in the pool, so that any attempt to use or free the block
+*     before it is returned by astMalloc is detected. The size is retained
+*     in the header.
+*/
+
+/* Local Variables: */
+   int ibin;
+   int result;
+
+/* Initialise. */
+   result = 0;
+
+/* Return without locking the mutex if the pool is not in use. */
+   if( !Pool_Used ) return result;
+
+/* Add the block to the start of the appropriate list, if there is room.
+   Pool_Max is checked again now that the mutex is locked. */
+   LOCK_POOL_MUTEX
+   if( Pool_Size + mem->size <= Pool_Max ) {
+      ibin = POOL_BIN( mem->size );
+      mem->magic = (unsigned long) 0;
+      mem->next = Pool[ ibin ];
+      Pool[ ibin ] = mem;
+      Pool_Size += mem->size;
+      result = 1;
+   }
+   UNLOCK_POOL_MUTEX
+
+/* Return the result. */
+   return result;
+}
+
+static void PoolTrim( size_t maxsize, int *status ){
+/*
+*  Name:
+*     PoolTrim
+
+*  Purpose:
+*     Free blocks from the pool of large blocks.
+
+*  Type:
+*     Private function.
+
+*  Synopsis:
+*     void PoolTrim( size_t maxsize, int *status )
+
+*  Description:
+*     This function frees memory blocks held in the pool of large memory
+*     blocks (see astMemPool) until the total size of the blocks remaining
+*     in the pool is no more than a given value.
+
+*  Parameters:
+*     maxsize
+*        The maximum total size, in bytes, of the blocks to be left in the
+*        pool. Supply zero to empty the pool.
+*     status
+*        Pointer to the inherited status variable.
+
+*  Notes:
+*     - This function attempts to execute even if an error has already
+*     occurred.
+*/
+
+/* Local Variables: */
+   Memory *mem;
+   int ibin;
+
+/* Free the blocks at the start of each list in turn until the pool is
+   small enough. */
+   LOCK_POOL_MUTEX
+   for( ibin = 0; ibin < POOL_NBIN && Pool_Size > maxsize; ibin++ ) {
+      while( Pool[ ibin ] && Pool_Size > maxsize ) {
+         mem = Pool[ ibin ];
+         Pool[ ibin ] = mem->next;
+         Pool_Size -= mem->size;
+         mem->size = (size_t) 0;
+         FREE( mem );
+      }
+   }
+   UNLOCK_POOL_MUTEX
+}
+
 void *astRealloc_( void *ptr, size_t size, int *status ) {
 /*
 *++
@@ -5457,6 +6397,12 @@ void astFlushMemory_( int leak, int *status ) {
 /* Empty the cache. */
    astMemCaching( astMemCaching( AST__TUNULL ) );
 
+/* Empty the pool of large memory blocks. */
+   PoolTrim( 0, status );
+
+/* Free the chunks of memory used by astArenaMalloc. */
+   ArenaFree( 0, status );
+
 /* Free and count all non-permanent memory blocks. */
    nact = 0;
    next = Active_List;
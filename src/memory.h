@@ -132,6 +132,7 @@
 /* C header files. */
 /* --------------- */
 #include <stddef.h>
+#include <stdint.h>
 #include "error.h"
 
 /* Macros. */
@@ -189,6 +190,15 @@ typedef struct AstMemoryGlobals {
    int Use_Cache;
    Memory *Cache[ MXCSIZE + 1 ];
    int PM_Depth;
+   char **Arena_Chunk;
+   size_t *Arena_Size;
+   int Arena_NChunk;
+   int Arena_IChunk;
+   size_t Arena_Used;
+   int Arena_Depth;
+   int Arena_MaxDepth;
+   int *Arena_MarkChunk;
+   size_t *Arena_MarkUsed;
 
 } AstMemoryGlobals;
 
@@ -212,6 +222,7 @@ void astInitMemoryGlobals_( AstMemoryGlobals * );
                                  /* use in developing (e.g.) foreign */
                                  /* language or graphics interfaces. */
 int astMemCaching_( int, int * );
+int astMemPool_( int, int * );
 void astChrClean_( char * );
 void astChrRemoveBlanks_( char * );
 void astChrCase_( const char *, char *, int, int, int * );
@@ -228,6 +239,9 @@ size_t astSizeOf_( const void *, int * );
 AstStringList *astStringList_( size_t, int * );
 AstStringList *astFreeStringList_( AstStringList *, int * );
 void astAppendStringList_( AstStringList *, const char *, int * );
+void *astArenaMalloc_( size_t, int * );
+void astBeginArena_( int * );
+void astEndArena_( int * );
 int astIsDynamic_( const void *, int * );
 size_t astTSizeOf_( const void *, int * );
 void *astFree_( void *, int * );
@@ -239,6 +253,9 @@ void *astRealloc_( void *, size_t, int * );
 void *astStore_( void *, const void *, size_t, int * );
 size_t astChrLen_( const char *, int * );
 double astChr2Double_( const char *, int * );
+int astChrReadDouble_( const char *, double *, int * );
+int astChrReadInt_( const char *, int *, int * );
+int astChrReadInt64_( const char *, int64_t *, int * );
 void astRemoveLeadingBlanks_( char *, int * );
 char *astAppendString_( char *, int *, const char *, int * );
 char *astAppendStringf_( char *, int *, const char *, ... )__attribute__((format(printf,3,4)));
@@ -284,6 +301,7 @@ void astEndPM_( int * );
 #define astGrow(ptr,n,size) astERROR_INVOKE(astGrow_(ptr,n,size,STATUS_PTR))
 #define astMalloc(size) astERROR_INVOKE(astMalloc_(size,0,STATUS_PTR))
 #define astMemCaching(flag) astERROR_INVOKE(astMemCaching_(flag,STATUS_PTR))
+#define astMemPool(size) astERROR_INVOKE(astMemPool_(size,STATUS_PTR))
 #define astRealloc(ptr,size) astERROR_INVOKE(astRealloc_(ptr,size,STATUS_PTR))
 #define astSizeOf(ptr) astERROR_INVOKE(astSizeOf_(ptr,STATUS_PTR))
 #define astIsDynamic(ptr) astERROR_INVOKE(astIsDynamic_(ptr,STATUS_PTR))
@@ -310,6 +328,12 @@ void astEndPM_( int * );
 #define astStringList(nline) astERROR_INVOKE(astStringList_(nline,STATUS_PTR))
 #define astFreeStringList(list) astERROR_INVOKE(astFreeStringList_(list,STATUS_PTR))
 #define astAppendStringList(list,text) astERROR_INVOKE(astAppendStringList_(list,text,STATUS_PTR))
+#define astChrReadDouble(str,value) astERROR_INVOKE(astChrReadDouble_(str,value,STATUS_PTR))
+#define astChrReadInt(str,value) astERROR_INVOKE(astChrReadInt_(str,value,STATUS_PTR))
+#define astChrReadInt64(str,value) astERROR_INVOKE(astChrReadInt64_(str,value,STATUS_PTR))
+#define astArenaMalloc(size) astERROR_INVOKE(astArenaMalloc_(size,STATUS_PTR))
+#define astBeginArena astERROR_INVOKE(astBeginArena_(STATUS_PTR))
+#define astEndArena astERROR_INVOKE(astEndArena_(STATUS_PTR))
 #endif
 
 #ifdef HAVE_NONANSI_SSCANF
@@ -76,6 +76,8 @@ c     - astAddCell: Adds a single HEALPix cell into an existing Moc
 f     - AST_ADDCELL: Adds a single HEALPix cell into an existing Moc
 c     - astAddMocData: Adds a FITS binary table into an existing Moc
 f     - ADT_ADDMOCDATA: Adds a FITS binary table into an existing Moc
+c     - astAddMocRanges: Adds a list of HEALPix cell ranges into an existing Moc
+f     - AST_ADDMOCRANGES: Adds a list of HEALPix cell ranges into an existing Moc
 c     - astAddMocString: Adds a JSON or string-encoded MOC into an existing Moc
 f     - ADT_ADDMOCSTRING: Adds a JSON or string-encoded MOC into an existing Moc
 c     - astAddPixelMask<X>: Adds a pixel mask to an existing Moc
@@ -88,6 +90,8 @@ c     - astGetMocData: Get the FITS binary table data describing a Moc
 f     - AST_GETMOCDATA: Get the FITS binary table data describing a Moc
 c     - astGetMocHeader: Get the FITS binary table headers describing a Moc
 f     - AST_GETMOCHEADER: Get the FITS binary table headers describing a Moc
+c     - astGetMocRanges: Get the ranges of HEALPix cells included in a Moc
+f     - AST_GETMOCRANGES: Get the ranges of HEALPix cells included in a Moc
 c     - astGetMocString: Get the JSON or string-encoded form of a Moc
 f     - AST_GETMOCSTRING: Get the JSON or string-encoded form of a Moc
 c     - astTestCell: Test if a single HEALPix cell is included in a Moc
@@ -321,14 +325,10 @@ typedef struct SourceData {
 } SourceData;
 
 typedef struct List {
-   int64_t nval;
-   size_t *values;
+   int64_t nrange;
+   int64_t *ranges;
 } List;
 
-typedef struct EndPoint {
-   int64_t value;
-   int start;
-} EndPoint;
 
 
 
@@ -434,7 +434,6 @@ static double GetPixelArea( AstFrameSet *, const AstDim *, int * );
 static double OrderToRes( int order );
 static int Comp_corner( const void *, const void * );
 static int Comp_decra( const void *, const void * );
-static int Comp_endpoint( const void *, const void * );
 static int Comp_range( const void *, const void * );
 static int Comp_int64( const void *, const void * );
 static int Equal( AstObject *, AstObject *, int * );
@@ -443,20 +442,25 @@ static int RegTrace( AstRegion *, int, double *, double **, int * );
 static int ResToOrder( double );
 static int log2_32( int );
 static int log2_64( int64_t );
+static int GallopRanges( const int64_t *, int, int, int64_t );
+static int SortRanges( int64_t *, int );
 static int TestCell( AstMoc *, int, int64_t, int, int * );
 static int64_t XyToNested( int, int, int );
 static void AddCell( AstMoc *, int, int, int64_t, int * );
 static void AddMocData( AstMoc *, int, int, int, int, int, const void *, int * );
+static void AddMocRanges( AstMoc *, int, int, int, int, const int64_t *, int * );
 static void AddMocString( AstMoc *, int, int, int, size_t, const char *, int *, int * );
 static void AddRegion( AstMoc *, int, AstRegion *, int * );
 static void AppendChildren( AstMoc *, Cell *, int, Cell **, int *);
+static void AppendRange( List *, int64_t, int64_t, int * );
 static void ClearCache( AstMoc *, int * );
-static void CombineRanges( AstMoc *, int, const char *, int * );
+static void CombineRanges( AstMoc *, int, int, int, const char *, int * );
 static void Copy( const AstObject *, AstObject *, int * );
 static void Delete( AstObject *, int * );
 static void Dump( AstObject *, AstChannel *, int * );
 static void GetCell( AstMoc *, int, int *, int64_t *, int * );
 static void GetMocData( AstMoc *, size_t, void *, int * );
+static void GetMocRanges( AstMoc *, int, int *, int64_t *, int * );
 static void GetMocString( AstMoc *, int, size_t, char *, size_t *, int * );
 static void GetNorm( AstMoc *, const char *, int * );
 static void IncorporateCells( AstMoc *, CellList *, int, int, int, const char *, int * );
@@ -465,6 +469,7 @@ static void MergeRanges( AstMoc *, int, int * );
 static void NegateRanges( AstMoc *, int, int, int * );
 static void NestedToXy( int64_t, int, int *, int * );
 static void PutCell( AstMoc *, AstMapping **, AstDim, AstDim *, AstDim *, int, CellList *, int, void *, int, int *, const char *, int * );
+static void PutRange( int64_t *, int *, int64_t, int64_t );
 static void RegBaseBox( AstRegion *, double *, double *, int * );
 static void Sink1( void *, size_t, const char *, int * );
 static void Sink2( void *, size_t, const char *, int * );
@@ -793,7 +798,6 @@ f     MAXORDER  is negative.
    const int *pni;
    const int64_t *pnk;
    int icell;
-   int irange;
    int nold;
    int order;
    int shift;
@@ -873,13 +877,20 @@ f     MAXORDER  is negative.
          nold = this->nrange;
 
 /* Convert the supplied MOC data to a list of ranges of cells at
-  "maxorder" and append to the end of the ranges currently in the Moc. */
+  "maxorder" and append to the end of the ranges currently in the Moc.
+   The ranges array is extended once to accommodate the worst case (one
+   range per cell). Cells that are contiguous with the previous cell are
+   added into the previous range, so the number of ranges to be sorted
+   and merged by astMocNorm is usually much less than the number of
+   cells. */
+         this->range = astGrow( this->range, nold + len, 2*sizeof(*(this->range)) );
+         pr = this->range + 2*nold;
          if( nbyte == 4 ) {
             pni = data;
          } else {
             pnk = data;
          }
-         for( icell = 0; icell < len; icell++ ) {
+         for( icell = 0; icell < len && astOK; icell++ ) {
 
 /* Decode the data value (a "nuniq" value) to get the order and npix, using
    a fast log2 function. */
@@ -902,15 +913,15 @@ f     MAXORDER  is negative.
                ihigh = ( npix >> -shift );
             }
 
-/* Append this as a new range to the Moc. */
-            irange = this->nrange++;
-            this->range = astGrow( this->range, this->nrange, 2*sizeof(*(this->range)) );
-            if( astOK ) {
-               pr = this->range + 2*irange;
-               pr[ 0 ] = ilow;
-               pr[ 1 ] = ihigh;
+/* Extend the previous new range if possible. Otherwise, append this as
+   a new range to the Moc. */
+            if( this->nrange > nold && ilow >= pr[ -2 ] &&
+                ilow <= pr[ -1 ] + 1 ) {
+               if( ihigh > pr[ -1 ] ) pr[ -1 ] = ihigh;
             } else {
-               break;
+               this->nrange++;
+               *(pr++) = ilow;
+               *(pr++) = ihigh;
             }
          }
 
@@ -920,6 +931,197 @@ f     MAXORDER  is negative.
    }
 }
 
+static void AddMocRanges( AstMoc *this, int cmode, int negate, int order,
+                          int nrange, const int64_t *ranges, int *status ) {
+/*
+*++
+*  Name:
+c     astAddMocRanges
+f     AST_ADDMOCRANGES
+
+*  Purpose:
+*     Adds a list of HEALPix cell ranges into an existing Moc.
+
+*  Type:
+*     Public virtual function.
+
+*  Synopsis:
+c     #include "moc.h"
+c     void astAddMocRanges( AstMoc *this, int cmode, int negate, int order,
+c                           int nrange, const int64_t *ranges )
+f     CALL AST_ADDMOCRANGES( THIS, CMODE, NEGATE, ORDER, NRANGE, RANGES,
+f                            STATUS )
+
+*  Class Membership:
+*     Moc method.
+
+*  Description:
+*     This function modifies a Moc by combining it with a list of ranges
+*     of HEALPix cells, all at the same order. The way in which they
+*     are combined is determined by the
+c     "cmode" parameter.
+*
+*     Each range contributes all the cells between its lower and upper
+*     "npix" values. Describing a MOC in this way is usually much more
+*     compact than listing the individual cells, and so provides a fast
+*     way of transferring large MOCs into a Moc. If the ranges are
+*     supplied in increasing order (as returned by
+c     astGetMocRanges),
+f     AST_GETMOCRANGES),
+*     no sorting is required.
+
+*  Parameters:
+c     this
+f     THIS = INTEGER (Given)
+*        Pointer to the Moc to be modified.
+c     cmode
+f     CMODE = INTEGER (Given)
+*        Indicates how the Moc and ranges are to be combined. Any of the
+*        following values may be supplied:
+*        - AST__AND: The modified Moc is the intersection of the original
+*        Moc and the ranges.
+*        - AST__OR: The modified Moc is the union of the original Moc and
+*        the ranges.
+*        - AST__XOR: The modified Moc is the exclusive disjunction of the
+*        original Moc and the ranges.
+c     negate
+f     NEGATE = LOGICAL (Given)
+*        If
+c        zero,
+f        .FALSE.,
+*        the cells added to the Moc will be those included in the
+*        supplied ranges.
+*        If
+c        non-zero,
+f        .TRUE.,
+*        the cells added to the Moc will be those not included in the
+*        supplied ranges.
+c     order
+f     ORDER = INTEGER (Given)
+*        The HEALPix order of the cells in the supplied ranges. If no value
+*        has been set for the MaxOrder attribute, calling this method causes
+*        it to be set to the supplied order value. If
+c        "order"
+f        ORDER
+*        is greater than the MaxOrder value, the supplied ranges are
+*        degraded to the resolution of MaxOrder.
+c     nrange
+f     NRANGE = INTEGER (Given)
+*        The number of ranges supplied. If zero is supplied, and
+c        "negate"
+f        NEGATE
+*        is set, the ranges are taken to cover the whole sky.
+c     ranges
+f     RANGES( 2, NRANGE ) = INTEGER*8 (Given)
+c        Pointer to an array holding "2*nrange" values. Each
+c        consecutive pair of values holds the lower and upper "npix"
+c        values (inclusive) for a single range of cells.
+f        An array holding the lower and upper "npix" values (inclusive)
+f        for each range of cells.
+f     STATUS = INTEGER (Given and Returned)
+f        The global status.
+
+*--
+*/
+
+/* Local Variables: */
+   const int64_t *pi;
+   int64_t allsky[ 2 ];
+   int irange;
+   int maxorder;
+   int nold;
+   int shift;
+   int64_t *pr;
+   int64_t ihigh;
+   int64_t ilow;
+   int64_t maxnpix;
+
+/* Check the global error status. */
+   if ( !astOK ) return;
+
+/* Validate */
+   if( order < 0 || order > AST__MXORDHPX ) {
+      astError( AST__INVAR, "astAddMocRanges(%s): Invalid value (%d) "
+                "supplied for parameter 'order' - must be no greater "
+                "than %d.", status, astGetClass( this ), order,
+                AST__MXORDHPX );
+
+   } else if( nrange < 0 ) {
+      astError( AST__INVAR, "astAddMocRanges(%s): Invalid value (%d) "
+                "supplied for parameter 'nrange' - must not be "
+                "negative.", status, astGetClass( this ), nrange );
+
+/* If no ranges are supplied, the resulting Moc will be unchanged unless
+   "cmode" is AST__AND, in which case the resulting Moc will be empty.
+   If "negate" is set, the supplied ranges instead describe the whole
+   sky, and so the Moc is unchanged if "cmode" is AST__AND. */
+   } else if( nrange == 0 && ( !negate || cmode == AST__AND ) ) {
+      if( cmode == AST__AND && !negate ) {
+         this->nrange = 0;
+         this->range = astFree( this->range );
+         ClearCache( this, status );
+      }
+
+/* Otherwise, get MaxOrder, setting it to "order" if it is not set. */
+   } else {
+      if( astTestMaxOrder( this ) ) {
+         maxorder = astGetMaxOrder( this );
+      } else {
+         maxorder = order;
+         astSetMaxOrder( this, order );
+      }
+
+/* A negated empty list of ranges is equivalent to a single range
+   covering the whole sky. */
+      if( nrange == 0 ) {
+         allsky[ 0 ] = 0;
+         allsky[ 1 ] = MaxNpix( order );
+         ranges = allsky;
+         nrange = 1;
+         negate = 0;
+      }
+
+/* Extend the ranges array in the Moc to accommodate the new ranges. */
+      nold = this->nrange;
+      this->range = astGrow( this->range, nold + nrange,
+                             2*sizeof(*(this->range)) );
+
+/* Convert each supplied range to a range of cells at "maxorder" and
+   append it to the end of the ranges currently in the Moc. */
+      maxnpix = MaxNpix( order );
+      shift = 2*( maxorder - order );
+      pi = ranges;
+      pr = this->range + 2*nold;
+      for( irange = 0; irange < nrange && astOK; irange++ ) {
+         ilow = *(pi++);
+         ihigh = *(pi++);
+
+         if( ilow < 0 || ilow > ihigh || ihigh > maxnpix ) {
+            astError( AST__INVAR, "astAddMocRanges(%s): Invalid range "
+                      "(%" PRId64 " to %" PRId64 ") supplied at index %d "
+                      "of parameter 'ranges' - must be an increasing "
+                      "range within 0 to %" PRId64 ".", status,
+                      astGetClass( this ), ilow, ihigh, irange, maxnpix );
+
+         } else {
+            if( shift > 0 ) {
+               *(pr++) = ( ilow << shift );
+               *(pr++) = ( ( ihigh + 1 ) << shift ) - 1;
+            } else {
+               *(pr++) = ( ilow >> -shift );
+               *(pr++) = ( ihigh >> -shift );
+            }
+         }
+      }
+
+/* Normalise the Moc. If an error occurred, discard the new ranges. */
+      if( astOK ) {
+         this->nrange += nrange;
+         astMocNorm( this, negate, cmode, nold, maxorder, "astAddMocRanges" );
+      }
+   }
+}
+
 static void AddMocString( AstMoc *this, int cmode, int negate, int maxorder,
                           size_t len, const char *string, int *json,
                           int *status ) {
@@ -1150,15 +1352,13 @@ void astAddMocText_( AstMoc *this, int maxorder,
    int shift;
    int state;
    int64_t *pr;
+   int64_t *values;
    int64_t ihigh;
    int64_t ilow;
    int64_t ipix;
-   int64_t nadd;
    int64_t npix0;
    int64_t npix;
-   int64_t nval;
-   size_t *values;
-   size_t nbyte;
+   int64_t nrange;
    size_t nc;
 
 /* Initialise */
@@ -1195,10 +1395,13 @@ void astAddMocText_( AstMoc *this, int maxorder,
    holding the first characters to read. */
       text = (*source)( data, &nc, status );
 
-/* Initialise the list of NPIX values at each order. */
+/* Initialise the list of NPIX ranges at each order. Contiguous NPIX
+   values are stored as a single range, so the text can be read in a
+   single pass without expanding any ranges it contains into separate
+   cells. */
       for( order = 0; order <= AST__MXORDHPX; order++ ) {
-         orders[ order ].nval = 0;
-         orders[ order ].values = NULL;
+         orders[ order ].nrange = 0;
+         orders[ order ].ranges = NULL;
       }
 
 /* Loop to parse all available text. This loop populates the above array
@@ -1355,15 +1558,8 @@ void astAddMocText_( AstMoc *this, int maxorder,
 /* When the NPIX value is complete append it to the current list of NPIX
    values for the current order. */
                   if( state != 6 ) {
-                     nval = orders[ order ].nval;
-                     if( nval == 0 && order > mxord ) mxord = order;
-                     nbyte = ( nval + 1 )*sizeof( size_t );
-                     values = astGrow( orders[ order ].values, 1, nbyte );
-                     if( astOK ) {
-                        values[ nval ] = npix;
-                        orders[ order ].values = values;
-                        orders[ order ].nval = nval + 1;
-                     }
+                     if( order > mxord ) mxord = order;
+                     AppendRange( orders + order, npix, npix, status );
                   }
 
 /* If we are looking for a comma or closing square bracket marking the
@@ -1458,10 +1654,8 @@ void astAddMocText_( AstMoc *this, int maxorder,
 
                      if( !isrange ) {
                         npix0 = npix;
-                        nadd = 1;
                      } else if( npix >= npix0 ){
                         isrange = 0;
-                        nadd = npix - npix0 + 1;
                      } else {
                         astError( AST__INMOC, "%s(%s): Invalid string MOC supplied: '%.30s...'",
                                   status, method, astGetClass( this ), text );
@@ -1470,18 +1664,7 @@ void astAddMocText_( AstMoc *this, int maxorder,
                         break;
                      }
 
-                     nval = orders[ order ].nval;
-                     nbyte = ( nval + nadd )*sizeof( size_t );
-                     values = astGrow( orders[ order ].values, 1, nbyte );
-                     if( astOK ) {
-                        for( ; npix0 <= npix; npix0++ ) {
-                           values[ nval++ ] = npix0;
-                        }
-
-                        orders[ order ].values = values;
-                        orders[ order ].nval = nval;
-                     }
-
+                     AppendRange( orders + order, npix0, npix, status );
                      state = 1;
 
 /* slash - the value previously recorded is an order value. Update the
@@ -1562,23 +1745,12 @@ void astAddMocText_( AstMoc *this, int maxorder,
 
             if( !isrange ) {
                npix0 = npix;
-               nadd = 1;
             } else {
                isrange = 0;
-               nadd = npix - npix0 + 1;
             }
 
-            nval = orders[ order ].nval;
-            nbyte = ( nval + nadd )*sizeof( size_t );
-            values = astGrow( orders[ order ].values, 1, nbyte );
-            if( astOK ) {
-               for( ; npix0 <= npix; npix0++ ) {
-                  values[ nval++ ] = npix0;
-               }
-
-               orders[ order ].values = values;
-               orders[ order ].nval = nval;
-            }
+            if( npix0 <= npix ) AppendRange( orders + order, npix0, npix,
+                                             status );
          }
 
 /* If the MaxOrder attribute is set in the Moc, use it in preference to
@@ -1602,44 +1774,39 @@ void astAddMocText_( AstMoc *this, int maxorder,
             astSetMaxOrder( this, maxorder );
          }
 
-/* For each order and NPIX value found during the parsing of the text
-   (except for any that have an order greater than 'maxorder', which are
-   ignored), get the upper and lower bounds of the cells at maxorder
-   contained within this cell, and append this as a new range to the Moc. */
+/* For each order and range of NPIX values found during the parsing of
+   the text, get the upper and lower bounds of the cells at maxorder
+   contained within the range, and append this as a new range to the Moc.
+   Cells with an order greater than 'maxorder' are degraded to
+   'maxorder'. */
          for( order = 0; order <= astMAX( maxorder, mxord ); order++ ) {
-            nval = orders[ order ].nval;
-            values = orders[ order ].values;
+            nrange = orders[ order ].nrange;
+            values = orders[ order ].ranges;
             shift = 2*( maxorder - order );
 
-            for( ipix = 0; ipix < nval; ipix++,values++ ){
-
-               if( shift > 0 ) {
-                  ilow = ( *values << shift );
-                  ihigh = ( (*values + 1 ) << shift ) - 1;
-               } else {
-                  ilow = ( *values >> -shift );
-                  ihigh = ( *values >> -shift );
-               }
-
-               irange = this->nrange++;
-               this->range = astGrow( this->range, this->nrange, 2*sizeof(*(this->range)) );
-               if( astOK ) {
-                  pr = this->range + 2*irange;
-                  pr[ 0 ] = ilow;
-                  pr[ 1 ] = ihigh;
-               } else {
-                  break;
+            irange = this->nrange;
+            this->range = astGrow( this->range, irange + nrange, 2*sizeof(*(this->range)) );
+            if( astOK ) {
+               this->nrange = irange + nrange;
+               pr = this->range + 2*irange;
+               for( ipix = 0; ipix < nrange; ipix++,values += 2 ){
+                  if( shift > 0 ) {
+                     ilow = ( values[ 0 ] << shift );
+                     ihigh = ( ( values[ 1 ] + 1 ) << shift ) - 1;
+                  } else {
+                     ilow = ( values[ 0 ] >> -shift );
+                     ihigh = ( values[ 1 ] >> -shift );
+                  }
+                  *(pr++) = ilow;
+                  *(pr++) = ihigh;
                }
             }
-
-/* Free the list of NPIX values at each order. */
-            orders[ order ].values = astFree( orders[ order ].values );
          }
+      }
 
-/* Free the list of NPIX values at any unused orders. */
-         for( ; order <= AST__MXORDHPX; order++ ) {
-            orders[ order ].values = astFree( orders[ order ].values );
-         }
+/* Free the list of NPIX ranges at each order. */
+      for( order = 0; order <= AST__MXORDHPX; order++ ) {
+         orders[ order ].ranges = astFree( orders[ order ].ranges );
       }
    }
 }
@@ -2798,6 +2965,70 @@ static void AppendChildren( AstMoc *this, Cell *cell, int order,
    }
 }
 
+static void AppendRange( List *list, int64_t lo, int64_t hi, int *status ){
+/*
+*  Name:
+*     AppendRange
+
+*  Purpose:
+*     Append a range of NPIX values to a List.
+
+*  Type:
+*     Private function.
+
+*  Synopsis:
+*     #include "moc.h"
+*     void AppendRange( List *list, int64_t lo, int64_t hi, int *status )
+
+*  Class Membership:
+*     Moc member function
+
+*  Description:
+*     This function appends a range of NPIX values to the supplied List.
+*     If the new range is contiguous with, or overlaps, the end of the
+*     last range in the List, the last range is extended instead. This
+*     means that runs of consecutive NPIX values require only a single
+*     range, so the memory needed to read a textual MOC depends on the
+*     number of ranges it contains rather than the number of cells.
+
+*  Parameters:
+*     list
+*        The List to extend.
+*     lo
+*        The first NPIX value in the range.
+*     hi
+*        The last NPIX value in the range.
+*     status
+*        Pointer to inherited status.
+
+*/
+
+/* Local Variables: */
+   int64_t *pr;
+
+/* Check inherited status */
+   if( !astOK ) return;
+
+/* Get a pointer to the last range in the List. */
+   pr = ( list->nrange > 0 ) ? list->ranges + 2*( list->nrange - 1 ) : NULL;
+
+/* If the new range starts within or immediately after the last range,
+   just extend the last range if required. */
+   if( pr && lo >= pr[ 0 ] && lo <= pr[ 1 ] + 1 ) {
+      if( hi > pr[ 1 ] ) pr[ 1 ] = hi;
+
+/* Otherwise, append a new range, extending the array as required. */
+   } else {
+      list->ranges = astGrow( list->ranges, list->nrange + 1,
+                              2*sizeof( *(list->ranges) ) );
+      if( astOK ) {
+         pr = list->ranges + 2*( list->nrange++ );
+         pr[ 0 ] = lo;
+         pr[ 1 ] = hi;
+      }
+   }
+}
+
 static void ClearAttrib( AstObject *this_object, const char *attrib, int *status ) {
 /*
 *  Name:
@@ -2980,8 +3211,8 @@ static void ClearMaxOrder( AstMoc *this, int *status ){
    ClearCache( this, status );
 }
 
-static void CombineRanges( AstMoc *this, int cmode, const char *method,
-                           int *status ){
+static void CombineRanges( AstMoc *this, int nold, int cmode, int negate,
+                           const char *method, int *status ){
 /*
 *  Name:
 *     CombineRanges
@@ -2994,19 +3225,33 @@ static void CombineRanges( AstMoc *this, int cmode, const char *method,
 
 *  Synopsis:
 *     #include "moc.h"
-*     void CombineRanges( AstMoc *this, int cmode, const char *method,
-*                         int *status )
+*     void CombineRanges( AstMoc *this, int nold, int cmode, int negate,
+*                         const char *method, int *status )
 
 *  Class Membership:
 *     Moc member function
 
 *  Description:
-*     This function combines the separate ranges of nested index stored
-*     in a Moc, using the specified combination method.
+*     This function combines two separate lists of ranges of nested
+*     index stored in a Moc, using the specified combination method.
+*     The first list contains ranges zero to "nold-1" and the second
+*     list contains the remaining ranges. Each list should be normalised
+*     (i.e. sorted into increasing order, with no overlapping or
+*     adjacent ranges). If the first list is not normalised, it is
+*     normalised before being used.
+*
+*     The two lists are combined in a single linear pass. Where one
+*     list contains a long run of ranges that are entirely below the
+*     current range in the other list, the end of the run is found using
+*     an exponential search and the whole run is copied (or skipped) in
+*     one go. So combining a small list with a large list takes time
+*     roughly proportional to the size of the small list.
 
 *  Parameters:
 *     this
 *        Pointer to the Moc.
+*     nold
+*        The number of ranges in the first list.
 *     cmode
 *        Indicates how the ranges are to be combined. Any of the following
 *        values may be supplied:
@@ -3016,6 +3261,10 @@ static void CombineRanges( AstMoc *this, int cmode, const char *method,
 *        the cell list.
 *        - AST__XOR: The modified Moc is the exclusive disjunction of the
 *        original Moc and the cell list.
+*     negate
+*        If non-zero, the cells in the second list are excluded from
+*        the result, which then contains the cells that are in the first
+*        list but not in the second list. The "cmode" value is ignored.
 *     method:
 *        Name of calling method.
 *     status
@@ -3024,285 +3273,164 @@ static void CombineRanges( AstMoc *this, int cmode, const char *method,
 */
 
 /* Local Variables: */
-   EndPoint *list;
-   EndPoint *plist;
-   int depth;
-   int ipoint;
-   int irange;
-   int isstart;
+   int i;
+   int j;
+   int k;
+   int keepa;
+   int keepab;
+   int keepb;
+   int na;
+   int nb;
    int nnew;
-   int npoint;
    int64_t *newranges;
-   int64_t *pnew;
-   int64_t *pcur;
-   int64_t *pw;
-   int64_t *pr;
+   int64_t *ra;
+   int64_t *rb;
+   int64_t ahi;
+   int64_t alo;
+   int64_t bhi;
+   int64_t blo;
+   int64_t m;
 
 /* Check inherited status */
    if( !astOK ) return;
 
-/* Nothing to do if there are fewer than 2 ranges in the Moc. */
-   if( this->nrange > 1 ) {
-
-/* Create an array of structures, each holding the start or end value of
-   a range, and a flag indicating if the value is the start or the end. */
-      npoint = 2*this->nrange;
-      list = astCalloc( npoint, sizeof( *list ) );
-      if( astOK ) {
-         plist = list;
-         pnew = this->range;
-         isstart = 1;
-         for( ipoint = 0; ipoint < npoint; ipoint++,plist++,pnew++ ) {
-            plist->value = *pnew;
-            plist->start = isstart;
-            isstart = ( isstart == 0 );
-         }
-
-/* Sort these structures into ascending value. */
-         qsort( list, npoint, sizeof(*list), Comp_endpoint );
-
-/* Allocate an initial array to hold the new list of merged ranges. This
-   array will grow in size dynamically if required. */
-         newranges = astCalloc( npoint, sizeof( *(this->range) ) );
-      }
-
-      if( astOK ) {
-
-/* Initialise the number of input ranges that encompass the current
-   value. */
-         depth = 0;
+/* Determine which cells to keep - those only in the first list, those
+   only in the second list and those in both lists. */
+   keepa = 0;
+   keepb = 0;
+   keepab = 0;
+   if( negate ) {
+      keepa = 1;
+   } else if( cmode == AST__OR ){
+      keepa = 1;
+      keepb = 1;
+      keepab = 1;
+   } else if( cmode == AST__AND ){
+      keepab = 1;
+   } else if( cmode == AST__XOR ){
+      keepa = 1;
+      keepb = 1;
+   } else {
+      astError( AST__BDPAR, "%s(%s): Bad value (%d) suppied for "
+                "parameter 'cmode'.", status, method,
+                astGetClass(this), cmode );
+   }
 
-/* Result is union of old and new */
-/* ------------------------------ */
-         if( cmode == AST__OR ){
-
-/* The number of new ranges will never be greater than the number of original
-   ranges, so we can safely use the initial newranges array without checking
-   its size. Loop round each end-point in the sorted list. Maintain a depth
-   indicating how many input ranges are active at each point. */
-            nnew = 0;
-            pnew = newranges;
-            plist = list;
-            for( ipoint = 0; ipoint < npoint; ipoint++,plist++ ) {
-
-/* If this end-point is the start of one of the original ranges, and we
-   are not currently inside a range, record the start of a new range.
-   Increment the number of original ranges that include the current value. */
-               if( plist->start ) {
-                  if( !depth ) pnew[ 0 ] = plist->value;
-                  depth++;
-
-/* If this end-point is the end of one of the original ranges, decrement
-   the number of original ranges that include the current value. If we
-   are then no longer inside a range, record the end of a new range. */
-               } else {
-                  depth--;
-                  if( !depth ) {
-                     pnew[ 1 ] = plist->value;
-                     nnew++;
-                     pnew += 2;
-                  } else if( depth < 0 ) {
-                     astError( AST__INTER, "CombineRanges(%s): Negative depth "
-                               "at end-point %" PRId64 " (internal programming"
-                               " error).", status, astGetClass(this),
-                               plist->value );
-                     break;
-                  }
-               }
+/* Get pointers to the two lists, ensuring the first is normalised. The
+   number of ranges in the result can never be more than the total
+   number of ranges in the two lists. */
+   ra = this->range;
+   na = SortRanges( ra, nold );
+   rb = this->range + 2*nold;
+   nb = this->nrange - nold;
+   newranges = astMalloc( 2*( na + nb )*sizeof( *newranges ) );
+
+/* Initialise the current range in each list. As each range is processed,
+   its lower bound is moved upwards to exclude the cells that have
+   already been handled. */
+   if( astOK ) {
+      nnew = 0;
+      i = 0;
+      j = 0;
+      alo = ( na > 0 ) ? ra[ 0 ] : 0;
+      ahi = ( na > 0 ) ? ra[ 1 ] : 0;
+      blo = ( nb > 0 ) ? rb[ 0 ] : 0;
+      bhi = ( nb > 0 ) ? rb[ 1 ] : 0;
+
+/* Loop until one of the lists has been exhausted. */
+      while( i < na && j < nb ) {
+
+/* If the current range in the first list ends before the current range
+   in the second list starts, handle it, and then find the first
+   following range that ends at or after the start of the current
+   range in the second list. All the ranges in between can be handled
+   as a block. */
+         if( ahi < blo ) {
+            k = GallopRanges( ra, na, i + 1, blo );
+            if( keepa ) {
+               PutRange( newranges, &nnew, alo, ahi );
+               memcpy( newranges + 2*nnew, ra + 2*i + 2,
+                       2*( k - i - 1 )*sizeof( *newranges ) );
+               nnew += k - i - 1;
+            }
+            i = k;
+            if( i < na ) {
+               alo = ra[ 2*i ];
+               ahi = ra[ 2*i + 1 ];
             }
 
-/* Result is intersection of old and new */
-/* ------------------------------ */
-         } else if( cmode == AST__AND ){
-
-/* We cannot put a limit on how many ranges we shall end up with, so
-   we grow the newranges array dynamically as required. Loop round
-   each end-point in the sorted list. Maintain a depth indicating how many
-   input ranges are active at each point. */
-            nnew = 0;
-            pnew = newranges;
-            plist = list;
-            for( ipoint = 0; ipoint < npoint; ipoint++,plist++ ) {
-
-/* If this end-point is the start of one of the original ranges,
-   increment the number of ranges that are active at the current value.
-   Otherwise, decrement the number. */
-               if( plist->start ) {
-                  depth++;
-               } else {
-                  depth--;
-               }
+/* Do the same if the current range in the second list ends before the
+   current range in the first list starts. */
+         } else if( bhi < alo ) {
+            k = GallopRanges( rb, nb, j + 1, alo );
+            if( keepb ) {
+               PutRange( newranges, &nnew, blo, bhi );
+               memcpy( newranges + 2*nnew, rb + 2*j + 2,
+                       2*( k - j - 1 )*sizeof( *newranges ) );
+               nnew += k - j - 1;
+            }
+            j = k;
+            if( j < nb ) {
+               blo = rb[ 2*j ];
+               bhi = rb[ 2*j + 1 ];
+            }
 
-/* If the depth has risen to more than 2, report an error. */
-               if( depth > 2 ) {
-                  astError( AST__INTER, "CombineRanges(%s): More than 2 "
-                            "active ranges at %" PRId64 " (internal programming "
-                            "error).", status, astGetClass(this), plist->value );
-                  break;
+/* Otherwise the two current ranges overlap. Handle any cells at the
+   start that are in only one of the two ranges. */
+         } else if( alo < blo ) {
+            if( keepa ) PutRange( newranges, &nnew, alo, blo - 1 );
+            alo = blo;
 
-/* If the depth has risen to 2, record the start of a new range. */
-               } else if( depth == 2 ) {
-                  newranges = astGrow( newranges, nnew + 1,
-                                       2*sizeof( *newranges ) );
-                  if( astOK ) {
-                     pnew = newranges + 2*nnew;
-                     pnew[ 0 ] = plist->value;
-                     nnew++;
-                  } else {
-                     break;
-                  }
+         } else if( blo < alo ) {
+            if( keepb ) PutRange( newranges, &nnew, blo, alo - 1 );
+            blo = alo;
 
-/* If the depth has dropped to 1, record the end of the new range. */
-               } else if( depth == 1 && !plist->start ){
-                  pnew[ 1 ] = plist->value;
-
-/* If the depth has become negative, report an error. */
-               } else if( depth < 0 ) {
-                  astError( AST__INTER, "CombineRanges(%s): Negative depth at "
-                            "%" PRId64 " (internal programming error).", status,
-                            astGetClass(this), plist->value );
-                  break;
+/* Both ranges now start at the same cell. Handle the cells that are in
+   both ranges, and move on to the next range in any list for which the
+   current range has been exhausted. */
+         } else {
+            m = ( ahi < bhi ) ? ahi : bhi;
+            if( keepab ) PutRange( newranges, &nnew, alo, m );
 
-/* Otherwise (depth has risen to 1 or dropped to 0), do nothing. */
-               } else {
+            if( ahi == m ) {
+               if( ++i < na ) {
+                  alo = ra[ 2*i ];
+                  ahi = ra[ 2*i + 1 ];
                }
+            } else {
+               alo = m + 1;
             }
 
-/* Result is exclusive disjunction of old and new */
-/* ---------------------------------------------- */
-         } else if( cmode == AST__XOR ){
-
-/* We cannot put a limit on how many ranges we shall end up with, so
-   we grow the newranges array dynamically as required. Loop round
-   each end-point in the sorted list. Maintain a depth indicating how many
-   input ranges are active at each point. */
-            nnew = 0;
-            pnew = newranges;
-            plist = list;
-            for( ipoint = 0; ipoint < npoint; ipoint++,plist++ ) {
-
-/* If this end-point is the start of one of the original ranges,
-   increment the number of ranges that are active at the current value.
-   Otherwise, decrement the number. */
-               if( plist->start ) {
-                  depth++;
-               } else {
-                  depth--;
-               }
-
-/* If the depth has risen to more than 2, report an error. */
-               if( depth > 2 ) {
-                  astError( AST__INTER, "CombineRanges(%s): More than 2 "
-                            "active ranges at %" PRId64 " (internal programming "
-                            "error).", status, astGetClass(this), plist->value );
-                  break;
-
-/* If the depth has risen to 2, end the current range. Ignore ranges that
-   have negative length. */
-               } else if( depth == 2 ) {
-                  pnew[ 1 ] = plist->value - 1;
-                  if( pnew[ 1 ] < pnew[ 0 ] ) nnew--;
-
-/* If the depth has dropped or risen to 1, record the start of a new range. */
-               } else if( depth == 1 ){
-                  newranges = astGrow( newranges, nnew + 1,
-                                       2*sizeof( *newranges ) );
-                  if( astOK ) {
-                     pnew = newranges + 2*nnew;
-                     pnew[ 0 ] = plist->value;
-                     if( !plist->start ) pnew[ 0 ]++;
-                     nnew++;
-                  } else {
-                     break;
-                  }
-
-/* If the depth has become negative, report an error. */
-               } else if( depth < 0 ) {
-                  astError( AST__INTER, "CombineRanges(%s): Negative depth at "
-                            "%" PRId64 " (internal programming error).", status,
-                            astGetClass(this), plist->value );
-                  break;
-
-/* Otherwise (depth has dropped to 0), end the current range. Ignore
-   ranges that have negative length. */
-               } else {
-                  pnew[ 1 ] = plist->value;
-                  if( pnew[ 1 ] < pnew[ 0 ] ) nnew--;
+            if( bhi == m ) {
+               if( ++j < nb ) {
+                  blo = rb[ 2*j ];
+                  bhi = rb[ 2*j + 1 ];
                }
+            } else {
+               blo = m + 1;
             }
-
-/* Unknown operation new */
-/* --------------------- */
-         } else if( astOK ){
-            astError( AST__BDPAR, "%s(%s): Bad value (%d) suppied for "
-                      "parameter 'cmode'.", status, method,
-                      astGetClass(this), cmode );
-         }
-
-/* Report an error if the final depth is non-zero. */
-         if( depth != 0 && astOK ) {
-            astError( AST__INTER, "CombineRanges(%s): Un-balanced ranges - "
-                      "final depth %d (internal programming error).", status,
-                      astGetClass(this), depth );
          }
       }
 
-/* Store the new ranges in the Moc. */
-      if( astOK ) {
-         (void) astFree( this->range );
-         this->range = newranges;
-         this->nrange =  nnew;
+/* Copy any remaining ranges from the list that has not been exhausted. */
+      if( i < na && keepa ) {
+         PutRange( newranges, &nnew, alo, ahi );
+         memcpy( newranges + 2*nnew, ra + 2*i + 2,
+                 2*( na - i - 1 )*sizeof( *newranges ) );
+         nnew += na - i - 1;
       }
 
-/* Check the new ranges do not overlap and are not reversed. */
-      if( astOK && this->nrange > 0 ) {
-         pcur = this->range;
-         if( pcur[ 1 ] < pcur[ 0 ] ) {
-            astError( AST__INTER, "CombineRanges(%s): Range 0 [%" PRId64 ":%" PRId64 "]"
-                      " - upper bound lower than lower bound (internal "
-                      "programming error).", status, astGetClass(this),
-                      pcur[ 0 ], pcur[ 1 ] );
-         } else {
-            pnew = this->range + 2;
-            for( irange = 1; irange < this->nrange; irange++,pnew += 2 ) {
-               if( pnew[ 1 ] < pnew[ 0 ] ) {
-                  astError( AST__INTER, "CombineRanges(%s): Range %d [%" PRId64 ":%" PRId64 "]"
-                            " - upper bound lower than lower bound (internal "
-                            "programming error).", status, astGetClass(this),
-                            irange, pnew[ 0 ], pnew[ 1 ] );
-                  break;
-
-               } else if( pcur[ 1 ] >= pnew[ 0 ] ) {
-                  astError( AST__INTER, "CombineRanges(%s): Range %d [%" PRId64 ":%" PRId64 "]"
-                            " overlaps range %d [%" PRId64 ":%" PRId64 "] (internal programming "
-                            "error).", status, astGetClass(this), irange - 1,
-                            pcur[ 0 ], pcur[ 1 ], irange, pnew[ 0 ], pnew[ 1 ] );
-                  break;
-
-/* Flag adjacent ranges to be merged. */
-               } else if( pcur[ 1 ] == pnew[ 0 ] - 1 ) {
-                  pcur[ 1 ] = INT64_MIN;
-                  pnew[ 0 ] = INT64_MIN;
-                  nnew--;
-               }
-               pcur = pnew;
-            }
-
-/* Merge any adjacent ranges. */
-            if( nnew < this->nrange ) {
-               npoint = 2*this->nrange;
-               pr = this->range;
-               pw = this->range;
-               for( ipoint = 0; ipoint < npoint; ipoint++,pr++ ){
-                  if( *pr != INT64_MIN ) *(pw++) = *pr;
-               }
-               this->nrange = nnew;
-            }
-         }
+      if( j < nb && keepb ) {
+         PutRange( newranges, &nnew, blo, bhi );
+         memcpy( newranges + 2*nnew, rb + 2*j + 2,
+                 2*( nb - j - 1 )*sizeof( *newranges ) );
+         nnew += nb - j - 1;
       }
 
-/* Free resources */
-      list = astFree( list );
+/* Store the new ranges in the Moc. */
+      (void) astFree( this->range );
+      this->range = astRealloc( newranges, 2*nnew*sizeof( *newranges ) );
+      this->nrange = nnew;
    }
 
 /* Clear the cached information stored in the Moc structure so that it is
@@ -3464,54 +3592,6 @@ static int Comp_decra( const void *a, const void *b ){
    }
 }
 
-static int Comp_endpoint( const void *a, const void *b ){
-/*
-*  Name:
-*     Comp_endpoint
-
-*  Purpose:
-*     A comparison function for use with the qsort function.
-
-*  Type:
-*     Private function.
-
-*  Synopsis:
-*     #include "moc.h"
-*     int Comp_endpoint( const void *a, const void *b )
-
-*  Class Membership:
-*     Moc member function
-
-*  Description:
-*     This function compares two EndPoint structures and returns
-*     a value indicating which has the larger value. If they are the
-*     same, then the end point is considered larger than the start point.
-
-*  Parameters:
-*     a
-*        Pointer to the first EndPoint.
-*     b
-*        Pointer to the second EndPoint.
-
-*  Returned Value:
-*     An integer less than, equal to, or greater than  zero if  the
-*     first  parameter  is considered to be respectively less than,
-*     equal to, or greater than the second.
-
-*/
-   if( ((EndPoint *) a)->value < ((EndPoint *) b)->value ) {
-      return -1;
-   } else if( ((EndPoint *) a)->value > ((EndPoint *) b)->value ) {
-      return 1;
-   } else if( ((EndPoint *) a)->start && !((EndPoint *) b)->start ) {
-      return -1;
-   } else if( !((EndPoint *) a)->start && ((EndPoint *) b)->start ) {
-      return 1;
-   } else {
-      return 0;
-   }
-}
-
 static int Comp_range( const void *a, const void *b ){
 /*
 *  Name:
@@ -3873,6 +3953,85 @@ static AstFrame *FindSkyAxes( AstFrame *frame, const char *method,
    return result;
 }
 
+static int GallopRanges( const int64_t *ranges, int nrange, int start,
+                         int64_t value ){
+/*
+*  Name:
+*     GallopRanges
+
+*  Purpose:
+*     Find the first range that ends at or after a given value.
+
+*  Type:
+*     Private function.
+
+*  Synopsis:
+*     #include "moc.h"
+*     int GallopRanges( const int64_t *ranges, int nrange, int start,
+*                       int64_t value )
+
+*  Class Membership:
+*     Moc member function
+
+*  Description:
+*     This function returns the index of the first range, at or after a
+*     given starting index, that has an upper bound greater than or equal
+*     to a given value. The ranges must be normalised. An exponential
+*     search is used, so the cost is proportional to the logarithm of
+*     the number of ranges skipped.
+
+*  Parameters:
+*     ranges
+*        Pointer to an array holding the lower and upper bound of each
+*        range.
+*     nrange
+*        The number of ranges in the array.
+*     start
+*        The index of the first range to check.
+*     value
+*        The required value.
+
+*  Returned Value:
+*     The index of the first range at or after "start" that has an upper
+*     bound greater than or equal to "value", or "nrange" if there is no
+*     such range.
+
+*/
+
+/* Local Variables: */
+   int hi;
+   int lo;
+   int mid;
+   int step;
+
+/* Return "start" if the first range ends at or after the value. */
+   if( start >= nrange || ranges[ 2*start + 1 ] >= value ) return start;
+
+/* Find an interval (lo,hi] that contains the required range, doubling
+   the size of the interval each time. The range at "lo" always ends
+   before the value. */
+   lo = start;
+   step = 1;
+   hi = lo + step;
+   while( hi < nrange && ranges[ 2*hi + 1 ] < value ) {
+      lo = hi;
+      step *= 2;
+      hi = ( step < nrange - lo ) ? lo + step : nrange;
+   }
+   if( hi > nrange ) hi = nrange;
+
+/* Use a binary chop to find the required range within the interval. */
+   while( hi - lo > 1 ) {
+      mid = lo + ( hi - lo )/2;
+      if( ranges[ 2*mid + 1 ] < value ) {
+         lo = mid;
+      } else {
+         hi = mid;
+      }
+   }
+   return hi;
+}
+
 static const char *GetAttrib( AstObject *this_object, const char *attrib, int *status ) {
 /*
 *  Name:
@@ -4479,6 +4638,96 @@ f        The global status.
    }
 }
 
+static void GetMocRanges( AstMoc *this, int mxrange, int *nrange,
+                          int64_t *ranges, int *status ) {
+/*
+*++
+*  Name:
+c     astGetMocRanges
+f     AST_GETMOCRANGES
+
+*  Purpose:
+*     Get the ranges of HEALPix cells included in a Moc.
+
+*  Type:
+*     Public virtual function.
+
+*  Synopsis:
+c     #include "moc.h"
+c     void astGetMocRanges( AstMoc *this, int mxrange, int *nrange,
+c                           int64_t *ranges )
+f     CALL AST_GETMOCRANGES( THIS, MXRANGE, NRANGE, RANGES, STATUS )
+
+*  Class Membership:
+*     Moc method.
+
+*  Description:
+*     This function returns the cells included in a Moc in the form of a
+*     list of disjoint ranges of HEALPix cells at the order given by the
+*     MaxOrder attribute. The ranges are returned in increasing order
+*     and no two ranges are contiguous. This is the form in which the
+*     Moc is stored internally, and so it can be obtained much more
+*     quickly than the FITS binary table form returned by
+c     astGetMocData.
+f     AST_GETMOCDATA.
+*
+*     The list can be passed to
+c     astAddMocRanges
+f     AST_ADDMOCRANGES
+*     to re-create the Moc.
+
+*  Parameters:
+c     this
+f     THIS = INTEGER (Given)
+*        Pointer to the Moc.
+c     mxrange
+f     MXRANGE = INTEGER (Given)
+*        The maximum number of ranges that can be stored in the supplied
+c        "ranges" array. If zero is supplied, the number of ranges is
+c        returned in "nrange" but the "ranges" array is not used (a NULL
+c        pointer may be supplied).
+f        RANGES array. If zero is supplied, the number of ranges is
+f        returned in NRANGE but the RANGES array is not used.
+*        Otherwise, an error is reported if the Moc contains more than
+c        "mxrange"
+f        MXRANGE
+*        ranges.
+c     nrange
+f     NRANGE = INTEGER (Returned)
+*        Returned holding the number of ranges in the Moc.
+c     ranges
+f     RANGES( 2, MXRANGE ) = INTEGER*8 (Returned)
+c        Pointer to an array with at least "2*mxrange" elements. Each
+c        consecutive pair of returned values holds the lower and upper
+c        "npix" values (inclusive) for a single range of cells at the
+c        order given by the MaxOrder attribute.
+f        Returned holding the lower and upper "npix" values (inclusive)
+f        for each range of cells, at the order given by the MaxOrder
+f        attribute.
+f     STATUS = INTEGER (Given and Returned)
+f        The global status.
+
+*--
+*/
+
+/* Check the global error status. */
+   if ( !astOK ) return;
+
+/* Return the number of ranges. */
+   *nrange = this->nrange;
+
+/* Copy the ranges into the supplied array if required. */
+   if( mxrange > 0 ) {
+      if( mxrange < this->nrange ) {
+         astError( AST__BADSIZ, "astGetMocRanges(%s): The supplied array "
+                   "can hold %d ranges but %d are required.", status,
+                   astGetClass(this), mxrange, this->nrange );
+      } else if( this->nrange > 0 ) {
+         memcpy( ranges, this->range, 2*this->nrange*sizeof(*ranges) );
+      }
+   }
+}
+
 static AstFitsChan *GetMocHeader( AstMoc *this, int *status ){
 /*
 *++
@@ -5158,7 +5407,7 @@ static void GetNorm( AstMoc *this, const char *method, int *status ){
             newranges = NULL; \
             nnew = 0; \
             pr = ranges; \
-            for( irange = 0; irange < nrange; irange++ ) { \
+            for( irange = 0; irange < nrange && astOK; irange++ ) { \
                min = *(pr++); \
                max = *(pr++); \
                m1 = ( ( min + offset ) >> shift ); \
@@ -5170,11 +5419,10 @@ static void GetNorm( AstMoc *this, const char *method, int *status ){
                                astGetClass( this ) ); \
                      break; \
                   } else { \
+                     norm = astGrow( norm, moclen + m2 - m1, sizeof(*norm) ); \
+                     if( !astOK ) break; \
                      for( npix = m1; npix < m2; npix++ ) { \
-                        norm = astGrow( norm, moclen+1, sizeof(*norm) ); \
-                        if( astOK ) { \
-                           norm[ moclen++ ] =  nuniq_offset + npix; \
-                       } \
+                        norm[ moclen++ ] =  nuniq_offset + npix; \
                      } \
                   } \
                   m1 = ( m1 << shift ); \
@@ -5707,6 +5955,7 @@ void astInitMocVtab_(  AstMocVtab *vtab, const char *name, int *status ) {
    virtual methods for this class. */
    vtab->AddRegion = AddRegion;
    vtab->AddMocData = AddMocData;
+   vtab->AddMocRanges = AddMocRanges;
    vtab->AddMocString = AddMocString;
    vtab->GetMocString = GetMocString;
    vtab->AddCell = AddCell;
@@ -5729,6 +5978,7 @@ void astInitMocVtab_(  AstMocVtab *vtab, const char *name, int *status ) {
 
    vtab->GetMocArea = GetMocArea;
    vtab->GetMocData = GetMocData;
+   vtab->GetMocRanges = GetMocRanges;
    vtab->GetMocType = GetMocType;
    vtab->GetMocLength = GetMocLength;
    vtab->GetMocHeader = GetMocHeader;
@@ -6376,10 +6626,7 @@ static void MergeRanges( AstMoc *this, int start, int *status ){
 */
 
 /* Local Variables: */
-   int irange;
    int nnew;
-   int64_t *pr;
-   int64_t *pw;
 
 /* Check inherited status */
    if( !astOK ) return;
@@ -6388,39 +6635,8 @@ static void MergeRanges( AstMoc *this, int start, int *status ){
    first range to be merged is the last range. */
    if( this->nrange > 1 && start < this->nrange - 1 ) {
 
-/* Sort the specified ranges into increasing order of lower bound. */
-      qsort( this->range + 2*start, this->nrange - start,
-             2*sizeof(*(this->range)), Comp_range );
-
-/* "nnew" is the number of ranges in the Moc after the merge. Initialise
-   it to the number of ranges not being merged, plus one (because the
-   two or more ranges being merged must produce at least one merged
-   range). */
-      nnew = start + 1;
-
-/* Merge contiguous or overlapping ranges. */
-      pw = this->range + 2*start;
-      pr = this->range + 2*start + 2;
-      for( irange = nnew; irange < this->nrange; irange++, pr += 2 ) {
-
-/* If the new range starts at or before the end of the current range, and
-   the new range ends after the end of the current range, extend the
-   current range to include the new range. */
-         if( pr[ 0 ] <= pw[ 1 ] + 1 ) {
-            if( pr[ 1 ] > pw[ 1 ] ) {
-               pw[ 1 ] = pr[ 1 ];
-            }
-
-/* If the new range starts after the end of the current range, increment
-   the current range and initialise it to the bounds of the current
-   range. */
-         } else {
-            pw += 2;
-            pw[ 0 ] = pr[ 0 ];
-            pw[ 1 ] = pr[ 1 ];
-            nnew++;
-         }
-      }
+/* Sort and merge the specified ranges. */
+      nnew = start + SortRanges( this->range + 2*start, this->nrange - start );
 
 /* Store the new number of ranges in the Moc. This may be smaller than
    the original number, but will never be greater. Then realloc the
@@ -6495,11 +6711,18 @@ void astMocNorm_( AstMoc *this, int negate, int cmode, int nold,
    MergeRanges( this, nold, status );
 
 /* If the cell list is to be inverted, we replace the new ranges
-   with the gaps between the new ranges. */
-   if( negate ) NegateRanges( this, nold, maxorder, status );
+   with the gaps between the new ranges. This is not needed if the
+   inverted ranges are to be combined using AST__AND, since the result
+   is then just the old ranges minus the new ranges, which CombineRanges
+   can form directly. */
+   if( negate && cmode != AST__AND ) {
+      NegateRanges( this, nold, maxorder, status );
+      negate = 0;
+   }
 
-/* Combine all the ranges using the specified combination method. */
-   CombineRanges( this, cmode, method, status );
+/* Combine the old and new ranges using the specified combination
+   method. */
+   CombineRanges( this, nold, cmode, negate, method, status );
 }
 
 static void NegateRanges( AstMoc *this, int start, int order,
@@ -6530,7 +6753,7 @@ static void NegateRanges( AstMoc *this, int start, int order,
 *
 *     Note, it is assumed that the ranges being negated are sorted into
 *     increasing order of lower bound and that they do not overlap or
-*     touch. These conditions can be achieved by calling CombineRanges
+*     touch. These conditions can be achieved by calling MergeRanges
 *     before calling this function.
 
 *  Parameters:
@@ -7176,6 +7399,58 @@ static void PutCell( AstMoc *this, AstMapping **map, AstDim ncell, AstDim *ix,
    inside = astFree( inside );
 }
 
+static void PutRange( int64_t *ranges, int *nrange, int64_t lo, int64_t hi ){
+/*
+*  Name:
+*     PutRange
+
+*  Purpose:
+*     Append a range to the end of a normalised list of ranges.
+
+*  Type:
+*     Private function.
+
+*  Synopsis:
+*     #include "moc.h"
+*     void PutRange( int64_t *ranges, int *nrange, int64_t lo, int64_t hi )
+
+*  Class Membership:
+*     Moc member function
+
+*  Description:
+*     This function appends a new range to the end of a list of ranges.
+*     If the new range touches or overlaps the last range in the list,
+*     the last range is extended instead. The new range must not start
+*     before the start of the last range in the list. The array must
+*     have room for the new range.
+
+*  Parameters:
+*     ranges
+*        Pointer to an array holding the lower and upper bound of each
+*        range.
+*     nrange
+*        Pointer to the number of ranges in the array. Updated on exit.
+*     lo
+*        The lower bound of the new range.
+*     hi
+*        The upper bound of the new range.
+
+*/
+
+/* Local Variables: */
+   int64_t *pr;
+
+/* Extend the last range if possible. Otherwise append a new range. */
+   pr = ranges + 2*( *nrange );
+   if( *nrange > 0 && lo <= pr[ -1 ] + 1 ) {
+      if( hi > pr[ -1 ] ) pr[ -1 ] = hi;
+   } else {
+      pr[ 0 ] = lo;
+      pr[ 1 ] = hi;
+      (*nrange)++;
+   }
+}
+
 static void RegBaseBox( AstRegion *this_region, double *lbnd,
                         double *ubnd, int *status ){
 /*
@@ -8874,6 +9149,70 @@ static void SetMaxOrder( AstMoc *this, int value, int *status ){
    ClearCache( this, status );
 }
 
+static int SortRanges( int64_t *ranges, int nrange ){
+/*
+*  Name:
+*     SortRanges
+
+*  Purpose:
+*     Normalise a list of ranges.
+
+*  Type:
+*     Private function.
+
+*  Synopsis:
+*     #include "moc.h"
+*     int SortRanges( int64_t *ranges, int nrange )
+
+*  Class Membership:
+*     Moc member function
+
+*  Description:
+*     This function sorts a list of ranges into increasing order of
+*     lower bound, and then merges any overlapping or adjacent ranges.
+*     The list is modified in place. The sort is skipped if the ranges
+*     are already in order.
+
+*  Parameters:
+*     ranges
+*        Pointer to an array holding the lower and upper bound of each
+*        range.
+*     nrange
+*        The number of ranges in the array.
+
+*  Returned Value:
+*     The number of ranges in the normalised list. This will never be
+*     greater than "nrange".
+
+*/
+
+/* Local Variables: */
+   int irange;
+   int nnew;
+   int64_t *pr;
+
+/* Nothing to do if there are fewer than two ranges. */
+   if( nrange < 2 ) return nrange;
+
+/* Sort the ranges into increasing order of lower bound. Ranges are
+   usually already in order, so check for this first to avoid the cost
+   of the sort. */
+   pr = ranges;
+   for( irange = 1; irange < nrange; irange++, pr += 2 ) {
+      if( pr[ 2 ] < pr[ 0 ] ) break;
+   }
+   if( irange < nrange ) {
+      qsort( ranges, nrange, 2*sizeof(*ranges), Comp_range );
+   }
+
+/* Merge contiguous or overlapping ranges. */
+   nnew = 1;
+   for( irange = 1; irange < nrange; irange++ ) {
+      PutRange( ranges, &nnew, ranges[ 2*irange ], ranges[ 2*irange + 1 ] );
+   }
+   return nnew;
+}
+
 static void Sink1( void *data, size_t nc, const char *buf, int *status ){
 /*
 *  Name:
@@ -10881,6 +11220,13 @@ void astGetMocData_( AstMoc *this, size_t mxsize, void *array, int *status ) {
    (**astMEMBER(this,Moc,GetMocData))( this, mxsize, array, status );
 }
 
+void astGetMocRanges_( AstMoc *this, int mxrange, int *nrange,
+                       int64_t *ranges, int *status ) {
+   if ( !astOK ) return;
+   (**astMEMBER(this,Moc,GetMocRanges))( this, mxrange, nrange, ranges,
+                                         status );
+}
+
 void astGetMocString_( AstMoc *this, int json, size_t mxsize, char *string,
                        size_t *size, int *status ){
    if ( !astOK ) return;
@@ -10905,6 +11251,13 @@ void astAddMocData_( AstMoc *this, int cmode, int negate, int maxorder,
                                        nbyte, data, status );
 }
 
+void astAddMocRanges_( AstMoc *this, int cmode, int negate, int order,
+                       int nrange, const int64_t *ranges, int *status ) {
+   if ( !astOK ) return;
+   (**astMEMBER(this,Moc,AddMocRanges))( this, cmode, negate, order, nrange,
+                                         ranges, status );
+}
+
 void astAddMocString_( AstMoc *this, int cmode, int negate, int maxorder,
                      size_t len, const char *string, int *json, int *status ) {
    if ( !astOK ) return;
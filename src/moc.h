@@ -149,6 +149,8 @@ typedef struct AstMocVtab {
    void (* AddCell)( AstMoc *, int, int, int64_t, int * );
    void (* AddMocData)( AstMoc *, int, int, int, int, int, const void *, int * );
    void (* GetMocData)( AstMoc *, size_t, void *, int * );
+   void (* AddMocRanges)( AstMoc *, int, int, int, int, const int64_t *, int * );
+   void (* GetMocRanges)( AstMoc *, int, int *, int64_t *, int * );
    void (* AddMocString)( AstMoc *, int, int, int, size_t, const char *, int *, int * );
    void (* GetMocString)( AstMoc *, int, size_t, char *, size_t *, int * );
 
@@ -263,6 +265,8 @@ void astGetCell_( AstMoc *, int, int *, int64_t *, int * );
 void astAddCell_( AstMoc *, int, int, int64_t, int * );
 void astAddMocData_( AstMoc *, int, int, int, int, int, const void *, int * );
 void astGetMocData_( AstMoc *, size_t, void *, int * );
+void astAddMocRanges_( AstMoc *, int, int, int, int, const int64_t *, int * );
+void astGetMocRanges_( AstMoc *, int, int *, int64_t *, int * );
 void astAddMocString_( AstMoc *, int, int, int, size_t, const char *, int *, int * );
 void astGetMocString_( AstMoc *, int, size_t, char *, size_t *, int * );
 int astTestCell_( AstMoc *, int, int64_t, int, int * );
@@ -339,6 +343,8 @@ astINVOKE(O,astLoadMoc_(mem,size,vtab,name,astCheckChannel(channel),STATUS_PTR))
 astINVOKE(V,astAddRegion_(astCheckMoc(this),cmode,astCheckRegion(region),STATUS_PTR))
 #define astAddMocData(this,cmode,negate,maxorder,len,nbyte,data) \
 astINVOKE(V,astAddMocData_(astCheckMoc(this),cmode,negate,maxorder,len,nbyte,data,STATUS_PTR))
+#define astAddMocRanges(this,cmode,negate,order,nrange,ranges) \
+astINVOKE(V,astAddMocRanges_(astCheckMoc(this),cmode,negate,order,nrange,ranges,STATUS_PTR))
 #define astAddMocString(this,cmode,negate,maxorder,len,string,json) \
 astINVOKE(V,astAddMocString_(astCheckMoc(this),cmode,negate,maxorder,len,string,json,STATUS_PTR))
 #define astGetMocString(this,json,mxsize,string,size) \
@@ -403,6 +409,8 @@ astINVOKE(V,astAddPixelMask8US_(astCheckMoc(this),cmode,astCheckFrameSet(wcs),va
 
 #define astGetMocData(this,mxsize,data) \
 astINVOKE(V,astGetMocData_(astCheckMoc(this),mxsize,data,STATUS_PTR))
+#define astGetMocRanges(this,mxrange,nrange,ranges) \
+astINVOKE(V,astGetMocRanges_(astCheckMoc(this),mxrange,nrange,ranges,STATUS_PTR))
 #define astGetMocHeader(this) \
 astINVOKE(O,astGetMocHeader_(astCheckMoc(this),STATUS_PTR))
 
@@ -768,11 +768,14 @@ static void Sink1( void *data, size_t nc, const char *buf, int *status ){
 
 /* "buf" is not null terminated, so we need to create a null terminated
    copy. */
-   line = astStore( NULL, buf, nc + 1 );
-   line[ nc ] = 0;
+   line = astMalloc( nc + 1 );
+   if( astOK ) {
+      memcpy( line, buf, nc );
+      line[ nc ] = 0;
 
 /* Write this null-terminated line ut through the sink function. */
-   astPutNextText( this, line );
+      astPutNextText( this, line );
+   }
 
 /* Free the memory. */
    line = astFree( line );
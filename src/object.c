@@ -335,6 +335,26 @@ static AstObject *zero_ptr;
    caching is switched off via the astTune function. */
 static int object_caching = 0;
 
+/* The maximum number of deleted Objects to retain on the free list of
+   each class that has been flagged as "pooled" (using astSetVtabPooled).
+   These are classes for which large numbers of short-lived Objects are
+   typically created and deleted (e.g. PointSets), and for which it is
+   worth re-using memory even if object caching is switched off. This is
+   zero by default in MEM_DEBUG builds, so that retained Objects are not
+   reported as memory leaks. */
+#ifdef MEM_DEBUG
+static int object_pool = 0;
+#else
+static int object_pool = 100;
+#endif
+
+/* The maximum number of FrameSets to retain in the cache of FrameSets
+   read from FITS headers. The cache itself is managed by the FitsChan
+   class, which registers a function (using astTuneHook) that is invoked
+   whenever a new value is stored. */
+static int fits_cache = 0;
+static void (* fits_cache_hook)( int, int * ) = NULL;
+
 /* Set up global data access, mutexes, etc, needed for thread safety. */
 #ifdef THREAD_SAFE
 
@@ -467,6 +487,7 @@ static void ClearIdent( AstObject *, int * );
 static void ClearID( AstObject *, int * );
 static void Dump( AstObject *, AstChannel *, int * );
 static void EmptyObjectCache( int * );
+static int UsePool( AstObjectVtab *, int * );
 static void ToStringSink( const char * );
 static void SetAttrib( AstObject *, const char *, int * );
 static void SetID( AstObject *, const char *, int * );
@@ -1383,7 +1404,7 @@ f     function is invoked with STATUS set to an error value, or if it
    object, to store the output Object. */
 
    vtab = this->vtab;
-   if( object_caching ){
+   if( object_caching || UsePool( vtab, status ) ){
 
       if( vtab->nfree > 0 ) {
          new = vtab->free_list[ --(vtab->nfree) ];
@@ -1461,8 +1482,14 @@ f     function is invoked with STATUS set to an error value, or if it
       }
    }
 
-/* If OK, increment the count of active objects. */
-   if ( astOK ) vtab->nobject++;
+/* If OK, increment the count of active objects, and update the other
+   memory usage statistics for the class (see astMemoryUsage). */
+   if ( astOK ) {
+      vtab->nobject++;
+      vtab->nbyte += new->size;
+      if( vtab->nobject > vtab->mxobject ) vtab->mxobject = vtab->nobject;
+      if( vtab->nbyte > vtab->mxbyte ) vtab->mxbyte = vtab->nbyte;
+   }
 
 /* Return a pointer to the new Object. */
    return new;
@@ -1576,11 +1603,14 @@ f     value
 /* If necessary, free the Object's memory. If object caching is switched
    on, the memory is not in fact freed; it is merely placed onto the end
    of the list of free memory blocks included in the virtual function table
-   of the AST class concerned. astGrow returns immediately if an error
+   of the AST class concerned. The same is done for classes that re-use
+   memory by default (see astSetVtabPooled), so long as the free list is
+   not already full. astGrow returns immediately if an error
    has already occurred, so we need to reset the error status explicitly
    before calling astGrow. */
    if ( dynamic ) {
-      if( object_caching ) {
+      if( object_caching ||
+          ( UsePool( vtab, status ) && vtab->nfree < object_pool ) ) {
          ifree = (vtab->nfree)++;
 
          status_value = astStatus;
@@ -1595,8 +1625,9 @@ f     value
       }
    }
 
-/* Decrement the count of active Objects. */
+/* Decrement the count and total size of active Objects. */
    vtab->nobject--;
+   if( vtab->nbyte >= size ) vtab->nbyte -= size;
 
 /* Always return NULL. */
    return NULL;
@@ -4237,11 +4268,50 @@ f        AST_DELETE).
 *        blocks currently in the pool to be freed. Note, this tuning parameter
 *        only controls the caching of memory used to store AST Objects. To
 *        cache other memory blocks allocated by AST, use MemoryCaching.
+*     ObjectPool
+*        The maximum number of deleted Objects to retain for re-use, for
+*        each of the classes that are most frequently used to hold
+*        short-lived Objects (currently PointSet, UnitMap and CmpMap).
+*        These Objects are retained even if ObjectCaching is zero, and
+*        are used by the next constructor for the same class, avoiding
+*        the need to allocate memory for the new Object. Identifiers
+*        issued for the new Object are not affected. The default value
+*        is 100. Setting a new value causes the memory used by any
+*        currently retained Objects to be freed (unless ObjectCaching is
+*        non-zero).
 *     MemoryCaching
 *        A boolean flag similar to ObjectCaching except
 *        that it controls caching of all memory blocks of less than 300 bytes
 *        allocated by AST (whether for internal or external use), not just
 *        memory used to store AST Objects.
+*     MemoryPool
+*        The maximum total size, in kilobytes, of the freed memory blocks
+*        larger than 300 bytes (i.e. too large to be cached using
+*        MemoryCaching) that should be retained for re-use. A retained
+*        block is re-used the next time AST needs a block of exactly the
+*        same size, which avoids repeated calls to the system malloc and
+*        free functions for the large work arrays used when (for
+*        instance) transforming many sets of points using a Mapping. The
+*        retained blocks are shared by all threads. The default value is
+*        zero, meaning that no blocks are retained. Reducing the value
+*        causes blocks to be freed until the limit is met.
+*     FitsCache
+*        The maximum number of FrameSets to retain in a cache of
+*        FrameSets read from FITS headers. If this is non-zero, a copy
+*        of each FrameSet read from a FitsChan using any encoding other
+*        than NATIVE is retained, together with a description of the
+*        WCS-related keyword values and FitsChan attributes from which
+*        it was created. A later read that uses the same keyword and
+*        attribute values then returns a copy of the cached FrameSet,
+*        rather than creating a new FrameSet. This can save a lot of
+*        time when reading many headers that share the same WCS. The
+*        cache is shared by all threads. Reducing the value causes the
+*        least recently used FrameSets to be deleted until the limit is
+*        met. The default value is zero, meaning that no FrameSets are
+*        cached.
+*        Statistics describing the use of the cache may be obtained
+c        using astFitsCacheStats.
+f        using AST_FITSCACHESTATS.
 
 *  Notes:
 c     - This function attempts to execute even if the AST error
@@ -4268,9 +4338,25 @@ f     error value
             if( !object_caching ) EmptyObjectCache( status );
          }
 
+      } else if( astChrMatch( name, "ObjectPool" ) ) {
+         result = object_pool;
+         if( value != AST__TUNULL ) {
+            object_pool = ( value > 0 ) ? value : 0;
+            if( !object_caching ) EmptyObjectCache( status );
+         }
+
       } else if( astChrMatch( name, "MemoryCaching" ) ) {
          result = astMemCaching( value );
 
+      } else if( astChrMatch( name, "MemoryPool" ) ) {
+         result = astMemPool( value );
+      } else if( astChrMatch( name, "FitsCache" ) ) {
+         result = fits_cache;
+         if( value != AST__TUNULL ) {
+            fits_cache = ( value > 0 ) ? value : 0;
+            if( fits_cache_hook ) ( *fits_cache_hook )( fits_cache, status );
+         }
+
       } else if( astOK ) {
          astError( AST__TUNAM, "astTune: Unknown AST tuning parameter "
                    "specified \"%s\".", status, name );
@@ -4453,6 +4539,72 @@ f     error value
    }
 }
 
+void astTuneHook_( const char *name, void (* hook)( int, int * ),
+                   int *status ) {
+/*
+*+
+*  Name:
+*     astTuneHook
+
+*  Purpose:
+*     Register a function to be invoked when a tuning parameter changes.
+
+*  Type:
+*     Protected function.
+
+*  Synopsis:
+*     #include "object.h"
+*     void astTuneHook( const char *name, void (* hook)( int, int * ) )
+
+*  Class Membership:
+*     Object function.
+
+*  Description:
+*     This function registers a function that is invoked whenever a new
+*     value is stored for an integer-valued tuning parameter (see
+*     astTune). It allows a tuning parameter that controls resources
+*     owned by another class to be handled by that class, without this
+*     class needing to know about it. The function is also invoked
+*     immediately with the current value of the tuning parameter, so
+*     that any value stored before the function was registered is not
+*     lost.
+*
+*     Currently, only the "FitsCache" tuning parameter (used by the
+*     FitsChan class) supports this.
+
+*  Parameters:
+*     name
+*        The name of the tuning parameter (case-insensitive).
+*     hook
+*        Pointer to the function to invoke, or NULL to cancel any
+*        previously registered function. It is invoked with the new
+*        value of the tuning parameter and a pointer to the inherited
+*        status variable. It is invoked while the tuning parameters are
+*        locked, and so should not itself invoke astTune.
+
+*  Notes:
+*     - This function attempts to execute even if the AST error status
+*     is set on entry.
+*-
+*/
+
+   if( name ) {
+
+      LOCK_MUTEX1;
+
+      if( astChrMatch( name, "FitsCache" ) ) {
+         fits_cache_hook = hook;
+         if( hook ) ( *hook )( fits_cache, status );
+
+      } else if( astOK ) {
+         astError( AST__TUNAM, "astTuneHook: Unknown AST tuning parameter "
+                   "specified \"%s\".", status, name );
+      }
+
+      UNLOCK_MUTEX1;
+   }
+}
+
 AstObject *astFromString_( const char *string, int *status ) {
 /*
 c++
@@ -4589,6 +4741,62 @@ static const char *FromStringSource( void ){
    return data->buff;
 }
 
+static int UsePool( AstObjectVtab *vtab, int *status ) {
+/*
+*  Name:
+*     UsePool
+
+*  Purpose:
+*     Determine if deleted Objects of a class should be retained for re-use.
+
+*  Type:
+*     Private function.
+
+*  Synopsis:
+*     #include "object.h"
+*     int UsePool( AstObjectVtab *vtab, int *status )
+
+*  Class Membership:
+*     Object member function.
+
+*  Description:
+*     This function returns a flag indicating if the free list in the
+*     supplied virtual function table should be used to store deleted
+*     Objects, and to supply memory for new Objects, when object caching
+*     is switched off. This is the case if the class has been flagged as
+*     "pooled" (see astSetVtabPooled), the ObjectPool tuning parameter is
+*     non-zero, and (in a multi-threaded context) the vtab is owned by the
+*     currently executing thread.
+
+*  Parameters:
+*     vtab
+*        Pointer to the virtual function table.
+*     status
+*        Pointer to the inherited status variable.
+
+*  Returned Value:
+*     Non-zero if the free list should be used.
+
+*  Notes:
+*     -  This function attempts to execute even if an error has occurred.
+*/
+
+/* Local Variables: */
+   astDECLARE_GLOBALS    /* Thread-specific global data */
+
+/* Check the class is pooled. */
+   if( !vtab->pooled || object_pool == 0 ) return 0;
+
+/* Check the vtab is owned by the current thread, since the free list
+   is not protected by a mutex. */
+#if defined(THREAD_SAFE)
+   astGET_GLOBALS(NULL);
+   if( vtab->thread != AST__THREAD_ID ) return 0;
+#endif
+
+   return 1;
+}
+
 static void VSet( AstObject *this, const char *settings, char **text,
                   va_list args, int *status ) {
 /*
@@ -5476,9 +5684,12 @@ void astInitObjectVtab_(  AstObjectVtab *vtab, const char *name, int *status ) {
 /* Store the pointer to the class name. */
    vtab->class = name;
 
-/* Initialise the count of active objects and the number of destructors,
-   copy constructors and dump functions. */
+/* Initialise the count and size of active objects and the number of
+   destructors, copy constructors and dump functions. */
    vtab->nobject = 0;
+   vtab->mxobject = 0;
+   vtab->nbyte = 0;
+   vtab->mxbyte = 0;
    vtab->ndelete = 0;
    vtab->ncopy = 0;
    vtab->ndump = 0;
@@ -5502,6 +5713,13 @@ void astInitObjectVtab_(  AstObjectVtab *vtab, const char *name, int *status ) {
    continuously allocating small blocks of memory using malloc. */
    vtab->nfree = 0;
    vtab->free_list = NULL;
+   vtab->pooled = 0;
+
+/* Record the thread that owns the vtab. Only this thread may use the
+   free list for a pooled class (see UsePool). */
+#if defined(THREAD_SAFE)
+   vtab->thread = AST__THREAD_ID;
+#endif
 
 /* Add the supplied virtual function table pointer to the end of the list
    of known vtabs. */
@@ -5603,7 +5821,7 @@ AstObject *astInitObject_( void *mem, size_t size, int init,
    for safety. If the list is originally empty, allocate memory for a new
    object using astMalloc. */
    if( !mem ) {
-      if( object_caching ) {
+      if( object_caching || UsePool( vtab, status ) ) {
          if( vtab->nfree > 0 ) {
             mem = vtab->free_list[ --(vtab->nfree) ];
             vtab->free_list[ vtab->nfree ] = NULL;
@@ -5674,6 +5892,12 @@ AstObject *astInitObject_( void *mem, size_t size, int init,
    the Object. */
          new->iref = vtab->nobject++;
 
+/* Update the other memory usage statistics for the class (see
+   astMemoryUsage). */
+         vtab->nbyte += size;
+         if( vtab->nobject > vtab->mxobject ) vtab->mxobject = vtab->nobject;
+         if( vtab->nbyte > vtab->mxbyte ) vtab->mxbyte = vtab->nbyte;
+
 /* Initialise the pointer to an external object that acts as a proxy for
    the AST Object within foreign language interfaces. */
          new->proxy = NULL;
@@ -8244,6 +8468,227 @@ AstObject *astMakePointer_NoLockCheck_( AstObject *this_id, int *status ) {
    return ptr;
 }
 
+AstKeyMap *astMemoryUsage_( int current, int *status ) {
+/*
+c++
+*  Name:
+*     astMemoryUsage
+
+*  Purpose:
+*     Return statistics describing the memory used by active Objects.
+
+*  Type:
+*     Public function.
+
+*  Synopsis:
+*     #include "object.h"
+*     AstKeyMap *astMemoryUsage( int current )
+
+*  Class Membership:
+*     Object method.
+
+*  Description:
+*     This function returns a KeyMap holding a snapshot of the memory used
+*     by currently active AST Objects. It is intended to help identify
+*     which Objects are responsible for excessive memory use within
+*     long-running applications. The returned KeyMap contains two entries,
+*     each of which is itself a KeyMap:
+*
+*     - "Classes": This KeyMap has an entry for each AST class for which
+*     at least one Object has been created. The key is the class name
+*     (e.g. "FrameSet", "ZoomMap", etc), and the value is a KeyMap holding
+*     the following integer entries: "Nobject" - the number of active
+*     Objects of the class; "MaxNobject" - the largest number of Objects
+*     of the class that have been active at any one time; "Bytes" - the
+*     total size of the structures holding the active Objects of the
+*     class; "MaxBytes" - the largest value that "Bytes" has taken. Note,
+*     the "Bytes" value does not include the memory allocated for other
+*     data owned by each Object (for instance, the coordinate values held
+*     in a PointSet). Objects of a class count only towards that class,
+*     not its parent classes.
+*
+*     - "Routines": This KeyMap has an entry for each function that has
+*     issued an active Object pointer. The key is the function name, as
+*     returned by astCreatedAt ("<unknown>" is used if no function name is
+*     available), and the value is a KeyMap holding the following integer
+*     entries: "Nobject" - the number of active Object pointers issued
+*     by the function; "Bytes" - the total memory used by the Objects
+*     identified by those pointers, including all data owned by each
+*     Object (such as component Mappings, coordinate values, etc).
+*
+*     The "Classes" values are maintained as each Object is created and
+*     deleted, at negligible cost. The "Routines" values are determined
+*     when this function is called, and so add no overhead to normal use
+*     of AST.
+
+*  Parameters:
+*     current
+*        A Boolean flag indicating if the "Routines" statistics should
+*        be restricted to pointers issued within the current AST object
+*        context (see astBegin and astEnd).
+
+*  Returned Value:
+*     astMemoryUsage()
+*        A pointer to a new KeyMap holding the statistics. The KeyMap
+*        pointer should be annulled when it is no longer needed. A NULL
+*        pointer is returned if an error has occurred prior to calling
+*        this function.
+*
+*        The "Bytes" and "MaxBytes" values are stored as 64 bit integers,
+*        and so should be accessed using the KeyMap "K" data type (e.g.
+*        using function astMapGet0K).
+
+*  Notes:
+*     - The "Routines" statistics include only pointers locked by the
+*     currently executing thread. The "Classes" statistics include only
+*     Objects created by the currently executing thread.
+*     - An Object that is identified by more than one active pointer
+*     (e.g. as a result of using astClone) is included once for each
+*     pointer in the "Routines" statistics.
+*     - The KeyMap returned by this function, and the KeyMaps it contains,
+*     are not included in the statistics.
+
+c--
+*/
+
+/* Local Variables: */
+   AstKeyMap *bytes;          /* Total Object size for each routine */
+   AstKeyMap *classes;        /* KeyMap holding class statistics */
+   AstKeyMap *counts;         /* Number of pointers for each routine */
+   AstKeyMap *km;             /* KeyMap holding statistics for one item */
+   AstKeyMap *result;         /* Returned KeyMap */
+   AstKeyMap *routines;       /* KeyMap holding routine statistics */
+   AstObjectVtab *vtab;       /* Pointer to class virtual function table */
+   Handle *handle;            /* Pointer to current Handle */
+   astDECLARE_GLOBALS         /* Thread-specific global data */
+   const char *key;           /* Routine name */
+   int i;                     /* Loop count */
+   int ihandle;               /* Offset of current Handle */
+   int n;                     /* Number of pointers */
+   int nclass;                /* Number of known classes */
+   int nobj;                  /* Number of pointers for a routine */
+   int64_t *stats;            /* Copy of class statistics */
+   int64_t nb;                /* Number of bytes */
+
+/* Check the global error status. */
+   if ( !astOK ) return NULL;
+
+/* Get a pointer to Thread-specific global data. */
+   astGET_GLOBALS(NULL);
+
+/* Take a copy of the statistics stored in the virtual function tables
+   created by the currently executing thread. This is done before creating
+   any KeyMaps so that they are not included in the statistics. */
+   nclass = nvtab;
+   stats = astMalloc( sizeof( *stats )*4*nclass );
+   if( astOK ) {
+      for( i = 0; i < nclass; i++ ) {
+         vtab = known_vtabs[ i ];
+         stats[ 4*i ] = vtab->nobject;
+         stats[ 4*i + 1 ] = vtab->mxobject;
+         stats[ 4*i + 2 ] = (int64_t) vtab->nbyte;
+         stats[ 4*i + 3 ] = (int64_t) vtab->mxbyte;
+      }
+   }
+
+/* Create an empty KeyMap to hold the results. */
+   result = astKeyMap( " ", status );
+
+/* Create a KeyMap holding the statistics for each class for which at
+   least one Object has been created. */
+   classes = astKeyMap( " ", status );
+   for( i = 0; i < nclass && astOK; i++ ) {
+      if( stats[ 4*i + 1 ] > 0 ) {
+         km = astKeyMap( " ", status );
+         astMapPut0I( km, "Nobject", (int) stats[ 4*i ], NULL );
+         astMapPut0I( km, "MaxNobject", (int) stats[ 4*i + 1 ], NULL );
+         astMapPut0K( km, "Bytes", stats[ 4*i + 2 ], NULL );
+         astMapPut0K( km, "MaxBytes", stats[ 4*i + 3 ], NULL );
+         astMapPut0A( classes, known_vtabs[ i ]->class, km, NULL );
+         km = astAnnul( km );
+      }
+   }
+   stats = astFree( stats );
+
+/* Create KeyMaps to hold the number of pointers issued by each routine,
+   and the total size of the associated Objects. */
+   counts = astKeyMap( " ", status );
+   bytes = astKeyMap( " ", status );
+
+/* Get exclusive access to the handles array. */
+   LOCK_MUTEX2;
+
+/* Get the index of the first Handle to check. If we are checking only the
+   current context level, then get this index from the appropriate element
+   of the active_handles array. Otherwise, we check the whole of the
+   handles array, starting at element zero. */
+   if( current && active_handles ) {
+      ihandle = active_handles[ context_level ];
+   } else {
+      ihandle = 0;
+   }
+
+/* Loop over the Handles array, starting from the above element. */
+   handle = handles + ihandle;
+   for( ; ihandle < nhandles && astOK; ihandle++,handle++ ) {
+
+/* Skip Handles that have no associated object. */
+      if( !handle->ptr ) continue;
+
+/* Skip handles that are in an unrequired context. */
+      if( current && handle->context != context_level ) continue;
+
+#if defined(THREAD_SAFE)
+/* Skip handles that are not locked for use by the current thread. */
+      if( handle->thread != AST__THREAD_ID ) continue;
+#endif
+
+/* Increment the number of pointers issued by the routine that issued
+   the handle, and the total size of the associated Objects. */
+      key = handle->routine ? handle->routine : "<unknown>";
+      if( !astMapGet0I( counts, key, &n ) ) n = 0;
+      astMapPut0I( counts, key, n + 1, NULL );
+      if( !astMapGet0K( bytes, key, &nb ) ) nb = 0;
+      astMapPut0K( bytes, key, nb + (int64_t) astGetObjSize( handle->ptr ),
+                   NULL );
+   }
+
+/* Relinquish access to the handles array. */
+   UNLOCK_MUTEX2;
+
+/* Create a KeyMap holding the statistics for each routine. */
+   routines = astKeyMap( " ", status );
+   n = astMapSize( counts );
+   for( i = 0; i < n && astOK; i++ ) {
+      key = astMapKey( counts, i );
+      km = astKeyMap( " ", status );
+      if( astMapGet0I( counts, key, &nobj ) ) {
+         astMapPut0I( km, "Nobject", nobj, NULL );
+      }
+      if( astMapGet0K( bytes, key, &nb ) ) {
+         astMapPut0K( km, "Bytes", nb, NULL );
+      }
+      astMapPut0A( routines, key, km, NULL );
+      km = astAnnul( km );
+   }
+
+/* Store the two KeyMaps in the returned KeyMap. */
+   astMapPut0A( result, "Classes", classes, NULL );
+   astMapPut0A( result, "Routines", routines, NULL );
+
+/* Free resources. */
+   classes = astAnnul( classes );
+   routines = astAnnul( routines );
+   counts = astAnnul( counts );
+   bytes = astAnnul( bytes );
+
+/* Annul the returned KeyMap if an error occurred. */
+   if( !astOK ) result = astAnnul( result );
+
+/* Return the KeyMap. */
+   return result;
+}
+
 int astP2I_( AstObject *pointer, int *status ) {
 /*
 *+
@@ -261,7 +261,7 @@ typedef struct WordContext {
    char *e;
    char f;
    int done;
-   char *words[ NEWORD ];
+   char words[ NEWORD ][ MXWORDLEN + 1 ];
    int next;
    int close;
    int open;
@@ -340,6 +340,7 @@ static char *SourceWrap( const char *(*)( void ), int * );
 static const char *GetNextWord( AstStcsChan *, WordContext *, int * );
 static const char *ReadSpaceArgs( AstStcsChan *, const char *, int, int, WordContext *, AstKeyMap *, int * );
 static double *BoxCorners( AstFrame *, const double[2], const double[2], int * );
+static double ReadDouble( const char *, int * );
 static int GetIndent( AstChannel *, int * );
 static int GetRegionProps( AstStcsChan *, AstRegion *, AstKeyMap *, int, int, double, int, int * );
 static int SpaceId( const char *, int * );
@@ -786,9 +787,9 @@ static char *ContextFragment( WordContext *con, char **buf, int *status ){
    moment, this is the index of the oldest word in the cyclic list. */
    j = con->next;
 
-/* Loop round all non-NULL words in the cyclic list. */
+/* Loop round all non-blank words in the cyclic list. */
    for( i = 0; i < NEWORD; i++ ) {
-      if( con->words[ j ] ) {
+      if( con->words[ j ][ 0 ] ) {
 
 /* Append this word to the buffer, extending the buffer size as
    necessary. */
@@ -851,19 +852,12 @@ static void FreeContext( WordContext *con, int *status ){
 
 */
 
-/* Local Variables: */
-   int i;                         /* Word index */
-
 /* Check the supplied pointer. */
    if ( !con ) return;
 
-/* Free the resources. */
+/* Free the resources. The words in the cyclic list are held in fixed
+   length buffers within the structure, and so do not need freeing. */
    con->line = astFree( con->line );
-
-   for( i = 0; i < NEWORD; i++ ) {
-      con->words[ i ] = astFree( con->words[ i ] );
-   }
-
 }
 
 static const char *GetAttrib( AstObject *this_object, const char *attrib, int *status ) {
@@ -1202,6 +1196,7 @@ static const char *GetNextWord( AstStcsChan *this, WordContext *con,
    const char *result;            /* Returned pointer. */
    int i;                         /* Word index */
    size_t len;                    /* Word length */
+   size_t nc;                     /* Number of characters to store */
 
 /* Initialise. */
    result = NULL;
@@ -1218,7 +1213,7 @@ static const char *GetNextWord( AstStcsChan *this, WordContext *con,
       con->wnext = NULL;
       con->close = 0;
       con->open = 0;
-      for( i = 0; i < NEWORD; i++ ) con->words[ i ] = NULL;
+      for( i = 0; i < NEWORD; i++ ) con->words[ i ][ 0 ] = 0;
 
 /* Words that end with an opening parenthesis are treated as two words. If the
    previous word ended in an opening parenthesis, it will have been removed by
@@ -1297,9 +1292,13 @@ static const char *GetNextWord( AstStcsChan *this, WordContext *con,
          }
 
 /* Add the word into the cyclic list of words used to form a document
-   fragment to include in error and warning messages. */
-         con->words[ con->next ] = astStore( con->words[ con->next ],
-                                             result, len + 1 );
+   fragment to include in error and warning messages. Each element of
+   the list is a fixed length buffer within the context structure, so no
+   memory needs to be allocated. Over-length words are truncated (an
+   error is reported for them below). */
+         nc = ( len > MXWORDLEN ) ? MXWORDLEN : len;
+         memcpy( con->words[ con->next ], result, nc );
+         con->words[ con->next ][ nc ] = 0;
          if( ++(con->next) == NEWORD ) con->next = 0;
 
 /* Deal with words that include an opening or closing parenthesis at
@@ -2497,8 +2496,6 @@ static AstObject *Read( AstChannel *this_channel, int *status ) {
    AstTimeFrame *tf1;        /* Temporary TimeFrame */
    AstTimeFrame *timefrm;    /* Pointer to TimeFrame for time sub-phrase */
    AstTimeScaleType ts;      /* TimeFrame TimeScale attribute value */
-   WordContext con;          /* Context for finding next source word */
-   char *fbuf;               /* Pointer to buffer holding document fragment */
    const char *new_ts;       /* Time scale string */
    double epoch;             /* Value to use for the Epoch attribue */
    double fill;              /* Filling factor */
@@ -2888,8 +2885,7 @@ static AstObject *Read( AstChannel *this_channel, int *status ) {
          } else if( astOK ) {
             astError( AST__BADIN, "astRead(StcsChan): Unsupported "
                       "units (%s) for a spherical co-ordinate system "
-                      "within an STC-S description: '%s'.", status,
-                      cval, ContextFragment( &con, &fbuf, status ) );
+                      "within an STC-S description.", status, cval );
          }
 
 /* Basic Frames can use any of the allowed units, so use a scale factor of
@@ -3428,6 +3424,148 @@ static AstObject *Read( AstChannel *this_channel, int *status ) {
    return new;
 }
 
+static double ReadDouble( const char *word, int *status ){
+/*
+*  Name:
+*     ReadDouble
+
+*  Purpose:
+*     Read a floating point value from a word of an STC-S description.
+
+*  Type:
+*     Private function.
+
+*  Synopsis:
+*     #include "stcschan.h"
+*     double ReadDouble( const char *word, int *status )
+
+*  Class Membership:
+*     StcsChan member function
+
+*  Description:
+*     This function returns the floating point value represented by the
+*     supplied word. It gives the same result as astChr2Double, but
+*     handles the plain decimal values found in most STC-S descriptions
+*     (e.g. "-12.3456" or "1.5E-3") without calling sscanf.
+*
+*     A plain value is converted directly only if its significant digits
+*     form an integer no larger than 2**53 and the power of ten to apply
+*     is no larger than 10**22. Both numbers are then exactly
+*     representable as doubles, so a single multiplication or division
+*     gives the correctly rounded result. Any other word is passed on to
+*     astChr2Double.
+
+*  Parameters:
+*     word
+*        The null-terminated word to read.
+*     status
+*        Pointer to the inherited status variable.
+
+*  Returned Value:
+*     The floating point value, or AST__BAD if the word is not a
+*     numerical value.
+
+*/
+
+/* Local Constants: */
+#define MXMANT 9007199254740992ULL  /* 2**53 */
+
+/* Local Variables: */
+   static const double pow10[ 23 ] = { 1.0E0, 1.0E1, 1.0E2, 1.0E3, 1.0E4,
+                                       1.0E5, 1.0E6, 1.0E7, 1.0E8, 1.0E9,
+                                       1.0E10, 1.0E11, 1.0E12, 1.0E13,
+                                       1.0E14, 1.0E15, 1.0E16, 1.0E17,
+                                       1.0E18, 1.0E19, 1.0E20, 1.0E21,
+                                       1.0E22 };
+   const char *c;             /* Pointer to next character */
+   double result;             /* Returned value */
+   int expo;                  /* Explicit exponent value */
+   int ndig;                  /* Number of mantissa digits found */
+   int neg;                   /* Is the value negative? */
+   int nsig;                  /* Number of significant mantissa digits */
+   int p10;                   /* Power of ten to apply to the mantissa */
+   int sexp;                  /* Sign of explicit exponent */
+   unsigned long long mant;   /* Significant mantissa digits */
+
+/* Check inherited status and supplied pointer. */
+   if( !astOK || !word ) return AST__BAD;
+
+/* Initialise */
+   c = word;
+   mant = 0;
+   ndig = 0;
+   nsig = 0;
+   p10 = 0;
+
+/* Optional sign. */
+   neg = ( *c == '-' );
+   if( *c == '-' || *c == '+' ) c++;
+
+/* Digits before any decimal point. Leading zeros are not significant. */
+   while( isdigit( (unsigned char) *c ) ) {
+      if( mant || *c != '0' ) {
+         if( ++nsig <= 19 ) mant = 10*mant + ( *c - '0' );
+      }
+      ndig++;
+      c++;
+   }
+
+/* Digits after any decimal point. Each one reduces the power of ten. */
+   if( *c == '.' ) {
+      c++;
+      while( isdigit( (unsigned char) *c ) ) {
+         if( mant || *c != '0' ) {
+            if( ++nsig <= 19 ) mant = 10*mant + ( *c - '0' );
+         }
+         p10--;
+         ndig++;
+         c++;
+      }
+   }
+
+/* Optional exponent, which must include at least one digit. Limit the
+   exponent to avoid overflow - such values are handled by astChr2Double
+   anyway. */
+   if( ndig && ( *c == 'e' || *c == 'E' ) ) {
+      c++;
+      sexp = ( *c == '-' ) ? -1 : 1;
+      if( *c == '-' || *c == '+' ) c++;
+      if( isdigit( (unsigned char) *c ) ) {
+         expo = 0;
+         while( isdigit( (unsigned char) *c ) ) {
+            if( expo < 1000 ) expo = 10*expo + ( *c - '0' );
+            c++;
+         }
+         p10 += sexp*expo;
+      } else {
+         ndig = 0;
+      }
+   }
+
+/* Use the direct conversion if the whole word has been used and the
+   result can be formed exactly. */
+   if( ndig && !*c && nsig <= 19 && mant <= MXMANT &&
+       ( mant == 0 || ( p10 >= -22 && p10 <= 22 ) ) ) {
+      result = (double) mant;
+      if( mant && p10 > 0 ) {
+         result *= pow10[ p10 ];
+      } else if( mant && p10 < 0 ) {
+         result /= pow10[ -p10 ];
+      }
+      if( neg ) result = -result;
+
+/* Otherwise, use the general purpose function. */
+   } else {
+      result = astChr2Double( word );
+   }
+
+/* Return the result. */
+   return result;
+
+/* Undefine Local Constants: */
+#undef MXMANT
+}
+
 static AstKeyMap *ReadProps( AstStcsChan *this, int *status ) {
 /*
 *  Name:
@@ -3791,7 +3929,7 @@ static AstKeyMap *ReadProps( AstStcsChan *this, int *status ) {
    word in a new context and so do not need a new word. */
          if( astChrMatch( word, "fillfactor" ) ) {
             word = GetNextWord( this, &con, status );
-            if( astChr2Double( word ) == AST__BAD ) {
+            if( ReadDouble( word, status ) == AST__BAD ) {
                astError( AST__BADIN, "astRead(StcsChan): Expected a numerical "
                          "filling factor, but found '%s' in the %s "
                          "sub-phrase of STC-S description: '%s'.", status,
@@ -3988,7 +4126,7 @@ static AstKeyMap *ReadProps( AstStcsChan *this, int *status ) {
          is_jd = astChrMatch( word, "JD" );
          if( is_jd || astChrMatch( word, "MJD" ) ) {
             word = GetNextWord( this, &con, status );
-            value = astChr2Double( word );
+            value = ReadDouble( word, status );
             if( value == AST__BAD && astOK ) {
                astError( AST__BADIN, "astRead(StcsChan): Expected numerical "
                          "value in Start time, but found '%s %s' in STC-S "
@@ -4044,7 +4182,7 @@ static AstKeyMap *ReadProps( AstStcsChan *this, int *status ) {
          is_jd = astChrMatch( word, "JD" );
          if( is_jd || astChrMatch( word, "MJD" ) ) {
             word = GetNextWord( this, &con, status );
-            value = astChr2Double( word );
+            value = ReadDouble( word, status );
             if( value == AST__BAD && astOK ) {
                astError( AST__BADIN, "astRead(StcsChan): Expected numerical "
                          "value in Stop time, but found '%s %s' in STC-S "
@@ -4106,7 +4244,7 @@ static AstKeyMap *ReadProps( AstStcsChan *this, int *status ) {
          is_jd = astChrMatch( word, "JD" );
          if( is_jd || astChrMatch( word, "MJD" ) ) {
             word = GetNextWord( this, &con, status );
-            value = astChr2Double( word );
+            value = ReadDouble( word, status );
             if( value == AST__BAD && astOK ) {
                astError( AST__BADIN, "astRead(StcsChan): Expected numerical "
                          "value in Time value, but found '%s %s' in STC-S "
@@ -4216,7 +4354,7 @@ static AstKeyMap *ReadProps( AstStcsChan *this, int *status ) {
          }
 
 /* The current word should be a numerical value (the low limit ). */
-         if( astChr2Double( word ) == AST__BAD && astOK ) {
+         if( ReadDouble( word, status ) == AST__BAD && astOK ) {
             astError( AST__BADIN, "astRead(StcsChan): Expected a numerical "
                       "value for a %s lolimit, but found '%s' in an STC-S "
                       "description: '%s'.", status, t, word,
@@ -4227,7 +4365,7 @@ static AstKeyMap *ReadProps( AstStcsChan *this, int *status ) {
 
 /* The next word should be a numerical value (the high limit ). */
          word = GetNextWord( this, &con, status );
-         if( astChr2Double( word ) == AST__BAD && astOK ) {
+         if( ReadDouble( word, status ) == AST__BAD && astOK ) {
             astError( AST__BADIN, "astRead(StcsChan): Expected a numerical "
                       "value for a %s hilimit, but found '%s' in an STC-S "
                       "description: '%s'.", status, t, word,
@@ -4260,7 +4398,7 @@ static AstKeyMap *ReadProps( AstStcsChan *this, int *status ) {
 /* ------------------------------------------------------------------ */
 
          t = ( specid != NULL_ID ) ? "spectral" : "redshift";
-         if( astChr2Double( word ) == AST__BAD && astOK ) {
+         if( ReadDouble( word, status ) == AST__BAD && astOK ) {
             astError( AST__BADIN, "astRead(StcsChan): Expected a numerical "
                       "%s value, but found '%s' in an STC-S "
                       "description: '%s'.", status, t, word,
@@ -4287,7 +4425,7 @@ static AstKeyMap *ReadProps( AstStcsChan *this, int *status ) {
 /* Get a value for every space axis. */
             nc = 0;
             for( iaxis = 0; iaxis < naxes; iaxis++ ) {
-               val[ iaxis ] = astChr2Double( word );
+               val[ iaxis ] = ReadDouble( word, status );
                if( val[ iaxis ] == AST__BAD && astOK ) {
                   astError( AST__BADIN, "astRead(StcsChan): Expected another "
                             "axis value for a space Position, but found "
@@ -4341,7 +4479,7 @@ static AstKeyMap *ReadProps( AstStcsChan *this, int *status ) {
 
          if( astChrMatch( word, "Velocity" ) ) {
             word = GetNextWord( this, &con, status );
-            if( astChr2Double( word ) == AST__BAD && astOK ) {
+            if( ReadDouble( word, status ) == AST__BAD && astOK ) {
                astError( AST__BADIN, "astRead(StcsChan): Expected a "
                          "numerical Velocity value but found 'Velocity %s' "
                          "in an STC-S description: '%s'.", status, word,
@@ -4464,7 +4602,7 @@ static AstKeyMap *ReadProps( AstStcsChan *this, int *status ) {
    non-numerical value is encountered. */
          if( astChrMatch( word, "Error" ) ) {
             word = GetNextWord( this, &con, status );
-            value = astChr2Double( word );
+            value = ReadDouble( word, status );
 
             nc = 0;
             nval = 0;
@@ -4474,7 +4612,7 @@ static AstKeyMap *ReadProps( AstStcsChan *this, int *status ) {
                   prop = astAppendString( prop, &nc, word );
                   prop = astAppendString( prop, &nc, " " );
                   word = GetNextWord( this, &con, status );
-                  value = astChr2Double( word );
+                  value = ReadDouble( word, status );
                } else {
                   astError( AST__BADIN, "astRead(StcsChan): Too many (more "
                             "than %d) numerical values found for the Error "
@@ -4520,7 +4658,7 @@ static AstKeyMap *ReadProps( AstStcsChan *this, int *status ) {
    first non-numerical value is encountered. */
          if( astChrMatch( word, "Resolution" ) ) {
             word = GetNextWord( this, &con, status );
-            value = astChr2Double( word );
+            value = ReadDouble( word, status );
 
             nc = 0;
             nval = 0;
@@ -4530,7 +4668,7 @@ static AstKeyMap *ReadProps( AstStcsChan *this, int *status ) {
                   prop = astAppendString( prop, &nc, word );
                   prop = astAppendString( prop, &nc, " " );
                   word = GetNextWord( this, &con, status );
-                  value = astChr2Double( word );
+                  value = ReadDouble( word, status );
                } else {
                   astError( AST__BADIN, "astRead(StcsChan): Too many (more "
                             "than %d) numerical values found for the Resolution "
@@ -4576,7 +4714,7 @@ static AstKeyMap *ReadProps( AstStcsChan *this, int *status ) {
    first non-numerical value is encountered. */
          if( astChrMatch( word, "Size" ) ) {
             word = GetNextWord( this, &con, status );
-            value = astChr2Double( word );
+            value = ReadDouble( word, status );
 
             nc = 0;
             nval = 0;
@@ -4586,7 +4724,7 @@ static AstKeyMap *ReadProps( AstStcsChan *this, int *status ) {
                   prop = astAppendString( prop, &nc, word );
                   prop = astAppendString( prop, &nc, " " );
                   word = GetNextWord( this, &con, status );
-                  value = astChr2Double( word );
+                  value = ReadDouble( word, status );
                } else {
                   astError( AST__BADIN, "astRead(StcsChan): Too many (more "
                             "than %d) numerical values found for the Size "
@@ -4632,7 +4770,7 @@ static AstKeyMap *ReadProps( AstStcsChan *this, int *status ) {
    first non-numerical value is encountered. */
          if( astChrMatch( word, "PixSize" ) ) {
             word = GetNextWord( this, &con, status );
-            value = astChr2Double( word );
+            value = ReadDouble( word, status );
 
             nc = 0;
             nval = 0;
@@ -4642,7 +4780,7 @@ static AstKeyMap *ReadProps( AstStcsChan *this, int *status ) {
                   prop = astAppendString( prop, &nc, word );
                   prop = astAppendString( prop, &nc, " " );
                   word = GetNextWord( this, &con, status );
-                  value = astChr2Double( word );
+                  value = ReadDouble( word, status );
                } else {
                   astError( AST__BADIN, "astRead(StcsChan): Too many (more "
                             "than %d) numerical values found for the PixSize "
@@ -4796,6 +4934,7 @@ static const char *ReadSpaceArgs( AstStcsChan *this, const char *word,
    double val;             /* Single numerical value */
    double vals[ 6 ];       /* List of numerical values */
    int iaxis;              /* Axis index */
+   int keeptext;           /* Store textual form of polygon vertices? */
    int nc;                 /* Used length of string */
    int new_spaceid;        /* Type of next argument region */
    int nreg;               /* Number of argument regions found */
@@ -4815,7 +4954,7 @@ static const char *ReadSpaceArgs( AstStcsChan *this, const char *word,
 
 /* Get a lolimit value for every space axis. */
       for( iaxis = 0; iaxis < naxes; iaxis++ ) {
-         vals[ iaxis ] = astChr2Double( word );
+         vals[ iaxis ] = ReadDouble( word, status );
          if( vals[ iaxis ] == AST__BAD && astOK ) {
             astError( AST__BADIN, "astRead(StcsChan): Expected another "
                    "'lolimit' value for a PositionInterval, but found "
@@ -4837,7 +4976,7 @@ static const char *ReadSpaceArgs( AstStcsChan *this, const char *word,
 /* Get a hilimit value for every space axis. */
       nc = 0;
       for( iaxis = 0; iaxis < naxes; iaxis++ ) {
-         vals[ iaxis ] = astChr2Double( word );
+         vals[ iaxis ] = ReadDouble( word, status );
          if( vals[ iaxis ] == AST__BAD && astOK ) {
             astError( AST__BADIN, "astRead(StcsChan): Expected another "
                    "'hilimit' value for a PositionInterval, but found "
@@ -4853,7 +4992,7 @@ static const char *ReadSpaceArgs( AstStcsChan *this, const char *word,
       if( prop && nc > 0 ) {
          prop[ nc - 1 ] = 0;
          astMapPut0C( props, "HILIMIT", prop, NULL );
-         astMapPut1D( props, "DLOLIMIT", naxes, vals, NULL );
+         astMapPut1D( props, "DHILIMIT", naxes, vals, NULL );
       }
 
 /* If we are currently looking for information needed to create a spatial
@@ -4869,7 +5008,7 @@ static const char *ReadSpaceArgs( AstStcsChan *this, const char *word,
 /* Get a centre value for every space axis. */
       nc = 0;
       for( iaxis = 0; iaxis < naxes; iaxis++ ) {
-         vals[ iaxis ] = astChr2Double( word );
+         vals[ iaxis ] = ReadDouble( word, status );
          if( vals[ iaxis ] == AST__BAD && astOK ) {
             astError( AST__BADIN, "astRead(StcsChan): Expected another "
                    "'centre' value for a Circle, but found "
@@ -4889,7 +5028,7 @@ static const char *ReadSpaceArgs( AstStcsChan *this, const char *word,
       }
 
 /* Get the radius value. */
-      val = astChr2Double( word );
+      val = ReadDouble( word, status );
       if( val == AST__BAD && astOK ) {
          astError( AST__BADIN, "astRead(StcsChan): Expected a radius "
                    "value for a Circle, but found '%s' in an STC-S "
@@ -4912,7 +5051,7 @@ static const char *ReadSpaceArgs( AstStcsChan *this, const char *word,
 /* Get a centre value for every space axis. */
       nc = 0;
       for( iaxis = 0; iaxis < naxes; iaxis++ ) {
-         vals[ iaxis ] = astChr2Double( word );
+         vals[ iaxis ] = ReadDouble( word, status );
          if( vals[ iaxis ] == AST__BAD && astOK ) {
             astError( AST__BADIN, "astRead(StcsChan): Expected another "
                    "centre value for an Ellipse, but found "
@@ -4932,7 +5071,7 @@ static const char *ReadSpaceArgs( AstStcsChan *this, const char *word,
       }
 
 /* Get the first radius value . */
-      val = astChr2Double( word );
+      val = ReadDouble( word, status );
       if( val == AST__BAD && astOK ) {
          astError( AST__BADIN, "astRead(StcsChan): Expected the first "
                    "radius value for an Ellipse, but found "
@@ -4945,7 +5084,7 @@ static const char *ReadSpaceArgs( AstStcsChan *this, const char *word,
 
 /* Get the second radius value . */
       word = GetNextWord( this, con, status );
-      val = astChr2Double( word );
+      val = ReadDouble( word, status );
       if( val == AST__BAD && astOK ) {
          astError( AST__BADIN, "astRead(StcsChan): Expected the second "
                    "radius value for an Ellipse, but found "
@@ -4958,7 +5097,7 @@ static const char *ReadSpaceArgs( AstStcsChan *this, const char *word,
 
 /* Get the position angle value. */
       word = GetNextWord( this, con, status );
-      val = astChr2Double( word );
+      val = ReadDouble( word, status );
       if( val == AST__BAD && astOK ) {
          astError( AST__BADIN, "astRead(StcsChan): Expected the position "
                    "angle value for an Ellipse, but found "
@@ -4981,7 +5120,7 @@ static const char *ReadSpaceArgs( AstStcsChan *this, const char *word,
 /* Get a centre value for every space axis. */
       nc = 0;
       for( iaxis = 0; iaxis < naxes; iaxis++ ) {
-         vals[ iaxis ] = astChr2Double( word );
+         vals[ iaxis ] = ReadDouble( word, status );
          if( vals[ iaxis ] == AST__BAD && astOK ) {
             astError( AST__BADIN, "astRead(StcsChan): Expected another "
                       "centre value for a Box, but found "
@@ -5003,7 +5142,7 @@ static const char *ReadSpaceArgs( AstStcsChan *this, const char *word,
 /* Get bsize value for every space axis. */
       nc = 0;
       for( iaxis = 0; iaxis < naxes; iaxis++ ) {
-         vals[ iaxis ] = astChr2Double( word );
+         vals[ iaxis ] = ReadDouble( word, status );
          if( vals[ iaxis ] == AST__BAD && astOK ) {
             astError( AST__BADIN, "astRead(StcsChan): Expected another "
                       "'bsize' value for a Box, but found "
@@ -5027,13 +5166,20 @@ static const char *ReadSpaceArgs( AstStcsChan *this, const char *word,
    Polygon ... */
    } else if( spaceid == POLYGON_ID ) {
 
+/* Polygons from archive footprints may have very many vertices. The
+   textual form of the vertex list is only needed if the properties are
+   to be returned to the caller (see attribute StcsProps), so only form it
+   if required. The numerical values are read into a single array which
+   is stored in the KeyMap when complete. */
+      keeptext = astGetStcsProps( this );
+
 /* Read the first vertex into a dynamically allocated array. */
       temp = astMalloc( sizeof( *temp )*naxes );
       if( temp ) {
          nc = 0;
          p = temp;
          for( iaxis = 0; iaxis < naxes; iaxis++,p++ ) {
-            val = astChr2Double( word );
+            val = ReadDouble( word, status );
             if( val == AST__BAD && astOK ) {
                astError( AST__BADIN, "astRead(StcsChan): Expected another "
                       "vertex value for a Polygon, but found "
@@ -5042,14 +5188,16 @@ static const char *ReadSpaceArgs( AstStcsChan *this, const char *word,
             } else {
                *p = val;
             }
-            prop = astAppendString( prop, &nc, word );
-            prop = astAppendString( prop, &nc, " " );
+            if( keeptext ) {
+               prop = astAppendString( prop, &nc, word );
+               prop = astAppendString( prop, &nc, " " );
+            }
             word = GetNextWord( this, con, status );
          }
 
 /* Loop round reading remaining vertices, expanding the array as needed. */
          nvert = 1;
-         val = astChr2Double( word );
+         val = ReadDouble( word, status );
          while( val != AST__BAD && astOK ) {
 
             temp = astGrow( temp, naxes*( nvert + 1 ), sizeof( *temp ) );
@@ -5066,21 +5214,24 @@ static const char *ReadSpaceArgs( AstStcsChan *this, const char *word,
                   } else {
                      *p = val;
                   }
-                  prop = astAppendString( prop, &nc, word );
-                  prop = astAppendString( prop, &nc, " " );
+                  if( keeptext ) {
+                     prop = astAppendString( prop, &nc, word );
+                     prop = astAppendString( prop, &nc, " " );
+                  }
                   word = GetNextWord( this, con, status );
-                  val = astChr2Double( word );
+                  val = ReadDouble( word, status );
                }
                nvert++;
             }
          }
 
-/* Remove the trailing space, and store the property value in the KeyMap. */
+/* Remove the trailing space, and store the property values in the
+   KeyMap. */
          if( prop && nc > 0 ) {
             prop[ nc - 1 ] = 0;
             astMapPut0C( props, "VERTICES", prop, NULL );
-            astMapPut1D( props, "DVERTICES", naxes*nvert, temp, NULL );
          }
+         if( astOK ) astMapPut1D( props, "DVERTICES", naxes*nvert, temp, NULL );
          temp = astFree( temp );
       }
 
@@ -5103,7 +5254,7 @@ static const char *ReadSpaceArgs( AstStcsChan *this, const char *word,
 /* Get a value for every space axis. */
       nc = 0;
       for( iaxis = 0; iaxis < naxes; iaxis++ ) {
-         vals[ iaxis ] = astChr2Double( word );
+         vals[ iaxis ] = ReadDouble( word, status );
          if( vals[ iaxis ] == AST__BAD && astOK ) {
             astError( AST__BADIN, "astRead(StcsChan): Expected another "
                       "axis value for a space Position, but found "
@@ -296,8 +296,70 @@ static AstKeyMap *ParameterProps( AstTable *, int * );
 static const char *ColumnName( AstTable *, int index, int * );
 static const char *ParameterName( AstTable *, int index, int * );
 static const char *GetColumnUnit( AstTable *, const char *, int * );
+static void RowKey( char *key, int namlen, int irow, int *status ) {
+/*
+*  Name:
+*     RowKey
+
+*  Purpose:
+*     Complete the key used to store a cell of a column.
+
+*  Type:
+*     Private function.
+
+*  Synopsis:
+*     #include "table.h"
+*     void RowKey( char *key, int namlen, int irow, int *status )
+
+*  Class Membership:
+*     Table member function.
+
+*  Description:
+*     This function appends a one-based row index, enclosed in
+*     parentheses, to a column name held at the start of the supplied
+*     buffer, forming the key used to store the cell in the parent
+*     KeyMap. The result is the same as that produced by
+*     sprintf( key, "%.*s(%d)", namlen, column, irow ), but the column
+*     name is not copied, so this is quicker when forming the keys for
+*     all the cells in a column.
+
+*  Parameters:
+*     key
+*        The buffer holding the column name in its first "namlen"
+*        characters. It should have at least AST__MXCOLKEYLEN + 1
+*        elements.
+*     namlen
+*        The number of characters in the column name.
+*     irow
+*        The one-based row index. Must be positive.
+*     status
+*        Pointer to the inherited status variable.
+*/
+
+/* Local Variables: */
+   char digits[ 20 ];      /* Decimal digits of row index, in reverse */
+   char *p;                /* Pointer to next key character */
+   int nd;                 /* Number of decimal digits */
+
+/* Form the decimal digits of the row index, least significant first. */
+   nd = 0;
+   do {
+      digits[ nd++ ] = (char) ( '0' + irow % 10 );
+      irow /= 10;
+   } while( irow > 0 );
+
+/* Append them to the column name in the correct order, enclosed in
+   parentheses, and terminate the key. */
+   p = key + namlen;
+   *(p++) = '(';
+   while( nd > 0 ) *(p++) = digits[ --nd ];
+   *(p++) = ')';
+   *p = 0;
+}
+
 static const char *TypeString( int );
 static int Equal( AstObject *, AstObject *, int * );
+static int GetColumn( AstTable *, const char *, size_t, void *, char *, int * );
 static int GetColumnLenC( AstTable *, const char *, int * );
 static int GetColumnLength( AstTable *, const char *, int * );
 static int GetColumnNdim( AstTable *, const char *, int * );
@@ -387,6 +449,9 @@ static void SetAttrib( AstObject *, const char *, int * );
 
 static int GetNrow( AstTable *, int * );
 static void SetNrow( AstTable *, int, int * );
+static size_t ColumnTypeSize( AstTable *, const char *, int, const char *, int * );
+static void PutColumn( AstTable *, const char *, int, const void *, const char *, int * );
+static void RowKey( char *, int, int, int * );
 
 static int GetNcolumn( AstTable *, int * );
 static int GetNparameter( AstTable *, int * );
@@ -927,6 +992,88 @@ static AstKeyMap *ColumnProps( AstTable *this, int *status ) {
    return astClone( this->columns );
 }
 
+static size_t ColumnTypeSize( AstTable *this, const char *column, int type,
+                              const char *method, int *status ) {
+/*
+*  Name:
+*     ColumnTypeSize
+
+*  Purpose:
+*     Get the size of a single element of a numerical column value.
+
+*  Type:
+*     Private function.
+
+*  Synopsis:
+*     #include "table.h"
+*     size_t ColumnTypeSize( AstTable *this, const char *column, int type,
+*                            const char *method, int *status )
+
+*  Class Membership:
+*     Table member function.
+
+*  Description:
+*     This function returns the number of bytes used to store a single
+*     element of a value of the supplied data type. An error is reported
+*     if the data type is not one of the integer or floating point types.
+
+*  Parameters:
+*     this
+*        Pointer to the Table.
+*     column
+*        The name of the column, for use in error messages.
+*     type
+*        The column data type.
+*     method
+*        Name of the calling method, for use in error messages.
+*     status
+*        Pointer to the inherited status variable.
+
+*  Returned Value:
+*     The number of bytes in a single element.
+
+*  Notes:
+*     - Zero is returned if an error has already occurred, or if this
+*     function fails for any reason.
+
+*/
+
+/* Local Variables: */
+   size_t result;
+
+/* Check the global error status. */
+   if ( !astOK ) return 0;
+
+/* Do each supported type in turn. */
+   if( type == AST__INTTYPE ) {
+      result = sizeof( int );
+
+   } else if( type == AST__KINTTYPE ) {
+      result = sizeof( int64_t );
+
+   } else if( type == AST__DOUBLETYPE ) {
+      result = sizeof( double );
+
+   } else if( type == AST__FLOATTYPE ) {
+      result = sizeof( float );
+
+   } else if( type == AST__SINTTYPE ) {
+      result = sizeof( short int );
+
+   } else if( type == AST__BYTETYPE ) {
+      result = sizeof( unsigned char );
+
+/* Report an error for any other type. */
+   } else {
+      result = 0;
+      astError( AST__BADTYP, "%s(%s): Column %s holds %s values but only "
+                "numerical columns can be accessed as a whole.", status,
+                method, astGetClass( this ), column, TypeString( type ) );
+   }
+
+   return result;
+}
+
 static void ColumnShape( AstTable *this, const char *column, int mxdim,
                          int *ndim, int *dims, int *status ){
 /*
@@ -1300,6 +1447,150 @@ static const char *GetAttrib( AstObject *this_object, const char *attrib, int *s
    return result;
 }
 
+static int GetColumn( AstTable *this, const char *column, size_t mxsize,
+                      void *data, char *valid, int *status ) {
+/*
+*+
+*  Name:
+*     astGetColumn
+
+*  Purpose:
+*     Retrieve all the values stored in a numerical column.
+
+*  Type:
+*     Protected virtual function.
+
+*  Synopsis:
+*     #include "table.h"
+*     int astGetColumn( AstTable *this, const char *column, size_t mxsize,
+*                       void *data, char *valid )
+
+*  Class Membership:
+*     Table method.
+
+*  Description:
+*     This function copies the values stored in all cells of a named
+*     column into a single contiguous array, using the native data type
+*     of the column. The column properties are checked only once, and
+*     each cell is then read directly from the underlying KeyMap, so
+*     this is much faster than reading each cell in turn using the
+*     astMapGet1<X> methods.
+
+*  Parameters:
+*     this
+*        Pointer to the Table.
+*     column
+*        The character string holding the name of the column. Trailing
+*        spaces are ignored.
+*     mxsize
+*        The size in bytes of the "data" array. The number of rows
+*        returned is reduced if necessary so that they fit into the array.
+*     data
+*        Pointer to an array in which to return the column values. The
+*        values for each row are stored in turn, each row containing
+*        ColumnLength elements of the column's data type. Elements for
+*        rows that have no value are left unchanged.
+*     valid
+*        Pointer to an array in which to return a flag for each row,
+*        indicating if a value was found in the row (non-zero) or not
+*        (zero). It should have at least as many elements as the number
+*        of rows returned. May be NULL.
+
+*  Returned Value:
+*     The number of rows for which information is returned in "data" and
+*     "valid".
+
+*  Notes:
+*     - Only columns of integer and floating point data types are
+*     supported. An error is reported if the column holds any other type
+*     of value, or does not exist.
+*     - A function value of zero will be returned if an error has already
+*     occurred, or if this function should fail for any reason.
+
+*-
+*/
+
+/* Local Variables: */
+   AstKeyMap *this_keymap; /* Pointer to parent KeyMap structure */
+   char key[ AST__MXCOLKEYLEN + 1 ]; /* Current cell key string */
+   char *pout;             /* Pointer to next output value */
+   const void *pval;       /* Pointer to stored cell value */
+   int irow;               /* One-based index of current row */
+   int namlen;             /* Used length of column name */
+   int nel;                /* No. of elements per value */
+   int nrow;               /* No. of rows to return */
+   int nval;               /* No. of values read from a cell */
+   int ok;                 /* Was a value found for the current row? */
+   int type;               /* Column data type */
+   int vnel;               /* No. of elements in stored cell value */
+   int vtype;              /* Data type of stored cell value */
+   size_t nbv;             /* No. of bytes per value */
+
+/* Check the global error status. */
+   if ( !astOK ) return 0;
+
+/* Get the data type of the column, and the number of bytes in each
+   element. This reports an error if the column does not exist. */
+   type = astGetColumnType( this, column );
+   nbv = ColumnTypeSize( this, column, type, "astGetColumn", status );
+
+/* Get the number of elements per value, and the number of bytes per value. */
+   nel = astGetColumnLength( this, column );
+   nbv *= nel;
+
+/* Get the number of rows to return. */
+   nrow = astGetNrow( this );
+   if( nbv && mxsize < nbv*nrow ) nrow = mxsize/nbv;
+
+/* Copy the column name into the start of the buffer used to hold the
+   key for each cell. Only the row number then needs to be changed for
+   each cell. */
+   this_keymap = (AstKeyMap *) this;
+   namlen = astChrLen( column );
+   memcpy( key, column, namlen );
+
+/* Loop round the rows. Get a pointer to the value stored in each cell.
+   If it has the native data type and length of the column (which is
+   normally the case), just copy it. Otherwise, use the parent KeyMap
+   method appropriate to the column data type, which converts it. */
+   pout = data;
+   for( irow = 1; irow <= nrow && astOK; irow++ ) {
+      RowKey( key, namlen, irow, status );
+      pval = astMapValuePtr( this_keymap, key, &vtype, &vnel );
+
+      if( !pval ) {
+         ok = 0;
+      } else if( vtype == type && vnel == nel ) {
+         memcpy( pout, pval, nbv );
+         ok = 1;
+      } else if( type == AST__INTTYPE ) {
+         ok = (*parent_mapget1i)( this_keymap, key, nel, &nval,
+                                  (int *) pout, status );
+      } else if( type == AST__KINTTYPE ) {
+         ok = (*parent_mapget1k)( this_keymap, key, nel, &nval,
+                                  (int64_t *) pout, status );
+      } else if( type == AST__DOUBLETYPE ) {
+         ok = (*parent_mapget1d)( this_keymap, key, nel, &nval,
+                                  (double *) pout, status );
+      } else if( type == AST__FLOATTYPE ) {
+         ok = (*parent_mapget1f)( this_keymap, key, nel, &nval,
+                                  (float *) pout, status );
+      } else if( type == AST__SINTTYPE ) {
+         ok = (*parent_mapget1s)( this_keymap, key, nel, &nval,
+                                  (short int *) pout, status );
+      } else {
+         ok = (*parent_mapget1b)( this_keymap, key, nel, &nval,
+                                  (unsigned char *) pout, status );
+      }
+
+      if( valid ) valid[ irow - 1 ] = ok ? 1 : 0;
+      pout += nbv;
+   }
+
+/* Return zero if an error occurred. */
+   return astOK ? nrow : 0;
+}
+
 static int GetColumnLenC( AstTable *this, const char *column, int *status ) {
 /*
 *+
@@ -2151,6 +2442,8 @@ void astInitTableVtab_(  AstTableVtab *vtab, const char *name, int *status ) {
    vtab->GetColumnLength = GetColumnLength;
    vtab->GetColumnNdim = GetColumnNdim;
    vtab->GetColumnType = GetColumnType;
+   vtab->GetColumn = GetColumn;
+   vtab->PutColumn = PutColumn;
    vtab->GetColumnUnit = GetColumnUnit;
    vtab->GetNcolumn = GetNcolumn;
    vtab->GetNparameter = GetNparameter;
@@ -3682,6 +3975,134 @@ static int ParseKey( AstTable *this, const char *key, int report,
    return result;
 }
 
+static void PutColumn( AstTable *this, const char *column, int nrow,
+                       const void *data, const char *valid, int *status ) {
+/*
+*+
+*  Name:
+*     astPutColumn
+
+*  Purpose:
+*     Store new values for all rows of a numerical column.
+
+*  Type:
+*     Protected virtual function.
+
+*  Synopsis:
+*     #include "table.h"
+*     void astPutColumn( AstTable *this, const char *column, int nrow,
+*                        const void *data, const char *valid )
+
+*  Class Membership:
+*     Table method.
+
+*  Description:
+*     This function stores new values for rows 1 to "nrow" of a named
+*     column, taking them from a single contiguous array that uses the
+*     native data type of the column. The column properties are checked
+*     only once, and each cell is then written directly to the underlying
+*     KeyMap, so this is much faster than storing each cell in turn using
+*     the astMapPut1<X> methods. The Nrow attribute is increased if
+*     necessary.
+
+*  Parameters:
+*     this
+*        Pointer to the Table.
+*     column
+*        The character string holding the name of the column. Trailing
+*        spaces are ignored.
+*     nrow
+*        The number of rows to store.
+*     data
+*        Pointer to an array holding the new column values. The values
+*        for each row are stored in turn, each row containing ColumnLength
+*        elements of the column's data type.
+*     valid
+*        Pointer to an array holding a flag for each row. If the flag is
+*        zero, any existing value in the corresponding cell is removed and
+*        the corresponding elements of "data" are ignored. May be NULL, in
+*        which case all rows are stored.
+
+*  Notes:
+*     - Only columns of integer and floating point data types are
+*     supported. An error is reported if the column holds any other type
+*     of value, or does not exist.
+*     - Cells in rows above "nrow" are left unchanged.
+
+*-
+*/
+
+/* Local Variables: */
+   AstKeyMap *this_keymap; /* Pointer to parent KeyMap structure */
+   char key[ AST__MXCOLKEYLEN + 1 ]; /* Current cell key string */
+   const char *pin;        /* Pointer to next input value */
+   int irow;               /* One-based index of current row */
+   int lastrow;            /* Highest row containing a stored value */
+   int namlen;             /* Used length of column name */
+   int nel;                /* No. of elements per value */
+   int type;               /* Column data type */
+   size_t nbv;             /* No. of bytes per value */
+
+/* Check the global error status. */
+   if ( !astOK ) return;
+
+/* Get the data type of the column, and the number of bytes in each
+   element. This reports an error if the column does not exist. */
+   type = astGetColumnType( this, column );
+   nbv = ColumnTypeSize( this, column, type, "astPutColumn", status );
+
+/* Get the number of elements per value, and the number of bytes per value. */
+   nel = astGetColumnLength( this, column );
+   nbv *= nel;
+
+/* Copy the column name into the start of the buffer used to hold the
+   key for each cell. Only the row number then needs to be changed for
+   each cell. */
+   this_keymap = (AstKeyMap *) this;
+   namlen = astChrLen( column );
+   memcpy( key, column, namlen );
+
+/* Loop round the rows, storing each cell using the parent KeyMap method
+   appropriate to the column data type. */
+   pin = data;
+   lastrow = 0;
+   for( irow = 1; irow <= nrow && astOK; irow++ ) {
+      RowKey( key, namlen, irow, status );
+
+      if( valid && !valid[ irow - 1 ] ) {
+         (*parent_mapremove)( this_keymap, key, status );
+
+      } else {
+         lastrow = irow;
+
+         if( type == AST__INTTYPE ) {
+            (*parent_mapput1i)( this_keymap, key, nel, (const int *) pin,
+                                NULL, status );
+         } else if( type == AST__KINTTYPE ) {
+            (*parent_mapput1k)( this_keymap, key, nel, (const int64_t *) pin,
+                                NULL, status );
+         } else if( type == AST__DOUBLETYPE ) {
+            (*parent_mapput1d)( this_keymap, key, nel, (const double *) pin,
+                                NULL, status );
+         } else if( type == AST__FLOATTYPE ) {
+            (*parent_mapput1f)( this_keymap, key, nel, (const float *) pin,
+                                NULL, status );
+         } else if( type == AST__SINTTYPE ) {
+            (*parent_mapput1s)( this_keymap, key, nel,
+                                (const short int *) pin, NULL, status );
+         } else {
+            (*parent_mapput1b)( this_keymap, key, nel,
+                                (const unsigned char *) pin, NULL, status );
+         }
+      }
+
+      pin += nbv;
+   }
+
+/* Update the number of rows in the table if required. */
+   if( lastrow > astGetNrow( this ) ) astSetNrow( this, lastrow );
+}
+
 static void PurgeRows( AstTable *this, int *status ) {
 /*
 *++
@@ -5249,6 +5670,16 @@ int astGetColumnNdim_( AstTable *this, const char *column, int *status ){
    if ( !astOK ) return 0;
    return (**astMEMBER(this,Table,GetColumnNdim))(this,column,status);
 }
+int astGetColumn_( AstTable *this, const char *column, size_t mxsize,
+                   void *data, char *valid, int *status ){
+   if ( !astOK ) return 0;
+   return (**astMEMBER(this,Table,GetColumn))(this,column,mxsize,data,valid,status);
+}
+void astPutColumn_( AstTable *this, const char *column, int nrow,
+                    const void *data, const char *valid, int *status ){
+   if ( !astOK ) return;
+   (**astMEMBER(this,Table,PutColumn))(this,column,nrow,data,valid,status);
+}
 void astColumnShape_( AstTable *this, const char *column, int mxdim,
                       int *ndim, int *dims, int *status ){
    if ( !astOK ) return;
@@ -126,6 +126,7 @@ typedef struct AstTableVtab {
    int (* GetColumnLength)( AstTable *, const char *, int * );
    int (* GetColumnNdim)( AstTable *, const char *, int * );
    int (* GetColumnType)( AstTable *, const char *, int * );
+   int (* GetColumn)( AstTable *, const char *, size_t, void *, char *, int * );
    int (* GetNcolumn)( AstTable *, int * );
    int (* GetNparameter)( AstTable *, int * );
    int (* GetNrow)( AstTable *, int * );
@@ -135,6 +136,7 @@ typedef struct AstTableVtab {
    void (* AddParameter)( AstTable *, const char *, int * );
    void (* ColumnShape)( AstTable *, const char *, int, int *, int *, int * );
    void (* PurgeRows)( AstTable *, int * );
+   void (* PutColumn)( AstTable *, const char *, int, const void *, const char *, int * );
    void (* RemoveColumn)( AstTable *, const char *, int * );
    void (* RemoveParameter)( AstTable *, const char *, int * );
    void (* RemoveRow)( AstTable *, int, int * );
@@ -211,10 +213,12 @@ int astGetColumnLenC_( AstTable *, const char *, int * );
 int astGetColumnLength_( AstTable *, const char *, int * );
 int astGetColumnNdim_( AstTable *, const char *, int * );
 int astGetColumnType_( AstTable *, const char *, int * );
+int astGetColumn_( AstTable *, const char *, size_t, void *, char *, int * );
 int astGetNcolumn_( AstTable *, int * );
 int astGetNparameter_( AstTable *, int * );
 int astGetNrow_( AstTable *, int * );
 void astSetNrow_( AstTable *, int, int * );
+void astPutColumn_( AstTable *, const char *, int, const void *, const char *, int * );
 #endif
 
 /* Function interfaces. */
@@ -299,6 +303,10 @@ astINVOKE(V,astGetColumnNdim_(astCheckTable(this),column,STATUS_PTR))
 astINVOKE(V,astGetColumnType_(astCheckTable(this),column,STATUS_PTR))
 #define astGetColumnUnit(this,column) \
 astINVOKE(V,astGetColumnUnit_(astCheckTable(this),column,STATUS_PTR))
+#define astGetColumn(this,column,mxsize,data,valid) \
+astINVOKE(V,astGetColumn_(astCheckTable(this),column,mxsize,data,valid,STATUS_PTR))
+#define astPutColumn(this,column,nrow,data,valid) \
+astINVOKE(V,astPutColumn_(astCheckTable(this),column,nrow,data,valid,STATUS_PTR))
 
 #endif
 #endif
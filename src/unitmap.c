@@ -347,10 +347,14 @@ void astInitUnitMapVtab_(  AstUnitMapVtab *vtab, const char *name, int *status )
 
 /* If we have just initialised the vtab for the current class, indicate
    that the vtab is now initialised, and store a pointer to the class
-   identifier in the base "object" level of the vtab. */
+   identifier in the base "object" level of the vtab. Also indicate that
+   the memory used by deleted UnitMaps should be re-used (see the
+   ObjectPool tuning parameter), since large numbers of short-lived
+   UnitMaps are often created. This is not done for sub-classes. */
    if( vtab == &class_vtab ) {
       class_init = 1;
       astSetVtabClassIdentifier( vtab, &(vtab->id) );
+      astSetVtabPooled( vtab );
    }
 }
 
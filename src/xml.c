@@ -74,6 +74,9 @@
 
 #define IND_INC 3
 
+/* The number of spare text buffers retained while reading a document. */
+#define AST__XML_NPOOL 8
+
 
 /* Include files. */
 /* ============== */
@@ -91,6 +94,7 @@
 /* C header files. */
 /* --------------- */
 #include <stdarg.h>
+#include <stddef.h>
 #include <stdio.h>
 #include <string.h>
 #include <ctype.h>
@@ -189,6 +193,10 @@ static pthread_mutex_t mutex1 = PTHREAD_MUTEX_INITIALIZER;
 #define LOCK_MUTEX1 pthread_mutex_lock( &mutex1 );
 #define UNLOCK_MUTEX1 pthread_mutex_unlock( &mutex1 );
 
+static pthread_mutex_t mutex2 = PTHREAD_MUTEX_INITIALIZER;
+#define LOCK_MUTEX2 pthread_mutex_lock( &mutex2 );
+#define UNLOCK_MUTEX2 pthread_mutex_unlock( &mutex2 );
+
 /* If thread safety is not needed, declare globals at static variables. */
 #else
 
@@ -198,6 +206,9 @@ static char gettag_buff[ AST__XML_GETTAG_BUFF_LEN + 1 ];
 #define LOCK_MUTEX1
 #define UNLOCK_MUTEX1
 
+#define LOCK_MUTEX2
+#define UNLOCK_MUTEX2
+
 #ifdef DEBUG   /* Not available in thread-safe compilations */
 static int nobj = 0;
 static AstXmlObject **existing_objects = NULL;
@@ -205,6 +216,40 @@ static AstXmlObject **existing_objects = NULL;
 
 #endif
 
+/* Element and attribute names (and their namespace prefixes) are
+   interned. Each distinct name is stored once, in a hash table that is
+   shared by all threads (access is serialised by mutex2). The XmlObjects
+   then just hold pointers to the "text" component of an XmlName
+   structure. This saves allocating and freeing memory for every element
+   and attribute, and means that the hash value for a name can be found
+   directly from the name pointer using the NAME_HASH macro. Each name
+   has a reference count giving the number of XmlObjects that use it.
+   Names that are no longer used are retained for re-use (so that
+   reading a long stream of similar elements does not allocate and free
+   the same names repeatedly), but are removed from the table once there
+   are more than NAME_MAXUNUSED of them and they make up more than half
+   the table. */
+typedef struct XmlName {
+   struct XmlName *next;      /* Next name in the same hash table bucket */
+   unsigned int hash;         /* Hash value for the name */
+   int nref;                  /* Number of XmlObjects using the name */
+   char text[ 1 ];            /* The null-terminated name (extended as needed) */
+} XmlName;
+
+#define NAME_HASH(name) \
+   ( ( (XmlName *) ( (name) - offsetof( XmlName, text ) ) )->hash )
+
+/* The bit within the "attrmask" component of an XmlElement that is set
+   if the element has an attribute with the given name hash value. */
+#define NAME_BIT(hash) ( 1U << ( (hash) & 31U ) )
+
+#define NAME_MAXUNUSED 256
+
+static XmlName **name_table = NULL;
+static int name_tabsize = 0;
+static int name_count = 0;
+static int name_unused = 0;
+
 
 /* Function prototypes. */
 /* ==================== */
@@ -212,12 +257,18 @@ static AstXmlObject **existing_objects = NULL;
 /* Private member functions. */
 /* ------------------------- */
 static AstXmlAttribute *FindAttribute( AstXmlElement *, const char *, int * );
+static XmlName *FindName( const char *, size_t, unsigned int, int * );
 static AstXmlAttribute *NewAttribute( const char *, const char *, const char *, int * );
 static AstXmlDocument *NewDocument( int * );
 static AstXmlPrologue *NewPrologue( AstXmlDocument *, int * );
 static AstXmlNamespace *NewNamespace( const char *, const char *, int * );
 static char *AppendChar( char *, int *, char, int * );
 static char *AppendLine( char *, int *, const char *, int, int * );
+static char *AppendText( char *, int *, char, char **, int * );
+static char *ReleaseText( char *, char **, int * );
+static char *InternName( const char *, size_t, const char *, const char *, int * );
+static char *ReleaseName( char *, int * );
+static void PurgeNames( int * );
 static char *RemoveEscapes( const char *, int * );
 static char *CleanText( const char *, int * );
 static const char *AddEscapes( const char *, int * );
@@ -228,7 +279,9 @@ static const char *ResolvePrefix( const char *, AstXmlElement *, int * );
 static int CheckType( long int, long int, int * );
 static int MatchName( AstXmlElement *, const char *, int * );
 static int Ustrcmp( const char *, const char *, int * );
+static unsigned int HashName( const char *, size_t, int * );
 static void AddContent( AstXmlParent *, int, AstXmlContentItem *, int * );
+static void RemoveContent( AstXmlElement *, int, int * );
 static void CheckName( const char *, const char *, const char *, int, int * );
 static void CheckPrefName( char *, const char *, const char *, int * );
 static void CleanXml( AstXmlObject *, long int, int * );
@@ -245,7 +298,7 @@ static void InitXmlElement( AstXmlElement *, int, const char *, const char *, in
 static void InitXmlNamespace( AstXmlNamespace *, int, const char *, const char *, int * );
 static void InitXmlObject( AstXmlObject *, long int, int * );
 static void InitXmlPI( AstXmlPI *, int, const char *, const char *, int * );
-static AstXmlElement *ReadContent( AstXmlDocument **, int, int (*)( AstXmlElement *, int * ), int, char (*)( void *, int * ), void *, int, int * );
+static AstXmlElement *ReadContent( AstXmlDocument **, int, int (*)( AstXmlElement *, int * ), void (*)( AstXmlElement *, int * ), int, char (*)( void *, int * ), void *, int, char **, int * );
 
 #ifdef DEBUG
 static void AddObjectToList( AstXmlObject * );
@@ -317,6 +370,7 @@ static void AddContent( AstXmlParent *this, int where, AstXmlContentItem *item,
 */
 
 /* Local Variables: */
+   AstXmlContentItem **base; /* Start of memory holding item list */
    AstXmlDocument *doc;   /* Document pointer */
    AstXmlElement *elem;   /* Element pointer */
    AstXmlPrologue *pro;   /* Prologue pointer */
@@ -332,12 +386,25 @@ static void AddContent( AstXmlParent *this, int where, AstXmlContentItem *item,
 /* Save the number of content items currently stored in the element. */
       nitem = ( elem->items ) ? elem->nitem : 0;
 
+/* Items removed from the start of the list leave unused slots before
+   the first item (see RemoveContent). If these account for more than
+   half the allocated memory, shuffle the items down to the start of the
+   memory. */
+      if( elem->nskip > 0 && elem->nskip >= nitem ) {
+         memmove( elem->items - elem->nskip, elem->items,
+                  nitem*sizeof( AstXmlContentItem * ) );
+         elem->items -= elem->nskip;
+         elem->nskip = 0;
+      }
+
 /* Attempt to extend the array to hold an extra item. */
-      elem->items = astGrow( elem->items, nitem + 1,
-                             sizeof( AstXmlContentItem * ) );
+      base = elem->items ? elem->items - elem->nskip : NULL;
+      base = astGrow( base, elem->nskip + nitem + 1,
+                      sizeof( AstXmlContentItem * ) );
 
 /* Check the memory was allocated succesfully. */
       if( astOK ) {
+         elem->items = base + elem->nskip;
 
 /* Store the supplied pointer in the array of content items. */
          elem->items[ nitem ] = item;
@@ -753,6 +820,79 @@ static char *AppendLine( char *str1, int *nc, const char *str2, int ind, int *st
    return astAppendString( temp, nc, str2 );
 }
 
+static char *AppendText( char *str1, int *nc, char ch, char **pool,
+                         int *status ) {
+/*
+*  Name:
+*     AppendText
+
+*  Purpose:
+*     Append a character to a text buffer, re-using spare memory.
+
+*  Type:
+*     Private function.
+
+*  Synopsis:
+*     #include "xml.h"
+*     char *AppendText( char *str1, int *nc, char ch, char **pool,
+*                       int *status )
+
+*  Description:
+*     This function is like AppendChar, except that if a NULL "str1"
+*     pointer is supplied, a spare buffer is taken from the supplied
+*     pool (if any are available) instead of allocating new memory. This
+*     allows the memory used to accumulate text while reading a document
+*     to be re-used for each new tag, attribute, etc, rather than being
+*     allocated and freed each time. Text buffers should be returned to
+*     the pool using ReleaseText when they are no longer needed.
+
+*  Parameters:
+*     str1
+*        Pointer to the null-terminated dynamic string, or NULL.
+*     nc
+*        Pointer to an integer containing the number of characters in
+*        the dynamic string (excluding the final null). Its value is
+*        updated by this function to include the extra character.
+*        If "str1" is NULL, the initial value supplied for "*nc" will
+*        be ignored and zero will be used.
+*     ch
+*        The character which is to be appended to "str1".
+*     pool
+*        Pointer to an array of AST__XML_NPOOL pointers to spare buffers.
+*        NULL pointers in the array are ignored.
+*     status
+*        Pointer to the inherited status variable.
+
+*  Returned Value:
+*     A possibly new pointer to the dynamic string with the new character
+*     appended.
+
+*  Notes:
+*     - If this function is invoked with the global error status set
+*     or if it should fail for any reason, then the returned pointer
+*     will be equal to "str1" and the dynamic string contents will be
+*     unchanged.
+*/
+
+/* Local Variables: */
+   int i;                        /* Index into pool */
+
+/* If no string was supplied, take a spare buffer from the pool. */
+   if( !str1 && astOK ) {
+      for( i = 0; i < AST__XML_NPOOL; i++ ) {
+         if( pool[ i ] ) {
+            str1 = pool[ i ];
+            pool[ i ] = NULL;
+            *nc = 0;
+            break;
+         }
+      }
+   }
+
+/* Append the character. */
+   return AppendChar( str1, nc, ch, status );
+}
+
 void astXmlAddAttr_( AstXmlElement *this, const char *name, const char *value,
                      const char *prefix, int *status ){
 /*
@@ -803,11 +943,12 @@ void astXmlAddAttr_( AstXmlElement *this, const char *name, const char *value,
 /* Initialise */
    oldattr = NULL;
 
-/* Clean the value text. */
-   my_value = CleanText( value, status );
+/* Clean the value text. This is only needed if it contains any carriage
+   return characters. */
+   my_value = ( value && strchr( value, '\r' ) ) ? CleanText( value, status ) : NULL;
 
 /* Create a new XmlAttribute. */
-   attr = NewAttribute( name, my_value, prefix, status );
+   attr = NewAttribute( name, my_value ? my_value : value, prefix, status );
 
 /* Free the memory */
    my_value = astFree( my_value );
@@ -820,19 +961,14 @@ void astXmlAddAttr_( AstXmlElement *this, const char *name, const char *value,
       nattr = ( this->attrs ) ? this->nattr : 0;
 
 /* Search the existing attributes to see if an attribute with the given
-   name and prefix already exists. */
+   name and prefix already exists. Names and prefixes are shared, so
+   there is no need to compare the strings themselves. */
       oldi = -1;
       for( i = 0; i < nattr; i++ ) {
          oldattr = this->attrs[ i ];
-         if( !strcmp( oldattr->name, attr->name ) ) {
-            if( !oldattr->prefix && !attr->prefix ) {
-               oldi = i;
-               break;
-            } else if( oldattr->prefix && attr->prefix &&
-                       !strcmp( oldattr->prefix, attr->prefix ) ){
-               oldi = i;
-               break;
-            }
+         if( oldattr->name == attr->name && oldattr->prefix == attr->prefix ) {
+            oldi = i;
+            break;
          }
       }
 
@@ -857,6 +993,9 @@ void astXmlAddAttr_( AstXmlElement *this, const char *name, const char *value,
 /* Increment the number of content items in this element */
             this->nattr = nattr + 1;
 
+/* Record the hash value of the attribute name in the element. */
+            this->attrmask |= NAME_BIT( NAME_HASH( attr->name ) );
+
          }
       }
    }
@@ -1502,6 +1641,7 @@ AstXmlObject *astXmlCopy_( AstXmlObject *this, int *status ) {
 
       newelem->attrs = astMalloc( sizeof( AstXmlAttribute *) * (size_t)elem->nattr );
       newelem->nattr = elem->nattr;
+      newelem->attrmask = elem->attrmask;
       for( i = 0; i < elem->nattr; i++ ) {
          newelem->attrs[ i ] = (AstXmlAttribute *) astXmlCopy( elem->attrs[ i ] );
          ((AstXmlObject *) newelem->attrs[ i ])->parent = (AstXmlParent *) newelem;
@@ -2637,19 +2777,14 @@ void astXmlRemoveAttr_( AstXmlElement *this, const char *name,
       nattr = ( this->attrs ) ? this->nattr : 0;
 
 /* Search the existing attributes to see if an attribute with the given
-   name and prefix already exists. */
+   name and prefix already exists. Names and prefixes are shared, so
+   there is no need to compare the strings themselves. */
       oldi = -1;
       for( i = 0; i < nattr; i++ ) {
          oldattr = this->attrs[ i ];
-         if( !strcmp( oldattr->name, attr->name ) ) {
-            if( !oldattr->prefix && !attr->prefix ) {
-               oldi = i;
-               break;
-            } else if( oldattr->prefix && attr->prefix &&
-                       !strcmp( oldattr->prefix, attr->prefix ) ){
-               oldi = i;
-               break;
-            }
+         if( oldattr->name == attr->name && oldattr->prefix == attr->prefix ) {
+            oldi = i;
+            break;
          }
       }
 
@@ -2696,7 +2831,6 @@ void astXmlRemoveItem_( AstXmlContentItem *this, int *status ){
    AstXmlParent *parent;            /* Pointer to parent */
    int found;                       /* Was the item found within its parent? */
    int i;                           /* Item index */
-   int j;                           /* Item index */
 
 /* Check the global error status. */
    if( !astOK ) return;
@@ -2712,13 +2846,9 @@ void astXmlRemoveItem_( AstXmlContentItem *this, int *status ){
       for( i = 0; i < elem->nitem; i++ ) {
          if( elem->items[ i ] == this ) {
 
-/* When found, decrement the number of items in the element, and shuffle
-   all the remaining item pointers down one slot to over-write it, then
+/* When found, remove it from the list of items in the element, then
    nullify the parent pointer in the supplied object and leave the loop. */
-            (elem->nitem)--;
-            for( j = i; j < elem->nitem; j++ ) {
-               elem->items[ j ] = elem->items[ j + 1 ];
-            }
+            RemoveContent( elem, i, status );
             ( (AstXmlObject *) this )->parent = NULL;
             found = 1;
             break;
@@ -3440,15 +3570,16 @@ static void CleanXml( AstXmlObject *this, long int type, int *status ){
 
       elem = (AstXmlElement *) this;
 
-      elem->name = astFree( elem->name );
+      elem->name = ReleaseName( elem->name, status );
       elem->defns = astFree( elem->defns );
-      elem->prefix = astFree( elem->prefix );
+      elem->prefix = ReleaseName( elem->prefix, status );
 
       while( elem->nattr > 0 ) astXmlDelete( elem->attrs[ 0 ] );
       elem->attrs = astFree( elem->attrs );
 
       while( elem->nitem > 0 ) astXmlDelete( elem->items[ 0 ] );
-      elem->items = astFree( elem->items );
+      if( elem->items ) elem->items = astFree( elem->items - elem->nskip );
+      elem->nskip = 0;
 
       while( elem->nnspref > 0 ) astXmlDelete( elem->nsprefs[ 0 ] );
       elem->nsprefs = astFree( elem->nsprefs );
@@ -3457,9 +3588,9 @@ static void CleanXml( AstXmlObject *this, long int type, int *status ){
 
    } else if( type == AST__XMLATTR ){
       attr = (AstXmlAttribute *) this;
-      attr->name = astFree( attr->name );
+      attr->name = ReleaseName( attr->name, status );
       attr->value = astFree( attr->value );
-      attr->prefix = astFree( attr->prefix );
+      attr->prefix = ReleaseName( attr->prefix, status );
       CleanXml( this, AST__XMLOBJECT, status );
 
    } else if( type == AST__XMLBLACK ){
@@ -3777,10 +3908,7 @@ void *astXmlDelete_( void *obj_ptr, int *status ){
             n = elem->nitem;
             for( i = 0; i < n; i++ ) {
                if( elem->items[ i ] == (AstXmlContentItem *) obj ) {
-                  for( j = i + 1; j < n; j++ ) {
-                     elem->items[ j - 1 ] =  elem->items[ j ];
-                  }
-                  elem->items[ --elem->nitem ] = NULL;
+                  RemoveContent( elem, i, status );
                   ok = 1;
                   break;
                }
@@ -3858,16 +3986,16 @@ static AstXmlAttribute *FindAttribute( AstXmlElement *this, const char *name0,
 */
 
 /* Local Variables: */
+   AstXmlAttribute *attr;       /* Pointer to attribute to be checked */
    AstXmlAttribute *result;     /* Returned pointer */
    char name_buffer[ 50 ];      /* Buffer for name */
    char prefix_buffer[ 50 ];    /* Buffer for prefix */
    const char *colon;           /* Pointer to colon in supplied string */
-   const char *name1;           /* Pointer to name to be checked */
    const char *name;            /* Pointer to name to be searched for */
-   const char *prefix1;         /* Pointer to prefix to be checked */
    const char *prefix;          /* Pointer to prefix to be searched for */
    int i;                       /* Loop count */
    size_t len;                  /* Length of string */
+   unsigned int hash;           /* Hash value for the name */
 
 /* Initialise */
    result = NULL;
@@ -3903,17 +4031,25 @@ static AstXmlAttribute *FindAttribute( AstXmlElement *this, const char *name0,
 
    }
 
-/* Loop round all the attributes in the element. */
-   for( i = 0; i < this->nattr; i++ ) {
-      name1 = this->attrs[ i ]->name;
-      prefix1 = this->attrs[ i ]->prefix;
+/* The element records the hash values of the names of all the attributes
+   it has ever held in its "attrmask" component. If the bit for the
+   required name is not set, the element cannot have the attribute, so
+   there is no need to check each attribute. */
+   hash = HashName( name, strlen( name ), status );
+   if( this->attrmask & NAME_BIT( hash ) ) {
+
+/* Otherwise, loop round all the attributes in the element. */
+      for( i = 0; i < this->nattr; i++ ) {
+         attr = this->attrs[ i ];
 
 /* Compare the attribute name (and prefix) with the supplied name (and
-   prefix). Leave the loop if they match. */
-      if( !strcmp( name1, name ) &&
-          ( !prefix || ( prefix1 && !strcmp( prefix1, prefix ) ) ) ) {
-         result = this->attrs[ i ];
-         break;
+   prefix). The names are only compared if their hash values are equal.
+   Leave the loop if they match. */
+         if( NAME_HASH( attr->name ) == hash && !strcmp( attr->name, name ) &&
+             ( !prefix || ( attr->prefix && !strcmp( attr->prefix, prefix ) ) ) ) {
+            result = attr;
+            break;
+         }
       }
    }
 
@@ -3921,6 +4057,61 @@ static AstXmlAttribute *FindAttribute( AstXmlElement *this, const char *name0,
    return result;
 }
 
+static XmlName *FindName( const char *name, size_t nc, unsigned int hash,
+                          int *status ){
+/*
+*  Name:
+*     FindName
+
+*  Purpose:
+*     Search the table of interned names for a given name.
+
+*  Type:
+*     Private function.
+
+*  Synopsis:
+*     #include "xml.h"
+*     XmlName *FindName( const char *name, size_t nc, unsigned int hash,
+*                        int *status )
+
+*  Description:
+*     This function searches the table of interned element and attribute
+*     names for a given name. It should only be called while the mutex
+*     protecting the table is locked.
+
+*  Parameters:
+*     name
+*        Pointer to the start of the name. It need not be null-terminated.
+*     nc
+*        The number of characters in the name.
+*     hash
+*        The hash value for the name, as returned by HashName.
+*     status
+*        Pointer to the inherited status variable.
+
+*  Returned Value:
+*     Pointer to the XmlName structure holding the name, or NULL if the
+*     name has not yet been interned.
+*/
+
+/* Local Variables: */
+   XmlName *result;             /* Returned pointer */
+
+/* Check the table has been created. */
+   if( !name_table ) return NULL;
+
+/* Search the bucket into which the hash value falls. */
+   result = name_table[ hash & ( name_tabsize - 1 ) ];
+   while( result ) {
+      if( result->hash == hash && !strncmp( result->text, name, nc ) &&
+          !result->text[ nc ] ) break;
+      result = result->next;
+   }
+
+/* Return the result. */
+   return result;
+}
+
 static const char *Format( AstXmlObject *this, int ind, int *status ){
 /*
 *  Name:
@@ -4339,6 +4530,55 @@ static char *FormatTag( AstXmlObject *this, int opening, int *status ){
    return result;
 }
 
+static unsigned int HashName( const char *name, size_t nc, int *status ){
+/*
+*  Name:
+*     HashName
+
+*  Purpose:
+*     Return a hash value for an element or attribute name.
+
+*  Type:
+*     Private function.
+
+*  Synopsis:
+*     #include "xml.h"
+*     unsigned int HashName( const char *name, size_t nc, int *status )
+
+*  Description:
+*     This function returns a hash value for the supplied name (a 32 bit
+*     FNV-1a hash).
+
+*  Parameters:
+*     name
+*        Pointer to the start of the name. It need not be null-terminated.
+*     nc
+*        The number of characters in the name.
+*     status
+*        Pointer to the inherited status variable.
+
+*  Returned Value:
+*     The hash value.
+
+*  Notes:
+*     - This function attempts to execute even if an error has occurred.
+*/
+
+/* Local Variables: */
+   size_t i;                  /* Index of next character */
+   unsigned int result;       /* Returned value */
+
+/* Combine the characters. */
+   result = 2166136261U;
+   for( i = 0; i < nc; i++ ) {
+      result ^= (unsigned char) name[ i ];
+      result *= 16777619U;
+   }
+
+/* Return the result. */
+   return result;
+}
+
 static void InitXmlAttribute( AstXmlAttribute *new, int type, const char *name,
                               const char *value, const char *prefix, int *status ){
 /*
@@ -4378,9 +4618,10 @@ static void InitXmlAttribute( AstXmlAttribute *new, int type, const char *name,
 
 /* Local Variables: */
    const char *colon;         /* Pointer to colon within supplied name */
-   char *newname;             /* Pointer to name string (no prefix) */
-   char *newpref;             /* Pointer to name string */
-   int nc;                    /* Length of prefix string */
+   char *newname;             /* Pointer to shared name string */
+   char *newpref;             /* Pointer to shared prefix string */
+   size_t nc;                 /* Length of name string */
+   size_t npref;              /* Length of prefix string */
 
 /* Check the global error status. */
    if( !astOK ) return;
@@ -4398,44 +4639,32 @@ static void InitXmlAttribute( AstXmlAttribute *new, int type, const char *name,
 
 /* If no prefix was supplied, extract any prefix from the start of the
    supplied name. */
-   newname = (char *) name;
-   newpref = (char *) prefix;
-   colon = NULL;
+   nc = strlen( name );
+   npref = prefix ? strlen( prefix ) : 0;
 
    if( !prefix || astChrLen( prefix ) == 0 ){
       colon = strchr( name, ':' );
       if( colon ) {
-         nc = colon - name;
-         newpref = astStore( NULL, name, nc + 1 );
-         newpref[ nc ] = 0;
-
-         nc = strlen( name ) - ( colon - name ) - 1;
-         newname = astStore( NULL, colon + 1, nc + 1 );
-         newname[ nc ] = 0;
+         prefix = name;
+         npref = colon - name;
+         name = colon + 1;
+         nc -= npref + 1;
       }
    }
 
-/* Check the supplied name and prefix are valid XML 'names'. */
-   CheckName( newname, "attribute", "InitXmlAttribute", 0, status );
-   CheckName( newpref, "attribute", "InitXmlAttribute", 1, status );
+/* Get shared copies of the name and prefix, checking they are valid XML
+   'names'. */
+   newname = InternName( name, nc, "attribute", "InitXmlAttribute", status );
+   newpref = ( npref > 0 ) ? InternName( prefix, npref, "attribute",
+                                         "InitXmlAttribute", status ) : NULL;
 
 /* Initialise the parent XmlObject component. */
    InitXmlObject( (AstXmlObject *) new, type, status );
 
 /* Initialise the items specific to this class of structure. */
-   new->name = astStore( NULL, newname, strlen( newname ) + 1 );
+   new->name = newname;
    new->value = astStore( NULL, value, strlen( value ) + 1 );
-   new->prefix = NULL;
-   if( newpref ) {
-      nc = strlen( newpref );
-      if( nc > 0 ) new->prefix = astStore( NULL, newpref, nc + 1 );
-   }
-
-/* Free any name and prefix extracted from the supplied name string */
-   if( colon ) {
-      newname = astFree( newname );
-      newpref = astFree( newpref );
-   }
+   new->prefix = newpref;
 }
 
 static void InitXmlCDataSection( AstXmlCDataSection *new, int type,
@@ -4859,9 +5088,10 @@ static void InitXmlElement( AstXmlElement *new, int type, const char *name,
 
 /* Local Variables: */
    const char *colon;         /* Pointer to colon within supplied name */
-   char *newname;             /* Pointer to name string (no prefix) */
-   char *newpref;             /* Pointer to name string */
-   int nc;                    /* Length of prefix string */
+   char *newname;             /* Pointer to shared name string */
+   char *newpref;             /* Pointer to shared prefix string */
+   size_t nc;                 /* Length of name string */
+   size_t npref;              /* Length of prefix string */
 
 /* Check the global error status. */
    if( !astOK ) return;
@@ -4878,52 +5108,41 @@ static void InitXmlElement( AstXmlElement *new, int type, const char *name,
 
 /* If no prefix was supplied, extract any prefix from the start of the
    supplied name. */
-   newname = (char *) name;
-   newpref = (char *) prefix;
-   colon = NULL;
+   nc = strlen( name );
+   npref = prefix ? strlen( prefix ) : 0;
 
    if( !prefix || astChrLen( prefix ) == 0 ){
       colon = strchr( name, ':' );
       if( colon ) {
-         nc = colon - name;
-         newpref = astStore( NULL, name, nc + 1 );
-         newpref[ nc ] = 0;
-
-         nc = strlen( name ) - ( colon - name ) - 1;
-         newname = astStore( NULL, colon + 1, nc + 1 );
-         newname[ nc ] = 0;
+         prefix = name;
+         npref = colon - name;
+         name = colon + 1;
+         nc -= npref + 1;
       }
    }
 
-/* Check the supplied name and prefix are valid XML 'names'. */
-   CheckName( newname, "element", "InitXmlElement", 0, status );
-   CheckName( newpref, "element", "InitXmlElement", 1, status );
+/* Get shared copies of the name and prefix, checking they are valid XML
+   'names'. */
+   newname = InternName( name, nc, "element", "InitXmlElement", status );
+   newpref = ( npref > 0 ) ? InternName( prefix, npref, "element",
+                                         "InitXmlElement", status ) : NULL;
 
 /* Initialise the parent XmlObject component. */
    InitXmlObject( (AstXmlObject *) new, type, status );
 
 /* Initialise the items specific to this class of structure. */
-   new->name = astStore( NULL, newname, strlen( newname ) + 1 );
+   new->name = newname;
    new->attrs = NULL;
    new->nattr = 0;
+   new->attrmask = 0;
    new->items = NULL;
    new->nitem = 0;
+   new->nskip = 0;
    new->defns = NULL;
    new->nsprefs = NULL;
    new->nnspref = 0;
    new->complete = 0;
-
-   new->prefix = NULL;
-   if( newpref ) {
-      nc = strlen( newpref );
-      if( nc > 0 ) new->prefix = astStore( NULL, newpref, nc + 1 );
-   }
-
-/* Free any name and prefix extracted from the supplied name string */
-   if( colon ) {
-      newname = astFree( newname );
-      newpref = astFree( newpref );
-   }
+   new->prefix = newpref;
 }
 
 static void InitXmlNamespace( AstXmlNamespace *new, int type, const char *prefix,
@@ -5157,6 +5376,151 @@ static void InitXmlPrologue( AstXmlPrologue *new, int type, int *status ){
    new->nmisc2 = 0;
 }
 
+static char *InternName( const char *name, size_t nc, const char *noun,
+                         const char *method, int *status ){
+/*
+*  Name:
+*     InternName
+
+*  Purpose:
+*     Return a shared copy of an element or attribute name.
+
+*  Type:
+*     Private function.
+
+*  Synopsis:
+*     #include "xml.h"
+*     char *InternName( const char *name, size_t nc, const char *noun,
+*                       const char *method, int *status )
+
+*  Description:
+*     This function returns a pointer to a copy of the supplied element
+*     or attribute name (or namespace prefix) which is shared by all
+*     XmlObjects that use the same name. The copy is created the first
+*     time the name is used, once the name has been checked to be a legal
+*     XML name. The reference count for the name is incremented, and
+*     ReleaseName should be called when the returned pointer is no longer
+*     needed. The hash value for the name may be obtained from the
+*     returned pointer using the NAME_HASH macro.
+
+*  Parameters:
+*     name
+*        Pointer to the start of the name. It need not be null-terminated.
+*     nc
+*        The number of characters in the name.
+*     noun
+*        A word to describe the object which the name applies to - for
+*        use in error messages only.
+*     method
+*        The name of the calling method - for use in error messages only.
+*     status
+*        Pointer to the inherited status variable.
+
+*  Returned Value:
+*     Pointer to the shared copy of the name. The string must not be
+*     modified or freed, other than by calling ReleaseName.
+
+*  Notes:
+*     - NULL is returned if this function is called with the global error
+*     status set, or if it should fail for any reason.
+*/
+
+/* Local Variables: */
+   XmlName **newtable;        /* Pointer to the enlarged hash table */
+   XmlName *entry;            /* Pointer to an existing table entry */
+   XmlName *new;              /* Pointer to a new table entry */
+   XmlName *next;             /* Pointer to the next entry in a bucket */
+   char *result;              /* Returned pointer */
+   int i;                     /* Bucket index */
+   int newsize;               /* Number of buckets in enlarged table */
+   unsigned int hash;         /* Hash value for the name */
+
+/* Initialise */
+   result = NULL;
+
+/* Check the global error status. */
+   if( !astOK ) return result;
+
+/* Return the existing copy of the name if there is one, incrementing
+   its reference count. */
+   hash = HashName( name, nc, status );
+   LOCK_MUTEX2
+   entry = FindName( name, nc, hash, status );
+   if( entry && !entry->nref++ ) name_unused--;
+   UNLOCK_MUTEX2
+   if( entry ) return entry->text;
+
+/* Otherwise, create a new table entry holding a copy of the name. The
+   table is shared by all threads and is not freed when an XmlObject is
+   deleted, so allocate the memory as permanent. Check that the name is a
+   legal XML name. */
+   astBeginPM;
+   new = astMalloc( sizeof( XmlName ) + nc );
+   astEndPM;
+   if( astOK ) {
+      memcpy( new->text, name, nc );
+      new->text[ nc ] = 0;
+      new->hash = hash;
+      new->nref = 1;
+      CheckName( new->text, noun, method, 0, status );
+   }
+
+/* Add the new entry to the table, unless another thread has added the
+   same name in the meantime. Double the number of buckets in the table
+   whenever the number of names reaches it. */
+   if( astOK ) {
+      LOCK_MUTEX2
+      entry = FindName( name, nc, hash, status );
+      if( entry ) {
+         if( !entry->nref++ ) name_unused--;
+         result = entry->text;
+
+      } else {
+         if( name_count >= name_tabsize ) {
+            newsize = name_tabsize ? 2*name_tabsize : 64;
+            astBeginPM;
+            newtable = astCalloc( newsize, sizeof( XmlName * ) );
+            astEndPM;
+            if( astOK ) {
+               for( i = 0; i < name_tabsize; i++ ) {
+                  entry = name_table[ i ];
+                  while( entry ) {
+                     next = entry->next;
+                     entry->next = newtable[ entry->hash & ( newsize - 1 ) ];
+                     newtable[ entry->hash & ( newsize - 1 ) ] = entry;
+                     entry = next;
+                  }
+               }
+               astBeginPM;
+               name_table = astFree( name_table );
+               astEndPM;
+               name_table = newtable;
+               name_tabsize = newsize;
+            }
+         }
+
+         if( astOK ) {
+            new->next = name_table[ hash & ( name_tabsize - 1 ) ];
+            name_table[ hash & ( name_tabsize - 1 ) ] = new;
+            name_count++;
+            result = new->text;
+            new = NULL;
+         }
+      }
+      UNLOCK_MUTEX2
+   }
+
+/* Free the new entry if it was not used. */
+   if( new ) {
+      astBeginPM;
+      new = astFree( new );
+      astEndPM;
+   }
+
+/* Return the result. */
+   return result;
+}
+
 static int MatchName( AstXmlElement *this, const char *name, int *status ){
 /*
 *  Name:
@@ -5192,10 +5556,8 @@ static int MatchName( AstXmlElement *this, const char *name, int *status ){
 
 /* Local Variables: */
    const char *colon;         /* Pointer to colon within supplied name */
-   char *newname;             /* Pointer to name string (no prefix) */
-   char *newpref;             /* Pointer to name string */
-   int nc;                    /* Length of prefix string */
    int result;                /* Returned value */
+   size_t nc;                 /* Length of prefix string */
 
 /* Initialise */
    result = 0;
@@ -5203,49 +5565,21 @@ static int MatchName( AstXmlElement *this, const char *name, int *status ){
 /* Check the global error status. */
    if( !astOK ) return result;
 
-/* Extract any prefix from the start of the supplied name. */
-   newpref = NULL;
-   newname = (char *) name;
+/* Compare any prefix at the start of the supplied name with the prefix
+   of the element, and then skip over it. */
    colon = strchr( name, ':' );
    if( colon ) {
       nc = colon - name;
-      newpref = astStore( NULL, name, nc + 1 );
-      newpref[ nc ] = 0;
-
-      nc = strlen( name ) - ( colon - name ) - 1;
-      newname = astStore( NULL, colon + 1, nc + 1 );
-      newname[ nc ] = 0;
-   }
-
-/* Compare the prefix. */
-   if( newpref && this->prefix ) {
-      result = !strcmp( newpref, this->prefix );
-
-   } else if( !newpref && !this->prefix ) {
-      result = 1;
+      result = ( this->prefix && !strncmp( name, this->prefix, nc ) &&
+                 !this->prefix[ nc ] );
+      name = colon + 1;
 
    } else {
-      result = 0;
+      result = !this->prefix;
    }
 
 /* If the prefixes matches, compare the names */
-   if( result ) {
-      if( newname && this->name ) {
-         result = !strcmp( newname, this->name );
-
-      } else if( !newname && !this->name ) {
-         result = 1;
-
-      } else {
-         result = 0;
-      }
-   }
-
-/* Free any name and prefix extracted from the supplied name string */
-   if( colon ) {
-      newname = astFree( newname );
-      newpref = astFree( newpref );
-   }
+   if( result ) result = ( this->name && !strcmp( name, this->name ) );
 
 /* Return the result. */
    return result;
@@ -5490,6 +5824,244 @@ static AstXmlPrologue *NewPrologue( AstXmlDocument *doc, int *status ){
 
 }
 
+static void PurgeNames( int *status ){
+/*
+*  Name:
+*     PurgeNames
+
+*  Purpose:
+*     Remove unused names from the table of interned names.
+
+*  Type:
+*     Private function.
+
+*  Synopsis:
+*     #include "xml.h"
+*     void PurgeNames( int *status )
+
+*  Description:
+*     This function removes all names that are not used by any XmlObject
+*     from the table of interned element and attribute names, and frees
+*     them. It should only be called while the mutex protecting the table
+*     is locked.
+
+*  Parameters:
+*     status
+*        Pointer to the inherited status variable.
+
+*  Notes:
+*     - This function attempts to execute even if an error has occurred.
+*/
+
+/* Local Variables: */
+   XmlName **prev;            /* Address of pointer to current entry */
+   XmlName *entry;            /* Pointer to current entry */
+   int i;                     /* Bucket index */
+
+/* Check each bucket in turn, unlinking and freeing any unused names. */
+   astBeginPM;
+   for( i = 0; i < name_tabsize; i++ ) {
+      prev = name_table + i;
+      while( ( entry = *prev ) ) {
+         if( entry->nref == 0 ) {
+            *prev = entry->next;
+            entry = astFree( entry );
+            name_count--;
+         } else {
+            prev = &( entry->next );
+         }
+      }
+   }
+   astEndPM;
+   name_unused = 0;
+}
+
+static char *ReleaseName( char *name, int *status ){
+/*
+*  Name:
+*     ReleaseName
+
+*  Purpose:
+*     Release a shared copy of an element or attribute name.
+
+*  Type:
+*     Private function.
+
+*  Synopsis:
+*     #include "xml.h"
+*     char *ReleaseName( char *name, int *status )
+
+*  Description:
+*     This function decrements the reference count for a name returned
+*     by InternName. If the name is no longer used by any XmlObject it is
+*     retained for re-use, but all such unused names are removed from the
+*     table (see PurgeNames) if there are now too many of them.
+
+*  Parameters:
+*     name
+*        Pointer returned by InternName, or NULL.
+*     status
+*        Pointer to the inherited status variable.
+
+*  Returned Value:
+*     A NULL pointer.
+
+*  Notes:
+*     - This function attempts to execute even if an error has occurred.
+*/
+
+/* Local Variables: */
+   XmlName *entry;            /* Pointer to the table entry */
+
+/* Check a name was supplied. */
+   if( name ) {
+      entry = (XmlName *) ( name - offsetof( XmlName, text ) );
+
+/* Decrement the reference count. If the name is now unused, purge all
+   unused names if there are too many of them. */
+      LOCK_MUTEX2
+      if( --entry->nref == 0 ) {
+         name_unused++;
+         if( name_unused > NAME_MAXUNUSED && 2*name_unused > name_count ) {
+            PurgeNames( status );
+         }
+      }
+      UNLOCK_MUTEX2
+   }
+
+/* Return a NULL pointer. */
+   return NULL;
+}
+
+static char *ReleaseText( char *text, char **pool, int *status ){
+/*
+*  Name:
+*     ReleaseText
+
+*  Purpose:
+*     Return a text buffer to a pool of spare buffers.
+
+*  Type:
+*     Private function.
+
+*  Synopsis:
+*     #include "xml.h"
+*     char *ReleaseText( char *text, char **pool, int *status )
+
+*  Description:
+*     This function stores the supplied text buffer in the first unused
+*     slot of the supplied pool, so that it can be re-used by a later
+*     call to AppendText. If the pool is full, the buffer is freed.
+
+*  Parameters:
+*     text
+*        Pointer to a dynamic string, or NULL.
+*     pool
+*        Pointer to an array of AST__XML_NPOOL pointers to spare buffers.
+*     status
+*        Pointer to the inherited status variable.
+
+*  Returned Value:
+*     A NULL pointer.
+
+*  Notes:
+*     - This function attempts to execute even if an error has occurred.
+*/
+
+/* Local Variables: */
+   int i;                     /* Index into pool */
+
+/* Check a buffer was supplied. */
+   if( text ) {
+
+/* Store it in the first unused slot in the pool. */
+      for( i = 0; i < AST__XML_NPOOL; i++ ) {
+         if( !pool[ i ] ) {
+            pool[ i ] = text;
+            text = NULL;
+            break;
+         }
+      }
+
+/* Free it if the pool is full. */
+      text = astFree( text );
+   }
+
+/* Return a NULL pointer. */
+   return NULL;
+}
+
+static void RemoveContent( AstXmlElement *this, int item, int *status ){
+/*
+*  Name:
+*     RemoveContent
+
+*  Purpose:
+*     Remove a content item from the list of items in an XmlElement.
+
+*  Type:
+*     Private function.
+
+*  Synopsis:
+*     #include "xml.h"
+*     void RemoveContent( AstXmlElement *this, int item, int *status )
+
+*  Description:
+*     This function removes a specified entry from the list of content
+*     items in an XmlElement, shuffling the remaining entries to close up
+*     the gap. The shorter of the two parts of the list on either side of
+*     the removed item is moved. If this is the part before the removed
+*     item, the start of the list is moved forward by one slot, leaving an
+*     unused slot at the start of the allocated memory. This means that
+*     repeatedly removing the first item (as happens when the content of
+*     an element is read sequentially) does not require the whole list
+*     to be shuffled each time.
+
+*  Parameters:
+*     this
+*        The pointer to the element.
+*     item
+*        The zero-based index of the item to be removed. Must be in the
+*        range 0 to (nitem-1).
+*     status
+*        Pointer to the inherited status variable.
+
+*  Notes:
+*     - The parent pointer in the removed item is left unchanged.
+*     - This function attempts to execute even if an error has occurred.
+*/
+
+/* Local Variables: */
+   int nitem;                 /* Number of items in the element */
+
+/* Get the number of items in the element. */
+   nitem = this->nitem;
+
+/* If the item is in the first half of the list, shuffle the earlier items
+   up one slot and move the start of the list forward. */
+   if( item < nitem/2 ) {
+      memmove( this->items + 1, this->items,
+               item*sizeof( AstXmlContentItem * ) );
+      this->items[ 0 ] = NULL;
+      this->items++;
+      this->nskip++;
+
+/* Otherwise, shuffle the later items down one slot. */
+   } else {
+      memmove( this->items + item, this->items + item + 1,
+               ( nitem - item - 1 )*sizeof( AstXmlContentItem * ) );
+      this->items[ nitem - 1 ] = NULL;
+   }
+
+/* Decrement the number of items. If the list is now empty, move the start
+   of the list back to the start of the allocated memory. */
+   this->nitem = --nitem;
+   if( nitem == 0 ) {
+      this->items -= this->nskip;
+      this->nskip = 0;
+   }
+}
+
 static char *RemoveEscapes( const char *text, int *status ){
 /*
 *  Name:
@@ -5552,7 +6124,10 @@ static char *RemoveEscapes( const char *text, int *status ){
 
 /* If this character marks the start of a entity reference, replace it by
    the corresponding ascii character and shuffle the remaining text down. */
-         if( !strncmp( c, "&amp;", 5 ) ) {
+         if( *c != '&' ) {
+            rc = 0;
+
+         } else if( !strncmp( c, "&amp;", 5 ) ) {
             rc = '&';
             nc= 4;
 
@@ -5895,6 +6470,7 @@ int astXmlTrace( int show ){
 
 AstXmlElement *astXmlReadDocument_( AstXmlDocument **doc,
                                    int (*is_wanted)( AstXmlElement *, int * ),
+                                   void (*is_done)( AstXmlElement *, int * ),
                                    int skip, char (*source)( void *, int * ),
                                    void *data, int *status ){
 /*
@@ -5912,6 +6488,7 @@ AstXmlElement *astXmlReadDocument_( AstXmlDocument **doc,
 *     #include "xml.h"
 *     AstXmlElement *astXmlReadDocument( AstXmlDocument **doc,
 *                                       int (*is_wanted)( AstXmlElement *, int * ),
+*                                       void (*is_done)( AstXmlElement *, int * ),
 *                                       int skip, char (*source)( void *, int * ),
 *                                       void *data )
 
@@ -5949,6 +6526,13 @@ AstXmlElement *astXmlReadDocument_( AstXmlDocument **doc,
 *     source, once the contents of the first "interesting" element has been
 *     read.
 *
+*     The client may also supply an "is_done" function, which is called
+*     as soon as the end tag of each element within the interesting
+*     element has been read. This allows the client to process each
+*     element as it is completed, and to replace its content with
+*     something smaller, rather than waiting until the whole of the
+*     interesting element has been read.
+*
 *     The function thus returns a pointer to an XmlElement containing the
 *     entire contents of the first interesting element encountered in the
 *     source. This function can then be invoked again to read further
@@ -5984,6 +6568,15 @@ AstXmlElement *astXmlReadDocument_( AstXmlDocument **doc,
 *            1 : the element is definately of interest to the client so
 *                read its contents and return a pointer to it.
 *        If NULL is supplied, a value of "+1" is assumed.
+*     is_done
+*        Pointer to a function which is called when each element contained
+*        within the interesting element has been read completely (i.e.
+*        once its end tag has been read). It has a single argument which is
+*        a pointer to the completed XmlElement. It is called for the
+*        innermost elements first, and is not called for the interesting
+*        element itself. The function may change the content and
+*        attributes of the element, but should not delete it or remove
+*        it from its parent. May be NULL.
 *     skip
 *        Indicates if any uninteresting elements may proceed the first
 *        element of interest. If zero, then an error is reported if the
@@ -6018,17 +6611,26 @@ AstXmlElement *astXmlReadDocument_( AstXmlDocument **doc,
 
 /* Local Variables: */
    AstXmlElement *result;
+   char *pool[ AST__XML_NPOOL ];
+   int i;
 
 /* Check any supplied pointer is for an XmlDocument. */
    astXmlCheckDocument( *doc, 1 );
 
+/* Initialise the pool of spare text buffers used by ReadContent. */
+   for( i = 0; i < AST__XML_NPOOL; i++ ) pool[ i ] = NULL;
+
 /* Read and parse the source text. Indicate that the element being read
    *may* contain items of interest to the client. Surround with a mutex
    since the supplied functions may not be thread-safe. */
    LOCK_MUTEX1;
-   result = ReadContent( doc, -1, is_wanted, skip, source, data, 0, status );
+   result = ReadContent( doc, -1, is_wanted, is_done, skip, source, data, 0,
+                         pool, status );
    UNLOCK_MUTEX1;
 
+/* Free the spare text buffers. */
+   for( i = 0; i < AST__XML_NPOOL; i++ ) pool[ i ] = astFree( pool[ i ] );
+
 /* Return the result. */
    return result;
 }
@@ -6036,8 +6638,10 @@ AstXmlElement *astXmlReadDocument_( AstXmlDocument **doc,
 
 static AstXmlElement *ReadContent( AstXmlDocument **doc, int wanted,
                                    int (*is_wanted)( AstXmlElement *, int * ),
+                                   void (*is_done)( AstXmlElement *, int * ),
                                    int skip, char (*source)( void *, int * ),
-                                   void *data, int depth, int *status ){
+                                   void *data, int depth, char **pool,
+                                   int *status ){
 /*
 *  Name:
 *     ReadContent
@@ -6052,8 +6656,10 @@ static AstXmlElement *ReadContent( AstXmlDocument **doc, int wanted,
 *     #include "xml.h"
 *     AstXmlElement *ReadContent( AstXmlDocument **doc, int wanted,
 *                                 int (*is_wanted)( AstXmlElement *, int * ),
+*                                 void (*is_done)( AstXmlElement *, int * ),
 *                                 int skip, char (*source)( void *, int * ),
-*                                 void *data, int depth, int *status )
+*                                 void *data, int depth, char **pool,
+*                                 int *status )
 
 *  Description:
 *     This function reads and parses text from an XML source. The text is
@@ -6106,6 +6712,15 @@ static AstXmlElement *ReadContent( AstXmlDocument **doc, int wanted,
 *            1 : the element is definately of interest to the client so
 *                read its contents and return a pointer to it.
 *        If NULL is supplied, a value of "+1" is assumed.
+*     is_done
+*        Pointer to a function which is called when each element contained
+*        within the interesting element has been read completely (i.e.
+*        once its end tag has been read). It has a single argument which is
+*        a pointer to the completed XmlElement. It is called for the
+*        innermost elements first, and is not called for the interesting
+*        element itself. The function may change the content and
+*        attributes of the element, but should not delete it or remove
+*        it from its parent. May be NULL.
 *     skip
 *        Indicates if any uninteresting elements may proceed the first
 *        element of interest. If zero, then an error is reported if the
@@ -6124,6 +6739,11 @@ static AstXmlElement *ReadContent( AstXmlDocument **doc, int wanted,
 *        Depth of nesting (i.e. zero if this function was invoked from
 *        astXmlReadDocument, and a positive value if it was invoked
 *        recursively from within itself).
+*     pool
+*        Pointer to an array of AST__XML_NPOOL pointers used to hold
+*        spare memory for accumulating text (see AppendText). The same
+*        array should be used for all invocations made while reading a
+*        document.
 *     status
 *        Pointer to the inherited status variable.
 
@@ -6269,9 +6889,9 @@ static AstXmlElement *ReadContent( AstXmlDocument **doc, int wanted,
 
 /* Save text which is not character data for use in error messages. */
       if( state < 2 ) {
-         if( msg ) msg = astFree( msg );
+         if( msg ) msg = ReleaseText( msg, pool, status );
       } else {
-         msg = AppendChar( msg, &ncmsg, c, status );
+         msg = AppendText( msg, &ncmsg, c, pool, status );
       }
 
 /* State 0: Use the first character to decide what sort of content item
@@ -6279,9 +6899,9 @@ static AstXmlElement *ReadContent( AstXmlDocument **doc, int wanted,
       if( state == 0 ) {
          if( c != '<' ) {
             state = 1;
-            text1 = AppendChar( text1, &nc1, c, status );
+            text1 = AppendText( text1, &nc1, c, pool, status );
          } else {
-            msg = AppendChar( msg, &ncmsg, '<', status );
+            msg = AppendText( msg, &ncmsg, '<', pool, status );
             state = 2;
          }
 
@@ -6290,16 +6910,16 @@ static AstXmlElement *ReadContent( AstXmlDocument **doc, int wanted,
    the parent if required and we continue to state 2.*/
       } else if( state == 1 ) {
          if( c != '<' ) {
-            text1 = AppendChar( text1, &nc1, c, status );
+            text1 = AppendText( text1, &nc1, c, pool, status );
          } else {
-            msg = AppendChar( msg, &ncmsg, '<', status );
+            msg = AppendText( msg, &ncmsg, '<', pool, status );
             if( text1 ){
 
 /* If we have a parent element, just add it to the element. */
                if( parent ) {
                   if( wanted > 0 ) {
-                     text4 = RemoveEscapes( text1, status );
-                     astXmlAddCharData( (AstXmlParent *) parent, 0, text4 );
+                     text4 = strchr( text1, '&' ) ? RemoveEscapes( text1, status ) : NULL;
+                     astXmlAddCharData( (AstXmlParent *) parent, 0, text4 ? text4 : text1 );
                      text4 = astFree( text4 );
 
 
@@ -6337,7 +6957,7 @@ static AstXmlElement *ReadContent( AstXmlDocument **doc, int wanted,
                   text4 = astFree( text4 );
                }
 
-               text1 = astFree( text1 );
+               text1 = ReleaseText( text1, pool, status );
             }
             state = 2;
          }
@@ -6374,7 +6994,7 @@ static AstXmlElement *ReadContent( AstXmlDocument **doc, int wanted,
    to "text1". */
          } else {
             state = 6;
-            text1 = AppendChar( text1, &nc1, c, status );
+            text1 = AppendText( text1, &nc1, c, pool, status );
          }
 
 /* State 3: We are reading the initial text following the opening "<?" string
@@ -6387,7 +7007,7 @@ static AstXmlElement *ReadContent( AstXmlDocument **doc, int wanted,
          } else if( isspace( c ) ) {
             state = 7;
          } else {
-            text1 = AppendChar( text1, &nc1, c, status );
+            text1 = AppendText( text1, &nc1, c, pool, status );
          }
 
 /* State 4: We are using the characters following the opening "<!" text to
@@ -6418,7 +7038,7 @@ static AstXmlElement *ReadContent( AstXmlDocument **doc, int wanted,
          if( c == '>' ) {
             state = 101;
          } else {
-            text1 = AppendChar( text1, &nc1, c, status );
+            text1 = AppendText( text1, &nc1, c, pool, status );
          }
 
 /* State 6: We are looking for the (prefix:)name combination at the start of
@@ -6429,7 +7049,7 @@ static AstXmlElement *ReadContent( AstXmlDocument **doc, int wanted,
          } else if( isspace( c ) ) {
             state = 104;
          } else if( c != '/' ){
-            text1 = AppendChar( text1, &nc1, c, status );
+            text1 = AppendText( text1, &nc1, c, pool, status );
          }
 
 /* State 7: We are reading the remaining text in a PI tag following the target
@@ -6439,7 +7059,7 @@ static AstXmlElement *ReadContent( AstXmlDocument **doc, int wanted,
             if( text2 ) text2[ --nc2 ] = 0;
             state = 100;
          } else if( text2 || !isspace( c ) ) {
-            text2 = AppendChar( text2, &nc2, c, status );
+            text2 = AppendText( text2, &nc2, c, pool, status );
          }
 
 /* State 8: We are looking for the start of the text within a comment tag. */
@@ -6463,7 +7083,7 @@ static AstXmlElement *ReadContent( AstXmlDocument **doc, int wanted,
          if( c == '[' ) {
             if( !strcmp( text1, "<![CDATA" ) ) {
                state = 11;
-               text1 = astFree( text1 );
+               text1 = ReleaseText( text1, pool, status );
             } else {
                if( parent ) {
                   astError( AST__XMLWF, "astRead(XmlChan): Illegal XML tag "
@@ -6473,12 +7093,12 @@ static AstXmlElement *ReadContent( AstXmlDocument **doc, int wanted,
                   astError( AST__XMLWF, "astRead(XmlChan): Illegal XML tag "
                             "starting with \"%s%c...\" encountered.", status, text1, c );
                }
-               text1 = astFree( text1 );
+               text1 = ReleaseText( text1, pool, status );
                break;
             }
 
          } else if( nc1 < 10 ) {
-            text1 = AppendChar( text1, &nc1, c, status );
+            text1 = AppendText( text1, &nc1, c, pool, status );
 
          } else {
             if( parent ) {
@@ -6489,7 +7109,7 @@ static AstXmlElement *ReadContent( AstXmlDocument **doc, int wanted,
                astError( AST__XMLWF, "astRead(XmlChan): Illegal XML tag "
                          "starting with \"%s%c...\" encountered.", status, text1, c );
             }
-            text1 = astFree( text1 );
+            text1 = ReleaseText( text1, pool, status );
             break;
          }
 
@@ -6502,7 +7122,7 @@ static AstXmlElement *ReadContent( AstXmlDocument **doc, int wanted,
             text1[ nc1 - 2 ] = 0;
             state = 105;
          } else {
-            text1 = AppendChar( text1, &nc1, c, status );
+            text1 = AppendText( text1, &nc1, c, pool, status );
          }
 
 /* State 11: We are reading the remaining text in a CDATA tag. */
@@ -6511,7 +7131,7 @@ static AstXmlElement *ReadContent( AstXmlDocument **doc, int wanted,
             text1[ nc1 - 2 ] = 0;
             state = 106;
          } else {
-            text1 = AppendChar( text1, &nc1, c, status );
+            text1 = AppendText( text1, &nc1, c, pool, status );
          }
 
 /* State 12: We are looking for an equals sign marking the end of an
@@ -6540,7 +7160,7 @@ static AstXmlElement *ReadContent( AstXmlDocument **doc, int wanted,
             }
 
          } else if( text1 || !isspace( c ) ) {
-            if( c != '/' ) text1 = AppendChar( text1, &nc1, c, status );
+            if( c != '/' ) text1 = AppendText( text1, &nc1, c, pool, status );
          }
 
 /* State 13: We are looking for a '"' or ''' marking the start of an attribute
@@ -6570,7 +7190,7 @@ static AstXmlElement *ReadContent( AstXmlDocument **doc, int wanted,
             break;
 
          } else {
-            text2 = AppendChar( text2, &nc2, c, status );
+            text2 = AppendText( text2, &nc2, c, pool, status );
          }
 
 /* State 15: We are looking for a ''' marking the end of an attribute value
@@ -6585,7 +7205,7 @@ static AstXmlElement *ReadContent( AstXmlDocument **doc, int wanted,
             break;
 
          } else {
-            text2 = AppendChar( text2, &nc2, c, status );
+            text2 = AppendText( text2, &nc2, c, pool, status );
          }
 
 /* State 16: We are looking for the end of a DOCTYPE string. */
@@ -6593,7 +7213,7 @@ static AstXmlElement *ReadContent( AstXmlDocument **doc, int wanted,
          if( isspace( c ) ) {
             if( !strcmp( text1, "<!DOCTYPE" ) ) {
                state = 17;
-               text1 = astFree( text1 );
+               text1 = ReleaseText( text1, pool, status );
             } else {
                if( parent ) {
                   astError( AST__XMLWF, "astRead(XmlChan): Illegal XML tag "
@@ -6603,12 +7223,12 @@ static AstXmlElement *ReadContent( AstXmlDocument **doc, int wanted,
                   astError( AST__XMLWF, "astRead(XmlChan): Illegal XML tag "
                             "starting with \"%s%c...\" encountered.", status, text1, c );
                }
-               text1 = astFree( text1 );
+               text1 = ReleaseText( text1, pool, status );
                break;
             }
 
          } else if( nc1 < 15 ) {
-            text1 = AppendChar( text1, &nc1, c, status );
+            text1 = AppendText( text1, &nc1, c, pool, status );
 
          } else {
             if( parent ) {
@@ -6619,14 +7239,14 @@ static AstXmlElement *ReadContent( AstXmlDocument **doc, int wanted,
                astError( AST__XMLWF, "astRead(XmlChan): Illegal XML tag "
                          "starting with \"%s%c...\" encountered.", status, text1, c );
             }
-            text1 = astFree( text1 );
+            text1 = ReleaseText( text1, pool, status );
             break;
          }
 
 /* State 17: We are looking for the start of a DOCTYPE name string. */
       } else if( state == 17 ) {
          if( !isspace( c ) ) {
-            text1 = AppendChar( text1, &nc1, c, status );
+            text1 = AppendText( text1, &nc1, c, pool, status );
             state = 18;
          }
 
@@ -6637,7 +7257,7 @@ static AstXmlElement *ReadContent( AstXmlDocument **doc, int wanted,
          } else if( c == '>' ) {
             state = 109;
          } else {
-            text1 = AppendChar( text1, &nc1, c, status );
+            text1 = AppendText( text1, &nc1, c, pool, status );
          }
 
 /* State 19: We are looking for the start of a string following a DOCTYPE
@@ -6650,7 +7270,7 @@ static AstXmlElement *ReadContent( AstXmlDocument **doc, int wanted,
                state = 109;
             } else {
                state = 21;
-               text2 = AppendChar( text2, &nc2, c, status );
+               text2 = AppendText( text2, &nc2, c, pool, status );
             }
          }
 
@@ -6658,7 +7278,7 @@ static AstXmlElement *ReadContent( AstXmlDocument **doc, int wanted,
    markup of a DOCTYPE element. Avoid the contents of quoted strings (such
    as #FIXED attribute values). */
       } else if( state == 20 ) {
-         text3 = AppendChar( text3, &nc3, c, status );
+         text3 = AppendText( text3, &nc3, c, pool, status );
          if( c == '\'' ) {
             if( quoted == '\'' ) {
                quoted = 0;
@@ -6685,7 +7305,7 @@ static AstXmlElement *ReadContent( AstXmlDocument **doc, int wanted,
          } else if( c == '>' ) {
             state = 109;
          } else {
-            text2 = AppendChar( text2, &nc2, c, status );
+            text2 = AppendText( text2, &nc2, c, pool, status );
          }
 
 /* State 22: We are looking for the ">" at the end of a DOCTYPE. */
@@ -6760,8 +7380,8 @@ static AstXmlElement *ReadContent( AstXmlDocument **doc, int wanted,
 
                }
             }
-            text1 = astFree( text1 );
-            if( text2 ) text2 = astFree( text2 );
+            text1 = ReleaseText( text1, pool, status );
+            if( text2 ) text2 = ReleaseText( text2, pool, status );
          } else {
             astError( AST__XMLWF, "astRead(XmlChan): Illegal XML tag \"%s\" "
                       "encountered.", status, msg );
@@ -6796,7 +7416,7 @@ static AstXmlElement *ReadContent( AstXmlDocument **doc, int wanted,
                          "\"%s\" encountered.", status, msg );
             }
 
-            text1 = astFree( text1 );
+            text1 = ReleaseText( text1, pool, status );
 
          } else {
             astError( AST__XMLWF, "astRead(XmlChan): Illegal XML tag \"%s\" "
@@ -6824,7 +7444,7 @@ static AstXmlElement *ReadContent( AstXmlDocument **doc, int wanted,
       } else if( state == 102 ) {
          if( text1 ){
             elem = astXmlAddElement( parent, text1, NULL );
-            text1 = astFree( text1 );
+            text1 = ReleaseText( text1, pool, status );
             state = 200;
 
          } else {
@@ -6841,7 +7461,7 @@ static AstXmlElement *ReadContent( AstXmlDocument **doc, int wanted,
          if( text1 ){
             elem = astXmlAddElement( parent, text1, NULL );
             elem->complete = 1;
-            text1 = astFree( text1 );
+            text1 = ReleaseText( text1, pool, status );
             state = 200;
 
          } else {
@@ -6857,7 +7477,7 @@ static AstXmlElement *ReadContent( AstXmlDocument **doc, int wanted,
       } else if( state == 104 ) {
          if( text1 ){
             elem = astXmlAddElement( parent, text1, NULL );
-            text1 = astFree( text1 );
+            text1 = ReleaseText( text1, pool, status );
             state = 12;
 
          } else {
@@ -6899,7 +7519,7 @@ static AstXmlElement *ReadContent( AstXmlDocument **doc, int wanted,
                astXmlAddComment( (AstXmlParent *) *doc, where, text1 );
             }
 
-            text1 = astFree( text1 );
+            text1 = ReleaseText( text1, pool, status );
 
          } else {
             astError( AST__XMLWF, "astRead(XmlChan): Illegal XML tag \"%s\" "
@@ -6925,7 +7545,7 @@ static AstXmlElement *ReadContent( AstXmlDocument **doc, int wanted,
                }
                break;
             }
-            text1 = astFree( text1 );
+            text1 = ReleaseText( text1, pool, status );
          } else {
             astError( AST__XMLWF, "astRead(XmlChan): Illegal XML tag \"%s\" "
                       "encountered.", status, msg );
@@ -6951,13 +7571,13 @@ static AstXmlElement *ReadContent( AstXmlDocument **doc, int wanted,
                astXmlAddURI( elem, text1+6, text2 );
 
             } else {
-               text4 = RemoveEscapes( text2, status );
-               astXmlAddAttr( elem, text1, text4, NULL );
+               text4 = ( text2 && strchr( text2, '&' ) ) ? RemoveEscapes( text2, status ) : NULL;
+               astXmlAddAttr( elem, text1, text4 ? text4 : text2, NULL );
                text4 = astFree( text4 );
             }
 
-            text1 = astFree( text1 );
-            text2 = astFree( text2 );
+            text1 = ReleaseText( text1, pool, status );
+            text2 = ReleaseText( text2, pool, status );
 
          } else {
             astError( AST__XMLWF, "astRead(XmlChan): Illegal XML tag \"%s\" "
@@ -6994,9 +7614,9 @@ static AstXmlElement *ReadContent( AstXmlDocument **doc, int wanted,
 
          } else {
             astXmlSetDTDec( *doc, text1, text2, text3 );
-            text1 = astFree( text1 );
-            text2 = astFree( text2 );
-            text3 = astFree( text3 );
+            text1 = ReleaseText( text1, pool, status );
+            text2 = ReleaseText( text2, pool, status );
+            text3 = ReleaseText( text3, pool, status );
             state = 0;
          }
 
@@ -7058,8 +7678,8 @@ static AstXmlElement *ReadContent( AstXmlDocument **doc, int wanted,
 /* Read the contents of the new element from the source. If the client is
    interested in the element, the read contents will be added to the
    element, otherwise they will be discarded after being read. */
-         answer = ReadContent( doc, newwanted, is_wanted, skip, source,
-                               data, depth + 1, status );
+         answer = ReadContent( doc, newwanted, is_wanted, is_done, skip,
+                               source, data, depth + 1, pool, status );
 
 /* If the first interesting element was found inside "elem", then
    return it. If "elem" is not interesting and did not contain anything
@@ -7077,9 +7697,14 @@ static AstXmlElement *ReadContent( AstXmlDocument **doc, int wanted,
             elem = astXmlDelete( elem );
 
 /* Otherwise, "elem" itself is definitely of interest. If "elem" is
-   the first item of interest, return it. */
+   the first item of interest, return it. If it is contained within the
+   first item of interest, let the client process it now that it is
+   complete. */
          } else if( wanted < 0 ) {
             result = elem;
+
+         } else if( is_done && astOK ) {
+            (*is_done)( elem, status );
          }
 
 /* If we have an answer to return, leave the loop, otherwise re-instate the
@@ -7103,10 +7728,10 @@ static AstXmlElement *ReadContent( AstXmlDocument **doc, int wanted,
    }
 
 /* Free any dynamic strings */
-   text1 = astFree( text1 );
-   text2 = astFree( text2 );
-   text3 = astFree( text3 );
-   if( msg ) msg = astFree( msg );
+   text1 = ReleaseText( text1, pool, status );
+   text2 = ReleaseText( text2, pool, status );
+   text3 = ReleaseText( text3, pool, status );
+   if( msg ) msg = ReleaseText( msg, pool, status );
 
 /* Delete the returned object if an error occurred. */
    if( !astOK ) result = astXmlDelete( result );
@@ -130,12 +130,14 @@ struct AstXmlObject {
 
 /* XmlAttribute structure. */
 /* ----------------------- */
-/* Describes an XML attribute */
+/* Describes an XML attribute. Components marked "shared" point to
+   interned strings that are shared by all XmlObjects and must never be
+   freed. */
 struct AstXmlAttribute {
    AstXmlObject obj;          /* General information for this XmlObject */
-   char *name;                /* The name of the attribute */
+   char *name;                /* The name of the attribute (shared) */
    char *value;               /* Attribute value */
-   char *prefix;              /* Namespace prefix for this attribute */
+   char *prefix;              /* Namespace prefix for this attribute (shared) */
 };
 
 /* XmlNamespace structure. */
@@ -152,13 +154,15 @@ struct AstXmlNamespace {
 /* Describes an XML element */
 struct AstXmlElement {
    AstXmlObject obj;          /* General information for this XmlObject */
-   char *name;                /* The type (name) of the element */
+   char *name;                /* The type (name) of the element (shared) */
    AstXmlAttribute **attrs;   /* Ptr. to list of attributes of the element */
    int nattr;                 /* Number of attributes in the above list */
+   unsigned int attrmask;     /* Bit mask of attribute name hash values */
    AstXmlContentItem **items; /* Ptr. to list of items in the element's content */
    int nitem;                 /* Number of items in above list */
+   int nskip;                 /* No. of unused slots allocated before "items" */
    char *defns;               /* Default Namespace URI for element content */
-   char *prefix;              /* Namespace prefix for this element */
+   char *prefix;              /* Namespace prefix for this element (shared) */
    AstXmlNamespace **nsprefs; /* Ptr. to list of new Namespaces defined by this element */
    int nnspref;               /* Number of Namespaces in above list */
    int complete;              /* Have the contents of the element been read? */
@@ -277,7 +281,7 @@ AstXmlElement *astXmlAddElement_( AstXmlElement *, const char *, const char *, i
 AstXmlElement *astXmlCheckElement_( void *, int, int * );
 AstXmlParent *astXmlGetParent_( AstXmlObject *, int * );
 AstXmlObject *astXmlGetRoot_( AstXmlObject *, int * );
-AstXmlElement *astXmlReadDocument_( AstXmlDocument **, int (*)( AstXmlElement *, int * ), int, char (*)( void *, int * ), void *, int * );
+AstXmlElement *astXmlReadDocument_( AstXmlDocument **, int (*)( AstXmlElement *, int * ), void (*)( AstXmlElement *, int * ), int, char (*)( void *, int * ), void *, int * );
 AstXmlNamespace *astXmlCheckNamespace_( void *, int, int * );
 AstXmlObject *astXmlCopy_( AstXmlObject *, int * );
 AstXmlObject *astXmlCheckObject_( void *, int, int * );
@@ -374,7 +378,7 @@ int astXmlTrace_( int );
 #define astXmlRemoveItem(this) astXmlRemoveItem_(astXmlCheckContentItem(this,0),STATUS_PTR)
 #define astXmlRemoveAttr(this,name,prefix) astXmlRemoveAttr_(astXmlCheckElement(this,0),name,prefix,STATUS_PTR)
 #define astXmlRemoveURI(this,prefix) astXmlRemoveURI_(astXmlCheckElement(this,0),prefix,STATUS_PTR)
-#define astXmlReadDocument(doc,is_wanted,skip,source,data) astXmlReadDocument_(doc,is_wanted,skip,source,data,STATUS_PTR)
+#define astXmlReadDocument(doc,is_wanted,is_done,skip,source,data) astXmlReadDocument_(doc,is_wanted,is_done,skip,source,data,STATUS_PTR)
 #define astXmlInsertElement(this,elem) astXmlInsertElement_(astXmlCheckElement(this,0),astXmlCheckElement(elem,0),STATUS_PTR)
 #define astXmlPurge(this) astXmlPurge_(astXmlCheckParent(this,1),STATUS_PTR)
 #define astXmlSetXmlDec(this,text) astXmlSetXmlDec_(astXmlCheckDocument(this,0),text,STATUS_PTR)
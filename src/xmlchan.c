@@ -202,6 +202,12 @@ f     The XmlChan class does not define any new routines beyond those
 /* String used to represent AST__BAD externally. */
 #define BAD_STRING "<bad>"
 
+/* The number of items of content a container element must have before
+   the names of the values it holds are recorded in a KeyMap, so that
+   values that are not present can be identified without searching the
+   whole element. */
+#define MIN_VALNAMES 50
+
 /* Include files. */
 /* ============== */
 /* Interface definitions. */
@@ -433,11 +439,14 @@ static int Use( AstXmlChan *, int, int, int * );
 static int Ustrcmp( const char *, const char *, int * );
 static int Ustrncmp( const char *, const char *, size_t, int * );
 static int VertexReader( AstXmlChan *, AstXmlElement *, double *, double *, int * );
+static void CheckEmpty( AstXmlElement *, int * );
 static void ClearAttrib( AstObject *, const char *, int * );
 static void Copy( const AstObject *, AstObject *, int * );
 static void Delete( AstObject *, int * );
 static void Dump( AstObject *, AstChannel *, int * );
 static void FillAndLims( AstXmlChan *, AstXmlElement *, AstRegion *, int * );
+static void FreeDone( AstXmlChan *, int * );
+static void IsDone( AstXmlElement *, int * );
 static void OutputText( AstXmlChan *, const char *, int, int * );
 static void ReCentreAnc( AstRegion *, int, AstKeyMap **, int * );
 static void ReadClassData( AstChannel *, const char *, int * );
@@ -2655,6 +2664,96 @@ static AstRegion *BoxReader( AstXmlChan *this, AstXmlElement *elem,
    return new;
 }
 
+static void CheckEmpty( AstXmlElement *element, int *status ) {
+/*
+*  Name:
+*     CheckEmpty
+
+*  Purpose:
+*     Check that all the content of an element has been used.
+
+*  Type:
+*     Private function.
+
+*  Synopsis:
+*     #include "xmlchan.h"
+*     void CheckEmpty( AstXmlElement *element, int *status )
+
+*  Class Membership:
+*     XmlChan member function.
+
+*  Description:
+*     This function reports an error if the supplied element contains
+*     anything other than comments, "isa" elements, defaulted values and
+*     blank character data (all other contents should have been consumed
+*     by the process of reading the object described by the element).
+
+*  Parameters:
+*     element
+*        Pointer to the XML element to be checked.
+*     status
+*        Pointer to the inherited status variable.
+
+*/
+
+/* Local Variables: */
+   AstXmlContentItem *item; /* Item */
+   const char *def;         /* Pointer to default attribute value */
+   int i;                   /* Index of current item */
+   int nitem;               /* Number of items still in the element */
+
+/* Check the global error status. */
+   if ( !astOK ) return;
+
+/* Check each item of content in turn. */
+   nitem = astXmlGetNitem( element );
+   for( i = 0; i < nitem; i++ ) {
+      item = astXmlGetItem( element, i );
+      if( astXmlCheckType( item, AST__XMLELEM ) ) {
+
+/* See if this element represents a default value */
+         def = astXmlGetAttributeValue( item, DEFAULT );
+
+/* Default values and "isa" elements are OK. */
+         if( ( !def || strcmp( def, TRUE ) ) && astOK &&
+             strcmp( astXmlGetName( item ), ISA ) ) {
+
+/* Remove any "definedby" attribute (added by ReadClassData) so that it
+   does not appear in the error message. */
+            if( astXmlGetAttributeValue( item, DEFINEDBY ) ) {
+               astXmlRemoveAttr( item, DEFINEDBY, NULL );
+            }
+
+/* Report the error. */
+            if( astOK ) astError( AST__BADIN, "astRead(XmlChan): The following "
+                                  "tag was not recognised as valid input within "
+                                  "a %s: %s", status, astXmlGetName( element ),
+                                  GetTag( (AstXmlObject *) item, 1, status ) );
+            break;
+         }
+
+/* Character data is OK so long as it contains only white space */
+      } else if( astXmlCheckType( item, AST__XMLBLACK ) ) {
+         astError( AST__BADIN, "astRead(XmlChan): The following character "
+                   "data was not recognised as valid input within a %s: %s", status,
+                   astXmlGetName( element ), astXmlGetValue( item, 0 ) );
+         break;
+
+      } else if( astXmlCheckType( item, AST__XMLCDATA ) ) {
+         astError( AST__BADIN, "astRead(XmlChan): The following CDATA section "
+                   "data was not recognised as valid input within a %s: %s", status,
+                   astXmlGetName( element ), astXmlGetValue( item, 0 ) );
+         break;
+
+      } else if( astXmlCheckType( item, AST__XMLPI ) ) {
+         astError( AST__BADIN, "astRead(XmlChan): The following processing "
+                   "instruction was not recognised as valid input within "
+                   "a %s: %s", status, astXmlGetName( element ), GetTag( (AstXmlObject *) item, 1, status ) );
+         break;
+      }
+   }
+}
+
 static AstRegion *CircleReader( AstXmlChan *this, AstXmlElement *elem,
                                 AstFrame *frm, int *status ){
 /*
@@ -4032,6 +4131,9 @@ static AstXmlElement *FindAttribute( AstXmlChan *this, const char *name, int *st
 *     of the supplied XmlChan looking for an element which represents a
 *     named AST attribute. No error is reported if the attribute is not
 *     found. Attributes which represent defaul values are ignored.
+*
+*     The search starts at the index of the previous attribute found in
+*     the same container (see FindObject).
 
 *  Parameters:
 *     this
@@ -4054,7 +4156,9 @@ static AstXmlElement *FindAttribute( AstXmlChan *this, const char *name, int *st
    const char *definedby;   /* Name of class which defines the item */
    const char *xmlname;     /* Value from XML NAME attribute */
    int i;                   /* Index of current item */
+   int j;                   /* Number of items checked */
    int nitem;               /* Number of items still in the element */
+   int start;               /* Index of first item to check */
 
 /* Initialise */
    result = NULL;
@@ -4076,12 +4180,24 @@ static AstXmlElement *FindAttribute( AstXmlChan *this, const char *name, int *st
                 astXmlGetName( this->container ) );
    }
 
+/* If ReadClassData recorded the names of the values in the container,
+   check the required value is present before searching for it. */
+   if( astOK && this->valnames && this->valcontainer == this->container &&
+       this->valclass == this->isa_class &&
+       !astMapHasKey( this->valnames, name ) ) return result;
+
 /* Check all is OK. */
    if( astOK ) {
 
-/* Loop round all items in the elements contents. */
+/* Decide where to start the search. */
       nitem = astXmlGetNitem( this->container );
-      for( i = 0; i < nitem; i++ ) {
+      start = 0;
+      if( this->findcontainer == this->container &&
+          this->findattr < nitem ) start = this->findattr;
+
+/* Loop round all items in the elements contents. */
+      for( j = 0; j < nitem; j++ ) {
+         i = ( start + j ) % nitem;
          item = astXmlGetItem( this->container, i );
 
 /* Ignore this item if it is not an element. */
@@ -4107,6 +4223,11 @@ static AstXmlElement *FindAttribute( AstXmlChan *this, const char *name, int *st
                       definedby = astXmlGetAttributeValue( item, DEFINEDBY );
                       if( definedby && !strcmp( definedby, this->isa_class ) ) {
                          result = (AstXmlElement *) item;
+                         if( this->findcontainer != this->container ) {
+                            this->findcontainer = this->container;
+                            this->findobj = 0;
+                         }
+                         this->findattr = i;
                          break;
                       }
                    }
@@ -4442,6 +4563,14 @@ static AstXmlElement *FindObject( AstXmlChan *this, const char *name, int *statu
 *     of the supplied XmlChan looking for an element which represents a
 *     named AST Object. No error is reported if the object is not
 *     found. Objects which represent default values are ignored.
+*
+*     Loaders usually read Objects in the order in which they were
+*     written, and each Object element is removed from its container
+*     once it has been read. So the search starts at the index of the
+*     previous Object found in the same container, and wraps round to
+*     the start of the container if necessary. This avoids repeatedly
+*     scanning any earlier items that have not yet been read (e.g. the
+*     ATTR elements that precede the Objects within a FrameSet).
 
 *  Parameters:
 *     this
@@ -4464,7 +4593,9 @@ static AstXmlElement *FindObject( AstXmlChan *this, const char *name, int *statu
    const char *definedby;   /* Name of class which defines the item */
    const char *xmlname;     /* Value from XML LABEL attribute */
    int i;                   /* Index of current item */
+   int j;                   /* Number of items checked */
    int nitem;               /* Number of items still i nthe element */
+   int start;               /* Index of first item to check */
 
 /* Initialise */
    result = NULL;
@@ -4489,9 +4620,15 @@ static AstXmlElement *FindObject( AstXmlChan *this, const char *name, int *statu
 /* Check all is OK. */
    if( astOK ) {
 
-/* Loop round all items in the elements contents. */
+/* Decide where to start the search. */
       nitem = astXmlGetNitem( this->container );
-      for( i = 0; i < nitem; i++ ) {
+      start = 0;
+      if( this->findcontainer == this->container &&
+          this->findobj < nitem ) start = this->findobj;
+
+/* Loop round all items in the elements contents. */
+      for( j = 0; j < nitem; j++ ) {
+         i = ( start + j ) % nitem;
          item = astXmlGetItem( this->container, i );
 
 /* Ignore this item if it is not an element. */
@@ -4515,6 +4652,11 @@ static AstXmlElement *FindObject( AstXmlChan *this, const char *name, int *statu
                       definedby = astXmlGetAttributeValue( item, DEFINEDBY );
                       if( definedby && !strcmp( definedby, this->isa_class ) ) {
                          result = (AstXmlElement *) item;
+                         if( this->findcontainer != this->container ) {
+                            this->findcontainer = this->container;
+                            this->findattr = 0;
+                         }
+                         this->findobj = i;
                          break;
                       }
                    }
@@ -4611,6 +4753,53 @@ static int FindString( int n, const char *list[], const char *test,
    return ret;
 }
 
+static void FreeDone( AstXmlChan *this, int *status ){
+/*
+*  Name:
+*     FreeDone
+
+*  Purpose:
+*     Free the list of elements that have already been converted to Objects.
+
+*  Type:
+*     Private function.
+
+*  Synopsis:
+*     #include "xmlchan.h"
+*     void FreeDone( AstXmlChan *this, int *status )
+
+*  Class Membership:
+*     XmlChan member function.
+
+*  Description:
+*     This function annuls any Objects created by IsDone that have not yet
+*     been used, and frees the arrays used to hold them.
+
+*  Parameters:
+*     this
+*        Pointer to the XmlChan.
+*     status
+*        Pointer to the inherited status variable.
+
+*  Notes:
+*     -  This function attempts to execute even if an error has occurred.
+*/
+
+/* Local Variables: */
+   int i;                    /* Index of completed element */
+
+/* Check the supplied pointer. */
+   if( !this ) return;
+
+/* Annul the Objects and free the arrays. */
+   for( i = 0; i < this->ndone; i++ ) {
+      if( this->doneobj[ i ] ) this->doneobj[ i ] = astAnnul( this->doneobj[ i ] );
+   }
+   this->doneelem = astFree( this->doneelem );
+   this->doneobj = astFree( this->doneobj );
+   this->ndone = 0;
+}
+
 static IVOAScan *FreeIVOAScan( IVOAScan *in, int *status ){
 /*
 *  Name:
@@ -4967,9 +5156,9 @@ static char GetNextChar( void *data, int *status ) {
    if( !astOK ) return result;
 
 /* We read a new line from the source if: 1) the reset flag is set in the
-   XmlChan, 2) we have reached the terminating null in the previous line,
-   or 3) we do not yet have a line of text. */
-   if( this->reset_source || *getnextchar_c == 0 || !getnextchar_buf ) {
+   XmlChan, 2) we do not yet have a line of text, or 3) we have reached
+   the terminating null in the previous line. */
+   if( this->reset_source || !getnextchar_buf || *getnextchar_c == 0 ) {
       this->reset_source = 0;
 
 /* Free the memory used to hold any previous text. */
@@ -5180,6 +5369,131 @@ static AstRegion *IntersectionReader( AstXmlChan *this, AstXmlElement *elem,
    return new;
 }
 
+static void IsDone( AstXmlElement *elem, int *status ){
+/*
+*  Name:
+*     IsDone
+
+*  Purpose:
+*     Convert a completed XmlElement into an AST Object.
+
+*  Type:
+*     Private function.
+
+*  Synopsis:
+*     #include "xmlchan.h"
+*     void IsDone( AstXmlElement *elem, int *status )
+
+*  Class Membership:
+*     XmlChan member function.
+
+*  Description:
+*     This function is called by astXmlReadDocument as soon as the end
+*     tag of each element nested within the element being read has been
+*     read. If the element describes a nested AST Object in native (or
+*     quoted) format, the Object is created immediately and the contents
+*     of the element are deleted, leaving an empty element that acts as
+*     a place holder for the Object. The Object is returned by
+*     MakeAstFromXml when the loader for the enclosing Object asks for
+*     it. This means that the XML for large Objects does not need to be
+*     held in memory all at once.
+
+*  Parameters:
+*     elem
+*        A pointer to the completed XmlElement.
+*     status
+*        Pointer to the inherited status variable.
+
+*/
+
+/* Local Variables: */
+   astDECLARE_GLOBALS            /* Declare the thread specific global data */
+   AstObject *new;               /* Pointer to new Object */
+   AstXmlChan *this;             /* Pointer to the XmlChan being read */
+   const char *def;              /* Value from XML DEFAULT attribute */
+   const char *isa_class;        /* Class currently being loaded */
+   const char *uri;              /* Pointer to namespace URI */
+   int i;                        /* Index of content item */
+   int lstatus;                  /* Local status for conversion */
+   int nitem;                    /* No. of items of content within element */
+   int oldrep;                   /* Original value of the Reporting flag */
+
+/* Check the global error status, and the supplied pointer. */
+   if ( !astOK || !elem ) return;
+
+/* Get a pointer to the structure holding thread-specific global data. */
+   astGET_GLOBALS(NULL);
+
+/* IVOA elements are converted by the enclosing element's reader, so
+   leave them alone. Also do nothing if an earlier element could not be
+   converted. */
+   this = isusable_this;
+   if( !this || this->donefail ||
+       astGetXmlFormat( this ) == IVOA_FORMAT ) return;
+
+/* Only elements in the AST namespace that describe a labelled, non-default
+   Object are converted (others are either attributes, "isa" markers or
+   will be ignored by the loader). */
+   uri = astXmlGetURI( elem );
+   if( uri && strcmp( uri, AST__XMLNS ) ) return;
+   if( !astXmlGetAttributeValue( elem, LABEL ) ) return;
+   def = astXmlGetAttributeValue( elem, DEFAULT );
+   if( def && !strcmp( def, TRUE ) ) return;
+
+/* Check the element name is an AST class name. */
+   if( astOK ) {
+      oldrep = astReporting( 0 );
+      astGetLoader( astXmlGetName( elem ), status );
+      if( !astOK ) {
+         astClearStatus;
+         astReporting( oldrep );
+         return;
+      }
+      astReporting( oldrep );
+   }
+
+/* Make the Object, remembering the class currently being loaded so that
+   it can be re-instated, and check that everything in the element was
+   used. A separate status variable is used, and error reports are
+   deferred, so that if the element cannot be converted the rest of the
+   enclosing element can still be read from the source before the error
+   is reported (as happens if nested elements are not converted until
+   the whole of the enclosing element has been read). */
+   lstatus = 0;
+   oldrep = astReporting( 0 );
+   isa_class = this->isa_class;
+   new = MakeAstFromXml( this, elem, &lstatus );
+   this->isa_class = isa_class;
+   CheckEmpty( elem, &lstatus );
+
+/* If the conversion failed, remember the error status and leave error
+   reporting switched off. ReadXmlText re-instates them once the whole of
+   the enclosing element has been read. */
+   if( lstatus != 0 ) {
+      this->donefail = lstatus;
+      this->donerep = oldrep;
+      if( new ) new = astAnnul( new );
+      return;
+   }
+   astReporting( oldrep );
+
+/* Delete the contents of the element. */
+   nitem = astXmlGetNitem( elem );
+   for( i = nitem - 1; i >= 0; i-- ) astXmlDelete( astXmlGetItem( elem, i ) );
+
+/* Record the Object, and the element that it came from. */
+   i = this->ndone;
+   this->doneelem = astGrow( this->doneelem, i + 1, sizeof( AstXmlElement * ) );
+   this->doneobj = astGrow( this->doneobj, i + 1, sizeof( AstObject * ) );
+   if( astOK ) {
+      this->doneelem[ i ] = elem;
+      this->doneobj[ i ] = new;
+      this->ndone++;
+   } else {
+      new = astAnnul( new );
+   }
+}
+
 static int IsUsable( AstXmlElement *elem, int *status ){
 /*
 *  Name:
@@ -5317,14 +5631,20 @@ static AstObject *MakeAstFromXml( AstXmlChan *this, AstXmlElement *elem, int *st
 */
 
 /* Local Variables: */
+   AstKeyMap *old_valnames;      /* Names of values in "old_container" */
    AstLoaderType *loader;        /* Pointer to loader for Object */
    AstObject *new;               /* Pointer to returned Object */
    AstXmlParent *old_container;  /* Element from which items are being read */
+   AstXmlParent *old_findcontainer;/* Container described by "old_findattr/obj" */
+   AstXmlParent *old_valcontainer;/* Container described by "old_valnames" */
+   const char *old_valclass;     /* Class described by "old_valnames" */
    IVOAReader reader;            /* Pointer to reader function */
    const char *class;            /* Pointer to Object class name string */
    int is_ivoa;                  /* Element belongs to an IVOA namespace? */
    int i;                        /* Index of content item */
    int nitem;                    /* No. of items of content within element */
+   int old_findattr;             /* Index of last ATTR in "old_findcontainer" */
+   int old_findobj;              /* Index of last Object in "old_findcontainer" */
 
 /* Initialise. */
    new = NULL;
@@ -5365,6 +5685,18 @@ static AstObject *MakeAstFromXml( AstXmlChan *this, AstXmlElement *elem, int *st
 /* ---------------------------------------------------- */
    } else {
 
+/* If the element has already been converted into an Object by IsDone,
+   return the Object and remove it from the list of completed elements. */
+      for( i = 0; i < this->ndone; i++ ) {
+         if( this->doneelem[ i ] == elem ) {
+            new = this->doneobj[ i ];
+            this->ndone--;
+            this->doneelem[ i ] = this->doneelem[ this->ndone ];
+            this->doneobj[ i ] = this->doneobj[ this->ndone ];
+            return new;
+         }
+      }
+
 /* Get the AST class name. This is the name of the XML element. */
       class = astXmlGetName( elem );
 
@@ -5380,6 +5712,16 @@ static AstObject *MakeAstFromXml( AstXmlChan *this, AstXmlElement *elem, int *st
          old_container = this->container;
          this->container = (AstXmlParent *) elem;
 
+/* Also save the names of the values in the current container, so that
+   they can be re-instated once the new Object has been loaded. */
+         old_valnames = this->valnames;
+         old_valcontainer = this->valcontainer;
+         old_valclass = this->valclass;
+         this->valnames = NULL;
+         old_findcontainer = this->findcontainer;
+         old_findattr = this->findattr;
+         old_findobj = this->findobj;
+
 /* The "isa_class" item in the XmlChan structure contains a pointer to
    the name of the class whose loader is currently being invoked. It is set
    by the loader itself as a side effect of calling the astReadClassData
@@ -5396,6 +5738,13 @@ static AstObject *MakeAstFromXml( AstXmlChan *this, AstXmlElement *elem, int *st
 
 /* Re-instate the original container. */
          this->container = old_container;
+         if( this->valnames ) this->valnames = astAnnul( this->valnames );
+         this->valnames = old_valnames;
+         this->valcontainer = old_valcontainer;
+         this->valclass = old_valclass;
+         this->findcontainer = old_findcontainer;
+         this->findattr = old_findattr;
+         this->findobj = old_findobj;
       }
    }
 
@@ -7052,6 +7401,10 @@ static AstObject *Read( AstChannel *this_channel, int *status ) {
       elem = Remove( this, elem, status );
    }
 
+/* Free any Objects created from nested elements that were not used (this
+   only happens if an error has occurred). */
+   FreeDone( this, status );
+
 /* If an error has occurred, annul the document. */
    if( !astOK ) this->readcontext = astXmlAnnul( this->readcontext );
 
@@ -7110,7 +7463,9 @@ static void ReadClassData( AstChannel *this_channel, const char *class, int *sta
 /* Local Variables: */
    AstXmlChan *this;             /* Pointer to the XmlChan structure */
    AstXmlContentItem *item;      /* Pointer to next item of content */
+   const char *def;              /* Value from XML DEFAULT attribute */
    const char *definedby;        /* Class defining current content items */
+   const char *name;             /* Value from XML NAME attribute */
    int nitem;                    /* Number of items in container */
    int i;                        /* Loop counter */
 
@@ -7141,8 +7496,22 @@ static void ReadClassData( AstChannel *this_channel, const char *class, int *sta
    If none is found the name of the class being loaded is used. */
       definedby = FindNextIsA( (AstXmlElement *) this->container, 0, status );
 
-/* Loop round all elements within the container. */
+/* If the container is large, the names of the (non-default) values
+   defined by the class being loaded are also recorded in a KeyMap. This
+   allows FindAttribute to return immediately if a value is not present,
+   rather than searching the whole container. Values are read in
+   (roughly) the order they were written, and are removed from the
+   container once read, so values that are present are usually found
+   quickly anyway. */
       nitem = astXmlGetNitem( this->container );
+      if( this->valnames ) this->valnames = astAnnul( this->valnames );
+      if( nitem >= MIN_VALNAMES ) {
+         this->valnames = astKeyMap( "KeyCase=0", status );
+         this->valcontainer = this->container;
+         this->valclass = class;
+      }
+
+/* Loop round all elements within the container. */
       for( i = 0; astOK && i < nitem; i++ ) {
          item = astXmlGetItem( this->container, i );
          if( astXmlCheckType( item, AST__XMLELEM ) ) {
@@ -7158,6 +7527,16 @@ static void ReadClassData( AstChannel *this_channel, const char *class, int *sta
    of the class defined by the current ISA element. */
             } else {
                astXmlAddAttr( item, DEFINEDBY, definedby, NULL );
+
+/* Record the names of the values defined by the class being loaded. */
+               if( this->valnames && !strcmp( definedby, class ) &&
+                   !strcmp( astXmlGetName( item ), ATTR ) ) {
+                  def = astXmlGetAttributeValue( item, DEFAULT );
+                  name = astXmlGetAttributeValue( item, NAME );
+                  if( name && ( !def || strcmp( def, TRUE ) ) ) {
+                     astMapPut0I( this->valnames, name, 1, NULL );
+                  }
+               }
             }
          }
       }
@@ -7781,18 +8160,27 @@ static AstXmlElement *ReadXmlText( AstXmlChan *this, int *status ){
    AST object could be created. */
    skip = astGetSkip( this );
 
-/* Store a pointer to the XmlChan in a module variable so that the IsUsable function
-   can access its properties. */
+/* Store a pointer to the XmlChan in a module variable so that the IsUsable
+   and IsDone functions can access its properties. */
    isusable_this = this;
+   this->donefail = 0;
 
 /* Read characters from the XML source and return an XmlElement structure
    containing the first usable element encountered. */
-   result = astXmlReadDocument( &(this->readcontext), IsUsable, skip,
-                               GetNextChar, this );
+   result = astXmlReadDocument( &(this->readcontext), IsUsable, IsDone, skip,
+                                GetNextChar, this );
 
 /* Nullify the module variable for safety. */
    isusable_this = NULL;
 
+/* If IsDone failed to convert a nested element into an AST Object,
+   report the deferred error now that the whole element has been read. */
+   if( this->donefail ) {
+      if( astOK ) astSetStatus( this->donefail );
+      astReporting( this->donerep );
+      this->donefail = 0;
+   }
+
 /* If no usable element was found, annul the document. */
    if( !result ) this->readcontext = astXmlAnnul( this->readcontext );
 
@@ -8872,10 +9260,7 @@ static AstXmlElement *Remove( AstXmlChan *this, AstXmlElement *element, int *sta
 */
 
 /* Local Variables: */
-   AstXmlContentItem *item; /* Item */
-   const char *def;         /* Pointer to default attribute value */
-   int i;                   /* Index of current item */
-   int nitem;               /* Number of items still in the element */
+   int nitem;               /* Number of items in the container */
 
 /* Check the global error status, and the supplied element. */
    if ( !astOK || !element ) return NULL;
@@ -8889,59 +9274,31 @@ static AstXmlElement *Remove( AstXmlChan *this, AstXmlElement *element, int *sta
                    "contained within the current container element (internal "
                    "AST programming error)." , status);
       } else {
-         astXmlRemoveItem( element );
-      }
-   }
 
-/* Check that the element being removed is empty (apart from comments,
-   defaulted values and "isa" elements). */
-   nitem = astXmlGetNitem( element );
-   for( i = 0; i < nitem; i++ ) {
-      item = astXmlGetItem( element, i );
-      if( astXmlCheckType( item, AST__XMLELEM ) ) {
-
-/* See if this element represents a default value */
-         def = astXmlGetAttributeValue( item, DEFAULT );
-
-/* Default values and "isa" elements are OK. */
-         if( ( !def || strcmp( def, TRUE ) ) && astOK &&
-             strcmp( astXmlGetName( item ), ISA ) ) {
-
-/* Remove any "definedby" attribute (added by ReadClassData) so that it
-   does not appear in the error message. */
-            if( astXmlGetAttributeValue( item, DEFINEDBY ) ) {
-               astXmlRemoveAttr( item, DEFINEDBY, NULL );
+/* If the element was found by FindAttribute or FindObject, the items
+   following it will move down by one. Adjust the other search index
+   so that it continues to refer to the same item. */
+         if( this->findcontainer == this->container ) {
+            nitem = astXmlGetNitem( this->container );
+            if( this->findattr < nitem && this->findattr < this->findobj &&
+                astXmlGetItem( this->container, this->findattr ) ==
+                (AstXmlContentItem *) element ) {
+               this->findobj--;
+            } else if( this->findobj < nitem && this->findobj < this->findattr &&
+                astXmlGetItem( this->container, this->findobj ) ==
+                (AstXmlContentItem *) element ) {
+               this->findattr--;
             }
-
-/* Report the error. */
-            if( astOK ) astError( AST__BADIN, "astRead(XmlChan): The following "
-                                  "tag was not recognised as valid input within "
-                                  "a %s: %s", status, astXmlGetName( element ),
-                                  GetTag( (AstXmlObject *) item, 1, status ) );
-            break;
          }
 
-/* Character data is OK so long as it contains only white space */
-      } else if( astXmlCheckType( item, AST__XMLBLACK ) ) {
-         astError( AST__BADIN, "astRead(XmlChan): The following character "
-                   "data was not recognised as valid input within a %s: %s", status,
-                   astXmlGetName( element ), astXmlGetValue( item, 0 ) );
-         break;
-
-      } else if( astXmlCheckType( item, AST__XMLCDATA ) ) {
-         astError( AST__BADIN, "astRead(XmlChan): The following CDATA section "
-                   "data was not recognised as valid input within a %s: %s", status,
-                   astXmlGetName( element ), astXmlGetValue( item, 0 ) );
-         break;
-
-      } else if( astXmlCheckType( item, AST__XMLPI ) ) {
-         astError( AST__BADIN, "astRead(XmlChan): The following processing "
-                   "instruction was not recognised as valid input within "
-                   "a %s: %s", status, astXmlGetName( element ), GetTag( (AstXmlObject *) item, 1, status ) );
-         break;
+         astXmlRemoveItem( element );
       }
    }
 
+/* Check that the element being removed is empty (apart from comments,
+   defaulted values and "isa" elements). */
+   CheckEmpty( element, status );
+
 /* Remove the element from its parent and the annul it. */
    astXmlRemoveItem( element );
    astXmlAnnul( element );
@@ -13455,6 +13812,17 @@ static void Copy( const AstObject *objin, AstObject *objout, int *status ) {
    out->write_isa = 0;       /* Write out the next "IsA" item? */
    out->reset_source = 1;    /* A new line should be read from the source */
    out->isa_class = NULL;    /* Class being loaded */
+   out->doneelem = NULL;     /* Elements already converted to Objects */
+   out->doneobj = NULL;      /* Objects created from completed elements */
+   out->ndone = 0;           /* Number of completed elements */
+   out->donefail = 0;        /* Status from failed conversion */
+   out->donerep = 1;         /* Reporting flag before failed conversion */
+   out->valnames = NULL;     /* Names of values in current container */
+   out->valcontainer = NULL; /* Container described by valnames */
+   out->valclass = NULL;     /* Class described by valnames */
+   out->findcontainer = NULL;/* Container described by findattr/obj */
+   out->findattr = 0;        /* Index of last ATTR element found */
+   out->findobj = 0;         /* Index of last Object element found */
 
 /* Store a copy of the prefix string.*/
    if ( in->xmlprefix ) out->xmlprefix = astStore( NULL, in->xmlprefix,
@@ -13501,6 +13869,13 @@ static void Delete( AstObject *obj, int *status ) {
 /* Free any unread part of the document. */
    this->readcontext = astXmlAnnul( this->readcontext );
 
+/* Free any Objects created from elements that were never used. */
+   FreeDone( this, status );
+
+/* Free the KeyMap holding the names of the values in the current
+   container. */
+   if( this->valnames ) this->valnames = astAnnul( this->valnames );
+
 /* Free the memory used for the XmlPrefix string if necessary. */
    this->xmlprefix = astFree( this->xmlprefix );
 
@@ -14209,6 +14584,17 @@ AstXmlChan *astInitXmlChan_( void *mem, size_t size, int init,
       new->formatdef = NATIVE_FORMAT;  /* Default Xml format */
       new->reset_source = 1;    /* A new line should be read from the source */
       new->isa_class = NULL;    /* Class being loaded */
+      new->doneelem = NULL;     /* Elements already converted to Objects */
+      new->doneobj = NULL;      /* Objects created from completed elements */
+      new->ndone = 0;           /* Number of completed elements */
+      new->donefail = 0;        /* Status from failed conversion */
+      new->donerep = 1;         /* Reporting flag before failed conversion */
+      new->valnames = NULL;     /* Names of values in current container */
+      new->valcontainer = NULL; /* Container described by valnames */
+      new->valclass = NULL;     /* Class described by valnames */
+      new->findcontainer = NULL;/* Container described by findattr/obj */
+      new->findattr = 0;        /* Index of last ATTR element found */
+      new->findobj = 0;         /* Index of last Object element found */
 
 /* If an error occurred, clean up by deleting the new object. */
       if ( !astOK ) new = astDelete( new );
@@ -14352,6 +14738,17 @@ AstXmlChan *astLoadXmlChan_( void *mem, size_t size,
       new->xmlprefix = NULL;    /* Xml prefix */
       new->reset_source = 1;    /* A new line should be read from the source */
       new->isa_class = NULL;    /* Class being loaded */
+      new->doneelem = NULL;     /* Elements already converted to Objects */
+      new->doneobj = NULL;      /* Objects created from completed elements */
+      new->ndone = 0;           /* Number of completed elements */
+      new->donefail = 0;        /* Status from failed conversion */
+      new->donerep = 1;         /* Reporting flag before failed conversion */
+      new->valnames = NULL;     /* Names of values in current container */
+      new->valcontainer = NULL; /* Container described by valnames */
+      new->valclass = NULL;     /* Class described by valnames */
+      new->findcontainer = NULL;/* Container described by findattr/obj */
+      new->findattr = 0;        /* Index of last ATTR element found */
+      new->findobj = 0;         /* Index of last Object element found */
       new->formatdef = NATIVE_FORMAT;  /* Default Xml format */
 
 /* Now restore presistent values. */
@@ -111,6 +111,17 @@ typedef struct AstXmlChan {
    char *xmlprefix;            /* Namespace prefix */
    int reset_source;           /* Read a new line from the source ? */
    const char *isa_class;      /* Class being loaded */
+   AstXmlElement **doneelem;   /* Elements already converted to Objects */
+   AstObject **doneobj;        /* Objects created from "doneelem" elements */
+   int ndone;                  /* Number of converted elements */
+   int donefail;               /* Status from failed conversion */
+   int donerep;                /* Reporting flag before failed conversion */
+   AstKeyMap *valnames;        /* Names of values in "valcontainer" */
+   AstXmlParent *valcontainer; /* Container described by "valnames" */
+   const char *valclass;       /* Class described by "valnames" */
+   AstXmlParent *findcontainer;/* Container described by "findattr/obj" */
+   int findattr;               /* Index of last ATTR element found */
+   int findobj;                /* Index of last Object element found */
 } AstXmlChan;
 
 /* Virtual function table. */
@@ -48,14 +48,21 @@ f     encodings and the internal ASCII encoding. If no such routines
 *     In addition to those attributes common to all Channels, every
 *     YamlChan also has the following attributes:
 *
+*     - BlockOK: Minimum size of arrays written as ASDF binary blocks
 *     - VerboseRead: Echo YAML text to standard output as it is read?
 *     - PreserveName: Save the ASDF name attributes as AST Ident values?
 *     - YamlEncoding: The external formatting system to use.
 
 *  Functions:
-c     The YamlChan class does not define any new functions beyond those
-f     The YamlChan class does not define any new routines beyond those
-*     which are applicable to all Channels.
+c     In addition to those functions applicable to all Channels, the
+c     following functions may also be applied to all YamlChans:
+f     In addition to those routines applicable to all Channels, the
+f     following routines may also be applied to all YamlChans:
+*
+c     - astGetAsdfBlocks: Retrieve the ASDF binary blocks from a YamlChan
+c     - astPutAsdfBlocks: Store ASDF binary blocks in a YamlChan
+f     - AST_GETASDFBLOCKS: Retrieve the ASDF binary blocks from a YamlChan
+f     - AST_PUTASDFBLOCKS: Store ASDF binary blocks in a YamlChan
 
 *  Notes:
 *     - This class uses the limyaml library to read and write yaml. If the
@@ -450,6 +457,7 @@ static const char *GetName( AstYamlChan *, const char *, AstMapping *, int * );
 static const char *YamlEventType( yaml_event_t );
 static double *GetQuantityV( AstYamlChan *, AstKeyMap *, const char *, const char *, int, int, int *, int *,  int * );
 static double *GetSequence( AstYamlChan *, AstKeyMap *, const char *, int, int, int *, int *, int *status );
+static double *ReadAsdfBlock( AstYamlChan *, AstKeyMap *, int, int *, int *, int * );
 static double *ReadNDArray( AstYamlChan *, AstKeyMap *, int, int *, int *, int * );
 static double *ReadSequence( AstYamlChan *, AstKeyMap *, const char *, int, int *, int *, int * );
 static double Get0D( AstKeyMap *, const char *, int, double, int * );
@@ -465,9 +473,12 @@ static int GetChoice( AstKeyMap *, const char *, const char *, int, int, int * )
 static int IsA( AstKeyMap *, const char *, int * );
 static int LibYamlReader( void *, yaml_char_t *, size_t, size_t * );
 static int LibYamlWriter( void *, yaml_char_t *, long unsigned int );
+static int LittleEndian( void );
 static int ReadBaseFrame( AstKeyMap *, AstSkyFrame *, int * );
+static int ReadYAMLNumber( const char *, double *, int *, int * );
 static int SimplifyAsdf( AstYamlChan *, AstKeyMap **, int *);
 static int Use( AstYamlChan *, int, int, int * );
+static void ConvertTransform( AstYamlChan *, AstKeyMap **, int * );
 static void Deuler( const char *, double *, double[3][3], int * );
 static void ExpandAsdf( AstYamlChan *, AstKeyMap *, int, int *, AstKeyMap ***, int * );
 static void GetUCD( int, const char **, const char ** );
@@ -482,9 +493,11 @@ static void ReadYAMLItem( AstYamlChan *, yaml_parser_t *, AstKeyMap *, const cha
 static void ReadYAMLSequence( AstYamlChan *, AstKeyMap *, const char *, yaml_parser_t *, int * );
 static void SetNotAsdf( AstCmpMap *, int * );
 static void EndYamlDoc( AstYamlChan *, yaml_emitter_t *, int * );
+static void MakeAsdfBlocks( AstYamlChan *, AstKeyMap *, int * );
 static void StartYamlDoc( AstYamlChan *, yaml_emitter_t *, int * );
 static void StartYamlMapping( AstYamlChan *, const char *, const char *, yaml_emitter_t *, int * );
 static void Store0C( AstYamlChan *, const char *, int, AstKeyMap *, const char *, const char *, int * );
+static void StoreAsdfBlock( AstYamlChan *, AstKeyMap *, int, const int *, const double *, int * );
 static void Store0D( AstYamlChan *, const char *, AstKeyMap *, double, int * );
 static void Store0I( AstYamlChan *, const char *, AstKeyMap *, int, int * );
 static void Store1C( AstYamlChan *, const char *, int, AstKeyMap *, int, const char *[], const char *, int * );
@@ -597,11 +610,20 @@ static int Ustrcmp( const char *, const char *, int * );
 static int Ustrncmp( const char *, const char *, size_t, int * );
 static int Write( AstChannel *, AstObject *, int * );
 static void ClearAttrib( AstObject *, const char *, int * );
+static AstKeyMap *GetAsdfBlocks( AstYamlChan *, int * );
+static void Copy( const AstObject *, AstObject *, int * );
+static void Delete( AstObject *, int * );
 static void Dump( AstObject *, AstChannel *, int * );
+static void PutAsdfBlocks( AstYamlChan *, AstKeyMap *, int * );
 static void SetAttrib( AstObject *, const char *, int * );
 static void SetIndent( AstChannel *, int, int * );
 static void SinkWrap( void (*)( const char * ), const char *, int * );
 
+static int GetBlockOK( AstYamlChan *, int * );
+static int TestBlockOK( AstYamlChan *, int * );
+static void ClearBlockOK( AstYamlChan *, int * );
+static void SetBlockOK( AstYamlChan *, int, int * );
+
 static int GetVerboseRead( AstYamlChan *, int * );
 static int TestVerboseRead( AstYamlChan *, int * );
 static void ClearVerboseRead( AstYamlChan *, int * );
@@ -666,7 +688,10 @@ static void ClearAttrib( AstObject *this_object, const char *attrib, int *status
    this = ( AstYamlChan *) this_object;
 
 /* Check the attribute name and clear the appropriate attribute. */
-   if ( !strcmp( attrib, "verboseread" ) ) {
+   if ( !strcmp( attrib, "blockok" ) ) {
+      astClearBlockOK( this );
+
+   } else if ( !strcmp( attrib, "verboseread" ) ) {
       astClearVerboseRead( this );
 
    } else if ( !strcmp( attrib, "preservename" ) ) {
@@ -764,6 +789,97 @@ static int FindString( int n, const char *list[], const char *test,
    return ret;
 }
 
+static AstKeyMap *GetAsdfBlocks( AstYamlChan *this, int *status ) {
+/*
+*++
+*  Name:
+c     astGetAsdfBlocks
+f     AST_GETASDFBLOCKS
+
+*  Purpose:
+*     Retrieve the ASDF binary blocks currently in a YamlChan.
+
+*  Type:
+*     Public virtual function.
+
+*  Synopsis:
+c     #include "yamlchan.h"
+c     AstKeyMap *astGetAsdfBlocks( AstYamlChan *this )
+f     RESULT = AST_GETASDFBLOCKS( THIS, STATUS )
+
+*  Class Membership:
+*     YamlChan method.
+
+*  Description:
+*     If the supplied YamlChan currently contains any ASDF binary blocks,
+*     then this function returns a pointer to a KeyMap holding them.
+*     Each entry in the KeyMap is a vector of bytes (i.e. an entry of
+*     type AST__BYTETYPE) holding the raw contents of one block. The key
+*     for each entry is the zero-based index of the block, formatted as
+*     a decimal integer (e.g. "0", "1", etc). This is the value of the
+*     "source" property of the ASDF ndarray that refers to the block.
+*
+*     Blocks are created when an Object is written to a YamlChan
+c     using astWrite,
+f     using AST_WRITE,
+*     if the BlockOK attribute is positive and the Object contains
+*     arrays of at least BlockOK values. Each such array is stored in
+*     a block as a sequence of little-endian IEEE double precision
+*     values, rather than as a YAML sequence. The YAML text written
+*     through the sink function does not include the blocks, so the
+*     caller should append them to the ASDF file in order of increasing
+*     block index, each preceded by an ASDF block header. Blocks can
+*     also be stored in a YamlChan
+c     using astPutAsdfBlocks.
+f     using AST_PUTASDFBLOCKS.
+
+*  Parameters:
+c     this
+f     THIS = INTEGER (Given)
+*        Pointer to the YamlChan.
+f     STATUS = INTEGER (Given and Returned)
+f        The global status.
+
+*  Returned Value:
+c     astGetAsdfBlocks()
+f     AST_GETASDFBLOCKS = INTEGER
+*        A pointer to a deep copy of the KeyMap holding the blocks
+*        currently in the YamlChan, or
+c        NULL
+f        AST__NULL
+*        if the YamlChan does not contain any blocks. The returned
+*        pointer should be annulled using
+c        astAnnul
+f        AST_ANNUL
+*        when no longer needed.
+
+*  Notes:
+*     - A null Object pointer (AST__NULL) will be returned if this
+c     function is invoked with the AST error status set, or if it
+f     function is invoked with STATUS set to an error value, or if it
+*     should fail for any reason.
+*--
+*/
+
+/* Local Variables: */
+   AstKeyMap *result;      /* Pointer value to return */
+
+/* Initialise. */
+   result = NULL;
+
+/* Check the global error status. */
+   if ( !astOK ) return result;
+
+/* If the YamlChan contains any blocks, return a pointer to a copy of
+   the KeyMap containing them. Otherwise, return a NULL pointer. */
+   if( this->blocks && astMapSize( this->blocks ) > 0 ) {
+      result = astCopy( this->blocks );
+   }
+
+/* Return the result. */
+   return result;
+}
+
 static const char *GetAttrib( AstObject *this_object, const char *attrib, int *status ) {
 /*
 *  Name:
@@ -837,7 +953,14 @@ static const char *GetAttrib( AstObject *this_object, const char *attrib, int *s
    format.  Set "result" to point at the result string. */
 
 /* Test for each attribute name is turn. */
-   if ( !strcmp( attrib, "verboseread" ) ) {
+   if ( !strcmp( attrib, "blockok" ) ) {
+      ival = astGetBlockOK( this );
+      if ( astOK ) {
+         (void) sprintf( getattrib_buff, "%d", ival );
+         result = getattrib_buff;
+      }
+
+   } else if ( !strcmp( attrib, "verboseread" ) ) {
       ival = astGetVerboseRead( this );
       if ( astOK ) {
          (void) sprintf( getattrib_buff, "%d", ival );
@@ -1010,6 +1133,14 @@ void astInitYamlChanVtab_(  AstYamlChanVtab *vtab, const char *name, int *status
    parent_setindent = channel->SetIndent;
    channel->SetIndent = SetIndent;
 
+   vtab->GetAsdfBlocks = GetAsdfBlocks;
+   vtab->PutAsdfBlocks = PutAsdfBlocks;
+
+   vtab->ClearBlockOK = ClearBlockOK;
+   vtab->GetBlockOK = GetBlockOK;
+   vtab->SetBlockOK = SetBlockOK;
+   vtab->TestBlockOK = TestBlockOK;
+
    vtab->ClearVerboseRead = ClearVerboseRead;
    vtab->GetVerboseRead = GetVerboseRead;
    vtab->SetVerboseRead = SetVerboseRead;
@@ -1025,8 +1156,9 @@ void astInitYamlChanVtab_(  AstYamlChanVtab *vtab, const char *name, int *status
    vtab->SetYamlEncoding = SetYamlEncoding;
    vtab->TestYamlEncoding = TestYamlEncoding;
 
-/* Declare the Dump function for this class. There is no destructor or
-   copy constructor. */
+/* Declare the copy constructor, destructor and class dump function. */
+   astSetCopy( vtab, Copy );
+   astSetDelete( vtab, Delete );
    astSetDump( vtab, Dump, "YamlChan", "YAML I/O Channel" );
 
 /* If we have just initialised the vtab for the current class, indicate
@@ -1038,6 +1170,96 @@ void astInitYamlChanVtab_(  AstYamlChanVtab *vtab, const char *name, int *status
    }
 }
 
+static void PutAsdfBlocks( AstYamlChan *this, AstKeyMap *blocks, int *status ) {
+/*
+*++
+*  Name:
+c     astPutAsdfBlocks
+f     AST_PUTASDFBLOCKS
+
+*  Purpose:
+*     Store ASDF binary blocks in a YamlChan.
+
+*  Type:
+*     Public virtual function.
+
+*  Synopsis:
+c     #include "yamlchan.h"
+c     void astPutAsdfBlocks( AstYamlChan *this, AstKeyMap *blocks )
+f     CALL AST_PUTASDFBLOCKS( THIS, BLOCKS, STATUS )
+
+*  Class Membership:
+*     YamlChan method.
+
+*  Description:
+c     This function
+f     This routine
+*     stores the contents of one or more ASDF binary blocks in a YamlChan.
+*     They are used when a subsequent call to
+c     astRead
+f     AST_READ
+*     reads an ASDF ndarray that refers to a binary block (i.e. has an
+*     integer "source" property), rather than holding its values inline.
+*     The calling application is responsible for reading the blocks from
+*     the binary section of the ASDF file, following the YAML tree.
+*
+*     An error is reported by
+c     astRead
+f     AST_READ
+*     if a required block has not been stored in the YamlChan. Ndarrays
+*     with data type "float64", "float32", "int64", "int32", "int16" or
+*     "uint8", and either byte order, can be read from binary blocks.
+
+*  Parameters:
+c     this
+f     THIS = INTEGER (Given)
+*        Pointer to the YamlChan.
+c     blocks
+f     BLOCKS = INTEGER (Given)
+*        Pointer to a KeyMap holding the blocks to be added to the
+*        YamlChan. Each entry should be a vector of bytes (i.e. an entry
+*        of type AST__BYTETYPE) holding the raw contents of one block,
+*        excluding the block header, and decompressed if necessary. The
+*        key for each entry should be the zero-based index of the block
+*        within the ASDF file, formatted as a decimal integer (e.g. "0",
+*        "1", etc). Entries of any other type are ignored. A copy of each
+*        entry is stored in the YamlChan, replacing any existing block
+*        with the same key.
+f     STATUS = INTEGER (Given and Returned)
+f        The global status.
+
+*  Notes:
+*     - Blocks stored in the YamlChan may be retrieved using
+c     astGetAsdfBlocks.
+f     AST_GETASDFBLOCKS.
+*     - Any blocks already in the YamlChan are deleted when an Object is
+*     written to the YamlChan using ASDF encoding with a positive value
+*     for the BlockOK attribute.
+*--
+*/
+
+/* Local Variables: */
+   const char *key;
+   int ientry;
+   int nentry;
+
+/* Check the global error status. */
+   if ( !astOK ) return;
+
+/* Create the KeyMap holding the blocks if it does not already exist. */
+   if( !this->blocks ) this->blocks = astKeyMap( " ", status );
+
+/* Loop through all entries in the supplied KeyMap, copying each byte
+   vector into the YamlChan. */
+   nentry = astMapSize( blocks );
+   for( ientry = 0; ientry < nentry && astOK; ientry++ ) {
+      key = astMapKey( blocks, ientry );
+      if( astMapType( blocks, key ) == AST__BYTETYPE ) {
+         astMapCopyEntry( this->blocks, key, blocks, 0 );
+      }
+   }
+}
+
 static AstObject *Read( AstChannel *this_channel, int *status ) {
 /*
 *  Name:
@@ -1104,6 +1326,7 @@ static AstObject *Read( AstChannel *this_channel, int *status ) {
 
 /* Indicate we have not yet read a complete WCS object. */
    this->gotwcs = 0;
+   this->inwcs = 0;
 
 /* Indicate we have not yet determined the default yaml encoding. */
    this->defenc = UNKNOWN_ENCODING;
@@ -1209,6 +1432,11 @@ static void SetAttrib( AstObject *this_object, const char *setting, int *status
 
 /* Test for each attribute name in turn. */
    if ( nc = 0,
+               ( 1 == astSscanf( setting, "blockok= %d %n", &ival, &nc ) )
+               && ( nc >= len ) ) {
+      astSetBlockOK( this, ival );
+
+   } else if ( nc = 0,
                ( 1 == astSscanf( setting, "verboseread= %d %n", &ival, &nc ) )
                && ( nc >= len ) ) {
       astSetVerboseRead( this, ival );
@@ -1453,7 +1681,10 @@ static int TestAttrib( AstObject *this_object, const char *attrib, int *status )
    this = (AstYamlChan *) this_object;
 
 /* Check the attribute name and test the appropriate attribute. */
-   if ( !strcmp( attrib, "verboseread" ) ) {
+   if ( !strcmp( attrib, "blockok" ) ) {
+      result = astTestBlockOK( this );
+
+   } else if ( !strcmp( attrib, "verboseread" ) ) {
       result = astTestVerboseRead( this );
 
    } else if ( !strcmp( attrib, "preservename" ) ) {
@@ -1734,6 +1965,13 @@ static int Write( AstChannel *this_channel, AstObject *obj, int *status ) {
 /* For ASDF encoding... */
    } else if( enc == ASDF_ENCODING ) {
 
+/* If large arrays are to be written to binary blocks, delete any blocks
+   created by a previous write so that the blocks used by this write are
+   numbered from zero. */
+      if( astGetBlockOK( this ) > 0 && this->blocks ) {
+         this->blocks = astAnnul( this->blocks );
+      }
+
 /* Check the supplied object is of a suitable AST class. Since Frames and
    FrameSets are subclasses of Mapping, we can just test that the supplied
    object is a Mapping. */
@@ -1756,6 +1994,10 @@ static int Write( AstChannel *this_channel, AstObject *obj, int *status ) {
             km = WriteMapping( this, (AstMapping *) obj, NULL, NULL, status );
          }
 
+/* If required, move the values of any large ndarrays into binary
+   blocks. */
+         if( km && astGetBlockOK( this ) > 0 ) MakeAsdfBlocks( this, km, status );
+
 /* If the object was written to the KeyMap successfully, write it out as
    YAML through the sink function and then free the KeyMap. */
          if( km ) {
@@ -1891,6 +2133,77 @@ static AstKeyMap *AddR2D( AstYamlChan *this, AstKeyMap **km, int r2d,
    return ret;
 }
 
+static void ConvertTransform( AstYamlChan *this, AstKeyMap **km,
+                              int *status ){
+/*
+*  Name:
+*     ConvertTransform
+
+*  Purpose:
+*     Replace the contents of a KeyMap holding an ASDF transform with an
+*     equivalent AST Mapping.
+
+*  Type:
+*     Private function.
+
+*  Synopsis:
+*     #include "yamlchan.h"
+*     void ConvertTransform( AstYamlChan *this, AstKeyMap **km,
+*                            int *status )
+
+*  Class Membership:
+*     YamlChan member function
+
+*  Description:
+*     This function is called whilst the YAML is being parsed, as soon as
+*     the KeyMap holding an ASDF transform within a GWCS wcs object has
+*     been completed. It creates the equivalent AST Mapping and returns a
+*     new KeyMap holding just the Mapping (with key "ASTmapping") and the
+*     ASDFclass of the transform. ReadTransform returns the stored
+*     Mapping without needing to read the original properties again.
+*
+*     Since any transforms nested within the supplied transform will
+*     already have been converted, each transform is converted only once,
+*     and the KeyMaps holding the properties of each transform (which may
+*     include large arrays of coefficients) are freed as soon as the
+*     transform has been read, rather than being retained until the whole
+*     wcs object has been read.
+
+*  Parameters:
+*     this
+*        Pointer to the YamlChan.
+*     km
+*        Address of a pointer to the KeyMap holding the ASDF transform.
+*        The supplied KeyMap pointer is annulled and a pointer to the new
+*        KeyMap is returned in its place.
+*     status
+*        Pointer to the inherited status variable.
+
+*/
+
+/* Local Variables: */
+   AstKeyMap *new;
+   AstMapping *map;
+
+/* Check the global error status. */
+   if ( !astOK ) return;
+
+/* Create the AST Mapping from the properties of the transform. */
+   map = ReadTransform( this, *km, status );
+   if( map ) {
+
+/* Create a new KeyMap holding the Mapping and the ASDF class of the
+   transform, and use it in place of the supplied KeyMap. */
+      new = astKeyMap( "SortBy=KeyAgeDown", status );
+      astMapCopyEntry( new, "ASDFclass", *km, 0 );
+      astMapPut0A( new, "ASTmapping", map, NULL );
+      map = astAnnul( map );
+
+      (void) astAnnul( *km );
+      *km = new;
+   }
+}
+
 static void Deuler( const char *order, double *angles, double rmat[3][3],
                     int *status ) {
 /*
@@ -2034,6 +2347,12 @@ static void EndYamlDoc( AstYamlChan *this, yaml_emitter_t *emitter,
 /* Delete the emitter. */
    yaml_emitter_delete( emitter );
 
+/* Write out any incomplete final line retained by LibYamlWriter. */
+   if( this->wline ) {
+      if( astOK ) astPutNextText( this, this->wline );
+      this->wline = astFree( this->wline );
+   }
+
 /* Nullify the emitter pointer in the YamlChan structure. */
    this->emitter = NULL;
 }
@@ -2628,6 +2947,7 @@ static const char *FmtDouble( double dval, size_t buflen, char *buf ) {
 #define EXTRA 8
 
 /* Local Variables: */
+   char *exp;
    int nc;
    int n1;
    int n2;
@@ -2662,12 +2982,20 @@ static const char *FmtDouble( double dval, size_t buflen, char *buf ) {
             sprintf( buf, "%.*g", nc - 2, dval );
          }
       }
-   }
 
-/* Ensure there is a decimal point in the string. */
-   if( !strchr( buf, '.' ) ) {
-      n1 = strlen( buf );
-      strcpy( buf + n1, ".0" );
+/* Ensure there is a decimal point in the mantissa, so that the value is
+   read back as a floating point value. */
+      if( !strchr( buf, '.' ) ) {
+         exp = strpbrk( buf, "eE" );
+         if( exp ) {
+            memmove( exp + 2, exp, strlen( exp ) + 1 );
+            exp[ 0 ] = '.';
+            exp[ 1 ] = '0';
+         } else {
+            n1 = strlen( buf );
+            strcpy( buf + n1, ".0" );
+         }
+      }
    }
 
    return buf;
@@ -5850,7 +6178,8 @@ static int LibYamlWriter( void *data, yaml_char_t *buffer,
    char *pend;
    char *pstart;
    int *status;
-   int nc;
+   size_t nc;
+   size_t nw;
 
 /* Get the AST status pointer */
    status = astGetStatusPtr;
@@ -5873,16 +6202,23 @@ static int LibYamlWriter( void *data, yaml_char_t *buffer,
 
 /* Loop round all buffer characters. */
    line = NULL;
-   pb--;
-   while( ++pb <= pend ){
-
-/* If the current buffer character is a newline, or we have reached the
-   end of the buffer, get a null terminated copy of the line that ends
-   here, then write it out using astPutNextText. */
-      if( pb == pend || *pb == '\n' ){
+   for( ; pb < pend && astOK; pb++ ){
+
+/* If the current buffer character is a newline, get a null terminated
+   copy of the line that ends here, then write it out using
+   astPutNextText. libyaml flushes its buffer whenever it becomes full, so
+   the start of the line may have been retained from the end of the
+   previous buffer. */
+      if( *pb == '\n' ){
          nc = pb - pstart;
-         line = astStore( line, pstart, nc + 1 );
-         if( astOK ) line[ nc ] = 0;
+         nw = this->wline ? strlen( this->wline ) : 0;
+         line = astGrow( line, nw + nc + 1, 1 );
+         if( astOK ) {
+            if( nw ) memcpy( line, this->wline, nw );
+            memcpy( line + nw, pstart, nc );
+            line[ nw + nc ] = 0;
+         }
+         this->wline = astFree( this->wline );
          astPutNextText( this, line );
 
 /* Indicate any subsequent line starts at the next character. */
@@ -5890,12 +6226,172 @@ static int LibYamlWriter( void *data, yaml_char_t *buffer,
       }
    }
 
+/* Retain any incomplete line at the end of the buffer so that it can be
+   completed by the next buffer (the final line is written out by
+   EndYamlDoc). */
+   nc = pend - pstart;
+   nw = this->wline ? strlen( this->wline ) : 0;
+   this->wline = astGrow( this->wline, nw + nc + 1, 1 );
+   if( astOK ) {
+      memcpy( this->wline + nw, pstart, nc );
+      this->wline[ nw + nc ] = 0;
+   }
+
 /* Free the line copy. */
    line = astFree( line );
 
    return astOK ? 1 : 0;
 }
 
+static int LittleEndian( void ) {
+/*
+*  Name:
+*     LittleEndian
+
+*  Purpose:
+*     See if the local machine stores numbers in little-endian order.
+
+*  Type:
+*     Private function.
+
+*  Synopsis:
+*     #include "yamlchan.h"
+*     int LittleEndian( void )
+
+*  Class Membership:
+*     YamlChan member function
+
+*  Description:
+*     This function returns a flag indicating if the least significant
+*     byte of a multi-byte number is stored first in memory on the local
+*     machine. If so, the values in an ASDF binary block can be copied
+*     directly to and from memory.
+
+*  Returned Value:
+*     Non-zero if the local machine is little-endian, and zero otherwise.
+*/
+
+/* Local Variables: */
+   const int one = 1;
+
+/* Test the first byte of an integer holding the value one. */
+   return *( (const unsigned char *) &one ) == 1;
+}
+
+static void MakeAsdfBlocks( AstYamlChan *this, AstKeyMap *km, int *status ){
+/*
+*  Name:
+*     MakeAsdfBlocks
+
+*  Purpose:
+*     Move the values of large ASDF ndarrays into binary blocks.
+
+*  Type:
+*     Private function.
+
+*  Synopsis:
+*     #include "yamlchan.h"
+*     void MakeAsdfBlocks( AstYamlChan *this, AstKeyMap *km, int *status )
+
+*  Class Membership:
+*     YamlChan member function
+
+*  Description:
+*     This function searches the supplied KeyMap, and any KeyMaps nested
+*     within it, for ASDF ndarrays that hold their values inline. If an
+*     ndarray holds at least BlockOK values (and more than one value),
+*     the values are moved into a new ASDF binary block (see
+*     StoreAsdfBlock) and the inline "data" is removed from the ndarray.
+*
+*     This is done after the whole ASDF object has been created, rather
+*     than as each ndarray is created, since the values in some ndarrays
+*     are modified when adjacent ASDF transforms are merged.
+
+*  Parameters:
+*     this
+*        Pointer to the YamlChan.
+*     km
+*        Pointer to the KeyMap to search.
+*     status
+*        Pointer to the inherited status.
+*/
+
+/* Local Variables: */
+   AstKeyMap *datakm;
+   AstObject *obj;
+   char rowkey[ 30 ];
+   const char *key;
+   const char *tag;
+   double *vals;
+   int dims[ 2 ];
+   int iel;
+   int ikey;
+   int nel;
+   int nkey;
+   int nval;
+   int ndim;
+
+/* Check the global error status. */
+   if ( !astOK ) return;
+
+/* If the KeyMap is an ndarray that holds its values inline, get the
+   values and their dimensions. 2-dimensional arrays are stored as a
+   nested KeyMap holding one vector for each row. */
+   if( astMapGet0C( km, "YAMLTAG", &tag ) && strstr( tag, "/ndarray-" ) ) {
+      vals = NULL;
+      ndim = 0;
+      if( astMapType( km, "data" ) == AST__OBJECTTYPE ) {
+         astMapGet0A( km, "data", &obj );
+         datakm = (AstKeyMap *) obj;
+         dims[ 0 ] = astMapLength( datakm, "data_0" );
+         dims[ 1 ] = 0;
+         sprintf( rowkey, "data_%d", dims[ 1 ] );
+         while( astMapHasKey( datakm, rowkey ) && astOK ) {
+            vals = astGrow( vals, dims[ 0 ]*( dims[ 1 ] + 1 ), sizeof(*vals) );
+            if( astOK ) {
+               astMapGet1D( datakm, rowkey, dims[ 0 ], &nval,
+                            vals + dims[ 0 ]*dims[ 1 ] );
+            }
+            sprintf( rowkey, "data_%d", ++dims[ 1 ] );
+         }
+         datakm = astAnnul( datakm );
+         ndim = 2;
+
+      } else if( astMapHasKey( km, "data" ) ) {
+         dims[ 0 ] = astMapLength( km, "data" );
+         vals = astMalloc( dims[ 0 ]*sizeof(*vals) );
+         astMapGet1D( km, "data", dims[ 0 ], &nval, vals );
+         ndim = 1;
+      }
+
+/* If the array is big enough, replace the inline values with a
+   reference to a new binary block. */
+      nel = ( ndim == 2 ) ? dims[ 0 ]*dims[ 1 ] : ( ndim == 1 ? dims[ 0 ] : 0 );
+      if( vals && nel > 1 && nel >= astGetBlockOK( this ) && astOK ) {
+         astMapRemove( km, "data" );
+         StoreAsdfBlock( this, km, ndim, dims, vals, status );
+      }
+      vals = astFree( vals );
+
+/* Otherwise, search any nested KeyMaps. */
+   } else {
+      nkey = astMapSize( km );
+      for( ikey = 0; ikey < nkey && astOK; ikey++ ) {
+         key = astMapKey( km, ikey );
+         if( astMapType( km, key ) == AST__OBJECTTYPE ) {
+            nel = astMapLength( km, key );
+            for( iel = 0; iel < nel && astOK; iel++ ) {
+               astMapGetElemA( km, key, iel, &obj );
+               if( astIsAKeyMap( obj ) ) {
+                  MakeAsdfBlocks( this, (AstKeyMap *) obj, status );
+               }
+               obj = astAnnul( obj );
+            }
+         }
+      }
+   }
+}
+
 static AstKeyMap *MergeAsdf( AstYamlChan *this, AstKeyMap *km,
                              int r2d, int before, int *status ){
 /*
@@ -6403,31 +6899,272 @@ static AstMapping *ReadAffine( AstYamlChan *this, AstKeyMap *km, int *status ){
                       "way.", status );
          }
 
-/* Create the ShiftMap */
-         sm = astShiftMap( dims[ 0 ], tra_ptr, " ", status );
+/* Create the ShiftMap */
+         sm = astShiftMap( dims[ 0 ], tra_ptr, " ", status );
+
+/* Free resources. */
+         subkm = astAnnul( subkm );
+         tra_ptr = astFree( tra_ptr );
+      }
+
+/* Combine the translation and matrix in series, and simplify. */
+      cm = astCmpMap( mm, sm, 1, " ", status );
+      result = astSimplify( cm );
+
+/* Free resources. */
+      sm = astAnnul( sm );
+      mm = astAnnul( mm );
+      cm = astAnnul( cm );
+   }
+
+/* If an error occurred, report the context. */
+   if( !astOK ) {
+      astError( astStatus, "Error occurred when reading an ASDF 'affine' "
+                "object.", status );
+   }
+
+/* Return the Mapping. */
+   return result;
+}
+
+static double *ReadAsdfBlock( AstYamlChan *this, AstKeyMap *km, int mxdim,
+                              int *ndim, int *dims, int *status ){
+/*
+*  Name:
+*     ReadAsdfBlock
+
+*  Purpose:
+*     Read a vectorised array of doubles from an ASDF binary block.
+
+*  Type:
+*     Private function.
+
+*  Synopsis:
+*     #include "yamlchan.h"
+*     double *ReadAsdfBlock( AstYamlChan *this, AstKeyMap *km, int mxdim,
+*                            int *ndim, int *dims, int *status )
+
+*  Class Membership:
+*     YamlChan member function
+
+*  Description:
+*     This function allocates and returns an array of doubles holding
+*     the values of an ASDF ndarray that is stored in a binary block
+*     rather than inline. The supplied KeyMap should hold the ndarray
+*     properties, including an integer "source" property giving the
+*     index of the block. The contents of the block are obtained from
+*     the KeyMap of blocks stored in the YamlChan by astPutAsdfBlocks.
+*     If the block holds little-endian doubles and the local machine is
+*     also little-endian, the values are copied directly into the
+*     returned array. Otherwise, they are converted one at a time.
+
+*  Parameters:
+*     this
+*        Pointer to the YamlChan.
+*     km
+*        Pointer to the KeyMap holding the ASDF ndarray.
+*     mxdim
+*        The maximum allowed number of dimensions within the returned
+*        vectorised values array.
+*     ndim
+*        Pointer to an int in which to return the actual number of
+*        dimensions within the returned vectorised values array.
+*     dims
+*        An array with "mxdim" elements in which are returned the dimensions
+*        of the returned vectorised values array (first axis varying
+*        fastest).
+*     status
+*        Pointer to the inherited status variable.
+
+*  Returned Value:
+*     A pointer to a newly allocated array holding the vectorised array of
+*     values read from the block, or NULL if an error occurs. The array
+*     should be freed using astFree when it is no longer needed.
+*/
+
+/* Local Variables: */
+   char key[ 30 ];
+   const char *byteorder;
+   const char *datatype;
+   double *result;
+   float fval;
+   int16_t sval;
+   int32_t ival;
+   int64_t kval;
+   int iblock;
+   int idim;
+   int nbyte = 0;
+   int nshape;
+   int nval;
+   int offset;
+   int shape[ MXDIM ];
+   int size;
+   int swap;
+   int type;
+   size_t i;
+   size_t j;
+   size_t nel;
+   unsigned char *data;
+   unsigned char *p;
+   unsigned char buf[ 8 ];
+
+/* Initialise */
+   result = NULL;
+   *ndim = 0;
+
+/* Check inherited status */
+   if( !astOK ) return result;
+
+/* The "source" property must be an integer block index. A string
+   value would refer to an external file, which is not supported. */
+   type = astMapType( km, "source" );
+   if( type != AST__INTTYPE && type != AST__SINTTYPE &&
+       type != AST__KINTTYPE && type != AST__BYTETYPE ) {
+      astError( AST__BYAML, "astRead(YamlChan): ndarray refers to external "
+                "data ('%s') - AST can only handle ndarrays that are "
+                "defined inline or stored in binary blocks.", status,
+                Get0C( km, "source", 1, "", status ) );
+      return result;
+   }
+
+/* Check the block has been supplied. */
+   iblock = Get0I( km, "source", 0, 0, status );
+   sprintf( key, "%d", iblock );
+   if( astOK && ( !this->blocks || !astMapHasKey( this->blocks, key ) ) ) {
+      astError( AST__BYAML, "astRead(YamlChan): ndarray refers to ASDF "
+                "binary block %d, but no such block has been stored in "
+                "the %s (see astPutAsdfBlocks).", status, iblock,
+                astGetClass( this ) );
+   }
+
+/* Non-contiguous arrays are not supported. */
+   if( astOK && astMapHasKey( km, "strides" ) ) {
+      astError( AST__BYAML, "astRead(YamlChan): ndarray has a 'strides' "
+                "property - AST can only handle contiguous ndarrays.",
+                status );
+   }
+
+/* Get the number of bytes in each value, and see if the bytes in each
+   value need to be reversed. */
+   datatype = Get0C( km, "datatype", 0, NULL, status );
+   byteorder = Get0C( km, "byteorder", 1, "little", status );
+   size = 0;
+   swap = 0;
+   if( astOK ) {
+      if( !strcmp( datatype, "float64" ) || !strcmp( datatype, "int64" ) ) {
+         size = 8;
+      } else if( !strcmp( datatype, "float32" ) || !strcmp( datatype, "int32" ) ) {
+         size = 4;
+      } else if( !strcmp( datatype, "int16" ) ) {
+         size = 2;
+      } else if( !strcmp( datatype, "uint8" ) ) {
+         size = 1;
+      } else {
+         astError( AST__BYAML, "astRead(YamlChan): ndarray has unsupported "
+                   "datatype '%s'.", status, datatype );
+      }
+
+      if( !strcmp( byteorder, "big" ) ) {
+         swap = LittleEndian();
+      } else if( !strcmp( byteorder, "little" ) ) {
+         swap = !LittleEndian();
+      } else if( astOK ) {
+         astError( AST__BYAML, "astRead(YamlChan): ndarray has illegal "
+                   "byteorder '%s'.", status, byteorder );
+      }
+   }
+
+/* Get the shape of the array. ASDF gives the slowest varying axis first,
+   so reverse the dimensions into the usual AST order. Check the number
+   of elements as it is formed, so that neither it nor the size of the
+   returned array can overflow. */
+   Get1I( km, "shape", 0, MXDIM, shape, &nshape, status );
+   nel = 1;
+   if( astOK ) {
+      if( nshape > mxdim ) {
+         astError( AST__BYAML, "astRead(YamlChan): The array has %d axes "
+                   "- no more than %d are allowed.", status, nshape, mxdim );
+      } else {
+         for( idim = 0; idim < nshape && astOK; idim++ ) {
+            dims[ idim ] = shape[ nshape - 1 - idim ];
+            if( dims[ idim ] < 1 ||
+                nel > ( (size_t) -1 )/sizeof(*result)/dims[ idim ] ) {
+               astError( AST__BYAML, "astRead(YamlChan): ndarray has "
+                         "illegal shape.", status );
+            } else {
+               nel *= dims[ idim ];
+            }
+         }
+         *ndim = nshape;
+      }
+   }
 
-/* Free resources. */
-         subkm = astAnnul( subkm );
-         tra_ptr = astFree( tra_ptr );
+/* Check the block is long enough to hold the array. Compare the number
+   of elements with the number that fit after the offset, rather than
+   forming the number of bytes in the array, which could overflow. */
+   offset = Get0I( km, "offset", 1, 0, status );
+   if( astOK ) {
+      nbyte = astMapLength( this->blocks, key );
+      if( offset < 0 || offset > nbyte ||
+          nel > (size_t) ( nbyte - offset )/size ) {
+         astError( AST__BYAML, "astRead(YamlChan): ASDF binary block %d "
+                   "(%d bytes) is too short to hold a %zu element %s "
+                   "ndarray at offset %d.", status, iblock, nbyte, nel,
+                   datatype, offset );
       }
+   }
 
-/* Combine the translation and matrix in series, and simplify. */
-      cm = astCmpMap( mm, sm, 1, " ", status );
-      result = astSimplify( cm );
+/* Allocate the returned array. */
+   result = astMalloc( nel*sizeof(*result) );
+   if( astOK ) {
 
-/* Free resources. */
-      sm = astAnnul( sm );
-      mm = astAnnul( mm );
-      cm = astAnnul( cm );
-   }
+/* If the block holds doubles in the local byte order, starting at the
+   beginning of the block, copy them straight into the returned array. */
+      if( size == 8 && !swap && offset == 0 && !strcmp( datatype, "float64" ) ) {
+         astMapGet1B( this->blocks, key, (int) ( nel*size ), &nval,
+                      (unsigned char *) result );
 
-/* If an error occurred, report the context. */
-   if( !astOK ) {
-      astError( astStatus, "Error occurred when reading an ASDF 'affine' "
-                "object.", status );
+/* Otherwise, get a copy of the whole block and convert each value in
+   turn, reversing the bytes if necessary. */
+      } else {
+         data = astMalloc( nbyte );
+         astMapGet1B( this->blocks, key, nbyte, &nval, data );
+         if( astOK ) {
+            p = data + offset;
+            for( i = 0; i < nel; i++, p += size ) {
+               if( swap ) {
+                  for( j = 0; j < (size_t) size; j++ ) buf[ j ] = p[ size - 1 - j ];
+               } else {
+                  memcpy( buf, p, size );
+               }
+
+               if( !strcmp( datatype, "float64" ) ) {
+                  memcpy( result + i, buf, 8 );
+               } else if( !strcmp( datatype, "int64" ) ) {
+                  memcpy( &kval, buf, 8 );
+                  result[ i ] = (double) kval;
+               } else if( !strcmp( datatype, "float32" ) ) {
+                  memcpy( &fval, buf, 4 );
+                  result[ i ] = (double) fval;
+               } else if( !strcmp( datatype, "int32" ) ) {
+                  memcpy( &ival, buf, 4 );
+                  result[ i ] = (double) ival;
+               } else if( !strcmp( datatype, "int16" ) ) {
+                  memcpy( &sval, buf, 2 );
+                  result[ i ] = (double) sval;
+               } else {
+                  result[ i ] = (double) buf[ 0 ];
+               }
+            }
+         }
+         data = astFree( data );
+      }
    }
 
-/* Return the Mapping. */
+/* Return NULL if an error occurred. */
+   if( !astOK ) result = astFree( result );
+
+/* Return the array. */
    return result;
 }
 
@@ -7849,11 +8586,10 @@ static double *ReadNDArray( AstYamlChan *this, AstKeyMap *km, int mxdim,
 /* Create the returned array. */
    } else {
 
-/* This class can only handle arrays defined inline. */
+/* If the ndarray has a "source" property, the values are stored in a
+   binary block rather than inline. */
       if( astMapHasKey( km, "source" ) ){
-         astError( AST__BYAML, "astRead(YamlChan): ndarray is not defined "
-                   "inline - AST can only handle ndarrays that are defined "
-                   "inline.", status );
+         result = ReadAsdfBlock( this, km, mxdim, ndim, dims, status );
 
 /* If the supplied KeyMap contains a "data" element it may be a KeyMap
    holding a set of vectors (each corresponding to one row of the data
@@ -8098,8 +8834,8 @@ static AstMapping *ReadPoly( AstYamlChan *this, AstKeyMap *km, int isortho,
    double outa[ 2 ];
    double outb[ 2 ];
    int dims[ 2 ];
-   int dimd;
-   int dimw;
+   int dimd[ MXDIM ];
+   int dimw[ MXDIM ];
    int i;
    int irow;
    int j;
@@ -8109,6 +8845,7 @@ static AstMapping *ReadPoly( AstYamlChan *this, AstKeyMap *km, int isortho,
    int ndim;
    int ndimd;
    int ndimw;
+   int nrow;
 
 /* Initialise */
    result = NULL;
@@ -8208,11 +8945,11 @@ static AstMapping *ReadPoly( AstYamlChan *this, AstKeyMap *km, int isortho,
 
 /* If the supplied KeyMap contains a "domain", read the vectorised domain
    array into a newly allocated memory block. */
-      domain = GetSequence( this, km, "domain", 1, ndim, &ndimd, &dimd, status );
+      domain = GetSequence( this, km, "domain", 1, ndim, &ndimd, dimd, status );
 
 /* If the supplied KeyMap contains a "window", read the vectorised window
    array into a newly allocated memory block. */
-      window = GetSequence( this, km, "window", 1, ndim, &ndimw, &dimw, status );
+      window = GetSequence( this, km, "window", 1, ndim, &ndimw, dimw, status );
 
 /* If neither exist, just return the basic PolyMap or ChebyMap (the
    ChebyMap assumes a domain of [-1,1] on each axis. */
@@ -8235,12 +8972,14 @@ static AstMapping *ReadPoly( AstYamlChan *this, AstKeyMap *km, int isortho,
 
 /* Get the input positions at the two corners of the domain, as required
    by the WinMap constructor. Use a domain of [-1,1] on each axis if no
-   domain was supplied. */
+   domain was supplied. The domain holds a pair of bounds for each input
+   axis. */
          if( domain ) {
-            if( dimd != ndim ) {
+            nrow = ( ndimd == 2 ) ? dimd[ 1 ] : 1;
+            if( dimd[ 0 ] != 2 || nrow != ndim ) {
                astError( AST__BYAML, "astRead(YamlChan): The domain array "
                          "has wrong length (%d) - should be %d.", status,
-                         dimd, ndim );
+                         nrow, ndim );
             } else {
                ina[ 0 ] = domain[ 0 ];
                if( ndim == 2 ) ina[ 1 ] = domain[ 2 ];
@@ -8258,10 +8997,11 @@ static AstMapping *ReadPoly( AstYamlChan *this, AstKeyMap *km, int isortho,
    window), as required by the WinMap constructor. Use a window of [-1,1]
    on each axis if no domain was supplied. */
          if( window ) {
-            if( dimw != ndim ) {
+            nrow = ( ndimw == 2 ) ? dimw[ 1 ] : 1;
+            if( dimw[ 0 ] != 2 || nrow != ndim ) {
                astError( AST__BYAML, "astRead(YamlChan): The window array "
                          "has wrong length (%d) - should be %d.", status,
-                         dimw, ndim );
+                         nrow, ndim );
             } else {
                outa[ 0 ] = window[ 0 ];
                if( ndim == 2 ) outa[ 1 ] = window[ 2 ];
@@ -9057,6 +9797,7 @@ static double *ReadSequence( AstYamlChan *this, AstKeyMap *km, const char *name,
    int nkey;
    int nused;
    int odims[ MXDIM ];
+   size_t irow;
    size_t nel;
    size_t nel_exp;
 
@@ -9081,20 +9822,17 @@ static double *ReadSequence( AstYamlChan *this, AstKeyMap *km, const char *name,
                 "got type '%s'.", status, SEQ_TYPE, class );
    }
 
-/* Ensure the astMapKey function returns keys in alphabetical order. This
-   should ensure that the rows are accessed in the right order. */
-   astSet( km, "SortBy=KeyUp", status );
-
 /* Get the length of the supplied name. */
    nc = strlen( name );
 
 /* Initialise the largest index found for each axis. */
    for( idim = 0; idim < MXDIM; idim++ ) odims[ idim ] = 0;
 
-/* Initialise the number of elements currently in the result array. */
+/* Initialise the total number of elements in all rows. */
    nel = 0;
 
-/* Loop round all keys in the sub keymap. */
+/* Loop round all keys in the sub keymap, checking the rows are
+   consistent and finding the dimensions of the array. */
    nkey = astMapSize( km );
    for( ikey = 0; ikey < nkey; ikey++ ) {
       key = astMapKey( km, ikey );
@@ -9152,17 +9890,8 @@ static double *ReadSequence( AstYamlChan *this, AstKeyMap *km, const char *name,
             break;
          }
 
-/* Grow the results array to make room for the values in the current
-   vector entry. */
-         result = astGrow( result, nel + dim, sizeof(*result) );
-         if( astOK ) {
-
-/* Copy the values in the current vector entry into the results array. */
-            astMapGet1D( km, key, dim, &dim, result + nel );
-
-/* Incrmeent the number of values currently in the results array. */
-            nel += dim;
-         }
+/* Increment the total number of values. */
+         nel += dim;
       }
    }
 
@@ -9196,6 +9925,27 @@ static double *ReadSequence( AstYamlChan *this, AstKeyMap *km, const char *name,
                    "elements in the array should be %zu, but %zu were "
                    "found.", status, nel_exp, nel );
       }
+
+/* Copy the values in each row into the results array. The position of
+   each row within the results array is determined by the indices in its
+   key, so the order in which the keys are returned by astMapKey does not
+   matter (sorting the keys alphabetically would put "data_10" before
+   "data_2"). */
+      result = astMalloc( nel*sizeof(*result) );
+      for( ikey = 0; ikey < nkey && astOK; ikey++ ) {
+         key = astMapKey( km, ikey );
+         if( !strncmp( key, name, nc ) ) {
+            irow = 0;
+            pkey = key + nc;
+            for( idim = 0; idim < *ndim - 1; idim++ ) {
+               astSscanf( pkey, "_%d%n", &dim, &nused );
+               irow = irow*odims[ idim ] + dim;
+               pkey += nused;
+            }
+            dim = odims[ *ndim - 1 ];
+            astMapGet1D( km, key, dim, &dim, result + irow*dim );
+         }
+      }
    }
 
 /* Report a context error. */
@@ -9671,6 +10421,7 @@ static AstMapping *ReadTransform( AstYamlChan *this, AstKeyMap *km, int *status
    AstMapping *inverse;
    AstMapping *new;
    AstMapping *result;
+   AstObject *obj;
    const char *class;
    const char *name;
    double *coeffs_f;
@@ -9698,7 +10449,14 @@ static AstMapping *ReadTransform( AstYamlChan *this, AstKeyMap *km, int *status
       astError( AST__BYAML, "astRead(YamlChan): Expected KeyMap to hold "
                 "a transform but got a %s", status, GetAsdfClass(km,status) );
 
-/* Create a Mapping of the required class. */
+/* If the transform was converted into an AST Mapping whilst the YAML was
+   being parsed (see ConvertTransform), return the Mapping. It is removed
+   from the KeyMap so that the caller is free to modify it. */
+   } else if( astMapGet0A( km, "ASTmapping", &obj ) ) {
+      astMapRemove( km, "ASTmapping" );
+      result = (AstMapping *) obj;
+
+/* Otherwise, create a Mapping of the required class. */
    } else {
       class = GetAsdfClass( km, status );
       if( class ) {
@@ -10320,6 +11078,8 @@ static void ReadYAMLEvent( AstYamlChan *this, yaml_parser_t *parser,
    char *class;
    char *text;
    double dval;
+   int isint;
+   int iswcs;
    int ival;
    unsigned char bval;
 
@@ -10346,16 +11106,34 @@ static void ReadYAMLEvent( AstYamlChan *this, yaml_parser_t *parser,
          }
       }
 
+/* Note if the YAML Mapping holds a GWCS wcs object. If so, increment the
+   number of wcs objects currently being read. */
+      iswcs = ( class && !strncmp( GWCS_TAG"wcs-", class,
+                                   strlen(GWCS_TAG"wcs-") ) );
+      if( iswcs ) this->inwcs++;
+
 /* Get a KeyMap holding the content of the YAML Mapping. This consumes
    subsequent events up to and including the "Mapping end" event corresponding
    to the "Mapping start" event read above. */
       kmval = ReadYAMLMapping( this, parser, status );
+      if( iswcs ) this->inwcs--;
 
 /* Store the YAML class in the sub keymap. If no class is specified a
    fixed string will be used to indicate the object has no type (usuall
    the start of a sequence).  */
       astMapPut0C( kmval, "ASDFclass", class?class:ANON_TYPE, NULL );
 
+/* If the YAML Mapping holds an ASDF transform within a wcs object, create
+   the equivalent AST Mapping now, rather than waiting until the whole wcs
+   has been read. This allows the KeyMap holding the properties of the
+   transform to be freed straight away. Do not do this if the YAML is
+   being read as an AST native object. */
+      if( this->inwcs > 0 && IsA( kmval, "transform", status ) &&
+          ( !astTestYamlEncoding( this ) ||
+            astGetYamlEncoding( this ) != NATIVE_ENCODING ) ) {
+         ConvertTransform( this, &kmval, status );
+      }
+
 /* Store the sub keymap in the supplied keymap. If no previous item has
    been stored with this id, a new 1-element vector entry is created.
    Otherwise, the existing vector entry is extended and the new value is
@@ -10365,9 +11143,7 @@ static void ReadYAMLEvent( AstYamlChan *this, yaml_parser_t *parser,
 /* If this mapping holds a wcs object, store a flag in the YamlChan
    structure indicating that a WCS object is now available in the KeyMap
    and there is therefore no need to continue reading more YAML. */
-      if( class && !strncmp( GWCS_TAG"wcs-", class, strlen(GWCS_TAG"wcs-") ) ){
-         this->gotwcs = 1;
-      }
+      if( iswcs ) this->gotwcs = 1;
 
 /* Free resources. */
       if( kmval ) kmval = astAnnul( kmval );
@@ -10377,19 +11153,14 @@ static void ReadYAMLEvent( AstYamlChan *this, yaml_parser_t *parser,
    } else if( event->type == YAML_SCALAR_EVENT ) {
       anchor = (char *) event->data.scalar.anchor;
       text = (char *) event->data.scalar.value;
-      dval = astChr2Double( text );
-      if( dval != AST__BAD ) {
-         if( strstr( text, "." ) ){
-            PutIntoKeyMap( km, id, AST__DOUBLETYPE, &dval, status );
-         } else {
+      if( ReadYAMLNumber( text, &dval, &isint, status ) ) {
+         if( isint ){
             ival = (int) dval;
             PutIntoKeyMap( km, id, AST__INTTYPE, &ival, status );
+         } else {
+            PutIntoKeyMap( km, id, AST__DOUBLETYPE, &dval, status );
          }
 
-      } else if( astChrMatch( text, AST__BAD_STRING ) ) {
-         dval = AST__BAD;
-         PutIntoKeyMap( km, id, AST__DOUBLETYPE, &dval, status );
-
       } else if( astChrMatch( text, "False" ) ){
          bval = 0;
          PutIntoKeyMap( km, id, AST__BYTETYPE, &bval, status );
@@ -10592,6 +11363,76 @@ static AstKeyMap *ReadYAMLMapping( AstYamlChan *this, yaml_parser_t *parser, int
    return result;
 }
 
+static int ReadYAMLNumber( const char *text, double *dval, int *isint,
+                           int *status ){
+/*
+*  Name:
+*     ReadYAMLNumber
+
+*  Purpose:
+*     See if a YAML scalar holds a numerical value.
+
+*  Type:
+*     Private function.
+
+*  Synopsis:
+*     #include "yamlchan.h"
+*     int ReadYAMLNumber( const char *text, double *dval, int *isint,
+*                         int *status )
+
+*  Class Membership:
+*     YamlChan member function
+
+*  Description:
+*     This function checks if the supplied text, read from a YAML scalar,
+*     represents a numerical value. If so, the value is returned, together
+*     with a flag indicating if it should be stored as an integer. Values
+*     that include a decimal point or an exponent, or that are too large to
+*     be stored as an int, are flagged as floating point values. The string
+*     AST__BAD_STRING is also accepted, and returned as AST__BAD.
+
+*  Parameters:
+*     text
+*        The text of the YAML scalar.
+*     dval
+*        Pointer to a double in which to return the numerical value.
+*     isint
+*        Pointer to an int in which to return a flag indicating if the
+*        value is an integer.
+*     status
+*        Pointer to the inherited status variable.
+
+*  Returned Value:
+*     Non-zero if the text holds a numerical value, and zero otherwise.
+
+*/
+
+/* Local Variables: */
+   int result;
+
+/* Initialise */
+   result = 0;
+   *dval = AST__BAD;
+   *isint = 0;
+
+/* Check inherited status */
+   if( !astOK || !text ) return result;
+
+/* Attempt to read a numerical value from the text. */
+   *dval = astChr2Double( text );
+   if( *dval != AST__BAD ) {
+      result = 1;
+      *isint = ( !strpbrk( text, ".eE" ) && fabs( *dval ) <= INT_MAX );
+
+/* The text may also represent a bad value. */
+   } else if( astChrMatch( text, AST__BAD_STRING ) ) {
+      result = 1;
+   }
+
+/* Return the result. */
+   return result;
+}
+
 static void ReadYAMLSequence( AstYamlChan *this, AstKeyMap *km, const char *id,
                               yaml_parser_t *parser, int *status ) {
 /*
@@ -10658,15 +11499,20 @@ static void ReadYAMLSequence( AstYamlChan *this, AstKeyMap *km, const char *id,
    AstKeyMap *newkm;
    AstKeyMap *stage;
    AstKeyMap *subkm;
+   char *isint;
    char *key;
    const char *cval;
    const char *subclass;
+   double *values;
    double dval;
    int allnum;
    int allobj;
    int allseq;
    int alltext;
+   int direct;
+   int inum;
    int ival;
+   int nnum;
    int nval;
    int type;
    yaml_event_t  event;
@@ -10682,6 +11528,17 @@ static void ReadYAMLSequence( AstYamlChan *this, AstKeyMap *km, const char *id,
 /* Allocate space to hold the key. */
    key = astMalloc( strlen(id) + 10 );
 
+/* Most sequences hold nothing but numerical scalars (e.g. the rows of
+   an ndarray). To avoid the cost of creating a separate staging post
+   entry for every value, numerical scalars are read directly into an
+   array until the first non-numerical item is found. At that point any
+   values read so far are moved into the staging post and the remaining
+   items are read in the usual way. */
+   values = NULL;
+   isint = NULL;
+   nnum = 0;
+   direct = 1;
+
 /* Loop round reading values. Each value is stored as a separate element
    in the staging post, with its own unique key.  */
    alltext = 1;
@@ -10702,8 +11559,41 @@ static void ReadYAMLSequence( AstYamlChan *this, AstKeyMap *km, const char *id,
       } else if( event.type == YAML_SEQUENCE_END_EVENT ) {
          break;
 
-/* Read the next sequence value and store it in the staging post KeyMap. */
+/* If no non-numerical items have yet been found, and the next item is an
+   un-anchored numerical scalar, append it to the array of values. */
+      } else if( direct && event.type == YAML_SCALAR_EVENT &&
+                 !event.data.scalar.anchor &&
+                 ReadYAMLNumber( (const char *) event.data.scalar.value,
+                                 &dval, &ival, status ) ) {
+         values = astGrow( values, nnum + 1, sizeof(*values) );
+         isint = astGrow( isint, nnum + 1, sizeof(*isint) );
+         if( astOK ) {
+            values[ nnum ] = dval;
+            isint[ nnum++ ] = ival;
+            nval++;
+         }
+
+/* Otherwise, move any values read directly into the array into the
+   staging post, storing each one as a separate entry. */
       } else {
+         if( direct ) {
+            direct = 0;
+            for( inum = 0; inum < nnum; inum++ ) {
+               sprintf( key, "%s_%d", id, inum );
+               if( isint[ inum ] ) {
+                  astMapPut0I( stage, key, (int) values[ inum ], NULL );
+               } else {
+                  astMapPut0D( stage, key, values[ inum ], NULL );
+               }
+            }
+            if( nnum > 0 ) {
+               alltext = 0;
+               allobj = 0;
+               allseq = 0;
+            }
+         }
+
+/* Read the next sequence value and store it in the staging post KeyMap. */
          sprintf( key, "%s_%d", id, nval++ );
          ReadYAMLEvent( this, parser, &event, stage, key, status );
 
@@ -10763,6 +11653,17 @@ static void ReadYAMLSequence( AstYamlChan *this, AstKeyMap *km, const char *id,
    end of the entry. */
    type = astMapType( km, id );
    if( type != AST__BADTYPE ){
+      if( direct ) {
+         for( inum = 0; inum < nnum; inum++ ) {
+            sprintf( key, "%s_%d", id, inum );
+            if( isint[ inum ] ) {
+               astMapPut0I( stage, key, (int) values[ inum ], NULL );
+            } else {
+               astMapPut0D( stage, key, values[ inum ], NULL );
+            }
+         }
+      }
+
       if( type != AST__OBJECTTYPE && astOK ){
          astError( AST__INTER, "astRead(YamlChan): The container for the "
                    "nested YAML sequence named '%s' should be a KeyMap but "
@@ -10776,10 +11677,16 @@ static void ReadYAMLSequence( AstYamlChan *this, AstKeyMap *km, const char *id,
    KeyMap, create one now. */
    } else {
 
+/* If all elements of the sequence were read directly into the array of
+   numerical values, store the array as a single numerical vector entry
+   within the supplied KeyMap, using the supplied id. */
+      if( direct ) {
+         if( nnum > 0 ) astMapPut1D( km, id, nnum, values, NULL );
+
 /* If all elements of the sequence just read were numerical scalars,
    concatenate them into a numerical vector entry within the supplied
    KeyMap, using the supplied id. */
-      if( allnum ) {
+      } else if( allnum ) {
          for( ival = 0; ival < nval; ival++ ) {
             sprintf( key, "%s_%d", id, ival );
             astMapGet0D( stage, key, &dval );
@@ -10838,6 +11745,8 @@ static void ReadYAMLSequence( AstYamlChan *this, AstKeyMap *km, const char *id,
 /* Free resources. */
    stage = astAnnul( stage );
    key = astFree( key );
+   values = astFree( values );
+   isint = astFree( isint );
 }
 
 static void SetNotAsdf( AstCmpMap *map, int *status ){
@@ -11084,7 +11993,7 @@ static int SimplifyAsdf( AstYamlChan *this, AstKeyMap **km, int *status ){
             if( *pkm ) *(pw++) = *pkm;
          }
          nkm = ( pw - km_list );
-         while( *pw < *pkm ){
+         while( pw < pkm ){
             *(pw++) = NULL;
          }
       }
@@ -11162,7 +12071,7 @@ static int SimplifyAsdf( AstYamlChan *this, AstKeyMap **km, int *status ){
             if( *pkm ) *(pw++) = *pkm;
          }
          nkm = ( pw - km_list );
-         while( *pw < *pkm ){
+         while( pw < pkm ){
             *(pw++) = NULL;
          }
       }
@@ -11237,7 +12146,7 @@ static int SimplifyAsdf( AstYamlChan *this, AstKeyMap **km, int *status ){
             if( *pkm ) *(pw++) = *pkm;
          }
          nkm = ( pw - km_list );
-         while( *pw < *pkm ){
+         while( pw < pkm ){
             *(pw++) = NULL;
          }
       }
@@ -11504,7 +12413,8 @@ static void StartYamlDoc( AstYamlChan *this, yaml_emitter_t *emitter,
    tag.handle = (yaml_char_t *) "!";
    enc = astGetYamlEncoding( this );
    if( enc == ASDF_ENCODING ) {
-      LibYamlWriter( this, (yaml_char_t *) ASDF_HEADER, strlen(ASDF_HEADER) );
+      LibYamlWriter( this, (yaml_char_t *) ASDF_HEADER "\n",
+                     strlen(ASDF_HEADER) + 1 );
       tag.prefix = (yaml_char_t *) ASDF_TAG;
 
    } else if( enc == NATIVE_ENCODING ) {
@@ -11904,6 +12814,118 @@ static void StoreAnchor( AstYamlChan *this, const char *anchor, AstKeyMap *km,
    astMapRename( this->anchors, id, anchor );
 }
 
+static void StoreAsdfBlock( AstYamlChan *this, AstKeyMap *km, int ndim,
+                            const int *dims, const double *vals,
+                            int *status ){
+/*
+*  Name:
+*     StoreAsdfBlock
+
+*  Purpose:
+*     Store an array of doubles in a new ASDF binary block.
+
+*  Type:
+*     Private function.
+
+*  Synopsis:
+*     #include "yamlchan.h"
+*     void StoreAsdfBlock( AstYamlChan *this, AstKeyMap *km, int ndim,
+*                          const int *dims, const double *vals,
+*                          int *status )
+
+*  Class Membership:
+*     YamlChan member function
+
+*  Description:
+*     This function appends a new binary block to the KeyMap of blocks
+*     held in the YamlChan (see astGetAsdfBlocks), and stores the supplied
+*     values in it as little-endian 64 bit floating point values. It then
+*     adds the "source", "datatype", "byteorder" and "shape" properties
+*     that describe the block to the supplied ASDF ndarray KeyMap.
+
+*  Parameters:
+*     this
+*        Pointer to the YamlChan.
+*     km
+*        Pointer to the KeyMap holding the ASDF ndarray.
+*     ndim
+*        The number of dimensions in the array.
+*     dims
+*        The length of each dimension (first axis varying fastest).
+*     vals
+*        Pointer to the vector of values, in Fortran order.
+*     status
+*        Pointer to the inherited status.
+*/
+
+/* Local Variables: */
+   AstKeyMap *shape;
+   char key[ 30 ];
+   const unsigned char *p;
+   int iblock;
+   int idim;
+   size_t i;
+   size_t j;
+   size_t nel;
+   unsigned char *data;
+
+/* Check the global error status. */
+   if ( !astOK ) return;
+
+/* Get the number of values, and check they will fit in a single KeyMap
+   entry. */
+   nel = 1;
+   for( idim = 0; idim < ndim; idim++ ) nel *= dims[ idim ];
+   if( nel*sizeof(*vals) > INT_MAX ) {
+      astError( AST__BYAML, "astWrite(YamlChan): Cannot store a %zu element "
+                "array in an ASDF binary block - too many values.", status,
+                nel );
+      return;
+   }
+
+/* Create the KeyMap of blocks if required. Blocks are numbered from zero
+   in the order in which they are created. */
+   if( !this->blocks ) this->blocks = astKeyMap( " ", status );
+   iblock = astMapSize( this->blocks );
+   sprintf( key, "%d", iblock );
+
+/* Store the values. On a little-endian machine they can be copied
+   directly. Otherwise, reverse the bytes in each value first. */
+   if( LittleEndian() ) {
+      astMapPut1B( this->blocks, key, (int)( nel*sizeof(*vals) ),
+                   (const unsigned char *) vals, NULL );
+   } else {
+      data = astMalloc( nel*sizeof(*vals) );
+      if( astOK ) {
+         p = (const unsigned char *) vals;
+         for( i = 0; i < nel; i++, p += sizeof(*vals) ) {
+            for( j = 0; j < sizeof(*vals); j++ ) {
+               data[ i*sizeof(*vals) + j ] = p[ sizeof(*vals) - 1 - j ];
+            }
+         }
+         astMapPut1B( this->blocks, key, (int)( nel*sizeof(*vals) ), data,
+                      NULL );
+      }
+      data = astFree( data );
+   }
+
+/* Describe the block in the ndarray. */
+   Store0I( this, "source", km, iblock, status );
+   Store0C( this, "datatype", 0, km, "float64", NULL, status );
+   Store0C( this, "byteorder", 0, km, "little", NULL, status );
+
+/* The shape is written as a YAML sequence, with the slowest varying axis
+   first. Use a KeyMap rather than a vector so that a sequence is written
+   even for 1-dimensional arrays. */
+   shape = StartAsdfKeyMap( this, 1, NULL, status );
+   for( idim = 0; idim < ndim; idim++ ) {
+      sprintf( key, "shape_%d", idim );
+      Store0I( this, key, shape, dims[ ndim - 1 - idim ], status );
+   }
+   if( astOK ) astMapPut0A( km, "shape", shape, NULL );
+   if( shape ) shape = astAnnul( shape );
+}
+
 static void Store1C( AstYamlChan *this, const char *key, int quote,
                      AstKeyMap *km, int nval, const char *values[],
                      const char *tag, int *status ){
@@ -17772,6 +18794,55 @@ static AstObject *YamlToAst( AstYamlChan *this, AstKeyMap *km,
    "object.h" file. For a description of each attribute, see the class
    interface (in the associated .h file). */
 
+/*
+*att++
+*  Name:
+*     BlockOK
+
+*  Purpose:
+*     Should large arrays be stored in ASDF binary blocks?
+
+*  Type:
+*     Public attribute.
+
+*  Synopsis:
+*     Integer.
+
+*  Description:
+*     This attribute is only used when writing an Object using the ASDF
+*     encoding (see attribute YamlEncoding). If it is given a positive
+*     value, any ASDF ndarray containing at least BlockOK values (and
+*     more than one value) is stored in an ASDF binary block rather than
+*     being written inline as YAML text. The YAML text then describes the ndarray using a
+*     "source" property holding the zero-based index of the block. The
+*     blocks created by the most recent call to
+c     astWrite can be retrieved using astGetAsdfBlocks.
+f     AST_WRITE can be retrieved using AST_GETASDFBLOCKS.
+*     It is then the responsibility of the caller to store them after
+*     the YAML text, as described in the ASDF standard.
+*
+*     If BlockOK is zero or negative (the default), all ndarrays are
+*     written inline.
+*
+*     This attribute is not used when reading an Object from a YamlChan.
+*     Any ndarrays that refer to binary blocks are always read from the
+*     blocks supplied using
+c     astPutAsdfBlocks.
+f     AST_PUTASDFBLOCKS.
+
+*  Applicability:
+*     YamlChan
+*        All YamlChans have this attribute.
+*att--
+*/
+
+/* This is an integer value with a value of -INT_MAX when undefined but
+   yielding a default of zero. */
+astMAKE_CLEAR(YamlChan,BlockOK,blockok,-INT_MAX)
+astMAKE_GET(YamlChan,BlockOK,int,0,( this->blockok != -INT_MAX ? this->blockok : 0 ))
+astMAKE_SET(YamlChan,BlockOK,int,blockok,value)
+astMAKE_TEST(YamlChan,BlockOK,( this->blockok != -INT_MAX ))
+
 /*
 *att++
 *  Name:
@@ -17931,9 +19002,97 @@ astMAKE_GET(YamlChan,YamlEncoding,int,0,(this->yamlencoding == UNKNOWN_ENCODING
 
 /* Copy constructor. */
 /* ----------------- */
+static void Copy( const AstObject *objin, AstObject *objout, int *status ) {
+/*
+*  Name:
+*     Copy
+
+*  Purpose:
+*     Copy constructor for YamlChan objects.
+
+*  Type:
+*     Private function.
+
+*  Synopsis:
+*     void Copy( const AstObject *objin, AstObject *objout, int *status )
+
+*  Description:
+*     This function implements the copy constructor for YamlChan objects.
+
+*  Parameters:
+*     objin
+*        Pointer to the object to be copied.
+*     objout
+*        Pointer to the object being constructed.
+*     status
+*        Pointer to the inherited status variable.
+
+*  Notes:
+*     -  This constructor makes a deep copy.
+*/
+
+/* Local Variables: */
+   AstYamlChan *in;              /* Pointer to input YamlChan */
+   AstYamlChan *out;             /* Pointer to output YamlChan */
+
+/* Check the global error status. */
+   if ( !astOK ) return;
+
+/* Obtain pointers to the input and output YamlChans. */
+   in = (AstYamlChan *) objin;
+   out = (AstYamlChan *) objout;
+
+/* Clear the non-persistent values in the new YamlChan. */
+   out->anchors = NULL;      /* YAML anchors in document being read */
+   out->obj = NULL;          /* NATIVE object being read */
+   out->wline = NULL;        /* Incomplete line of YAML output */
+
+/* Store a copy of any ASDF binary blocks. */
+   if( in->blocks ) out->blocks = astCopy( in->blocks );
+}
 
 /* Destructor. */
 /* ----------- */
+static void Delete( AstObject *obj, int *status ) {
+/*
+*  Name:
+*     Delete
+
+*  Purpose:
+*     Destructor for YamlChan objects.
+
+*  Type:
+*     Private function.
+
+*  Synopsis:
+*     void Delete( AstObject *obj, int *status )
+
+*  Description:
+*     This function implements the destructor for YamlChan objects.
+
+*  Parameters:
+*     obj
+*        Pointer to the object to be deleted.
+*     status
+*        Pointer to the inherited status variable.
+
+*  Notes:
+*     This function attempts to execute even if the global error status is
+*     set.
+*/
+
+/* Local Variables: */
+   AstYamlChan *this;            /* Pointer to YamlChan */
+
+/* Obtain a pointer to the YamlChan structure. */
+   this = (AstYamlChan *) obj;
+
+/* Free the KeyMap holding any ASDF binary blocks. */
+   if( this->blocks ) this->blocks = astAnnul( this->blocks );
+
+/* Free any incomplete line of YAML output. */
+   this->wline = astFree( this->wline );
+}
 
 /* Dump function. */
 /* -------------- */
@@ -17992,6 +19151,12 @@ static void Dump( AstObject *this_object, AstChannel *channel, int *status ) {
    actual default attribute value.  Since "set" will be zero, these
    values are for information only and will not be read back. */
 
+   set = TestBlockOK( this, status );
+   ival = set ? GetBlockOK( this, status ) : astGetBlockOK( this );
+   astWriteInt( channel, "BlockOK", set, 0, ival,
+                ival > 0 ? "Min. no. of values in an ASDF binary block" :
+                           "Do not write ASDF binary blocks" );
+
    set = TestVerboseRead( this, status );
    ival = set ? GetVerboseRead( this, status ) : astGetVerboseRead( this );
    astWriteInt( channel, "VerboseRead", set, 0, ival,
@@ -18637,13 +19802,17 @@ AstYamlChan *astInitYamlChan_( void *mem, size_t size, int init,
 
 /* Initialise the YamlChan data. */
 /* ---------------------------- */
+      new->blockok = -INT_MAX;
       new->verboseread = -INT_MAX;
       new->preservename = -INT_MAX;
       new->yamlencoding = UNKNOWN_ENCODING;
       new->anchors = NULL;
       new->gotwcs = 0;
+      new->inwcs = 0;
       new->defenc = UNKNOWN_ENCODING;
       new->obj = NULL;
+      new->blocks = NULL;
+      new->wline = NULL;
 
 /* If an error occurred, clean up by deleting the new object. */
       if ( !astOK ) new = astDelete( new );
@@ -18780,6 +19949,9 @@ AstYamlChan *astLoadYamlChan_( void *mem, size_t size,
    obtained, we then use the appropriate (private) Set... member
    function to validate and set the value properly. */
 
+      new->blockok = astReadInt( channel, "blockok", -INT_MAX );
+      if ( TestBlockOK( new, status ) ) SetBlockOK( new, new->blockok, status );
+
       new->verboseread = astReadInt( channel, "verboseread", -INT_MAX );
       if ( TestVerboseRead( new, status ) ) SetVerboseRead( new, new->verboseread, status );
 
@@ -18803,8 +19975,11 @@ AstYamlChan *astLoadYamlChan_( void *mem, size_t size,
    representation of the YamlChan. */
       new->anchors = NULL;
       new->gotwcs = 0;
+      new->inwcs = 0;
       new->defenc = UNKNOWN_ENCODING;
       new->obj = NULL;
+      new->blocks = NULL;
+      new->wline = NULL;
    }
 
 /* If an error occurred, clean up by deleting the new YamlChan. */
@@ -18832,3 +20007,12 @@ AstYamlChan *astLoadYamlChan_( void *mem, size_t size,
 
 
 
+AstKeyMap *astGetAsdfBlocks_( AstYamlChan *this, int *status ){
+   if( !astOK ) return NULL;
+   return (**astMEMBER(this,YamlChan,GetAsdfBlocks))(this, status );
+}
+
+void astPutAsdfBlocks_( AstYamlChan *this, AstKeyMap *blocks, int *status ){
+   if( !astOK ) return;
+   (**astMEMBER(this,YamlChan,PutAsdfBlocks))(this, blocks, status );
+}
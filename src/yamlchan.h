@@ -98,17 +98,21 @@ typedef struct AstYamlChan {
    AstChannel channel;    /* Parent class structure */
 
 /* Attributes specific to objects in this class. */
+   int blockok;           /* Min. no. of values in an ASDF binary block */
    int preservename;      /* Store ASDF 'name' as Ident? */
    int verboseread;       /* Echo yaml text to stdout as it is read? */
    int yamlencoding;      /* Output format to use when writing */
    int defenc;            /* Default yaml encoding */
    AstKeyMap *anchors;    /* KeyMap holding transient YAML anchor definitions */
    int gotwcs;            /* Has a complete WCS been read yet? */
+   int inwcs;             /* Depth of ASDF wcs objects being parsed */
    const char *objectname;/* Name of Object currently being written. */
    int objectset;         /* Is the Object currently being written set? */
    int write_isa;         /* Is the next "isA" really needed? */
    AstKeyMap *obj;        /* KeyMap holding the NATIVE object being read */
    int index;             /* Index of next item to read from "obj" */
+   AstKeyMap *blocks;     /* KeyMap holding ASDF binary blocks */
+   char *wline;           /* Incomplete line of YAML output */
 
 #if defined( YAML )
    yaml_emitter_t emitter_data; /* The body of a yaml emitter */
@@ -131,6 +135,14 @@ typedef struct AstYamlChanVtab {
    AstClassIdentifier id;
 
 /* Properties (e.g. methods) specific to this class. */
+   AstKeyMap *(* GetAsdfBlocks)( AstYamlChan *, int * );
+   void (* PutAsdfBlocks)( AstYamlChan *, AstKeyMap *, int * );
+
+   int (* GetBlockOK)( AstYamlChan *, int * );
+   int (* TestBlockOK)( AstYamlChan *, int * );
+   void (* ClearBlockOK)( AstYamlChan *, int * );
+   void (* SetBlockOK)( AstYamlChan *, int, int * );
+
    int (* GetVerboseRead)( AstYamlChan *, int * );
    int (* TestVerboseRead)( AstYamlChan *, int * );
    void (* ClearVerboseRead)( AstYamlChan *, int * );
@@ -211,9 +223,16 @@ void astInitYamlChanGlobals_( AstYamlChanGlobals * );
 
 /* Prototypes for member functions. */
 /* -------------------------------- */
+AstKeyMap *astGetAsdfBlocks_( AstYamlChan *, int * );
+void astPutAsdfBlocks_( AstYamlChan *, AstKeyMap *, int * );
 
 # if defined(astCLASS)           /* Protected */
 
+int astGetBlockOK_( AstYamlChan *, int * );
+int astTestBlockOK_( AstYamlChan *, int * );
+void astClearBlockOK_( AstYamlChan *, int * );
+void astSetBlockOK_( AstYamlChan *, int, int * );
+
 int astGetVerboseRead_( AstYamlChan *, int * );
 int astTestVerboseRead_( AstYamlChan *, int * );
 void astClearVerboseRead_( AstYamlChan *, int * );
@@ -278,8 +297,21 @@ astINVOKE(O,astLoadYamlChan_(mem,size,vtab,name,astCheckChannel(channel),STATUS_
    before use.  This provides a contextual error report if a pointer
    to the wrong sort of Object is supplied. */
 
+#define astGetAsdfBlocks(this) \
+astINVOKE(O,astGetAsdfBlocks_(astCheckYamlChan(this),STATUS_PTR))
+#define astPutAsdfBlocks(this,blocks) \
+astINVOKE(V,astPutAsdfBlocks_(astCheckYamlChan(this),astCheckKeyMap(blocks),STATUS_PTR))
 
 #if defined(astCLASS)            /* Protected */
+#define astClearBlockOK(this) \
+astINVOKE(V,astClearBlockOK_(astCheckYamlChan(this),STATUS_PTR))
+#define astGetBlockOK(this) \
+astINVOKE(V,astGetBlockOK_(astCheckYamlChan(this),STATUS_PTR))
+#define astSetBlockOK(this,value) \
+astINVOKE(V,astSetBlockOK_(astCheckYamlChan(this),value,STATUS_PTR))
+#define astTestBlockOK(this) \
+astINVOKE(V,astTestBlockOK_(astCheckYamlChan(this),STATUS_PTR))
+
 #define astClearVerboseRead(this) \
 astINVOKE(V,astClearVerboseRead_(astCheckYamlChan(this),STATUS_PTR))
 #define astGetVerboseRead(this) \